@@ -429,6 +429,14 @@ typedef enum ur_function_t {
   UR_FUNCTION_ENQUEUE_EVENTS_WAIT_WITH_BARRIER_EXT = 246,
   /// Enumerator for ::urPhysicalMemGetInfo
   UR_FUNCTION_PHYSICAL_MEM_GET_INFO = 249,
+  /// Enumerator for ::urEnqueueBatchExp
+  UR_FUNCTION_ENQUEUE_BATCH_EXP = 250,
+  /// Enumerator for ::urEnqueueHostTaskExp
+  UR_FUNCTION_ENQUEUE_HOST_TASK_EXP = 251,
+  /// Enumerator for ::urEnqueueUSMAllocExp
+  UR_FUNCTION_ENQUEUE_USM_ALLOC_EXP = 252,
+  /// Enumerator for ::urEnqueueUSMFreeExp
+  UR_FUNCTION_ENQUEUE_USM_FREE_EXP = 253,
   /// @cond
   UR_FUNCTION_FORCE_UINT32 = 0x7fffffff
   /// @endcond
@@ -538,6 +546,8 @@ typedef enum ur_structure_type_t {
   UR_STRUCTURE_TYPE_EXP_ENQUEUE_NATIVE_COMMAND_PROPERTIES = 0x3000,
   /// ::ur_exp_enqueue_ext_properties_t
   UR_STRUCTURE_TYPE_EXP_ENQUEUE_EXT_PROPERTIES = 0x4000,
+  /// ::ur_exp_program_file_source_t
+  UR_STRUCTURE_TYPE_EXP_PROGRAM_FILE_SOURCE = 0x5000,
   /// @cond
   UR_STRUCTURE_TYPE_FORCE_UINT32 = 0x7fffffff
   /// @endcond
@@ -1319,6 +1329,11 @@ typedef enum ur_adapter_info_t {
   /// incremented unpon major changes, e.g. when multiple versions of an
   /// adapter may exist in parallel.
   UR_ADAPTER_INFO_VERSION = 2,
+  /// [char[]][optional-query] Returns the latency histograms recorded by
+  /// the adapter so far, as comma separated values with one header line.
+  /// Only available when the adapter is built with latency tracking and
+  /// tracking is enabled with UR_LOG_LATENCY.
+  UR_ADAPTER_INFO_LATENCY_HISTOGRAM_EXP = 0x2000,
   /// @cond
   UR_ADAPTER_INFO_FORCE_UINT32 = 0x7fffffff
   /// @endcond
@@ -1340,7 +1355,7 @@ typedef enum ur_adapter_info_t {
 ///     - ::UR_RESULT_ERROR_INVALID_NULL_HANDLE
 ///         + `NULL == hAdapter`
 ///     - ::UR_RESULT_ERROR_INVALID_ENUMERATION
-///         + `::UR_ADAPTER_INFO_VERSION < propName`
+///         + `::UR_ADAPTER_INFO_LATENCY_HISTOGRAM_EXP < propName`
 ///     - ::UR_RESULT_ERROR_UNSUPPORTED_ENUMERATION
 ///         + If `propName` is not supported by the adapter.
 ///     - ::UR_RESULT_ERROR_INVALID_SIZE
@@ -5221,8 +5236,9 @@ typedef struct ur_program_properties_t {
 ///     - ::UR_RESULT_ERROR_INVALID_NULL_HANDLE
 ///         + `NULL == hContext`
 ///     - ::UR_RESULT_ERROR_INVALID_NULL_POINTER
-///         + `NULL == pIL`
 ///         + `NULL == phProgram`
+///         + `NULL == pIL && NULL ==
+///         find_stype_node<ur_exp_program_file_source_t>(pProperties)`
 ///         + `NULL != pProperties && pProperties->count > 0 && NULL ==
 ///         pProperties->pMetadatas`
 ///     - ::UR_RESULT_ERROR_INVALID_SIZE
@@ -5237,7 +5253,8 @@ typedef struct ur_program_properties_t {
 UR_APIEXPORT ur_result_t UR_APICALL urProgramCreateWithIL(
     /// [in] handle of the context instance
     ur_context_handle_t hContext,
-    /// [in] pointer to IL binary.
+    /// [in][optional] pointer to IL binary. May only be NULL if the IL is
+    /// given by a ::ur_exp_program_file_source_t chained to `pProperties`.
     const void *pIL,
     /// [in] length of `pIL` in bytes.
     size_t length,
@@ -5275,8 +5292,9 @@ UR_APIEXPORT ur_result_t UR_APICALL urProgramCreateWithIL(
 ///     - ::UR_RESULT_ERROR_INVALID_NULL_POINTER
 ///         + `NULL == phDevices`
 ///         + `NULL == pLengths`
-///         + `NULL == ppBinaries`
 ///         + `NULL == phProgram`
+///         + `NULL == ppBinaries && NULL ==
+///         find_stype_node<ur_exp_program_file_source_t>(pProperties)`
 ///         + `NULL != pProperties && pProperties->count > 0 && NULL ==
 ///         pProperties->pMetadatas`
 ///     - ::UR_RESULT_ERROR_INVALID_SIZE
@@ -5297,8 +5315,10 @@ UR_APIEXPORT ur_result_t UR_APICALL urProgramCreateWithBinary(
     /// [in][range(0, numDevices)] array of sizes of program binaries
     /// specified by `pBinaries` (in bytes).
     size_t *pLengths,
-    /// [in][range(0, numDevices)] pointer to program binaries to be loaded
-    /// for devices specified by `phDevices`.
+    /// [in][optional][range(0, numDevices)] pointer to program binaries to be
+    /// loaded for devices specified by `phDevices`. May only be NULL if the
+    /// binaries are given by a ::ur_exp_program_file_source_t chained to
+    /// `pProperties`.
     const uint8_t **ppBinaries,
     /// [in][optional] pointer to program creation properties.
     const ur_program_properties_t *pProperties,
@@ -7054,6 +7074,14 @@ typedef enum ur_command_t {
   UR_COMMAND_TIMESTAMP_RECORDING_EXP = 0x2002,
   /// Event created by ::urEnqueueNativeCommandExp
   UR_COMMAND_ENQUEUE_NATIVE_EXP = 0x2004,
+  /// Event created by ::urEnqueueBatchExp
+  UR_COMMAND_ENQUEUE_BATCH_EXP = 0x2005,
+  /// Event created by ::urEnqueueHostTaskExp
+  UR_COMMAND_ENQUEUE_HOST_TASK_EXP = 0x2006,
+  /// Event created by ::urEnqueueUSMAllocExp
+  UR_COMMAND_ENQUEUE_USM_ALLOC_EXP = 0x2007,
+  /// Event created by ::urEnqueueUSMFreeExp
+  UR_COMMAND_ENQUEUE_USM_FREE_EXP = 0x2008,
   /// @cond
   UR_COMMAND_FORCE_UINT32 = 0x7fffffff
   /// @endcond
@@ -11884,6 +11912,379 @@ UR_APIEXPORT ur_result_t UR_APICALL urUsmP2PPeerAccessGetInfoExp(
     /// propName.
     size_t *pPropSizeRet);
 
+#if !defined(__GNUC__)
+#pragma endregion
+#endif
+// Intel 'oneAPI' Unified Runtime Experimental API for enqueuing batches of
+// commands
+#if !defined(__GNUC__)
+#pragma region enqueue_batch_(experimental)
+#endif
+///////////////////////////////////////////////////////////////////////////////
+#ifndef UR_ENQUEUE_BATCH_EXTENSION_STRING_EXP
+/// @brief The extension string that defines support for the enqueue batch
+///        extension, which is returned when querying device extensions.
+#define UR_ENQUEUE_BATCH_EXTENSION_STRING_EXP "ur_exp_enqueue_batch"
+#endif // UR_ENQUEUE_BATCH_EXTENSION_STRING_EXP
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Type of a command in a batch
+typedef enum ur_exp_batch_command_type_t {
+  /// Kernel launch, as enqueued by ::urEnqueueKernelLaunch
+  UR_EXP_BATCH_COMMAND_TYPE_KERNEL_LAUNCH = 0,
+  /// Non-blocking USM copy, as enqueued by ::urEnqueueUSMMemcpy
+  UR_EXP_BATCH_COMMAND_TYPE_USM_MEMCPY = 1,
+  /// USM fill, as enqueued by ::urEnqueueUSMFill
+  UR_EXP_BATCH_COMMAND_TYPE_USM_FILL = 2,
+  /// Barrier between the earlier and the later commands of the batch
+  UR_EXP_BATCH_COMMAND_TYPE_BARRIER = 3,
+  /// @cond
+  UR_EXP_BATCH_COMMAND_TYPE_FORCE_UINT32 = 0x7fffffff
+  /// @endcond
+
+} ur_exp_batch_command_type_t;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Arguments of a batched kernel launch
+typedef struct ur_exp_batch_kernel_launch_args_t {
+  /// [in] handle of the kernel object
+  ur_kernel_handle_t hKernel;
+  /// [in] number of dimensions, from 1 to 3, to specify the global and
+  /// work-group work-items
+  uint32_t workDim;
+  /// [in][optional] pointer to an array of workDim unsigned values that
+  /// specify the offset used to calculate the global ID of a work-item
+  const size_t *pGlobalWorkOffset;
+  /// [in] pointer to an array of workDim unsigned values that specify the
+  /// number of global work-items in workDim that will execute the kernel
+  /// function
+  const size_t *pGlobalWorkSize;
+  /// [in][optional] pointer to an array of workDim unsigned values that
+  /// specify the number of local work-items forming a work-group that will
+  /// execute the kernel function. If nullptr, the runtime implementation
+  /// will choose the work-group size.
+  const size_t *pLocalWorkSize;
+
+} ur_exp_batch_kernel_launch_args_t;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Arguments of a batched USM copy
+typedef struct ur_exp_batch_usm_memcpy_args_t {
+  /// [in] pointer to the destination USM memory object
+  void *pDst;
+  /// [in] pointer to the source USM memory object
+  const void *pSrc;
+  /// [in] size in bytes to be copied
+  size_t size;
+
+} ur_exp_batch_usm_memcpy_args_t;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Arguments of a batched USM fill
+typedef struct ur_exp_batch_usm_fill_args_t {
+  /// [in] pointer to USM memory object
+  void *pMem;
+  /// [in] the size in bytes of the pattern. Must be a power of 2 and less
+  /// than or equal to width.
+  size_t patternSize;
+  /// [in] pointer with the bytes of the pattern to set.
+  const void *pPattern;
+  /// [in] size in bytes to be set. Must be a multiple of patternSize.
+  size_t size;
+
+} ur_exp_batch_usm_fill_args_t;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Arguments of a command in a batch
+typedef union ur_exp_batch_command_args_t {
+  /// [in] kernel launch arguments
+  ur_exp_batch_kernel_launch_args_t kernelLaunch;
+  /// [in] USM copy arguments
+  ur_exp_batch_usm_memcpy_args_t usmMemcpy;
+  /// [in] USM fill arguments
+  ur_exp_batch_usm_fill_args_t usmFill;
+
+} ur_exp_batch_command_args_t;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Command in a batch
+typedef struct ur_exp_batch_command_t {
+  /// [in] type of the command
+  ur_exp_batch_command_type_t type;
+  /// [in][tagged_by(type)] arguments of the command, unused by barriers
+  ur_exp_batch_command_args_t args;
+  /// [in] number of commands of the batch that must complete before this
+  /// one
+  uint32_t numDepsInBatch;
+  /// [in][optional][range(0, numDepsInBatch)] indices in the batch of the
+  /// commands that must complete before this one, which must all be lower
+  /// than the index of this command
+  const uint32_t *pDepsInBatch;
+
+} ur_exp_batch_command_t;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Enqueue a batch of commands
+///
+/// @details
+///     - Enqueues the commands of pCommands in a single call, so that adapters
+///       can record them in one go, e.g. into a single native command list or
+///       task graph.
+///     - Each command waits for the events in phEventWaitList, for the commands
+///       of the batch listed in its pDepsInBatch and for the earlier barrier
+///       commands of the batch. A barrier command waits for all the earlier
+///       commands of the batch.
+///     - On in-order queues, the commands are executed in the order of
+///       pCommands.
+///     - phEvent completes once all the commands of the batch complete.
+///     - Adapters that don't implement this entry point are served by the
+///       loader, which enqueues the commands one by one.
+///
+/// @returns
+///     - ::UR_RESULT_SUCCESS
+///     - ::UR_RESULT_ERROR_UNINITIALIZED
+///     - ::UR_RESULT_ERROR_DEVICE_LOST
+///     - ::UR_RESULT_ERROR_ADAPTER_SPECIFIC
+///     - ::UR_RESULT_ERROR_INVALID_NULL_HANDLE
+///         + `NULL == hQueue`
+///     - ::UR_RESULT_ERROR_INVALID_NULL_POINTER
+///         + `NULL == pCommands`
+///     - ::UR_RESULT_ERROR_INVALID_SIZE
+///         + `numCommands == 0`
+///     - ::UR_RESULT_ERROR_INVALID_VALUE
+///         + An index in pDepsInBatch is not lower than the index of its
+///         command.
+///     - ::UR_RESULT_ERROR_INVALID_KERNEL
+///     - ::UR_RESULT_ERROR_INVALID_WORK_DIMENSION
+///     - ::UR_RESULT_ERROR_INVALID_EVENT_WAIT_LIST
+///         + `phEventWaitList == NULL && numEventsInWaitList > 0`
+///         + `phEventWaitList != NULL && numEventsInWaitList == 0`
+///         + If event objects in phEventWaitList are not valid events.
+///     - ::UR_RESULT_ERROR_IN_EVENT_LIST_EXEC_STATUS
+///         + An event in phEventWaitList has ::UR_EVENT_STATUS_ERROR
+///     - ::UR_RESULT_ERROR_OUT_OF_HOST_MEMORY
+///     - ::UR_RESULT_ERROR_OUT_OF_RESOURCES
+UR_APIEXPORT ur_result_t UR_APICALL urEnqueueBatchExp(
+    /// [in] handle of the queue object
+    ur_queue_handle_t hQueue,
+    /// [in] number of commands in the batch
+    uint32_t numCommands,
+    /// [in][range(0, numCommands)] pointer to the commands of the batch
+    const ur_exp_batch_command_t *pCommands,
+    /// [in] size of the event wait list
+    uint32_t numEventsInWaitList,
+    /// [in][optional][range(0, numEventsInWaitList)] pointer to a list of
+    /// events that must be complete before the commands of the batch are
+    /// executed.
+    /// If nullptr, the numEventsInWaitList must be 0, indicating no wait
+    /// events.
+    const ur_event_handle_t *phEventWaitList,
+    /// [out][optional] return an event object that identifies the execution
+    /// of the whole batch.
+    /// If phEventWaitList and phEvent are not NULL, phEvent must not refer to
+    /// an element of the phEventWaitList array.
+    ur_event_handle_t *phEvent);
+
+#if !defined(__GNUC__)
+#pragma endregion
+#endif
+// Intel 'oneAPI' Unified Runtime Experimental API for enqueuing host tasks
+#if !defined(__GNUC__)
+#pragma region enqueue_host_task_(experimental)
+#endif
+///////////////////////////////////////////////////////////////////////////////
+#ifndef UR_ENQUEUE_HOST_TASK_EXTENSION_STRING_EXP
+/// @brief The extension string that defines support for the enqueue host task
+///        extension, which is returned when querying device extensions.
+#define UR_ENQUEUE_HOST_TASK_EXTENSION_STRING_EXP "ur_exp_enqueue_host_task"
+#endif // UR_ENQUEUE_HOST_TASK_EXTENSION_STRING_EXP
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Function executed on the host by ::urEnqueueHostTaskExp.
+typedef void (*ur_exp_host_task_function_t)(
+    /// [in][out] pointer to data to be passed to the host task
+    void *pUserData);
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Enqueue a function to be executed on the host
+///
+/// @details
+///     - pfnHostTask is called on a host thread once the events in
+///       phEventWaitList complete, and, on in-order queues, once the commands
+///       enqueued before it complete.
+///     - phEvent completes once pfnHostTask returns, and commands enqueued
+///       after it on in-order queues are executed after it returns.
+///     - pfnHostTask may be called before this function returns, and from a
+///       thread other than the calling one.
+///     - pfnHostTask must not enqueue commands to hQueue or wait for events of
+///       commands enqueued after it.
+///     - Adapters that don't implement this entry point are served by the
+///       loader, which waits for the dependencies of the host task and calls it
+///       before returning.
+///
+/// @returns
+///     - ::UR_RESULT_SUCCESS
+///     - ::UR_RESULT_ERROR_UNINITIALIZED
+///     - ::UR_RESULT_ERROR_DEVICE_LOST
+///     - ::UR_RESULT_ERROR_ADAPTER_SPECIFIC
+///     - ::UR_RESULT_ERROR_INVALID_NULL_HANDLE
+///         + `NULL == hQueue`
+///     - ::UR_RESULT_ERROR_INVALID_NULL_POINTER
+///         + `NULL == pfnHostTask`
+///     - ::UR_RESULT_ERROR_INVALID_EVENT_WAIT_LIST
+///         + `phEventWaitList == NULL && numEventsInWaitList > 0`
+///         + `phEventWaitList != NULL && numEventsInWaitList == 0`
+///         + If event objects in phEventWaitList are not valid events.
+///     - ::UR_RESULT_ERROR_IN_EVENT_LIST_EXEC_STATUS
+///         + An event in phEventWaitList has ::UR_EVENT_STATUS_ERROR
+///     - ::UR_RESULT_ERROR_OUT_OF_HOST_MEMORY
+///     - ::UR_RESULT_ERROR_OUT_OF_RESOURCES
+UR_APIEXPORT ur_result_t UR_APICALL urEnqueueHostTaskExp(
+    /// [in] handle of the queue object
+    ur_queue_handle_t hQueue,
+    /// [in] function to be executed on the host
+    ur_exp_host_task_function_t pfnHostTask,
+    /// [in][optional] data passed to pfnHostTask
+    void *pUserData,
+    /// [in] size of the event wait list
+    uint32_t numEventsInWaitList,
+    /// [in][optional][range(0, numEventsInWaitList)] pointer to a list of
+    /// events that must be complete before pfnHostTask is called.
+    /// If nullptr, the numEventsInWaitList must be 0, indicating no wait
+    /// events.
+    const ur_event_handle_t *phEventWaitList,
+    /// [out][optional] return an event object that identifies the execution
+    /// of the host task.
+    /// If phEventWaitList and phEvent are not NULL, phEvent must not refer to
+    /// an element of the phEventWaitList array.
+    ur_event_handle_t *phEvent);
+
+#if !defined(__GNUC__)
+#pragma endregion
+#endif
+// Intel 'oneAPI' Unified Runtime Experimental API for queue-ordered USM
+// allocations
+#if !defined(__GNUC__)
+#pragma region enqueue_usm_alloc_(experimental)
+#endif
+///////////////////////////////////////////////////////////////////////////////
+#ifndef UR_ENQUEUE_USM_ALLOC_EXTENSION_STRING_EXP
+/// @brief The extension string that defines support for the enqueue USM
+///        allocation extension, which is returned when querying device
+///        extensions.
+#define UR_ENQUEUE_USM_ALLOC_EXTENSION_STRING_EXP "ur_exp_enqueue_usm_alloc"
+#endif // UR_ENQUEUE_USM_ALLOC_EXTENSION_STRING_EXP
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Enqueue an allocation of USM device memory
+///
+/// @details
+///     - Allocates device memory on the device of hQueue, which can be used by
+///       the commands enqueued after this one on hQueue, or by commands that
+///       wait for phEvent.
+///     - The allocation is served from a memory arena owned by hQueue, and must
+///       be freed with ::urEnqueueUSMFreeExp on the same queue. It must not be
+///       freed with ::urUSMFree.
+///     - Memory freed with ::urEnqueueUSMFreeExp is reused by later allocations
+///       on hQueue once the free completes, or right away on in-order queues.
+///     - Any memory still allocated from the arena is released together with
+///       hQueue.
+///
+/// @returns
+///     - ::UR_RESULT_SUCCESS
+///     - ::UR_RESULT_ERROR_UNINITIALIZED
+///     - ::UR_RESULT_ERROR_DEVICE_LOST
+///     - ::UR_RESULT_ERROR_ADAPTER_SPECIFIC
+///     - ::UR_RESULT_ERROR_INVALID_NULL_HANDLE
+///         + `NULL == hQueue`
+///     - ::UR_RESULT_ERROR_INVALID_ENUMERATION
+///         + `NULL != pUSMDesc && ::UR_USM_ADVICE_FLAGS_MASK & pUSMDesc->hints`
+///     - ::UR_RESULT_ERROR_INVALID_NULL_POINTER
+///         + `NULL == ppMem`
+///     - ::UR_RESULT_ERROR_INVALID_VALUE
+///         + `pUSMDesc && pUSMDesc->align != 0 && ((pUSMDesc->align &
+///         (pUSMDesc->align-1)) != 0)`
+///     - ::UR_RESULT_ERROR_INVALID_USM_SIZE
+///         + `size == 0`
+///         + `size` is greater than ::UR_DEVICE_INFO_MAX_MEM_ALLOC_SIZE.
+///     - ::UR_RESULT_ERROR_INVALID_EVENT_WAIT_LIST
+///         + `phEventWaitList == NULL && numEventsInWaitList > 0`
+///         + `phEventWaitList != NULL && numEventsInWaitList == 0`
+///         + If event objects in phEventWaitList are not valid events.
+///     - ::UR_RESULT_ERROR_IN_EVENT_LIST_EXEC_STATUS
+///         + An event in phEventWaitList has ::UR_EVENT_STATUS_ERROR
+///     - ::UR_RESULT_ERROR_OUT_OF_HOST_MEMORY
+///     - ::UR_RESULT_ERROR_OUT_OF_RESOURCES
+UR_APIEXPORT ur_result_t UR_APICALL urEnqueueUSMAllocExp(
+    /// [in] handle of the queue object
+    ur_queue_handle_t hQueue,
+    /// [in][optional] USM memory allocation descriptor, of which only the
+    /// alignment is used
+    const ur_usm_desc_t *pUSMDesc,
+    /// [in] minimum size in bytes of the USM memory object to be allocated
+    size_t size,
+    /// [in] size of the event wait list
+    uint32_t numEventsInWaitList,
+    /// [in][optional][range(0, numEventsInWaitList)] pointer to a list of
+    /// events that must be complete before the allocation can be used.
+    /// If nullptr, the numEventsInWaitList must be 0, indicating no wait
+    /// events.
+    const ur_event_handle_t *phEventWaitList,
+    /// [out] pointer to USM device memory object
+    void **ppMem,
+    /// [out][optional] return an event object that identifies this particular
+    /// command instance.
+    /// If phEventWaitList and phEvent are not NULL, phEvent must not refer to
+    /// an element of the phEventWaitList array.
+    ur_event_handle_t *phEvent);
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Enqueue the release of USM memory allocated by ::urEnqueueUSMAllocExp
+///
+/// @details
+///     - The memory is released once the events in phEventWaitList complete,
+///       and, on in-order queues, once the commands enqueued before this one
+///       complete.
+///     - pMem must have been returned by ::urEnqueueUSMAllocExp on hQueue, and
+///       must not be used by commands enqueued after this one.
+///
+/// @returns
+///     - ::UR_RESULT_SUCCESS
+///     - ::UR_RESULT_ERROR_UNINITIALIZED
+///     - ::UR_RESULT_ERROR_DEVICE_LOST
+///     - ::UR_RESULT_ERROR_ADAPTER_SPECIFIC
+///     - ::UR_RESULT_ERROR_INVALID_NULL_HANDLE
+///         + `NULL == hQueue`
+///     - ::UR_RESULT_ERROR_INVALID_NULL_POINTER
+///         + `NULL == pMem`
+///     - ::UR_RESULT_ERROR_INVALID_VALUE
+///         + pMem was not allocated by ::urEnqueueUSMAllocExp on hQueue.
+///     - ::UR_RESULT_ERROR_INVALID_EVENT_WAIT_LIST
+///         + `phEventWaitList == NULL && numEventsInWaitList > 0`
+///         + `phEventWaitList != NULL && numEventsInWaitList == 0`
+///         + If event objects in phEventWaitList are not valid events.
+///     - ::UR_RESULT_ERROR_IN_EVENT_LIST_EXEC_STATUS
+///         + An event in phEventWaitList has ::UR_EVENT_STATUS_ERROR
+///     - ::UR_RESULT_ERROR_OUT_OF_HOST_MEMORY
+///     - ::UR_RESULT_ERROR_OUT_OF_RESOURCES
+UR_APIEXPORT ur_result_t UR_APICALL urEnqueueUSMFreeExp(
+    /// [in] handle of the queue object
+    ur_queue_handle_t hQueue,
+    /// [in] pointer to USM memory object allocated by ::urEnqueueUSMAllocExp
+    void *pMem,
+    /// [in] size of the event wait list
+    uint32_t numEventsInWaitList,
+    /// [in][optional][range(0, numEventsInWaitList)] pointer to a list of
+    /// events that must be complete before the memory is released.
+    /// If nullptr, the numEventsInWaitList must be 0, indicating no wait
+    /// events.
+    const ur_event_handle_t *phEventWaitList,
+    /// [out][optional] return an event object that identifies this particular
+    /// command instance.
+    /// If phEventWaitList and phEvent are not NULL, phEvent must not refer to
+    /// an element of the phEventWaitList array.
+    ur_event_handle_t *phEvent);
+
 #if !defined(__GNUC__)
 #pragma endregion
 #endif
@@ -12065,6 +12466,59 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueNativeCommandExp(
     /// array.
     ur_event_handle_t *phEvent);
 
+#if !defined(__GNUC__)
+#pragma endregion
+#endif
+// Intel 'oneAPI' Unified Runtime Experimental API for creating programs from
+// files
+#if !defined(__GNUC__)
+#pragma region program_file_source_(experimental)
+#endif
+///////////////////////////////////////////////////////////////////////////////
+#ifndef UR_PROGRAM_FILE_SOURCE_EXTENSION_STRING_EXP
+/// @brief The extension string that defines support for the program file source
+///        extension, which is returned when querying device extensions.
+#define UR_PROGRAM_FILE_SOURCE_EXTENSION_STRING_EXP                            \
+  "ur_exp_program_file_source"
+#endif // UR_PROGRAM_FILE_SOURCE_EXTENSION_STRING_EXP
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Region of a file holding the source of a program.
+typedef struct ur_exp_file_region_t {
+  /// [in] descriptor of a file open for reading.
+  int fd;
+  /// [in] offset of the region in the file, in bytes.
+  uint64_t offset;
+
+} ur_exp_file_region_t;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Program creation properties giving the sources of the program as
+///        regions of files, which are mapped rather than read.
+///
+/// @details
+///     - Chained to the pNext of the ::ur_program_properties_t passed to
+///       ::urProgramCreateWithIL or ::urProgramCreateWithBinary, in which case
+///       `pIL` or `ppBinaries` may be NULL, and the source is read from the
+///       regions instead.
+///     - The lengths of the regions are given by `length` or `pLengths`.
+///     - The file descriptors may be closed once the program has been created.
+typedef struct ur_exp_program_file_source_t {
+  /// [in] type of this structure, must be
+  /// ::UR_STRUCTURE_TYPE_EXP_PROGRAM_FILE_SOURCE
+  ur_structure_type_t stype;
+  /// [in,out][optional] pointer to extension-specific structure
+  void *pNext;
+  /// [in] number of entries in pRegions, which must be 1 for
+  /// ::urProgramCreateWithIL, or `numDevices` for
+  /// ::urProgramCreateWithBinary.
+  uint32_t count;
+  /// [in][range(0, count)] the region holding the IL, or the region holding
+  /// the binary of each device in `phDevices`.
+  const ur_exp_file_region_t *pRegions;
+
+} ur_exp_program_file_source_t;
+
 #if !defined(__GNUC__)
 #pragma endregion
 #endif
@@ -13482,6 +13936,58 @@ typedef struct ur_enqueue_kernel_launch_custom_exp_params_t {
   ur_event_handle_t **pphEvent;
 } ur_enqueue_kernel_launch_custom_exp_params_t;
 
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Function parameters for urEnqueueBatchExp
+/// @details Each entry is a pointer to the parameter passed to the function;
+///     allowing the callback the ability to modify the parameter's value
+typedef struct ur_enqueue_batch_exp_params_t {
+  ur_queue_handle_t *phQueue;
+  uint32_t *pnumCommands;
+  const ur_exp_batch_command_t **ppCommands;
+  uint32_t *pnumEventsInWaitList;
+  const ur_event_handle_t **pphEventWaitList;
+  ur_event_handle_t **pphEvent;
+} ur_enqueue_batch_exp_params_t;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Function parameters for urEnqueueHostTaskExp
+/// @details Each entry is a pointer to the parameter passed to the function;
+///     allowing the callback the ability to modify the parameter's value
+typedef struct ur_enqueue_host_task_exp_params_t {
+  ur_queue_handle_t *phQueue;
+  ur_exp_host_task_function_t *ppfnHostTask;
+  void **ppUserData;
+  uint32_t *pnumEventsInWaitList;
+  const ur_event_handle_t **pphEventWaitList;
+  ur_event_handle_t **pphEvent;
+} ur_enqueue_host_task_exp_params_t;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Function parameters for urEnqueueUSMAllocExp
+/// @details Each entry is a pointer to the parameter passed to the function;
+///     allowing the callback the ability to modify the parameter's value
+typedef struct ur_enqueue_usm_alloc_exp_params_t {
+  ur_queue_handle_t *phQueue;
+  const ur_usm_desc_t **ppUSMDesc;
+  size_t *psize;
+  uint32_t *pnumEventsInWaitList;
+  const ur_event_handle_t **pphEventWaitList;
+  void ***pppMem;
+  ur_event_handle_t **pphEvent;
+} ur_enqueue_usm_alloc_exp_params_t;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Function parameters for urEnqueueUSMFreeExp
+/// @details Each entry is a pointer to the parameter passed to the function;
+///     allowing the callback the ability to modify the parameter's value
+typedef struct ur_enqueue_usm_free_exp_params_t {
+  ur_queue_handle_t *phQueue;
+  void **ppMem;
+  uint32_t *pnumEventsInWaitList;
+  const ur_event_handle_t **pphEventWaitList;
+  ur_event_handle_t **pphEvent;
+} ur_enqueue_usm_free_exp_params_t;
+
 ///////////////////////////////////////////////////////////////////////////////
 /// @brief Function parameters for urEnqueueEventsWaitWithBarrierExt
 /// @details Each entry is a pointer to the parameter passed to the function;
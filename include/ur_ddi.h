@@ -1117,6 +1117,30 @@ typedef ur_result_t(UR_APICALL *ur_pfnEnqueueKernelLaunchCustomExp_t)(
     const size_t *, const size_t *, uint32_t, const ur_exp_launch_property_t *,
     uint32_t, const ur_event_handle_t *, ur_event_handle_t *);
 
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Function-pointer for urEnqueueBatchExp
+typedef ur_result_t(UR_APICALL *ur_pfnEnqueueBatchExp_t)(
+    ur_queue_handle_t, uint32_t, const ur_exp_batch_command_t *, uint32_t,
+    const ur_event_handle_t *, ur_event_handle_t *);
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Function-pointer for urEnqueueHostTaskExp
+typedef ur_result_t(UR_APICALL *ur_pfnEnqueueHostTaskExp_t)(
+    ur_queue_handle_t, ur_exp_host_task_function_t, void *, uint32_t,
+    const ur_event_handle_t *, ur_event_handle_t *);
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Function-pointer for urEnqueueUSMAllocExp
+typedef ur_result_t(UR_APICALL *ur_pfnEnqueueUSMAllocExp_t)(
+    ur_queue_handle_t, const ur_usm_desc_t *, size_t, uint32_t,
+    const ur_event_handle_t *, void **, ur_event_handle_t *);
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Function-pointer for urEnqueueUSMFreeExp
+typedef ur_result_t(UR_APICALL *ur_pfnEnqueueUSMFreeExp_t)(
+    ur_queue_handle_t, void *, uint32_t, const ur_event_handle_t *,
+    ur_event_handle_t *);
+
 ///////////////////////////////////////////////////////////////////////////////
 /// @brief Function-pointer for urEnqueueCooperativeKernelLaunchExp
 typedef ur_result_t(UR_APICALL *ur_pfnEnqueueCooperativeKernelLaunchExp_t)(
@@ -1142,6 +1166,10 @@ typedef ur_result_t(UR_APICALL *ur_pfnEnqueueNativeCommandExp_t)(
 /// @brief Table of EnqueueExp functions pointers
 typedef struct ur_enqueue_exp_dditable_t {
   ur_pfnEnqueueKernelLaunchCustomExp_t pfnKernelLaunchCustomExp;
+  ur_pfnEnqueueBatchExp_t pfnBatchExp;
+  ur_pfnEnqueueHostTaskExp_t pfnHostTaskExp;
+  ur_pfnEnqueueUSMAllocExp_t pfnUSMAllocExp;
+  ur_pfnEnqueueUSMFreeExp_t pfnUSMFreeExp;
   ur_pfnEnqueueCooperativeKernelLaunchExp_t pfnCooperativeKernelLaunchExp;
   ur_pfnEnqueueTimestampRecordingExp_t pfnTimestampRecordingExp;
   ur_pfnEnqueueNativeCommandExp_t pfnNativeCommandExp;
@@ -250,6 +250,10 @@ template <>
 inline ur_result_t printTagged(std::ostream &os, const void *ptr,
                                ur_exp_peer_info_t value, size_t size);
 
+inline ur_result_t printUnion(std::ostream &os,
+                              const union ur_exp_batch_command_args_t params,
+                              const enum ur_exp_batch_command_type_t tag);
+
 template <>
 inline ur_result_t printFlag<ur_exp_enqueue_ext_flag_t>(std::ostream &os,
                                                         uint32_t flag);
@@ -565,6 +569,20 @@ operator<<(std::ostream &os,
            [[maybe_unused]] const struct ur_exp_launch_property_t params);
 inline std::ostream &operator<<(std::ostream &os,
                                 enum ur_exp_peer_info_t value);
+inline std::ostream &operator<<(std::ostream &os,
+                                enum ur_exp_batch_command_type_t value);
+inline std::ostream &operator<<(
+    std::ostream &os,
+    [[maybe_unused]] const struct ur_exp_batch_kernel_launch_args_t params);
+inline std::ostream &
+operator<<(std::ostream &os,
+           [[maybe_unused]] const struct ur_exp_batch_usm_memcpy_args_t params);
+inline std::ostream &
+operator<<(std::ostream &os,
+           [[maybe_unused]] const struct ur_exp_batch_usm_fill_args_t params);
+inline std::ostream &
+operator<<(std::ostream &os,
+           [[maybe_unused]] const struct ur_exp_batch_command_t params);
 inline std::ostream &operator<<(std::ostream &os,
                                 enum ur_exp_enqueue_ext_flag_t value);
 inline std::ostream &operator<<(
@@ -576,6 +594,12 @@ inline std::ostream &operator<<(
     std::ostream &os,
     [[maybe_unused]] const struct ur_exp_enqueue_native_command_properties_t
         params);
+inline std::ostream &
+operator<<(std::ostream &os,
+           [[maybe_unused]] const struct ur_exp_file_region_t params);
+inline std::ostream &
+operator<<(std::ostream &os,
+           [[maybe_unused]] const struct ur_exp_program_file_source_t params);
 
 ///////////////////////////////////////////////////////////////////////////////
 /// @brief Print operator for the ur_function_t type
@@ -1177,6 +1201,18 @@ inline std::ostream &operator<<(std::ostream &os, enum ur_function_t value) {
   case UR_FUNCTION_PHYSICAL_MEM_GET_INFO:
     os << "UR_FUNCTION_PHYSICAL_MEM_GET_INFO";
     break;
+  case UR_FUNCTION_ENQUEUE_BATCH_EXP:
+    os << "UR_FUNCTION_ENQUEUE_BATCH_EXP";
+    break;
+  case UR_FUNCTION_ENQUEUE_HOST_TASK_EXP:
+    os << "UR_FUNCTION_ENQUEUE_HOST_TASK_EXP";
+    break;
+  case UR_FUNCTION_ENQUEUE_USM_ALLOC_EXP:
+    os << "UR_FUNCTION_ENQUEUE_USM_ALLOC_EXP";
+    break;
+  case UR_FUNCTION_ENQUEUE_USM_FREE_EXP:
+    os << "UR_FUNCTION_ENQUEUE_USM_FREE_EXP";
+    break;
   default:
     os << "unknown enumerator";
     break;
@@ -1340,6 +1376,9 @@ inline std::ostream &operator<<(std::ostream &os,
   case UR_STRUCTURE_TYPE_EXP_ENQUEUE_EXT_PROPERTIES:
     os << "UR_STRUCTURE_TYPE_EXP_ENQUEUE_EXT_PROPERTIES";
     break;
+  case UR_STRUCTURE_TYPE_EXP_PROGRAM_FILE_SOURCE:
+    os << "UR_STRUCTURE_TYPE_EXP_PROGRAM_FILE_SOURCE";
+    break;
   default:
     os << "unknown enumerator";
     break;
@@ -1644,6 +1683,12 @@ inline ur_result_t printStruct(std::ostream &os, const void *ptr) {
         (const ur_exp_enqueue_ext_properties_t *)ptr;
     printPtr(os, pstruct);
   } break;
+
+  case UR_STRUCTURE_TYPE_EXP_PROGRAM_FILE_SOURCE: {
+    const ur_exp_program_file_source_t *pstruct =
+        (const ur_exp_program_file_source_t *)ptr;
+    printPtr(os, pstruct);
+  } break;
   default:
     os << "unknown enumerator";
     return UR_RESULT_ERROR_INVALID_ENUMERATION;
@@ -2182,6 +2227,9 @@ inline std::ostream &operator<<(std::ostream &os,
   case UR_ADAPTER_INFO_VERSION:
     os << "UR_ADAPTER_INFO_VERSION";
     break;
+  case UR_ADAPTER_INFO_LATENCY_HISTOGRAM_EXP:
+    os << "UR_ADAPTER_INFO_LATENCY_HISTOGRAM_EXP";
+    break;
   default:
     os << "unknown enumerator";
     break;
@@ -2238,6 +2286,11 @@ inline ur_result_t printTagged(std::ostream &os, const void *ptr,
 
     os << ")";
   } break;
+  case UR_ADAPTER_INFO_LATENCY_HISTOGRAM_EXP: {
+
+    const char *tptr = (const char *)ptr;
+    printPtr(os, tptr);
+  } break;
   default:
     os << "unknown enumerator";
     return UR_RESULT_ERROR_INVALID_ENUMERATION;
@@ -9914,6 +9967,18 @@ inline std::ostream &operator<<(std::ostream &os, enum ur_command_t value) {
   case UR_COMMAND_ENQUEUE_NATIVE_EXP:
     os << "UR_COMMAND_ENQUEUE_NATIVE_EXP";
     break;
+  case UR_COMMAND_ENQUEUE_BATCH_EXP:
+    os << "UR_COMMAND_ENQUEUE_BATCH_EXP";
+    break;
+  case UR_COMMAND_ENQUEUE_HOST_TASK_EXP:
+    os << "UR_COMMAND_ENQUEUE_HOST_TASK_EXP";
+    break;
+  case UR_COMMAND_ENQUEUE_USM_ALLOC_EXP:
+    os << "UR_COMMAND_ENQUEUE_USM_ALLOC_EXP";
+    break;
+  case UR_COMMAND_ENQUEUE_USM_FREE_EXP:
+    os << "UR_COMMAND_ENQUEUE_USM_FREE_EXP";
+    break;
   default:
     os << "unknown enumerator";
     break;
@@ -11478,6 +11543,202 @@ inline ur_result_t printTagged(std::ostream &os, const void *ptr,
 }
 } // namespace ur::details
 
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Print operator for the ur_exp_batch_command_type_t type
+/// @returns
+///     std::ostream &
+inline std::ostream &operator<<(std::ostream &os,
+                                enum ur_exp_batch_command_type_t value) {
+  switch (value) {
+  case UR_EXP_BATCH_COMMAND_TYPE_KERNEL_LAUNCH:
+    os << "UR_EXP_BATCH_COMMAND_TYPE_KERNEL_LAUNCH";
+    break;
+  case UR_EXP_BATCH_COMMAND_TYPE_USM_MEMCPY:
+    os << "UR_EXP_BATCH_COMMAND_TYPE_USM_MEMCPY";
+    break;
+  case UR_EXP_BATCH_COMMAND_TYPE_USM_FILL:
+    os << "UR_EXP_BATCH_COMMAND_TYPE_USM_FILL";
+    break;
+  case UR_EXP_BATCH_COMMAND_TYPE_BARRIER:
+    os << "UR_EXP_BATCH_COMMAND_TYPE_BARRIER";
+    break;
+  default:
+    os << "unknown enumerator";
+    break;
+  }
+  return os;
+}
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Print operator for the ur_exp_batch_kernel_launch_args_t type
+/// @returns
+///     std::ostream &
+inline std::ostream &
+operator<<(std::ostream &os,
+           const struct ur_exp_batch_kernel_launch_args_t params) {
+  os << "(struct ur_exp_batch_kernel_launch_args_t){";
+
+  os << ".hKernel = ";
+
+  ur::details::printPtr(os, (params.hKernel));
+
+  os << ", ";
+  os << ".workDim = ";
+
+  os << (params.workDim);
+
+  os << ", ";
+  os << ".pGlobalWorkOffset = ";
+
+  ur::details::printPtr(os, (params.pGlobalWorkOffset));
+
+  os << ", ";
+  os << ".pGlobalWorkSize = ";
+
+  ur::details::printPtr(os, (params.pGlobalWorkSize));
+
+  os << ", ";
+  os << ".pLocalWorkSize = ";
+
+  ur::details::printPtr(os, (params.pLocalWorkSize));
+
+  os << "}";
+  return os;
+}
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Print operator for the ur_exp_batch_usm_memcpy_args_t type
+/// @returns
+///     std::ostream &
+inline std::ostream &
+operator<<(std::ostream &os,
+           const struct ur_exp_batch_usm_memcpy_args_t params) {
+  os << "(struct ur_exp_batch_usm_memcpy_args_t){";
+
+  os << ".pDst = ";
+
+  ur::details::printPtr(os, (params.pDst));
+
+  os << ", ";
+  os << ".pSrc = ";
+
+  ur::details::printPtr(os, (params.pSrc));
+
+  os << ", ";
+  os << ".size = ";
+
+  os << (params.size);
+
+  os << "}";
+  return os;
+}
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Print operator for the ur_exp_batch_usm_fill_args_t type
+/// @returns
+///     std::ostream &
+inline std::ostream &
+operator<<(std::ostream &os, const struct ur_exp_batch_usm_fill_args_t params) {
+  os << "(struct ur_exp_batch_usm_fill_args_t){";
+
+  os << ".pMem = ";
+
+  ur::details::printPtr(os, (params.pMem));
+
+  os << ", ";
+  os << ".patternSize = ";
+
+  os << (params.patternSize);
+
+  os << ", ";
+  os << ".pPattern = ";
+
+  ur::details::printPtr(os, (params.pPattern));
+
+  os << ", ";
+  os << ".size = ";
+
+  os << (params.size);
+
+  os << "}";
+  return os;
+}
+namespace ur::details {
+
+///////////////////////////////////////////////////////////////////////////////
+// @brief Print ur_exp_batch_command_args_t union
+inline ur_result_t printUnion(std::ostream &os,
+                              const union ur_exp_batch_command_args_t params,
+                              const enum ur_exp_batch_command_type_t tag) {
+  os << "(union ur_exp_batch_command_args_t){";
+
+  switch (tag) {
+  case UR_EXP_BATCH_COMMAND_TYPE_KERNEL_LAUNCH:
+
+    os << ".kernelLaunch = ";
+
+    os << (params.kernelLaunch);
+
+    break;
+  case UR_EXP_BATCH_COMMAND_TYPE_USM_MEMCPY:
+
+    os << ".usmMemcpy = ";
+
+    os << (params.usmMemcpy);
+
+    break;
+  case UR_EXP_BATCH_COMMAND_TYPE_USM_FILL:
+
+    os << ".usmFill = ";
+
+    os << (params.usmFill);
+
+    break;
+  default:
+    os << "<unknown>";
+    return UR_RESULT_ERROR_INVALID_ENUMERATION;
+  }
+  os << "}";
+  return UR_RESULT_SUCCESS;
+}
+} // namespace ur::details
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Print operator for the ur_exp_batch_command_t type
+/// @returns
+///     std::ostream &
+inline std::ostream &operator<<(std::ostream &os,
+                                const struct ur_exp_batch_command_t params) {
+  os << "(struct ur_exp_batch_command_t){";
+
+  os << ".type = ";
+
+  os << (params.type);
+
+  os << ", ";
+  os << ".args = ";
+  ur::details::printUnion(os, (params.args), params.type);
+
+  os << ", ";
+  os << ".numDepsInBatch = ";
+
+  os << (params.numDepsInBatch);
+
+  os << ", ";
+  os << ".pDepsInBatch = ";
+  ur::details::printPtr(os,
+                        reinterpret_cast<const void *>((params.pDepsInBatch)));
+  if ((params.pDepsInBatch) != NULL) {
+    os << " {";
+    for (size_t i = 0; i < params.numDepsInBatch; ++i) {
+      if (i != 0) {
+        os << ", ";
+      }
+
+      os << ((params.pDepsInBatch))[i];
+    }
+    os << "}";
+  }
+
+  os << "}";
+  return os;
+}
 ///////////////////////////////////////////////////////////////////////////////
 /// @brief Print operator for the ur_exp_enqueue_ext_flag_t type
 /// @returns
@@ -11629,6 +11890,66 @@ operator<<(std::ostream &os,
   os << "}";
   return os;
 }
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Print operator for the ur_exp_file_region_t type
+/// @returns
+///     std::ostream &
+inline std::ostream &operator<<(std::ostream &os,
+                                const struct ur_exp_file_region_t params) {
+  os << "(struct ur_exp_file_region_t){";
+
+  os << ".fd = ";
+
+  os << (params.fd);
+
+  os << ", ";
+  os << ".offset = ";
+
+  os << (params.offset);
+
+  os << "}";
+  return os;
+}
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Print operator for the ur_exp_program_file_source_t type
+/// @returns
+///     std::ostream &
+inline std::ostream &
+operator<<(std::ostream &os, const struct ur_exp_program_file_source_t params) {
+  os << "(struct ur_exp_program_file_source_t){";
+
+  os << ".stype = ";
+
+  os << (params.stype);
+
+  os << ", ";
+  os << ".pNext = ";
+
+  ur::details::printStruct(os, (params.pNext));
+
+  os << ", ";
+  os << ".count = ";
+
+  os << (params.count);
+
+  os << ", ";
+  os << ".pRegions = ";
+  ur::details::printPtr(os, reinterpret_cast<const void *>((params.pRegions)));
+  if ((params.pRegions) != NULL) {
+    os << " {";
+    for (size_t i = 0; i < params.count; ++i) {
+      if (i != 0) {
+        os << ", ";
+      }
+
+      os << ((params.pRegions))[i];
+    }
+    os << "}";
+  }
+
+  os << "}";
+  return os;
+}
 
 ///////////////////////////////////////////////////////////////////////////////
 /// @brief Print operator for the ur_loader_config_create_params_t type
@@ -16158,6 +16479,221 @@ inline std::ostream &operator<<(
   return os;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Print operator for the ur_enqueue_batch_exp_params_t type
+/// @returns
+///     std::ostream &
+inline std::ostream &operator<<(
+    std::ostream &os,
+    [[maybe_unused]] const struct ur_enqueue_batch_exp_params_t *params) {
+
+  os << ".hQueue = ";
+
+  ur::details::printPtr(os, *(params->phQueue));
+
+  os << ", ";
+  os << ".numCommands = ";
+
+  os << *(params->pnumCommands);
+
+  os << ", ";
+  os << ".pCommands = ";
+  ur::details::printPtr(os,
+                        reinterpret_cast<const void *>(*(params->ppCommands)));
+  if (*(params->ppCommands) != NULL) {
+    os << " {";
+    for (size_t i = 0; i < *params->pnumCommands; ++i) {
+      if (i != 0) {
+        os << ", ";
+      }
+
+      os << (*(params->ppCommands))[i];
+    }
+    os << "}";
+  }
+
+  os << ", ";
+  os << ".numEventsInWaitList = ";
+
+  os << *(params->pnumEventsInWaitList);
+
+  os << ", ";
+  os << ".phEventWaitList = ";
+  ur::details::printPtr(
+      os, reinterpret_cast<const void *>(*(params->pphEventWaitList)));
+  if (*(params->pphEventWaitList) != NULL) {
+    os << " {";
+    for (size_t i = 0; i < *params->pnumEventsInWaitList; ++i) {
+      if (i != 0) {
+        os << ", ";
+      }
+
+      ur::details::printPtr(os, (*(params->pphEventWaitList))[i]);
+    }
+    os << "}";
+  }
+
+  os << ", ";
+  os << ".phEvent = ";
+
+  ur::details::printPtr(os, *(params->pphEvent));
+
+  return os;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Print operator for the ur_enqueue_host_task_exp_params_t type
+/// @returns
+///     std::ostream &
+inline std::ostream &operator<<(
+    std::ostream &os,
+    [[maybe_unused]] const struct ur_enqueue_host_task_exp_params_t *params) {
+
+  os << ".hQueue = ";
+
+  ur::details::printPtr(os, *(params->phQueue));
+
+  os << ", ";
+  os << ".pfnHostTask = ";
+
+  os << reinterpret_cast<void *>(*(params->ppfnHostTask));
+
+  os << ", ";
+  os << ".pUserData = ";
+
+  ur::details::printPtr(os, *(params->ppUserData));
+
+  os << ", ";
+  os << ".numEventsInWaitList = ";
+
+  os << *(params->pnumEventsInWaitList);
+
+  os << ", ";
+  os << ".phEventWaitList = ";
+  ur::details::printPtr(
+      os, reinterpret_cast<const void *>(*(params->pphEventWaitList)));
+  if (*(params->pphEventWaitList) != NULL) {
+    os << " {";
+    for (size_t i = 0; i < *params->pnumEventsInWaitList; ++i) {
+      if (i != 0) {
+        os << ", ";
+      }
+
+      ur::details::printPtr(os, (*(params->pphEventWaitList))[i]);
+    }
+    os << "}";
+  }
+
+  os << ", ";
+  os << ".phEvent = ";
+
+  ur::details::printPtr(os, *(params->pphEvent));
+
+  return os;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Print operator for the ur_enqueue_usm_alloc_exp_params_t type
+/// @returns
+///     std::ostream &
+inline std::ostream &operator<<(
+    std::ostream &os,
+    [[maybe_unused]] const struct ur_enqueue_usm_alloc_exp_params_t *params) {
+
+  os << ".hQueue = ";
+
+  ur::details::printPtr(os, *(params->phQueue));
+
+  os << ", ";
+  os << ".pUSMDesc = ";
+
+  ur::details::printPtr(os, *(params->ppUSMDesc));
+
+  os << ", ";
+  os << ".size = ";
+
+  os << *(params->psize);
+
+  os << ", ";
+  os << ".numEventsInWaitList = ";
+
+  os << *(params->pnumEventsInWaitList);
+
+  os << ", ";
+  os << ".phEventWaitList = ";
+  ur::details::printPtr(
+      os, reinterpret_cast<const void *>(*(params->pphEventWaitList)));
+  if (*(params->pphEventWaitList) != NULL) {
+    os << " {";
+    for (size_t i = 0; i < *params->pnumEventsInWaitList; ++i) {
+      if (i != 0) {
+        os << ", ";
+      }
+
+      ur::details::printPtr(os, (*(params->pphEventWaitList))[i]);
+    }
+    os << "}";
+  }
+
+  os << ", ";
+  os << ".ppMem = ";
+
+  ur::details::printPtr(os, *(params->pppMem));
+
+  os << ", ";
+  os << ".phEvent = ";
+
+  ur::details::printPtr(os, *(params->pphEvent));
+
+  return os;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Print operator for the ur_enqueue_usm_free_exp_params_t type
+/// @returns
+///     std::ostream &
+inline std::ostream &operator<<(
+    std::ostream &os,
+    [[maybe_unused]] const struct ur_enqueue_usm_free_exp_params_t *params) {
+
+  os << ".hQueue = ";
+
+  ur::details::printPtr(os, *(params->phQueue));
+
+  os << ", ";
+  os << ".pMem = ";
+
+  ur::details::printPtr(os, *(params->ppMem));
+
+  os << ", ";
+  os << ".numEventsInWaitList = ";
+
+  os << *(params->pnumEventsInWaitList);
+
+  os << ", ";
+  os << ".phEventWaitList = ";
+  ur::details::printPtr(
+      os, reinterpret_cast<const void *>(*(params->pphEventWaitList)));
+  if (*(params->pphEventWaitList) != NULL) {
+    os << " {";
+    for (size_t i = 0; i < *params->pnumEventsInWaitList; ++i) {
+      if (i != 0) {
+        os << ", ";
+      }
+
+      ur::details::printPtr(os, (*(params->pphEventWaitList))[i]);
+    }
+    os << "}";
+  }
+
+  os << ", ";
+  os << ".phEvent = ";
+
+  ur::details::printPtr(os, *(params->pphEvent));
+
+  return os;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// @brief Print operator for the
 /// ur_enqueue_events_wait_with_barrier_ext_params_t type
@@ -19886,6 +20422,18 @@ inline ur_result_t UR_APICALL printFunctionParams(std::ostream &os,
   case UR_FUNCTION_ENQUEUE_KERNEL_LAUNCH_CUSTOM_EXP: {
     os << (const struct ur_enqueue_kernel_launch_custom_exp_params_t *)params;
   } break;
+  case UR_FUNCTION_ENQUEUE_BATCH_EXP: {
+    os << (const struct ur_enqueue_batch_exp_params_t *)params;
+  } break;
+  case UR_FUNCTION_ENQUEUE_HOST_TASK_EXP: {
+    os << (const struct ur_enqueue_host_task_exp_params_t *)params;
+  } break;
+  case UR_FUNCTION_ENQUEUE_USM_ALLOC_EXP: {
+    os << (const struct ur_enqueue_usm_alloc_exp_params_t *)params;
+  } break;
+  case UR_FUNCTION_ENQUEUE_USM_FREE_EXP: {
+    os << (const struct ur_enqueue_usm_free_exp_params_t *)params;
+  } break;
   case UR_FUNCTION_ENQUEUE_EVENTS_WAIT_WITH_BARRIER_EXT: {
     os << (const struct ur_enqueue_events_wait_with_barrier_ext_params_t *)
             params;
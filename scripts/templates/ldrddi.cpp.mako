@@ -7,6 +7,13 @@ from templates import helper as th
 
     x=tags['$x']
     X=x.upper()
+
+    ## Entry points the loader implements on top of other entry points for
+    ## adapters that don't provide them, and the helpers implementing them.
+    fallbacks = {
+        "EnqueueBatchExp": "batch::enqueueByCommand",
+        "EnqueueHostTaskExp": "host_task::enqueueAndWait",
+    }
 %>/*
  *
  * Copyright (C) 2022-2023 Intel Corporation
@@ -20,6 +27,8 @@ from templates import helper as th
  * @file ${name}.cpp
  *
  */
+#include "${x}_enqueue_batch.hpp"
+#include "${x}_enqueue_host_task.hpp"
 #include "${x}_lib_loader.hpp"
 #include "${x}_loader.hpp"
 
@@ -152,8 +161,10 @@ namespace ur_loader
         // extract platform's function pointer table
         auto dditable = reinterpret_cast<${item['obj']}*>( ${item['pointer']}${item['name']} )->dditable;
         auto ${th.make_pfn_name(n, tags, obj)} = dditable->${n}.${th.get_table_name(n, tags, obj)}.${th.make_pfn_name(n, tags, obj)};
+        %if func_basename not in fallbacks:
         if( nullptr == ${th.make_pfn_name(n, tags, obj)} )
             return ${X}_RESULT_ERROR_UNINITIALIZED;
+        %endif
 
         <%break%>
         %endif
@@ -188,6 +199,15 @@ namespace ur_loader
         %endif
 
         %endfor
+        %if func_basename == "EnqueueBatchExp":
+        // convert loader handles in the commands to platform handles
+        auto pCommandsLocal = std::vector<${x}_exp_batch_command_t>(pCommands, pCommands + numCommands);
+        for( auto &command : pCommandsLocal )
+            if( ${X}_EXP_BATCH_COMMAND_TYPE_KERNEL_LAUNCH == command.type )
+                command.args.kernelLaunch.hKernel = reinterpret_cast<${x}_kernel_object_t*>( command.args.kernelLaunch.hKernel )->handle;
+        pCommands = pCommandsLocal.data();
+
+        %endif
 
         <%
         epilogue = th.get_loader_epilogue(specs, n, tags, obj, meta)
@@ -286,12 +306,21 @@ namespace ur_loader
         %endfor
         %endif
 
+        %if func_basename in fallbacks:
+        // forward to device-platform, or to the loader's implementation if it
+        // doesn't provide one
+        if( nullptr == ${th.make_pfn_name(n, tags, obj)} )
+            result = ${x}::${fallbacks[func_basename]}( ${x}::${fallbacks[func_basename].split("::")[0]}::getEnqueueFns(dditable->${n}), ${", ".join(th.make_param_lines(n, tags, obj, format=["name", "local"], replacements=param_replacements))} );
+        else
+            result = ${th.make_pfn_name(n, tags, obj)}( ${", ".join(th.make_param_lines(n, tags, obj, format=["name", "local"], replacements=param_replacements))} );
+        %else:
         // forward to device-platform
         %if add_local:
         result = ${th.make_pfn_name(n, tags, obj)}( ${", ".join(th.make_param_lines(n, tags, obj, format=["name", "local"], replacements=param_replacements))} );
         %else:
         result = ${th.make_pfn_name(n, tags, obj)}( ${", ".join(th.make_param_lines(n, tags, obj, format=["name"]))} );
         %endif
+        %endif
 <% 
         del param_replacements
         del add_local
@@ -372,6 +401,21 @@ namespace ur_loader
     #endif // ${th.subt(n, tags, obj['condition'])}
     %endif
 
+    %if func_basename in fallbacks:
+    ///////////////////////////////////////////////////////////////////////////////
+    /// @brief ${func_name} for adapters that don't provide it, when the
+    ///        platform's DDI tables are returned directly
+    __${x}dlllocal ${x}_result_t ${X}_APICALL ${func_name}Fallback(
+        %for line in th.make_param_lines(n, tags, obj):
+        ${line}
+        %endfor
+        )
+    {
+        auto &dditable = getContext()->platforms.front().dditable;
+        return ${x}::${fallbacks[func_basename]}( ${x}::${fallbacks[func_basename].split("::")[0]}::getEnqueueFns(dditable.${n}), ${", ".join(th.make_param_lines(n, tags, obj, format=["name"]))} );
+    }
+
+    %endif
     %endfor
 } // namespace ur_loader
 
@@ -441,6 +485,12 @@ ${tbl['export']['name']}(
         {
             // return pointers directly to platform's DDIs
             *pDdiTable = ur_loader::getContext()->platforms.front().dditable.${n}.${tbl['name']};
+            %if tbl['name'] == "EnqueueExp":
+            %for fallback in fallbacks:
+            if( nullptr == pDdiTable->pfn${fallback[len("Enqueue"):]} )
+                pDdiTable->pfn${fallback[len("Enqueue"):]} = ur_loader::${x}${fallback}Fallback;
+            %endfor
+            %endif
         }
     }
 
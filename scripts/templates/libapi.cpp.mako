@@ -29,6 +29,7 @@ def define_dbg(obj, tags):
  * @brief C++ library for ${n}
  *
  */
+#include "latency_tracker.hpp"
 #include "${x}_lib.hpp"
 
 extern "C" {
@@ -57,6 +58,9 @@ ${th.make_func_name(n, tags, obj)}(
     %endfor
     )
 try {
+%if obj['class'] == '$xEnqueue':
+    TRACK_SCOPE_LATENCY("${th.make_func_name(n, tags, obj)}");
+%endif
 %if th.obj_traits.is_loader_only(obj):
     return ur_lib::${th.make_func_name(n, tags, obj)}(${", ".join(th.make_param_lines(n, tags, obj, format=["name"]))} );
 %else:
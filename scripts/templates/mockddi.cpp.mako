@@ -94,6 +94,22 @@ namespace driver
                 auto parentDummyHandle =
                     reinterpret_cast<mock::dummy_handle_t>(hBuffer);
                 *ppRetMap = (void *)(parentDummyHandle->MData);
+            ## Host tasks run inline so tests can observe their side effects.
+            %elif re.search(r"EnqueueHostTaskExp$", fname):
+                pfnHostTask(pUserData);
+                if(phEvent) {
+                    *phEvent = mock::createDummyHandle<ur_event_handle_t>();
+                }
+            %elif re.search(r"EnqueueUSMAllocExp$", fname):
+                *ppMem = mock::createDummyHandle<void *>(size);
+                if(phEvent) {
+                    *phEvent = mock::createDummyHandle<ur_event_handle_t>();
+                }
+            %elif re.search(r"EnqueueUSMFreeExp$", fname):
+                mock::releaseDummyHandle(pMem);
+                if(phEvent) {
+                    *phEvent = mock::createDummyHandle<ur_event_handle_t>();
+                }
             %elif re.search(r"USM(Host|Device|Shared)Alloc$", fname):
                 *ppMem = mock::createDummyHandle<void *>(size);
             %elif re.search(r"USMPitchedAllocExp$", fname):
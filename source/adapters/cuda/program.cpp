@@ -495,6 +495,9 @@ UR_APIEXPORT ur_result_t UR_APICALL urProgramCreateWithBinary(
     ur_program_handle_t *phProgram) {
   if (numDevices > 1)
     return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  // Loading the binary from a file source chained to pProperties isn't
+  // supported.
+  UR_ASSERT(ppBinaries, UR_RESULT_ERROR_UNSUPPORTED_FEATURE);
 
   UR_CHECK_ERROR(createProgram(hContext, phDevices[0], pLengths[0],
                                ppBinaries[0], pProperties, phProgram));
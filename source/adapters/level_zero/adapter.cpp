@@ -10,6 +10,7 @@
 
 #include "adapter.hpp"
 #include "common.hpp"
+#include "latency_tracker.hpp"
 #include "ur_level_zero.hpp"
 #include <iomanip>
 
@@ -717,6 +718,12 @@ ur_result_t urAdapterGetInfo(ur_adapter_handle_t, ur_adapter_info_t PropName,
 #endif
     return ReturnValue(adapterVersion);
   }
+  case UR_ADAPTER_INFO_LATENCY_HISTOGRAM_EXP:
+#if defined(UR_ENABLE_LATENCY_HISTOGRAM)
+    return ReturnValue(globalLatencyPrinter().toString().c_str());
+#else
+    return UR_RESULT_ERROR_UNSUPPORTED_ENUMERATION;
+#endif
   default:
     return UR_RESULT_ERROR_INVALID_ENUMERATION;
   }
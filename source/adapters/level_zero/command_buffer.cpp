@@ -353,7 +353,8 @@ ur_exp_command_buffer_handle_t_::ur_exp_command_buffer_handle_t_(
     ur_event_handle_t ComputeFinishedEvent,
     const ur_exp_command_buffer_desc_t *Desc, const bool IsInOrderCmdList,
     const bool UseImmediateAppendPath)
-    : Context(Context), Device(Device), ZeComputeCommandList(CommandList),
+    : _ur_object("ur_exp_command_buffer_handle_t_::Mutex"), Context(Context),
+      Device(Device), ZeComputeCommandList(CommandList),
       ZeComputeCommandListTranslated(CommandListTranslated),
       ZeCommandListResetEvents(CommandListResetEvents),
       ZeCopyCommandList(CopyCommandList),
@@ -153,7 +153,8 @@ struct ur_exp_command_buffer_handle_t_ : public _ur_object {
 struct ur_exp_command_buffer_command_handle_t_ : public _ur_object {
   ur_exp_command_buffer_command_handle_t_(
       ur_exp_command_buffer_handle_t CommandBuffer, uint64_t CommandId)
-      : CommandBuffer(CommandBuffer), CommandId(CommandId) {}
+      : _ur_object("ur_exp_command_buffer_command_handle_t_::Mutex"),
+        CommandBuffer(CommandBuffer), CommandId(CommandId) {}
 
   virtual ~ur_exp_command_buffer_command_handle_t_() {}
 
@@ -411,7 +411,10 @@ private:
 
 // Base class to store common data
 struct _ur_object {
-  _ur_object() : RefCount{} {}
+  _ur_object() : _ur_object("_ur_object::Mutex") {}
+  // Derived objects name their mutex, so that the lock profile tells their
+  // kinds apart, see ur_shared_mutex.
+  explicit _ur_object(const char *MutexName) : RefCount{}, Mutex{MutexName} {}
 
   // Must be atomic to prevent data race when incrementing/decrementing.
   ReferenceCounter RefCount;
@@ -440,7 +443,7 @@ struct _ur_object {
 // for each memory allocation.
 struct MemAllocRecord : _ur_object {
   MemAllocRecord(ur_context_handle_t Context, bool OwnZeMemHandle = true)
-      : Context(Context) {
+      : _ur_object("MemAllocRecord::Mutex"), Context(Context) {
     OwnNativeHandle = OwnZeMemHandle;
   }
   // Currently kernel can reference memory allocations from different contexts
@@ -301,6 +301,23 @@ ur_result_t ur_context_handle_t_::initialize() {
     createUSMAllocators(SingleRootDevice);
   }
 
+  // Index the devices, and their sub-devices, in the table of event slot
+  // allocators. Index 0 is for pools shared by all devices.
+  std::function<void(ur_device_handle_t)> indexDeviceRecursive =
+      [&](ur_device_handle_t Device) {
+        EventSlotAllocatorDeviceIndex.emplace(
+            Device->ZeDevice, EventSlotAllocatorDeviceIndex.size() + 1);
+        for (auto &SubDevice : Device->SubDevices)
+          indexDeviceRecursive(SubDevice);
+      };
+  for (auto &Device : Devices) {
+    indexDeviceRecursive(Device);
+  }
+  if (SingleRootDevice)
+    indexDeviceRecursive(SingleRootDevice);
+  EventSlotAllocators = std::vector<std::atomic<ur_event_slot_allocator *>>(
+      (EventSlotAllocatorDeviceIndex.size() + 1) * NumEventPoolKinds);
+
   // Create the immediate command list to be used for initializations.
   // Created as synchronous so level-zero performs implicit synchronization and
   // there is no need to query for completion in the plugin
@@ -434,16 +451,24 @@ ur_result_t ur_context_handle_t_::finalize() {
     }
   }
   {
-    std::scoped_lock<ur_mutex> Lock(ZeEventPoolCacheMutex);
-    for (auto &ZePoolCache : ZeEventPoolCache) {
-      for (auto &ZePool : ZePoolCache) {
-        auto ZeResult = ZE_CALL_NOCHECK(zeEventPoolDestroy, (ZePool));
-        // Gracefully handle the case that L0 was already unloaded.
-        if (ZeResult && ZeResult != ZE_RESULT_ERROR_UNINITIALIZED)
-          return ze2urResult(ZeResult);
-      }
-      ZePoolCache.clear();
+    auto destroyPool = [](ze_event_pool_handle_t ZePool) {
+      auto ZeResult = ZE_CALL_NOCHECK(zeEventPoolDestroy, (ZePool));
+      // Gracefully handle the case that L0 was already unloaded.
+      if (ZeResult && ZeResult != ZE_RESULT_ERROR_UNINITIALIZED)
+        return ze2urResult(ZeResult);
+      return UR_RESULT_SUCCESS;
+    };
+    for (auto &Allocator : EventSlotAllocators) {
+      std::unique_ptr<ur_event_slot_allocator> Owned(
+          Allocator.exchange(nullptr));
+      if (Owned)
+        UR_CALL(Owned->destroyPools(destroyPool));
+    }
+    std::scoped_lock<ur_mutex> Lock(OtherEventSlotAllocatorsMutex);
+    for (auto &Allocator : OtherEventSlotAllocators) {
+      UR_CALL(Allocator.second->destroyPools(destroyPool));
     }
+    OtherEventSlotAllocators.clear();
   }
 
   // Destroy the command list used for initializations
@@ -493,105 +518,132 @@ static const uint32_t MaxNumEventsPerPool = [] {
   return Result;
 }();
 
-ur_result_t ur_context_handle_t_::getFreeSlotInExistingOrNewPool(
-    ze_event_pool_handle_t &Pool, size_t &Index, bool HostVisible,
-    bool ProfilingEnabled, ur_device_handle_t Device,
-    bool CounterBasedEventEnabled, bool UsingImmCmdList,
-    bool InterruptBasedEventEnabled) {
-  // Lock while updating event pool machinery.
-  std::scoped_lock<ur_mutex> Lock(ZeEventPoolCacheMutex);
-
-  ze_device_handle_t ZeDevice = nullptr;
+// Number of free event slots of a kind of pools below which a new pool is
+// created in the background. Defaults to a quarter of a pool, 0 disables the
+// background creation of pools.
+static const uint32_t EventPoolRefillWatermark = [] {
+  const char *UrRet = std::getenv("UR_L0_EVENT_POOL_REFILL_WATERMARK");
+  if (!UrRet)
+    return MaxNumEventsPerPool / 4;
+  int Result = std::atoi(UrRet);
+  return Result > 0 ? static_cast<uint32_t>(Result) : 0u;
+}();
 
-  if (Device) {
-    ZeDevice = Device->ZeDevice;
-  }
-  std::list<ze_event_pool_handle_t> *ZePoolCache = getZeEventPoolCache(
-      HostVisible, ProfilingEnabled, CounterBasedEventEnabled, UsingImmCmdList,
-      InterruptBasedEventEnabled, ZeDevice);
-
-  if (!ZePoolCache->empty()) {
-    if (NumEventsAvailableInEventPool[ZePoolCache->front()] == 0) {
-      if (DisableEventsCaching) {
-        // Remove full pool from the cache if events caching is disabled.
-        ZePoolCache->erase(ZePoolCache->begin());
-      } else {
-        // If event caching is enabled then we don't destroy events so there is
-        // no need to remove pool from the cache and add it back when it has
-        // available slots. Just keep it in the tail of the cache so that all
-        // pools can be destroyed during context destruction.
-        ZePoolCache->push_front(nullptr);
+ur_result_t ur_context_handle_t_::getEventSlotAllocator(
+    ur_event_slot_allocator *&Allocator, bool HostVisible, bool WithProfiling,
+    ze_device_handle_t ZeDevice, bool CounterBasedEventEnabled,
+    bool UsingImmCmdList, bool InterruptBasedEventEnabled) {
+  EventPoolCacheType CacheType;
+  calculateCacheIndex(HostVisible, CounterBasedEventEnabled, UsingImmCmdList,
+                      InterruptBasedEventEnabled, CacheType);
+  size_t Kind = WithProfiling ? CacheType * 2 : CacheType * 2 + 1;
+
+  auto createAllocator = [&]() {
+    auto CreatePool = [this, HostVisible, WithProfiling, ZeDevice,
+                       CounterBasedEventEnabled, UsingImmCmdList,
+                       InterruptBasedEventEnabled](
+                          uint32_t NumSlots,
+                          ze_event_pool_handle_t &ZePool) -> ur_result_t {
+      ze_event_pool_counter_based_exp_desc_t counterBasedExt = {
+          ZE_STRUCTURE_TYPE_COUNTER_BASED_EVENT_POOL_EXP_DESC, nullptr, 0};
+
+      ze_intel_event_sync_mode_exp_desc_t eventSyncMode = {
+          ZE_INTEL_STRUCTURE_TYPE_EVENT_SYNC_MODE_EXP_DESC, nullptr, 0};
+      eventSyncMode.syncModeFlags =
+          ZE_INTEL_EVENT_SYNC_MODE_EXP_FLAG_LOW_POWER_WAIT |
+          ZE_INTEL_EVENT_SYNC_MODE_EXP_FLAG_SIGNAL_INTERRUPT;
+
+      ZeStruct<ze_event_pool_desc_t> ZeEventPoolDesc;
+      ZeEventPoolDesc.count = NumSlots;
+      ZeEventPoolDesc.flags = 0;
+      ZeEventPoolDesc.pNext = nullptr;
+      if (HostVisible)
+        ZeEventPoolDesc.flags |= ZE_EVENT_POOL_FLAG_HOST_VISIBLE;
+      if (WithProfiling)
+        ZeEventPoolDesc.flags |= ZE_EVENT_POOL_FLAG_KERNEL_TIMESTAMP;
+      logger::debug("ze_event_pool_desc_t flags set to: {}",
+                    ZeEventPoolDesc.flags);
+      if (CounterBasedEventEnabled) {
+        if (UsingImmCmdList) {
+          counterBasedExt.flags =
+              ZE_EVENT_POOL_COUNTER_BASED_EXP_FLAG_IMMEDIATE;
+        } else {
+          counterBasedExt.flags =
+              ZE_EVENT_POOL_COUNTER_BASED_EXP_FLAG_NON_IMMEDIATE;
+        }
+        logger::debug("ze_event_pool_desc_t counter based flags set to: {}",
+                      counterBasedExt.flags);
+        if (InterruptBasedEventEnabled) {
+          counterBasedExt.pNext = &eventSyncMode;
+        }
+        ZeEventPoolDesc.pNext = &counterBasedExt;
+      } else if (InterruptBasedEventEnabled) {
+        ZeEventPoolDesc.pNext = &eventSyncMode;
       }
-    }
-  }
-  if (ZePoolCache->empty()) {
-    ZePoolCache->push_back(nullptr);
-  }
 
-  // We shall be adding an event to the front pool.
-  ze_event_pool_handle_t *ZePool = &ZePoolCache->front();
-  Index = 0;
-  // Create one event ZePool per MaxNumEventsPerPool events
-  if (*ZePool == nullptr) {
-    ze_event_pool_counter_based_exp_desc_t counterBasedExt = {
-        ZE_STRUCTURE_TYPE_COUNTER_BASED_EVENT_POOL_EXP_DESC, nullptr, 0};
-
-    ze_intel_event_sync_mode_exp_desc_t eventSyncMode = {
-        ZE_INTEL_STRUCTURE_TYPE_EVENT_SYNC_MODE_EXP_DESC, nullptr, 0};
-    eventSyncMode.syncModeFlags =
-        ZE_INTEL_EVENT_SYNC_MODE_EXP_FLAG_LOW_POWER_WAIT |
-        ZE_INTEL_EVENT_SYNC_MODE_EXP_FLAG_SIGNAL_INTERRUPT;
-
-    ZeStruct<ze_event_pool_desc_t> ZeEventPoolDesc;
-    ZeEventPoolDesc.count = MaxNumEventsPerPool;
-    ZeEventPoolDesc.flags = 0;
-    ZeEventPoolDesc.pNext = nullptr;
-    if (HostVisible)
-      ZeEventPoolDesc.flags |= ZE_EVENT_POOL_FLAG_HOST_VISIBLE;
-    if (ProfilingEnabled)
-      ZeEventPoolDesc.flags |= ZE_EVENT_POOL_FLAG_KERNEL_TIMESTAMP;
-    logger::debug("ze_event_pool_desc_t flags set to: {}",
-                  ZeEventPoolDesc.flags);
-    if (CounterBasedEventEnabled) {
-      if (UsingImmCmdList) {
-        counterBasedExt.flags = ZE_EVENT_POOL_COUNTER_BASED_EXP_FLAG_IMMEDIATE;
+      std::vector<ze_device_handle_t> ZeDevices;
+      if (ZeDevice) {
+        ZeDevices.push_back(ZeDevice);
       } else {
-        counterBasedExt.flags =
-            ZE_EVENT_POOL_COUNTER_BASED_EXP_FLAG_NON_IMMEDIATE;
-      }
-      logger::debug("ze_event_pool_desc_t counter based flags set to: {}",
-                    counterBasedExt.flags);
-      if (InterruptBasedEventEnabled) {
-        counterBasedExt.pNext = &eventSyncMode;
+        std::for_each(Devices.begin(), Devices.end(),
+                      [&](const ur_device_handle_t &D) {
+                        ZeDevices.push_back(D->ZeDevice);
+                      });
       }
-      ZeEventPoolDesc.pNext = &counterBasedExt;
-    } else if (InterruptBasedEventEnabled) {
-      ZeEventPoolDesc.pNext = &eventSyncMode;
-    }
 
-    std::vector<ze_device_handle_t> ZeDevices;
+      ZE2UR_CALL(zeEventPoolCreate, (ZeContext, &ZeEventPoolDesc,
+                                     ZeDevices.size(), &ZeDevices[0], &ZePool));
+      return UR_RESULT_SUCCESS;
+    };
+    return std::make_unique<ur_event_slot_allocator>(
+        MaxNumEventsPerPool,
+        std::min(EventPoolRefillWatermark, MaxNumEventsPerPool), CreatePool);
+  };
+
+  try {
+    size_t DeviceIndex = 0;
     if (ZeDevice) {
-      ZeDevices.push_back(ZeDevice);
-    } else {
-      std::for_each(Devices.begin(), Devices.end(),
-                    [&](const ur_device_handle_t &D) {
-                      ZeDevices.push_back(D->ZeDevice);
-                    });
+      auto It = EventSlotAllocatorDeviceIndex.find(ZeDevice);
+      if (It == EventSlotAllocatorDeviceIndex.end()) {
+        std::scoped_lock<ur_mutex> Lock(OtherEventSlotAllocatorsMutex);
+        auto &Other = OtherEventSlotAllocators[{ZeDevice, Kind}];
+        if (!Other)
+          Other = createAllocator();
+        Allocator = Other.get();
+        return UR_RESULT_SUCCESS;
+      }
+      DeviceIndex = It->second;
     }
 
-    ZE2UR_CALL(zeEventPoolCreate, (ZeContext, &ZeEventPoolDesc,
-                                   ZeDevices.size(), &ZeDevices[0], ZePool));
-    NumEventsAvailableInEventPool[*ZePool] = MaxNumEventsPerPool - 1;
-    NumEventsUnreleasedInEventPool[*ZePool] = 1;
-  } else {
-    Index = MaxNumEventsPerPool - NumEventsAvailableInEventPool[*ZePool];
-    --NumEventsAvailableInEventPool[*ZePool];
-    ++NumEventsUnreleasedInEventPool[*ZePool];
+    auto &Entry = EventSlotAllocators[DeviceIndex * NumEventPoolKinds + Kind];
+    Allocator = Entry.load(std::memory_order_acquire);
+    if (!Allocator) {
+      // Threads racing to create the allocator keep the first one.
+      auto New = createAllocator();
+      if (Entry.compare_exchange_strong(Allocator, New.get(),
+                                        std::memory_order_acq_rel))
+        Allocator = New.release();
+    }
+  } catch (const std::bad_alloc &) {
+    return UR_RESULT_ERROR_OUT_OF_HOST_MEMORY;
+  } catch (...) {
+    return UR_RESULT_ERROR_UNKNOWN;
   }
-  Pool = *ZePool;
   return UR_RESULT_SUCCESS;
 }
 
+ur_result_t ur_context_handle_t_::getFreeSlotInExistingOrNewPool(
+    ur_event_slot_t &Slot, bool HostVisible, bool ProfilingEnabled,
+    ur_device_handle_t Device, bool CounterBasedEventEnabled,
+    bool UsingImmCmdList, bool InterruptBasedEventEnabled) {
+  ur_event_slot_allocator *Allocator = nullptr;
+  UR_CALL(getEventSlotAllocator(
+      Allocator, HostVisible, ProfilingEnabled,
+      Device ? Device->ZeDevice : nullptr, CounterBasedEventEnabled,
+      UsingImmCmdList, InterruptBasedEventEnabled));
+  return Allocator->allocate(Slot);
+}
+
 ur_event_handle_t ur_context_handle_t_::getEventFromContextCache(
     bool HostVisible, bool WithProfiling, ur_device_handle_t Device,
     bool CounterBasedEventEnabled, bool InterruptBasedEventEnabled) {
@@ -643,38 +695,15 @@ void ur_context_handle_t_::addEventToContextCache(ur_event_handle_t Event) {
 
 ur_result_t
 ur_context_handle_t_::decrementUnreleasedEventsInPool(ur_event_handle_t Event) {
-  std::shared_lock<ur_shared_mutex> EventLock(Event->Mutex, std::defer_lock);
-  std::scoped_lock<ur_mutex, std::shared_lock<ur_shared_mutex>> LockAll(
-      ZeEventPoolCacheMutex, EventLock);
+  std::shared_lock<ur_shared_mutex> EventLock(Event->Mutex);
   if (!Event->ZeEventPool) {
     // This must be an interop event created on a users's pool.
     // Do nothing.
     return UR_RESULT_SUCCESS;
   }
 
-  ze_device_handle_t ZeDevice = nullptr;
-  bool UsingImmediateCommandlists =
-      !Event->UrQueue || Event->UrQueue->UsingImmCmdLists;
-
-  if (!Event->IsMultiDevice && Event->UrQueue) {
-    ZeDevice = Event->UrQueue->Device->ZeDevice;
-  }
-
-  std::list<ze_event_pool_handle_t> *ZePoolCache = getZeEventPoolCache(
-      Event->isHostVisible(), Event->isProfilingEnabled(),
-      Event->CounterBasedEventsEnabled, UsingImmediateCommandlists,
-      Event->InterruptBasedEventsEnabled, ZeDevice);
-
-  // Put the empty pool to the cache of the pools.
-  if (NumEventsUnreleasedInEventPool[Event->ZeEventPool] == 0)
-    die("Invalid event release: event pool doesn't have unreleased events");
-  if (--NumEventsUnreleasedInEventPool[Event->ZeEventPool] == 0) {
-    if (ZePoolCache->front() != Event->ZeEventPool) {
-      ZePoolCache->push_back(Event->ZeEventPool);
-    }
-    NumEventsAvailableInEventPool[Event->ZeEventPool] = MaxNumEventsPerPool;
-  }
-
+  // The slot is reused by the next event allocated from its pool.
+  ur_event_slot_allocator::release(Event->Slot);
   return UR_RESULT_SUCCESS;
 }
 
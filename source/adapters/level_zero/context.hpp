@@ -9,6 +9,7 @@
 //===----------------------------------------------------------------------===//
 #pragma once
 
+#include <atomic>
 #include <list>
 #include <map>
 #include <stdarg.h>
@@ -23,6 +24,7 @@
 #include <zes_api.h>
 
 #include "common.hpp"
+#include "helpers/event_slot_allocator.hpp"
 #include "queue.hpp"
 
 #include <umf_helpers.hpp>
@@ -54,12 +56,13 @@ typedef struct _ze_intel_event_sync_mode_exp_desc_t {
 struct ur_context_handle_t_ : _ur_object {
   ur_context_handle_t_(ze_context_handle_t ZeContext, uint32_t NumDevices,
                        const ur_device_handle_t *Devs, bool OwnZeContext)
-      : ZeContext{ZeContext}, Devices{Devs, Devs + NumDevices},
-        NumDevices{NumDevices} {
+      : _ur_object("ur_context_handle_t_::Mutex"), ZeContext{ZeContext},
+        Devices{Devs, Devs + NumDevices}, NumDevices{NumDevices} {
     OwnNativeHandle = OwnZeContext;
   }
 
-  ur_context_handle_t_(ze_context_handle_t ZeContext) : ZeContext{ZeContext} {}
+  ur_context_handle_t_(ze_context_handle_t ZeContext)
+      : _ur_object("ur_context_handle_t_::Mutex"), ZeContext{ZeContext} {}
 
   // A L0 context handle is primarily used during creation and management of
   // resources that may be used by multiple devices.
@@ -88,11 +91,13 @@ struct ur_context_handle_t_ : _ur_object {
   // Mutex for the immediate command list. Per the Level Zero spec memory copy
   // operations submitted to an immediate command list are not allowed to be
   // called from simultaneous threads.
-  ur_mutex ImmediateCommandListMutex;
+  ur_mutex ImmediateCommandListMutex{
+      "ur_context_handle_t_::ImmediateCommandListMutex"};
 
   // Mutex Lock for the Command List Cache. This lock is used to control both
   // compute and copy command list caches.
-  ur_mutex ZeCommandListCacheMutex;
+  ur_mutex ZeCommandListCacheMutex{
+      "ur_context_handle_t_::ZeCommandListCacheMutex"};
 
   // If context contains one device or sub-devices of the same device, we want
   // to save this device.
@@ -152,40 +157,22 @@ struct ur_context_handle_t_ : _ur_object {
   // when kernel has finished execution.
   std::unordered_map<void *, MemAllocRecord> MemAllocs;
 
-  // Following member variables are used to manage assignment of events
-  // to event pools.
-  //
-  // TODO: Create ur_event_pool class to encapsulate working with pools.
-  // This will avoid needing the use of maps below, and cleanup the
-  // ur_context_handle_t overall.
-  //
-
-  // The cache of event pools from where new events are allocated from.
-  // The head event pool is where the next event would be added to if there
-  // is still some room there. If there is no room in the head then
-  // the following event pool is taken (guranteed to be empty) and made the
-  // head. In case there is no next pool, a new pool is created and made the
-  // head.
-  //
-  // Cache of event pools to which host-visible events are added to.
-  std::vector<std::list<ze_event_pool_handle_t>> ZeEventPoolCache{30};
-  std::vector<std::unordered_map<ze_device_handle_t, size_t>>
-      ZeEventPoolCacheDeviceMap{30};
-
-  // This map will be used to determine if a pool is full or not
-  // by storing number of empty slots available in the pool.
-  std::unordered_map<ze_event_pool_handle_t, uint32_t>
-      NumEventsAvailableInEventPool;
-  // This map will be used to determine number of unreleased events in the pool.
-  // We use separate maps for number of event slots available in the pool from
-  // the number of events unreleased in the pool.
-  // This will help when we try to make the code thread-safe.
-  std::unordered_map<ze_event_pool_handle_t, uint32_t>
-      NumEventsUnreleasedInEventPool;
-
-  // Mutex to control operations on event pool caches and the helper maps
-  // holding the current pool usage counts.
-  ur_mutex ZeEventPoolCacheMutex;
+  // Allocators of event slots, one for each kind of event pool (see
+  // EventPoolCacheType), profiling mode and device. Index 0 of the device
+  // dimension is for pools shared by all devices of the context. The table is
+  // sized by initialize() and allocators are created on first use, so that
+  // events are allocated without taking a context-wide lock.
+  std::vector<std::atomic<ur_event_slot_allocator *>> EventSlotAllocators;
+  // Index of the devices, and their sub-devices, in EventSlotAllocators. Only
+  // written by initialize().
+  std::unordered_map<ze_device_handle_t, size_t> EventSlotAllocatorDeviceIndex;
+
+  // Allocators for devices that are not in EventSlotAllocatorDeviceIndex.
+  std::map<std::pair<ze_device_handle_t, size_t>,
+           std::unique_ptr<ur_event_slot_allocator>>
+      OtherEventSlotAllocators;
+  ur_mutex OtherEventSlotAllocatorsMutex{
+      "ur_context_handle_t_::OtherEventSlotAllocatorsMutex"};
 
   // Initialize the PI context.
   ur_result_t initialize();
@@ -208,11 +195,11 @@ struct ur_context_handle_t_ : _ur_object {
   // Get vector of devices from this context
   const std::vector<ur_device_handle_t> &getDevices() const;
 
-  // Get index of the free slot in the available pool. If there is no available
-  // pool then create new one. The HostVisible parameter tells if we need a
+  // Get a free slot in the available pool. If there is no available pool
+  // then create new one. The HostVisible parameter tells if we need a
   // slot for a host-visible event. The ProfilingEnabled tells is we need a
   // slot for an event with profiling capabilities.
-  ur_result_t getFreeSlotInExistingOrNewPool(ze_event_pool_handle_t &, size_t &,
+  ur_result_t getFreeSlotInExistingOrNewPool(ur_event_slot_t &Slot,
                                              bool HostVisible,
                                              bool ProfilingEnabled,
                                              ur_device_handle_t Device,
@@ -249,31 +236,9 @@ struct ur_context_handle_t_ : _ur_object {
     HostInvisibleInterruptAndCounterBasedImmediateCacheType
   };
 
-  std::list<ze_event_pool_handle_t> *
-  getZeEventPoolCache(bool HostVisible, bool WithProfiling,
-                      bool CounterBasedEventEnabled, bool UsingImmediateCmdList,
-                      bool InterruptBasedEventEnabled,
-                      ze_device_handle_t ZeDevice) {
-    EventPoolCacheType CacheType;
-
-    calculateCacheIndex(HostVisible, CounterBasedEventEnabled,
-                        UsingImmediateCmdList, InterruptBasedEventEnabled,
-                        CacheType);
-    if (ZeDevice) {
-      auto ZeEventPoolCacheMap =
-          WithProfiling ? &ZeEventPoolCacheDeviceMap[CacheType * 2]
-                        : &ZeEventPoolCacheDeviceMap[CacheType * 2 + 1];
-      if (ZeEventPoolCacheMap->find(ZeDevice) == ZeEventPoolCacheMap->end()) {
-        ZeEventPoolCache.emplace_back();
-        ZeEventPoolCacheMap->insert(
-            std::make_pair(ZeDevice, ZeEventPoolCache.size() - 1));
-      }
-      return &ZeEventPoolCache[(*ZeEventPoolCacheMap)[ZeDevice]];
-    } else {
-      return WithProfiling ? &ZeEventPoolCache[CacheType * 2]
-                           : &ZeEventPoolCache[CacheType * 2 + 1];
-    }
-  }
+  // Number of kinds of event pools, with and without profiling.
+  static constexpr size_t NumEventPoolKinds =
+      (HostInvisibleInterruptAndCounterBasedImmediateCacheType + 1) * 2;
 
   ur_result_t calculateCacheIndex(bool HostVisible,
                                   bool CounterBasedEventEnabled,
@@ -332,8 +297,7 @@ struct ur_context_handle_t_ : _ur_object {
     return UR_RESULT_SUCCESS;
   }
 
-  // Decrement number of events living in the pool upon event destroy
-  // and return the pool to the cache if there are no unreleased events.
+  // Return the slot of the event to its pool upon event destroy.
   ur_result_t decrementUnreleasedEventsInPool(ur_event_handle_t Event);
 
   // Retrieves a command list for executing on this device along with
@@ -380,8 +344,17 @@ private:
         5, // this is used as an offset for embedding device id
   };
 
+  // Get the allocator of event slots for a kind of event pool, creating it
+  // if needed.
+  ur_result_t getEventSlotAllocator(ur_event_slot_allocator *&Allocator,
+                                    bool HostVisible, bool WithProfiling,
+                                    ze_device_handle_t ZeDevice,
+                                    bool CounterBasedEventEnabled,
+                                    bool UsingImmCmdList,
+                                    bool InterruptBasedEventEnabled);
+
   // Mutex to control operations on event caches.
-  ur_mutex EventCacheMutex;
+  ur_mutex EventCacheMutex{"ur_context_handle_t_::EventCacheMutex"};
 
   // Caches for events.
   using EventCache = std::list<ur_event_handle_t>;
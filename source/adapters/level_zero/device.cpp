@@ -296,6 +296,7 @@ ur_result_t urDeviceGetInfo(
     // Return supported for the UR multi-device compile experimental feature
     SupportedExtensions += ("ur_exp_multi_device_compile ");
     SupportedExtensions += ("ur_exp_usm_p2p ");
+    SupportedExtensions += ("ur_exp_program_file_source ");
 
     return ReturnValue(SupportedExtensions.c_str());
   }
@@ -60,8 +60,9 @@ struct ur_ze_external_memory_data {
 struct ur_device_handle_t_ : _ur_object {
   ur_device_handle_t_(ze_device_handle_t Device, ur_platform_handle_t Plt,
                       ur_device_handle_t ParentDevice = nullptr)
-      : ZeDevice{Device}, Platform{Plt}, RootDevice{ParentDevice},
-        ZeDeviceProperties{}, ZeDeviceComputeProperties{}, Id(std::nullopt) {
+      : _ur_object("ur_device_handle_t_::Mutex"), ZeDevice{Device},
+        Platform{Plt}, RootDevice{ParentDevice}, ZeDeviceProperties{},
+        ZeDeviceComputeProperties{}, Id(std::nullopt) {
     // NOTE: one must additionally call initialize() to complete
     // UR device creation.
   }
@@ -1356,18 +1356,15 @@ ur_result_t EventCreate(ur_context_handle_t Context, ur_queue_handle_t Queue,
   }
 
   ze_event_handle_t ZeEvent;
-  ze_event_pool_handle_t ZeEventPool = {};
-
-  size_t Index = 0;
+  ur_event_slot_t Slot;
 
   if (auto Res = Context->getFreeSlotInExistingOrNewPool(
-          ZeEventPool, Index, HostVisible, ProfilingEnabled, Device,
-          CounterBasedEventEnabled, UsingImmediateCommandlists,
-          InterruptBasedEventEnabled))
+          Slot, HostVisible, ProfilingEnabled, Device, CounterBasedEventEnabled,
+          UsingImmediateCommandlists, InterruptBasedEventEnabled))
     return Res;
 
   ZeStruct<ze_event_desc_t> ZeEventDesc;
-  ZeEventDesc.index = Index;
+  ZeEventDesc.index = Slot.Index;
   ZeEventDesc.wait = 0;
 
   if (HostVisible || CounterBasedEventEnabled || InterruptBasedEventEnabled) {
@@ -1384,17 +1381,23 @@ ur_result_t EventCreate(ur_context_handle_t Context, ur_queue_handle_t Queue,
     ZeEventDesc.signal = 0;
   }
 
-  ZE2UR_CALL(zeEventCreate, (ZeEventPool, &ZeEventDesc, &ZeEvent));
+  if (auto ZeResult = ZE_CALL_NOCHECK(
+          zeEventCreate, (Slot.ZeEventPool, &ZeEventDesc, &ZeEvent))) {
+    ur_event_slot_allocator::release(Slot);
+    return ze2urResult(ZeResult);
+  }
 
   try {
     *RetEvent = new ur_event_handle_t_(
-        ZeEvent, ZeEventPool, reinterpret_cast<ur_context_handle_t>(Context),
+        ZeEvent, Slot.ZeEventPool,
+        reinterpret_cast<ur_context_handle_t>(Context),
         UR_EXT_COMMAND_TYPE_USER, true);
   } catch (const std::bad_alloc &) {
     return UR_RESULT_ERROR_OUT_OF_HOST_MEMORY;
   } catch (...) {
     return UR_RESULT_ERROR_UNKNOWN;
   }
+  (*RetEvent)->Slot = Slot;
   (*RetEvent)->CounterBasedEventsEnabled = CounterBasedEventEnabled;
   (*RetEvent)->InterruptBasedEventsEnabled = InterruptBasedEventEnabled;
   if (HostVisible)
@@ -25,6 +25,7 @@
 #include <zes_api.h>
 
 #include "common.hpp"
+#include "helpers/event_slot_allocator.hpp"
 #include "queue.hpp"
 
 extern "C" {
@@ -128,8 +129,9 @@ struct ur_event_handle_t_ : _ur_object {
                      ze_event_pool_handle_t ZeEventPool,
                      ur_context_handle_t Context, ur_command_t CommandType,
                      bool OwnZeEvent)
-      : ZeEvent{ZeEvent}, ZeEventPool{ZeEventPool}, Context{Context},
-        CommandType{CommandType}, CommandData{nullptr} {
+      : _ur_object("ur_event_handle_t_::Mutex"), ZeEvent{ZeEvent},
+        ZeEventPool{ZeEventPool}, Context{Context}, CommandType{CommandType},
+        CommandData{nullptr} {
     OwnNativeHandle = OwnZeEvent;
   }
 
@@ -139,6 +141,10 @@ struct ur_event_handle_t_ : _ur_object {
   // Level Zero event pool handle.
   ze_event_pool_handle_t ZeEventPool;
 
+  // Slot of the event in ZeEventPool, returned to the pool when the event is
+  // destroyed.
+  ur_event_slot_t Slot;
+
   // In case we use device-only events this holds their host-visible
   // counterpart. If this event is itself host-visble then HostVisibleEvent
   // points to this event. If this event is not host-visible then this field can
@@ -0,0 +1,148 @@
+//===--------- batch_controller.cpp - Level Zero Adapter -----------------===//
+//
+// Copyright (C) 2025 Intel Corporation
+//
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "batch_controller.hpp"
+#include "logger/ur_logger.hpp"
+
+#include <algorithm>
+
+std::optional<ur_batch_policy_t> parseBatchPolicy(std::string_view Value) {
+  if (Value == "threshold")
+    return ur_batch_policy_t::Threshold;
+  if (Value == "aimd")
+    return ur_batch_policy_t::Aimd;
+  return std::nullopt;
+}
+
+namespace {
+
+// The original heuristic. It only looks at how batches are closed, counting
+// full and early closes since the last adjustment.
+struct threshold_batch_controller : ur_batch_controller {
+  threshold_batch_controller(const zeCommandListBatchConfig &Config)
+      : ur_batch_controller(Config.startSize()), Config(Config) {}
+
+protected:
+  void fullBatch() override {
+    NumTimesClosedFull += 1;
+
+    // If the number of times the list has been closed early is low, and
+    // the number of times it has been closed full is high, then raise
+    // the batching size slowly. Don't raise it if it is already pretty
+    // high.
+    if (NumTimesClosedEarly <= Config.NumTimesClosedEarlyThreshold &&
+        NumTimesClosedFull > Config.NumTimesClosedFullThreshold) {
+      if (Size < Config.DynamicSizeMax) {
+        Size += Config.DynamicSizeStep;
+        logger::debug("Raising QueueBatchSize to {}", Size);
+      }
+      NumTimesClosedEarly = 0;
+      NumTimesClosedFull = 0;
+    }
+  }
+
+  void partialBatch(uint32_t NumCommands) override {
+    NumTimesClosedEarly += 1;
+
+    // If we are closing early more than about 3x the number of times
+    // it is closing full, lower the batch size to the value of the
+    // current open command list. This is trying to quickly get to a
+    // batch size that will be able to be closed full at least once
+    // in a while.
+    if (NumTimesClosedEarly > (NumTimesClosedFull + 1) * 3) {
+      Size = std::max<uint32_t>(NumCommands, 2) - 1;
+      logger::debug("Lowering QueueBatchSize to {}", Size);
+      NumTimesClosedEarly = 0;
+      NumTimesClosedFull = 0;
+    }
+  }
+
+private:
+  const zeCommandListBatchConfig Config;
+  uint32_t NumTimesClosedEarly = 0;
+  uint32_t NumTimesClosedFull = 0;
+};
+
+// Additive increase, multiplicative decrease. The size grows by a step with
+// every full batch while batches complete within the latency target. It is
+// halved when the application synchronizes after less than half of it, or
+// when a batch of about the current size completes later than the target.
+//
+// Synchronizations after at least half of the size leave it unchanged, and
+// the size stops growing once it exceeds the synchronization interval, since
+// batches are then only closed early. Streams alternating between nearby
+// intervals therefore settle instead of oscillating.
+struct aimd_batch_controller : ur_batch_controller {
+  aimd_batch_controller(const zeCommandListBatchConfig &Config)
+      : ur_batch_controller(Config.startSize()), Config(Config) {}
+
+  void onBatchCompleted(uint32_t NumCommands,
+                        std::chrono::nanoseconds Latency) override {
+    // Exponential moving average, weighing the new sample by 1/8.
+    SmoothedLatency = SmoothedLatency == std::chrono::nanoseconds::zero()
+                          ? Latency
+                          : (SmoothedLatency * 7 + Latency) / 8;
+
+    // Batches larger than the size were submitted before the last decrease
+    // and must not decrease it again. Small batches are slow because of
+    // their commands rather than because of batching.
+    if (Latency > Config.LatencyTarget && NumCommands <= Size &&
+        NumCommands * 2 > Size) {
+      decrease();
+    }
+  }
+
+protected:
+  void fullBatch() override {
+    CommandsSinceSync += Size;
+    if (Size < Config.DynamicSizeMax &&
+        SmoothedLatency <= Config.LatencyTarget) {
+      Size = std::min(Size + Config.DynamicSizeStep, Config.DynamicSizeMax);
+      logger::debug("Raising QueueBatchSize to {}", Size);
+    }
+  }
+
+  void partialBatch(uint32_t NumCommands) override {
+    // Full batches since the last synchronization show that the interval
+    // was long enough for the size.
+    uint64_t Interval = CommandsSinceSync + NumCommands;
+    CommandsSinceSync = 0;
+    if (Interval * 2 < Size) {
+      decrease();
+    }
+  }
+
+private:
+  void decrease() {
+    Size = std::max<uint32_t>(Size / 2, 1);
+    logger::debug("Lowering QueueBatchSize to {}", Size);
+  }
+
+  const zeCommandListBatchConfig Config;
+  std::chrono::nanoseconds SmoothedLatency{0};
+  uint64_t CommandsSinceSync = 0;
+};
+
+} // namespace
+
+std::unique_ptr<ur_batch_controller>
+makeBatchController(const zeCommandListBatchConfig &Config) {
+  if (!Config.dynamic()) {
+    return std::make_unique<ur_batch_controller>(Config.Size);
+  }
+
+  switch (Config.Policy) {
+  case ur_batch_policy_t::Aimd:
+    return std::make_unique<aimd_batch_controller>(Config);
+  case ur_batch_policy_t::Threshold:
+  default:
+    return std::make_unique<threshold_batch_controller>(Config);
+  }
+}
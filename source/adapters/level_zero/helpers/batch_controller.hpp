@@ -0,0 +1,117 @@
+//===--------- batch_controller.hpp - Level Zero Adapter -----------------===//
+//
+// Copyright (C) 2025 Intel Corporation
+//
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <tuple>
+
+// Policies adjusting the size of dynamic command-list batches.
+enum class ur_batch_policy_t {
+  // Grow by a step after many full batches, drop to the size of the open
+  // batch after many early closes.
+  Threshold,
+  // Additive increase on full batches, multiplicative decrease on batches
+  // closed well before reaching the size or completing later than the
+  // latency target.
+  Aimd,
+};
+
+// Parses a UR_L0_BATCH_POLICY value, "threshold" or "aimd".
+std::optional<ur_batch_policy_t> parseBatchPolicy(std::string_view Value);
+
+// Configuration of the command-list batching.
+struct zeCommandListBatchConfig {
+  // Default value of 0. This specifies to use dynamic batch size adjustment.
+  // Other values will try to collect specified amount of commands.
+  uint32_t Size{0};
+
+  // If doing dynamic batching, specifies start batch size.
+  uint32_t DynamicSizeStart{4};
+
+  // The maximum size for dynamic batch.
+  uint32_t DynamicSizeMax{64};
+
+  // The step size for dynamic batch increases.
+  uint32_t DynamicSizeStep{1};
+
+  // Thresholds for when increase batch size (number of closed early is small
+  // and number of closed full is high).
+  uint32_t NumTimesClosedEarlyThreshold{3};
+  uint32_t NumTimesClosedFullThreshold{8};
+
+  // Policy used for dynamic batch size adjustment.
+  ur_batch_policy_t Policy{ur_batch_policy_t::Threshold};
+
+  // For the AIMD policy, the submit-to-complete time a batch should not
+  // exceed.
+  std::chrono::microseconds LatencyTarget{1000};
+
+  // Tells the starting size of a batch.
+  uint32_t startSize() const { return Size > 0 ? Size : DynamicSizeStart; }
+  // Tells is we are doing dynamic batch size adjustment.
+  bool dynamic() const { return Size == 0; }
+};
+
+// Decides how many commands a queue collects in a command list before
+// submitting it. The queue reports how each batch was closed and, when it
+// can observe it, how long each batch took to complete.
+//
+// Not thread-safe, the queue calls it under its lock.
+struct ur_batch_controller {
+  ur_batch_controller(uint32_t Size) : Size(Size) {}
+  virtual ~ur_batch_controller() = default;
+
+  // Number of commands to collect before submitting a batch. 0 means never
+  // allow batching.
+  uint32_t size() const { return Size; }
+
+  // A batch reached size() commands and is being submitted.
+  void onFullBatch() {
+    NumTimesClosedFull++;
+    if (Size > 0)
+      fullBatch();
+  }
+
+  // A batch of NumCommands commands is being submitted before reaching
+  // size(), because the application needs its results.
+  void onPartialBatch(uint32_t NumCommands) {
+    NumTimesClosedEarly++;
+    if (Size > 0)
+      partialBatch(NumCommands);
+  }
+
+  // A batch of NumCommands commands completed Latency after its submission.
+  virtual void onBatchCompleted(uint32_t NumCommands,
+                                std::chrono::nanoseconds Latency) {
+    std::ignore = NumCommands;
+    std::ignore = Latency;
+  }
+
+  uint64_t numTimesClosedFull() const { return NumTimesClosedFull; }
+  uint64_t numTimesClosedEarly() const { return NumTimesClosedEarly; }
+
+protected:
+  virtual void fullBatch() {}
+  virtual void partialBatch(uint32_t NumCommands) { std::ignore = NumCommands; }
+
+  uint32_t Size;
+
+private:
+  uint64_t NumTimesClosedFull = 0;
+  uint64_t NumTimesClosedEarly = 0;
+};
+
+// Creates the controller of a fixed or dynamic batch size, as configured.
+std::unique_ptr<ur_batch_controller>
+makeBatchController(const zeCommandListBatchConfig &Config);
@@ -0,0 +1,195 @@
+//===--------- event_slot_allocator.cpp - Level Zero Adapter -------------===//
+//
+// Copyright (C) 2025 Intel Corporation
+//
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "event_slot_allocator.hpp"
+#include "logger/ur_logger.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <thread>
+#include <utility>
+
+struct ur_event_slot_pool {
+  ur_event_slot_pool(ur_event_slot_allocator *Owner,
+                     ze_event_pool_handle_t ZeEventPool, uint32_t NumSlots)
+      : Owner(Owner), ZeEventPool(ZeEventPool), NumSlots(NumSlots),
+        NumWords((NumSlots + BitsPerWord - 1) / BitsPerWord),
+        Words(new word_t[NumWords]) {
+    for (uint32_t I = 0; I < NumWords; I++) {
+      uint32_t Bits = std::min(NumSlots - I * BitsPerWord, BitsPerWord);
+      Words[I].FreeSlots.store(Bits == BitsPerWord ? ~uint64_t{0}
+                                                   : (uint64_t{1} << Bits) - 1,
+                               std::memory_order_relaxed);
+    }
+  }
+
+  // Claims a free slot, starting from a word that depends on the calling
+  // thread so that threads allocating concurrently rarely contend. Fails if
+  // no slot was seen free.
+  bool claim(uint32_t &Index) {
+    static thread_local const size_t ThreadSeed =
+        std::hash<std::thread::id>{}(std::this_thread::get_id());
+    uint32_t Start = ThreadSeed % NumWords;
+    for (uint32_t I = 0; I < NumWords; I++) {
+      uint32_t WordIndex = (Start + I) % NumWords;
+      auto &FreeSlots = Words[WordIndex].FreeSlots;
+      uint64_t Bits = FreeSlots.load(std::memory_order_relaxed);
+      while (Bits) {
+        uint64_t Bit = Bits & (~Bits + 1);
+        if (FreeSlots.compare_exchange_weak(Bits, Bits & ~Bit,
+                                            std::memory_order_acquire,
+                                            std::memory_order_relaxed)) {
+          // The number of bits below the lowest set bit is its position.
+          Index = WordIndex * BitsPerWord +
+                  static_cast<uint32_t>(std::bitset<64>(Bit - 1).count());
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  // Returns false if the slot was already free.
+  bool release(uint32_t Index) {
+    uint64_t Bit = uint64_t{1} << (Index % BitsPerWord);
+    auto Previous = Words[Index / BitsPerWord].FreeSlots.fetch_or(
+        Bit, std::memory_order_release);
+    return !(Previous & Bit);
+  }
+
+  static constexpr uint32_t BitsPerWord = 64;
+
+  // Each word on its own cache line, as threads claim slots from different
+  // words.
+  struct alignas(64) word_t {
+    // Set bits are free slots.
+    std::atomic<uint64_t> FreeSlots;
+  };
+
+  ur_event_slot_allocator *const Owner;
+  const ze_event_pool_handle_t ZeEventPool;
+  const uint32_t NumSlots;
+  const uint32_t NumWords;
+  std::unique_ptr<word_t[]> Words;
+  ur_event_slot_pool *Next = nullptr;
+};
+
+ur_event_slot_allocator::ur_event_slot_allocator(uint32_t SlotsPerPool,
+                                                 uint32_t Watermark,
+                                                 create_pool_t CreatePool)
+    : SlotsPerPool(SlotsPerPool), Watermark(Watermark),
+      CreatePool(std::move(CreatePool)) {}
+
+ur_event_slot_allocator::~ur_event_slot_allocator() {
+  waitForRefill();
+  for (auto *Pool = Pools.load(); Pool;) {
+    delete std::exchange(Pool, Pool->Next);
+  }
+}
+
+ur_result_t ur_event_slot_allocator::allocate(ur_event_slot_t &Slot) {
+  auto tryClaim = [&](ur_event_slot_pool *Pool) {
+    if (!Pool->claim(Slot.Index))
+      return false;
+    Slot.ZeEventPool = Pool->ZeEventPool;
+    Slot.Pool = Pool;
+    return true;
+  };
+  // Pools are published with release semantics, so the first one with a
+  // free slot is found by walking the list from its head.
+  auto tryClaimAny = [&]() {
+    for (auto *Pool = Pools.load(std::memory_order_acquire); Pool;
+         Pool = Pool->Next) {
+      if (tryClaim(Pool)) {
+        CurrentPool.store(Pool, std::memory_order_relaxed);
+        return true;
+      }
+    }
+    return false;
+  };
+
+  auto *Current = CurrentPool.load(std::memory_order_acquire);
+  if (!(Current && tryClaim(Current)) && !tryClaimAny()) {
+    std::scoped_lock<std::mutex> Lock(AddPoolMutex);
+    // Another thread may have created a pool, or released slots, meanwhile.
+    while (!tryClaimAny()) {
+      if (auto Res = addPool())
+        return Res;
+    }
+  }
+
+  auto Free = NumFreeSlots.fetch_sub(1, std::memory_order_relaxed) - 1;
+  if (Free < int64_t{Watermark} && !RefillPending.exchange(true)) {
+    std::scoped_lock<std::mutex> Lock(RefillMutex);
+    try {
+      Refill = std::async(std::launch::async, [this] { refill(); });
+    } catch (...) {
+      RefillPending = false;
+    }
+  }
+  return UR_RESULT_SUCCESS;
+}
+
+void ur_event_slot_allocator::release(const ur_event_slot_t &Slot) {
+  if (Slot.Pool && Slot.Pool->release(Slot.Index)) {
+    Slot.Pool->Owner->NumFreeSlots.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+ur_result_t ur_event_slot_allocator::addPool() {
+  ze_event_pool_handle_t ZeEventPool = nullptr;
+  if (auto Res = CreatePool(SlotsPerPool, ZeEventPool))
+    return Res;
+
+  auto *Pool = new ur_event_slot_pool(this, ZeEventPool, SlotsPerPool);
+  NumFreeSlots.fetch_add(SlotsPerPool, std::memory_order_relaxed);
+  NumPools.fetch_add(1, std::memory_order_relaxed);
+
+  // Only this thread, holding AddPoolMutex, modifies the list.
+  Pool->Next = Pools.load(std::memory_order_relaxed);
+  Pools.store(Pool, std::memory_order_release);
+  CurrentPool.store(Pool, std::memory_order_release);
+  return UR_RESULT_SUCCESS;
+}
+
+void ur_event_slot_allocator::refill() {
+  {
+    std::scoped_lock<std::mutex> Lock(AddPoolMutex);
+    if (NumFreeSlots.load() < int64_t{Watermark}) {
+      if (auto Res = addPool())
+        logger::warning("Failed to create an event pool in the background: {}",
+                        Res);
+    }
+  }
+  RefillPending = false;
+}
+
+void ur_event_slot_allocator::waitForRefill() {
+  std::scoped_lock<std::mutex> Lock(RefillMutex);
+  if (Refill.valid())
+    Refill.wait();
+}
+
+ur_result_t ur_event_slot_allocator::destroyPools(
+    const std::function<ur_result_t(ze_event_pool_handle_t)> &Destroy) {
+  waitForRefill();
+
+  std::scoped_lock<std::mutex> Lock(AddPoolMutex);
+  ur_result_t Result = UR_RESULT_SUCCESS;
+  for (auto *Pool = Pools.exchange(nullptr); Pool;) {
+    if (auto Res = Destroy(Pool->ZeEventPool); Res && !Result)
+      Result = Res;
+    delete std::exchange(Pool, Pool->Next);
+  }
+  CurrentPool = nullptr;
+  NumFreeSlots = 0;
+  NumPools = 0;
+  return Result;
+}
@@ -0,0 +1,100 @@
+//===--------- event_slot_allocator.hpp - Level Zero Adapter -------------===//
+//
+// Copyright (C) 2025 Intel Corporation
+//
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+
+#include <ur_api.h>
+#include <ze_api.h>
+
+struct ur_event_slot_pool;
+
+// Slot of an event in a Level Zero event pool.
+struct ur_event_slot_t {
+  ze_event_pool_handle_t ZeEventPool = nullptr;
+  uint32_t Index = 0;
+  // Pool the slot is returned to, null if the slot is not owned.
+  ur_event_slot_pool *Pool = nullptr;
+};
+
+// Allocates event slots from Level Zero event pools of the same kind (flags
+// and devices). The free slots of each pool are tracked in a bitmap, so that
+// events are allocated and released without locks. A lock is only taken to
+// create a new pool, once all existing pools are full.
+//
+// When the number of free slots drops below the watermark, a new pool is
+// created in the background, so that the allocating threads do not wait for
+// the driver.
+class ur_event_slot_allocator {
+public:
+  // Creates a Level Zero event pool with the given number of events.
+  using create_pool_t =
+      std::function<ur_result_t(uint32_t NumSlots, ze_event_pool_handle_t &)>;
+
+  // A Watermark of 0 disables the background creation of pools.
+  ur_event_slot_allocator(uint32_t SlotsPerPool, uint32_t Watermark,
+                          create_pool_t CreatePool);
+  ~ur_event_slot_allocator();
+
+  ur_event_slot_allocator(const ur_event_slot_allocator &) = delete;
+  ur_event_slot_allocator &operator=(const ur_event_slot_allocator &) = delete;
+
+  ur_result_t allocate(ur_event_slot_t &Slot);
+
+  // Returns the slot to its pool. Slots that are not owned, or already free,
+  // are ignored.
+  static void release(const ur_event_slot_t &Slot);
+
+  // Waits for the background creation of pools, if any.
+  void waitForRefill();
+
+  // Waits for the background creation of pools and destroys every pool with
+  // Destroy. The slots of destroyed pools must not be released anymore.
+  ur_result_t
+  destroyPools(const std::function<ur_result_t(ze_event_pool_handle_t)> &);
+
+  size_t getNumFreeSlots() const {
+    return static_cast<size_t>(std::max<int64_t>(NumFreeSlots.load(), 0));
+  }
+  size_t getNumPools() const { return NumPools.load(); }
+
+private:
+  ur_result_t addPool();
+  void refill();
+
+  const uint32_t SlotsPerPool;
+  const uint32_t Watermark;
+  const create_pool_t CreatePool;
+
+  // Pools, most recently created first. Pools are only removed by
+  // destroyPools.
+  std::atomic<ur_event_slot_pool *> Pools{nullptr};
+  // Pool the last slot was allocated from.
+  std::atomic<ur_event_slot_pool *> CurrentPool{nullptr};
+
+  // Signed, as a slot may be claimed again before its release is counted.
+  std::atomic<int64_t> NumFreeSlots{0};
+  std::atomic<size_t> NumPools{0};
+
+  // Serializes the creation of pools.
+  std::mutex AddPoolMutex;
+
+  std::atomic<bool> RefillPending{false};
+  std::mutex RefillMutex;
+  std::future<void> Refill;
+
+  friend struct ur_event_slot_pool;
+};
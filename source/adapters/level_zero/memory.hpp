@@ -96,11 +96,13 @@ struct ur_mem_handle_t_ : _ur_object {
 
 protected:
   ur_mem_handle_t_(mem_type_t type, ur_context_handle_t Context)
-      : UrContext{Context}, UrDevice{nullptr}, mem_type(type) {}
+      : _ur_object("ur_mem_handle_t_::Mutex"), UrContext{Context},
+        UrDevice{nullptr}, mem_type(type) {}
 
   ur_mem_handle_t_(mem_type_t type, ur_context_handle_t Context,
                    ur_device_handle_t Device)
-      : UrContext{Context}, UrDevice(Device), mem_type(type) {}
+      : _ur_object("ur_mem_handle_t_::Mutex"), UrContext{Context},
+        UrDevice(Device), mem_type(type) {}
 
   // Since the destructor isn't virtual, callers must destruct it via _ur_buffer
   // or _ur_image
@@ -14,7 +14,8 @@
 struct ur_physical_mem_handle_t_ : _ur_object {
   ur_physical_mem_handle_t_(ze_physical_mem_handle_t ZePhysicalMem,
                             ur_context_handle_t Context)
-      : ZePhysicalMem{ZePhysicalMem}, Context{Context} {}
+      : _ur_object("ur_physical_mem_handle_t_::Mutex"),
+        ZePhysicalMem{ZePhysicalMem}, Context{Context} {}
 
   // Level Zero physical memory handle.
   ze_physical_mem_handle_t ZePhysicalMem;
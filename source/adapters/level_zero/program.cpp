@@ -11,6 +11,7 @@
 #include "program.hpp"
 #include "device.hpp"
 #include "logger/ur_logger.hpp"
+#include "ur_file_mapping.hpp"
 #include "ur_interface_loader.hpp"
 
 #ifdef UR_ADAPTER_LEVEL_ZERO_V2
@@ -60,7 +61,8 @@ namespace ur::level_zero {
 ur_result_t urProgramCreateWithIL(
     /// [in] handle of the context instance
     ur_context_handle_t Context,
-    /// [in] pointer to IL binary.
+    /// [in][optional] pointer to IL binary. May only be NULL if the IL is
+    /// given by a ::ur_exp_program_file_source_t chained to `pProperties`.
     const void *IL,
     /// [in] length of `pIL` in bytes.
     size_t Length,
@@ -68,8 +70,14 @@ ur_result_t urProgramCreateWithIL(
     const ur_program_properties_t *Properties,
     /// [out] pointer to handle of program object created.
     ur_program_handle_t *Program) {
-  std::ignore = Properties;
   UR_ASSERT(Context, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  // The program keeps its own copy of the IL, so the file only needs to be
+  // mapped while it is created.
+  std::vector<ur::file_mapping_t> Mappings;
+  UR_CALL(ur::mapProgramFileSource(Properties, 1, &Length, Mappings));
+  if (!Mappings.empty()) {
+    IL = Mappings[0].data();
+  }
   UR_ASSERT(IL && Program, UR_RESULT_ERROR_INVALID_NULL_POINTER);
   try {
     ur_program_handle_t_ *UrProgram =
@@ -95,8 +103,10 @@ ur_result_t urProgramCreateWithBinary(
     /// [in][range(0, numDevices)] array of sizes of program binaries specified
     /// by `pBinaries` (in bytes).
     size_t *pLengths,
-    /// [in][range(0, numDevices)] pointer to program binaries to be loaded
-    /// for devices specified by `phDevices`.
+    /// [in][optional][range(0, numDevices)] pointer to program binaries to be
+    /// loaded for devices specified by `phDevices`. May only be NULL if the
+    /// binaries are given by a ::ur_exp_program_file_source_t chained to
+    /// `pProperties`.
     const uint8_t **ppBinaries,
     /// [in][optional] pointer to program creation properties.
     const ur_program_properties_t *pProperties,
@@ -112,6 +122,17 @@ ur_result_t urProgramCreateWithBinary(
   // somehow examine the binary image to distinguish the cases.  Alternatively,
   // we could change the PI interface and have the caller pass additional
   // information to distinguish the cases.
+  std::vector<ur::file_mapping_t> Mappings;
+  UR_CALL(
+      ur::mapProgramFileSource(pProperties, numDevices, pLengths, Mappings));
+  std::vector<const uint8_t *> MappedBinaries;
+  if (!Mappings.empty()) {
+    for (const auto &Mapping : Mappings) {
+      MappedBinaries.push_back(static_cast<const uint8_t *>(Mapping.data()));
+    }
+    ppBinaries = MappedBinaries.data();
+  }
+  UR_ASSERT(ppBinaries, UR_RESULT_ERROR_INVALID_NULL_POINTER);
   try {
     for (uint32_t i = 0; i < numDevices; i++) {
       UR_ASSERT(ppBinaries[i] || !pLengths[0], UR_RESULT_ERROR_INVALID_VALUE);
@@ -1002,7 +1023,8 @@ ur_result_t urProgramSetSpecializationConstants(
 ur_program_handle_t_::ur_program_handle_t_(state St,
                                            ur_context_handle_t Context,
                                            const void *Input, size_t Length)
-    : Context{Context}, NativeProperties{nullptr}, OwnZeModule{true},
+    : _ur_object("ur_program_handle_t_::Mutex"), Context{Context},
+      NativeProperties{nullptr}, OwnZeModule{true},
       AssociatedDevices(Context->getDevices()), SpirvCode{new uint8_t[Length]},
       SpirvCodeLength{Length} {
   std::memcpy(SpirvCode.get(), Input, Length);
@@ -1018,7 +1040,8 @@ ur_program_handle_t_::ur_program_handle_t_(
     const ur_device_handle_t *Devices,
     const ur_program_properties_t *Properties, const uint8_t **Inputs,
     const size_t *Lengths)
-    : Context{Context}, NativeProperties(Properties), OwnZeModule{true},
+    : _ur_object("ur_program_handle_t_::Mutex"), Context{Context},
+      NativeProperties(Properties), OwnZeModule{true},
       AssociatedDevices(Devices, Devices + NumDevices) {
   for (uint32_t I = 0; I < NumDevices; ++I) {
     DeviceData &PerDevData = DeviceDataMap[Devices[I]->ZeDevice];
@@ -1030,19 +1053,22 @@ ur_program_handle_t_::ur_program_handle_t_(
 }
 
 ur_program_handle_t_::ur_program_handle_t_(ur_context_handle_t Context)
-    : Context{Context}, NativeProperties{nullptr}, OwnZeModule{true},
+    : _ur_object("ur_program_handle_t_::Mutex"), Context{Context},
+      NativeProperties{nullptr}, OwnZeModule{true},
       AssociatedDevices(Context->getDevices()) {}
 
 ur_program_handle_t_::ur_program_handle_t_(state, ur_context_handle_t Context,
                                            ze_module_handle_t InteropZeModule)
-    : Context{Context}, NativeProperties{nullptr}, OwnZeModule{true},
+    : _ur_object("ur_program_handle_t_::Mutex"), Context{Context},
+      NativeProperties{nullptr}, OwnZeModule{true},
       AssociatedDevices({Context->getDevices()[0]}),
       InteropZeModule{InteropZeModule} {}
 
 ur_program_handle_t_::ur_program_handle_t_(state, ur_context_handle_t Context,
                                            ze_module_handle_t InteropZeModule,
                                            bool OwnZeModule)
-    : Context{Context}, NativeProperties{nullptr}, OwnZeModule{OwnZeModule},
+    : _ur_object("ur_program_handle_t_::Mutex"), Context{Context},
+      NativeProperties{nullptr}, OwnZeModule{OwnZeModule},
       AssociatedDevices({Context->getDevices()[0]}),
       InteropZeModule{InteropZeModule} {
   // TODO: Currently it is not possible to understand the device associated
@@ -1052,8 +1078,9 @@ ur_program_handle_t_::ur_program_handle_t_(state, ur_context_handle_t Context,
 ur_program_handle_t_::ur_program_handle_t_(state St,
                                            ur_context_handle_t Context,
                                            const std::string &ErrorMessage)
-    : Context{Context}, NativeProperties{nullptr}, OwnZeModule{true},
-      ErrorMessage{ErrorMessage}, AssociatedDevices(Context->getDevices()) {
+    : _ur_object("ur_program_handle_t_::Mutex"), Context{Context},
+      NativeProperties{nullptr}, OwnZeModule{true}, ErrorMessage{ErrorMessage},
+      AssociatedDevices(Context->getDevices()) {
   for (auto &Device : Context->getDevices()) {
     DeviceData &PerDevData = DeviceDataMap[Device->ZeDevice];
     PerDevData.State = St;
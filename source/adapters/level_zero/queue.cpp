@@ -19,6 +19,8 @@
 #include "common.hpp"
 #include "event.hpp"
 #include "queue.hpp"
+#include "ur_enqueue_batch.hpp"
+#include "ur_enqueue_host_task.hpp"
 #include "ur_interface_loader.hpp"
 #include "ur_level_zero.hpp"
 #include "ur_util.hpp"
@@ -929,33 +931,56 @@ ur_result_t urEnqueueKernelLaunchCustomExp(
   return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
 }
 
-} // namespace ur::level_zero
-
-// Configuration of the command-list batching.
-struct zeCommandListBatchConfig {
-  // Default value of 0. This specifies to use dynamic batch size adjustment.
-  // Other values will try to collect specified amount of commands.
-  uint32_t Size{0};
-
-  // If doing dynamic batching, specifies start batch size.
-  uint32_t DynamicSizeStart{4};
-
-  // The maximum size for dynamic batch.
-  uint32_t DynamicSizeMax{64};
+ur_result_t urEnqueueBatchExp(ur_queue_handle_t hQueue, uint32_t numCommands,
+                              const ur_exp_batch_command_t *pCommands,
+                              uint32_t numEventsInWaitList,
+                              const ur_event_handle_t *phEventWaitList,
+                              ur_event_handle_t *phEvent) {
+  // The commands end up in the queue's open command lists, which are batched
+  // and submitted the same way as for separately enqueued commands.
+  const ur::batch::enqueue_fns_t Fns = {
+      ur::level_zero::urEnqueueKernelLaunch,
+      ur::level_zero::urEnqueueUSMMemcpy,
+      ur::level_zero::urEnqueueUSMFill,
+      ur::level_zero::urEnqueueEventsWait,
+      ur::level_zero::urEnqueueEventsWaitWithBarrier,
+      ur::level_zero::urEventRelease,
+  };
+  return ur::batch::enqueueByCommand(Fns, hQueue, numCommands, pCommands,
+                                     numEventsInWaitList, phEventWaitList,
+                                     phEvent);
+}
+
+ur_result_t urEnqueueHostTaskExp(ur_queue_handle_t hQueue,
+                                 ur_exp_host_task_function_t pfnHostTask,
+                                 void *pUserData, uint32_t numEventsInWaitList,
+                                 const ur_event_handle_t *phEventWaitList,
+                                 ur_event_handle_t *phEvent) {
+  // The host task runs on the calling thread once the barrier in front of it
+  // completes, so commands enqueued after it can't start before it returns.
+  const ur::host_task::enqueue_fns_t Fns = {
+      ur::level_zero::urEnqueueEventsWaitWithBarrier,
+      ur::level_zero::urEventWait,
+      ur::level_zero::urEventRelease,
+  };
+  return ur::host_task::enqueueAndWait(Fns, hQueue, pfnHostTask, pUserData,
+                                       numEventsInWaitList, phEventWaitList,
+                                       phEvent);
+}
 
-  // The step size for dynamic batch increases.
-  uint32_t DynamicSizeStep{1};
+ur_result_t urEnqueueUSMAllocExp(ur_queue_handle_t, const ur_usm_desc_t *,
+                                 size_t, uint32_t, const ur_event_handle_t *,
+                                 void **, ur_event_handle_t *) {
+  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+}
 
-  // Thresholds for when increase batch size (number of closed early is small
-  // and number of closed full is high).
-  uint32_t NumTimesClosedEarlyThreshold{3};
-  uint32_t NumTimesClosedFullThreshold{8};
+ur_result_t urEnqueueUSMFreeExp(ur_queue_handle_t, void *, uint32_t,
+                                const ur_event_handle_t *,
+                                ur_event_handle_t *) {
+  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+}
 
-  // Tells the starting size of a batch.
-  uint32_t startSize() const { return Size > 0 ? Size : DynamicSizeStart; }
-  // Tells is we are doing dynamic batch size adjustment.
-  bool dynamic() const { return Size == 0; }
-};
+} // namespace ur::level_zero
 
 // Helper function to initialize static variables that holds batch config info
 // for compute and copy command batching.
@@ -1046,6 +1071,26 @@ static const zeCommandListBatchConfig ZeCommandListBatchConfig(bool IsCopy) {
         logger::warning("UR_L0_BATCH_SIZE: ignored negative value");
     }
   }
+
+  // The policy of dynamic batching, shared by compute and copy batches, with
+  // an optional latency target in microseconds: "aimd:500".
+  if (const char *PolicyStr = std::getenv("UR_L0_BATCH_POLICY")) {
+    std::string_view PolicyConfig(PolicyStr);
+    auto Pos = PolicyConfig.find(':');
+    if (auto Policy = parseBatchPolicy(PolicyConfig.substr(0, Pos))) {
+      Config.Policy = *Policy;
+    } else {
+      logger::warning("UR_L0_BATCH_POLICY: unknown policy {}", PolicyStr);
+    }
+    if (Pos != std::string_view::npos) {
+      try {
+        Config.LatencyTarget = std::chrono::microseconds(
+            std::stoul(std::string(PolicyConfig.substr(Pos + 1))));
+      } catch (...) {
+        logger::error("UR_L0_BATCH_POLICY: failed to parse latency target");
+      }
+    }
+  }
   return Config;
 }
 
@@ -1090,8 +1135,8 @@ ur_queue_handle_t_::ur_queue_handle_t_(
     std::vector<ze_command_queue_handle_t> &CopyQueues,
     ur_context_handle_t Context, ur_device_handle_t Device,
     bool OwnZeCommandQueue, ur_queue_flags_t Properties, int ForceComputeIndex)
-    : Context{Context}, Device{Device}, OwnZeCommandQueue{OwnZeCommandQueue},
-      Properties(Properties) {
+    : _ur_object("ur_queue_handle_t_::Mutex"), Context{Context}, Device{Device},
+      OwnZeCommandQueue{OwnZeCommandQueue}, Properties(Properties) {
   // Set the type of commandlists the queue will use when user-selected
   // submission mode. Otherwise use env var setting and if unset, use default.
   if (isBatchedSubmission())
@@ -1187,9 +1232,10 @@ ur_queue_handle_t_::ur_queue_handle_t_(
   // Initialize compute/copy command batches.
   ComputeCommandBatch.OpenCommandList = CommandListMap.end();
   CopyCommandBatch.OpenCommandList = CommandListMap.end();
-  ComputeCommandBatch.QueueBatchSize =
-      ZeCommandListBatchComputeConfig.startSize();
-  CopyCommandBatch.QueueBatchSize = ZeCommandListBatchCopyConfig.startSize();
+  ComputeCommandBatch.Controller =
+      makeBatchController(ZeCommandListBatchComputeConfig);
+  CopyCommandBatch.Controller =
+      makeBatchController(ZeCommandListBatchCopyConfig);
 
   this->CounterBasedEventsEnabled =
       UsingImmCmdLists && isInOrderQueue() && Device->useDriverInOrderLists() &&
@@ -1201,55 +1247,13 @@ ur_queue_handle_t_::ur_queue_handle_t_(
 
 void ur_queue_handle_t_::adjustBatchSizeForFullBatch(bool IsCopy) {
   auto &CommandBatch = IsCopy ? CopyCommandBatch : ComputeCommandBatch;
-  auto &ZeCommandListBatchConfig =
-      IsCopy ? ZeCommandListBatchCopyConfig : ZeCommandListBatchComputeConfig;
-  uint32_t &QueueBatchSize = CommandBatch.QueueBatchSize;
-  // QueueBatchSize of 0 means never allow batching.
-  if (QueueBatchSize == 0 || !ZeCommandListBatchConfig.dynamic())
-    return;
-  CommandBatch.NumTimesClosedFull += 1;
-
-  // If the number of times the list has been closed early is low, and
-  // the number of times it has been closed full is high, then raise
-  // the batching size slowly. Don't raise it if it is already pretty
-  // high.
-  if (CommandBatch.NumTimesClosedEarly <=
-          ZeCommandListBatchConfig.NumTimesClosedEarlyThreshold &&
-      CommandBatch.NumTimesClosedFull >
-          ZeCommandListBatchConfig.NumTimesClosedFullThreshold) {
-    if (QueueBatchSize < ZeCommandListBatchConfig.DynamicSizeMax) {
-      QueueBatchSize += ZeCommandListBatchConfig.DynamicSizeStep;
-      logger::debug("Raising QueueBatchSize to {}", QueueBatchSize);
-    }
-    CommandBatch.NumTimesClosedEarly = 0;
-    CommandBatch.NumTimesClosedFull = 0;
-  }
+  CommandBatch.Controller->onFullBatch();
 }
 
 void ur_queue_handle_t_::adjustBatchSizeForPartialBatch(bool IsCopy) {
   auto &CommandBatch = IsCopy ? CopyCommandBatch : ComputeCommandBatch;
-  auto &ZeCommandListBatchConfig =
-      IsCopy ? ZeCommandListBatchCopyConfig : ZeCommandListBatchComputeConfig;
-  uint32_t &QueueBatchSize = CommandBatch.QueueBatchSize;
-  // QueueBatchSize of 0 means never allow batching.
-  if (QueueBatchSize == 0 || !ZeCommandListBatchConfig.dynamic())
-    return;
-  CommandBatch.NumTimesClosedEarly += 1;
-
-  // If we are closing early more than about 3x the number of times
-  // it is closing full, lower the batch size to the value of the
-  // current open command list. This is trying to quickly get to a
-  // batch size that will be able to be closed full at least once
-  // in a while.
-  if (CommandBatch.NumTimesClosedEarly >
-      (CommandBatch.NumTimesClosedFull + 1) * 3) {
-    QueueBatchSize = CommandBatch.OpenCommandList->second.size() - 1;
-    if (QueueBatchSize < 1)
-      QueueBatchSize = 1;
-    logger::debug("Lowering QueueBatchSize to {}", QueueBatchSize);
-    CommandBatch.NumTimesClosedEarly = 0;
-    CommandBatch.NumTimesClosedFull = 0;
-  }
+  CommandBatch.Controller->onPartialBatch(
+      CommandBatch.OpenCommandList->second.size());
 }
 
 ur_result_t
@@ -1312,7 +1316,7 @@ ur_queue_handle_t_::executeCommandList(ur_command_list_ptr_t CommandList,
         die("executeCommandList: OpenCommandList should be equal to"
             "null or CommandList");
 
-      if (CommandList->second.size() < CommandBatch.QueueBatchSize) {
+      if (CommandList->second.size() < CommandBatch.Controller->size()) {
         CommandBatch.OpenCommandList = CommandList;
         return UR_RESULT_SUCCESS;
       }
@@ -1477,6 +1481,8 @@ ur_queue_handle_t_::executeCommandList(ur_command_list_ptr_t CommandList,
                                        true /* QueueLocked */);
       return ze2urResult(ZeResult);
     }
+    CommandList->second.SubmittedBatchSize = CommandList->second.size();
+    CommandList->second.SubmitTime = std::chrono::steady_clock::now();
   }
 
   // Check global control to make every command blocking for debugging.
@@ -1520,6 +1526,8 @@ ur_queue_handle_t_::resetDiscardedEvent(ur_command_list_ptr_t CommandList) {
       return UR_RESULT_ERROR_UNKNOWN;
     }
 
+    // The new event owns the Level Zero event, and so its slot.
+    UREvent->Slot = LastCommandEvent->Slot;
     if (LastCommandEvent->isHostVisible())
       UREvent->HostVisibleEvent = reinterpret_cast<ur_event_handle_t>(UREvent);
 
@@ -1610,12 +1618,12 @@ ur_result_t urQueueReleaseInternal(ur_queue_handle_t Queue) {
 
   logger::debug("urQueueRelease(compute) NumTimesClosedFull {}, "
                 "NumTimesClosedEarly {}",
-                Queue->ComputeCommandBatch.NumTimesClosedFull,
-                Queue->ComputeCommandBatch.NumTimesClosedEarly);
+                Queue->ComputeCommandBatch.Controller->numTimesClosedFull(),
+                Queue->ComputeCommandBatch.Controller->numTimesClosedEarly());
   logger::debug(
       "urQueueRelease(copy) NumTimesClosedFull {}, NumTimesClosedEarly {}",
-      Queue->CopyCommandBatch.NumTimesClosedFull,
-      Queue->CopyCommandBatch.NumTimesClosedEarly);
+      Queue->CopyCommandBatch.Controller->numTimesClosedFull(),
+      Queue->CopyCommandBatch.Controller->numTimesClosedEarly());
 
   delete Queue;
 
@@ -1624,7 +1632,7 @@ ur_result_t urQueueReleaseInternal(ur_queue_handle_t Queue) {
 
 bool ur_queue_handle_t_::isBatchingAllowed(bool IsCopy) const {
   auto &CommandBatch = IsCopy ? CopyCommandBatch : ComputeCommandBatch;
-  return (CommandBatch.QueueBatchSize > 0 &&
+  return (CommandBatch.Controller->size() > 0 &&
           ((UrL0Serialize & UrL0SerializeBlock) == 0));
 }
 
@@ -2014,6 +2022,17 @@ ur_result_t ur_queue_handle_t_::resetCommandList(
     ZE2UR_CALL(zeCommandListReset, (CommandList->first));
     CommandList->second.ZeFenceInUse = false;
     CommandList->second.IsClosed = false;
+
+    // The completion is only observed now, so this is an upper bound of the
+    // latency of the batch.
+    if (CommandList->second.SubmittedBatchSize > 0) {
+      auto &CommandBatch =
+          UseCopyEngine ? CopyCommandBatch : ComputeCommandBatch;
+      CommandBatch.Controller->onBatchCompleted(
+          CommandList->second.SubmittedBatchSize,
+          std::chrono::steady_clock::now() - CommandList->second.SubmitTime);
+      CommandList->second.SubmittedBatchSize = 0;
+    }
   }
 
   auto &EventList = CommandList->second.EventList;
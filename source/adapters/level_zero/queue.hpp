@@ -10,6 +10,7 @@
 #pragma once
 
 #include <cassert>
+#include <chrono>
 #include <list>
 #include <map>
 #include <optional>
@@ -26,6 +27,7 @@
 
 #include "common.hpp"
 #include "device.hpp"
+#include "helpers/batch_controller.hpp"
 
 extern "C" {
 ur_result_t urQueueReleaseInternal(ur_queue_handle_t Queue);
@@ -216,6 +218,12 @@ struct ur_command_list_info_t {
   std::vector<ur_event_handle_t> EventList;
   size_t size() const { return EventList.size(); }
   void append(ur_event_handle_t Event);
+
+  // Number of commands of the batch submitted with this command list, and
+  // when it was submitted, reported to the batch controller of the queue
+  // once the command list is known to be completed.
+  uint32_t SubmittedBatchSize = 0;
+  std::chrono::steady_clock::time_point SubmitTime;
 };
 
 // The map type that would track all command-lists in a queue.
@@ -382,23 +390,14 @@ struct ur_queue_handle_t_ : _ur_object {
 
   // Helper data structure to hold all variables related to batching
   struct command_batch {
-    // These two members are used to keep track of how often the
-    // batching closes and executes a command list before reaching the
-    // QueueComputeBatchSize limit, versus how often we reach the limit.
-    // This info might be used to vary the QueueComputeBatchSize value.
-    uint32_t NumTimesClosedEarly = {0};
-    uint32_t NumTimesClosedFull = {0};
-
     // Open command list fields for batching commands into this queue.
     ur_command_list_ptr_t OpenCommandList{};
 
-    // Approximate number of commands that are allowed to be batched for
-    // this queue.
-    // Added this member to the queue rather than using a global variable
-    // so that future implementation could use heuristics to change this on
-    // a queue specific basis. And by putting it in the queue itself, this
-    // is thread safe because of the locking of the queue that occurs.
-    uint32_t QueueBatchSize = {0};
+    // Decides the approximate number of commands that are allowed to be
+    // batched for this queue, observing how batches are closed and how long
+    // they take to complete. Each queue has its own, and it is thread safe
+    // because of the locking of the queue that occurs.
+    std::unique_ptr<ur_batch_controller> Controller;
   };
 
   // ComputeCommandBatch holds data related to batching of non-copy commands.
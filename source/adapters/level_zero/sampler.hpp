@@ -12,7 +12,8 @@
 #include "common.hpp"
 
 struct ur_sampler_handle_t_ : _ur_object {
-  ur_sampler_handle_t_(ze_sampler_handle_t Sampler) : ZeSampler{Sampler} {}
+  ur_sampler_handle_t_(ze_sampler_handle_t Sampler)
+      : _ur_object("ur_sampler_handle_t_::Mutex"), ZeSampler{Sampler} {}
 
   // Level Zero sampler handle.
   ze_sampler_handle_t ZeSampler;
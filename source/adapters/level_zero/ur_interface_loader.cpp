@@ -210,6 +210,10 @@ UR_APIEXPORT ur_result_t UR_APICALL urGetEnqueueExpProcAddrTable(
 
   pDdiTable->pfnKernelLaunchCustomExp =
       ur::level_zero::urEnqueueKernelLaunchCustomExp;
+  pDdiTable->pfnBatchExp = ur::level_zero::urEnqueueBatchExp;
+  pDdiTable->pfnHostTaskExp = ur::level_zero::urEnqueueHostTaskExp;
+  pDdiTable->pfnUSMAllocExp = ur::level_zero::urEnqueueUSMAllocExp;
+  pDdiTable->pfnUSMFreeExp = ur::level_zero::urEnqueueUSMFreeExp;
   pDdiTable->pfnCooperativeKernelLaunchExp =
       ur::level_zero::urEnqueueCooperativeKernelLaunchExp;
   pDdiTable->pfnTimestampRecordingExp =
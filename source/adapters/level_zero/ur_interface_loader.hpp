@@ -721,6 +721,25 @@ ur_result_t urUsmP2PPeerAccessGetInfoExp(ur_device_handle_t commandDevice,
                                          ur_exp_peer_info_t propName,
                                          size_t propSize, void *pPropValue,
                                          size_t *pPropSizeRet);
+ur_result_t urEnqueueBatchExp(ur_queue_handle_t hQueue, uint32_t numCommands,
+                              const ur_exp_batch_command_t *pCommands,
+                              uint32_t numEventsInWaitList,
+                              const ur_event_handle_t *phEventWaitList,
+                              ur_event_handle_t *phEvent);
+ur_result_t urEnqueueHostTaskExp(ur_queue_handle_t hQueue,
+                                 ur_exp_host_task_function_t pfnHostTask,
+                                 void *pUserData, uint32_t numEventsInWaitList,
+                                 const ur_event_handle_t *phEventWaitList,
+                                 ur_event_handle_t *phEvent);
+ur_result_t urEnqueueUSMAllocExp(ur_queue_handle_t hQueue,
+                                 const ur_usm_desc_t *pUSMDesc, size_t size,
+                                 uint32_t numEventsInWaitList,
+                                 const ur_event_handle_t *phEventWaitList,
+                                 void **ppMem, ur_event_handle_t *phEvent);
+ur_result_t urEnqueueUSMFreeExp(ur_queue_handle_t hQueue, void *pMem,
+                                uint32_t numEventsInWaitList,
+                                const ur_event_handle_t *phEventWaitList,
+                                ur_event_handle_t *phEvent);
 ur_result_t urEnqueueEventsWaitWithBarrierExt(
     ur_queue_handle_t hQueue,
     const ur_exp_enqueue_ext_properties_t *pProperties,
@@ -1035,7 +1035,8 @@ ur_result_t L0HostMemoryProvider::allocateImpl(void **ResultPtr, size_t Size,
 }
 
 ur_usm_pool_handle_t_::ur_usm_pool_handle_t_(ur_context_handle_t Context,
-                                             ur_usm_pool_desc_t *PoolDesc) {
+                                             ur_usm_pool_desc_t *PoolDesc)
+    : _ur_object("ur_usm_pool_handle_t_::Mutex") {
 
   this->Context = Context;
   zeroInit = static_cast<uint32_t>(PoolDesc->flags &
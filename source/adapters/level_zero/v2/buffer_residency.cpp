@@ -0,0 +1,67 @@
+//===--------- buffer_residency.cpp - Level Zero Adapter -----------------===//
+//
+// Copyright (C) 2025 Intel Corporation
+//
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "buffer_residency.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace v2 {
+
+buffer_residency_t::buffer_residency_t(size_t numDevices)
+    : valid(numDevices + 1, false) {}
+
+bool buffer_residency_t::hasValidCopy() const {
+  return std::find(valid.begin(), valid.end(), true) != valid.end();
+}
+
+std::optional<buffer_residency_t::location_t>
+buffer_residency_t::anyValidDevice() const {
+  for (location_t location = 0; location < host(); location++) {
+    if (valid[location]) {
+      return location;
+    }
+  }
+  return std::nullopt;
+}
+
+std::optional<buffer_residency_t::location_t>
+buffer_residency_t::getMigrationSource(
+    location_t location,
+    const std::function<bool(location_t)> &canCopyFrom) const {
+  assert(location < valid.size());
+
+  if (valid[location] || !hasValidCopy()) {
+    return std::nullopt;
+  }
+
+  for (location_t source = 0; source < host(); source++) {
+    if (valid[source] && canCopyFrom(source)) {
+      return source;
+    }
+  }
+  if (valid[host()] && canCopyFrom(host())) {
+    return host();
+  }
+
+  // Only device copies are left, as the host copy can always be copied from.
+  return anyValidDevice();
+}
+
+void buffer_residency_t::markAccessed(location_t location, bool write) {
+  assert(location < valid.size());
+
+  if (write) {
+    std::fill(valid.begin(), valid.end(), false);
+  }
+  valid[location] = true;
+}
+
+} // namespace v2
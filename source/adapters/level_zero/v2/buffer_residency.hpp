@@ -0,0 +1,56 @@
+//===--------- buffer_residency.hpp - Level Zero Adapter -----------------===//
+//
+// Copyright (C) 2025 Intel Corporation
+//
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace v2 {
+
+// Tracks which copies of a buffer hold its current contents, like the MSI
+// cache coherence protocol: a copy is either invalid, valid along with other
+// copies (after reads), or the only valid one (after a write).
+//
+// Copies are identified by location: the id of the device they are
+// allocated on, or host() for the copy in host memory.
+class buffer_residency_t {
+public:
+  using location_t = size_t;
+
+  explicit buffer_residency_t(size_t numDevices);
+
+  location_t host() const { return valid.size() - 1; }
+
+  bool isValid(location_t location) const { return valid[location]; }
+  // False until the buffer is initialized or written to.
+  bool hasValidCopy() const;
+  // Valid device copy with the lowest id, if any.
+  std::optional<location_t> anyValidDevice() const;
+
+  // Returns the copy the contents must be migrated from before they are
+  // accessed at location, or nullopt if location is valid or no copy is.
+  // Device copies that can be copied from are preferred over the host copy.
+  // If no valid copy can be copied from, a valid device copy is returned,
+  // which must then be migrated through the host copy.
+  std::optional<location_t>
+  getMigrationSource(location_t location,
+                     const std::function<bool(location_t)> &canCopyFrom) const;
+
+  // Records an access at location, after any migration to it was enqueued.
+  // Writes invalidate all the other copies.
+  void markAccessed(location_t location, bool write);
+
+private:
+  std::vector<bool> valid;
+};
+
+} // namespace v2
@@ -11,6 +11,10 @@
 #include "command_list_cache.hpp"
 #include "context.hpp"
 
+#include <cstdlib>
+#include <limits>
+#include <string>
+
 #include "../device.hpp"
 
 template <>
@@ -22,13 +26,29 @@ getZeStructureType<zex_intel_queue_copy_operations_offload_hint_exp_desc_t>() {
 bool v2::immediate_command_list_descriptor_t::operator==(
     const immediate_command_list_descriptor_t &rhs) const {
   return ZeDevice == rhs.ZeDevice && IsInOrder == rhs.IsInOrder &&
-         Mode == rhs.Mode && Priority == rhs.Priority && Index == rhs.Index;
+         Ordinal == rhs.Ordinal &&
+         CopyOffloadEnabled == rhs.CopyOffloadEnabled && Mode == rhs.Mode &&
+         Priority == rhs.Priority && Index == rhs.Index;
 }
 
 bool v2::regular_command_list_descriptor_t::operator==(
     const regular_command_list_descriptor_t &rhs) const {
   return ZeDevice == rhs.ZeDevice && Ordinal == rhs.Ordinal &&
-         IsInOrder == rhs.IsInOrder;
+         IsInOrder == rhs.IsInOrder &&
+         CopyOffloadEnabled == rhs.CopyOffloadEnabled;
+}
+
+static size_t getEnvSize(const char *Name, size_t Default) {
+  const char *Value = std::getenv(Name);
+  if (!Value) {
+    return Default;
+  }
+  try {
+    return std::stoull(Value);
+  } catch (...) {
+    logger::warning("Invalid value of {}: {}, using {}", Name, Value, Default);
+    return Default;
+  }
 }
 
 namespace v2 {
@@ -37,17 +57,47 @@ inline size_t command_list_descriptor_hash_t::operator()(
   if (auto ImmCmdDesc =
           std::get_if<immediate_command_list_descriptor_t>(&desc)) {
     return combine_hashes(0, ImmCmdDesc->ZeDevice, ImmCmdDesc->Ordinal,
-                          ImmCmdDesc->IsInOrder, ImmCmdDesc->Mode,
-                          ImmCmdDesc->Priority, ImmCmdDesc->Index);
+                          ImmCmdDesc->IsInOrder, ImmCmdDesc->CopyOffloadEnabled,
+                          ImmCmdDesc->Mode, ImmCmdDesc->Priority,
+                          ImmCmdDesc->Index);
   } else {
     auto RegCmdDesc = std::get<regular_command_list_descriptor_t>(desc);
     return combine_hashes(0, RegCmdDesc.ZeDevice, RegCmdDesc.IsInOrder,
-                          RegCmdDesc.Ordinal);
+                          RegCmdDesc.Ordinal, RegCmdDesc.CopyOffloadEnabled);
   }
 }
 
+// Enough for a few hundred queues with distinct configurations.
+static constexpr size_t DefaultCapacity = 512;
+
 command_list_cache_t::command_list_cache_t(ze_context_handle_t ZeContext)
-    : ZeContext{ZeContext} {}
+    : command_list_cache_t(ZeContext,
+                           getEnvSize("UR_L0_V2_COMMAND_LIST_CACHE_CAPACITY",
+                                      DefaultCapacity)) {}
+
+command_list_cache_t::command_list_cache_t(ze_context_handle_t ZeContext,
+                                           size_t Capacity)
+    : ZeContext{ZeContext}, Capacity{Capacity} {}
+
+command_list_cache_t::~command_list_cache_t() {
+  auto Stats = getStats();
+  logger::info("command list cache: {} hits, {} misses, {} evictions",
+               Stats.Hits, Stats.Misses, Stats.Evictions);
+}
+
+size_t command_list_cache_t::getPrewarmCount() {
+  static const size_t PrewarmCount =
+      getEnvSize("UR_L0_V2_COMMAND_LIST_CACHE_PREWARM", 0);
+  return PrewarmCount;
+}
+
+command_list_cache_t::shard_t &
+command_list_cache_t::getShard(const command_list_descriptor_t &desc) {
+  auto Hash = std::visit(
+      [](auto &&arg) { return combine_hashes(0, arg.ZeDevice, arg.Ordinal); },
+      desc);
+  return Shards[Hash % NumShards];
+}
 
 raii::ze_command_list_handle_t
 command_list_cache_t::createCommandList(const command_list_descriptor_t &desc) {
@@ -141,23 +191,48 @@ command_list_cache_t::getRegularCommandList(ze_device_handle_t ZeDevice,
       });
 }
 
+void command_list_cache_t::prewarmImmediateCommandLists(
+    ze_device_handle_t ZeDevice, bool IsInOrder, uint32_t Ordinal,
+    bool CopyOffloadEnable, ze_command_queue_mode_t Mode,
+    ze_command_queue_priority_t Priority, size_t Count) {
+  immediate_command_list_descriptor_t Desc;
+  Desc.ZeDevice = ZeDevice;
+  Desc.Ordinal = Ordinal;
+  Desc.CopyOffloadEnabled = CopyOffloadEnable;
+  Desc.IsInOrder = IsInOrder;
+  Desc.Mode = Mode;
+  Desc.Priority = Priority;
+  Desc.Index = std::nullopt;
+
+  for (size_t I = 0; I < Count; ++I) {
+    addCommandList(Desc, createCommandList(Desc));
+  }
+}
+
 raii::ze_command_list_handle_t
 command_list_cache_t::getCommandList(const command_list_descriptor_t &desc) {
-  std::unique_lock<ur_mutex> Lock(ZeCommandListCacheMutex);
-  auto it = ZeCommandListCache.find(desc);
-  if (it == ZeCommandListCache.end()) {
+  auto &Shard = getShard(desc);
+
+  std::unique_lock<ur_mutex> Lock(Shard.Mutex);
+  auto it = Shard.Lists.find(desc);
+  if (it == Shard.Lists.end()) {
+    Shard.Stats.Misses++;
     Lock.unlock();
     return createCommandList(desc);
   }
 
   assert(!it->second.empty());
 
-  raii::ze_command_list_handle_t CommandListHandle =
-      std::move(it->second.top());
-  it->second.pop();
-
+  // Reuse the most recently used command list of this descriptor.
+  auto Entry = it->second.back();
+  it->second.pop_back();
   if (it->second.empty())
-    ZeCommandListCache.erase(it);
+    Shard.Lists.erase(it);
+
+  raii::ze_command_list_handle_t CommandListHandle = std::move(Entry->Handle);
+  Shard.Lru.erase(Entry);
+  Shard.Stats.Hits++;
+  NumIdle--;
 
   return CommandListHandle;
 }
@@ -165,28 +240,94 @@ command_list_cache_t::getCommandList(const command_list_descriptor_t &desc) {
 void command_list_cache_t::addCommandList(
     const command_list_descriptor_t &desc,
     raii::ze_command_list_handle_t cmdList) {
-  // TODO: add a limit?
-  std::unique_lock<ur_mutex> Lock(ZeCommandListCacheMutex);
-  auto [it, _] = ZeCommandListCache.try_emplace(desc);
-  it->second.emplace(std::move(cmdList));
+  auto &Shard = getShard(desc);
+  size_t Idle;
+  {
+    std::unique_lock<ur_mutex> Lock(Shard.Mutex);
+    Shard.Lru.push_front({desc, std::move(cmdList), LruClock++});
+    Shard.Lists[desc].push_back(Shard.Lru.begin());
+    Idle = ++NumIdle;
+  }
+
+  if (Idle > Capacity) {
+    evictIdleCommandLists();
+  }
+}
+
+void command_list_cache_t::evictIdleCommandLists() {
+  while (NumIdle > Capacity) {
+    // Find the shard holding the least recently used command list. Shards
+    // are locked one at a time, so the result is only a hint.
+    shard_t *OldestShard = nullptr;
+    uint64_t OldestLastUsed = std::numeric_limits<uint64_t>::max();
+    for (auto &Shard : Shards) {
+      std::unique_lock<ur_mutex> Lock(Shard.Mutex);
+      if (!Shard.Lru.empty() && Shard.Lru.back().LastUsed < OldestLastUsed) {
+        OldestShard = &Shard;
+        OldestLastUsed = Shard.Lru.back().LastUsed;
+      }
+    }
+    if (!OldestShard) {
+      return;
+    }
+
+    // Destroyed after the lock is released.
+    raii::ze_command_list_handle_t Evicted;
+    {
+      std::unique_lock<ur_mutex> Lock(OldestShard->Mutex);
+      if (OldestShard->Lru.empty() || NumIdle <= Capacity) {
+        continue;
+      }
+
+      // The least recently used command list of the shard is also the least
+      // recently used one of its descriptor.
+      auto Entry = std::prev(OldestShard->Lru.end());
+      auto it = OldestShard->Lists.find(Entry->Desc);
+      assert(it != OldestShard->Lists.end() && it->second.front() == Entry);
+      it->second.pop_front();
+      if (it->second.empty())
+        OldestShard->Lists.erase(it);
+
+      Evicted = std::move(Entry->Handle);
+      OldestShard->Lru.erase(Entry);
+      OldestShard->Stats.Evictions++;
+      NumIdle--;
+    }
+  }
+}
+
+command_list_cache_stats_t command_list_cache_t::getStats() {
+  command_list_cache_stats_t Stats{};
+  for (auto &Shard : Shards) {
+    std::unique_lock<ur_mutex> Lock(Shard.Mutex);
+    Stats.Hits += Shard.Stats.Hits;
+    Stats.Misses += Shard.Stats.Misses;
+    Stats.Evictions += Shard.Stats.Evictions;
+  }
+  return Stats;
 }
 
 size_t command_list_cache_t::getNumImmediateCommandLists() {
-  std::unique_lock<ur_mutex> Lock(ZeCommandListCacheMutex);
   size_t NumLists = 0;
-  for (auto &Pair : ZeCommandListCache) {
-    if (std::holds_alternative<immediate_command_list_descriptor_t>(Pair.first))
-      NumLists += Pair.second.size();
+  for (auto &Shard : Shards) {
+    std::unique_lock<ur_mutex> Lock(Shard.Mutex);
+    for (auto &Entry : Shard.Lru) {
+      if (std::holds_alternative<immediate_command_list_descriptor_t>(
+              Entry.Desc))
+        NumLists++;
+    }
   }
   return NumLists;
 }
 
 size_t command_list_cache_t::getNumRegularCommandLists() {
-  std::unique_lock<ur_mutex> Lock(ZeCommandListCacheMutex);
   size_t NumLists = 0;
-  for (auto &Pair : ZeCommandListCache) {
-    if (std::holds_alternative<regular_command_list_descriptor_t>(Pair.first))
-      NumLists += Pair.second.size();
+  for (auto &Shard : Shards) {
+    std::unique_lock<ur_mutex> Lock(Shard.Mutex);
+    for (auto &Entry : Shard.Lru) {
+      if (std::holds_alternative<regular_command_list_descriptor_t>(Entry.Desc))
+        NumLists++;
+    }
   }
   return NumLists;
 }
@@ -9,8 +9,11 @@
 //===----------------------------------------------------------------------===//
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <deque>
 #include <functional>
-#include <stack>
+#include <list>
 
 #include "latency_tracker.hpp"
 #include <ur/ur.hpp>
@@ -53,8 +56,23 @@ struct command_list_descriptor_hash_t {
   inline size_t operator()(const command_list_descriptor_t &desc) const;
 };
 
+struct command_list_cache_stats_t {
+  // Command lists taken from the cache.
+  uint64_t Hits;
+  // Command lists created because no idle one matched.
+  uint64_t Misses;
+  // Idle command lists destroyed to stay within the capacity.
+  uint64_t Evictions;
+};
+
+// Caches idle command lists by descriptor. The cache is sharded by device and
+// ordinal, each shard with its own lock, and keeps at most Capacity idle
+// command lists, destroying the least recently used ones beyond that.
 struct command_list_cache_t {
+  // Capacity defaults to UR_L0_V2_COMMAND_LIST_CACHE_CAPACITY.
   command_list_cache_t(ze_context_handle_t ZeContext);
+  command_list_cache_t(ze_context_handle_t ZeContext, size_t Capacity);
+  ~command_list_cache_t();
 
   raii::command_list_unique_handle
   getImmediateCommandList(ze_device_handle_t ZeDevice, bool IsInOrder,
@@ -66,22 +84,57 @@ struct command_list_cache_t {
   getRegularCommandList(ze_device_handle_t ZeDevice, bool IsInOrder,
                         uint32_t Ordinal, bool CopyOffloadEnable);
 
+  // Creates Count idle immediate command lists ahead of their first use.
+  void prewarmImmediateCommandLists(ze_device_handle_t ZeDevice, bool IsInOrder,
+                                    uint32_t Ordinal, bool CopyOffloadEnable,
+                                    ze_command_queue_mode_t Mode,
+                                    ze_command_queue_priority_t Priority,
+                                    size_t Count);
+
+  // Number of immediate command lists to prewarm per device when a context
+  // is created, from UR_L0_V2_COMMAND_LIST_CACHE_PREWARM.
+  static size_t getPrewarmCount();
+
+  command_list_cache_stats_t getStats();
+
   // For testing purposes
   size_t getNumImmediateCommandLists();
   size_t getNumRegularCommandLists();
 
 private:
+  struct cache_entry_t {
+    command_list_descriptor_t Desc;
+    raii::ze_command_list_handle_t Handle;
+    // Value of LruClock when the command list was returned to the cache.
+    uint64_t LastUsed;
+  };
+
+  struct shard_t {
+    ur_mutex Mutex{"command_list_cache_t::Mutex"};
+    // Idle command lists, most recently used first.
+    std::list<cache_entry_t> Lru;
+    // Idle command lists of each descriptor, least recently used first.
+    std::unordered_map<command_list_descriptor_t,
+                       std::deque<std::list<cache_entry_t>::iterator>,
+                       command_list_descriptor_hash_t>
+        Lists;
+    command_list_cache_stats_t Stats{};
+  };
+
+  static constexpr size_t NumShards = 16;
+
   ze_context_handle_t ZeContext;
-  std::unordered_map<command_list_descriptor_t,
-                     std::stack<raii::ze_command_list_handle_t>,
-                     command_list_descriptor_hash_t>
-      ZeCommandListCache;
-  ur_mutex ZeCommandListCacheMutex;
+  const size_t Capacity;
+  std::array<shard_t, NumShards> Shards;
+  std::atomic<size_t> NumIdle{0};
+  std::atomic<uint64_t> LruClock{0};
 
+  shard_t &getShard(const command_list_descriptor_t &desc);
   raii::ze_command_list_handle_t
   getCommandList(const command_list_descriptor_t &desc);
   void addCommandList(const command_list_descriptor_t &desc,
                       raii::ze_command_list_handle_t cmdList);
+  void evictIdleCommandLists();
   raii::ze_command_list_handle_t
   createCommandList(const command_list_descriptor_t &desc);
 };
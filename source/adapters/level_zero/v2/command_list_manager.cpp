@@ -15,18 +15,36 @@
 #include "context.hpp"
 #include "kernel.hpp"
 
+#include <algorithm>
+#include <atomic>
+
+static uint64_t nextCommandListManagerId() {
+  static std::atomic<uint64_t> lastId{0};
+  return ++lastId;
+}
+
 ur_command_list_manager::ur_command_list_manager(
     ur_context_handle_t context, ur_device_handle_t device,
     v2::raii::command_list_unique_handle &&commandList, v2::event_flags_t flags,
     ur_queue_t_ *queue)
-    : context(context), device(device),
+    : _ur_object("ur_command_list_manager::Mutex"), context(context),
+      device(device),
       eventPool(context->getEventPoolCache().borrow(device->Id.value(), flags)),
-      zeCommandList(std::move(commandList)), queue(queue) {
+      zeCommandList(std::move(commandList)), queue(queue),
+      id(nextCommandListManagerId()) {
   UR_CALL_THROWS(ur::level_zero::urContextRetain(context));
   UR_CALL_THROWS(ur::level_zero::urDeviceRetain(device));
 }
 
 ur_command_list_manager::~ur_command_list_manager() {
+  if (waitListStats.events) {
+    logger::info("wait lists: {} of {} events pruned ({}%), {} duplicates, "
+                 "{} on the same list, {} complete",
+                 waitListStats.pruned(), waitListStats.events,
+                 waitListStats.pruned() * 100 / waitListStats.events,
+                 waitListStats.duplicates, waitListStats.sameList,
+                 waitListStats.complete);
+  }
   ur::level_zero::urContextRelease(context);
   ur::level_zero::urDeviceRelease(device);
 }
@@ -116,13 +134,36 @@ ur_result_t ur_command_list_manager::appendRegionCopyUnlocked(
 wait_list_view
 ur_command_list_manager::getWaitListView(const ur_event_handle_t *phWaitEvents,
                                          uint32_t numWaitEvents) {
-
-  waitList.resize(numWaitEvents);
+  waitList.clear();
   for (uint32_t i = 0; i < numWaitEvents; i++) {
-    waitList[i] = phWaitEvents[i]->getZeEvent();
+    auto hEvent = phWaitEvents[i];
+    if (hEvent->getSignalListId() == id) {
+      // The command list is in-order, so the event is signaled before any
+      // command appended now runs.
+      waitListStats.sameList++;
+    } else if (hEvent->isKnownComplete()) {
+      waitListStats.complete++;
+    } else {
+      waitList.push_back(hEvent->getZeEvent());
+    }
   }
+  waitListStats.events += numWaitEvents;
+
+  if (waitList.size() > 1) {
+    std::sort(waitList.begin(), waitList.end());
+    auto end = std::unique(waitList.begin(), waitList.end());
+    waitListStats.duplicates += static_cast<uint64_t>(waitList.end() - end);
+    waitList.erase(end, waitList.end());
+  }
+
+  if (waitList.empty()) {
+    return {nullptr, 0};
+  }
+  return {waitList.data(), static_cast<uint32_t>(waitList.size())};
+}
 
-  return {waitList.data(), static_cast<uint32_t>(numWaitEvents)};
+wait_list_stats_t ur_command_list_manager::getWaitListStats() const {
+  return waitListStats;
 }
 
 ze_event_handle_t
@@ -131,6 +172,8 @@ ur_command_list_manager::getSignalEvent(ur_event_handle_t *hUserEvent,
   if (hUserEvent && queue) {
     *hUserEvent = eventPool->allocate();
     (*hUserEvent)->resetQueueAndCommand(queue, commandType);
+    // Only queues, whose command lists are in-order, signal user events.
+    (*hUserEvent)->setSignalListId(id);
     return (*hUserEvent)->getZeEvent();
   } else {
     return nullptr;
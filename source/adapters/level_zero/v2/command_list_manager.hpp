@@ -31,6 +31,20 @@ struct wait_list_view {
   }
 };
 
+struct wait_list_stats_t {
+  // Events passed in wait lists.
+  uint64_t events;
+  // Events dropped because the wait list already contained them.
+  uint64_t duplicates;
+  // Events dropped because they are signaled by an earlier command of this
+  // in-order command list.
+  uint64_t sameList;
+  // Events dropped because they were already seen complete on the host.
+  uint64_t complete;
+
+  uint64_t pruned() const { return duplicates + sameList + complete; }
+};
+
 struct ur_command_list_manager : public _ur_object {
 
   ur_command_list_manager(ur_context_handle_t context,
@@ -101,8 +115,12 @@ struct ur_command_list_manager : public _ur_object {
 
   ze_command_list_handle_t getZeCommandList();
 
+  // Returns the events to wait for, without the ones the command list does
+  // not need to wait for: duplicates, events signaled by this in-order list
+  // and events known to be complete.
   wait_list_view getWaitListView(const ur_event_handle_t *phWaitEvents,
                                  uint32_t numWaitEvents);
+  wait_list_stats_t getWaitListStats() const;
   ze_event_handle_t getSignalEvent(ur_event_handle_t *hUserEvent,
                                    ur_command_t commandType);
 
@@ -128,4 +146,8 @@ private:
   v2::raii::command_list_unique_handle zeCommandList;
   ur_queue_t_ *queue;
   std::vector<ze_event_handle_t> waitList;
+  wait_list_stats_t waitListStats{};
+  // Unique among all managers, so that events signaled by a destroyed
+  // manager are never taken for events of a new one.
+  const uint64_t id;
 };
@@ -48,7 +48,8 @@ ur_context_handle_t_::ur_context_handle_t_(ze_context_handle_t hContext,
                                            uint32_t numDevices,
                                            const ur_device_handle_t *phDevices,
                                            bool ownZeContext)
-    : hContext(hContext, ownZeContext),
+    : _ur_object("ur_context_handle_t_::Mutex"),
+      hContext(hContext, ownZeContext),
       hDevices(phDevices, phDevices + numDevices), commandListCache(hContext),
       eventPoolCache(this, phDevices[0]->Platform->getNumDevices(),
                      [context = this, platform = phDevices[0]->Platform](
@@ -68,7 +69,19 @@ ur_context_handle_t_::ur_context_handle_t_(ze_context_handle_t hContext,
                                  v2::EVENT_FLAGS_PROFILING_ENABLED)),
       p2pAccessDevices(populateP2PDevices(
           phDevices[0]->Platform->getNumDevices(), this->hDevices)),
-      defaultUSMPool(this, nullptr) {}
+      defaultUSMPool(this, nullptr) {
+  // Prewarm command lists matching those of default in-order queues.
+  if (auto prewarmCount = v2::command_list_cache_t::getPrewarmCount()) {
+    for (auto &device : hDevices) {
+      commandListCache.prewarmImmediateCommandLists(
+          device->ZeDevice, true,
+          device->QueueGroup[queue_group_type::Compute].ZeOrdinal,
+          true /* always enable copy offload */,
+          ZE_COMMAND_QUEUE_MODE_ASYNCHRONOUS, ZE_COMMAND_QUEUE_PRIORITY_NORMAL,
+          prewarmCount);
+    }
+  }
+}
 
 ur_result_t ur_context_handle_t_::retain() {
   RefCount.increment();
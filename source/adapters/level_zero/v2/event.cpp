@@ -91,8 +91,9 @@ uint64_t *event_profiling_data_t::eventEndTimestampAddr() {
 ur_event_handle_t_::ur_event_handle_t_(
     ur_context_handle_t hContext, ur_event_handle_t_::event_variant hZeEvent,
     v2::event_flags_t flags, v2::event_pool *pool)
-    : hContext(hContext), event_pool(pool), hZeEvent(std::move(hZeEvent)),
-      flags(flags), profilingData(getZeEvent()) {}
+    : _ur_object("ur_event_handle_t_::Mutex"), hContext(hContext),
+      event_pool(pool), hZeEvent(std::move(hZeEvent)), flags(flags),
+      profilingData(getZeEvent()) {}
 
 void ur_event_handle_t_::resetQueueAndCommand(ur_queue_t_ *hQueue,
                                               ur_command_t commandType) {
@@ -121,6 +122,9 @@ uint64_t ur_event_handle_t_::getEventEndTimestamp() {
 }
 
 void ur_event_handle_t_::reset() {
+  signalListId = 0;
+  knownComplete.store(false, std::memory_order_relaxed);
+
   // consider make an abstraction for regular/counter based
   // events if there's more of this type of conditions
   if (!(flags & v2::EVENT_FLAGS_COUNTER)) {
@@ -189,6 +193,22 @@ ur_context_handle_t ur_event_handle_t_::getContext() const { return hContext; }
 
 ur_command_t ur_event_handle_t_::getCommandType() const { return commandType; }
 
+uint64_t ur_event_handle_t_::getSignalListId() const { return signalListId; }
+
+void ur_event_handle_t_::setSignalListId(uint64_t listId) {
+  signalListId = listId;
+}
+
+void ur_event_handle_t_::markComplete() {
+  if (event_pool) {
+    knownComplete.store(true, std::memory_order_release);
+  }
+}
+
+bool ur_event_handle_t_::isKnownComplete() const {
+  return knownComplete.load(std::memory_order_acquire);
+}
+
 ur_event_handle_t_::ur_event_handle_t_(
     ur_context_handle_t hContext,
     v2::raii::cache_borrowed_event eventAllocation, v2::event_pool *pool)
@@ -237,6 +257,7 @@ ur_result_t urEventWait(uint32_t numEvents,
   for (uint32_t i = 0; i < numEvents; ++i) {
     ZE2UR_CALL(zeEventHostSynchronize,
                (phEventWaitList[i]->getZeEvent(), UINT64_MAX));
+    phEventWaitList[i]->markComplete();
   }
   return UR_RESULT_SUCCESS;
 } catch (...) {
@@ -255,6 +276,9 @@ ur_result_t urEventGetInfo(ur_event_handle_t hEvent, ur_event_info_t propName,
     if (zeStatus == ZE_RESULT_NOT_READY) {
       return returnValue(UR_EVENT_STATUS_SUBMITTED);
     } else {
+      if (zeStatus == ZE_RESULT_SUCCESS) {
+        hEvent->markComplete();
+      }
       return returnValue(UR_EVENT_STATUS_COMPLETE);
     }
   }
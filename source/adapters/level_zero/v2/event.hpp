@@ -9,6 +9,7 @@
 //===----------------------------------------------------------------------===//
 #pragma once
 
+#include <atomic>
 #include <stack>
 
 #include <ur/ur.hpp>
@@ -107,6 +108,16 @@ public:
   uint64_t getEventStartTimestmap() const;
   uint64_t getEventEndTimestamp();
 
+  // Id of the in-order command list manager whose command signals this
+  // event, or 0 if it is not signaled by such a list.
+  uint64_t getSignalListId() const;
+  void setSignalListId(uint64_t listId);
+
+  // Records that the event was seen complete on the host. Only pooled events
+  // are remembered, as native events may be reset by the application.
+  void markComplete();
+  bool isKnownComplete() const;
+
 private:
   ur_event_handle_t_(ur_context_handle_t hContext, event_variant hZeEvent,
                      v2::event_flags_t flags, v2::event_pool *pool);
@@ -125,4 +136,8 @@ protected:
 
   v2::event_flags_t flags;
   event_profiling_data_t profilingData;
+
+  // Both are cleared when the event is returned to its pool.
+  uint64_t signalListId = 0;
+  std::atomic<bool> knownComplete = false;
 };
@@ -8,6 +8,11 @@
 //
 //===----------------------------------------------------------------------===//
 #include "event_pool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+
 #include "common/latency_tracker.hpp"
 #include "event.hpp"
 #include "queue_api.hpp"
@@ -17,22 +22,138 @@ namespace v2 {
 
 static constexpr size_t EVENTS_BURST = 64;
 
-ur_event_handle_t event_pool::allocate() {
-  TRACK_SCOPE_LATENCY("event_pool::allocate");
+static std::atomic<uint64_t> nextPoolId{1};
+
+// Free events of one pool cached by a thread. Each thread has
+// THREAD_CACHE_SLOTS of these, looked up by pool id. An entry left behind by
+// a destroyed pool is never looked up again; its events are dropped once it
+// is evicted.
+struct event_pool::thread_cache {
+  uint64_t poolId = 0;
+  // Value of the thread's use counter when the entry was last used.
+  uint64_t lastUse = 0;
+  std::shared_ptr<shared_freelist> freelist;
+  std::vector<ur_event_handle_t> events;
+  // Hits not yet added to freelist->stats.
+  uint64_t hits = 0;
+
+  thread_cache() { events.reserve(2 * THREAD_CACHE_BATCH); }
+  ~thread_cache() { release(); }
+
+  // Returns the events beyond Keep to the shared freelist.
+  void returnEvents(size_t keep) {
+    if (!freelist) {
+      return;
+    }
+    std::unique_lock<std::mutex> lock(freelist->mutex);
+    freelist->stats.hits += hits;
+    hits = 0;
+    if (freelist->alive && events.size() > keep) {
+      // Return the least recently freed events, keeping the hot ones.
+      freelist->events.insert(freelist->events.end(), events.begin(),
+                              events.end() - keep);
+    }
+    events.erase(events.begin(), events.end() - std::min(keep, events.size()));
+  }
+
+  void release() {
+    returnEvents(0);
+    freelist.reset();
+    poolId = 0;
+  }
+};
+
+event_pool::event_pool(ur_context_handle_t hContext,
+                       std::unique_ptr<event_provider> Provider)
+    : hContext(hContext), provider(std::move(Provider)), id(nextPoolId++),
+      freelist(std::make_shared<shared_freelist>()) {}
+
+event_pool::~event_pool() {
+  if (!freelist) {
+    return;
+  }
+  // Thread caches still holding events of this pool drop them when they
+  // are next used.
+  std::unique_lock<std::mutex> lock(freelist->mutex);
+  freelist->alive = false;
+  freelist->events.clear();
+}
+
+// Caches of the calling thread.
+struct event_pool::thread_caches {
+  std::array<thread_cache, THREAD_CACHE_SLOTS> slots;
+  // Counts uses of the caches, to find the least recently used one.
+  uint64_t uses = 0;
+};
 
-  std::unique_lock<std::mutex> lock(*mutex);
+event_pool::thread_caches &event_pool::getThreadCaches() {
+  static thread_local thread_caches caches;
+  return caches;
+}
+
+event_pool::thread_cache *event_pool::findThreadCache() const {
+  for (auto &cache : getThreadCaches().slots) {
+    if (cache.poolId == id) {
+      return &cache;
+    }
+  }
+  return nullptr;
+}
 
-  if (freelist.empty()) {
-    auto start = events.size();
-    auto end = start + EVENTS_BURST;
-    for (; start < end; ++start) {
+event_pool::thread_cache &event_pool::getThreadCache() const {
+  auto &caches = getThreadCaches();
+  auto *cache = findThreadCache();
+  if (!cache) {
+    auto leastRecentlyUsed = [](const thread_cache &a, const thread_cache &b) {
+      return a.lastUse < b.lastUse;
+    };
+    cache = &*std::min_element(caches.slots.begin(), caches.slots.end(),
+                               leastRecentlyUsed);
+    cache->release();
+    cache->poolId = id;
+    cache->freelist = freelist;
+  }
+  cache->lastUse = ++caches.uses;
+  return *cache;
+}
+
+void event_pool::refill(thread_cache &cache) {
+  TRACK_SCOPE_LATENCY("event_pool::refill");
+
+  std::unique_lock<std::mutex> lock(freelist->mutex);
+
+  freelist->stats.refills++;
+  freelist->stats.hits += cache.hits;
+  cache.hits = 0;
+
+  auto &shared = freelist->events;
+  if (shared.empty()) {
+    TRACK_SCOPE_LATENCY("event_pool::provider_allocate");
+
+    for (size_t i = 0; i < EVENTS_BURST; ++i) {
       events.emplace_back(hContext, provider->allocate(), this);
-      freelist.push_back(&events.at(start));
+      shared.push_back(&events.back());
     }
+    freelist->stats.providerAllocations += EVENTS_BURST;
   }
 
-  auto event = freelist.back();
-  freelist.pop_back();
+  auto count = std::min(THREAD_CACHE_BATCH, shared.size());
+  cache.events.insert(cache.events.end(), shared.end() - count, shared.end());
+  shared.resize(shared.size() - count);
+}
+
+ur_event_handle_t event_pool::allocate() {
+  TRACK_SCOPE_LATENCY("event_pool::allocate");
+
+  auto &cache = getThreadCache();
+  if (cache.events.empty()) {
+    refill(cache);
+  } else {
+    cache.hits++;
+  }
+
+  auto event = cache.events.back();
+  cache.events.pop_back();
 
 #ifndef NDEBUG
   // Set the command type to an invalid value to catch any misuses in tests
@@ -45,14 +166,18 @@ ur_event_handle_t event_pool::allocate() {
 void event_pool::free(ur_event_handle_t event) {
   TRACK_SCOPE_LATENCY("event_pool::free");
 
-  std::unique_lock<std::mutex> lock(*mutex);
-
   event->reset();
-  freelist.push_back(event);
 
   // The event is still in the pool, so we need to increment the refcount
   assert(event->RefCount.load() == 0);
   event->RefCount.increment();
+
+  auto &cache = getThreadCache();
+  cache.events.push_back(event);
+  if (cache.events.size() >= 2 * THREAD_CACHE_BATCH) {
+    TRACK_SCOPE_LATENCY("event_pool::return");
+    cache.returnEvents(THREAD_CACHE_BATCH);
+  }
 }
 
 event_provider *event_pool::getProvider() const { return provider.get(); }
@@ -61,4 +186,15 @@ event_flags_t event_pool::getFlags() const {
   return getProvider()->eventFlags();
 }
 
+event_pool_stats event_pool::getStats() const {
+  auto *cache = findThreadCache();
+
+  std::unique_lock<std::mutex> lock(freelist->mutex);
+  auto stats = freelist->stats;
+  if (cache) {
+    stats.hits += cache->hits;
+  }
+  return stats;
+}
+
 } // namespace v2
@@ -26,13 +26,26 @@
 
 namespace v2 {
 
+struct event_pool_stats {
+  // Allocations served from the calling thread's cache without locking.
+  uint64_t hits;
+  // Times a thread cache was refilled from the shared freelist.
+  uint64_t refills;
+  // Events allocated from the provider.
+  uint64_t providerAllocations;
+};
+
+// Events are handed out from a small per-thread cache, which is refilled
+// from and returned to the shared freelist in batches, so that threads
+// submitting to the same queue only take the lock once per batch. Each thread
+// caches events of at most THREAD_CACHE_SLOTS pools; using more pools evicts
+// the least recently used cache, whose events go back to its freelist.
 class event_pool {
 public:
   // store weak reference to the queue as event_pool is part of the queue
   event_pool(ur_context_handle_t hContext,
-             std::unique_ptr<event_provider> Provider)
-      : hContext(hContext), provider(std::move(Provider)),
-        mutex(std::make_unique<std::mutex>()) {};
+             std::unique_ptr<event_provider> Provider);
+  ~event_pool();
 
   event_pool(event_pool &&other) = default;
   event_pool &operator=(event_pool &&other) = default;
@@ -49,14 +62,45 @@ public:
   event_provider *getProvider() const;
   event_flags_t getFlags() const;
 
+  // Statistics of the pool. Hits of threads other than the calling one are
+  // only included once their caches have been refilled or returned. Doesn't
+  // modify any thread cache.
+  event_pool_stats getStats() const;
+
+  // Events moved between a thread cache and the shared freelist at once.
+  static constexpr size_t THREAD_CACHE_BATCH = 16;
+  // Pools whose events a thread can cache at the same time.
+  static constexpr size_t THREAD_CACHE_SLOTS = 8;
+
 private:
+  // State shared with the thread caches, which may outlive the pool.
+  struct shared_freelist {
+    std::mutex mutex;
+    std::vector<ur_event_handle_t> events;
+    event_pool_stats stats{};
+    bool alive = true;
+  };
+
+  struct thread_cache;
+  struct thread_caches;
+  static thread_caches &getThreadCaches();
+  // Returns the calling thread's cache of this pool, or nullptr if it has
+  // none.
+  thread_cache *findThreadCache() const;
+  // Returns the calling thread's cache of this pool, evicting the least
+  // recently used cache of another pool if needed.
+  thread_cache &getThreadCache() const;
+  void refill(thread_cache &cache);
+
   ur_context_handle_t hContext;
   std::unique_ptr<event_provider> provider;
 
   std::deque<ur_event_handle_t_> events;
-  std::vector<ur_event_handle_t> freelist;
 
-  std::unique_ptr<std::mutex> mutex;
+  // Unique for the lifetime of the process, identifies the pool in thread
+  // caches.
+  uint64_t id;
+  std::shared_ptr<shared_freelist> freelist;
 };
 
 } // namespace v2
@@ -42,7 +42,7 @@ public:
 
 private:
   ur_context_handle_t hContext;
-  ur_mutex mutex;
+  ur_mutex mutex{"event_pool_cache::mutex"};
   ProviderCreateFunc providerCreate;
 
   struct event_descriptor {
@@ -38,9 +38,91 @@ ur_result_t ur_single_device_kernel_t::release() {
   return UR_RESULT_SUCCESS;
 }
 
+ze_result_t ur_single_device_kernel_t::setArgValue(uint32_t argIndex,
+                                                   size_t argSize,
+                                                   const void *pArgValue) {
+  if (lastArgValues.size() <= argIndex) {
+    lastArgValues.resize(argIndex + 1);
+  }
+  auto &last = lastArgValues[argIndex];
+  auto bytes = static_cast<const char *>(pArgValue);
+
+  if (elideStateCalls && last && last->size == argSize &&
+      last->isNull == !pArgValue &&
+      (!pArgValue || std::equal(bytes, bytes + argSize, last->bytes.begin()))) {
+    TRACK_SCOPE_LATENCY("ur_single_device_kernel_t::elidedSetArgumentValue");
+    return ZE_RESULT_SUCCESS;
+  }
+
+  TRACK_SCOPE_LATENCY("ur_single_device_kernel_t::zeKernelSetArgumentValue");
+  auto zeResult =
+      ZE_CALL_NOCHECK(zeKernelSetArgumentValue,
+                      (hKernel.get(), argIndex, argSize, pArgValue));
+  if (zeResult != ZE_RESULT_SUCCESS) {
+    last.reset();
+    return zeResult;
+  }
+
+  if (!last) {
+    last.emplace();
+  }
+  last->size = argSize;
+  last->isNull = !pArgValue;
+  if (pArgValue) {
+    last->bytes.assign(bytes, bytes + argSize);
+  } else {
+    last->bytes.clear();
+  }
+  return ZE_RESULT_SUCCESS;
+}
+
+ur_result_t ur_single_device_kernel_t::setGroupSize(uint32_t groupSizeX,
+                                                    uint32_t groupSizeY,
+                                                    uint32_t groupSizeZ) {
+  std::array<uint32_t, 3> groupSize{groupSizeX, groupSizeY, groupSizeZ};
+  if (elideStateCalls && lastGroupSize == groupSize) {
+    TRACK_SCOPE_LATENCY("ur_single_device_kernel_t::elidedSetGroupSize");
+    return UR_RESULT_SUCCESS;
+  }
+
+  TRACK_SCOPE_LATENCY("ur_single_device_kernel_t::zeKernelSetGroupSize");
+  lastGroupSize.reset();
+  ZE2UR_CALL(zeKernelSetGroupSize,
+             (hKernel.get(), groupSizeX, groupSizeY, groupSizeZ));
+  lastGroupSize = groupSize;
+  return UR_RESULT_SUCCESS;
+}
+
+ur_result_t
+ur_single_device_kernel_t::setGlobalOffset(ur_context_handle_t hContext,
+                                           uint32_t workDim,
+                                           const size_t *pGlobalWorkOffset) {
+  std::array<size_t, 3> globalOffset{
+      pGlobalWorkOffset[0], workDim > 1 ? pGlobalWorkOffset[1] : 0,
+      workDim > 2 ? pGlobalWorkOffset[2] : 0};
+  if (elideStateCalls && lastGlobalOffset == globalOffset) {
+    TRACK_SCOPE_LATENCY("ur_single_device_kernel_t::elidedSetGlobalOffset");
+    return UR_RESULT_SUCCESS;
+  }
+
+  TRACK_SCOPE_LATENCY("ur_single_device_kernel_t::setKernelGlobalOffset");
+  lastGlobalOffset.reset();
+  UR_CALL(setKernelGlobalOffset(hContext, hKernel.get(), 3,
+                                globalOffset.data()));
+  lastGlobalOffset = globalOffset;
+  return UR_RESULT_SUCCESS;
+}
+
+void ur_single_device_kernel_t::disableStateElision() {
+  elideStateCalls = false;
+  lastArgValues.clear();
+  lastGroupSize.reset();
+  lastGlobalOffset.reset();
+}
+
 ur_kernel_handle_t_::ur_kernel_handle_t_(ur_program_handle_t hProgram,
                                          const char *kernelName)
-    : hProgram(hProgram),
+    : _ur_object("ur_kernel_handle_t_::Mutex"), hProgram(hProgram),
       deviceKernels(hProgram->Context->getPlatform()->getNumDevices()) {
   ur::level_zero::urProgramRetain(hProgram);
 
@@ -75,7 +157,7 @@ ur_kernel_handle_t_::ur_kernel_handle_t_(
     ur_native_handle_t hNativeKernel, ur_program_handle_t hProgram,
     ur_context_handle_t context,
     const ur_kernel_native_properties_t *pProperties)
-    : hProgram(hProgram),
+    : _ur_object("ur_kernel_handle_t_::Mutex"), hProgram(hProgram),
       deviceKernels(context ? context->getPlatform()->getNumDevices() : 0) {
   ur::level_zero::urProgramRetain(hProgram);
 
@@ -94,6 +176,10 @@ ur_kernel_handle_t_::ur_kernel_handle_t_(
     ownZeHandle = false;
   }
   completeInitialization();
+
+  // The entries share the native kernel, which the application may also
+  // change directly.
+  disableStateElision();
 }
 
 ur_result_t ur_kernel_handle_t_::release() {
@@ -162,6 +248,22 @@ ze_kernel_handle_t ur_kernel_handle_t_::getNativeZeHandle() const {
   return nullptr;
 }
 
+void ur_kernel_handle_t_::disableStateElision() {
+  for (auto &singleDeviceKernel : deviceKernels) {
+    if (singleDeviceKernel.has_value()) {
+      singleDeviceKernel.value().disableStateElision();
+    }
+  }
+}
+
+ur_result_t ur_kernel_handle_t_::setGroupSize(ur_device_handle_t hDevice,
+                                              uint32_t groupSizeX,
+                                              uint32_t groupSizeY,
+                                              uint32_t groupSizeZ) {
+  auto &deviceKernel = deviceKernels[deviceIndex(hDevice)].value();
+  return deviceKernel.setGroupSize(groupSizeX, groupSizeY, groupSizeZ);
+}
+
 ze_kernel_handle_t
 ur_kernel_handle_t_::getZeHandle(ur_device_handle_t hDevice) {
   auto &deviceKernel = deviceKernels[deviceIndex(hDevice)].value();
@@ -206,9 +308,8 @@ ur_result_t ur_kernel_handle_t_::setArgValue(
       continue;
     }
 
-    auto zeResult = ZE_CALL_NOCHECK(zeKernelSetArgumentValue,
-                                    (singleDeviceKernel.value().hKernel.get(),
-                                     argIndex, argSize, pArgValue));
+    auto zeResult =
+        singleDeviceKernel.value().setArgValue(argIndex, argSize, pArgValue);
 
     if (zeResult == ZE_RESULT_ERROR_INVALID_ARGUMENT) {
       return UR_RESULT_ERROR_INVALID_KERNEL_ARGUMENT_SIZE;
@@ -278,23 +379,30 @@ ur_result_t ur_kernel_handle_t_::prepareForSubmission(
     const size_t *pGlobalWorkOffset, uint32_t workDim, uint32_t groupSizeX,
     uint32_t groupSizeY, uint32_t groupSizeZ,
     std::function<void(void *, void *, size_t)> migrate) {
-  auto hZeKernel = getZeHandle(hDevice);
+  auto &deviceKernel = deviceKernels[deviceIndex(hDevice)].value();
 
   if (pGlobalWorkOffset != NULL) {
     UR_CALL(
-        setKernelGlobalOffset(hContext, hZeKernel, workDim, pGlobalWorkOffset));
+        deviceKernel.setGlobalOffset(hContext, workDim, pGlobalWorkOffset));
   }
 
-  ZE2UR_CALL(zeKernelSetGroupSize,
-             (hZeKernel, groupSizeX, groupSizeY, groupSizeZ));
+  UR_CALL(deviceKernel.setGroupSize(groupSizeX, groupSizeY, groupSizeZ));
 
   for (auto &pending : pending_allocations) {
     void *zePtr = nullptr;
     if (pending.hMem) {
       if (!pending.hMem->isImage()) {
         auto hBuffer = pending.hMem->getBuffer();
-        zePtr = hBuffer->getDevicePtr(hDevice, pending.mode, 0,
-                                      hBuffer->getSize(), migrate);
+        // Kernels cannot write to read-only buffers, whatever the argument
+        // says, so that their copies on other devices stay valid.
+        auto mode = hBuffer->getDeviceAccessMode() ==
+                            ur_mem_buffer_t::device_access_mode_t::read_only
+                        ? ur_mem_buffer_t::device_access_mode_t::read_only
+                        : pending.mode;
+        // Launches on other queues may migrate the same buffer concurrently.
+        std::scoped_lock<ur_shared_mutex> lock(hBuffer->getMutex());
+        zePtr = hBuffer->getDevicePtr(hDevice, mode, 0, hBuffer->getSize(),
+                                      migrate);
       } else {
         auto hImage = static_cast<ur_mem_image_t *>(pending.hMem->getImage());
         zePtr = reinterpret_cast<void *>(hImage->getZeImage());
@@ -341,6 +449,9 @@ ur_result_t urKernelCreate(ur_program_handle_t hProgram,
 
 ur_result_t urKernelGetNativeHandle(ur_kernel_handle_t hKernel,
                                     ur_native_handle_t *phNativeKernel) try {
+  std::scoped_lock<ur_shared_mutex> guard(hKernel->Mutex);
+  hKernel->disableStateElision();
+
   // Return the handle of the kernel for the first device
   *phNativeKernel =
       reinterpret_cast<ur_native_handle_t>(hKernel->getNativeZeHandle());
@@ -691,8 +802,9 @@ ur_result_t urKernelSuggestMaxCooperativeGroupCountExp(
   wg[0] = ur_cast<uint32_t>(pLocalWorkSize[0]);
   wg[1] = workDim >= 2 ? ur_cast<uint32_t>(pLocalWorkSize[1]) : 1;
   wg[2] = workDim == 3 ? ur_cast<uint32_t>(pLocalWorkSize[2]) : 1;
-  ZE2UR_CALL(zeKernelSetGroupSize,
-             (hKernel->getZeHandle(hDevice), wg[0], wg[1], wg[2]));
+
+  std::scoped_lock<ur_shared_mutex> guard(hKernel->Mutex);
+  UR_CALL(hKernel->setGroupSize(hDevice, wg[0], wg[1], wg[2]));
 
   uint32_t totalGroupCount = 0;
   ZE2UR_CALL(zeKernelSuggestMaxCooperativeGroupCount,
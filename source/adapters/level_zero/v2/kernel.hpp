@@ -10,6 +10,10 @@
 
 #pragma once
 
+#include <array>
+#include <optional>
+#include <vector>
+
 #include "../program.hpp"
 
 #include "common.hpp"
@@ -20,9 +24,36 @@ struct ur_single_device_kernel_t {
                             ze_kernel_handle_t hKernel, bool ownZeHandle);
   ur_result_t release();
 
+  // Set the state of hKernel, skipping the driver call if the value is the
+  // one last set.
+  ze_result_t setArgValue(uint32_t argIndex, size_t argSize,
+                          const void *pArgValue);
+  ur_result_t setGroupSize(uint32_t groupSizeX, uint32_t groupSizeY,
+                           uint32_t groupSizeZ);
+  ur_result_t setGlobalOffset(ur_context_handle_t hContext, uint32_t workDim,
+                              const size_t *pGlobalWorkOffset);
+
+  // Stop skipping driver calls, for kernels whose state may be changed through
+  // their native handle.
+  void disableStateElision();
+
   ur_device_handle_t hDevice;
   v2::raii::ze_kernel_handle_t hKernel;
   mutable ZeCache<ZeStruct<ze_kernel_properties_t>> zeKernelProperties;
+
+private:
+  struct arg_value_t {
+    size_t size;
+    // The value is null for local memory and null pointer arguments.
+    bool isNull;
+    std::vector<char> bytes;
+  };
+
+  // Values last set on hKernel, indexed by argument index.
+  bool elideStateCalls = true;
+  std::vector<std::optional<arg_value_t>> lastArgValues;
+  std::optional<std::array<uint32_t, 3>> lastGroupSize;
+  std::optional<std::array<size_t, 3>> lastGlobalOffset;
 };
 
 struct ur_kernel_handle_t_ : _ur_object {
@@ -48,6 +79,14 @@ public:
   // Get handle of the kernel for urKernelGetNativeHandle.
   ze_kernel_handle_t getNativeZeHandle() const;
 
+  // Stop skipping redundant driver calls, as the state of the kernel may be
+  // changed through its native handle.
+  void disableStateElision();
+
+  // Implementation of zeKernelSetGroupSize for a given device.
+  ur_result_t setGroupSize(ur_device_handle_t hDevice, uint32_t groupSizeX,
+                           uint32_t groupSizeY, uint32_t groupSizeZ);
+
   // Get program handle of the kernel.
   ur_program_handle_t getProgramHandle() const;
 
@@ -36,7 +36,8 @@ static bool isAccessCompatible(ur_mem_buffer_t::device_access_mode_t requested,
 
 ur_mem_buffer_t::ur_mem_buffer_t(ur_context_handle_t hContext, size_t size,
                                  device_access_mode_t accessMode)
-    : hContext(hContext), size(size), accessMode(accessMode) {}
+    : _ur_object("ur_mem_buffer_t::Mutex"), hContext(hContext), size(size),
+      accessMode(accessMode) {}
 
 ur_shared_mutex &ur_mem_buffer_t::getMutex() { return Mutex; }
 
@@ -185,24 +186,47 @@ void *ur_discrete_buffer_handle_t::allocateOnDevice(ur_device_handle_t hDevice,
           logger::error("Failed to free device memory: {}", ret);
         }
       });
-
-  activeAllocationDevice = hDevice;
+  allocationDevices[id] = hDevice;
 
   return ptr;
 }
 
-ur_result_t
-ur_discrete_buffer_handle_t::migrateBufferTo(ur_device_handle_t hDevice,
-                                             void *src, size_t size) {
-  TRACK_SCOPE_LATENCY("ur_discrete_buffer_handle_t::migrateBufferTo");
+void *ur_discrete_buffer_handle_t::getHostCopy() {
+  if (hostCopy) {
+    return hostCopy.get();
+  }
+  // The memory written back to on release holds the host copy, so that a
+  // valid host copy is never left unwritten.
+  if (writeBackPtr) {
+    hostCopy = usm_unique_ptr_t(writeBackPtr, [](void *) {});
+    return hostCopy.get();
+  }
 
-  auto Id = hDevice->Id.value();
-  void *dst = deviceAllocations[Id].get() ? deviceAllocations[Id].get()
-                                          : allocateOnDevice(hDevice, size);
+  void *ptr;
+  UR_CALL_THROWS(hContext->getDefaultUSMPool()->allocate(
+      hContext, nullptr, nullptr, UR_USM_TYPE_HOST, getSize(), &ptr));
+  hostCopy = usm_unique_ptr_t(ptr, [hContext = this->hContext](void *ptr) {
+    auto ret = hContext->getDefaultUSMPool()->free(ptr);
+    if (ret != UR_RESULT_SUCCESS) {
+      logger::error("Failed to free host memory: {}", ret);
+    }
+  });
+  return ptr;
+}
 
-  UR_CALL(synchronousZeCopy(hContext, hDevice, dst, src, size));
+void *ur_discrete_buffer_handle_t::getLocationPtr(location_t location,
+                                                  size_t offset) {
+  void *ptr = location == residency.host() ? hostCopy.get()
+                                           : deviceAllocations[location].get();
+  assert(ptr);
+  return ur_cast<char *>(ptr) + offset;
+}
 
-  return UR_RESULT_SUCCESS;
+bool ur_discrete_buffer_handle_t::isP2PAccessible(ur_device_handle_t hDevice,
+                                                  location_t location) {
+  auto &p2pDevices = hContext->getP2PDevices(hDevice);
+  return std::find(p2pDevices.begin(), p2pDevices.end(),
+                   allocationDevices[location]) != p2pDevices.end();
 }
 
 ur_discrete_buffer_handle_t::ur_discrete_buffer_handle_t(
@@ -210,10 +234,14 @@ ur_discrete_buffer_handle_t::ur_discrete_buffer_handle_t(
     device_access_mode_t accessMode)
     : ur_mem_buffer_t(hContext, size, accessMode),
       deviceAllocations(hContext->getPlatform()->getNumDevices()),
-      activeAllocationDevice(nullptr), mapToPtr(hostPtr), hostAllocations() {
+      allocationDevices(deviceAllocations.size()),
+      residency(deviceAllocations.size()), mapToPtr(hostPtr),
+      hostAllocations() {
   if (hostPtr) {
-    auto initialDevice = hContext->getDevices()[0];
-    UR_CALL_THROWS(migrateBufferTo(initialDevice, hostPtr, size));
+    // The buffer is not placed on any device until it is used, so the host
+    // memory, which may be freed once the buffer is created, is copied.
+    std::memcpy(getHostCopy(), hostPtr, size);
+    residency.markAccessed(residency.host(), true);
   }
 }
 
@@ -223,37 +251,39 @@ ur_discrete_buffer_handle_t::ur_discrete_buffer_handle_t(
     bool ownZePtr)
     : ur_mem_buffer_t(hContext, size, accessMode),
       deviceAllocations(hContext->getPlatform()->getNumDevices()),
-      activeAllocationDevice(hDevice), writeBackPtr(writeBackMemory),
+      allocationDevices(deviceAllocations.size()),
+      residency(deviceAllocations.size()), writeBackPtr(writeBackMemory),
       hostAllocations() {
 
   if (!devicePtr) {
-    hDevice = hDevice ? hDevice : hContext->getDevices()[0];
-    devicePtr = allocateOnDevice(hDevice, size);
+    // The host memory is migrated to a device when the buffer is first used
+    // on it, and written back on release.
+    getHostCopy();
+    residency.markAccessed(residency.host(), true);
   } else {
-    deviceAllocations[hDevice->Id.value()] = usm_unique_ptr_t(
+    auto id = hDevice->Id.value();
+    deviceAllocations[id] = usm_unique_ptr_t(
         devicePtr, [hContext = this->hContext, ownZePtr](void *ptr) {
           if (!ownZePtr) {
             return;
           }
           ZE_CALL_NOCHECK(zeMemFree, (hContext->getZeHandle(), ptr));
         });
+    allocationDevices[id] = hDevice;
+    residency.markAccessed(id, true);
   }
 }
 
 ur_discrete_buffer_handle_t::~ur_discrete_buffer_handle_t() {
-  if (!activeAllocationDevice || !writeBackPtr)
+  if (!writeBackPtr || residency.isValid(residency.host()))
     return;
 
-  auto srcPtr = getActiveDeviceAlloc();
-  synchronousZeCopy(hContext, activeAllocationDevice, writeBackPtr, srcPtr,
-                    getSize());
-}
+  auto source = residency.anyValidDevice();
+  if (!source)
+    return;
 
-void *ur_discrete_buffer_handle_t::getActiveDeviceAlloc(size_t offset) {
-  assert(activeAllocationDevice);
-  return ur_cast<char *>(
-             deviceAllocations[activeAllocationDevice->Id.value()].get()) +
-         offset;
+  synchronousZeCopy(hContext, allocationDevices[*source], writeBackPtr,
+                    getLocationPtr(*source), getSize());
 }
 
 void *ur_discrete_buffer_handle_t::getDevicePtr(
@@ -261,36 +291,49 @@ void *ur_discrete_buffer_handle_t::getDevicePtr(
     size_t size, std::function<void(void *src, void *dst, size_t)> migrate) {
   TRACK_SCOPE_LATENCY("ur_discrete_buffer_handle_t::getDevicePtr");
 
-  std::ignore = access;
   std::ignore = size;
-  std::ignore = migrate;
-  if (!activeAllocationDevice) {
-    if (!hDevice) {
-      hDevice = hContext->getDevices()[0];
-    }
-
-    allocateOnDevice(hDevice, getSize());
-  }
-
   if (!hDevice) {
-    hDevice = activeAllocationDevice;
+    auto validDevice = residency.anyValidDevice();
+    hDevice = validDevice ? allocationDevices[*validDevice]
+                          : hContext->getDevices()[0];
   }
 
-  if (activeAllocationDevice == hDevice) {
-    return getActiveDeviceAlloc(offset);
+  auto id = hDevice->Id.value();
+  void *ptr = deviceAllocations[id] ? deviceAllocations[id].get()
+                                    : allocateOnDevice(hDevice, getSize());
+
+  auto canCopyFrom = [&](location_t location) {
+    return location == residency.host() || isP2PAccessible(hDevice, location);
+  };
+  auto source = residency.getMigrationSource(id, canCopyFrom);
+  if (source) {
+    TRACK_SCOPE_LATENCY("ur_discrete_buffer_handle_t::migrate");
+    auto srcPtr = getLocationPtr(*source);
+    if (!canCopyFrom(*source)) {
+      // Stage the contents in the host copy, which stays valid, as it is
+      // only read from afterwards.
+      auto hostPtr = getHostCopy();
+      if (migrate) {
+        migrate(srcPtr, hostPtr, getSize());
+      } else {
+        UR_CALL_THROWS(synchronousZeCopy(hContext, allocationDevices[*source],
+                                         hostPtr, srcPtr, getSize()));
+      }
+      residency.markAccessed(residency.host(), false);
+      srcPtr = hostPtr;
+    }
+    if (migrate) {
+      migrate(srcPtr, ptr, getSize());
+    } else {
+      // Only native handle queries have no queue to migrate on.
+      UR_CALL_THROWS(
+          synchronousZeCopy(hContext, hDevice, ptr, srcPtr, getSize()));
+    }
   }
 
-  auto &p2pDevices = hContext->getP2PDevices(hDevice);
-  auto p2pAccessible = std::find(p2pDevices.begin(), p2pDevices.end(),
-                                 activeAllocationDevice) != p2pDevices.end();
-
-  if (!p2pAccessible) {
-    // TODO: migrate buffer through the host
-    throw UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
-  }
+  residency.markAccessed(id, access != device_access_mode_t::read_only);
 
-  // TODO: see if it's better to migrate the memory to the specified device
-  return getActiveDeviceAlloc(offset);
+  return ur_cast<char *>(ptr) + offset;
 }
 
 void *ur_discrete_buffer_handle_t::mapHostPtr(
@@ -317,9 +360,15 @@ void *ur_discrete_buffer_handle_t::mapHostPtr(
 
   hostAllocations.emplace_back(std::move(mappedPtr), size, offset, flags);
 
-  if (activeAllocationDevice && (flags & UR_MAP_FLAG_READ)) {
-    auto srcPtr = getActiveDeviceAlloc(offset);
-    migrate(srcPtr, hostAllocations.back().ptr.get(), size);
+  if (flags & UR_MAP_FLAG_READ) {
+    auto source = residency.anyValidDevice();
+    if (!source && residency.isValid(residency.host())) {
+      source = residency.host();
+    }
+    if (source) {
+      migrate(getLocationPtr(*source, offset),
+              hostAllocations.back().ptr.get(), size);
+    }
   }
 
   return hostAllocations.back().ptr.get();
@@ -343,16 +392,27 @@ void ur_discrete_buffer_handle_t::unmapHostPtr(
   bool shouldMigrateToDevice =
       !(hostAlloc->flags & UR_MAP_FLAG_WRITE_INVALIDATE_REGION);
 
-  if (!activeAllocationDevice && shouldMigrateToDevice) {
-    allocateOnDevice(hContext->getDevices()[0], getSize());
+  // The mapped memory is copied to a valid copy, which becomes the only
+  // valid one if it may have been written to.
+  auto target = residency.anyValidDevice();
+  if (!target && residency.isValid(residency.host())) {
+    target = residency.host();
+  }
+  if (!target && shouldMigrateToDevice) {
+    auto hDevice = hContext->getDevices()[0];
+    allocateOnDevice(hDevice, getSize());
+    target = hDevice->Id.value();
   }
 
   // TODO: tests require that memory is migrated even for
-  // UR_MAP_FLAG_WRITE_INVALIDATE_REGION when there is an active device
-  // allocation. is this correct?
-  if (activeAllocationDevice) {
-    migrate(hostAlloc->ptr.get(), getActiveDeviceAlloc(hostAlloc->offset),
+  // UR_MAP_FLAG_WRITE_INVALIDATE_REGION when there is a valid copy.
+  // is this correct?
+  if (target) {
+    migrate(hostAlloc->ptr.get(), getLocationPtr(*target, hostAlloc->offset),
             hostAlloc->size);
+    bool written = hostAlloc->flags & (UR_MAP_FLAG_WRITE |
+                                       UR_MAP_FLAG_WRITE_INVALIDATE_REGION);
+    residency.markAccessed(*target, written);
   }
 
   hostAllocations.erase(hostAlloc);
@@ -409,7 +469,7 @@ ur_mem_image_t::ur_mem_image_t(ur_context_handle_t hContext,
                                ur_mem_flags_t flags,
                                const ur_image_format_t *pImageFormat,
                                const ur_image_desc_t *pImageDesc, void *pHost)
-    : hContext(hContext) {
+    : _ur_object("ur_mem_image_t::Mutex"), hContext(hContext) {
   UR_CALL_THROWS(ur2zeImageDesc(pImageFormat, pImageDesc, zeImageDesc));
 
   // Currently we have the "0" device in context with mutliple root devices to
@@ -435,7 +495,8 @@ ur_mem_image_t::ur_mem_image_t(ur_context_handle_t hContext,
                                const ur_image_format_t *pImageFormat,
                                const ur_image_desc_t *pImageDesc,
                                ze_image_handle_t zeImage, bool ownZeImage)
-    : hContext(hContext), zeImage(zeImage, ownZeImage) {
+    : _ur_object("ur_mem_image_t::Mutex"), hContext(hContext),
+      zeImage(zeImage, ownZeImage) {
   UR_CALL_THROWS(ur2zeImageDesc(pImageFormat, pImageDesc, zeImageDesc));
 }
 
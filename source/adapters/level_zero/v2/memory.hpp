@@ -15,6 +15,7 @@
 #include <ur_api.h>
 
 #include "../device.hpp"
+#include "buffer_residency.hpp"
 #include "common.hpp"
 
 using usm_unique_ptr_t = std::unique_ptr<void, std::function<void(void *)>>;
@@ -109,11 +110,13 @@ struct host_allocation_desc_t {
 };
 
 // Manages memory buffer for discrete GPU.
-// Memory is allocated on the device and migrated/copies if necessary.
+// Memory is allocated on each device when the buffer is first used on it.
+// The contents are migrated between devices with copies enqueued on the
+// submitting queue, through host memory if the devices have no peer access,
+// and copies only read from stay valid on all devices.
 struct ur_discrete_buffer_handle_t : ur_mem_buffer_t {
-  // If hostPtr is not null, the buffer is allocated immediately on the
-  // first device in the context. Otherwise, the buffer is allocated on
-  // firt getDevicePtr call.
+  // If hostPtr is not null, its contents are copied to host memory and
+  // migrated to a device when the buffer is first used on it.
   ur_discrete_buffer_handle_t(ur_context_handle_t hContext, void *hostPtr,
                               size_t size, device_access_mode_t accesMode);
   ~ur_discrete_buffer_handle_t();
@@ -134,14 +137,20 @@ struct ur_discrete_buffer_handle_t : ur_mem_buffer_t {
                     std::function<void(void *src, void *dst, size_t)>) override;
 
 private:
-  void *getCurrentAllocation();
+  using location_t = v2::buffer_residency_t::location_t;
 
   // Vector of per-device allocations indexed by device->Id
   std::vector<usm_unique_ptr_t> deviceAllocations;
 
-  // Specifies device on which the latest allocation resides.
-  // If null, there is no allocation.
-  ur_device_handle_t activeAllocationDevice = nullptr;
+  // Device of each allocation in deviceAllocations.
+  std::vector<ur_device_handle_t> allocationDevices;
+
+  // Copy of the buffer in host memory, if it was created from host memory or
+  // migrated through the host.
+  usm_unique_ptr_t hostCopy;
+
+  // Which of the device allocations and the host copy are up to date.
+  v2::buffer_residency_t residency;
 
   // If not null, copy the buffer content back to this memory on release.
   void *writeBackPtr = nullptr;
@@ -151,10 +160,12 @@ private:
 
   std::vector<host_allocation_desc_t> hostAllocations;
 
-  void *getActiveDeviceAlloc(size_t offset = 0);
+  // Returns the allocation of a valid copy.
+  void *getLocationPtr(location_t location, size_t offset = 0);
   void *allocateOnDevice(ur_device_handle_t hDevice, size_t size);
-  ur_result_t migrateBufferTo(ur_device_handle_t hDevice, void *src,
-                              size_t size);
+  // Returns the host copy, allocating it if needed.
+  void *getHostCopy();
+  bool isP2PAccessible(ur_device_handle_t hDevice, location_t location);
 };
 
 struct ur_mem_sub_buffer_t : ur_mem_buffer_t {
@@ -410,6 +410,47 @@ ur_result_t urEnqueueKernelLaunchCustomExp(
 } catch (...) {
   return exceptionToResult(std::current_exception());
 }
+ur_result_t urEnqueueBatchExp(ur_queue_handle_t hQueue, uint32_t numCommands,
+                              const ur_exp_batch_command_t *pCommands,
+                              uint32_t numEventsInWaitList,
+                              const ur_event_handle_t *phEventWaitList,
+                              ur_event_handle_t *phEvent) try {
+  return hQueue->get().enqueueBatchExp(numCommands, pCommands,
+                                       numEventsInWaitList, phEventWaitList,
+                                       phEvent);
+} catch (...) {
+  return exceptionToResult(std::current_exception());
+}
+ur_result_t urEnqueueHostTaskExp(ur_queue_handle_t hQueue,
+                                 ur_exp_host_task_function_t pfnHostTask,
+                                 void *pUserData, uint32_t numEventsInWaitList,
+                                 const ur_event_handle_t *phEventWaitList,
+                                 ur_event_handle_t *phEvent) try {
+  return hQueue->get().enqueueHostTaskExp(pfnHostTask, pUserData,
+                                          numEventsInWaitList, phEventWaitList,
+                                          phEvent);
+} catch (...) {
+  return exceptionToResult(std::current_exception());
+}
+ur_result_t urEnqueueUSMAllocExp(ur_queue_handle_t hQueue,
+                                 const ur_usm_desc_t *pUSMDesc, size_t size,
+                                 uint32_t numEventsInWaitList,
+                                 const ur_event_handle_t *phEventWaitList,
+                                 void **ppMem, ur_event_handle_t *phEvent) try {
+  return hQueue->get().enqueueUSMAllocExp(pUSMDesc, size, numEventsInWaitList,
+                                          phEventWaitList, ppMem, phEvent);
+} catch (...) {
+  return exceptionToResult(std::current_exception());
+}
+ur_result_t urEnqueueUSMFreeExp(ur_queue_handle_t hQueue, void *pMem,
+                                uint32_t numEventsInWaitList,
+                                const ur_event_handle_t *phEventWaitList,
+                                ur_event_handle_t *phEvent) try {
+  return hQueue->get().enqueueUSMFreeExp(pMem, numEventsInWaitList,
+                                         phEventWaitList, phEvent);
+} catch (...) {
+  return exceptionToResult(std::current_exception());
+}
 ur_result_t urEnqueueEventsWaitWithBarrierExt(
     ur_queue_handle_t hQueue,
     const ur_exp_enqueue_ext_properties_t *pProperties,
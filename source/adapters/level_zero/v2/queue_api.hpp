@@ -150,6 +150,18 @@ struct ur_queue_t_ {
       ur_kernel_handle_t, uint32_t, const size_t *, const size_t *,
       const size_t *, uint32_t, const ur_exp_launch_property_t *, uint32_t,
       const ur_event_handle_t *, ur_event_handle_t *) = 0;
+  virtual ur_result_t enqueueBatchExp(uint32_t, const ur_exp_batch_command_t *,
+                                      uint32_t, const ur_event_handle_t *,
+                                      ur_event_handle_t *) = 0;
+  virtual ur_result_t enqueueHostTaskExp(ur_exp_host_task_function_t, void *,
+                                         uint32_t, const ur_event_handle_t *,
+                                         ur_event_handle_t *) = 0;
+  virtual ur_result_t enqueueUSMAllocExp(const ur_usm_desc_t *, size_t,
+                                         uint32_t, const ur_event_handle_t *,
+                                         void **, ur_event_handle_t *) = 0;
+  virtual ur_result_t enqueueUSMFreeExp(void *, uint32_t,
+                                        const ur_event_handle_t *,
+                                        ur_event_handle_t *) = 0;
   virtual ur_result_t
   enqueueEventsWaitWithBarrierExt(const ur_exp_enqueue_ext_properties_t *,
                                   uint32_t, const ur_event_handle_t *,
@@ -12,6 +12,7 @@
 #include "kernel.hpp"
 #include "memory.hpp"
 #include "ur.hpp"
+#include "ur_enqueue_batch.hpp"
 
 #include "../common/latency_tracker.hpp"
 #include "../helpers/kernel_helpers.hpp"
@@ -60,7 +61,8 @@ static event_flags_t eventFlagsFromQueueFlags(ur_queue_flags_t flags) {
 ur_queue_immediate_in_order_t::ur_queue_immediate_in_order_t(
     ur_context_handle_t hContext, ur_device_handle_t hDevice,
     const ur_queue_properties_t *pProps)
-    : hContext(hContext), hDevice(hDevice), flags(pProps ? pProps->flags : 0),
+    : _ur_object("ur_queue_immediate_in_order_t::Mutex"), hContext(hContext),
+      hDevice(hDevice), flags(pProps ? pProps->flags : 0),
       commandListManager(
           hContext, hDevice,
           hContext->getCommandListCache().getImmediateCommandList(
@@ -74,7 +76,8 @@ ur_queue_immediate_in_order_t::ur_queue_immediate_in_order_t(
 ur_queue_immediate_in_order_t::ur_queue_immediate_in_order_t(
     ur_context_handle_t hContext, ur_device_handle_t hDevice,
     ur_native_handle_t hNativeHandle, ur_queue_flags_t flags, bool ownZeQueue)
-    : hContext(hContext), hDevice(hDevice), flags(flags),
+    : _ur_object("ur_queue_immediate_in_order_t::Mutex"), hContext(hContext),
+      hDevice(hDevice), flags(flags),
       commandListManager(
           hContext, hDevice,
           raii::command_list_unique_handle(
@@ -560,7 +563,7 @@ ur_result_t ur_queue_immediate_in_order_t::enqueueGenericFillUnlocked(
   auto waitListView = getWaitListView(phEventWaitList, numEventsInWaitList);
 
   auto pDst = ur_cast<char *>(hBuffer->getDevicePtr(
-      hDevice, ur_mem_buffer_t::device_access_mode_t::read_only, offset, size,
+      hDevice, ur_mem_buffer_t::device_access_mode_t::write_only, offset, size,
       [&](void *src, void *dst, size_t size) {
         ZE2UR_CALL_THROWS(zeCommandListAppendMemoryCopy,
                           (commandListManager.getZeCommandList(), dst, src,
@@ -984,6 +987,88 @@ ur_result_t ur_queue_immediate_in_order_t::enqueueKernelLaunchCustomExp(
   return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
 }
 
+ur_result_t ur_queue_immediate_in_order_t::enqueueBatchExp(
+    uint32_t numCommands, const ur_exp_batch_command_t *pCommands,
+    uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
+    ur_event_handle_t *phEvent) {
+  TRACK_SCOPE_LATENCY("ur_queue_immediate_in_order_t::enqueueBatchExp");
+
+  UR_CALL(ur::batch::validate(numCommands, pCommands));
+
+  // The commands execute in order, so the dependencies within the batch and
+  // its barriers are satisfied already: only the first command has to wait
+  // for the wait list, and only the last one has to signal phEvent.
+  for (uint32_t i = 0; i < numCommands; i++) {
+    auto &command = pCommands[i];
+    bool isLast = i == numCommands - 1;
+    auto *phCommandEvent = isLast ? phEvent : nullptr;
+
+    switch (command.type) {
+    case UR_EXP_BATCH_COMMAND_TYPE_KERNEL_LAUNCH: {
+      auto &args = command.args.kernelLaunch;
+      UR_CALL(enqueueKernelLaunch(args.hKernel, args.workDim,
+                                  args.pGlobalWorkOffset, args.pGlobalWorkSize,
+                                  args.pLocalWorkSize, numEventsInWaitList,
+                                  phEventWaitList, phCommandEvent));
+      break;
+    }
+    case UR_EXP_BATCH_COMMAND_TYPE_USM_MEMCPY: {
+      auto &args = command.args.usmMemcpy;
+      UR_CALL(enqueueUSMMemcpy(false, args.pDst, args.pSrc, args.size,
+                               numEventsInWaitList, phEventWaitList,
+                               phCommandEvent));
+      break;
+    }
+    case UR_EXP_BATCH_COMMAND_TYPE_USM_FILL: {
+      auto &args = command.args.usmFill;
+      UR_CALL(enqueueUSMFill(args.pMem, args.patternSize, args.pPattern,
+                             args.size, numEventsInWaitList, phEventWaitList,
+                             phCommandEvent));
+      break;
+    }
+    default:
+      // the wait list carries over to the command after the barrier
+      if (!isLast) {
+        continue;
+      }
+      UR_CALL(enqueueEventsWaitWithBarrier(numEventsInWaitList,
+                                           phEventWaitList, phCommandEvent));
+      break;
+    }
+
+    numEventsInWaitList = 0;
+    phEventWaitList = nullptr;
+  }
+
+  return UR_RESULT_SUCCESS;
+}
+
+ur_result_t ur_queue_immediate_in_order_t::enqueueHostTaskExp(
+    ur_exp_host_task_function_t pfnHostTask, void *pUserData,
+    uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
+    ur_event_handle_t *phEvent) {
+  TRACK_SCOPE_LATENCY("ur_queue_immediate_in_order_t::enqueueHostTaskExp");
+
+  // The host task runs on the calling thread once the commands before it are
+  // done, so the commands appended after it can't start before it returns.
+  UR_CALL(enqueueEventsWait(numEventsInWaitList, phEventWaitList, phEvent));
+  UR_CALL(queueFinish());
+  pfnHostTask(pUserData);
+
+  return UR_RESULT_SUCCESS;
+}
+
+ur_result_t ur_queue_immediate_in_order_t::enqueueUSMAllocExp(
+    const ur_usm_desc_t *, size_t, uint32_t, const ur_event_handle_t *, void **,
+    ur_event_handle_t *) {
+  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+}
+
+ur_result_t ur_queue_immediate_in_order_t::enqueueUSMFreeExp(
+    void *, uint32_t, const ur_event_handle_t *, ur_event_handle_t *) {
+  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+}
+
 ur_result_t ur_queue_immediate_in_order_t::enqueueNativeCommandExp(
     ur_exp_enqueue_native_command_function_t, void *, uint32_t,
     const ur_mem_handle_t *, const ur_exp_enqueue_native_command_properties_t *,
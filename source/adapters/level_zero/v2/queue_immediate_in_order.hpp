@@ -251,6 +251,20 @@ public:
       const ur_exp_launch_property_t *launchPropList,
       uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
       ur_event_handle_t *phEvent) override;
+  ur_result_t enqueueBatchExp(uint32_t numCommands,
+                              const ur_exp_batch_command_t *pCommands,
+                              uint32_t numEventsInWaitList,
+                              const ur_event_handle_t *phEventWaitList,
+                              ur_event_handle_t *phEvent) override;
+  ur_result_t enqueueHostTaskExp(ur_exp_host_task_function_t pfnHostTask,
+                                 void *pUserData, uint32_t numEventsInWaitList,
+                                 const ur_event_handle_t *phEventWaitList,
+                                 ur_event_handle_t *phEvent) override;
+  ur_result_t enqueueUSMAllocExp(const ur_usm_desc_t *, size_t, uint32_t,
+                                 const ur_event_handle_t *, void **,
+                                 ur_event_handle_t *) override;
+  ur_result_t enqueueUSMFreeExp(void *, uint32_t, const ur_event_handle_t *,
+                                ur_event_handle_t *) override;
   ur_result_t
   enqueueCommandBuffer(ze_command_list_handle_t commandBufferCommandList,
                        ur_event_handle_t *phEvent, uint32_t numEventsInWaitList,
@@ -158,7 +158,7 @@ makeProvider(usm::pool_descriptor poolDescriptor) {
 
 ur_usm_pool_handle_t_::ur_usm_pool_handle_t_(ur_context_handle_t hContext,
                                              ur_usm_pool_desc_t *pPoolDesc)
-    : hContext(hContext) {
+    : _ur_object("ur_usm_pool_handle_t_::Mutex"), hContext(hContext) {
   // TODO: handle UR_USM_POOL_FLAG_ZERO_INITIALIZE_BLOCK from pPoolDesc
   auto disjointPoolConfigs = initializeDisjointPoolConfig();
 
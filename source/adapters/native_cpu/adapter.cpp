@@ -10,6 +10,7 @@
 
 #include "adapter.hpp"
 #include "common.hpp"
+#include "latency_tracker.hpp"
 #include "ur_api.h"
 
 struct ur_adapter_handle_t_ {
@@ -60,6 +61,12 @@ UR_APIEXPORT ur_result_t UR_APICALL urAdapterGetInfo(ur_adapter_handle_t,
     return ReturnValue(Adapter.RefCount.load());
   case UR_ADAPTER_INFO_VERSION:
     return ReturnValue(uint32_t{1});
+  case UR_ADAPTER_INFO_LATENCY_HISTOGRAM_EXP:
+#if defined(UR_ENABLE_LATENCY_HISTOGRAM)
+    return ReturnValue(globalLatencyPrinter().toString().c_str());
+#else
+    return UR_RESULT_ERROR_UNSUPPORTED_ENUMERATION;
+#endif
   default:
     return UR_RESULT_ERROR_INVALID_ENUMERATION;
   }
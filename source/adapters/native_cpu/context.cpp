@@ -25,6 +25,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urContextCreate(
   assert(DeviceCount == 1);
 
   // TODO: Proper error checking.
+  urDeviceRetain(*phDevices);
   auto ctx = new ur_context_handle_t_(*phDevices);
   *phContext = ctx;
   return UR_RESULT_SUCCESS;
@@ -38,8 +39,12 @@ urContextRetain(ur_context_handle_t hContext) {
 
 UR_APIEXPORT ur_result_t UR_APICALL
 urContextRelease(ur_context_handle_t hContext) {
-  decrementOrDelete(hContext);
-  return UR_RESULT_SUCCESS;
+  if (hContext->decrementReferenceCount() != 0) {
+    return UR_RESULT_SUCCESS;
+  }
+  auto Device = hContext->_device;
+  delete hContext;
+  return urDeviceRelease(Device);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL
@@ -21,13 +21,18 @@
 #endif
 
 #ifdef __linux__
+#include <sched.h>
 #include <sys/sysinfo.h>
 #include <unistd.h>
 
 #include <cstdio>
 #include <cstdlib>
+#include <fstream>
 #endif
 
+#include <cctype>
+#include <map>
+
 #ifdef __APPLE__
 #include <sys/sysctl.h>
 #include <unistd.h>
@@ -79,6 +84,213 @@ static uint64_t os_memory_bounded_size() {
              : std::numeric_limits<size_t>::max();
 }
 
+static native_cpu::cache_info_t os_cache_info() {
+  // Conservative defaults matching most current x86 and Arm server cores.
+  native_cpu::cache_info_t Info{1024 * 1024, 64};
+#if defined(__linux__) && defined(_SC_LEVEL2_CACHE_SIZE)
+  if (const long L2 = sysconf(_SC_LEVEL2_CACHE_SIZE); L2 > 0) {
+    Info.L2Size = static_cast<size_t>(L2);
+  }
+  if (const long Line = sysconf(_SC_LEVEL1_DCACHE_LINESIZE); Line > 0) {
+    Info.LineSize = static_cast<size_t>(Line);
+  }
+#endif
+  return Info;
+}
+
+// Logical CPUs the process is allowed to run on.
+static std::vector<size_t> os_available_cpus() {
+  std::vector<size_t> Cpus;
+#ifdef __linux__
+  cpu_set_t CpuSet;
+  CPU_ZERO(&CpuSet);
+  if (sched_getaffinity(0, sizeof(CpuSet), &CpuSet) == 0) {
+    for (size_t Cpu = 0; Cpu < CPU_SETSIZE; Cpu++) {
+      if (CPU_ISSET(Cpu, &CpuSet)) {
+        Cpus.push_back(Cpu);
+      }
+    }
+  }
+#endif
+  if (Cpus.empty()) {
+    const size_t NumCpus = std::max(1u, std::thread::hardware_concurrency());
+    for (size_t Cpu = 0; Cpu < NumCpus; Cpu++) {
+      Cpus.push_back(Cpu);
+    }
+  }
+  return Cpus;
+}
+
+// Assigns a logical CPU to each thread of the root device threadpool. When
+// more threads than CPUs are requested the CPUs are reused round-robin.
+static std::vector<size_t> root_compute_units() {
+  const auto Cpus = os_available_cpus();
+  std::vector<size_t> ComputeUnits(
+      native_cpu::detail::simple_thread_pool::get_num_threads());
+  for (size_t I = 0; I < ComputeUnits.size(); I++) {
+    ComputeUnits[I] = Cpus[I % Cpus.size()];
+  }
+  return ComputeUnits;
+}
+
+#ifdef __linux__
+// Parses a sysfs cpu list such as "0-3,8,10-11".
+static std::vector<size_t> parse_sysfs_cpu_list(const std::string &List) {
+  std::vector<size_t> Cpus;
+  std::stringstream Stream(List);
+  std::string Range;
+  while (std::getline(Stream, Range, ',')) {
+    if (Range.empty() || !std::isdigit(Range[0])) {
+      continue;
+    }
+    const auto Dash = Range.find('-');
+    const size_t First = std::stoul(Range.substr(0, Dash));
+    const size_t Last =
+        Dash == std::string::npos ? First : std::stoul(Range.substr(Dash + 1));
+    for (size_t Cpu = First; Cpu <= Last; Cpu++) {
+      Cpus.push_back(Cpu);
+    }
+  }
+  return Cpus;
+}
+
+static std::optional<std::string> read_sysfs(const std::string &Path) {
+  std::ifstream File(Path);
+  std::string Value;
+  if (!File || !std::getline(File, Value)) {
+    return std::nullopt;
+  }
+  return Value;
+}
+#endif
+
+// Returns an identifier of the affinity domain containing the logical CPU,
+// shared by all the CPUs of that domain, or std::nullopt if the host topology
+// can't be queried for this domain.
+static std::optional<size_t>
+os_cpu_affinity_domain(size_t Cpu, ur_device_affinity_domain_flags_t Domain) {
+#ifdef __linux__
+  const std::string CpuDir =
+      "/sys/devices/system/cpu/cpu" + std::to_string(Cpu) + "/";
+  if (Domain == UR_DEVICE_AFFINITY_DOMAIN_FLAG_NUMA) {
+    static const std::map<size_t, size_t> CpuToNode = [] {
+      std::map<size_t, size_t> Map;
+      const auto Nodes = read_sysfs("/sys/devices/system/node/possible");
+      if (!Nodes) {
+        return Map;
+      }
+      for (size_t Node : parse_sysfs_cpu_list(*Nodes)) {
+        const auto NodeCpus =
+            read_sysfs("/sys/devices/system/node/node" + std::to_string(Node) +
+                       "/cpulist");
+        if (!NodeCpus) {
+          continue;
+        }
+        for (size_t NodeCpu : parse_sysfs_cpu_list(*NodeCpus)) {
+          Map[NodeCpu] = Node;
+        }
+      }
+      return Map;
+    }();
+    const auto It = CpuToNode.find(Cpu);
+    if (It == CpuToNode.end()) {
+      return std::nullopt;
+    }
+    return It->second;
+  }
+
+  std::string Level;
+  switch (Domain) {
+  case UR_DEVICE_AFFINITY_DOMAIN_FLAG_L4_CACHE:
+    Level = "4";
+    break;
+  case UR_DEVICE_AFFINITY_DOMAIN_FLAG_L3_CACHE:
+    Level = "3";
+    break;
+  case UR_DEVICE_AFFINITY_DOMAIN_FLAG_L2_CACHE:
+    Level = "2";
+    break;
+  case UR_DEVICE_AFFINITY_DOMAIN_FLAG_L1_CACHE:
+    Level = "1";
+    break;
+  default:
+    return std::nullopt;
+  }
+  // Each cache/indexN directory describes one cache seen by the CPU, the
+  // domain is identified by the first CPU sharing the data or unified cache
+  // of the requested level.
+  for (size_t Index = 0;; Index++) {
+    const std::string CacheDir = CpuDir + "cache/index" + std::to_string(Index);
+    const auto CacheLevel = read_sysfs(CacheDir + "/level");
+    if (!CacheLevel) {
+      return std::nullopt;
+    }
+    if (*CacheLevel != Level ||
+        read_sysfs(CacheDir + "/type") == "Instruction") {
+      continue;
+    }
+    const auto SharedCpus = read_sysfs(CacheDir + "/shared_cpu_list");
+    if (!SharedCpus) {
+      return std::nullopt;
+    }
+    const auto Shared = parse_sysfs_cpu_list(*SharedCpus);
+    if (Shared.empty()) {
+      return std::nullopt;
+    }
+    return Shared.front();
+  }
+#else
+  std::ignore = Cpu;
+  std::ignore = Domain;
+  return std::nullopt;
+#endif
+}
+
+// Groups the compute units of the device by affinity domain, preserving the
+// order of the compute units. Returns an empty vector if the topology is not
+// available for this domain.
+static std::vector<std::vector<size_t>>
+group_by_affinity_domain(ur_device_handle_t hDevice,
+                         ur_device_affinity_domain_flags_t Domain) {
+  std::vector<std::vector<size_t>> Groups;
+  std::map<size_t, size_t> DomainToGroup;
+  for (size_t Cpu : hDevice->ComputeUnits) {
+    const auto DomainId = os_cpu_affinity_domain(Cpu, Domain);
+    if (!DomainId) {
+      return {};
+    }
+    auto [It, Inserted] = DomainToGroup.try_emplace(*DomainId, Groups.size());
+    if (Inserted) {
+      Groups.emplace_back();
+    }
+    Groups[It->second].push_back(Cpu);
+  }
+  return Groups;
+}
+
+// Affinity domains tried, in order, for
+// UR_DEVICE_AFFINITY_DOMAIN_FLAG_NEXT_PARTITIONABLE.
+static constexpr ur_device_affinity_domain_flag_t AffinityDomains[] = {
+    UR_DEVICE_AFFINITY_DOMAIN_FLAG_NUMA,
+    UR_DEVICE_AFFINITY_DOMAIN_FLAG_L4_CACHE,
+    UR_DEVICE_AFFINITY_DOMAIN_FLAG_L3_CACHE,
+    UR_DEVICE_AFFINITY_DOMAIN_FLAG_L2_CACHE,
+    UR_DEVICE_AFFINITY_DOMAIN_FLAG_L1_CACHE};
+
+static ur_device_affinity_domain_flags_t
+supported_affinity_domains(ur_device_handle_t hDevice) {
+  ur_device_affinity_domain_flags_t Supported = 0;
+  for (auto Domain : AffinityDomains) {
+    if (!group_by_affinity_domain(hDevice, Domain).empty()) {
+      Supported |= Domain;
+    }
+  }
+  if (Supported) {
+    Supported |= UR_DEVICE_AFFINITY_DOMAIN_FLAG_NEXT_PARTITIONABLE;
+  }
+  return Supported;
+}
+
 UR_APIEXPORT ur_result_t UR_APICALL urDeviceGet(ur_platform_handle_t hPlatform,
                                                 ur_device_type_t DeviceType,
                                                 uint32_t NumEntries,
@@ -129,7 +341,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
   case UR_DEVICE_INFO_TYPE:
     return ReturnValue(UR_DEVICE_TYPE_CPU);
   case UR_DEVICE_INFO_PARENT_DEVICE:
-    return ReturnValue(nullptr);
+    return ReturnValue(hDevice->ParentDevice);
   case UR_DEVICE_INFO_PLATFORM:
     return ReturnValue(hDevice->Platform);
   case UR_DEVICE_INFO_NAME:
@@ -168,23 +380,31 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
   case UR_DEVICE_INFO_MAX_COMPUTE_UNITS:
     return ReturnValue(static_cast<uint32_t>(hDevice->tp.num_threads()));
   case UR_DEVICE_INFO_PARTITION_MAX_SUB_DEVICES:
-    return ReturnValue(uint32_t{0});
-  case UR_DEVICE_INFO_SUPPORTED_PARTITIONS:
-    // TODO: Ensure this property is tested correctly
-    // Taken from CUDA ur adapter
-    if (pPropSizeRet) {
-      *pPropSizeRet = 0;
+    return ReturnValue(static_cast<uint32_t>(hDevice->ComputeUnits.size()));
+  case UR_DEVICE_INFO_SUPPORTED_PARTITIONS: {
+    // SYCL spec says: if this SYCL device cannot be partitioned into at least
+    // two sub devices then the returned vector must be empty.
+    if (hDevice->ComputeUnits.size() < 2) {
+      if (pPropSizeRet) {
+        *pPropSizeRet = 0;
+      }
+      return UR_RESULT_SUCCESS;
     }
-    return UR_RESULT_SUCCESS;
+    std::vector<ur_device_partition_t> Partitions = {
+        UR_DEVICE_PARTITION_EQUALLY, UR_DEVICE_PARTITION_BY_COUNTS};
+    if (supported_affinity_domains(hDevice)) {
+      Partitions.push_back(UR_DEVICE_PARTITION_BY_AFFINITY_DOMAIN);
+    }
+    return ReturnValue(Partitions.data(), Partitions.size());
+  }
   case UR_DEVICE_INFO_VENDOR_ID:
     // '0x8086' : 'Intel HD graphics vendor ID'
     return ReturnValue(uint32_t{0x8086});
   case UR_DEVICE_INFO_MAX_WORK_GROUP_SIZE:
-    // TODO: provide a mechanism to estimate/configure this.
-    return ReturnValue(size_t{2048});
+    return ReturnValue(native_cpu::MaxWorkGroupSize);
   case UR_DEVICE_INFO_MAX_NUM_SUB_GROUPS:
     // Set the max sub groups to be the same as the max work group size.
-    return ReturnValue(uint32_t{2048});
+    return ReturnValue(static_cast<uint32_t>(native_cpu::MaxWorkGroupSize));
   case UR_DEVICE_INFO_MEM_BASE_ADDR_ALIGN:
     // Imported from level_zero
     return ReturnValue(uint32_t{8});
@@ -210,10 +430,15 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
   case UR_DEVICE_INFO_MAX_WORK_ITEM_DIMENSIONS:
     return ReturnValue(uint32_t{3});
   case UR_DEVICE_INFO_PARTITION_TYPE:
-    if (pPropSizeRet) {
-      *pPropSizeRet = 0;
+    // For root-device there is no partitioning to report.
+    if (hDevice->PartitionProperties.empty()) {
+      if (pPropSizeRet) {
+        *pPropSizeRet = 0;
+      }
+      return UR_RESULT_SUCCESS;
     }
-    return UR_RESULT_SUCCESS;
+    return ReturnValue(hDevice->PartitionProperties.data(),
+                       hDevice->PartitionProperties.size());
   case UR_EXT_DEVICE_INFO_OPENCL_C_VERSION:
     return ReturnValue("");
   case UR_DEVICE_INFO_QUEUE_PROPERTIES:
@@ -240,11 +465,11 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
   case UR_DEVICE_INFO_NATIVE_VECTOR_WIDTH_SHORT:
     return ReturnValue(uint32_t{16});
   case UR_DEVICE_INFO_NATIVE_VECTOR_WIDTH_INT:
-    return ReturnValue(uint32_t{8});
+    return ReturnValue(native_cpu::NativeVectorWidth32);
   case UR_DEVICE_INFO_NATIVE_VECTOR_WIDTH_LONG:
     return ReturnValue(uint32_t{4});
   case UR_DEVICE_INFO_NATIVE_VECTOR_WIDTH_FLOAT:
-    return ReturnValue(uint32_t{8});
+    return ReturnValue(native_cpu::NativeVectorWidth32);
   case UR_DEVICE_INFO_NATIVE_VECTOR_WIDTH_DOUBLE:
     return ReturnValue(uint32_t{4});
   case UR_DEVICE_INFO_NATIVE_VECTOR_WIDTH_HALF:
@@ -287,8 +512,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
   case UR_DEVICE_INFO_GLOBAL_MEM_CACHE_TYPE:
     return ReturnValue(UR_DEVICE_MEM_CACHE_TYPE_READ_WRITE_CACHE);
   case UR_DEVICE_INFO_GLOBAL_MEM_CACHELINE_SIZE:
-    // TODO : CHECK
-    return ReturnValue(uint32_t{64});
+    return ReturnValue(static_cast<uint32_t>(hDevice->Caches.LineSize));
   case UR_DEVICE_INFO_GLOBAL_MEM_CACHE_SIZE:
     // TODO : CHECK
     return ReturnValue(uint64_t{0});
@@ -320,7 +544,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
   case UR_DEVICE_INFO_PREFERRED_INTEROP_USER_SYNC:
     return ReturnValue(bool{false});
   case UR_DEVICE_INFO_PARTITION_AFFINITY_DOMAIN:
-    return ReturnValue(ur_device_affinity_domain_flags_t{0});
+    return ReturnValue(supported_affinity_domains(hDevice));
   case UR_DEVICE_INFO_MAX_MEM_ALLOC_SIZE: {
     size_t Global = hDevice->mem_size;
 
@@ -338,8 +562,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
   case UR_DEVICE_INFO_PROFILE:
     return ReturnValue("FULL_PROFILE");
   case UR_DEVICE_INFO_REFERENCE_COUNT:
-    // TODO : CHECK
-    return ReturnValue(uint32_t{0});
+    return ReturnValue(uint32_t{hDevice->getReferenceCount()});
   case UR_DEVICE_INFO_BUILD_ON_SUBDEVICE:
     return ReturnValue(bool{0});
   case UR_DEVICE_INFO_ATOMIC_64:
@@ -443,6 +666,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
 UR_APIEXPORT ur_result_t UR_APICALL urDeviceRetain(ur_device_handle_t hDevice) {
   UR_ASSERT(hDevice, UR_RESULT_ERROR_INVALID_NULL_HANDLE)
 
+  hDevice->incrementReferenceCount();
   return UR_RESULT_SUCCESS;
 }
 
@@ -450,6 +674,22 @@ UR_APIEXPORT ur_result_t UR_APICALL
 urDeviceRelease(ur_device_handle_t hDevice) {
   UR_ASSERT(hDevice, UR_RESULT_ERROR_INVALID_NULL_HANDLE)
 
+  // The root device is owned by the platform, which holds the reference it is
+  // created with, so releases without a matching retain don't drop its count
+  // further.
+  if (!hDevice->isSubDevice()) {
+    uint32_t Count = hDevice->getReferenceCount();
+    while (Count > 1 &&
+           !hDevice->_refCount.compare_exchange_weak(Count, Count - 1)) {
+    }
+    return UR_RESULT_SUCCESS;
+  }
+
+  if (hDevice->decrementReferenceCount() == 0) {
+    auto Parent = hDevice->ParentDevice;
+    delete hDevice;
+    return urDeviceRelease(Parent);
+  }
   return UR_RESULT_SUCCESS;
 }
 
@@ -457,13 +697,100 @@ UR_APIEXPORT ur_result_t UR_APICALL urDevicePartition(
     ur_device_handle_t hDevice,
     const ur_device_partition_properties_t *pProperties, uint32_t NumDevices,
     ur_device_handle_t *phSubDevices, uint32_t *pNumDevicesRet) {
-  std::ignore = hDevice;
-  std::ignore = NumDevices;
-  std::ignore = pProperties;
-  std::ignore = phSubDevices;
-  std::ignore = pNumDevicesRet;
+  UR_ASSERT(hDevice, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(pProperties && pProperties->pProperties,
+            UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  UR_ASSERT(pProperties->PropCount > 0, UR_RESULT_ERROR_INVALID_VALUE);
+
+  const auto &ComputeUnits = hDevice->ComputeUnits;
+  const auto &FirstProperty = pProperties->pProperties[0];
+
+  // Compute units and partition properties of each sub-device.
+  std::vector<std::vector<size_t>> SubDeviceCpus;
+  std::vector<std::vector<ur_device_partition_property_t>> SubDeviceProps;
+
+  switch (FirstProperty.type) {
+  case UR_DEVICE_PARTITION_EQUALLY: {
+    UR_ASSERT(pProperties->PropCount == 1, UR_RESULT_ERROR_INVALID_VALUE);
+    const uint32_t PerSubDevice = FirstProperty.value.equally;
+    UR_ASSERT(PerSubDevice > 0, UR_RESULT_ERROR_INVALID_VALUE);
+    UR_ASSERT(PerSubDevice <= ComputeUnits.size(),
+              UR_RESULT_ERROR_DEVICE_PARTITION_FAILED);
+    for (size_t First = 0; First + PerSubDevice <= ComputeUnits.size();
+         First += PerSubDevice) {
+      SubDeviceCpus.emplace_back(ComputeUnits.begin() + First,
+                                 ComputeUnits.begin() + First + PerSubDevice);
+      SubDeviceProps.push_back({FirstProperty});
+    }
+    break;
+  }
+  case UR_DEVICE_PARTITION_BY_COUNTS: {
+    size_t First = 0;
+    for (size_t I = 0; I < pProperties->PropCount; I++) {
+      const auto &Property = pProperties->pProperties[I];
+      UR_ASSERT(Property.type == UR_DEVICE_PARTITION_BY_COUNTS,
+                UR_RESULT_ERROR_INVALID_VALUE);
+      const uint32_t Count = Property.value.count;
+      UR_ASSERT(Count > 0 && First + Count <= ComputeUnits.size(),
+                UR_RESULT_ERROR_INVALID_DEVICE_PARTITION_COUNT);
+      SubDeviceCpus.emplace_back(ComputeUnits.begin() + First,
+                                 ComputeUnits.begin() + First + Count);
+      First += Count;
+    }
+    // Each sub-device reports the full list of counts it was created with.
+    SubDeviceProps.assign(
+        SubDeviceCpus.size(),
+        std::vector<ur_device_partition_property_t>(
+            pProperties->pProperties,
+            pProperties->pProperties + pProperties->PropCount));
+    break;
+  }
+  case UR_DEVICE_PARTITION_BY_AFFINITY_DOMAIN: {
+    UR_ASSERT(pProperties->PropCount == 1, UR_RESULT_ERROR_INVALID_VALUE);
+    const auto Requested = FirstProperty.value.affinity_domain;
+    const auto Supported = supported_affinity_domains(hDevice);
+    UR_ASSERT(Requested & Supported, UR_RESULT_ERROR_INVALID_VALUE);
+
+    ur_device_affinity_domain_flags_t Domain = Requested;
+    if (Requested == UR_DEVICE_AFFINITY_DOMAIN_FLAG_NEXT_PARTITIONABLE) {
+      // Pick the outermost domain that actually splits the device.
+      Domain = 0;
+      for (auto Candidate : AffinityDomains) {
+        if ((Candidate & Supported) &&
+            group_by_affinity_domain(hDevice, Candidate).size() > 1) {
+          Domain = Candidate;
+          break;
+        }
+      }
+      UR_ASSERT(Domain, UR_RESULT_ERROR_DEVICE_PARTITION_FAILED);
+    }
 
-  DIE_NO_IMPLEMENTATION;
+    SubDeviceCpus = group_by_affinity_domain(hDevice, Domain);
+    auto Property = FirstProperty;
+    Property.value.affinity_domain = Domain;
+    SubDeviceProps.assign(SubDeviceCpus.size(), {Property});
+    break;
+  }
+  default:
+    return UR_RESULT_ERROR_INVALID_VALUE;
+  }
+
+  if (pNumDevicesRet) {
+    *pNumDevicesRet = static_cast<uint32_t>(SubDeviceCpus.size());
+  }
+
+  if (phSubDevices) {
+    // Only the requested number of sub-devices is created, the others are
+    // never materialized.
+    const size_t NumCreated =
+        std::min<size_t>(NumDevices, SubDeviceCpus.size());
+    for (size_t I = 0; I < NumCreated; I++) {
+      phSubDevices[I] = new ur_device_handle_t_(
+          hDevice, std::move(SubDeviceCpus[I]), std::move(SubDeviceProps[I]));
+    }
+  }
+
+  return UR_RESULT_SUCCESS;
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetNativeHandle(
@@ -524,4 +851,16 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceSelectBinary(
 }
 
 ur_device_handle_t_::ur_device_handle_t_(ur_platform_handle_t ArgPlt)
-    : mem_size(os_memory_bounded_size()), Platform(ArgPlt) {}
+    : ComputeUnits(root_compute_units()), mem_size(os_memory_bounded_size()),
+      Caches(os_cache_info()), Platform(ArgPlt) {}
+
+ur_device_handle_t_::ur_device_handle_t_(
+    ur_device_handle_t Parent, std::vector<size_t> Cpus,
+    std::vector<ur_device_partition_property_t> Partition)
+    : ComputeUnits(std::move(Cpus)), tp(ComputeUnits),
+      mem_size(Parent->mem_size), Caches(Parent->Caches),
+      Platform(Parent->Platform),
+      ParentDevice(Parent), PartitionProperties(std::move(Partition)) {
+  // Sub-devices keep their parent alive.
+  Parent->incrementReferenceCount();
+}
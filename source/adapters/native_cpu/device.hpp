@@ -10,13 +10,47 @@
 
 #pragma once
 
+#include "common.hpp"
 #include "threadpool.hpp"
 #include <ur/ur.hpp>
 
-struct ur_device_handle_t_ {
-  native_cpu::threadpool_t tp;
+namespace native_cpu {
+
+// Work-items of a work-group run sequentially on one thread, so this is a
+// soft limit bounding the per-group bookkeeping rather than a hardware one.
+inline constexpr size_t MaxWorkGroupSize = 2048;
+
+// Number of 32-bit lanes kernels are vectorized for along dimension 0.
+inline constexpr uint32_t NativeVectorWidth32 = 8;
+
+// Data cache geometry of the host, used to size work-groups.
+struct cache_info_t {
+  size_t L2Size;
+  size_t LineSize;
+};
+
+} // namespace native_cpu
+
+struct ur_device_handle_t_ : RefCounted {
   ur_device_handle_t_(ur_platform_handle_t ArgPlt);
 
+  // Creates a sub-device of Parent owning a threadpool bound to Cpus.
+  ur_device_handle_t_(ur_device_handle_t Parent, std::vector<size_t> Cpus,
+                      std::vector<ur_device_partition_property_t> Partition);
+
+  // Logical CPU backing each compute unit of the device. For the root device
+  // the threadpool is not pinned and this is only used for partitioning.
+  const std::vector<size_t> ComputeUnits;
+  native_cpu::threadpool_t tp;
+
   const uint64_t mem_size;
+  const native_cpu::cache_info_t Caches;
   ur_platform_handle_t Platform;
+
+  // Parent device and the partition properties this sub-device was created
+  // with, both empty for the root device.
+  ur_device_handle_t ParentDevice = nullptr;
+  const std::vector<ur_device_partition_property_t> PartitionProperties;
+
+  bool isSubDevice() const { return ParentDevice != nullptr; }
 };
@@ -8,6 +8,7 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <future>
 #include <vector>
 
 #include "ur_api.h"
@@ -15,9 +16,12 @@
 #include "common.hpp"
 #include "event.hpp"
 #include "kernel.hpp"
+#include "latency_tracker.hpp"
 #include "memory.hpp"
 #include "queue.hpp"
 #include "threadpool.hpp"
+#include "ur_enqueue_batch.hpp"
+#include "ur_host_dma.hpp"
 
 namespace native_cpu {
 struct NDRDescT {
@@ -52,6 +56,22 @@ struct NDRDescT {
 };
 } // namespace native_cpu
 
+// Splits large host memory operations across the device's threads. The
+// calling thread runs the first task and waits for the others.
+static ur::dma::executor_t getDmaExecutor(ur_queue_handle_t hQueue) {
+  auto &tp = hQueue->getDevice()->tp;
+  return [&tp](size_t NumTasks, const ur::dma::task_t &Task) {
+    std::vector<std::future<void>> Futures;
+    for (size_t I = 1; I < NumTasks; I++) {
+      Futures.emplace_back(tp.schedule_task([&Task, I](size_t) { Task(I); }));
+    }
+    Task(0);
+    for (auto &Future : Futures) {
+      Future.wait();
+    }
+  };
+}
+
 #ifdef NATIVECPU_USE_OCK
 static native_cpu::state getResizedState(const native_cpu::NDRDescT &ndr,
                                          size_t itemsPerThread) {
@@ -68,6 +88,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueKernelLaunch(
     const size_t *pGlobalWorkOffset, const size_t *pGlobalWorkSize,
     const size_t *pLocalWorkSize, uint32_t numEventsInWaitList,
     const ur_event_handle_t *phEventWaitList, ur_event_handle_t *phEvent) {
+  TRACK_SCOPE_LATENCY("urEnqueueKernelLaunch");
 
   urEventWait(numEventsInWaitList, phEventWaitList);
   UR_ASSERT(hQueue, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
@@ -107,6 +128,10 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueKernelLaunch(
   auto &tp = hQueue->getDevice()->tp;
   const size_t numParallelThreads = tp.num_threads();
   hKernel->updateMemPool(numParallelThreads);
+  auto res = hKernel->updateMemObjArgs();
+  if (res != UR_RESULT_SUCCESS) {
+    return res;
+  }
   std::vector<std::future<void>> futures;
   std::vector<std::function<void(size_t, ur_kernel_handle_t_)>> groups;
   auto numWG0 = ndr.GlobalSize[0] / ndr.LocalSize[0];
@@ -286,6 +311,10 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueEventsWait(
     const ur_event_handle_t *phEventWaitList, ur_event_handle_t *phEvent) {
 
   // TODO: the wait here should be async
+  // Without a wait list, the command waits for everything enqueued before.
+  if (numEventsInWaitList == 0) {
+    hQueue->finish();
+  }
   return withTimingEvent(UR_COMMAND_EVENTS_WAIT, hQueue, numEventsInWaitList,
                          phEventWaitList, phEvent,
                          [&]() { return UR_RESULT_SUCCESS; });
@@ -294,6 +323,9 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueEventsWait(
 UR_APIEXPORT ur_result_t UR_APICALL urEnqueueEventsWaitWithBarrier(
     ur_queue_handle_t hQueue, uint32_t numEventsInWaitList,
     const ur_event_handle_t *phEventWaitList, ur_event_handle_t *phEvent) {
+  if (numEventsInWaitList == 0) {
+    hQueue->finish();
+  }
   return withTimingEvent(UR_COMMAND_EVENTS_WAIT_WITH_BARRIER, hQueue,
                          numEventsInWaitList, phEventWaitList, phEvent,
                          [&]() { return UR_RESULT_SUCCESS; });
@@ -334,21 +366,21 @@ static inline ur_result_t enqueueMemBufferReadWriteRect_impl(
           HostRowPitch = region.width;
         if (HostSlicePitch == 0)
           HostSlicePitch = HostRowPitch * region.height;
-        for (size_t w = 0; w < region.width; w++)
-          for (size_t h = 0; h < region.height; h++)
-            for (size_t d = 0; d < region.depth; d++) {
-              size_t buff_orign = (d + BufferOffset.z) * BufferSlicePitch +
-                                  (h + BufferOffset.y) * BufferRowPitch + w +
-                                  BufferOffset.x;
-              size_t host_origin = (d + HostOffset.z) * HostSlicePitch +
-                                   (h + HostOffset.y) * HostRowPitch + w +
-                                   HostOffset.x;
-              int8_t &buff_mem = ur_cast<int8_t *>(Buff->_mem)[buff_orign];
-              if constexpr (IsRead)
-                ur_cast<int8_t *>(DstMem)[host_origin] = buff_mem;
-              else
-                buff_mem = ur_cast<const int8_t *>(DstMem)[host_origin];
-            }
+        char *BuffMem = IsRead ? Buff->getReadPtr() : Buff->getWritePtr();
+        UR_ASSERT(BuffMem && DstMem, UR_RESULT_ERROR_OUT_OF_HOST_MEMORY);
+        BuffMem += BufferOffset.z * BufferSlicePitch +
+                   BufferOffset.y * BufferRowPitch + BufferOffset.x;
+        auto *HostMem = ur_cast<char *>(const_cast<void *>(DstMem)) +
+                        HostOffset.z * HostSlicePitch +
+                        HostOffset.y * HostRowPitch + HostOffset.x;
+        if constexpr (IsRead)
+          ur::dma::copy3D(HostMem, HostRowPitch, HostSlicePitch, BuffMem,
+                          BufferRowPitch, BufferSlicePitch, region.width,
+                          region.height, region.depth, getDmaExecutor(hQueue));
+        else
+          ur::dma::copy3D(BuffMem, BufferRowPitch, BufferSlicePitch, HostMem,
+                          HostRowPitch, HostSlicePitch, region.width,
+                          region.height, region.depth, getDmaExecutor(hQueue));
 
         return UR_RESULT_SUCCESS;
       });
@@ -360,12 +392,19 @@ static inline ur_result_t doCopy_impl(ur_queue_handle_t hQueue, void *DstPtr,
                                       const ur_event_handle_t *phEventWaitList,
                                       ur_event_handle_t *phEvent,
                                       ur_command_t command_type) {
-  return withTimingEvent(command_type, hQueue, numEventsInWaitList,
-                         phEventWaitList, phEvent, [&]() {
-                           if (SrcPtr != DstPtr && Size)
-                             memmove(DstPtr, SrcPtr, Size);
-                           return UR_RESULT_SUCCESS;
-                         });
+  return withTimingEvent(
+      command_type, hQueue, numEventsInWaitList, phEventWaitList, phEvent,
+      [&]() {
+        if (SrcPtr == DstPtr || !Size)
+          return UR_RESULT_SUCCESS;
+        auto *Dst = static_cast<char *>(DstPtr);
+        auto *Src = static_cast<const char *>(SrcPtr);
+        if (Dst + Size <= Src || Src + Size <= Dst)
+          ur::dma::copy(Dst, Src, Size, getDmaExecutor(hQueue));
+        else
+          memmove(DstPtr, SrcPtr, Size);
+        return UR_RESULT_SUCCESS;
+      });
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemBufferRead(
@@ -374,7 +413,9 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemBufferRead(
     const ur_event_handle_t *phEventWaitList, ur_event_handle_t *phEvent) {
   std::ignore = blockingRead;
 
-  void *FromPtr = /*Src*/ hBuffer->_mem + offset;
+  char *BuffMem = hBuffer->getReadPtr();
+  UR_ASSERT(BuffMem, UR_RESULT_ERROR_OUT_OF_HOST_MEMORY);
+  void *FromPtr = /*Src*/ BuffMem + offset;
   auto res = doCopy_impl(hQueue, pDst, FromPtr, size, numEventsInWaitList,
                          phEventWaitList, phEvent, UR_COMMAND_MEM_BUFFER_READ);
   return res;
@@ -386,7 +427,9 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemBufferWrite(
     const ur_event_handle_t *phEventWaitList, ur_event_handle_t *phEvent) {
   std::ignore = blockingWrite;
 
-  void *ToPtr = hBuffer->_mem + offset;
+  char *BuffMem = hBuffer->getWritePtr();
+  UR_ASSERT(BuffMem, UR_RESULT_ERROR_OUT_OF_HOST_MEMORY);
+  void *ToPtr = BuffMem + offset;
   auto res = doCopy_impl(hQueue, ToPtr, pSrc, size, numEventsInWaitList,
                          phEventWaitList, phEvent, UR_COMMAND_MEM_BUFFER_WRITE);
   return res;
@@ -424,8 +467,11 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemBufferCopy(
     uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
     ur_event_handle_t *phEvent) {
   urEventWait(numEventsInWaitList, phEventWaitList);
-  const void *SrcPtr = hBufferSrc->_mem + srcOffset;
-  void *DstPtr = hBufferDst->_mem + dstOffset;
+  const char *SrcMem = hBufferSrc->getReadPtr();
+  char *DstMem = hBufferDst->getWritePtr();
+  UR_ASSERT(SrcMem && DstMem, UR_RESULT_ERROR_OUT_OF_HOST_MEMORY);
+  const void *SrcPtr = SrcMem + srcOffset;
+  void *DstPtr = DstMem + dstOffset;
   return doCopy_impl(hQueue, DstPtr, SrcPtr, size, numEventsInWaitList,
                      phEventWaitList, phEvent, UR_COMMAND_MEM_BUFFER_COPY);
 }
@@ -440,8 +486,8 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemBufferCopyRect(
   return enqueueMemBufferReadWriteRect_impl<true /*read*/>(
       hQueue, hBufferSrc, false /*todo: check blocking*/, srcOrigin,
       /*HostOffset*/ dstOrigin, region, srcRowPitch, srcSlicePitch, dstRowPitch,
-      dstSlicePitch, hBufferDst->_mem, numEventsInWaitList, phEventWaitList,
-      phEvent);
+      dstSlicePitch, hBufferDst->getWritePtr(), numEventsInWaitList,
+      phEventWaitList, phEvent);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemBufferFill(
@@ -457,12 +503,11 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemBufferFill(
 
         // TODO: error checking
         // TODO: handle async
-        void *startingPtr = hBuffer->_mem + offset;
-        unsigned steps = size / patternSize;
-        for (unsigned i = 0; i < steps; i++) {
-          memcpy(static_cast<int8_t *>(startingPtr) + i * patternSize, pPattern,
-                 patternSize);
-        }
+        char *BuffMem = hBuffer->getWritePtr();
+        UR_ASSERT(BuffMem, UR_RESULT_ERROR_OUT_OF_HOST_MEMORY);
+        void *startingPtr = BuffMem + offset;
+        ur::dma::fill(startingPtr, pPattern, patternSize, size,
+                      getDmaExecutor(hQueue));
 
         return UR_RESULT_SUCCESS;
       });
@@ -533,14 +578,25 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemBufferMap(
     uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
     ur_event_handle_t *phEvent, void **ppRetMap) {
   std::ignore = blockingMap;
-  std::ignore = mapFlags;
-  std::ignore = size;
 
-  return withTimingEvent(UR_COMMAND_MEM_BUFFER_MAP, hQueue, numEventsInWaitList,
-                         phEventWaitList, phEvent, [&]() {
-                           *ppRetMap = hBuffer->_mem + offset;
-                           return UR_RESULT_SUCCESS;
-                         });
+  // Buffers live in host memory, so mapping never copies: the map points
+  // straight at the buffer storage. The flags only decide whether that
+  // storage has to be materialized before the host writes to it.
+  return withTimingEvent(
+      UR_COMMAND_MEM_BUFFER_MAP, hQueue, numEventsInWaitList, phEventWaitList,
+      phEvent, [&]() {
+        char *Base;
+        if (mapFlags & UR_MAP_FLAG_WRITE_INVALIDATE_REGION) {
+          Base = hBuffer->getWriteInvalidatePtr(offset, size);
+        } else if (mapFlags & UR_MAP_FLAG_WRITE) {
+          Base = hBuffer->getWritePtr();
+        } else {
+          Base = hBuffer->getReadPtr();
+        }
+        UR_ASSERT(Base, UR_RESULT_ERROR_OUT_OF_HOST_MEMORY);
+        *ppRetMap = Base + offset;
+        return UR_RESULT_SUCCESS;
+      });
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemUnmap(
@@ -569,43 +625,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueUSMFill(
         UR_ASSERT(size % patternSize == 0, UR_RESULT_ERROR_INVALID_SIZE)
         // TODO: add check for allocation size once the query is supported
 
-        switch (patternSize) {
-        case 1:
-          memset(ptr, *static_cast<const uint8_t *>(pPattern),
-                 size * patternSize);
-          break;
-        case 2: {
-          const auto pattern = *static_cast<const uint16_t *>(pPattern);
-          auto *start = reinterpret_cast<uint16_t *>(ptr);
-          auto *end = reinterpret_cast<uint16_t *>(
-              reinterpret_cast<uint8_t *>(ptr) + size);
-          std::fill(start, end, pattern);
-          break;
-        }
-        case 4: {
-          const auto pattern = *static_cast<const uint32_t *>(pPattern);
-          auto *start = reinterpret_cast<uint32_t *>(ptr);
-          auto *end = reinterpret_cast<uint32_t *>(
-              reinterpret_cast<uint8_t *>(ptr) + size);
-          std::fill(start, end, pattern);
-          break;
-        }
-        case 8: {
-          const auto pattern = *static_cast<const uint64_t *>(pPattern);
-          auto *start = reinterpret_cast<uint64_t *>(ptr);
-          auto *end = reinterpret_cast<uint64_t *>(
-              reinterpret_cast<uint8_t *>(ptr) + size);
-          std::fill(start, end, pattern);
-          break;
-        }
-        default: {
-          for (unsigned int step{0}; step < size; step += patternSize) {
-            auto *dest = reinterpret_cast<void *>(
-                reinterpret_cast<uint8_t *>(ptr) + step);
-            memcpy(dest, pPattern, patternSize);
-          }
-        }
-        }
+        ur::dma::fill(ptr, pPattern, patternSize, size, getDmaExecutor(hQueue));
         return UR_RESULT_SUCCESS;
       });
 }
@@ -622,7 +642,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueUSMMemcpy(
         UR_ASSERT(pDst, UR_RESULT_ERROR_INVALID_NULL_POINTER);
         UR_ASSERT(pSrc, UR_RESULT_ERROR_INVALID_NULL_POINTER);
 
-        memcpy(pDst, pSrc, size);
+        ur::dma::copy(pDst, pSrc, size, getDmaExecutor(hQueue));
 
         return UR_RESULT_SUCCESS;
       });
@@ -777,3 +797,232 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueNativeCommandExp(
     const ur_event_handle_t *, ur_event_handle_t *) {
   return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
 }
+
+UR_APIEXPORT ur_result_t UR_APICALL urEnqueueHostTaskExp(
+    ur_queue_handle_t hQueue, ur_exp_host_task_function_t pfnHostTask,
+    void *pUserData, uint32_t numEventsInWaitList,
+    const ur_event_handle_t *phEventWaitList, ur_event_handle_t *phEvent) {
+  TRACK_SCOPE_LATENCY("urEnqueueHostTaskExp");
+
+  UR_ASSERT(hQueue, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(pfnHostTask, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  // As for kernels, the dependencies are waited for before the task starts.
+  urEventWait(numEventsInWaitList, phEventWaitList);
+
+  auto event = new ur_event_handle_t_(hQueue, UR_COMMAND_ENQUEUE_HOST_TASK_EXP);
+  event->tick_start();
+  // Host tasks commonly enqueue work and wait for it, so they get a thread of
+  // their own rather than a worker of the device's pool, where that work may
+  // be queued behind the blocked host task.
+  std::vector<std::future<void>> futures;
+  futures.emplace_back(
+      std::async(std::launch::async,
+                 [pfnHostTask, pUserData]() { pfnHostTask(pUserData); }));
+  event->set_futures(futures);
+  event->set_callback([event]() { event->tick_end(); });
+
+  if (phEvent) {
+    *phEvent = event;
+  }
+  if (hQueue->isInOrder()) {
+    urEventWait(1, &event);
+  }
+
+  return UR_RESULT_SUCCESS;
+}
+
+UR_APIEXPORT ur_result_t UR_APICALL urEnqueueUSMAllocExp(
+    ur_queue_handle_t hQueue, const ur_usm_desc_t *pUSMDesc, size_t size,
+    uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
+    void **ppMem, ur_event_handle_t *phEvent) {
+  TRACK_SCOPE_LATENCY("urEnqueueUSMAllocExp");
+
+  UR_ASSERT(hQueue, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(ppMem, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  return hQueue->getUSMArena().enqueueAlloc(hQueue, pUSMDesc, size,
+                                            numEventsInWaitList,
+                                            phEventWaitList, ppMem, phEvent);
+}
+
+UR_APIEXPORT ur_result_t UR_APICALL urEnqueueUSMFreeExp(
+    ur_queue_handle_t hQueue, void *pMem, uint32_t numEventsInWaitList,
+    const ur_event_handle_t *phEventWaitList, ur_event_handle_t *phEvent) {
+  TRACK_SCOPE_LATENCY("urEnqueueUSMFreeExp");
+
+  UR_ASSERT(hQueue, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(pMem, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  return hQueue->getUSMArena().enqueueFree(hQueue, pMem, numEventsInWaitList,
+                                           phEventWaitList, phEvent);
+}
+
+namespace {
+// A command of a batch that later commands can wait for: kernels are tracked
+// by their event, copies and fills by the future of their task.
+struct batch_node_t {
+  ur_event_handle_t kernelEvent = nullptr;
+  std::shared_future<void> task;
+
+  void wait() const {
+    if (kernelEvent) {
+      kernelEvent->wait_futures();
+    } else if (task.valid()) {
+      task.wait();
+    }
+  }
+};
+
+using batch_deps_t = std::vector<batch_node_t>;
+
+// Copies and fills of a batch run as a single task of the thread pool, whose
+// workers mustn't wait for tasks scheduled after their own.
+const ur::dma::executor_t inlineExecutor = {};
+} // namespace
+
+UR_APIEXPORT ur_result_t UR_APICALL urEnqueueBatchExp(
+    ur_queue_handle_t hQueue, uint32_t numCommands,
+    const ur_exp_batch_command_t *pCommands, uint32_t numEventsInWaitList,
+    const ur_event_handle_t *phEventWaitList, ur_event_handle_t *phEvent) {
+  TRACK_SCOPE_LATENCY("urEnqueueBatchExp");
+
+  UR_ASSERT(hQueue, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  auto result = ur::batch::validate(numCommands, pCommands);
+  if (result != UR_RESULT_SUCCESS) {
+    return result;
+  }
+  urEventWait(numEventsInWaitList, phEventWaitList);
+
+  // The batch is scheduled as a task graph on the thread pool. Kernels are
+  // launched on this thread, since their arguments are read at launch, once
+  // the commands they depend on are done. Copies and fills are pool tasks
+  // that wait for their dependencies. Each task only waits for work that was
+  // scheduled before it, so the workers can't deadlock. A barrier makes the
+  // commands after it wait for all the commands before it.
+  auto event = new ur_event_handle_t_(hQueue, UR_COMMAND_ENQUEUE_BATCH_EXP);
+  event->tick_start();
+
+  auto &tp = hQueue->getDevice()->tp;
+  std::vector<batch_node_t> nodes(numCommands);
+  auto barrierDeps = std::make_shared<const batch_deps_t>();
+  for (uint32_t i = 0; i < numCommands && result == UR_RESULT_SUCCESS; i++) {
+    auto &command = pCommands[i];
+    batch_deps_t deps;
+    for (uint32_t d = 0; d < command.numDepsInBatch; d++) {
+      deps.push_back(nodes[command.pDepsInBatch[d]]);
+    }
+
+    switch (command.type) {
+    case UR_EXP_BATCH_COMMAND_TYPE_KERNEL_LAUNCH: {
+      for (auto &dep : *barrierDeps) {
+        dep.wait();
+      }
+      for (auto &dep : deps) {
+        dep.wait();
+      }
+      auto &args = command.args.kernelLaunch;
+      result = urEnqueueKernelLaunch(
+          hQueue, args.hKernel, args.workDim, args.pGlobalWorkOffset,
+          args.pGlobalWorkSize, args.pLocalWorkSize, 0, nullptr,
+          &nodes[i].kernelEvent);
+      break;
+    }
+    case UR_EXP_BATCH_COMMAND_TYPE_USM_MEMCPY: {
+      auto &args = command.args.usmMemcpy;
+      if (!args.pDst || !args.pSrc) {
+        result = UR_RESULT_ERROR_INVALID_NULL_POINTER;
+        break;
+      }
+      nodes[i].task = tp.schedule_task([args, barrierDeps,
+                                        deps = std::move(deps)](size_t) {
+                          for (auto &dep : *barrierDeps) {
+                            dep.wait();
+                          }
+                          for (auto &dep : deps) {
+                            dep.wait();
+                          }
+                          ur::dma::copy(args.pDst, args.pSrc, args.size,
+                                        inlineExecutor);
+                        }).share();
+      break;
+    }
+    case UR_EXP_BATCH_COMMAND_TYPE_USM_FILL: {
+      auto &args = command.args.usmFill;
+      if (!args.pMem || !args.pPattern) {
+        result = UR_RESULT_ERROR_INVALID_NULL_POINTER;
+        break;
+      }
+      if (args.patternSize == 0 || args.size == 0 ||
+          args.patternSize >= args.size || args.size % args.patternSize) {
+        result = UR_RESULT_ERROR_INVALID_SIZE;
+        break;
+      }
+      // The pattern only has to stay valid until the batch is enqueued.
+      auto *patternBytes = static_cast<const uint8_t *>(args.pPattern);
+      std::vector<uint8_t> pattern(patternBytes,
+                                   patternBytes + args.patternSize);
+      nodes[i].task =
+          tp.schedule_task([pMem = args.pMem, size = args.size, barrierDeps,
+                            deps = std::move(deps),
+                            pattern = std::move(pattern)](size_t) {
+              for (auto &dep : *barrierDeps) {
+                dep.wait();
+              }
+              for (auto &dep : deps) {
+                dep.wait();
+              }
+              ur::dma::fill(pMem, pattern.data(), pattern.size(), size,
+                            inlineExecutor);
+            }).share();
+      break;
+    }
+    default: {
+      // The nodes before the previous barrier are already in barrierDeps.
+      auto newBarrierDeps = std::make_shared<batch_deps_t>(*barrierDeps);
+      newBarrierDeps->insert(newBarrierDeps->end(), nodes.begin(),
+                             nodes.begin() + i);
+      barrierDeps = std::move(newBarrierDeps);
+      break;
+    }
+    }
+  }
+
+  auto waitAll = [nodes]() {
+    for (auto &node : nodes) {
+      node.wait();
+    }
+  };
+  // Kernel events are tracked by the queue, so they are only released by the
+  // thread completing the batch event rather than by the thread pool.
+  auto releaseKernelEvents = [nodes]() {
+    for (auto &node : nodes) {
+      if (node.kernelEvent) {
+        urEventRelease(node.kernelEvent);
+      }
+    }
+  };
+
+  if (result != UR_RESULT_SUCCESS) {
+    waitAll();
+    releaseKernelEvents();
+    urEventRelease(event);
+    return result;
+  }
+
+  // The batch event completes once a pool task, scheduled after all the
+  // commands, has seen them finish, so its status is known without waiting.
+  std::vector<std::future<void>> futures;
+  futures.emplace_back(tp.schedule_task([waitAll](size_t) { waitAll(); }));
+  event->set_futures(futures);
+  event->set_callback([event, releaseKernelEvents]() {
+    event->tick_end();
+    releaseKernelEvents();
+  });
+
+  if (phEvent) {
+    *phEvent = event;
+  }
+  if (hQueue->isInOrder()) {
+    urEventWait(1, &event);
+  }
+
+  return UR_RESULT_SUCCESS;
+}
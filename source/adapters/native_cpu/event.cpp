@@ -150,6 +150,13 @@ void ur_event_handle_t_::wait() {
     callback();
 }
 
+void ur_event_handle_t_::wait_futures() {
+  std::lock_guard<std::mutex> lock(mutex);
+  for (auto &f : futures) {
+    f.wait();
+  }
+}
+
 void ur_event_handle_t_::tick_start() {
   if (!queue->isProfiling())
     return;
@@ -10,6 +10,7 @@
 #pragma once
 #include "common.hpp"
 #include "ur_api.h"
+#include <chrono>
 #include <cstdint>
 #include <future>
 #include <mutex>
@@ -25,13 +26,23 @@ struct ur_event_handle_t_ : RefCounted {
 
   void wait();
 
+  // Waits for the futures of the command only, without completing the event.
+  // Safe to call from the thread pool.
+  void wait_futures();
+
   uint32_t getExecutionStatus() {
     // TODO: add support for UR_EVENT_STATUS_RUNNING
     std::lock_guard<std::mutex> lock(mutex);
     if (done) {
       return UR_EVENT_STATUS_COMPLETE;
     }
-    return UR_EVENT_STATUS_SUBMITTED;
+    // Commands without futures have already run on the enqueuing thread.
+    for (auto &f : futures) {
+      if (f.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return UR_EVENT_STATUS_SUBMITTED;
+      }
+    }
+    return UR_EVENT_STATUS_COMPLETE;
   }
 
   ur_queue_handle_t getQueue() const { return queue; }
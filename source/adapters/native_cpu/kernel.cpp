@@ -12,9 +12,11 @@
 #include "ur_util.hpp"
 
 #include "common.hpp"
+#include "device.hpp"
 #include "kernel.hpp"
 #include "memory.hpp"
 #include "program.hpp"
+#include "queue.hpp"
 
 UR_APIEXPORT ur_result_t UR_APICALL
 urKernelCreate(ur_program_handle_t hProgram, const char *pKernelName,
@@ -259,9 +261,6 @@ UR_APIEXPORT ur_result_t UR_APICALL
 urKernelSetArgMemObj(ur_kernel_handle_t hKernel, uint32_t argIndex,
                      const ur_kernel_arg_mem_obj_properties_t *pProperties,
                      ur_mem_handle_t hArgValue) {
-  std::ignore = argIndex;
-  std::ignore = pProperties;
-
   UR_ASSERT(hKernel, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
 
   // Taken from ur/adapters/cuda/kernel.cpp
@@ -271,7 +270,10 @@ urKernelSetArgMemObj(ur_kernel_handle_t hKernel, uint32_t argIndex,
     return UR_RESULT_SUCCESS;
   }
 
-  hKernel->addPtrArg(hArgValue->_mem, argIndex);
+  const ur_mem_flags_t AccessFlags =
+      pProperties ? pProperties->memoryAccess
+                  : static_cast<ur_mem_flags_t>(UR_MEM_FLAG_READ_WRITE);
+  hKernel->addMemObjArg(hArgValue, argIndex, AccessFlags);
   return UR_RESULT_SUCCESS;
 }
 
@@ -308,11 +310,82 @@ UR_APIEXPORT ur_result_t UR_APICALL urKernelCreateWithNativeHandle(
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urKernelGetSuggestedLocalWorkSize(
-    [[maybe_unused]] ur_kernel_handle_t hKernel,
-    [[maybe_unused]] ur_queue_handle_t hQueue,
-    [[maybe_unused]] uint32_t workDim,
-    [[maybe_unused]] const size_t *pGlobalWorkOffset,
-    [[maybe_unused]] const size_t *pGlobalWorkSize,
-    [[maybe_unused]] size_t *pSuggestedLocalWorkSize) {
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+    ur_kernel_handle_t hKernel, ur_queue_handle_t hQueue, uint32_t workDim,
+    const size_t *pGlobalWorkOffset, const size_t *pGlobalWorkSize,
+    size_t *pSuggestedLocalWorkSize) {
+  UR_ASSERT(hKernel, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(hQueue, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_ASSERT(pGlobalWorkOffset, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  UR_ASSERT(pGlobalWorkSize, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  UR_ASSERT(pSuggestedLocalWorkSize, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  UR_ASSERT(workDim > 0 && workDim < 4, UR_RESULT_ERROR_INVALID_WORK_DIMENSION);
+
+  if (auto Reqd = hKernel->getReqdWGSize()) {
+    for (uint32_t Dim = 0; Dim < workDim; Dim++) {
+      pSuggestedLocalWorkSize[Dim] = Reqd.value()[Dim];
+    }
+    return UR_RESULT_SUCCESS;
+  }
+
+  // Work-groups are spread across the threadpool and their work-items run
+  // sequentially on one thread, vectorized along dimension 0. Dimensions 1
+  // and 2 therefore get a local size of 1, which gives the launch the most
+  // work-groups to parallelize over, and dimension 0 gets the largest local
+  // size that still keeps every thread busy.
+  size_t OuterGroups = 1;
+  for (uint32_t Dim = 1; Dim < workDim; Dim++) {
+    pSuggestedLocalWorkSize[Dim] = 1;
+    OuterGroups *= pGlobalWorkSize[Dim];
+  }
+
+  const auto Device = hQueue->getDevice();
+  const size_t NumThreads = std::max<size_t>(1, Device->tp.num_threads());
+  const size_t Global0 = pGlobalWorkSize[0];
+
+  size_t Limit = std::min(Global0, native_cpu::MaxWorkGroupSize);
+  if (auto MaxWG = hKernel->getMaxWGSize()) {
+    Limit = std::min<size_t>(Limit, MaxWG.value()[0]);
+  }
+  if (auto MaxLinearWG = hKernel->getMaxLinearWGSize()) {
+    Limit = std::min<size_t>(Limit, *MaxLinearWG);
+  }
+  // Keep at least one work-group per thread.
+  if (OuterGroups < NumThreads) {
+    Limit = std::min(Limit,
+                     std::max<size_t>(1, Global0 * OuterGroups / NumThreads));
+  }
+  // A work-group's local memory plus the data it streams, estimated as one
+  // cache line per work-item, should stay resident in the L2 of its thread.
+  size_t LocalMemSize = 0;
+  for (const auto &Entry : hKernel->_localArgInfo) {
+    LocalMemSize += Entry.argSize;
+  }
+  const auto &Caches = Device->Caches;
+  if (LocalMemSize < Caches.L2Size) {
+    Limit = std::min(Limit, std::max<size_t>(1, (Caches.L2Size - LocalMemSize) /
+                                                    Caches.LineSize));
+  }
+
+  // The local size must divide the global size. Prefer multiples of the
+  // vector width, which leave no scalar tail in the vectorized loop, unless
+  // that would more than halve the work-group.
+  size_t Suggested = 1;
+  for (size_t Candidate = Limit; Candidate > 1; Candidate--) {
+    if (Candidate * 2 < Suggested) {
+      break;
+    }
+    if (Global0 % Candidate != 0) {
+      continue;
+    }
+    if (Candidate % native_cpu::NativeVectorWidth32 == 0) {
+      Suggested = Candidate;
+      break;
+    }
+    if (Suggested == 1) {
+      Suggested = Candidate;
+    }
+  }
+  pSuggestedLocalWorkSize[0] = Suggested;
+
+  return UR_RESULT_SUCCESS;
 }
@@ -9,9 +9,13 @@
 #pragma once
 
 #include "common.hpp"
+#include "memory.hpp"
 #include "nativecpu_state.hpp"
 #include "program.hpp"
+#include <algorithm>
 #include <cstring>
+#include <limits>
+#include <memory>
 #include <ur_api.h>
 #include <utility>
 
@@ -35,6 +39,7 @@ struct ur_kernel_handle_t_ : RefCounted {
   ur_kernel_handle_t_(const ur_kernel_handle_t_ &other)
       : Args(other.Args), hProgram(other.hProgram), _name(other._name),
         _subhandler(other._subhandler), _localArgInfo(other._localArgInfo),
+        MemObjArgs(other.MemObjArgs),
         _localMemPool(other._localMemPool),
         _localMemPoolSize(other._localMemPoolSize),
         ReqdWGSize(other.ReqdWGSize) {
@@ -44,7 +49,6 @@ struct ur_kernel_handle_t_ : RefCounted {
   ~ur_kernel_handle_t_() {
     if (decrementReferenceCount() == 0) {
       free(_localMemPool);
-      Args.deallocate();
     }
   }
 
@@ -59,9 +63,16 @@ struct ur_kernel_handle_t_ : RefCounted {
 
   struct arguments {
     using args_index_t = std::vector<void *>;
+    // Pointers handed to the kernel: by-value arguments point into Storage,
+    // pointer arguments are stored directly.
     args_index_t Indices;
-    std::vector<size_t> ParamSizes;
-    std::vector<bool> OwnsMem;
+    // Location and size of each by-value argument in Storage.
+    struct slot_t {
+      size_t Offset;
+      size_t Size;
+    };
+    std::vector<slot_t> Slots;
+    static constexpr size_t NoSlot = std::numeric_limits<size_t>::max();
     static constexpr size_t MaxAlign = 16 * sizeof(double);
 
     /// Add an argument to the kernel.
@@ -70,48 +81,90 @@ struct ur_kernel_handle_t_ : RefCounted {
     /// Gaps are filled with empty arguments.
     /// Implicit offset argument is kept at the back of the indices collection.
     void addArg(size_t Index, size_t Size, const void *Arg) {
-      if (Index + 1 > Indices.size()) {
-        Indices.resize(Index + 1);
-        OwnsMem.resize(Index + 1);
-        ParamSizes.resize(Index + 1);
-
-        // Update the stored value for the argument
-        Indices[Index] = native_cpu::aligned_malloc(MaxAlign, Size);
-        OwnsMem[Index] = true;
-        ParamSizes[Index] = Size;
-      } else {
-        if (ParamSizes[Index] != Size) {
-          Indices[Index] = realloc(Indices[Index], Size);
-          ParamSizes[Index] = Size;
+      resize(Index);
+      if (Slots[Index].Offset == NoSlot || Slots[Index].Size != Size) {
+        Slots[Index] = {NoSlot, Size};
+        size_t Offset = alignUp(StorageUsed, alignFor(Size));
+        if (Offset + Size > StorageCapacity || !isUnique()) {
+          rebuild(Size);
+          Offset = alignUp(StorageUsed, alignFor(Size));
         }
+        Slots[Index].Offset = Offset;
+        StorageUsed = Offset + Size;
+      } else if (!isUnique()) {
+        rebuild(0);
       }
+      Indices[Index] = Storage.get() + Slots[Index].Offset;
       std::memcpy(Indices[Index], Arg, Size);
     }
 
     void addPtrArg(size_t Index, void *Arg) {
+      resize(Index);
+      Slots[Index] = {NoSlot, sizeof(uint8_t *)};
+      Indices[Index] = Arg;
+    }
+
+    const args_index_t &getIndices() const noexcept { return Indices; }
+
+  private:
+    static size_t alignUp(size_t Value, size_t Align) {
+      return (Value + Align - 1) & ~(Align - 1);
+    }
+
+    // Arguments are aligned to the largest power of two dividing their size,
+    // which is at least the alignment of any type of that size.
+    static size_t alignFor(size_t Size) {
+      return Size ? std::min(MaxAlign, Size & (~Size + 1)) : 1;
+    }
+
+    void resize(size_t Index) {
       if (Index + 1 > Indices.size()) {
         Indices.resize(Index + 1);
-        OwnsMem.resize(Index + 1);
-        ParamSizes.resize(Index + 1);
-
-        OwnsMem[Index] = false;
-        ParamSizes[Index] = sizeof(uint8_t *);
+        Slots.resize(Index + 1, {NoSlot, 0});
       }
-      Indices[Index] = Arg;
     }
 
-    // This is called by the destructor of ur_kernel_handle_t_, since
-    // ur_kernel_handle_t_ implements reference counting and we want
-    // to deallocate only when the reference count is 0.
-    void deallocate() {
-      assert(OwnsMem.size() == Indices.size() && "Size mismatch");
-      for (size_t Index = 0; Index < Indices.size(); Index++) {
-        if (OwnsMem[Index])
-          native_cpu::aligned_free(Indices[Index]);
+    // Copies of the kernel taken at enqueue time share Storage, so it must
+    // not be written in place while any of them is alive.
+    bool isUnique() const { return Storage.use_count() == 1; }
+
+    // Moves the live arguments into a new, packed buffer with room for at
+    // least Extra more bytes.
+    void rebuild(size_t Extra) {
+      size_t Used = 0;
+      for (const slot_t &Slot : Slots) {
+        if (Slot.Offset != NoSlot)
+          Used = alignUp(Used, alignFor(Slot.Size)) + Slot.Size;
+      }
+      size_t Capacity = StorageCapacity;
+      if (Used + Extra + MaxAlign > Capacity)
+        Capacity = std::max(2 * Capacity, Used + Extra + MaxAlign);
+      Capacity = alignUp(Capacity, MaxAlign);
+
+      std::shared_ptr<char> NewStorage(
+          static_cast<char *>(native_cpu::aligned_malloc(MaxAlign, Capacity)),
+          native_cpu::aligned_free);
+      size_t Offset = 0;
+      for (size_t I = 0; I < Slots.size(); I++) {
+        slot_t &Slot = Slots[I];
+        if (Slot.Offset == NoSlot)
+          continue;
+        Offset = alignUp(Offset, alignFor(Slot.Size));
+        std::memcpy(NewStorage.get() + Offset, Storage.get() + Slot.Offset,
+                    Slot.Size);
+        Slot.Offset = Offset;
+        Indices[I] = NewStorage.get() + Offset;
+        Offset += Slot.Size;
       }
+      Storage = std::move(NewStorage);
+      StorageUsed = Used;
+      StorageCapacity = Capacity;
     }
 
-    const args_index_t &getIndices() const noexcept { return Indices; }
+    // Single buffer holding the values of all by-value arguments.
+    std::shared_ptr<char> Storage;
+    size_t StorageUsed = 0;
+    size_t StorageCapacity = 0;
 
   } Args;
 
@@ -120,6 +173,16 @@ struct ur_kernel_handle_t_ : RefCounted {
   nativecpu_task_t _subhandler;
   std::vector<local_arg_info_t> _localArgInfo;
 
+  // Memory objects bound as arguments. Their storage is resolved when the
+  // kernel is enqueued, since it may be allocated lazily or replaced by a
+  // private copy after the argument is set.
+  struct mem_obj_arg {
+    ur_mem_handle_t_ *Mem;
+    size_t Index;
+    ur_mem_flags_t AccessFlags;
+  };
+  std::vector<mem_obj_arg> MemObjArgs;
+
   std::optional<native_cpu::WGSize_t> getReqdWGSize() const {
     return ReqdWGSize;
   }
@@ -156,15 +219,46 @@ struct ur_kernel_handle_t_ : RefCounted {
     }
   }
 
+  // To be called before the kernel is enqueued if memory objects are bound.
+  // Fails if the storage of a memory object can't be allocated.
+  ur_result_t updateMemObjArgs() {
+    for (const auto &Arg : MemObjArgs) {
+      void *Ptr = (Arg.AccessFlags & UR_MEM_FLAG_READ_ONLY)
+                      ? Arg.Mem->getReadPtr()
+                      : Arg.Mem->getWritePtr();
+      UR_ASSERT(Ptr, UR_RESULT_ERROR_OUT_OF_HOST_MEMORY);
+      Args.Indices[Arg.Index] = Ptr;
+    }
+    return UR_RESULT_SUCCESS;
+  }
+
   const std::vector<void *> &getArgs() const { return Args.getIndices(); }
 
   void addArg(const void *Ptr, size_t Index, size_t Size) {
+    removeMemObjArg(Index);
     Args.addArg(Index, Size, Ptr);
   }
 
-  void addPtrArg(void *Ptr, size_t Index) { Args.addPtrArg(Index, Ptr); }
+  void addPtrArg(void *Ptr, size_t Index) {
+    removeMemObjArg(Index);
+    Args.addPtrArg(Index, Ptr);
+  }
+
+  void addMemObjArg(ur_mem_handle_t_ *Mem, size_t Index,
+                    ur_mem_flags_t AccessFlags) {
+    addPtrArg(nullptr, Index);
+    MemObjArgs.push_back({Mem, Index, AccessFlags});
+  }
 
 private:
+  void removeMemObjArg(size_t Index) {
+    MemObjArgs.erase(std::remove_if(MemObjArgs.begin(), MemObjArgs.end(),
+                                    [Index](const mem_obj_arg &Arg) {
+                                      return Arg.Index == Index;
+                                    }),
+                     MemObjArgs.end());
+  }
+
   char *_localMemPool = nullptr;
   size_t _localMemPoolSize = 0;
   std::optional<native_cpu::WGSize_t> ReqdWGSize = std::nullopt;
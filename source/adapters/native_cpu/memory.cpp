@@ -31,7 +31,6 @@ UR_APIEXPORT ur_result_t UR_APICALL urMemBufferCreate(
     const ur_buffer_properties_t *pProperties, ur_mem_handle_t *phBuffer) {
 
   // TODO: add proper error checking and double check flag semantics
-  // TODO: support UR_MEM_FLAG_ALLOC_COPY_HOST_POINTER flag
 
   UR_ASSERT(phBuffer, UR_RESULT_ERROR_INVALID_NULL_POINTER);
 
@@ -50,12 +49,18 @@ UR_APIEXPORT ur_result_t UR_APICALL urMemBufferCreate(
 
   ur_mem_handle_t_ *retMem;
 
-  if (useHostPtr) {
-    retMem = new _ur_buffer(hContext, pProperties->pHost);
-  } else if (copyHostPtr) {
-    retMem = new _ur_buffer(hContext, pProperties->pHost, size);
-  } else {
-    retMem = new _ur_buffer(hContext, size);
+  try {
+    if (useHostPtr) {
+      retMem = new _ur_buffer(hContext, pProperties->pHost, size,
+                              ur_mem_handle_t_::host_ptr_mode::use);
+    } else if (copyHostPtr) {
+      retMem = new _ur_buffer(hContext, pProperties->pHost, size,
+                              ur_mem_handle_t_::host_ptr_mode::copy);
+    } else {
+      retMem = new _ur_buffer(hContext, size);
+    }
+  } catch (const std::bad_alloc &) {
+    return UR_RESULT_ERROR_OUT_OF_HOST_MEMORY;
   }
 
   *phBuffer = retMem;
@@ -63,9 +68,10 @@ UR_APIEXPORT ur_result_t UR_APICALL urMemBufferCreate(
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urMemRetain(ur_mem_handle_t hMem) {
-  std::ignore = hMem;
+  UR_ASSERT(hMem, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
 
-  DIE_NO_IMPLEMENTATION
+  hMem->_refCount++;
+  return UR_RESULT_SUCCESS;
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urMemRelease(ur_mem_handle_t hMem) {
@@ -76,7 +82,11 @@ UR_APIEXPORT ur_result_t UR_APICALL urMemRelease(ur_mem_handle_t hMem) {
     return UR_RESULT_SUCCESS;
   }
 
+  auto Parent = hMem->Parent;
   delete hMem;
+  if (Parent) {
+    return urMemRelease(Parent);
+  }
   return UR_RESULT_SUCCESS;
 }
 
@@ -90,7 +100,10 @@ UR_APIEXPORT ur_result_t UR_APICALL urMemBufferPartition(
                 !(static_cast<_ur_buffer *>(hBuffer))->isSubBuffer(),
             UR_RESULT_ERROR_INVALID_MEM_OBJECT);
 
-  std::shared_lock<ur_shared_mutex> Guard(hBuffer->Mutex);
+  UR_ASSERT(pRegion, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  UR_ASSERT(pRegion->size != 0 &&
+                pRegion->origin + pRegion->size <= hBuffer->Size,
+            UR_RESULT_ERROR_INVALID_BUFFER_SIZE);
 
   if (flags != UR_MEM_FLAG_READ_WRITE) {
     die("urMemBufferPartition: NativeCPU implements only read-write buffer,"
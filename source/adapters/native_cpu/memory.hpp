@@ -13,28 +13,55 @@
 #include <atomic>
 #include <cstdlib>
 #include <cstring>
+#include <new>
 
 #include "common.hpp"
 #include "context.hpp"
 
+// Storage of a memory object is resolved on access:
+//  - buffers without a host pointer are allocated on first use,
+//  - UR_MEM_FLAG_USE_HOST_POINTER buffers use the host memory in place,
+//  - UR_MEM_FLAG_ALLOC_COPY_HOST_POINTER buffers copy the host memory at
+//    creation, or, when UR_NATIVE_CPU_DEFER_HOST_PTR_COPY is set, read it in
+//    place until the first write. Deferring requires the application to keep
+//    the host memory alive and unmodified while the buffer is only read.
+// Sub-buffers resolve through their parent. The accessors below return
+// nullptr if the storage can't be allocated.
 struct ur_mem_handle_t_ : _ur_object {
+  enum class host_ptr_mode { use, copy };
+
   ur_mem_handle_t_(size_t Size, bool _IsImage)
-      : _mem{static_cast<char *>(malloc(Size))}, _ownsMem{true},
-        IsImage{_IsImage} {}
+      : Size{Size}, _ownsMem{true}, IsImage{_IsImage} {}
 
-  ur_mem_handle_t_(void *HostPtr, size_t Size, bool _IsImage)
-      : _mem{static_cast<char *>(malloc(Size))}, _ownsMem{true},
-        IsImage{_IsImage} {
-    memcpy(_mem, HostPtr, Size);
+  ur_mem_handle_t_(void *HostPtr, size_t Size, host_ptr_mode Mode,
+                   bool _IsImage)
+      : Size{Size}, _ownsMem{Mode == host_ptr_mode::copy}, IsImage{_IsImage} {
+    if (Mode == host_ptr_mode::use) {
+      Mem.store(static_cast<char *>(HostPtr), std::memory_order_release);
+    } else if (deferHostPtrCopy()) {
+      CopySource = static_cast<const char *>(HostPtr);
+    } else {
+      // Nothing could be copied later, so a failure is reported on creation.
+      char *Alloc = allocate();
+      if (!Alloc) {
+        throw std::bad_alloc();
+      }
+      memcpy(Alloc, HostPtr, Size);
+      Mem.store(Alloc, std::memory_order_release);
+    }
   }
 
-  ur_mem_handle_t_(void *HostPtr, bool _IsImage)
-      : _mem{static_cast<char *>(HostPtr)}, _ownsMem{false}, IsImage{_IsImage} {
+  ur_mem_handle_t_(ur_mem_handle_t_ *Parent, size_t Origin, size_t Size,
+                   bool _IsImage)
+      : Size{Size}, _ownsMem{false}, Parent{Parent}, Origin{Origin},
+        IsImage{_IsImage} {
+    // Sub-buffers keep their parent alive.
+    Parent->_refCount++;
   }
 
   ~ur_mem_handle_t_() {
     if (_ownsMem) {
-      free(_mem);
+      free(Mem.load(std::memory_order_acquire));
     }
   }
 
@@ -43,34 +70,104 @@ struct ur_mem_handle_t_ : _ur_object {
   // Method to get type of the derived object (image or buffer)
   bool isImage() const { return this->IsImage; }
 
-  char *_mem;
+  // Pointer to the contents for an access that doesn't modify them.
+  char *getReadPtr() {
+    if (Parent) {
+      return offsetOf(Parent->getReadPtr(), Origin);
+    }
+    if (char *Ptr = Mem.load(std::memory_order_acquire)) {
+      return Ptr;
+    }
+    if (CopySource) {
+      return const_cast<char *>(CopySource);
+    }
+    return materialize(0, 0);
+  }
+
+  // Pointer to the contents for an access that may modify them.
+  char *getWritePtr() {
+    if (Parent) {
+      return offsetOf(Parent->getWritePtr(), Origin);
+    }
+    if (char *Ptr = Mem.load(std::memory_order_acquire)) {
+      return Ptr;
+    }
+    return materialize(0, 0);
+  }
+
+  // Pointer to the contents for an access that overwrites
+  // [Offset, Offset + InvalidSize) without reading it, the previous contents
+  // of that range don't need to be preserved.
+  char *getWriteInvalidatePtr(size_t Offset, size_t InvalidSize) {
+    if (Parent) {
+      return offsetOf(
+          Parent->getWriteInvalidatePtr(Origin + Offset, InvalidSize), Origin);
+    }
+    if (char *Ptr = Mem.load(std::memory_order_acquire)) {
+      return Ptr;
+    }
+    return materialize(Offset, InvalidSize);
+  }
+
+  const size_t Size;
   bool _ownsMem;
   std::atomic_uint32_t _refCount = {1};
 
+  // Parent buffer and offset in it, only set for sub-buffers.
+  ur_mem_handle_t_ *const Parent = nullptr;
+  const size_t Origin = 0;
+
 private:
+  static bool deferHostPtrCopy() {
+    static const bool Defer =
+        getenv_tobool("UR_NATIVE_CPU_DEFER_HOST_PTR_COPY", false);
+    return Defer;
+  }
+
+  char *allocate() const { return static_cast<char *>(malloc(Size)); }
+
+  static char *offsetOf(char *Ptr, size_t Offset) {
+    return Ptr ? Ptr + Offset : nullptr;
+  }
+
+  // Allocates the storage, copying the deferred host data except for the
+  // invalidated range.
+  char *materialize(size_t InvalidOffset, size_t InvalidSize) {
+    std::lock_guard<ur_shared_mutex> Lock(Mutex);
+    if (char *Ptr = Mem.load(std::memory_order_acquire)) {
+      return Ptr;
+    }
+    char *Alloc = allocate();
+    if (!Alloc) {
+      // Left unallocated, so that a later access can retry.
+      return nullptr;
+    }
+    if (CopySource) {
+      const size_t InvalidBegin = std::min(Size, InvalidOffset);
+      const size_t InvalidEnd = std::min(Size, InvalidOffset + InvalidSize);
+      memcpy(Alloc, CopySource, InvalidBegin);
+      memcpy(Alloc + InvalidEnd, CopySource + InvalidEnd, Size - InvalidEnd);
+    }
+    Mem.store(Alloc, std::memory_order_release);
+    return Alloc;
+  }
+
+  std::atomic<char *> Mem = nullptr;
+  // Host memory backing the buffer until the first write, see
+  // UR_NATIVE_CPU_DEFER_HOST_PTR_COPY.
+  const char *CopySource = nullptr;
   const bool IsImage;
 };
 
 struct _ur_buffer final : ur_mem_handle_t_ {
   // Buffer constructor
-  _ur_buffer(ur_context_handle_t /* Context*/, void *HostPtr)
-      : ur_mem_handle_t_(HostPtr, false) {}
-  _ur_buffer(ur_context_handle_t /* Context*/, void *HostPtr, size_t Size)
-      : ur_mem_handle_t_(HostPtr, Size, false) {}
+  _ur_buffer(ur_context_handle_t /* Context*/, void *HostPtr, size_t Size,
+             host_ptr_mode Mode)
+      : ur_mem_handle_t_(HostPtr, Size, Mode, false) {}
   _ur_buffer(ur_context_handle_t /* Context*/, size_t Size)
       : ur_mem_handle_t_(Size, false) {}
   _ur_buffer(_ur_buffer *b, size_t Offset, size_t Size)
-      : ur_mem_handle_t_(b->_mem + Offset, false), SubBuffer(b) {
-    std::ignore = Size;
-    SubBuffer.Origin = Offset;
-  }
-
-  bool isSubBuffer() const { return SubBuffer.Parent != nullptr; }
+      : ur_mem_handle_t_(b, Offset, Size, false) {}
 
-  struct BB {
-    BB(_ur_buffer *b) : Parent(b), Origin(0) {}
-    BB() : BB(nullptr) {}
-    _ur_buffer *const Parent;
-    size_t Origin; // only valid if Parent != nullptr
-  } SubBuffer;
+  bool isSubBuffer() const { return Parent != nullptr; }
 };
@@ -60,6 +60,9 @@ UR_APIEXPORT ur_result_t UR_APICALL urProgramCreateWithBinary(
     ur_program_handle_t *phProgram) {
   if (numDevices > 1)
     return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  // Loading the binary from a file source chained to pProperties isn't
+  // supported.
+  UR_ASSERT(ppBinaries, UR_RESULT_ERROR_UNSUPPORTED_FEATURE);
 
   auto hDevice = phDevices[0];
   auto pBinary = ppBinaries[0];
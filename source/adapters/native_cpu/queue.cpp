@@ -33,6 +33,8 @@ UR_APIEXPORT ur_result_t UR_APICALL urQueueCreate(
     const ur_queue_properties_t *pProperties, ur_queue_handle_t *phQueue) {
   // TODO: UR_QUEUE_FLAG_PROFILING_ENABLE and other props
 
+  // The queue runs its commands on the device's threadpool.
+  urDeviceRetain(hDevice);
   auto Queue = new ur_queue_handle_t_(hDevice, hContext, pProperties);
   *phQueue = Queue;
 
@@ -47,9 +49,12 @@ UR_APIEXPORT ur_result_t UR_APICALL urQueueRetain(ur_queue_handle_t hQueue) {
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urQueueRelease(ur_queue_handle_t hQueue) {
-  decrementOrDelete(hQueue);
-
-  return UR_RESULT_SUCCESS;
+  if (hQueue->decrementReferenceCount() != 0) {
+    return UR_RESULT_SUCCESS;
+  }
+  auto Device = hQueue->getDevice();
+  delete hQueue;
+  return urDeviceRelease(Device);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL
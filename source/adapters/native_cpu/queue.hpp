@@ -11,6 +11,7 @@
 #include "common.hpp"
 #include "event.hpp"
 #include "ur_api.h"
+#include "ur_usm_arena.hpp"
 #include <set>
 
 struct ur_queue_handle_t_ : RefCounted {
@@ -21,7 +22,11 @@ struct ur_queue_handle_t_ : RefCounted {
                            UR_QUEUE_FLAG_OUT_OF_ORDER_EXEC_MODE_ENABLE)
                        : true),
         profilingEnabled(pProps ? pProps->flags & UR_QUEUE_FLAG_PROFILING_ENABLE
-                                : false) {}
+                                : false),
+        usmArena({urUSMDeviceAlloc, urUSMFree, urEnqueueEventsWait,
+                  urEnqueueEventsWaitWithBarrier, urEventGetInfo, urEventWait,
+                  urEventRetain, urEventRelease},
+                 context, device, inOrder) {}
 
   ur_device_handle_t getDevice() const { return device; }
 
@@ -47,10 +52,15 @@ struct ur_queue_handle_t_ : RefCounted {
 
   bool isProfiling() const { return profilingEnabled; }
 
+  ur::usm_arena::arena_t &getUSMArena() { return usmArena; }
+
 private:
   ur_device_handle_t device;
   ur_context_handle_t context;
   std::set<ur_event_handle_t> events;
   const bool inOrder;
   const bool profilingEnabled;
+  // Declared last, so that its pending events are released while the queue
+  // can still track them.
+  ur::usm_arena::arena_t usmArena;
 };
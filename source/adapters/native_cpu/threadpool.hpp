@@ -17,27 +17,53 @@
 #include <iterator>
 #include <mutex>
 #include <numeric>
+#include <optional>
 #include <queue>
 #include <string>
 #include <thread>
 #include <vector>
 
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 namespace native_cpu {
 
 using worker_task_t = std::function<void(size_t)>;
 
 namespace detail {
 
+// Restricts the calling thread to the given logical CPU. This is a best-effort
+// hint, failures are ignored and the thread keeps its inherited affinity.
+inline void bind_current_thread_to_cpu(size_t cpu) noexcept {
+#ifdef __linux__
+  if (cpu >= CPU_SETSIZE) {
+    return;
+  }
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  CPU_SET(cpu, &cpuSet);
+  pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+#else
+  (void)cpu;
+#endif
+}
+
 class worker_thread {
 public:
   // Initializes state, but does not start the worker thread
-  worker_thread(size_t threadId) noexcept
+  worker_thread(size_t threadId,
+                std::optional<size_t> boundCpu = std::nullopt) noexcept
       : m_threadId(threadId), m_isRunning(false), m_numTasks(0) {
     std::lock_guard<std::mutex> lock(m_workMutex);
     if (this->is_running()) {
       return;
     }
-    m_worker = std::thread([this]() {
+    m_worker = std::thread([this, boundCpu]() {
+      if (boundCpu) {
+        bind_current_thread_to_cpu(*boundCpu);
+      }
       while (true) {
         std::unique_lock<std::mutex> lock(m_workMutex);
         // Wait until there's work available
@@ -128,6 +154,15 @@ public:
     m_isRunning.store(true, std::memory_order_release);
   }
 
+  // Creates one worker per entry of cpus, each bound to that logical CPU.
+  simple_thread_pool(const std::vector<size_t> &cpus) noexcept
+      : m_isRunning(false), m_numThreads(cpus.size()) {
+    for (size_t i = 0; i < m_numThreads; i++) {
+      m_workers.emplace_front(i, cpus[i]);
+    }
+    m_isRunning.store(true, std::memory_order_release);
+  }
+
   ~simple_thread_pool() {
     for (auto &t : m_workers) {
       t.stop();
@@ -173,7 +208,7 @@ protected:
         });
   }
 
-private:
+public:
   static size_t get_num_threads() {
     size_t numThreads;
     char *envVar = std::getenv("SYCL_NATIVE_CPU_HOST_THREADS");
@@ -185,6 +220,7 @@ private:
     return numThreads;
   }
 
+private:
   std::forward_list<worker_thread> m_workers;
 
   std::atomic<bool> m_isRunning;
@@ -201,6 +237,8 @@ public:
 
   threadpool_interface() : threadpool() {}
 
+  threadpool_interface(const std::vector<size_t> &cpus) : threadpool(cpus) {}
+
   auto schedule_task(worker_task_t &&task) {
     auto workerTask = std::make_shared<std::packaged_task<void(size_t)>>(
         [task](auto &&PH1) { return task(std::forward<decltype(PH1)>(PH1)); });
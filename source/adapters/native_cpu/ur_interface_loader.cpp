@@ -401,6 +401,10 @@ UR_DLLEXPORT ur_result_t UR_APICALL urGetEnqueueExpProcAddrTable(
   pDdiTable->pfnCooperativeKernelLaunchExp = nullptr;
   pDdiTable->pfnTimestampRecordingExp = urEnqueueTimestampRecordingExp;
   pDdiTable->pfnNativeCommandExp = urEnqueueNativeCommandExp;
+  pDdiTable->pfnBatchExp = urEnqueueBatchExp;
+  pDdiTable->pfnHostTaskExp = urEnqueueHostTaskExp;
+  pDdiTable->pfnUSMAllocExp = urEnqueueUSMAllocExp;
+  pDdiTable->pfnUSMFreeExp = urEnqueueUSMFreeExp;
 
   return UR_RESULT_SUCCESS;
 }
@@ -10,46 +10,280 @@
 
 #include "command_buffer.hpp"
 #include "common.hpp"
+#include "context.hpp"
+#include "device.hpp"
+#include "kernel.hpp"
+#include "queue.hpp"
+
+#include <algorithm>
 
 /// The ur_exp_command_buffer_handle_t_ destructor calls CL release
 /// command-buffer to free the underlying object.
 ur_exp_command_buffer_handle_t_::~ur_exp_command_buffer_handle_t_() {
+  // Emulated command-buffers only own the kernel clones of their commands,
+  // which are released with the command handles.
+  if (isSoftware()) {
+    return;
+  }
+
   urQueueRelease(hInternalQueue);
 
-  cl_context CLContext = cl_adapter::cast<cl_context>(hContext);
-  cl_ext::clReleaseCommandBufferKHR_fn clReleaseCommandBufferKHR = nullptr;
-  cl_int Res =
-      cl_ext::getExtFuncFromContext<decltype(clReleaseCommandBufferKHR)>(
-          CLContext, cl_ext::ExtFuncPtrCache->clReleaseCommandBufferKHRCache,
-          cl_ext::ReleaseCommandBufferName, &clReleaseCommandBufferKHR);
-  assert(Res == CL_SUCCESS);
-  (void)Res;
+  cl_ext::clReleaseCommandBufferKHR_fn clReleaseCommandBufferKHR =
+      hContext->ExtFuncs.clReleaseCommandBufferKHR;
+  assert(clReleaseCommandBufferKHR);
 
   clReleaseCommandBufferKHR(CLCommandBuffer);
 }
 
+ur_exp_command_buffer_command_handle_t_::
+    ~ur_exp_command_buffer_command_handle_t_() {
+  if (SWKernel) {
+    clReleaseKernel(SWKernel);
+  }
+}
+
+namespace {
+/// Records a command of an emulated command-buffer, which is replayed by
+/// calling Enqueue. Its sync-point is its index in the command-buffer.
+ur_result_t appendSoftwareCommand(
+    ur_exp_command_buffer_handle_t hCommandBuffer,
+    uint32_t NumSyncPointsInWaitList,
+    const ur_exp_command_buffer_sync_point_t *SyncPointWaitList,
+    ur_exp_command_buffer_sync_point_t *SyncPoint,
+    sw_command_t::enqueue_t Enqueue) {
+  UR_ASSERT(!hCommandBuffer->IsFinalized, UR_RESULT_ERROR_INVALID_OPERATION);
+
+  std::vector<sw_command_t> &Commands = hCommandBuffer->SWCommands;
+  for (uint32_t I = 0; I < NumSyncPointsInWaitList; I++) {
+    UR_ASSERT(SyncPointWaitList[I] < Commands.size(),
+              UR_RESULT_ERROR_INVALID_COMMAND_BUFFER_SYNC_POINT_EXP);
+  }
+
+  try {
+    Commands.push_back(
+        {std::move(Enqueue),
+         {SyncPointWaitList, SyncPointWaitList + NumSyncPointsInWaitList}});
+  } catch (...) {
+    return UR_RESULT_ERROR_OUT_OF_RESOURCES;
+  }
+
+  if (SyncPoint) {
+    *SyncPoint =
+        static_cast<ur_exp_command_buffer_sync_point_t>(Commands.size() - 1);
+  }
+  return UR_RESULT_SUCCESS;
+}
+
+/// Records a kernel launch in an emulated command-buffer. The arguments are
+/// captured by cloning the kernel, so replays don't need to set them, and the
+/// compile work-group size is resolved once here, so the command doesn't use
+/// hKernel after this call.
+ur_result_t appendSoftwareKernelLaunch(
+    ur_exp_command_buffer_handle_t hCommandBuffer, ur_kernel_handle_t hKernel,
+    uint32_t workDim, const size_t *pGlobalWorkOffset,
+    const size_t *pGlobalWorkSize, const size_t *pLocalWorkSize,
+    uint32_t numSyncPointsInWaitList,
+    const ur_exp_command_buffer_sync_point_t *pSyncPointWaitList,
+    ur_exp_command_buffer_sync_point_t *pSyncPoint,
+    ur_exp_command_buffer_command_handle_t *phCommandHandle) {
+  UR_ASSERT(!hCommandBuffer->IsFinalized, UR_RESULT_ERROR_INVALID_OPERATION);
+
+  std::array<size_t, 3> CompileWorkGroupSize = {0, 0, 0};
+  UR_RETURN_ON_FAILURE(hKernel->getCompileWorkGroupSize(
+      hCommandBuffer->hDevice, CompileWorkGroupSize));
+  std::array<size_t, 3> LocalWorkSize = CompileWorkGroupSize;
+  if (pLocalWorkSize) {
+    LocalWorkSize = {0, 0, 0};
+    std::copy_n(pLocalWorkSize, workDim, LocalWorkSize.begin());
+  }
+
+  cl_int Res = CL_SUCCESS;
+  cl_kernel Clone = clCloneKernel(hKernel->CLKernel, &Res);
+  CL_RETURN_ON_FAILURE(Res);
+
+  std::unique_ptr<ur_exp_command_buffer_command_handle_t_> Handle;
+  try {
+    Handle = std::make_unique<ur_exp_command_buffer_command_handle_t_>(
+        hCommandBuffer, nullptr, hKernel, workDim, pLocalWorkSize != nullptr);
+  } catch (...) {
+    clReleaseKernel(Clone);
+    return UR_RESULT_ERROR_OUT_OF_RESOURCES;
+  }
+  Handle->SWKernel = Clone;
+  if (pGlobalWorkOffset) {
+    std::copy_n(pGlobalWorkOffset, workDim, Handle->GlobalWorkOffset.begin());
+  }
+  std::copy_n(pGlobalWorkSize, workDim, Handle->GlobalWorkSize.begin());
+  Handle->LocalWorkSize = LocalWorkSize;
+  Handle->CompileWorkGroupSize = CompileWorkGroupSize;
+
+  ur_exp_command_buffer_command_handle_t Command = Handle.get();
+  UR_RETURN_ON_FAILURE(appendSoftwareCommand(
+      hCommandBuffer, numSyncPointsInWaitList, pSyncPointWaitList, pSyncPoint,
+      [Command](ur_queue_handle_t Queue, uint32_t NumEventsInWaitList,
+                const ur_event_handle_t *EventWaitList,
+                ur_event_handle_t *Event) {
+        CL_RETURN_ON_FAILURE(clEnqueueNDRangeKernel(
+            Queue->CLQueue, Command->SWKernel, Command->WorkDim,
+            Command->GlobalWorkOffset.data(), Command->GlobalWorkSize.data(),
+            Command->LocalWorkSize[0] ? Command->LocalWorkSize.data()
+                                      : nullptr,
+            NumEventsInWaitList,
+            cl_adapter::cast<const cl_event *>(EventWaitList),
+            cl_adapter::cast<cl_event *>(Event)));
+        return UR_RESULT_SUCCESS;
+      }));
+
+  try {
+    hCommandBuffer->CommandHandles.push_back(std::move(Handle));
+  } catch (...) {
+    hCommandBuffer->SWCommands.pop_back();
+    return UR_RESULT_ERROR_OUT_OF_RESOURCES;
+  }
+
+  if (phCommandHandle) {
+    *phCommandHandle = Command;
+  }
+  return UR_RESULT_SUCCESS;
+}
+
+/// Replays an emulated command-buffer on hQueue with as few OpenCL calls as
+/// its sync-points allow. An in-order queue runs the commands in the order
+/// they were appended, which satisfies every sync-point, so no events are
+/// needed between them. On an out-of-order queue only the commands others
+/// depend on signal events, and a marker joins the final commands if the
+/// caller wants an event and there is more than one of them.
+ur_result_t enqueueSoftwareCommandBuffer(
+    ur_exp_command_buffer_handle_t hCommandBuffer, ur_queue_handle_t hQueue,
+    uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
+    ur_event_handle_t *phEvent) {
+  const std::vector<sw_command_t> &Commands = hCommandBuffer->SWCommands;
+  if (Commands.empty()) {
+    return urEnqueueEventsWait(hQueue, numEventsInWaitList, phEventWaitList,
+                               phEvent);
+  }
+
+  cl_command_queue_properties Properties = 0;
+  CL_RETURN_ON_FAILURE(clGetCommandQueueInfo(hQueue->CLQueue,
+                                             CL_QUEUE_PROPERTIES,
+                                             sizeof(Properties), &Properties,
+                                             nullptr));
+
+  if (!(Properties & CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE)) {
+    // Commands without an Enqueue are no-ops, which are skipped.
+    size_t End = Commands.size();
+    while (End > 0 && !Commands[End - 1].Enqueue) {
+      End--;
+    }
+    if (End == 0) {
+      return urEnqueueEventsWait(hQueue, numEventsInWaitList, phEventWaitList,
+                                 phEvent);
+    }
+
+    for (size_t I = 0; I < End; I++) {
+      if (!Commands[I].Enqueue) {
+        continue;
+      }
+      UR_RETURN_ON_FAILURE(
+          Commands[I].Enqueue(hQueue, numEventsInWaitList, phEventWaitList,
+                              I + 1 == End ? phEvent : nullptr));
+      numEventsInWaitList = 0;
+      phEventWaitList = nullptr;
+    }
+    return UR_RESULT_SUCCESS;
+  }
+
+  // No-op commands become markers when something waits for them.
+  std::vector<ur_event_handle_t> Events(Commands.size(), nullptr);
+  std::vector<ur_event_handle_t> WaitList;
+  std::vector<size_t> Sinks;
+  ur_result_t Result = UR_RESULT_SUCCESS;
+  for (size_t I = 0; I < Commands.size() && Result == UR_RESULT_SUCCESS;
+       I++) {
+    const sw_command_t &Command = Commands[I];
+    const bool IsSink = phEvent && !Command.HasDependents;
+    if (!Command.Enqueue && !Command.HasDependents && !IsSink) {
+      continue;
+    }
+
+    // Commands without sync-points wait for the caller's events, the others
+    // wait for them through their dependencies.
+    WaitList.clear();
+    if (Command.Deps.empty()) {
+      WaitList.assign(phEventWaitList, phEventWaitList + numEventsInWaitList);
+    }
+    for (ur_exp_command_buffer_sync_point_t Dep : Command.Deps) {
+      WaitList.push_back(Events[Dep]);
+    }
+
+    const uint32_t NumEvents = static_cast<uint32_t>(WaitList.size());
+    const ur_event_handle_t *WaitEvents = WaitList.empty() ? nullptr
+                                                        : WaitList.data();
+    ur_event_handle_t *Event =
+        Command.HasDependents || IsSink ? &Events[I] : nullptr;
+    Result = Command.Enqueue
+                 ? Command.Enqueue(hQueue, NumEvents, WaitEvents, Event)
+                 : urEnqueueEventsWait(hQueue, NumEvents, WaitEvents, Event);
+    if (Result == UR_RESULT_SUCCESS && IsSink) {
+      Sinks.push_back(I);
+    }
+  }
+
+  if (Result == UR_RESULT_SUCCESS && phEvent) {
+    if (Sinks.size() == 1) {
+      *phEvent = Events[Sinks[0]];
+      Events[Sinks[0]] = nullptr;
+    } else {
+      WaitList.clear();
+      for (size_t Sink : Sinks) {
+        WaitList.push_back(Events[Sink]);
+      }
+      Result = urEnqueueEventsWait(hQueue,
+                                   static_cast<uint32_t>(WaitList.size()),
+                                   WaitList.data(), phEvent);
+    }
+  }
+
+  for (ur_event_handle_t Event : Events) {
+    if (Event) {
+      clReleaseEvent(cl_adapter::cast<cl_event>(Event));
+    }
+  }
+  return Result;
+}
+} // end anonymous namespace
+
 UR_APIEXPORT ur_result_t UR_APICALL urCommandBufferCreateExp(
     ur_context_handle_t hContext, ur_device_handle_t hDevice,
     const ur_exp_command_buffer_desc_t *pCommandBufferDesc,
     ur_exp_command_buffer_handle_t *phCommandBuffer) {
 
+  const bool IsUpdatable =
+      pCommandBufferDesc ? pCommandBufferDesc->isUpdatable : false;
+
+  if (hasSoftwareCommandBuffers(hDevice)) {
+    try {
+      auto URCommandBuffer = std::make_unique<ur_exp_command_buffer_handle_t_>(
+          nullptr, hContext, hDevice, nullptr, IsUpdatable);
+      *phCommandBuffer = URCommandBuffer.release();
+    } catch (...) {
+      return UR_RESULT_ERROR_OUT_OF_RESOURCES;
+    }
+    return UR_RESULT_SUCCESS;
+  }
+
   ur_queue_handle_t Queue = nullptr;
   UR_RETURN_ON_FAILURE(urQueueCreate(hContext, hDevice, nullptr, &Queue));
 
-  cl_context CLContext = cl_adapter::cast<cl_context>(hContext);
-  cl_ext::clCreateCommandBufferKHR_fn clCreateCommandBufferKHR = nullptr;
-  UR_RETURN_ON_FAILURE(
-      cl_ext::getExtFuncFromContext<decltype(clCreateCommandBufferKHR)>(
-          CLContext, cl_ext::ExtFuncPtrCache->clCreateCommandBufferKHRCache,
-          cl_ext::CreateCommandBufferName, &clCreateCommandBufferKHR));
-
-  const bool IsUpdatable =
-      pCommandBufferDesc ? pCommandBufferDesc->isUpdatable : false;
+  cl_ext::clCreateCommandBufferKHR_fn clCreateCommandBufferKHR =
+      hContext->ExtFuncs.clCreateCommandBufferKHR;
+  if (!clCreateCommandBufferKHR) {
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  }
 
   ur_device_command_buffer_update_capability_flags_t UpdateCapabilities;
-  cl_device_id CLDevice = cl_adapter::cast<cl_device_id>(hDevice);
   CL_RETURN_ON_FAILURE(
-      getDeviceCommandBufferUpdateCapabilities(CLDevice, UpdateCapabilities));
+      getDeviceCommandBufferUpdateCapabilities(hDevice, UpdateCapabilities));
   bool DeviceSupportsUpdate = UpdateCapabilities > 0;
 
   if (IsUpdatable && !DeviceSupportsUpdate) {
@@ -61,8 +295,8 @@ UR_APIEXPORT ur_result_t UR_APICALL urCommandBufferCreateExp(
       IsUpdatable ? CL_COMMAND_BUFFER_MUTABLE_KHR : 0u, 0};
 
   cl_int Res = CL_SUCCESS;
-  auto CLCommandBuffer = clCreateCommandBufferKHR(
-      1, cl_adapter::cast<cl_command_queue *>(&Queue), Properties, &Res);
+  auto CLCommandBuffer = clCreateCommandBufferKHR(1, &Queue->CLQueue,
+                                                  Properties, &Res);
   CL_RETURN_ON_FAILURE_AND_SET_NULL(Res, phCommandBuffer);
 
   try {
@@ -95,12 +329,23 @@ urCommandBufferReleaseExp(ur_exp_command_buffer_handle_t hCommandBuffer) {
 UR_APIEXPORT ur_result_t UR_APICALL
 urCommandBufferFinalizeExp(ur_exp_command_buffer_handle_t hCommandBuffer) {
   UR_ASSERT(!hCommandBuffer->IsFinalized, UR_RESULT_ERROR_INVALID_OPERATION);
-  cl_context CLContext = cl_adapter::cast<cl_context>(hCommandBuffer->hContext);
-  cl_ext::clFinalizeCommandBufferKHR_fn clFinalizeCommandBufferKHR = nullptr;
-  UR_RETURN_ON_FAILURE(
-      cl_ext::getExtFuncFromContext<decltype(clFinalizeCommandBufferKHR)>(
-          CLContext, cl_ext::ExtFuncPtrCache->clFinalizeCommandBufferKHRCache,
-          cl_ext::FinalizeCommandBufferName, &clFinalizeCommandBufferKHR));
+
+  if (hCommandBuffer->isSoftware()) {
+    std::vector<sw_command_t> &Commands = hCommandBuffer->SWCommands;
+    for (const sw_command_t &Command : Commands) {
+      for (ur_exp_command_buffer_sync_point_t Dep : Command.Deps) {
+        Commands[Dep].HasDependents = true;
+      }
+    }
+    hCommandBuffer->IsFinalized = true;
+    return UR_RESULT_SUCCESS;
+  }
+
+  cl_ext::clFinalizeCommandBufferKHR_fn clFinalizeCommandBufferKHR =
+      hCommandBuffer->hContext->ExtFuncs.clFinalizeCommandBufferKHR;
+  if (!clFinalizeCommandBufferKHR) {
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  }
 
   CL_RETURN_ON_FAILURE(
       clFinalizeCommandBufferKHR(hCommandBuffer->CLCommandBuffer));
@@ -127,12 +372,18 @@ UR_APIEXPORT ur_result_t UR_APICALL urCommandBufferAppendKernelLaunchExp(
   UR_ASSERT(!(phCommandHandle && !hCommandBuffer->IsUpdatable),
             UR_RESULT_ERROR_INVALID_OPERATION);
 
-  cl_context CLContext = cl_adapter::cast<cl_context>(hCommandBuffer->hContext);
-  cl_ext::clCommandNDRangeKernelKHR_fn clCommandNDRangeKernelKHR = nullptr;
-  UR_RETURN_ON_FAILURE(
-      cl_ext::getExtFuncFromContext<decltype(clCommandNDRangeKernelKHR)>(
-          CLContext, cl_ext::ExtFuncPtrCache->clCommandNDRangeKernelKHRCache,
-          cl_ext::CommandNRRangeKernelName, &clCommandNDRangeKernelKHR));
+  if (hCommandBuffer->isSoftware()) {
+    return appendSoftwareKernelLaunch(
+        hCommandBuffer, hKernel, workDim, pGlobalWorkOffset, pGlobalWorkSize,
+        pLocalWorkSize, numSyncPointsInWaitList, pSyncPointWaitList,
+        pSyncPoint, phCommandHandle);
+  }
+
+  cl_ext::clCommandNDRangeKernelKHR_fn clCommandNDRangeKernelKHR =
+      hCommandBuffer->hContext->ExtFuncs.clCommandNDRangeKernelKHR;
+  if (!clCommandNDRangeKernelKHR) {
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  }
 
   cl_mutable_command_khr CommandHandle = nullptr;
   cl_mutable_command_khr *OutCommandHandle =
@@ -149,10 +400,10 @@ UR_APIEXPORT ur_result_t UR_APICALL urCommandBufferAppendKernelLaunchExp(
   cl_command_properties_khr *Properties =
       hCommandBuffer->IsUpdatable ? UpdateProperties : nullptr;
   CL_RETURN_ON_FAILURE(clCommandNDRangeKernelKHR(
-      hCommandBuffer->CLCommandBuffer, nullptr, Properties,
-      cl_adapter::cast<cl_kernel>(hKernel), workDim, pGlobalWorkOffset,
-      pGlobalWorkSize, pLocalWorkSize, numSyncPointsInWaitList,
-      pSyncPointWaitList, pSyncPoint, OutCommandHandle));
+      hCommandBuffer->CLCommandBuffer, nullptr, Properties, hKernel->CLKernel,
+      workDim, pGlobalWorkOffset, pGlobalWorkSize, pLocalWorkSize,
+      numSyncPointsInWaitList, pSyncPointWaitList, pSyncPoint,
+      OutCommandHandle));
 
   try {
     auto Handle = std::make_unique<ur_exp_command_buffer_command_handle_t_>(
@@ -171,33 +422,72 @@ UR_APIEXPORT ur_result_t UR_APICALL urCommandBufferAppendKernelLaunchExp(
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urCommandBufferAppendUSMMemcpyExp(
-    [[maybe_unused]] ur_exp_command_buffer_handle_t hCommandBuffer,
-    [[maybe_unused]] void *pDst, [[maybe_unused]] const void *pSrc,
-    [[maybe_unused]] size_t size,
-    [[maybe_unused]] uint32_t numSyncPointsInWaitList,
-    [[maybe_unused]] const ur_exp_command_buffer_sync_point_t
-        *pSyncPointWaitList,
+    ur_exp_command_buffer_handle_t hCommandBuffer, void *pDst,
+    const void *pSrc, size_t size, uint32_t numSyncPointsInWaitList,
+    const ur_exp_command_buffer_sync_point_t *pSyncPointWaitList,
     [[maybe_unused]] uint32_t numEventsInWaitList,
     [[maybe_unused]] const ur_event_handle_t *phEventWaitList,
-    [[maybe_unused]] ur_exp_command_buffer_sync_point_t *pSyncPoint,
+    ur_exp_command_buffer_sync_point_t *pSyncPoint,
     [[maybe_unused]] ur_event_handle_t *phEvent,
     [[maybe_unused]] ur_exp_command_buffer_command_handle_t *phCommand) {
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  if (!hCommandBuffer->isSoftware()) {
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  }
+
+  // Copies within a single device context don't need the checks done by
+  // urEnqueueUSMMemcpy, so the extension function is called directly.
+  ur_context_handle_t Context = hCommandBuffer->hContext;
+  clEnqueueMemcpyINTEL_fn USMMemcpy = Context->ExtFuncs.clEnqueueMemcpyINTEL;
+  if (!USMMemcpy) {
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  }
+  if (Context->Devices.size() > 1) {
+    return appendSoftwareCommand(
+        hCommandBuffer, numSyncPointsInWaitList, pSyncPointWaitList,
+        pSyncPoint,
+        [=](ur_queue_handle_t Queue, uint32_t NumEventsInWaitList,
+            const ur_event_handle_t *EventWaitList, ur_event_handle_t *Event) {
+          return urEnqueueUSMMemcpy(Queue, false, pDst, pSrc, size,
+                                    NumEventsInWaitList, EventWaitList, Event);
+        });
+  }
+
+  return appendSoftwareCommand(
+      hCommandBuffer, numSyncPointsInWaitList, pSyncPointWaitList, pSyncPoint,
+      [=](ur_queue_handle_t Queue, uint32_t NumEventsInWaitList,
+          const ur_event_handle_t *EventWaitList, ur_event_handle_t *Event) {
+        CL_RETURN_ON_FAILURE(USMMemcpy(
+            Queue->CLQueue, CL_FALSE, pDst, pSrc, size, NumEventsInWaitList,
+            cl_adapter::cast<const cl_event *>(EventWaitList),
+            cl_adapter::cast<cl_event *>(Event)));
+        return UR_RESULT_SUCCESS;
+      });
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urCommandBufferAppendUSMFillExp(
-    [[maybe_unused]] ur_exp_command_buffer_handle_t hCommandBuffer,
-    [[maybe_unused]] void *pMemory, [[maybe_unused]] const void *pPattern,
-    [[maybe_unused]] size_t patternSize, [[maybe_unused]] size_t size,
-    [[maybe_unused]] uint32_t numSyncPointsInWaitList,
-    [[maybe_unused]] const ur_exp_command_buffer_sync_point_t
-        *pSyncPointWaitList,
+    ur_exp_command_buffer_handle_t hCommandBuffer, void *pMemory,
+    const void *pPattern, size_t patternSize, size_t size,
+    uint32_t numSyncPointsInWaitList,
+    const ur_exp_command_buffer_sync_point_t *pSyncPointWaitList,
     [[maybe_unused]] uint32_t numEventsInWaitList,
     [[maybe_unused]] const ur_event_handle_t *phEventWaitList,
-    [[maybe_unused]] ur_exp_command_buffer_sync_point_t *pSyncPoint,
+    ur_exp_command_buffer_sync_point_t *pSyncPoint,
     [[maybe_unused]] ur_event_handle_t *phEvent,
     [[maybe_unused]] ur_exp_command_buffer_command_handle_t *phCommand) {
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  if (!hCommandBuffer->isSoftware()) {
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  }
+
+  const auto *PatternBytes = static_cast<const uint8_t *>(pPattern);
+  std::vector<uint8_t> Pattern(PatternBytes, PatternBytes + patternSize);
+  return appendSoftwareCommand(
+      hCommandBuffer, numSyncPointsInWaitList, pSyncPointWaitList, pSyncPoint,
+      [=](ur_queue_handle_t Queue, uint32_t NumEventsInWaitList,
+          const ur_event_handle_t *EventWaitList, ur_event_handle_t *Event) {
+        return urEnqueueUSMFill(Queue, pMemory, Pattern.size(), Pattern.data(),
+                                size, NumEventsInWaitList, EventWaitList,
+                                Event);
+      });
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urCommandBufferAppendMemBufferCopyExp(
@@ -212,12 +502,23 @@ UR_APIEXPORT ur_result_t UR_APICALL urCommandBufferAppendMemBufferCopyExp(
   (void)phEventWaitList;
   (void)phEvent;
   (void)phCommand;
-  cl_context CLContext = cl_adapter::cast<cl_context>(hCommandBuffer->hContext);
-  cl_ext::clCommandCopyBufferKHR_fn clCommandCopyBufferKHR = nullptr;
-  UR_RETURN_ON_FAILURE(
-      cl_ext::getExtFuncFromContext<decltype(clCommandCopyBufferKHR)>(
-          CLContext, cl_ext::ExtFuncPtrCache->clCommandCopyBufferKHRCache,
-          cl_ext::CommandCopyBufferName, &clCommandCopyBufferKHR));
+  if (hCommandBuffer->isSoftware()) {
+    return appendSoftwareCommand(
+        hCommandBuffer, numSyncPointsInWaitList, pSyncPointWaitList,
+        pSyncPoint,
+        [=](ur_queue_handle_t Queue, uint32_t NumEventsInWaitList,
+            const ur_event_handle_t *EventWaitList, ur_event_handle_t *Event) {
+          return urEnqueueMemBufferCopy(Queue, hSrcMem, hDstMem, srcOffset,
+                                        dstOffset, size, NumEventsInWaitList,
+                                        EventWaitList, Event);
+        });
+  }
+
+  cl_ext::clCommandCopyBufferKHR_fn clCommandCopyBufferKHR =
+      hCommandBuffer->hContext->ExtFuncs.clCommandCopyBufferKHR;
+  if (!clCommandCopyBufferKHR) {
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  }
 
   CL_RETURN_ON_FAILURE(clCommandCopyBufferKHR(
       hCommandBuffer->CLCommandBuffer, nullptr, nullptr,
@@ -245,17 +546,28 @@ UR_APIEXPORT ur_result_t UR_APICALL urCommandBufferAppendMemBufferCopyRectExp(
     [[maybe_unused]] ur_exp_command_buffer_sync_point_t *pSyncPoint,
     [[maybe_unused]] ur_event_handle_t *phEvent,
     [[maybe_unused]] ur_exp_command_buffer_command_handle_t *phCommand) {
+  if (hCommandBuffer->isSoftware()) {
+    return appendSoftwareCommand(
+        hCommandBuffer, numSyncPointsInWaitList, pSyncPointWaitList,
+        pSyncPoint,
+        [=](ur_queue_handle_t Queue, uint32_t NumEventsInWaitList,
+            const ur_event_handle_t *EventWaitList, ur_event_handle_t *Event) {
+          return urEnqueueMemBufferCopyRect(
+              Queue, hSrcMem, hDstMem, srcOrigin, dstOrigin, region,
+              srcRowPitch, srcSlicePitch, dstRowPitch, dstSlicePitch,
+              NumEventsInWaitList, EventWaitList, Event);
+        });
+  }
 
   size_t OpenCLOriginRect[3]{srcOrigin.x, srcOrigin.y, srcOrigin.z};
   size_t OpenCLDstRect[3]{dstOrigin.x, dstOrigin.y, dstOrigin.z};
   size_t OpenCLRegion[3]{region.width, region.height, region.depth};
 
-  cl_context CLContext = cl_adapter::cast<cl_context>(hCommandBuffer->hContext);
-  cl_ext::clCommandCopyBufferRectKHR_fn clCommandCopyBufferRectKHR = nullptr;
-  UR_RETURN_ON_FAILURE(
-      cl_ext::getExtFuncFromContext<decltype(clCommandCopyBufferRectKHR)>(
-          CLContext, cl_ext::ExtFuncPtrCache->clCommandCopyBufferRectKHRCache,
-          cl_ext::CommandCopyBufferRectName, &clCommandCopyBufferRectKHR));
+  cl_ext::clCommandCopyBufferRectKHR_fn clCommandCopyBufferRectKHR =
+      hCommandBuffer->hContext->ExtFuncs.clCommandCopyBufferRectKHR;
+  if (!clCommandCopyBufferRectKHR) {
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  }
 
   CL_RETURN_ON_FAILURE(clCommandCopyBufferRectKHR(
       hCommandBuffer->CLCommandBuffer, nullptr, nullptr,
@@ -269,78 +581,108 @@ UR_APIEXPORT ur_result_t UR_APICALL urCommandBufferAppendMemBufferCopyRectExp(
 
 UR_APIEXPORT
 ur_result_t UR_APICALL urCommandBufferAppendMemBufferWriteExp(
-    [[maybe_unused]] ur_exp_command_buffer_handle_t hCommandBuffer,
-    [[maybe_unused]] ur_mem_handle_t hBuffer, [[maybe_unused]] size_t offset,
-    [[maybe_unused]] size_t size, [[maybe_unused]] const void *pSrc,
-    [[maybe_unused]] uint32_t numSyncPointsInWaitList,
-    [[maybe_unused]] const ur_exp_command_buffer_sync_point_t
-        *pSyncPointWaitList,
+    ur_exp_command_buffer_handle_t hCommandBuffer, ur_mem_handle_t hBuffer,
+    size_t offset, size_t size, const void *pSrc,
+    uint32_t numSyncPointsInWaitList,
+    const ur_exp_command_buffer_sync_point_t *pSyncPointWaitList,
     [[maybe_unused]] uint32_t numEventsInWaitList,
     [[maybe_unused]] const ur_event_handle_t *phEventWaitList,
-    [[maybe_unused]] ur_exp_command_buffer_sync_point_t *pSyncPoint,
+    ur_exp_command_buffer_sync_point_t *pSyncPoint,
     [[maybe_unused]] ur_event_handle_t *phEvent,
     [[maybe_unused]] ur_exp_command_buffer_command_handle_t *phCommand) {
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  if (!hCommandBuffer->isSoftware()) {
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  }
+
+  return appendSoftwareCommand(
+      hCommandBuffer, numSyncPointsInWaitList, pSyncPointWaitList, pSyncPoint,
+      [=](ur_queue_handle_t Queue, uint32_t NumEventsInWaitList,
+          const ur_event_handle_t *EventWaitList, ur_event_handle_t *Event) {
+        return urEnqueueMemBufferWrite(Queue, hBuffer, false, offset, size,
+                                       pSrc, NumEventsInWaitList,
+                                       EventWaitList, Event);
+      });
 }
 
 UR_APIEXPORT
 ur_result_t UR_APICALL urCommandBufferAppendMemBufferReadExp(
-    [[maybe_unused]] ur_exp_command_buffer_handle_t hCommandBuffer,
-    [[maybe_unused]] ur_mem_handle_t hBuffer, [[maybe_unused]] size_t offset,
-    [[maybe_unused]] size_t size, [[maybe_unused]] void *pDst,
-    [[maybe_unused]] uint32_t numSyncPointsInWaitList,
-    [[maybe_unused]] const ur_exp_command_buffer_sync_point_t
-        *pSyncPointWaitList,
+    ur_exp_command_buffer_handle_t hCommandBuffer, ur_mem_handle_t hBuffer,
+    size_t offset, size_t size, void *pDst,
+    uint32_t numSyncPointsInWaitList,
+    const ur_exp_command_buffer_sync_point_t *pSyncPointWaitList,
     [[maybe_unused]] uint32_t numEventsInWaitList,
     [[maybe_unused]] const ur_event_handle_t *phEventWaitList,
-    [[maybe_unused]] ur_exp_command_buffer_sync_point_t *pSyncPoint,
+    ur_exp_command_buffer_sync_point_t *pSyncPoint,
     [[maybe_unused]] ur_event_handle_t *phEvent,
     [[maybe_unused]] ur_exp_command_buffer_command_handle_t *phCommand) {
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  if (!hCommandBuffer->isSoftware()) {
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  }
+
+  return appendSoftwareCommand(
+      hCommandBuffer, numSyncPointsInWaitList, pSyncPointWaitList, pSyncPoint,
+      [=](ur_queue_handle_t Queue, uint32_t NumEventsInWaitList,
+          const ur_event_handle_t *EventWaitList, ur_event_handle_t *Event) {
+        return urEnqueueMemBufferRead(Queue, hBuffer, false, offset, size,
+                                      pDst, NumEventsInWaitList, EventWaitList,
+                                      Event);
+      });
 }
 
 UR_APIEXPORT
 ur_result_t UR_APICALL urCommandBufferAppendMemBufferWriteRectExp(
-    [[maybe_unused]] ur_exp_command_buffer_handle_t hCommandBuffer,
-    [[maybe_unused]] ur_mem_handle_t hBuffer,
-    [[maybe_unused]] ur_rect_offset_t bufferOffset,
-    [[maybe_unused]] ur_rect_offset_t hostOffset,
-    [[maybe_unused]] ur_rect_region_t region,
-    [[maybe_unused]] size_t bufferRowPitch,
-    [[maybe_unused]] size_t bufferSlicePitch,
-    [[maybe_unused]] size_t hostRowPitch,
-    [[maybe_unused]] size_t hostSlicePitch, [[maybe_unused]] void *pSrc,
-    [[maybe_unused]] uint32_t numSyncPointsInWaitList,
-    [[maybe_unused]] const ur_exp_command_buffer_sync_point_t
-        *pSyncPointWaitList,
+    ur_exp_command_buffer_handle_t hCommandBuffer, ur_mem_handle_t hBuffer,
+    ur_rect_offset_t bufferOffset, ur_rect_offset_t hostOffset,
+    ur_rect_region_t region, size_t bufferRowPitch, size_t bufferSlicePitch,
+    size_t hostRowPitch, size_t hostSlicePitch, void *pSrc,
+    uint32_t numSyncPointsInWaitList,
+    const ur_exp_command_buffer_sync_point_t *pSyncPointWaitList,
     [[maybe_unused]] uint32_t numEventsInWaitList,
     [[maybe_unused]] const ur_event_handle_t *phEventWaitList,
-    [[maybe_unused]] ur_exp_command_buffer_sync_point_t *pSyncPoint,
+    ur_exp_command_buffer_sync_point_t *pSyncPoint,
     [[maybe_unused]] ur_event_handle_t *phEvent,
     [[maybe_unused]] ur_exp_command_buffer_command_handle_t *phCommand) {
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  if (!hCommandBuffer->isSoftware()) {
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  }
+
+  return appendSoftwareCommand(
+      hCommandBuffer, numSyncPointsInWaitList, pSyncPointWaitList, pSyncPoint,
+      [=](ur_queue_handle_t Queue, uint32_t NumEventsInWaitList,
+          const ur_event_handle_t *EventWaitList, ur_event_handle_t *Event) {
+        return urEnqueueMemBufferWriteRect(
+            Queue, hBuffer, false, bufferOffset, hostOffset, region,
+            bufferRowPitch, bufferSlicePitch, hostRowPitch, hostSlicePitch,
+            pSrc, NumEventsInWaitList, EventWaitList, Event);
+      });
 }
 
 UR_APIEXPORT
 ur_result_t UR_APICALL urCommandBufferAppendMemBufferReadRectExp(
-    [[maybe_unused]] ur_exp_command_buffer_handle_t hCommandBuffer,
-    [[maybe_unused]] ur_mem_handle_t hBuffer,
-    [[maybe_unused]] ur_rect_offset_t bufferOffset,
-    [[maybe_unused]] ur_rect_offset_t hostOffset,
-    [[maybe_unused]] ur_rect_region_t region,
-    [[maybe_unused]] size_t bufferRowPitch,
-    [[maybe_unused]] size_t bufferSlicePitch,
-    [[maybe_unused]] size_t hostRowPitch,
-    [[maybe_unused]] size_t hostSlicePitch, [[maybe_unused]] void *pDst,
-    [[maybe_unused]] uint32_t numSyncPointsInWaitList,
-    [[maybe_unused]] const ur_exp_command_buffer_sync_point_t
-        *pSyncPointWaitList,
+    ur_exp_command_buffer_handle_t hCommandBuffer, ur_mem_handle_t hBuffer,
+    ur_rect_offset_t bufferOffset, ur_rect_offset_t hostOffset,
+    ur_rect_region_t region, size_t bufferRowPitch, size_t bufferSlicePitch,
+    size_t hostRowPitch, size_t hostSlicePitch, void *pDst,
+    uint32_t numSyncPointsInWaitList,
+    const ur_exp_command_buffer_sync_point_t *pSyncPointWaitList,
     [[maybe_unused]] uint32_t numEventsInWaitList,
     [[maybe_unused]] const ur_event_handle_t *phEventWaitList,
-    [[maybe_unused]] ur_exp_command_buffer_sync_point_t *pSyncPoint,
+    ur_exp_command_buffer_sync_point_t *pSyncPoint,
     [[maybe_unused]] ur_event_handle_t *phEvent,
     [[maybe_unused]] ur_exp_command_buffer_command_handle_t *phCommand) {
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  if (!hCommandBuffer->isSoftware()) {
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  }
+
+  return appendSoftwareCommand(
+      hCommandBuffer, numSyncPointsInWaitList, pSyncPointWaitList, pSyncPoint,
+      [=](ur_queue_handle_t Queue, uint32_t NumEventsInWaitList,
+          const ur_event_handle_t *EventWaitList, ur_event_handle_t *Event) {
+        return urEnqueueMemBufferReadRect(
+            Queue, hBuffer, false, bufferOffset, hostOffset, region,
+            bufferRowPitch, bufferSlicePitch, hostRowPitch, hostSlicePitch,
+            pDst, NumEventsInWaitList, EventWaitList, Event);
+      });
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urCommandBufferAppendMemBufferFillExp(
@@ -353,13 +695,26 @@ UR_APIEXPORT ur_result_t UR_APICALL urCommandBufferAppendMemBufferFillExp(
     ur_exp_command_buffer_sync_point_t *pSyncPoint,
     [[maybe_unused]] ur_event_handle_t *phEvent,
     [[maybe_unused]] ur_exp_command_buffer_command_handle_t *phCommand) {
+  if (hCommandBuffer->isSoftware()) {
+    const auto *PatternBytes = static_cast<const uint8_t *>(pPattern);
+    std::vector<uint8_t> Pattern(PatternBytes, PatternBytes + patternSize);
+    return appendSoftwareCommand(
+        hCommandBuffer, numSyncPointsInWaitList, pSyncPointWaitList,
+        pSyncPoint,
+        [=](ur_queue_handle_t Queue, uint32_t NumEventsInWaitList,
+            const ur_event_handle_t *EventWaitList, ur_event_handle_t *Event) {
+          return urEnqueueMemBufferFill(Queue, hBuffer, Pattern.data(),
+                                        Pattern.size(), offset, size,
+                                        NumEventsInWaitList, EventWaitList,
+                                        Event);
+        });
+  }
 
-  cl_context CLContext = cl_adapter::cast<cl_context>(hCommandBuffer->hContext);
-  cl_ext::clCommandFillBufferKHR_fn clCommandFillBufferKHR = nullptr;
-  UR_RETURN_ON_FAILURE(
-      cl_ext::getExtFuncFromContext<decltype(clCommandFillBufferKHR)>(
-          CLContext, cl_ext::ExtFuncPtrCache->clCommandFillBufferKHRCache,
-          cl_ext::CommandFillBufferName, &clCommandFillBufferKHR));
+  cl_ext::clCommandFillBufferKHR_fn clCommandFillBufferKHR =
+      hCommandBuffer->hContext->ExtFuncs.clCommandFillBufferKHR;
+  if (!clCommandFillBufferKHR) {
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  }
 
   CL_RETURN_ON_FAILURE(clCommandFillBufferKHR(
       hCommandBuffer->CLCommandBuffer, nullptr, nullptr,
@@ -376,20 +731,21 @@ UR_APIEXPORT ur_result_t UR_APICALL urCommandBufferAppendUSMPrefetchExp(
     uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
     ur_exp_command_buffer_sync_point_t *pSyncPoint, ur_event_handle_t *phEvent,
     ur_exp_command_buffer_command_handle_t *phCommand) {
-  (void)hCommandBuffer;
   (void)mem;
   (void)size;
   (void)flags;
-  (void)numSyncPointsInWaitList;
-  (void)pSyncPointWaitList;
   (void)numEventsInWaitList;
   (void)phEventWaitList;
-  (void)pSyncPoint;
   (void)phEvent;
   (void)phCommand;
 
-  // Not implemented
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  // Prefetches are markers in this adapter, so emulated command-buffers record
+  // them as no-ops which only take part in the ordering of commands.
+  if (!hCommandBuffer->isSoftware()) {
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  }
+  return appendSoftwareCommand(hCommandBuffer, numSyncPointsInWaitList,
+                               pSyncPointWaitList, pSyncPoint, nullptr);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urCommandBufferAppendUSMAdviseExp(
@@ -399,40 +755,43 @@ UR_APIEXPORT ur_result_t UR_APICALL urCommandBufferAppendUSMAdviseExp(
     uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
     ur_exp_command_buffer_sync_point_t *pSyncPoint, ur_event_handle_t *phEvent,
     ur_exp_command_buffer_command_handle_t *phCommand) {
-  (void)hCommandBuffer;
   (void)mem;
   (void)size;
   (void)advice;
-  (void)numSyncPointsInWaitList;
-  (void)pSyncPointWaitList;
   (void)numEventsInWaitList;
   (void)phEventWaitList;
-  (void)pSyncPoint;
   (void)phEvent;
   (void)phCommand;
 
-  // Not implemented
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  // Recorded as a no-op like prefetches, see above.
+  if (!hCommandBuffer->isSoftware()) {
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  }
+  return appendSoftwareCommand(hCommandBuffer, numSyncPointsInWaitList,
+                               pSyncPointWaitList, pSyncPoint, nullptr);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urCommandBufferEnqueueExp(
     ur_exp_command_buffer_handle_t hCommandBuffer, ur_queue_handle_t hQueue,
     uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
     ur_event_handle_t *phEvent) {
+  if (hCommandBuffer->isSoftware()) {
+    return enqueueSoftwareCommandBuffer(hCommandBuffer, hQueue,
+                                        numEventsInWaitList, phEventWaitList,
+                                        phEvent);
+  }
 
-  cl_context CLContext = cl_adapter::cast<cl_context>(hCommandBuffer->hContext);
-  cl_ext::clEnqueueCommandBufferKHR_fn clEnqueueCommandBufferKHR = nullptr;
-  UR_RETURN_ON_FAILURE(
-      cl_ext::getExtFuncFromContext<decltype(clEnqueueCommandBufferKHR)>(
-          CLContext, cl_ext::ExtFuncPtrCache->clEnqueueCommandBufferKHRCache,
-          cl_ext::EnqueueCommandBufferName, &clEnqueueCommandBufferKHR));
+  cl_ext::clEnqueueCommandBufferKHR_fn clEnqueueCommandBufferKHR =
+      hCommandBuffer->hContext->ExtFuncs.clEnqueueCommandBufferKHR;
+  if (!clEnqueueCommandBufferKHR) {
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  }
 
   const uint32_t NumberOfQueues = 1;
 
   CL_RETURN_ON_FAILURE(clEnqueueCommandBufferKHR(
-      NumberOfQueues, cl_adapter::cast<cl_command_queue *>(&hQueue),
-      hCommandBuffer->CLCommandBuffer, numEventsInWaitList,
-      cl_adapter::cast<const cl_event *>(phEventWaitList),
+      NumberOfQueues, &hQueue->CLQueue, hCommandBuffer->CLCommandBuffer,
+      numEventsInWaitList, cl_adapter::cast<const cl_event *>(phEventWaitList),
       cl_adapter::cast<cl_event *>(phEvent)));
 
   return UR_RESULT_SUCCESS;
@@ -513,11 +872,10 @@ ur_result_t validateCommandDesc(
   // Verify that the device supports updating the aspects of the kernel that
   // the user is requesting.
   ur_device_handle_t URDevice = Command->hCommandBuffer->hDevice;
-  cl_device_id CLDevice = cl_adapter::cast<cl_device_id>(URDevice);
 
   ur_device_command_buffer_update_capability_flags_t UpdateCapabilities = 0;
   CL_RETURN_ON_FAILURE(
-      getDeviceCommandBufferUpdateCapabilities(CLDevice, UpdateCapabilities));
+      getDeviceCommandBufferUpdateCapabilities(URDevice, UpdateCapabilities));
 
   size_t *NewGlobalWorkOffset = UpdateDesc->pNewGlobalWorkOffset;
   UR_ASSERT(
@@ -554,6 +912,72 @@ ur_result_t validateCommandDesc(
 
   return UR_RESULT_SUCCESS;
 }
+
+/// Updates a kernel command of an emulated command-buffer. The new arguments
+/// are set on the command's kernel clone, which OpenCL snapshots on every
+/// replay, so earlier replays that are still pending are unaffected.
+ur_result_t updateSoftwareKernelLaunch(
+    ur_exp_command_buffer_command_handle_t hCommand,
+    const ur_exp_command_buffer_update_kernel_launch_desc_t *UpdateDesc) {
+  cl_kernel Kernel = hCommand->SWKernel;
+
+  if (UpdateDesc->numNewPointerArgs) {
+    clSetKernelArgMemPointerINTEL_fn SetKernelArgMemPointer =
+        hCommand->hCommandBuffer->hContext->ExtFuncs
+            .clSetKernelArgMemPointerINTEL;
+    if (!SetKernelArgMemPointer) {
+      return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+    }
+    for (uint32_t i = 0; i < UpdateDesc->numNewPointerArgs; i++) {
+      const ur_exp_command_buffer_update_pointer_arg_desc_t &URPointerArg =
+          UpdateDesc->pNewPointerArgList[i];
+      CL_RETURN_ON_FAILURE(SetKernelArgMemPointer(
+          Kernel, URPointerArg.argIndex,
+          *static_cast<void *const *>(URPointerArg.pNewPointerArg)));
+    }
+  }
+
+  for (uint32_t i = 0; i < UpdateDesc->numNewMemObjArgs; i++) {
+    const ur_exp_command_buffer_update_memobj_arg_desc_t &URMemObjArg =
+        UpdateDesc->pNewMemObjArgList[i];
+    CL_RETURN_ON_FAILURE(clSetKernelArg(
+        Kernel, URMemObjArg.argIndex, sizeof(cl_mem),
+        cl_adapter::cast<const cl_mem *>(&URMemObjArg.hNewMemObjArg)));
+  }
+
+  for (uint32_t i = 0; i < UpdateDesc->numNewValueArgs; i++) {
+    const ur_exp_command_buffer_update_value_arg_desc_t &URValueArg =
+        UpdateDesc->pNewValueArgList[i];
+    CL_RETURN_ON_FAILURE(clSetKernelArg(Kernel, URValueArg.argIndex,
+                                        URValueArg.argSize,
+                                        URValueArg.pNewValueArg));
+  }
+
+  const cl_uint WorkDim = UpdateDesc->newWorkDim;
+  auto updateNDRange = [WorkDim](std::array<size_t, 3> &NDRange,
+                                 const size_t *UpdatePtr) {
+    NDRange = {0, 0, 0};
+    std::copy_n(UpdatePtr, WorkDim, NDRange.begin());
+  };
+
+  if (UpdateDesc->pNewGlobalWorkOffset) {
+    updateNDRange(hCommand->GlobalWorkOffset,
+                  UpdateDesc->pNewGlobalWorkOffset);
+  }
+  if (UpdateDesc->pNewGlobalWorkSize) {
+    updateNDRange(hCommand->GlobalWorkSize, UpdateDesc->pNewGlobalWorkSize);
+  }
+  if (UpdateDesc->pNewLocalWorkSize) {
+    updateNDRange(hCommand->LocalWorkSize, UpdateDesc->pNewLocalWorkSize);
+  } else if (UpdateDesc->pNewGlobalWorkSize) {
+    // A new global size without a local size resets the local size to the
+    // one the kernel was compiled with, if any.
+    hCommand->LocalWorkSize = hCommand->CompileWorkGroupSize;
+  }
+  hCommand->WorkDim = WorkDim;
+
+  return UR_RESULT_SUCCESS;
+}
 } // end anonymous namespace
 
 UR_APIEXPORT ur_result_t UR_APICALL urCommandBufferUpdateKernelLaunchExp(
@@ -564,13 +988,17 @@ UR_APIEXPORT ur_result_t UR_APICALL urCommandBufferUpdateKernelLaunchExp(
   UR_RETURN_ON_FAILURE(validateCommandDesc(hCommand, pUpdateKernelLaunch));
 
   ur_exp_command_buffer_handle_t hCommandBuffer = hCommand->hCommandBuffer;
-  cl_context CLContext = cl_adapter::cast<cl_context>(hCommandBuffer->hContext);
+  if (hCommandBuffer->isSoftware()) {
+    if (!hCommandBuffer->IsFinalized || !hCommandBuffer->IsUpdatable)
+      return UR_RESULT_ERROR_INVALID_OPERATION;
+    return updateSoftwareKernelLaunch(hCommand, pUpdateKernelLaunch);
+  }
 
-  cl_ext::clUpdateMutableCommandsKHR_fn clUpdateMutableCommandsKHR = nullptr;
-  UR_RETURN_ON_FAILURE(
-      cl_ext::getExtFuncFromContext<decltype(clUpdateMutableCommandsKHR)>(
-          CLContext, cl_ext::ExtFuncPtrCache->clUpdateMutableCommandsKHRCache,
-          cl_ext::UpdateMutableCommandsName, &clUpdateMutableCommandsKHR));
+  cl_ext::clUpdateMutableCommandsKHR_fn clUpdateMutableCommandsKHR =
+      hCommandBuffer->hContext->ExtFuncs.clUpdateMutableCommandsKHR;
+  if (!clUpdateMutableCommandsKHR) {
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  }
 
   if (!hCommandBuffer->IsFinalized || !hCommandBuffer->IsUpdatable)
     return UR_RESULT_ERROR_INVALID_OPERATION;
@@ -11,18 +11,48 @@
 #include <CL/cl_ext.h>
 #include <ur/ur.hpp>
 
+#include <array>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/// Command of a command-buffer emulated by the adapter, for devices without
+/// cl_khr_command_buffer. Its sync-point is its index in the command-buffer.
+struct sw_command_t {
+  /// Enqueues the command on a queue, waiting for the given events.
+  using enqueue_t = std::function<ur_result_t(
+      ur_queue_handle_t Queue, uint32_t NumEventsInWaitList,
+      const ur_event_handle_t *EventWaitList, ur_event_handle_t *Event)>;
+
+  enqueue_t Enqueue;
+  /// Sync-points of the commands this command depends on.
+  std::vector<ur_exp_command_buffer_sync_point_t> Deps;
+  /// Set on finalization if a later command depends on this one.
+  bool HasDependents = false;
+};
+
 /// Handle to a kernel command.
 struct ur_exp_command_buffer_command_handle_t_ {
   /// Command-buffer this command belongs to.
   ur_exp_command_buffer_handle_t hCommandBuffer;
   /// OpenCL command-handle.
   cl_mutable_command_khr CLMutableCommand;
-  /// Kernel associated with this command handle
+  /// Kernel associated with this command handle. Emulated commands don't
+  /// retain it, so it must not be dereferenced once the command is appended.
   ur_kernel_handle_t Kernel;
   /// Work-dimension the command was originally created with.
   cl_uint WorkDim;
   /// Set to true if the user set the local work size on command creation.
   bool UserDefinedLocalSize;
+  /// Clone of Kernel holding the arguments of the command, only used by
+  /// emulated command-buffers.
+  cl_kernel SWKernel = nullptr;
+  /// ND-range of the command in emulated command-buffers. A zero local size
+  /// lets the implementation choose it.
+  std::array<size_t, 3> GlobalWorkOffset{}, GlobalWorkSize{}, LocalWorkSize{};
+  /// Work-group size the kernel was compiled with, zero if it has none, used
+  /// by updates that reset the local size in emulated command-buffers.
+  std::array<size_t, 3> CompileWorkGroupSize{};
 
   ur_exp_command_buffer_command_handle_t_(
       ur_exp_command_buffer_handle_t hCommandBuffer,
@@ -31,17 +61,21 @@ struct ur_exp_command_buffer_command_handle_t_ {
       : hCommandBuffer(hCommandBuffer), CLMutableCommand(CLMutableCommand),
         Kernel(Kernel), WorkDim(WorkDim),
         UserDefinedLocalSize(UserDefinedLocalSize) {}
+
+  ~ur_exp_command_buffer_command_handle_t_();
 };
 
 /// Handle to a command-buffer object.
 struct ur_exp_command_buffer_handle_t_ {
   /// UR queue belonging to the command-buffer, required for OpenCL creation.
+  /// Null for emulated command-buffers.
   ur_queue_handle_t hInternalQueue;
   /// Context the command-buffer is created for.
   ur_context_handle_t hContext;
   /// Device the command-buffer is created for.
   ur_device_handle_t hDevice;
-  /// OpenCL command-buffer object.
+  /// OpenCL command-buffer object, null if the command-buffer is emulated by
+  /// the adapter.
   cl_command_buffer_khr CLCommandBuffer;
   /// Set to true if the kernel commands in the command-buffer can be updated,
   /// false otherwise
@@ -51,6 +85,8 @@ struct ur_exp_command_buffer_handle_t_ {
   /// List of commands in the command-buffer.
   std::vector<std::unique_ptr<ur_exp_command_buffer_command_handle_t_>>
       CommandHandles;
+  /// Commands of an emulated command-buffer, in the order they were appended.
+  std::vector<sw_command_t> SWCommands;
   /// Object reference count
   std::atomic_uint32_t RefCount;
 
@@ -65,6 +101,8 @@ struct ur_exp_command_buffer_handle_t_ {
 
   ~ur_exp_command_buffer_handle_t_();
 
+  bool isSoftware() const noexcept { return CLCommandBuffer == nullptr; }
+
   uint32_t incrementReferenceCount() noexcept { return ++RefCount; }
   uint32_t decrementReferenceCount() noexcept { return --RefCount; }
   uint32_t getReferenceCount() const noexcept { return RefCount; }
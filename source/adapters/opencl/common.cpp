@@ -9,6 +9,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "common.hpp"
+#include "device.hpp"
 #include "logger/ur_logger.hpp"
 namespace cl_adapter {
 
@@ -121,29 +122,44 @@ ur_result_t getNativeHandle(void *URObj, ur_native_handle_t *NativeHandle) {
   return UR_RESULT_SUCCESS;
 }
 
+void cl_ext::loadExtFuncs(cl_platform_id Platform, ExtFuncPtrT &ExtFuncs) {
+#define CL_EXTENSION_FUNC(func, name)                                          \
+  ExtFuncs.func = reinterpret_cast<func##_fn>(                                 \
+      clGetExtensionFunctionAddressForPlatform(Platform, name));
+
+#include "extension_functions.def"
+
+#undef CL_EXTENSION_FUNC
+}
+
+bool hasSoftwareCommandBuffers(ur_device_handle_t Dev) {
+  return !Dev->checkExtensions({"cl_khr_command_buffer"}) &&
+         Dev->Version >= oclv::V2_1;
+}
+
 cl_int getDeviceCommandBufferUpdateCapabilities(
-    cl_device_id Dev,
+    ur_device_handle_t Dev,
     ur_device_command_buffer_update_capability_flags_t &UpdateCapabilities) {
 
   UpdateCapabilities = 0;
 
-  size_t ExtSize = 0;
-  CL_RETURN_ON_FAILURE(
-      clGetDeviceInfo(Dev, CL_DEVICE_EXTENSIONS, 0, nullptr, &ExtSize));
-
-  std::string ExtStr(ExtSize, '\0');
-  CL_RETURN_ON_FAILURE(clGetDeviceInfo(Dev, CL_DEVICE_EXTENSIONS, ExtSize,
-                                       ExtStr.data(), nullptr));
+  // Emulated command-buffers update their commands' kernel clones directly.
+  if (hasSoftwareCommandBuffers(Dev)) {
+    UpdateCapabilities =
+        UR_DEVICE_COMMAND_BUFFER_UPDATE_CAPABILITY_FLAG_KERNEL_ARGUMENTS |
+        UR_DEVICE_COMMAND_BUFFER_UPDATE_CAPABILITY_FLAG_GLOBAL_WORK_SIZE |
+        UR_DEVICE_COMMAND_BUFFER_UPDATE_CAPABILITY_FLAG_LOCAL_WORK_SIZE |
+        UR_DEVICE_COMMAND_BUFFER_UPDATE_CAPABILITY_FLAG_GLOBAL_WORK_OFFSET;
+    return CL_SUCCESS;
+  }
 
-  std::string SupportedExtensions(ExtStr.c_str());
-  if (ExtStr.find("cl_khr_command_buffer_mutable_dispatch") ==
-      std::string::npos) {
+  if (!Dev->checkExtensions({"cl_khr_command_buffer_mutable_dispatch"})) {
     return CL_SUCCESS;
   }
 
   cl_mutable_dispatch_fields_khr MutableCapabilities;
   CL_RETURN_ON_FAILURE(clGetDeviceInfo(
-      Dev, CL_DEVICE_MUTABLE_DISPATCH_CAPABILITIES_KHR,
+      Dev->CLDevice, CL_DEVICE_MUTABLE_DISPATCH_CAPABILITIES_KHR,
       sizeof(MutableCapabilities), &MutableCapabilities, nullptr));
 
   if (!(MutableCapabilities & CL_MUTABLE_DISPATCH_EXEC_INFO_KHR)) {
@@ -12,6 +12,7 @@
 #include <climits>
 #include <map>
 #include <mutex>
+#include <unordered_map>
 #include <ur/ur.hpp>
 
 /**
@@ -159,7 +160,22 @@ extern thread_local char ErrorMessage[MaxMessageSize];
 
 [[noreturn]] void die(const char *Message);
 
+// Device, context, queue and kernel handles are wrapper objects rather than the
+// OpenCL objects themselves, so they must never be cast.
+template <class T>
+inline constexpr bool is_wrapped_handle_v =
+    std::is_same_v<std::remove_cv_t<std::remove_pointer_t<T>>,
+                   ur_device_handle_t> ||
+    std::is_same_v<std::remove_cv_t<std::remove_pointer_t<T>>,
+                   ur_context_handle_t> ||
+    std::is_same_v<std::remove_cv_t<std::remove_pointer_t<T>>,
+                   ur_queue_handle_t> ||
+    std::is_same_v<std::remove_cv_t<std::remove_pointer_t<T>>,
+                   ur_kernel_handle_t>;
+
 template <class To, class From> To cast(From Value) {
+  static_assert(!is_wrapped_handle_v<From> && !is_wrapped_handle_v<To>,
+                "Cast of a wrapped handle, use its OpenCL object instead");
 
   if constexpr (std::is_pointer_v<From>) {
     static_assert(std::is_pointer_v<From> == std::is_pointer_v<To>,
@@ -172,6 +188,26 @@ template <class To, class From> To cast(From Value) {
     return static_cast<To>(Value);
   }
 }
+
+/// Maps OpenCL objects back to the UR handles wrapping them, for queries that
+/// return OpenCL objects such as CL_MEM_CONTEXT. Registries are only used when
+/// handles are created, looked up from such queries, or destroyed, never on
+/// the enqueue paths.
+template <class CLObject, class Handle> class handle_registry {
+public:
+  /// Returns the handle wrapping Object, or nullptr. Mutex must be held.
+  Handle find(CLObject Object) const {
+    auto It = Handles.find(Object);
+    return It == Handles.end() ? nullptr : It->second;
+  }
+  void insert(CLObject Object, Handle H) { Handles.emplace(Object, H); }
+  void erase(CLObject Object) { Handles.erase(Object); }
+
+  std::mutex Mutex;
+
+private:
+  std::unordered_map<CLObject, Handle> Handles;
+};
 } // namespace cl_adapter
 
 namespace cl_ext {
@@ -220,6 +256,8 @@ CONSTFIX char GetCommandBufferInfoName[] = "clGetCommandBufferInfoKHR";
 CONSTFIX char UpdateMutableCommandsName[] = "clUpdateMutableCommandsKHR";
 CONSTFIX char CreateProgramWithILName[] = "clCreateProgramWithILKHR";
 CONSTFIX char GetKernelSubGroupInfoName[] = "clGetKernelSubGroupInfoKHR";
+CONSTFIX char GetKernelSuggestedLocalWorkSizeName[] =
+    "clGetKernelSuggestedLocalWorkSizeKHR";
 
 #undef CONSTFIX
 
@@ -325,107 +363,29 @@ using clGetKernelSubGroupInfoKHR_fn = CL_API_ENTRY
 cl_int(CL_API_CALL *)(cl_kernel, cl_device_id, cl_kernel_sub_group_info, size_t,
                       const void *, size_t, void *, size_t *);
 
-template <typename T> struct FuncPtrCache {
-  std::map<cl_context, T> Map;
-  std::mutex Mutex;
-
-  void clear(cl_context context) {
-    std::lock_guard<std::mutex> CacheLock{Mutex};
-    Map.erase(context);
-  }
-};
-
-struct ExtFuncPtrCacheT {
-#define CL_EXTENSION_FUNC(func) FuncPtrCache<func##_fn> func##Cache;
-
-#include "extension_functions.def"
-
-#undef CL_EXTENSION_FUNC
-
-  // If a context stored in the current caching mechanism is destroyed by the
-  // CL driver all of its function pointers are invalidated. This can lead to a
-  // pathological case where a subsequently created context gets returned with
-  // a coincidentally identical handle to the destroyed one and ends up being
-  // used to retrieve bad function pointers. To avoid this we clear the cache
-  // when contexts are released.
-  void clearCache(cl_context context) {
-#define CL_EXTENSION_FUNC(func) func##Cache.clear(context);
+// Entry points of the OpenCL extensions used by the adapter. They are resolved
+// once for each context, from the platform of its devices, and are left null
+// when the platform doesn't provide them.
+struct ExtFuncPtrT {
+#define CL_EXTENSION_FUNC(func, name) func##_fn func = nullptr;
 
 #include "extension_functions.def"
 
 #undef CL_EXTENSION_FUNC
-  }
 };
-// A raw pointer is used here since the lifetime of this map has to be tied to
-// piTeardown to avoid issues with static destruction order (a user application
-// might have static objects that indirectly access this cache in their
-// destructor).
-inline ExtFuncPtrCacheT *ExtFuncPtrCache;
-
-// USM helper function to get an extension function pointer
-template <typename T>
-static ur_result_t getExtFuncFromContext(cl_context Context,
-                                         FuncPtrCache<T> &FPtrCache,
-                                         const char *FuncName, T *Fptr) {
-  // TODO
-  // Potentially redo caching as UR interface changes.
-  // if cached, return cached FuncPtr
-  std::lock_guard<std::mutex> CacheLock{FPtrCache.Mutex};
-  std::map<cl_context, T> &FPtrMap = FPtrCache.Map;
-  auto It = FPtrMap.find(Context);
-  if (It != FPtrMap.end()) {
-    auto F = It->second;
-    // if cached that extension is not available return nullptr and
-    // UR_RESULT_ERROR_UNSUPPORTED_FEATURE
-    *Fptr = F;
-    return F ? UR_RESULT_SUCCESS : UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
-  }
-
-  cl_uint DeviceCount;
-  cl_int RetErr = clGetContextInfo(Context, CL_CONTEXT_NUM_DEVICES,
-                                   sizeof(cl_uint), &DeviceCount, nullptr);
-
-  if (RetErr != CL_SUCCESS || DeviceCount < 1) {
-    return UR_RESULT_ERROR_INVALID_CONTEXT;
-  }
-
-  std::vector<cl_device_id> DevicesInCtx(DeviceCount);
-  RetErr = clGetContextInfo(Context, CL_CONTEXT_DEVICES,
-                            DeviceCount * sizeof(cl_device_id),
-                            DevicesInCtx.data(), nullptr);
-
-  if (RetErr != CL_SUCCESS) {
-    return UR_RESULT_ERROR_INVALID_CONTEXT;
-  }
-
-  cl_platform_id CurPlatform;
-  RetErr = clGetDeviceInfo(DevicesInCtx[0], CL_DEVICE_PLATFORM,
-                           sizeof(cl_platform_id), &CurPlatform, nullptr);
 
-  if (RetErr != CL_SUCCESS) {
-    return UR_RESULT_ERROR_INVALID_CONTEXT;
-  }
-
-  T FuncPtr = reinterpret_cast<T>(
-      clGetExtensionFunctionAddressForPlatform(CurPlatform, FuncName));
-
-  if (!FuncPtr) {
-    // Cache that the extension is not available
-    FPtrMap[Context] = nullptr;
-    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
-  }
-
-  *Fptr = FuncPtr;
-  FPtrMap[Context] = FuncPtr;
-
-  return UR_RESULT_SUCCESS;
-}
+void loadExtFuncs(cl_platform_id Platform, ExtFuncPtrT &ExtFuncs);
 } // namespace cl_ext
 
 ur_result_t mapCLErrorToUR(cl_int Result);
 
 ur_result_t getNativeHandle(void *URObj, ur_native_handle_t *NativeHandle);
 
+/// Returns true if command-buffers on Dev are emulated by the adapter because
+/// it lacks cl_khr_command_buffer. The emulation needs clCloneKernel, i.e.
+/// OpenCL 2.1.
+bool hasSoftwareCommandBuffers(ur_device_handle_t Dev);
+
 cl_int getDeviceCommandBufferUpdateCapabilities(
-    cl_device_id Dev,
+    ur_device_handle_t Dev,
     ur_device_command_buffer_update_capability_flags_t &UpdateCapabilities);
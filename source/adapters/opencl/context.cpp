@@ -10,64 +10,261 @@
 
 #include "context.hpp"
 #include "adapter.hpp"
+#include "queue.hpp"
 
+#include <algorithm>
 #include <mutex>
 #include <set>
 #include <unordered_map>
 
-ur_result_t cl_adapter::getDevicesFromContext(
-    ur_context_handle_t hContext,
-    std::unique_ptr<std::vector<cl_device_id>> &DevicesInCtx) {
+using context_registry_t =
+    cl_adapter::handle_registry<cl_context, ur_context_handle_t>;
 
+static context_registry_t &getContextRegistry() {
+  // Never destroyed, so that handles can be released from static destructors.
+  static context_registry_t *Registry = new context_registry_t;
+  return *Registry;
+}
+
+ur_result_t ur_context_handle_t_::initialize() {
   cl_uint DeviceCount;
-  CL_RETURN_ON_FAILURE(clGetContextInfo(cl_adapter::cast<cl_context>(hContext),
-                                        CL_CONTEXT_NUM_DEVICES, sizeof(cl_uint),
-                                        &DeviceCount, nullptr));
+  CL_RETURN_ON_FAILURE(clGetContextInfo(CLContext, CL_CONTEXT_NUM_DEVICES,
+                                        sizeof(cl_uint), &DeviceCount,
+                                        nullptr));
 
   if (DeviceCount < 1) {
     return UR_RESULT_ERROR_INVALID_CONTEXT;
   }
 
-  DevicesInCtx = std::make_unique<std::vector<cl_device_id>>(DeviceCount);
+  std::vector<cl_device_id> CLDevices(DeviceCount);
+  CL_RETURN_ON_FAILURE(clGetContextInfo(CLContext, CL_CONTEXT_DEVICES,
+                                        DeviceCount * sizeof(cl_device_id),
+                                        CLDevices.data(), nullptr));
 
-  CL_RETURN_ON_FAILURE(clGetContextInfo(
-      cl_adapter::cast<cl_context>(hContext), CL_CONTEXT_DEVICES,
-      DeviceCount * sizeof(cl_device_id), (*DevicesInCtx).data(), nullptr));
+  for (cl_device_id CLDevice : CLDevices) {
+    ur_device_handle_t Device;
+    UR_RETURN_ON_FAILURE(ur_device_handle_t_::get(CLDevice, Device));
+    UR_RETURN_ON_FAILURE(urDeviceRetain(Device));
+    Devices.push_back(Device);
+  }
 
+  cl_ext::loadExtFuncs(Devices[0]->Platform, ExtFuncs);
+
+#ifdef UMF_ENABLE_POOL_TRACKING
+  try {
+    DefaultUSMPool = std::make_unique<ur_usm_pool_handle_t_>(this, nullptr);
+  } catch (ur_result_t Err) {
+    return Err;
+  } catch (umf_result_t Err) {
+    return umf::umf2urResult(Err);
+  } catch (...) {
+    return UR_RESULT_ERROR_UNKNOWN;
+  }
+#endif
   return UR_RESULT_SUCCESS;
 }
 
-UR_APIEXPORT ur_result_t UR_APICALL urContextCreate(
-    uint32_t DeviceCount, const ur_device_handle_t *phDevices,
-    const ur_context_properties_t *, ur_context_handle_t *phContext) {
+// OpenCL C source of the kernels the adapter uses to implement operations that
+// OpenCL has no single command for. Pitches are in elements.
+static const char *HelperProgramSource = R"CLC(
+__kernel void urUSMCopy2D(__global uchar *Dst, ulong DstPitch,
+                          __global const uchar *Src, ulong SrcPitch) {
+  size_t X = get_global_id(0), Y = get_global_id(1);
+  Dst[Y * DstPitch + X] = Src[Y * SrcPitch + X];
+}
 
-  cl_int Ret;
-  *phContext = cl_adapter::cast<ur_context_handle_t>(
-      clCreateContext(nullptr, cl_adapter::cast<cl_uint>(DeviceCount),
-                      cl_adapter::cast<const cl_device_id *>(phDevices),
-                      nullptr, nullptr, cl_adapter::cast<cl_int *>(&Ret)));
+__kernel void urUSMCopy2DVec16(__global uint4 *Dst, ulong DstPitch,
+                               __global const uint4 *Src, ulong SrcPitch) {
+  size_t X = get_global_id(0), Y = get_global_id(1);
+  Dst[Y * DstPitch + X] = Src[Y * SrcPitch + X];
+}
+)CLC";
 
-  return mapCLErrorToUR(Ret);
+ur_context_handle_t_::~ur_context_handle_t_() {
+  reclaimPoolFrees(/*Wait*/ true);
+  for (auto &[Name, Kernel] : HelperKernels) {
+    clReleaseKernel(Kernel);
+  }
+  if (HelperProgram) {
+    clReleaseProgram(HelperProgram);
+  }
 }
 
-static cl_int mapURContextInfoToCL(ur_context_info_t URPropName) {
+void ur_context_handle_t_::addQueue(ur_queue_handle_t Queue) {
+  std::lock_guard<std::mutex> Lock{QueuesMutex};
+  Queues.push_back(Queue);
+}
 
-  cl_int CLPropName;
-  switch (URPropName) {
-  case UR_CONTEXT_INFO_NUM_DEVICES:
-    CLPropName = CL_CONTEXT_NUM_DEVICES;
-    break;
-  case UR_CONTEXT_INFO_DEVICES:
-    CLPropName = CL_CONTEXT_DEVICES;
-    break;
-  case UR_CONTEXT_INFO_REFERENCE_COUNT:
-    CLPropName = CL_CONTEXT_REFERENCE_COUNT;
-    break;
-  default:
-    CLPropName = -1;
+void ur_context_handle_t_::removeQueue(ur_queue_handle_t Queue) {
+  std::lock_guard<std::mutex> Lock{QueuesMutex};
+  Queues.erase(std::remove(Queues.begin(), Queues.end(), Queue), Queues.end());
+}
+
+static void releaseMarkers(const std::vector<cl_event> &Markers) {
+  for (cl_event Marker : Markers) {
+    clReleaseEvent(Marker);
   }
+}
 
-  return CLPropName;
+ur_result_t ur_context_handle_t_::deferPoolFree(umf_memory_pool_handle_t Pool,
+                                                void *Mem) {
+  reclaimPoolFrees(/*Wait*/ false);
+
+  std::vector<cl_event> Markers;
+  {
+    std::lock_guard<std::mutex> Lock{QueuesMutex};
+    for (ur_queue_handle_t Queue : Queues) {
+      // A marker without a wait list completes once all commands enqueued
+      // before it have, also on out-of-order queues. Flush it, so that it
+      // completes without anyone waiting for it.
+      cl_event Marker;
+      cl_int Res =
+          clEnqueueMarkerWithWaitList(Queue->CLQueue, 0, nullptr, &Marker);
+      if (Res == CL_SUCCESS) {
+        Markers.push_back(Marker);
+        Res = clFlush(Queue->CLQueue);
+      }
+      if (Res != CL_SUCCESS) {
+        releaseMarkers(Markers);
+        CL_RETURN_ON_FAILURE(Res);
+      }
+    }
+  }
+
+  if (Markers.empty()) {
+    return umf::umf2urResult(umfPoolFree(Pool, Mem));
+  }
+  std::lock_guard<std::mutex> Lock{PoolFreesMutex};
+  PoolFrees.push_back({Pool, Mem, std::move(Markers)});
+  return UR_RESULT_SUCCESS;
+}
+
+static bool markersComplete(const std::vector<cl_event> &Markers) {
+  for (cl_event Marker : Markers) {
+    cl_int Status = CL_COMPLETE;
+    clGetEventInfo(Marker, CL_EVENT_COMMAND_EXECUTION_STATUS, sizeof(Status),
+                   &Status, nullptr);
+    // Negative values report a failed command, which won't run anymore.
+    if (Status > CL_COMPLETE) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ur_context_handle_t_::reclaimPoolFrees(bool Wait) {
+  std::lock_guard<std::mutex> Lock{PoolFreesMutex};
+  auto Reclaimed = std::remove_if(
+      PoolFrees.begin(), PoolFrees.end(), [Wait](const pool_free &Free) {
+        if (Wait) {
+          clWaitForEvents(Free.Markers.size(), Free.Markers.data());
+        } else if (!markersComplete(Free.Markers)) {
+          return false;
+        }
+        releaseMarkers(Free.Markers);
+        umfPoolFree(Free.Pool, Free.Mem);
+        return true;
+      });
+  PoolFrees.erase(Reclaimed, PoolFrees.end());
+}
+
+ur_result_t ur_context_handle_t_::getHelperKernel(const char *Name,
+                                                  cl_kernel &Kernel) {
+  Kernel = nullptr;
+  if (!HelperProgramBuilt) {
+    // Only attempt the build once, devices without a compiler will keep
+    // failing it.
+    HelperProgramBuilt = true;
+    cl_int Res = CL_SUCCESS;
+    cl_program Program = clCreateProgramWithSource(
+        CLContext, 1, &HelperProgramSource, nullptr, &Res);
+    if (Res != CL_SUCCESS) {
+      return UR_RESULT_SUCCESS;
+    }
+    if (clBuildProgram(Program, 0, nullptr, nullptr, nullptr, nullptr) !=
+        CL_SUCCESS) {
+      clReleaseProgram(Program);
+      return UR_RESULT_SUCCESS;
+    }
+    HelperProgram = Program;
+  }
+  if (!HelperProgram) {
+    return UR_RESULT_SUCCESS;
+  }
+
+  if (auto It = HelperKernels.find(Name); It != HelperKernels.end()) {
+    Kernel = It->second;
+    return UR_RESULT_SUCCESS;
+  }
+  cl_int Res = CL_SUCCESS;
+  cl_kernel NewKernel = clCreateKernel(HelperProgram, Name, &Res);
+  CL_RETURN_ON_FAILURE(Res);
+  Kernel = HelperKernels.emplace(Name, NewKernel).first->second;
+  return UR_RESULT_SUCCESS;
+}
+
+static ur_result_t releaseContextDevices(ur_context_handle_t Context) {
+  for (ur_device_handle_t Device : Context->Devices) {
+    UR_RETURN_ON_FAILURE(urDeviceRelease(Device));
+  }
+  return UR_RESULT_SUCCESS;
+}
+
+ur_result_t ur_context_handle_t_::create(cl_context Ctx,
+                                         ur_context_handle_t &Context) {
+  std::unique_ptr<ur_context_handle_t_> NewContext{
+      new ur_context_handle_t_(Ctx)};
+  if (ur_result_t Result = NewContext->initialize();
+      Result != UR_RESULT_SUCCESS) {
+    releaseContextDevices(NewContext.get());
+    clReleaseContext(Ctx);
+    return Result;
+  }
+
+  Context = NewContext.release();
+  getContextRegistry().insert(Ctx, Context);
+  return UR_RESULT_SUCCESS;
+}
+
+ur_result_t ur_context_handle_t_::make(cl_context Ctx,
+                                       ur_context_handle_t &Context) {
+  context_registry_t &Registry = getContextRegistry();
+  std::lock_guard<std::mutex> Lock{Registry.Mutex};
+  if ((Context = Registry.find(Ctx))) {
+    Context->RefCount++;
+    CL_RETURN_ON_FAILURE(clReleaseContext(Ctx));
+    return UR_RESULT_SUCCESS;
+  }
+  return create(Ctx, Context);
+}
+
+ur_result_t ur_context_handle_t_::get(cl_context Ctx,
+                                      ur_context_handle_t &Context) {
+  context_registry_t &Registry = getContextRegistry();
+  std::lock_guard<std::mutex> Lock{Registry.Mutex};
+  if ((Context = Registry.find(Ctx))) {
+    return UR_RESULT_SUCCESS;
+  }
+  CL_RETURN_ON_FAILURE(clRetainContext(Ctx));
+  return create(Ctx, Context);
+}
+
+UR_APIEXPORT ur_result_t UR_APICALL urContextCreate(
+    uint32_t DeviceCount, const ur_device_handle_t *phDevices,
+    const ur_context_properties_t *, ur_context_handle_t *phContext) {
+
+  std::vector<cl_device_id> CLDevices(DeviceCount);
+  for (uint32_t i = 0; i < DeviceCount; i++) {
+    CLDevices[i] = phDevices[i]->CLDevice;
+  }
+
+  cl_int Ret;
+  cl_context Ctx =
+      clCreateContext(nullptr, cl_adapter::cast<cl_uint>(DeviceCount),
+                      CLDevices.data(), nullptr, nullptr, &Ret);
+  CL_RETURN_ON_FAILURE_AND_SET_NULL(Ret, phContext);
+
+  return ur_context_handle_t_::make(Ctx, *phContext);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL
@@ -75,13 +272,11 @@ urContextGetInfo(ur_context_handle_t hContext, ur_context_info_t propName,
                  size_t propSize, void *pPropValue, size_t *pPropSizeRet) {
 
   UrReturnHelper ReturnValue(propSize, pPropValue, pPropSizeRet);
-  const cl_int CLPropName = mapURContextInfoToCL(propName);
 
   switch (static_cast<uint32_t>(propName)) {
-  /* 2D USM memops are not supported. */
   case UR_CONTEXT_INFO_USM_MEMCPY2D_SUPPORT:
   case UR_CONTEXT_INFO_USM_FILL2D_SUPPORT: {
-    return ReturnValue(false);
+    return ReturnValue(true);
   }
   case UR_CONTEXT_INFO_ATOMIC_MEMORY_ORDER_CAPABILITIES:
   case UR_CONTEXT_INFO_ATOMIC_MEMORY_SCOPE_CAPABILITIES:
@@ -92,21 +287,11 @@ urContextGetInfo(ur_context_handle_t hContext, ur_context_info_t propName,
     return UR_RESULT_ERROR_UNSUPPORTED_ENUMERATION;
   }
   case UR_CONTEXT_INFO_NUM_DEVICES:
+    return ReturnValue(static_cast<uint32_t>(hContext->Devices.size()));
   case UR_CONTEXT_INFO_DEVICES:
-  case UR_CONTEXT_INFO_REFERENCE_COUNT: {
-    size_t CheckPropSize = 0;
-    auto ClResult =
-        clGetContextInfo(cl_adapter::cast<cl_context>(hContext), CLPropName,
-                         propSize, pPropValue, &CheckPropSize);
-    if (pPropValue && CheckPropSize != propSize) {
-      return UR_RESULT_ERROR_INVALID_SIZE;
-    }
-    CL_RETURN_ON_FAILURE(ClResult);
-    if (pPropSizeRet) {
-      *pPropSizeRet = CheckPropSize;
-    }
-    return UR_RESULT_SUCCESS;
-  }
+    return ReturnValue(hContext->Devices.data(), hContext->Devices.size());
+  case UR_CONTEXT_INFO_REFERENCE_COUNT:
+    return ReturnValue(hContext->RefCount.load());
   default:
     return UR_RESULT_ERROR_INVALID_ENUMERATION;
   }
@@ -114,43 +299,33 @@ urContextGetInfo(ur_context_handle_t hContext, ur_context_info_t propName,
 
 UR_APIEXPORT ur_result_t UR_APICALL
 urContextRelease(ur_context_handle_t hContext) {
-  // If we're reasonably sure this context is about to be detroyed we should
-  // clear the ext function pointer cache. This isn't foolproof sadly but it
-  // should drastically reduce the chances of the pathological case described
-  // in the comments in common.hpp.
-  static std::mutex contextReleaseMutex;
-  auto clContext = cl_adapter::cast<cl_context>(hContext);
-
+  cl_context CLContext = hContext->CLContext;
   {
-    std::lock_guard<std::mutex> lock(contextReleaseMutex);
-    size_t refCount = 0;
-    CL_RETURN_ON_FAILURE(clGetContextInfo(clContext, CL_CONTEXT_REFERENCE_COUNT,
-                                          sizeof(size_t), &refCount, nullptr));
-
-    // ExtFuncPtrCache is destroyed in an atexit() callback, so it doesn't
-    // necessarily outlive the adapter (or all the contexts).
-    if (refCount == 1 && cl_ext::ExtFuncPtrCache) {
-      cl_ext::ExtFuncPtrCache->clearCache(clContext);
+    context_registry_t &Registry = getContextRegistry();
+    std::lock_guard<std::mutex> Lock{Registry.Mutex};
+    if (--hContext->RefCount != 0) {
+      return UR_RESULT_SUCCESS;
     }
+    Registry.erase(CLContext);
   }
 
-  CL_RETURN_ON_FAILURE(
-      clReleaseContext(cl_adapter::cast<cl_context>(hContext)));
+  ur_result_t Result = releaseContextDevices(hContext);
+  delete hContext;
 
-  return UR_RESULT_SUCCESS;
+  CL_RETURN_ON_FAILURE(clReleaseContext(CLContext));
+  return Result;
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL
 urContextRetain(ur_context_handle_t hContext) {
-
-  cl_int Ret = clRetainContext(cl_adapter::cast<cl_context>(hContext));
-  return mapCLErrorToUR(Ret);
+  hContext->RefCount++;
+  return UR_RESULT_SUCCESS;
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urContextGetNativeHandle(
     ur_context_handle_t hContext, ur_native_handle_t *phNativeContext) {
 
-  *phNativeContext = reinterpret_cast<ur_native_handle_t>(hContext);
+  *phNativeContext = reinterpret_cast<ur_native_handle_t>(hContext->CLContext);
   return UR_RESULT_SUCCESS;
 }
 
@@ -160,11 +335,11 @@ UR_APIEXPORT ur_result_t UR_APICALL urContextCreateWithNativeHandle(
     const ur_context_native_properties_t *pProperties,
     ur_context_handle_t *phContext) {
 
-  *phContext = reinterpret_cast<ur_context_handle_t>(hNativeContext);
+  cl_context NativeHandle = reinterpret_cast<cl_context>(hNativeContext);
   if (!pProperties || !pProperties->isNativeHandleOwned) {
-    return urContextRetain(*phContext);
+    CL_RETURN_ON_FAILURE(clRetainContext(NativeHandle));
   }
-  return UR_RESULT_SUCCESS;
+  return ur_context_handle_t_::make(NativeHandle, *phContext);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urContextSetExtendedDeleter(
@@ -221,7 +396,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urContextSetExtendedDeleter(
     C->execute();
   };
   CL_RETURN_ON_FAILURE(ur::cl::getAdapter()->clSetContextDestructorCallback(
-      cl_adapter::cast<cl_context>(hContext), ClCallback, Callback));
+      hContext->CLContext, ClCallback, Callback));
 
   return UR_RESULT_SUCCESS;
 }
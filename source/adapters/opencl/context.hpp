@@ -10,9 +10,78 @@
 #pragma once
 
 #include "common.hpp"
+#include "device.hpp"
+#include "usm.hpp"
 
-namespace cl_adapter {
-ur_result_t
-getDevicesFromContext(ur_context_handle_t hContext,
-                      std::unique_ptr<std::vector<cl_device_id>> &DevicesInCtx);
-}
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// Wraps a cl_context together with its devices and the extension entry points
+/// of its platform, so that enqueues don't have to query them.
+struct ur_context_handle_t_ {
+  /// Creates the handle of a context, taking over one OpenCL reference, which
+  /// is dropped on failure. If Ctx already has a handle, that one is returned
+  /// with an added reference.
+  static ur_result_t make(cl_context Ctx, ur_context_handle_t &Context);
+
+  /// Returns the handle of a context returned by OpenCL, e.g. by
+  /// CL_MEM_CONTEXT. No UR reference is added; contexts that weren't created
+  /// through the adapter get a handle, which retains Ctx, owned by the adapter.
+  static ur_result_t get(cl_context Ctx, ur_context_handle_t &Context);
+
+  ~ur_context_handle_t_();
+
+  /// Returns a kernel of the adapter's helper program, which is built for all
+  /// devices of the context on first use. Kernel is null if the program can't
+  /// be built. The kernels are shared, so HelperKernelMutex must be held from
+  /// before this call until the kernel has been enqueued.
+  ur_result_t getHelperKernel(const char *Name, cl_kernel &Kernel);
+
+  /// Tracks the queues created for the context, which deferred frees wait for.
+  void addQueue(ur_queue_handle_t Queue);
+  void removeQueue(ur_queue_handle_t Queue);
+
+  /// Returns Mem to Pool once the commands enqueued so far to the queues of
+  /// the context have completed, as kernels might access it indirectly.
+  ur_result_t deferPoolFree(umf_memory_pool_handle_t Pool, void *Mem);
+  /// Returns the memory of deferred frees whose commands have completed to
+  /// its pool. If Wait is set, waits for the commands of all of them.
+  void reclaimPoolFrees(bool Wait);
+
+  cl_context CLContext;
+  std::vector<ur_device_handle_t> Devices;
+  cl_ext::ExtFuncPtrT ExtFuncs;
+  std::atomic<uint32_t> RefCount = 1;
+  std::mutex HelperKernelMutex;
+  /// Serves USM allocations that don't name a pool. Null if UMF was built
+  /// without pool tracking.
+  std::unique_ptr<ur_usm_pool_handle_t_> DefaultUSMPool;
+
+private:
+  explicit ur_context_handle_t_(cl_context Ctx) : CLContext(Ctx) {}
+  ur_result_t initialize();
+  /// Creates and registers the handle of Ctx, taking over one OpenCL
+  /// reference. The caller holds the registry lock, so a context never gets
+  /// two handles.
+  static ur_result_t create(cl_context Ctx, ur_context_handle_t &Context);
+
+  cl_program HelperProgram = nullptr;
+  bool HelperProgramBuilt = false;
+  std::unordered_map<std::string, cl_kernel> HelperKernels;
+
+  std::mutex QueuesMutex;
+  std::vector<ur_queue_handle_t> Queues;
+
+  /// Pooled memory that is returned to Pool once all of Markers completed.
+  struct pool_free {
+    umf_memory_pool_handle_t Pool;
+    void *Mem;
+    std::vector<cl_event> Markers;
+  };
+  std::mutex PoolFreesMutex;
+  std::vector<pool_free> PoolFrees;
+};
@@ -11,69 +11,113 @@
 #include "common.hpp"
 #include "platform.hpp"
 
+#include <algorithm>
 #include <array>
 #include <cassert>
+#include <sstream>
 
-ur_result_t cl_adapter::getDeviceVersion(cl_device_id Dev,
-                                         oclv::OpenCLVersion &Version) {
+using device_registry_t =
+    cl_adapter::handle_registry<cl_device_id, ur_device_handle_t>;
 
-  size_t DevVerSize = 0;
-  CL_RETURN_ON_FAILURE(
-      clGetDeviceInfo(Dev, CL_DEVICE_VERSION, 0, nullptr, &DevVerSize));
+static device_registry_t &getDeviceRegistry() {
+  // Never destroyed, so that handles can be released from static destructors.
+  static device_registry_t *Registry = new device_registry_t;
+  return *Registry;
+}
+
+static ur_result_t getDeviceString(cl_device_id Dev, cl_device_info Name,
+                                   std::string &Value) {
+  size_t Size = 0;
+  CL_RETURN_ON_FAILURE(clGetDeviceInfo(Dev, Name, 0, nullptr, &Size));
+
+  std::string Str(Size, '\0');
+  CL_RETURN_ON_FAILURE(clGetDeviceInfo(Dev, Name, Size, Str.data(), nullptr));
+
+  Value = Str.c_str();
+  return UR_RESULT_SUCCESS;
+}
+
+ur_result_t ur_device_handle_t_::initialize() {
+  CL_RETURN_ON_FAILURE(clGetDeviceInfo(CLDevice, CL_DEVICE_PLATFORM,
+                                       sizeof(cl_platform_id), &Platform,
+                                       nullptr));
 
-  std::string DevVer(DevVerSize, '\0');
-  CL_RETURN_ON_FAILURE(clGetDeviceInfo(Dev, CL_DEVICE_VERSION, DevVerSize,
-                                       DevVer.data(), nullptr));
+  // OpenCL 1.1 devices can't be partitioned and don't know this query.
+  cl_device_id Parent = nullptr;
+  IsSubDevice = clGetDeviceInfo(CLDevice, CL_DEVICE_PARENT_DEVICE,
+                                sizeof(cl_device_id), &Parent,
+                                nullptr) == CL_SUCCESS &&
+                Parent != nullptr;
 
-  Version = oclv::OpenCLVersion(DevVer);
-  if (!Version.isValid()) {
-    return UR_RESULT_ERROR_INVALID_DEVICE;
+  std::string Str;
+  UR_RETURN_ON_FAILURE(getDeviceString(CLDevice, CL_DEVICE_VERSION, Str));
+  Version = oclv::OpenCLVersion(Str);
+
+  UR_RETURN_ON_FAILURE(getDeviceString(CLDevice, CL_DEVICE_EXTENSIONS, Str));
+  std::istringstream ExtStream(Str);
+  for (std::string Ext; ExtStream >> Ext;) {
+    Extensions.insert(std::move(Ext));
+  }
+
+  // The Intel FPGA emulation device does actually support these, even if it
+  // doesn't report them.
+  UR_RETURN_ON_FAILURE(getDeviceString(CLDevice, CL_DEVICE_NAME, Str));
+  if (Str.find("Intel(R) FPGA Emulation Device") != std::string::npos) {
+    Extensions.insert({"cl_intel_device_attribute_query",
+                       "cl_intel_required_subgroup_size", "cl_khr_subgroups"});
   }
 
   return UR_RESULT_SUCCESS;
 }
 
-static bool isIntelFPGAEmuDevice(cl_device_id Dev) {
-  size_t NameSize = 0;
-  CL_RETURN_ON_FAILURE(
-      clGetDeviceInfo(Dev, CL_DEVICE_NAME, 0, nullptr, &NameSize));
-  std::string NameStr(NameSize, '\0');
-  CL_RETURN_ON_FAILURE(
-      clGetDeviceInfo(Dev, CL_DEVICE_NAME, NameSize, NameStr.data(), nullptr));
+ur_result_t ur_device_handle_t_::get(cl_device_id Dev,
+                                     ur_device_handle_t &Device) {
+  device_registry_t &Registry = getDeviceRegistry();
+  std::lock_guard<std::mutex> Lock{Registry.Mutex};
+  if ((Device = Registry.find(Dev))) {
+    return UR_RESULT_SUCCESS;
+  }
 
-  return NameStr.find("Intel(R) FPGA Emulation Device") != std::string::npos;
+  std::unique_ptr<ur_device_handle_t_> NewDevice{new ur_device_handle_t_(Dev)};
+  UR_RETURN_ON_FAILURE(NewDevice->initialize());
+  if (NewDevice->IsSubDevice) {
+    CL_RETURN_ON_FAILURE(clRetainDevice(Dev));
+  }
+
+  Device = NewDevice.release();
+  Registry.insert(Dev, Device);
+  return UR_RESULT_SUCCESS;
 }
 
-ur_result_t cl_adapter::checkDeviceExtensions(
-    cl_device_id Dev, const std::vector<std::string> &Exts, bool &Supported) {
-  size_t ExtSize = 0;
-  CL_RETURN_ON_FAILURE(
-      clGetDeviceInfo(Dev, CL_DEVICE_EXTENSIONS, 0, nullptr, &ExtSize));
-
-  std::string ExtStr(ExtSize, '\0');
-
-  CL_RETURN_ON_FAILURE(clGetDeviceInfo(Dev, CL_DEVICE_EXTENSIONS, ExtSize,
-                                       ExtStr.data(), nullptr));
-
-  Supported = true;
-  for (const std::string &Ext : Exts) {
-    if (!(Supported = (ExtStr.find(Ext) != std::string::npos))) {
-      // The Intel FPGA emulation device does actually support these, even if it
-      // doesn't report them.
-      if (isIntelFPGAEmuDevice(Dev) &&
-          (Ext == "cl_intel_device_attribute_query" ||
-           Ext == "cl_intel_required_subgroup_size" ||
-           Ext == "cl_khr_subgroups")) {
-        Supported = true;
-        continue;
-      }
-      break;
-    }
+ur_result_t ur_device_handle_t_::makeSubDevice(cl_device_id Dev,
+                                               ur_device_handle_t &Device) {
+  device_registry_t &Registry = getDeviceRegistry();
+  std::lock_guard<std::mutex> Lock{Registry.Mutex};
+  if ((Device = Registry.find(Dev))) {
+    Device->RefCount++;
+    CL_RETURN_ON_FAILURE(clReleaseDevice(Dev));
+    return UR_RESULT_SUCCESS;
   }
 
+  std::unique_ptr<ur_device_handle_t_> NewDevice{new ur_device_handle_t_(Dev)};
+  if (ur_result_t Result = NewDevice->initialize();
+      Result != UR_RESULT_SUCCESS) {
+    clReleaseDevice(Dev);
+    return Result;
+  }
+
+  Device = NewDevice.release();
+  Registry.insert(Dev, Device);
   return UR_RESULT_SUCCESS;
 }
 
+bool ur_device_handle_t_::checkExtensions(
+    std::initializer_list<std::string_view> Exts) const {
+  return std::all_of(Exts.begin(), Exts.end(), [this](std::string_view Ext) {
+    return Extensions.find(Ext) != Extensions.end();
+  });
+}
+
 UR_APIEXPORT ur_result_t UR_APICALL urDeviceGet(ur_platform_handle_t hPlatform,
                                                 ur_device_type_t DeviceType,
                                                 uint32_t NumEntries,
@@ -103,20 +147,29 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGet(ur_platform_handle_t hPlatform,
     return UR_RESULT_ERROR_INVALID_ENUMERATION;
   }
 
+  std::vector<cl_device_id> CLDevices(phDevices ? NumEntries : 0);
+  cl_uint NumCLDevices = 0;
   cl_int Result = clGetDeviceIDs(cl_adapter::cast<cl_platform_id>(hPlatform),
                                  Type, cl_adapter::cast<cl_uint>(NumEntries),
-                                 cl_adapter::cast<cl_device_id *>(phDevices),
-                                 cl_adapter::cast<cl_uint *>(pNumDevices));
+                                 phDevices ? CLDevices.data() : nullptr,
+                                 &NumCLDevices);
 
   // Absorb the CL_DEVICE_NOT_FOUND and just return 0 in num_devices
   if (Result == CL_DEVICE_NOT_FOUND) {
     Result = CL_SUCCESS;
-    if (pNumDevices) {
-      *pNumDevices = 0;
-    }
+    NumCLDevices = 0;
   }
+  CL_RETURN_ON_FAILURE(Result);
 
-  return mapCLErrorToUR(Result);
+  if (pNumDevices) {
+    *pNumDevices = NumCLDevices;
+  }
+  for (size_t i = 0; i < std::min<size_t>(CLDevices.size(), NumCLDevices);
+       i++) {
+    UR_RETURN_ON_FAILURE(ur_device_handle_t_::get(CLDevices[i], phDevices[i]));
+  }
+
+  return UR_RESULT_SUCCESS;
 }
 
 static ur_device_fp_capability_flags_t
@@ -356,7 +409,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
   case UR_DEVICE_INFO_TYPE: {
     cl_device_type CLType;
     CL_RETURN_ON_FAILURE(
-        clGetDeviceInfo(cl_adapter::cast<cl_device_id>(hDevice), CLPropName,
+        clGetDeviceInfo(hDevice->CLDevice, CLPropName,
                         sizeof(cl_device_type), &CLType, nullptr));
 
     /* TODO UR: If the device is an Accelerator (FPGA, VPU, etc.), there is not
@@ -376,26 +429,22 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
     return ReturnValue(URDeviceType);
   }
   case UR_DEVICE_INFO_DEVICE_ID: {
-    bool Supported = false;
-    UR_RETURN_ON_FAILURE(cl_adapter::checkDeviceExtensions(
-        cl_adapter::cast<cl_device_id>(hDevice),
-        {"cl_intel_device_attribute_query"}, Supported));
+    bool Supported =
+        hDevice->checkExtensions({"cl_intel_device_attribute_query"});
 
     if (!Supported) {
       return UR_RESULT_ERROR_UNSUPPORTED_ENUMERATION;
     }
 
     CL_RETURN_ON_FAILURE(clGetDeviceInfo(
-        cl_adapter::cast<cl_device_id>(hDevice), CL_DEVICE_ID_INTEL, propSize,
+        hDevice->CLDevice, CL_DEVICE_ID_INTEL, propSize,
         pPropValue, pPropSizeRet));
 
     return UR_RESULT_SUCCESS;
   }
 
   case UR_DEVICE_INFO_BACKEND_RUNTIME_VERSION: {
-    oclv::OpenCLVersion Version;
-    UR_RETURN_ON_FAILURE(cl_adapter::getDeviceVersion(
-        cl_adapter::cast<cl_device_id>(hDevice), Version));
+    const oclv::OpenCLVersion &Version = hDevice->Version;
 
     const std::string Results = std::to_string(Version.getMajor()) + "." +
                                 std::to_string(Version.getMinor());
@@ -403,14 +452,13 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
   }
   case UR_DEVICE_INFO_SUPPORTED_PARTITIONS: {
     size_t CLSize;
-    CL_RETURN_ON_FAILURE(
-        clGetDeviceInfo(cl_adapter::cast<cl_device_id>(hDevice), CLPropName, 0,
-                        nullptr, &CLSize));
+    CL_RETURN_ON_FAILURE(clGetDeviceInfo(hDevice->CLDevice, CLPropName, 0,
+                                         nullptr, &CLSize));
     const size_t NProperties = CLSize / sizeof(cl_device_partition_property);
 
     std::vector<cl_device_partition_property> CLValue(NProperties);
     CL_RETURN_ON_FAILURE(
-        clGetDeviceInfo(cl_adapter::cast<cl_device_id>(hDevice), CLPropName,
+        clGetDeviceInfo(hDevice->CLDevice, CLPropName,
                         CLSize, CLValue.data(), nullptr));
 
     /* The OpenCL implementation returns a value of 0 if no properties are
@@ -432,9 +480,8 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
   case UR_DEVICE_INFO_PARTITION_TYPE: {
 
     size_t CLSize;
-    CL_RETURN_ON_FAILURE(
-        clGetDeviceInfo(cl_adapter::cast<cl_device_id>(hDevice), CLPropName, 0,
-                        nullptr, &CLSize));
+    CL_RETURN_ON_FAILURE(clGetDeviceInfo(hDevice->CLDevice, CLPropName, 0,
+                                         nullptr, &CLSize));
     const size_t NProperties = CLSize / sizeof(cl_device_partition_property);
 
     /* The OpenCL implementation returns either a size of 0 or a value of 0 if
@@ -449,7 +496,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
     auto CLValue =
         reinterpret_cast<cl_device_partition_property *>(alloca(CLSize));
     CL_RETURN_ON_FAILURE(
-        clGetDeviceInfo(cl_adapter::cast<cl_device_id>(hDevice), CLPropName,
+        clGetDeviceInfo(hDevice->CLDevice, CLPropName,
                         CLSize, CLValue, nullptr));
 
     std::vector<ur_device_partition_property_t> URValue(NProperties - 1);
@@ -502,14 +549,12 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
   case UR_DEVICE_INFO_MAX_NUM_SUB_GROUPS: {
     /* Corresponding OpenCL query is only available starting with OpenCL 2.1
      * and we have to emulate it on older OpenCL runtimes. */
-    oclv::OpenCLVersion DevVer;
-    UR_RETURN_ON_FAILURE(cl_adapter::getDeviceVersion(
-        cl_adapter::cast<cl_device_id>(hDevice), DevVer));
+    const oclv::OpenCLVersion &DevVer = hDevice->Version;
 
     if (DevVer >= oclv::V2_1) {
       cl_uint CLValue;
       CL_RETURN_ON_FAILURE(clGetDeviceInfo(
-          cl_adapter::cast<cl_device_id>(hDevice), CL_DEVICE_MAX_NUM_SUB_GROUPS,
+          hDevice->CLDevice, CL_DEVICE_MAX_NUM_SUB_GROUPS,
           sizeof(cl_uint), &CLValue, nullptr));
 
       if (CLValue == 0u) {
@@ -532,9 +577,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
     /* CL type: cl_device_fp_config
      * UR type: ur_device_fp_capability_flags_t */
     if (propName == UR_DEVICE_INFO_HALF_FP_CONFIG) {
-      bool Supported;
-      UR_RETURN_ON_FAILURE(cl_adapter::checkDeviceExtensions(
-          cl_adapter::cast<cl_device_id>(hDevice), {"cl_khr_fp16"}, Supported));
+      bool Supported = hDevice->checkExtensions({"cl_khr_fp16"});
 
       if (!Supported) {
         // If we don't support the extension then our capabilities are 0.
@@ -545,7 +588,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
 
     cl_device_fp_config CLValue;
     CL_RETURN_ON_FAILURE(
-        clGetDeviceInfo(cl_adapter::cast<cl_device_id>(hDevice), CLPropName,
+        clGetDeviceInfo(hDevice->CLDevice, CLPropName,
                         sizeof(cl_device_fp_config), &CLValue, nullptr));
 
     return ReturnValue(mapCLDeviceFpConfigToUR(CLValue));
@@ -554,9 +597,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
   case UR_DEVICE_INFO_ATOMIC_MEMORY_ORDER_CAPABILITIES: {
     /* This query is missing before OpenCL 3.0. Check version and handle
      * appropriately */
-    oclv::OpenCLVersion DevVer;
-    UR_RETURN_ON_FAILURE(cl_adapter::getDeviceVersion(
-        cl_adapter::cast<cl_device_id>(hDevice), DevVer));
+    const oclv::OpenCLVersion &DevVer = hDevice->Version;
 
     /* Minimum required capability to be returned. For OpenCL 1.2, this is all
      * that is required */
@@ -567,8 +608,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
       /* For OpenCL >=3.0, the query should be implemented */
       cl_device_atomic_capabilities CLCapabilities;
       CL_RETURN_ON_FAILURE(clGetDeviceInfo(
-          cl_adapter::cast<cl_device_id>(hDevice),
-          CL_DEVICE_ATOMIC_MEMORY_CAPABILITIES,
+          hDevice->CLDevice, CL_DEVICE_ATOMIC_MEMORY_CAPABILITIES,
           sizeof(cl_device_atomic_capabilities), &CLCapabilities, nullptr));
 
       /* Mask operation to only consider atomic_memory_order* capabilities */
@@ -614,15 +654,12 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
         UR_MEMORY_SCOPE_CAPABILITY_FLAG_SUB_GROUP |
         UR_MEMORY_SCOPE_CAPABILITY_FLAG_WORK_GROUP;
 
-    oclv::OpenCLVersion DevVer;
-    UR_RETURN_ON_FAILURE(cl_adapter::getDeviceVersion(
-        cl_adapter::cast<cl_device_id>(hDevice), DevVer));
+    const oclv::OpenCLVersion &DevVer = hDevice->Version;
 
     cl_device_atomic_capabilities CLCapabilities;
     if (DevVer >= oclv::V3_0) {
       CL_RETURN_ON_FAILURE(clGetDeviceInfo(
-          cl_adapter::cast<cl_device_id>(hDevice),
-          CL_DEVICE_ATOMIC_MEMORY_CAPABILITIES,
+          hDevice->CLDevice, CL_DEVICE_ATOMIC_MEMORY_CAPABILITIES,
           sizeof(cl_device_atomic_capabilities), &CLCapabilities, nullptr));
 
       assert((CLCapabilities & CL_DEVICE_ATOMIC_SCOPE_WORK_GROUP) &&
@@ -668,15 +705,12 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
         UR_MEMORY_ORDER_CAPABILITY_FLAG_RELEASE |
         UR_MEMORY_ORDER_CAPABILITY_FLAG_ACQ_REL;
 
-    oclv::OpenCLVersion DevVer;
-    UR_RETURN_ON_FAILURE(cl_adapter::getDeviceVersion(
-        cl_adapter::cast<cl_device_id>(hDevice), DevVer));
+    const oclv::OpenCLVersion &DevVer = hDevice->Version;
 
     cl_device_atomic_capabilities CLCapabilities;
     if (DevVer >= oclv::V3_0) {
       CL_RETURN_ON_FAILURE(clGetDeviceInfo(
-          cl_adapter::cast<cl_device_id>(hDevice),
-          CL_DEVICE_ATOMIC_FENCE_CAPABILITIES,
+          hDevice->CLDevice, CL_DEVICE_ATOMIC_FENCE_CAPABILITIES,
           sizeof(cl_device_atomic_capabilities), &CLCapabilities, nullptr));
 
       assert((CLCapabilities & CL_DEVICE_ATOMIC_ORDER_RELAXED) &&
@@ -718,9 +752,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
         UR_MEMORY_SCOPE_CAPABILITY_FLAG_SUB_GROUP |
         UR_MEMORY_SCOPE_CAPABILITY_FLAG_WORK_GROUP;
 
-    oclv::OpenCLVersion DevVer;
-    UR_RETURN_ON_FAILURE(cl_adapter::getDeviceVersion(
-        cl_adapter::cast<cl_device_id>(hDevice), DevVer));
+    const oclv::OpenCLVersion &DevVer = hDevice->Version;
 
     auto convertCapabilities =
         [](cl_device_atomic_capabilities CLCapabilities) {
@@ -744,8 +776,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
     if (DevVer >= oclv::V3_0) {
       cl_device_atomic_capabilities CLCapabilities;
       CL_RETURN_ON_FAILURE(clGetDeviceInfo(
-          cl_adapter::cast<cl_device_id>(hDevice),
-          CL_DEVICE_ATOMIC_FENCE_CAPABILITIES,
+          hDevice->CLDevice, CL_DEVICE_ATOMIC_FENCE_CAPABILITIES,
           sizeof(cl_device_atomic_capabilities), &CLCapabilities, nullptr));
       assert((CLCapabilities & CL_DEVICE_ATOMIC_SCOPE_WORK_GROUP) &&
              "Violates minimum mandated guarantee");
@@ -764,7 +795,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
       // not return an error if the query is unsuccessful as this is expected
       // of an OpenCL 1.2 driver.
       cl_device_atomic_capabilities CLCapabilities;
-      if (CL_SUCCESS == clGetDeviceInfo(cl_adapter::cast<cl_device_id>(hDevice),
+      if (CL_SUCCESS == clGetDeviceInfo(hDevice->CLDevice,
                                         CL_DEVICE_ATOMIC_FENCE_CAPABILITIES,
                                         sizeof(cl_device_atomic_capabilities),
                                         &CLCapabilities, nullptr)) {
@@ -783,11 +814,8 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
   }
 
   case UR_DEVICE_INFO_ATOMIC_64: {
-    bool Supported = false;
-    UR_RETURN_ON_FAILURE(cl_adapter::checkDeviceExtensions(
-        cl_adapter::cast<cl_device_id>(hDevice),
-        {"cl_khr_int64_base_atomics", "cl_khr_int64_extended_atomics"},
-        Supported));
+    bool Supported = hDevice->checkExtensions(
+        {"cl_khr_int64_base_atomics", "cl_khr_int64_extended_atomics"});
 
     return ReturnValue(Supported);
   }
@@ -795,16 +823,14 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
 
     cl_device_type DevType = CL_DEVICE_TYPE_DEFAULT;
     CL_RETURN_ON_FAILURE(
-        clGetDeviceInfo(cl_adapter::cast<cl_device_id>(hDevice), CL_DEVICE_TYPE,
+        clGetDeviceInfo(hDevice->CLDevice, CL_DEVICE_TYPE,
                         sizeof(cl_device_type), &DevType, nullptr));
 
     return ReturnValue(DevType == CL_DEVICE_TYPE_GPU);
   }
   case UR_DEVICE_INFO_MEM_CHANNEL_SUPPORT: {
-    bool Supported = false;
-    UR_RETURN_ON_FAILURE(cl_adapter::checkDeviceExtensions(
-        cl_adapter::cast<cl_device_id>(hDevice),
-        {"cl_intel_mem_channel_property"}, Supported));
+    bool Supported =
+        hDevice->checkExtensions({"cl_intel_mem_channel_property"});
 
     return ReturnValue(Supported);
   }
@@ -812,12 +838,12 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
     bool Supported = false;
     cl_device_type DevType = CL_DEVICE_TYPE_DEFAULT;
     CL_RETURN_ON_FAILURE(
-        clGetDeviceInfo(cl_adapter::cast<cl_device_id>(hDevice), CL_DEVICE_TYPE,
+        clGetDeviceInfo(hDevice->CLDevice, CL_DEVICE_TYPE,
                         sizeof(cl_device_type), &DevType, nullptr));
 
     cl_uint VendorID = 0;
     CL_RETURN_ON_FAILURE(clGetDeviceInfo(
-        cl_adapter::cast<cl_device_id>(hDevice), CL_DEVICE_VENDOR_ID,
+        hDevice->CLDevice, CL_DEVICE_VENDOR_ID,
         sizeof(VendorID), &VendorID, nullptr));
 
     /* ESIMD is only supported by Intel GPUs. */
@@ -830,14 +856,12 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
   }
   case UR_DEVICE_INFO_NUM_COMPUTE_UNITS: {
 
-    bool ExtensionSupported = false;
-    UR_RETURN_ON_FAILURE(cl_adapter::checkDeviceExtensions(
-        cl_adapter::cast<cl_device_id>(hDevice),
-        {"cl_intel_device_attribute_query"}, ExtensionSupported));
+    bool ExtensionSupported =
+        hDevice->checkExtensions({"cl_intel_device_attribute_query"});
 
     cl_device_type CLType;
     CL_RETURN_ON_FAILURE(
-        clGetDeviceInfo(cl_adapter::cast<cl_device_id>(hDevice), CL_DEVICE_TYPE,
+        clGetDeviceInfo(hDevice->CLDevice, CL_DEVICE_TYPE,
                         sizeof(cl_device_type), &CLType, nullptr));
 
     cl_uint NumComputeUnits;
@@ -845,16 +869,16 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
       cl_uint SliceCount = 0;
       cl_uint SubSlicePerSliceCount = 0;
       CL_RETURN_ON_FAILURE(clGetDeviceInfo(
-          cl_adapter::cast<cl_device_id>(hDevice), CL_DEVICE_NUM_SLICES_INTEL,
+          hDevice->CLDevice, CL_DEVICE_NUM_SLICES_INTEL,
           sizeof(cl_uint), &SliceCount, nullptr));
       CL_RETURN_ON_FAILURE(
-          clGetDeviceInfo(cl_adapter::cast<cl_device_id>(hDevice),
+          clGetDeviceInfo(hDevice->CLDevice,
                           CL_DEVICE_NUM_SUB_SLICES_PER_SLICE_INTEL,
                           sizeof(cl_uint), &SubSlicePerSliceCount, nullptr));
       NumComputeUnits = SliceCount * SubSlicePerSliceCount;
     } else {
       CL_RETURN_ON_FAILURE(clGetDeviceInfo(
-          cl_adapter::cast<cl_device_id>(hDevice), CL_DEVICE_MAX_COMPUTE_UNITS,
+          hDevice->CLDevice, CL_DEVICE_MAX_COMPUTE_UNITS,
           sizeof(cl_uint), &NumComputeUnits, nullptr));
     }
 
@@ -867,17 +891,13 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
     return ReturnValue(false);
   }
   case UR_DEVICE_INFO_HOST_PIPE_READ_WRITE_SUPPORTED: {
-    bool Supported = false;
-    UR_RETURN_ON_FAILURE(cl_adapter::checkDeviceExtensions(
-        cl_adapter::cast<cl_device_id>(hDevice),
-        {"cl_intel_program_scope_host_pipe"}, Supported));
+    bool Supported =
+        hDevice->checkExtensions({"cl_intel_program_scope_host_pipe"});
     return ReturnValue(Supported);
   }
   case UR_DEVICE_INFO_GLOBAL_VARIABLE_SUPPORT: {
-    bool Supported = false;
-    UR_RETURN_ON_FAILURE(cl_adapter::checkDeviceExtensions(
-        cl_adapter::cast<cl_device_id>(hDevice),
-        {"cl_intel_global_variable_access"}, Supported));
+    bool Supported =
+        hDevice->checkExtensions({"cl_intel_global_variable_access"});
     return ReturnValue(Supported);
   }
   case UR_DEVICE_INFO_QUEUE_PROPERTIES:
@@ -892,7 +912,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
 
     cl_bitfield CLValue = 0;
     CL_RETURN_ON_FAILURE(
-        clGetDeviceInfo(cl_adapter::cast<cl_device_id>(hDevice), CLPropName,
+        clGetDeviceInfo(hDevice->CLDevice, CLPropName,
                         sizeof(cl_bitfield), &CLValue, nullptr));
 
     /* We can just static_cast the output because OpenCL and UR bitfields
@@ -907,14 +927,12 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
   case UR_DEVICE_INFO_USM_SYSTEM_SHARED_SUPPORT: {
     /* CL type: cl_bitfield / enum
      * UR type: ur_flags_t (uint32_t) */
-    bool Supported = false;
-    UR_RETURN_ON_FAILURE(cl_adapter::checkDeviceExtensions(
-        cl_adapter::cast<cl_device_id>(hDevice),
-        {"cl_intel_unified_shared_memory"}, Supported));
+    bool Supported =
+        hDevice->checkExtensions({"cl_intel_unified_shared_memory"});
     if (Supported) {
       cl_bitfield CLValue = 0;
       CL_RETURN_ON_FAILURE(
-          clGetDeviceInfo(cl_adapter::cast<cl_device_id>(hDevice), CLPropName,
+          clGetDeviceInfo(hDevice->CLDevice, CLPropName,
                           sizeof(cl_bitfield), &CLValue, nullptr));
       return ReturnValue(static_cast<uint32_t>(CLValue));
     } else {
@@ -934,7 +952,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
 
     cl_bool CLValue;
     CL_RETURN_ON_FAILURE(
-        clGetDeviceInfo(cl_adapter::cast<cl_device_id>(hDevice), CLPropName,
+        clGetDeviceInfo(hDevice->CLDevice, CLPropName,
                         sizeof(cl_bool), &CLValue, nullptr));
 
     /* cl_bool is uint32_t and ur_bool_t is bool */
@@ -944,15 +962,13 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
     /* CL type: cl_bool
      * UR type: ur_bool_t */
 
-    oclv::OpenCLVersion DevVer;
-    CL_RETURN_ON_FAILURE(cl_adapter::getDeviceVersion(
-        cl_adapter::cast<cl_device_id>(hDevice), DevVer));
+    const oclv::OpenCLVersion &DevVer = hDevice->Version;
     /* Independent forward progress query is only supported as of OpenCL 2.1
      * if version is older we return a default false. */
     if (DevVer >= oclv::V2_1) {
       cl_bool CLValue;
       CL_RETURN_ON_FAILURE(
-          clGetDeviceInfo(cl_adapter::cast<cl_device_id>(hDevice), CLPropName,
+          clGetDeviceInfo(hDevice->CLDevice, CLPropName,
                           sizeof(cl_bool), &CLValue, nullptr));
 
       /* cl_bool is uint32_t and ur_bool_t is bool */
@@ -987,7 +1003,6 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
   case UR_DEVICE_INFO_MAX_SAMPLERS:
   case UR_DEVICE_INFO_GLOBAL_MEM_CACHELINE_SIZE:
   case UR_DEVICE_INFO_MAX_CONSTANT_ARGS:
-  case UR_DEVICE_INFO_REFERENCE_COUNT:
   case UR_DEVICE_INFO_PARTITION_MAX_SUB_DEVICES:
   case UR_DEVICE_INFO_MAX_MEM_ALLOC_SIZE:
   case UR_DEVICE_INFO_GLOBAL_MEM_CACHE_SIZE:
@@ -1006,7 +1021,6 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
   case UR_DEVICE_INFO_PROFILING_TIMER_RESOLUTION:
   case UR_DEVICE_INFO_PRINTF_BUFFER_SIZE:
   case UR_DEVICE_INFO_PLATFORM:
-  case UR_DEVICE_INFO_PARENT_DEVICE:
   case UR_DEVICE_INFO_IL_VERSION:
   case UR_DEVICE_INFO_NAME:
   case UR_DEVICE_INFO_VENDOR:
@@ -1024,20 +1038,31 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
      * | cl_ulong           | uint64_t               | 8    |
      * | size_t             | size_t                 | 8    |
      * | cl_platform_id     | ur_platform_handle_t   | 8    |
-     * | ur_device_handle_t | cl_device_id           | 8    |
      */
 
-    CL_RETURN_ON_FAILURE(
-        clGetDeviceInfo(cl_adapter::cast<cl_device_id>(hDevice), CLPropName,
-                        propSize, pPropValue, pPropSizeRet));
+    CL_RETURN_ON_FAILURE(clGetDeviceInfo(hDevice->CLDevice, CLPropName,
+                                         propSize, pPropValue, pPropSizeRet));
 
     return UR_RESULT_SUCCESS;
   }
+  case UR_DEVICE_INFO_REFERENCE_COUNT:
+    return ReturnValue(hDevice->RefCount.load());
+  case UR_DEVICE_INFO_PARENT_DEVICE: {
+    cl_device_id CLParent = nullptr;
+    if (hDevice->IsSubDevice) {
+      CL_RETURN_ON_FAILURE(clGetDeviceInfo(hDevice->CLDevice,
+                                           CL_DEVICE_PARENT_DEVICE,
+                                           sizeof(CLParent), &CLParent,
+                                           nullptr));
+    }
+    ur_device_handle_t Parent = nullptr;
+    if (CLParent) {
+      UR_RETURN_ON_FAILURE(ur_device_handle_t_::get(CLParent, Parent));
+    }
+    return ReturnValue(Parent);
+  }
   case UR_DEVICE_INFO_PCI_ADDRESS: {
-    bool Supported = false;
-    UR_RETURN_ON_FAILURE(cl_adapter::checkDeviceExtensions(
-        cl_adapter::cast<cl_device_id>(hDevice), {"cl_khr_pci_bus_info"},
-        Supported));
+    bool Supported = hDevice->checkExtensions({"cl_khr_pci_bus_info"});
 
     if (!Supported) {
       return UR_RESULT_ERROR_UNSUPPORTED_ENUMERATION;
@@ -1045,7 +1070,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
 
     cl_device_pci_bus_info_khr PciInfo = {};
     CL_RETURN_ON_FAILURE(clGetDeviceInfo(
-        cl_adapter::cast<cl_device_id>(hDevice), CL_DEVICE_PCI_BUS_INFO_KHR,
+        hDevice->CLDevice, CL_DEVICE_PCI_BUS_INFO_KHR,
         sizeof(PciInfo), &PciInfo, nullptr));
 
     constexpr size_t AddressBufferSize = 13;
@@ -1059,24 +1084,22 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
     /* The EU count can be queried using CL_DEVICE_MAX_COMPUTE_UNITS for Intel
      * GPUs. */
 
-    bool Supported;
-    UR_RETURN_ON_FAILURE(cl_adapter::checkDeviceExtensions(
-        cl_adapter::cast<cl_device_id>(hDevice),
-        {"cl_intel_device_attribute_query"}, Supported));
+    bool Supported =
+        hDevice->checkExtensions({"cl_intel_device_attribute_query"});
     if (!Supported) {
       return UR_RESULT_ERROR_UNSUPPORTED_ENUMERATION;
     }
 
     cl_device_type CLType;
     CL_RETURN_ON_FAILURE(
-        clGetDeviceInfo(cl_adapter::cast<cl_device_id>(hDevice), CL_DEVICE_TYPE,
+        clGetDeviceInfo(hDevice->CLDevice, CL_DEVICE_TYPE,
                         sizeof(cl_device_type), &CLType, nullptr));
     if (!(CLType & CL_DEVICE_TYPE_GPU)) {
       return UR_RESULT_ERROR_UNSUPPORTED_ENUMERATION;
     }
 
     CL_RETURN_ON_FAILURE(clGetDeviceInfo(
-        cl_adapter::cast<cl_device_id>(hDevice), CL_DEVICE_MAX_COMPUTE_UNITS,
+        hDevice->CLDevice, CL_DEVICE_MAX_COMPUTE_UNITS,
         propSize, pPropValue, pPropSizeRet));
 
     return UR_RESULT_SUCCESS;
@@ -1086,27 +1109,20 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
   case UR_DEVICE_INFO_GPU_SUBSLICES_PER_SLICE:
   case UR_DEVICE_INFO_GPU_HW_THREADS_PER_EU:
   case UR_DEVICE_INFO_IP_VERSION: {
-    bool Supported;
-    UR_RETURN_ON_FAILURE(cl_adapter::checkDeviceExtensions(
-        cl_adapter::cast<cl_device_id>(hDevice),
-        {"cl_intel_device_attribute_query"}, Supported));
+    bool Supported =
+        hDevice->checkExtensions({"cl_intel_device_attribute_query"});
     if (!Supported) {
       return UR_RESULT_ERROR_UNSUPPORTED_ENUMERATION;
     }
     CL_RETURN_ON_FAILURE(
-        clGetDeviceInfo(cl_adapter::cast<cl_device_id>(hDevice), CLPropName,
+        clGetDeviceInfo(hDevice->CLDevice, CLPropName,
                         propSize, pPropValue, pPropSizeRet));
 
     return UR_RESULT_SUCCESS;
   }
 
   case UR_DEVICE_INFO_SUB_GROUP_SIZES_INTEL: {
-    bool isExtensionSupported;
-    if (cl_adapter::checkDeviceExtensions(
-            cl_adapter::cast<cl_device_id>(hDevice),
-            {"cl_intel_required_subgroup_size"},
-            isExtensionSupported) != UR_RESULT_SUCCESS ||
-        !isExtensionSupported) {
+    if (!hDevice->checkExtensions({"cl_intel_required_subgroup_size"})) {
       std::vector<uint32_t> aThreadIsItsOwnSubGroup({1});
       return ReturnValue(aThreadIsItsOwnSubGroup.data(),
                          aThreadIsItsOwnSubGroup.size());
@@ -1115,45 +1131,36 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
     // Have to convert size_t to uint32_t
     size_t SubGroupSizesSize = 0;
     CL_RETURN_ON_FAILURE(
-        clGetDeviceInfo(cl_adapter::cast<cl_device_id>(hDevice), CLPropName, 0,
+        clGetDeviceInfo(hDevice->CLDevice, CLPropName, 0,
                         nullptr, &SubGroupSizesSize));
     std::vector<size_t> SubGroupSizes(SubGroupSizesSize / sizeof(size_t));
     CL_RETURN_ON_FAILURE(
-        clGetDeviceInfo(cl_adapter::cast<cl_device_id>(hDevice), CLPropName,
+        clGetDeviceInfo(hDevice->CLDevice, CLPropName,
                         SubGroupSizesSize, SubGroupSizes.data(), nullptr));
     return ReturnValue.template operator()<uint32_t>(SubGroupSizes.data(),
                                                      SubGroupSizes.size());
   }
   case UR_DEVICE_INFO_EXTENSIONS: {
-    cl_device_id Dev = cl_adapter::cast<cl_device_id>(hDevice);
-    size_t ExtSize = 0;
-    CL_RETURN_ON_FAILURE(
-        clGetDeviceInfo(Dev, CL_DEVICE_EXTENSIONS, 0, nullptr, &ExtSize));
-
-    std::string ExtStr(ExtSize, '\0');
-    CL_RETURN_ON_FAILURE(clGetDeviceInfo(Dev, CL_DEVICE_EXTENSIONS, ExtSize,
-                                         ExtStr.data(), nullptr));
-
-    std::string SupportedExtensions(ExtStr.c_str());
-    if (ExtStr.find("cl_khr_command_buffer") != std::string::npos) {
+    std::string SupportedExtensions;
+    UR_RETURN_ON_FAILURE(getDeviceString(
+        hDevice->CLDevice, CL_DEVICE_EXTENSIONS, SupportedExtensions));
+    if (hDevice->checkExtensions({"cl_khr_command_buffer"}) ||
+        hasSoftwareCommandBuffers(hDevice)) {
       SupportedExtensions += " ur_exp_command_buffer";
     }
+    SupportedExtensions += " ur_exp_program_file_source";
     return ReturnValue(SupportedExtensions.c_str());
   }
 
   case UR_DEVICE_INFO_UUID: {
     // Use the cl_khr_device_uuid extension, if available.
-    bool isKhrDeviceUuidSupported = false;
-    if (cl_adapter::checkDeviceExtensions(
-            cl_adapter::cast<cl_device_id>(hDevice), {"cl_khr_device_uuid"},
-            isKhrDeviceUuidSupported) != UR_RESULT_SUCCESS ||
-        !isKhrDeviceUuidSupported) {
+    if (!hDevice->checkExtensions({"cl_khr_device_uuid"})) {
       return UR_RESULT_ERROR_UNSUPPORTED_ENUMERATION;
     }
     static_assert(CL_UUID_SIZE_KHR == 16);
     std::array<uint8_t, CL_UUID_SIZE_KHR> UUID{};
     CL_RETURN_ON_FAILURE(
-        clGetDeviceInfo(cl_adapter::cast<cl_device_id>(hDevice),
+        clGetDeviceInfo(hDevice->CLDevice,
                         CL_DEVICE_UUID_KHR, UUID.size(), UUID.data(), nullptr));
     return ReturnValue(UUID);
   }
@@ -1172,7 +1179,12 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
   }
 
   case UR_DEVICE_INFO_USM_POOL_SUPPORT: {
+#ifdef UMF_ENABLE_POOL_TRACKING
+    return ReturnValue(
+        hDevice->checkExtensions({"cl_intel_unified_shared_memory"}));
+#else
     return ReturnValue(false);
+#endif
   }
 
   /* TODO: Check regularly to see if support is enabled in OpenCL. Intel GPU
@@ -1190,37 +1202,20 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetInfo(ur_device_handle_t hDevice,
   case UR_DEVICE_INFO_COMPOSITE_DEVICE:
     return UR_RESULT_ERROR_UNSUPPORTED_ENUMERATION;
   case UR_DEVICE_INFO_2D_BLOCK_ARRAY_CAPABILITIES_EXP: {
-    bool Is2DBlockIOSupported = false;
-    if (cl_adapter::checkDeviceExtensions(
-            cl_adapter::cast<cl_device_id>(hDevice),
-            {"cl_intel_subgroup_2d_block_io"},
-            Is2DBlockIOSupported) != UR_RESULT_SUCCESS ||
-        !Is2DBlockIOSupported) {
+    if (!hDevice->checkExtensions({"cl_intel_subgroup_2d_block_io"})) {
       return ReturnValue(
           static_cast<ur_exp_device_2d_block_array_capability_flags_t>(0));
     }
     return ReturnValue(UR_EXP_DEVICE_2D_BLOCK_ARRAY_CAPABILITY_FLAG_LOAD |
                        UR_EXP_DEVICE_2D_BLOCK_ARRAY_CAPABILITY_FLAG_STORE);
   }
-  case UR_DEVICE_INFO_COMMAND_BUFFER_SUPPORT_EXP: {
-    cl_device_id Dev = cl_adapter::cast<cl_device_id>(hDevice);
-    size_t ExtSize = 0;
-    CL_RETURN_ON_FAILURE(
-        clGetDeviceInfo(Dev, CL_DEVICE_EXTENSIONS, 0, nullptr, &ExtSize));
-
-    std::string ExtStr(ExtSize, '\0');
-    CL_RETURN_ON_FAILURE(clGetDeviceInfo(Dev, CL_DEVICE_EXTENSIONS, ExtSize,
-                                         ExtStr.data(), nullptr));
-
-    std::string SupportedExtensions(ExtStr.c_str());
-    return ReturnValue(ExtStr.find("cl_khr_command_buffer") !=
-                       std::string::npos);
-  }
+  case UR_DEVICE_INFO_COMMAND_BUFFER_SUPPORT_EXP:
+    return ReturnValue(hDevice->checkExtensions({"cl_khr_command_buffer"}) ||
+                       hasSoftwareCommandBuffers(hDevice));
   case UR_DEVICE_INFO_COMMAND_BUFFER_UPDATE_CAPABILITIES_EXP: {
-    cl_device_id Dev = cl_adapter::cast<cl_device_id>(hDevice);
     ur_device_command_buffer_update_capability_flags_t UpdateCapabilities = 0;
-    CL_RETURN_ON_FAILURE(
-        getDeviceCommandBufferUpdateCapabilities(Dev, UpdateCapabilities));
+    CL_RETURN_ON_FAILURE(getDeviceCommandBufferUpdateCapabilities(
+        hDevice, UpdateCapabilities));
     return ReturnValue(UpdateCapabilities);
   }
   case UR_DEVICE_INFO_COMMAND_BUFFER_EVENT_SUPPORT_EXP:
@@ -1276,7 +1271,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urDevicePartition(
 
   cl_uint CLNumDevicesRet;
   CL_RETURN_ON_FAILURE(
-      clCreateSubDevices(cl_adapter::cast<cl_device_id>(hDevice),
+      clCreateSubDevices(hDevice->CLDevice,
                          CLProperties.data(), 0, nullptr, &CLNumDevicesRet));
 
   if (pNumDevicesRet) {
@@ -1288,35 +1283,55 @@ UR_APIEXPORT ur_result_t UR_APICALL urDevicePartition(
   if (phSubDevices) {
     std::vector<cl_device_id> CLSubDevices(CLNumDevicesRet);
     CL_RETURN_ON_FAILURE(clCreateSubDevices(
-        cl_adapter::cast<cl_device_id>(hDevice), CLProperties.data(),
-        CLNumDevicesRet, CLSubDevices.data(), nullptr));
+        hDevice->CLDevice, CLProperties.data(), CLNumDevicesRet,
+        CLSubDevices.data(), nullptr));
 
-    std::memcpy(phSubDevices, CLSubDevices.data(),
-                sizeof(cl_device_id) * NumDevices);
+    for (size_t i = 0; i < CLSubDevices.size(); i++) {
+      if (i < NumDevices) {
+        UR_RETURN_ON_FAILURE(ur_device_handle_t_::makeSubDevice(
+            CLSubDevices[i], phSubDevices[i]));
+      } else {
+        CL_RETURN_ON_FAILURE(clReleaseDevice(CLSubDevices[i]));
+      }
+    }
   }
 
   return UR_RESULT_SUCCESS;
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urDeviceRetain(ur_device_handle_t hDevice) {
-
-  cl_int Result = clRetainDevice(cl_adapter::cast<cl_device_id>(hDevice));
-
-  return mapCLErrorToUR(Result);
+  // Root devices are not reference counted.
+  if (hDevice->IsSubDevice) {
+    hDevice->RefCount++;
+  }
+  return UR_RESULT_SUCCESS;
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL
 urDeviceRelease(ur_device_handle_t hDevice) {
+  if (!hDevice->IsSubDevice) {
+    return UR_RESULT_SUCCESS;
+  }
 
-  cl_int Result = clReleaseDevice(cl_adapter::cast<cl_device_id>(hDevice));
+  cl_device_id CLDevice = hDevice->CLDevice;
+  {
+    device_registry_t &Registry = getDeviceRegistry();
+    std::lock_guard<std::mutex> Lock{Registry.Mutex};
+    if (--hDevice->RefCount != 0) {
+      return UR_RESULT_SUCCESS;
+    }
+    Registry.erase(CLDevice);
+  }
+  delete hDevice;
 
-  return mapCLErrorToUR(Result);
+  CL_RETURN_ON_FAILURE(clReleaseDevice(CLDevice));
+  return UR_RESULT_SUCCESS;
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetNativeHandle(
     ur_device_handle_t hDevice, ur_native_handle_t *phNativeDevice) {
 
-  *phNativeDevice = reinterpret_cast<ur_native_handle_t>(hDevice);
+  *phNativeDevice = reinterpret_cast<ur_native_handle_t>(hDevice->CLDevice);
   return UR_RESULT_SUCCESS;
 }
 
@@ -1324,28 +1339,21 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceCreateWithNativeHandle(
     ur_native_handle_t hNativeDevice, ur_adapter_handle_t,
     const ur_device_native_properties_t *, ur_device_handle_t *phDevice) {
 
-  *phDevice = reinterpret_cast<ur_device_handle_t>(hNativeDevice);
-  return UR_RESULT_SUCCESS;
+  return ur_device_handle_t_::get(
+      reinterpret_cast<cl_device_id>(hNativeDevice), *phDevice);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urDeviceGetGlobalTimestamps(
     ur_device_handle_t hDevice, uint64_t *pDeviceTimestamp,
     uint64_t *pHostTimestamp) {
-  oclv::OpenCLVersion DevVer, PlatVer;
-  cl_platform_id Platform;
-  cl_device_id DeviceId = cl_adapter::cast<cl_device_id>(hDevice);
-
-  // TODO: Cache OpenCL version for each device and platform
-  auto RetErr = clGetDeviceInfo(DeviceId, CL_DEVICE_PLATFORM,
-                                sizeof(cl_platform_id), &Platform, nullptr);
-  CL_RETURN_ON_FAILURE(RetErr);
-
-  RetErr = cl_adapter::getDeviceVersion(DeviceId, DevVer);
-  CL_RETURN_ON_FAILURE(RetErr);
+  oclv::OpenCLVersion PlatVer;
+  cl_device_id DeviceId = hDevice->CLDevice;
 
-  RetErr = cl_adapter::getPlatformVersion(Platform, PlatVer);
+  // TODO: Cache OpenCL version for each platform
+  UR_RETURN_ON_FAILURE(
+      cl_adapter::getPlatformVersion(hDevice->Platform, PlatVer));
 
-  if (PlatVer < oclv::V2_1 || DevVer < oclv::V2_1) {
+  if (PlatVer < oclv::V2_1 || hDevice->Version < oclv::V2_1) {
     return UR_RESULT_ERROR_INVALID_OPERATION;
   }
 
@@ -1384,7 +1392,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urDeviceSelectBinary(
   cl_device_type DeviceType;
   constexpr uint32_t InvalidInd = std::numeric_limits<uint32_t>::max();
   cl_int RetErr =
-      clGetDeviceInfo(cl_adapter::cast<cl_device_id>(hDevice), CL_DEVICE_TYPE,
+      clGetDeviceInfo(hDevice->CLDevice, CL_DEVICE_TYPE,
                       sizeof(cl_device_type), &DeviceType, nullptr);
   if (RetErr != CL_SUCCESS) {
     *pSelectedBinary = InvalidInd;
@@ -11,10 +11,37 @@
 
 #include "common.hpp"
 
-namespace cl_adapter {
-ur_result_t getDeviceVersion(cl_device_id Dev, oclv::OpenCLVersion &Version);
+#include <atomic>
+#include <set>
+#include <string_view>
 
-ur_result_t checkDeviceExtensions(cl_device_id Dev,
-                                  const std::vector<std::string> &Exts,
-                                  bool &Supported);
-} // namespace cl_adapter
+/// Wraps a cl_device_id together with the properties the adapter queries
+/// repeatedly. Root devices live until the adapter is unloaded, sub-devices
+/// are reference counted and release their OpenCL device with the last UR
+/// reference.
+struct ur_device_handle_t_ {
+  /// Returns the handle of a device returned by OpenCL, creating it if needed.
+  /// No UR reference is added; a new handle of a sub-device retains Dev.
+  static ur_result_t get(cl_device_id Dev, ur_device_handle_t &Device);
+
+  /// Creates the handle of a sub-device, taking over one OpenCL reference,
+  /// which is dropped on failure.
+  static ur_result_t makeSubDevice(cl_device_id Dev,
+                                   ur_device_handle_t &Device);
+
+  /// Returns true if the device reports all of Exts.
+  bool checkExtensions(std::initializer_list<std::string_view> Exts) const;
+
+  cl_device_id CLDevice;
+  cl_platform_id Platform = nullptr;
+  bool IsSubDevice = false;
+  /// CL_DEVICE_VERSION, invalid (0.0) if the device reported a malformed one.
+  oclv::OpenCLVersion Version;
+  /// Tokens of CL_DEVICE_EXTENSIONS.
+  std::set<std::string, std::less<>> Extensions;
+  std::atomic<uint32_t> RefCount = 1;
+
+private:
+  explicit ur_device_handle_t_(cl_device_id Dev) : CLDevice(Dev) {}
+  ur_result_t initialize();
+};
@@ -9,6 +9,11 @@
 //===----------------------------------------------------------------------===//
 
 #include "common.hpp"
+#include "context.hpp"
+#include "kernel.hpp"
+#include "queue.hpp"
+
+#include <thread>
 
 cl_map_flags convertURMapFlagsToCL(ur_map_flags_t URFlags) {
   cl_map_flags CLFlags = 0;
@@ -30,32 +35,19 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueKernelLaunch(
     const size_t *pGlobalWorkOffset, const size_t *pGlobalWorkSize,
     const size_t *pLocalWorkSize, uint32_t numEventsInWaitList,
     const ur_event_handle_t *phEventWaitList, ur_event_handle_t *phEvent) {
-  std::vector<size_t> compiledLocalWorksize;
+  // The compile work-group size always has three entries, all zeroes if the
+  // kernel doesn't specify one.
+  std::array<size_t, 3> CompiledLocalWorkSize = {0, 0, 0};
   if (!pLocalWorkSize) {
-    cl_device_id device = nullptr;
-    CL_RETURN_ON_FAILURE(clGetCommandQueueInfo(
-        cl_adapter::cast<cl_command_queue>(hQueue), CL_QUEUE_DEVICE,
-        sizeof(device), &device, nullptr));
-    // This query always returns size_t[3], if nothing was specified it returns
-    // all zeroes.
-    size_t queriedLocalWorkSize[3] = {0, 0, 0};
-    CL_RETURN_ON_FAILURE(clGetKernelWorkGroupInfo(
-        cl_adapter::cast<cl_kernel>(hKernel), device,
-        CL_KERNEL_COMPILE_WORK_GROUP_SIZE, sizeof(size_t[3]),
-        queriedLocalWorkSize, nullptr));
-    if (queriedLocalWorkSize[0] != 0) {
-      for (uint32_t i = 0; i < workDim; i++) {
-        compiledLocalWorksize.push_back(queriedLocalWorkSize[i]);
-      }
-    }
+    UR_RETURN_ON_FAILURE(hKernel->getCompileWorkGroupSize(
+        hQueue->Device, CompiledLocalWorkSize));
   }
 
   CL_RETURN_ON_FAILURE(clEnqueueNDRangeKernel(
-      cl_adapter::cast<cl_command_queue>(hQueue),
-      cl_adapter::cast<cl_kernel>(hKernel), workDim, pGlobalWorkOffset,
+      hQueue->CLQueue, hKernel->CLKernel, workDim, pGlobalWorkOffset,
       pGlobalWorkSize,
-      compiledLocalWorksize.empty() ? pLocalWorkSize
-                                    : compiledLocalWorksize.data(),
+      CompiledLocalWorkSize[0] == 0 ? pLocalWorkSize
+                                    : CompiledLocalWorkSize.data(),
       numEventsInWaitList, cl_adapter::cast<const cl_event *>(phEventWaitList),
       cl_adapter::cast<cl_event *>(phEvent)));
 
@@ -77,7 +69,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueEventsWait(
     const ur_event_handle_t *phEventWaitList, ur_event_handle_t *phEvent) {
 
   CL_RETURN_ON_FAILURE(clEnqueueMarkerWithWaitList(
-      cl_adapter::cast<cl_command_queue>(hQueue), numEventsInWaitList,
+      hQueue->CLQueue, numEventsInWaitList,
       cl_adapter::cast<const cl_event *>(phEventWaitList),
       cl_adapter::cast<cl_event *>(phEvent)));
 
@@ -89,7 +81,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueEventsWaitWithBarrier(
     const ur_event_handle_t *phEventWaitList, ur_event_handle_t *phEvent) {
 
   CL_RETURN_ON_FAILURE(clEnqueueBarrierWithWaitList(
-      cl_adapter::cast<cl_command_queue>(hQueue), numEventsInWaitList,
+      hQueue->CLQueue, numEventsInWaitList,
       cl_adapter::cast<const cl_event *>(phEventWaitList),
       cl_adapter::cast<cl_event *>(phEvent)));
 
@@ -104,16 +96,102 @@ UR_APIEXPORT ur_result_t urEnqueueEventsWaitWithBarrierExt(
                                         phEventWaitList, phEvent);
 }
 
+UR_APIEXPORT ur_result_t UR_APICALL urEnqueueHostTaskExp(
+    ur_queue_handle_t hQueue, ur_exp_host_task_function_t pfnHostTask,
+    void *pUserData, uint32_t numEventsInWaitList,
+    const ur_event_handle_t *phEventWaitList, ur_event_handle_t *phEvent) {
+  // The completion callback of a marker for the wait list starts the task on
+  // a host thread, which then completes a user event that a second marker,
+  // the one returned in phEvent, waits for. The calling thread never blocks.
+  struct HostTask {
+    ur_exp_host_task_function_t pfnHostTask;
+    void *pUserData;
+    cl_event UserEvent;
+  };
+
+  cl_int Res = CL_SUCCESS;
+  cl_event UserEvent = clCreateUserEvent(hQueue->Context->CLContext, &Res);
+  CL_RETURN_ON_FAILURE(Res);
+
+  cl_event Marker = nullptr;
+  Res = clEnqueueMarkerWithWaitList(
+      hQueue->CLQueue, numEventsInWaitList,
+      cl_adapter::cast<const cl_event *>(phEventWaitList), &Marker);
+  if (Res != CL_SUCCESS) {
+    clReleaseEvent(UserEvent);
+    return mapCLErrorToUR(Res);
+  }
+  Res = clEnqueueMarkerWithWaitList(hQueue->CLQueue, 1, &UserEvent,
+                                    cl_adapter::cast<cl_event *>(phEvent));
+  if (Res != CL_SUCCESS) {
+    clReleaseEvent(Marker);
+    clReleaseEvent(UserEvent);
+    return mapCLErrorToUR(Res);
+  }
+
+  // The callback takes over the references to both events.
+  auto Task = new HostTask({pfnHostTask, pUserData, UserEvent});
+  auto ClCallback = [](cl_event Marker, cl_int Status, void *pUserData) {
+    auto *Task = static_cast<HostTask *>(pUserData);
+    clReleaseEvent(Marker);
+    auto Run = [Task, Status]() {
+      if (Status == CL_COMPLETE) {
+        Task->pfnHostTask(Task->pUserData);
+      }
+      clSetUserEventStatus(Task->UserEvent, Status);
+      clReleaseEvent(Task->UserEvent);
+      delete Task;
+    };
+    // Blocking CL calls are undefined in callbacks, and host tasks usually
+    // make them, so the task runs on a thread of its own.
+    try {
+      std::thread(Run).detach();
+    } catch (...) {
+      clSetUserEventStatus(Task->UserEvent, CL_OUT_OF_HOST_MEMORY);
+      clReleaseEvent(Task->UserEvent);
+      delete Task;
+    }
+  };
+  Res = clSetEventCallback(Marker, CL_COMPLETE, ClCallback, Task);
+  if (Res != CL_SUCCESS) {
+    // Fail the commands waiting for the task instead of leaving them stuck.
+    clSetUserEventStatus(UserEvent, Res);
+    clReleaseEvent(Marker);
+    clReleaseEvent(UserEvent);
+    delete Task;
+    return mapCLErrorToUR(Res);
+  }
+  CL_RETURN_ON_FAILURE(clFlush(hQueue->CLQueue));
+
+  return UR_RESULT_SUCCESS;
+}
+
+UR_APIEXPORT ur_result_t UR_APICALL urEnqueueUSMAllocExp(
+    ur_queue_handle_t hQueue, const ur_usm_desc_t *pUSMDesc, size_t size,
+    uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
+    void **ppMem, ur_event_handle_t *phEvent) {
+  return hQueue->USMArena->enqueueAlloc(hQueue, pUSMDesc, size,
+                                        numEventsInWaitList, phEventWaitList,
+                                        ppMem, phEvent);
+}
+
+UR_APIEXPORT ur_result_t UR_APICALL urEnqueueUSMFreeExp(
+    ur_queue_handle_t hQueue, void *pMem, uint32_t numEventsInWaitList,
+    const ur_event_handle_t *phEventWaitList, ur_event_handle_t *phEvent) {
+  return hQueue->USMArena->enqueueFree(hQueue, pMem, numEventsInWaitList,
+                                       phEventWaitList, phEvent);
+}
+
 UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemBufferRead(
     ur_queue_handle_t hQueue, ur_mem_handle_t hBuffer, bool blockingRead,
     size_t offset, size_t size, void *pDst, uint32_t numEventsInWaitList,
     const ur_event_handle_t *phEventWaitList, ur_event_handle_t *phEvent) {
 
-  CL_RETURN_ON_FAILURE(clEnqueueReadBuffer(
-      cl_adapter::cast<cl_command_queue>(hQueue),
-      cl_adapter::cast<cl_mem>(hBuffer), blockingRead, offset, size, pDst,
-      numEventsInWaitList, cl_adapter::cast<const cl_event *>(phEventWaitList),
-      cl_adapter::cast<cl_event *>(phEvent)));
+  CL_RETURN_ON_FAILURE(
+      clEnqueueReadBuffer(hQueue->CLQueue, cl_adapter::cast<cl_mem>(hBuffer),
+                          blockingRead, offset, size, pDst, numEventsInWaitList,
+                          cl_adapter::cast<const cl_event *>(phEventWaitList),
+                          cl_adapter::cast<cl_event *>(phEvent)));
 
   return UR_RESULT_SUCCESS;
 }
@@ -124,9 +202,9 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemBufferWrite(
     const ur_event_handle_t *phEventWaitList, ur_event_handle_t *phEvent) {
 
   CL_RETURN_ON_FAILURE(clEnqueueWriteBuffer(
-      cl_adapter::cast<cl_command_queue>(hQueue),
-      cl_adapter::cast<cl_mem>(hBuffer), blockingWrite, offset, size, pSrc,
-      numEventsInWaitList, cl_adapter::cast<const cl_event *>(phEventWaitList),
+      hQueue->CLQueue, cl_adapter::cast<cl_mem>(hBuffer), blockingWrite, offset,
+      size, pSrc, numEventsInWaitList,
+      cl_adapter::cast<const cl_event *>(phEventWaitList),
       cl_adapter::cast<cl_event *>(phEvent)));
 
   return UR_RESULT_SUCCESS;
@@ -145,10 +223,9 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemBufferReadRect(
   const size_t Region[3] = {region.width, region.height, region.depth};
 
   CL_RETURN_ON_FAILURE(clEnqueueReadBufferRect(
-      cl_adapter::cast<cl_command_queue>(hQueue),
-      cl_adapter::cast<cl_mem>(hBuffer), blockingRead, BufferOrigin, HostOrigin,
-      Region, bufferRowPitch, bufferSlicePitch, hostRowPitch, hostSlicePitch,
-      pDst, numEventsInWaitList,
+      hQueue->CLQueue, cl_adapter::cast<cl_mem>(hBuffer), blockingRead,
+      BufferOrigin, HostOrigin, Region, bufferRowPitch, bufferSlicePitch,
+      hostRowPitch, hostSlicePitch, pDst, numEventsInWaitList,
       cl_adapter::cast<const cl_event *>(phEventWaitList),
       cl_adapter::cast<cl_event *>(phEvent)));
 
@@ -168,10 +245,9 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemBufferWriteRect(
   const size_t Region[3] = {region.width, region.height, region.depth};
 
   CL_RETURN_ON_FAILURE(clEnqueueWriteBufferRect(
-      cl_adapter::cast<cl_command_queue>(hQueue),
-      cl_adapter::cast<cl_mem>(hBuffer), blockingWrite, BufferOrigin,
-      HostOrigin, Region, bufferRowPitch, bufferSlicePitch, hostRowPitch,
-      hostSlicePitch, pSrc, numEventsInWaitList,
+      hQueue->CLQueue, cl_adapter::cast<cl_mem>(hBuffer), blockingWrite,
+      BufferOrigin, HostOrigin, Region, bufferRowPitch, bufferSlicePitch,
+      hostRowPitch, hostSlicePitch, pSrc, numEventsInWaitList,
       cl_adapter::cast<const cl_event *>(phEventWaitList),
       cl_adapter::cast<cl_event *>(phEvent)));
 
@@ -185,8 +261,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemBufferCopy(
     ur_event_handle_t *phEvent) {
 
   CL_RETURN_ON_FAILURE(clEnqueueCopyBuffer(
-      cl_adapter::cast<cl_command_queue>(hQueue),
-      cl_adapter::cast<cl_mem>(hBufferSrc),
+      hQueue->CLQueue, cl_adapter::cast<cl_mem>(hBufferSrc),
       cl_adapter::cast<cl_mem>(hBufferDst), srcOffset, dstOffset, size,
       numEventsInWaitList, cl_adapter::cast<const cl_event *>(phEventWaitList),
       cl_adapter::cast<cl_event *>(phEvent)));
@@ -206,8 +281,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemBufferCopyRect(
   const size_t Region[3] = {region.width, region.height, region.depth};
 
   CL_RETURN_ON_FAILURE(clEnqueueCopyBufferRect(
-      cl_adapter::cast<cl_command_queue>(hQueue),
-      cl_adapter::cast<cl_mem>(hBufferSrc),
+      hQueue->CLQueue, cl_adapter::cast<cl_mem>(hBufferSrc),
       cl_adapter::cast<cl_mem>(hBufferDst), SrcOrigin, DstOrigin, Region,
       srcRowPitch, srcSlicePitch, dstRowPitch, dstSlicePitch,
       numEventsInWaitList, cl_adapter::cast<const cl_event *>(phEventWaitList),
@@ -224,12 +298,11 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemBufferFill(
   // CL FillBuffer only allows pattern sizes up to the largest CL type:
   // long16/double16
   if (patternSize <= 128) {
-    CL_RETURN_ON_FAILURE(
-        clEnqueueFillBuffer(cl_adapter::cast<cl_command_queue>(hQueue),
-                            cl_adapter::cast<cl_mem>(hBuffer), pPattern,
-                            patternSize, offset, size, numEventsInWaitList,
-                            cl_adapter::cast<const cl_event *>(phEventWaitList),
-                            cl_adapter::cast<cl_event *>(phEvent)));
+    CL_RETURN_ON_FAILURE(clEnqueueFillBuffer(
+        hQueue->CLQueue, cl_adapter::cast<cl_mem>(hBuffer), pPattern,
+        patternSize, offset, size, numEventsInWaitList,
+        cl_adapter::cast<const cl_event *>(phEventWaitList),
+        cl_adapter::cast<cl_event *>(phEvent)));
     return UR_RESULT_SUCCESS;
   }
 
@@ -242,10 +315,9 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemBufferFill(
 
   cl_event WriteEvent = nullptr;
   auto ClErr = clEnqueueWriteBuffer(
-      cl_adapter::cast<cl_command_queue>(hQueue),
-      cl_adapter::cast<cl_mem>(hBuffer), false, offset, size, HostBuffer,
-      numEventsInWaitList, cl_adapter::cast<const cl_event *>(phEventWaitList),
-      &WriteEvent);
+      hQueue->CLQueue, cl_adapter::cast<cl_mem>(hBuffer), false, offset, size,
+      HostBuffer, numEventsInWaitList,
+      cl_adapter::cast<const cl_event *>(phEventWaitList), &WriteEvent);
   if (ClErr != CL_SUCCESS) {
     delete[] HostBuffer;
     CL_RETURN_ON_FAILURE(ClErr);
@@ -283,9 +355,8 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemImageRead(
   const size_t Region[3] = {region.width, region.height, region.depth};
 
   CL_RETURN_ON_FAILURE(clEnqueueReadImage(
-      cl_adapter::cast<cl_command_queue>(hQueue),
-      cl_adapter::cast<cl_mem>(hImage), blockingRead, Origin, Region, rowPitch,
-      slicePitch, pDst, numEventsInWaitList,
+      hQueue->CLQueue, cl_adapter::cast<cl_mem>(hImage), blockingRead, Origin,
+      Region, rowPitch, slicePitch, pDst, numEventsInWaitList,
       cl_adapter::cast<const cl_event *>(phEventWaitList),
       cl_adapter::cast<cl_event *>(phEvent)));
 
@@ -301,9 +372,8 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemImageWrite(
   const size_t Region[3] = {region.width, region.height, region.depth};
 
   CL_RETURN_ON_FAILURE(clEnqueueWriteImage(
-      cl_adapter::cast<cl_command_queue>(hQueue),
-      cl_adapter::cast<cl_mem>(hImage), blockingWrite, Origin, Region, rowPitch,
-      slicePitch, pSrc, numEventsInWaitList,
+      hQueue->CLQueue, cl_adapter::cast<cl_mem>(hImage), blockingWrite, Origin,
+      Region, rowPitch, slicePitch, pSrc, numEventsInWaitList,
       cl_adapter::cast<const cl_event *>(phEventWaitList),
       cl_adapter::cast<cl_event *>(phEvent)));
 
@@ -321,10 +391,9 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemImageCopy(
   const size_t Region[3] = {region.width, region.height, region.depth};
 
   CL_RETURN_ON_FAILURE(clEnqueueCopyImage(
-      cl_adapter::cast<cl_command_queue>(hQueue),
-      cl_adapter::cast<cl_mem>(hImageSrc), cl_adapter::cast<cl_mem>(hImageDst),
-      SrcOrigin, DstOrigin, Region, numEventsInWaitList,
-      cl_adapter::cast<const cl_event *>(phEventWaitList),
+      hQueue->CLQueue, cl_adapter::cast<cl_mem>(hImageSrc),
+      cl_adapter::cast<cl_mem>(hImageDst), SrcOrigin, DstOrigin, Region,
+      numEventsInWaitList, cl_adapter::cast<const cl_event *>(phEventWaitList),
       cl_adapter::cast<cl_event *>(phEvent)));
 
   return UR_RESULT_SUCCESS;
@@ -338,8 +407,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemBufferMap(
 
   cl_int Err;
   *ppRetMap = clEnqueueMapBuffer(
-      cl_adapter::cast<cl_command_queue>(hQueue),
-      cl_adapter::cast<cl_mem>(hBuffer), blockingMap,
+      hQueue->CLQueue, cl_adapter::cast<cl_mem>(hBuffer), blockingMap,
       convertURMapFlagsToCL(mapFlags), offset, size, numEventsInWaitList,
       cl_adapter::cast<const cl_event *>(phEventWaitList),
       cl_adapter::cast<cl_event *>(phEvent), &Err);
@@ -353,9 +421,8 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemUnmap(
     ur_event_handle_t *phEvent) {
 
   CL_RETURN_ON_FAILURE(clEnqueueUnmapMemObject(
-      cl_adapter::cast<cl_command_queue>(hQueue),
-      cl_adapter::cast<cl_mem>(hMem), pMappedPtr, numEventsInWaitList,
-      cl_adapter::cast<const cl_event *>(phEventWaitList),
+      hQueue->CLQueue, cl_adapter::cast<cl_mem>(hMem), pMappedPtr,
+      numEventsInWaitList, cl_adapter::cast<const cl_event *>(phEventWaitList),
       cl_adapter::cast<cl_event *>(phEvent)));
 
   return UR_RESULT_SUCCESS;
@@ -367,24 +434,16 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueDeviceGlobalVariableWrite(
     uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
     ur_event_handle_t *phEvent) {
 
-  cl_context Ctx = nullptr;
-  cl_int Res =
-      clGetCommandQueueInfo(cl_adapter::cast<cl_command_queue>(hQueue),
-                            CL_QUEUE_CONTEXT, sizeof(Ctx), &Ctx, nullptr);
-
-  if (Res != CL_SUCCESS)
-    return mapCLErrorToUR(Res);
-
-  cl_ext::clEnqueueWriteGlobalVariable_fn F = nullptr;
-  UR_RETURN_ON_FAILURE(cl_ext::getExtFuncFromContext<decltype(F)>(
-      Ctx, cl_ext::ExtFuncPtrCache->clEnqueueWriteGlobalVariableCache,
-      cl_ext::EnqueueWriteGlobalVariableName, &F));
+  cl_ext::clEnqueueWriteGlobalVariable_fn F =
+      hQueue->Context->ExtFuncs.clEnqueueWriteGlobalVariable;
+  if (!F) {
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  }
 
-  Res = F(cl_adapter::cast<cl_command_queue>(hQueue),
-          cl_adapter::cast<cl_program>(hProgram), name, blockingWrite, count,
-          offset, pSrc, numEventsInWaitList,
-          cl_adapter::cast<const cl_event *>(phEventWaitList),
-          cl_adapter::cast<cl_event *>(phEvent));
+  cl_int Res = F(hQueue->CLQueue, cl_adapter::cast<cl_program>(hProgram), name,
+                 blockingWrite, count, offset, pSrc, numEventsInWaitList,
+                 cl_adapter::cast<const cl_event *>(phEventWaitList),
+                 cl_adapter::cast<cl_event *>(phEvent));
 
   return mapCLErrorToUR(Res);
 }
@@ -395,24 +454,16 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueDeviceGlobalVariableRead(
     uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
     ur_event_handle_t *phEvent) {
 
-  cl_context Ctx = nullptr;
-  cl_int Res =
-      clGetCommandQueueInfo(cl_adapter::cast<cl_command_queue>(hQueue),
-                            CL_QUEUE_CONTEXT, sizeof(Ctx), &Ctx, nullptr);
-
-  if (Res != CL_SUCCESS)
-    return mapCLErrorToUR(Res);
-
-  cl_ext::clEnqueueReadGlobalVariable_fn F = nullptr;
-  UR_RETURN_ON_FAILURE(cl_ext::getExtFuncFromContext<decltype(F)>(
-      Ctx, cl_ext::ExtFuncPtrCache->clEnqueueReadGlobalVariableCache,
-      cl_ext::EnqueueReadGlobalVariableName, &F));
+  cl_ext::clEnqueueReadGlobalVariable_fn F =
+      hQueue->Context->ExtFuncs.clEnqueueReadGlobalVariable;
+  if (!F) {
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  }
 
-  Res = F(cl_adapter::cast<cl_command_queue>(hQueue),
-          cl_adapter::cast<cl_program>(hProgram), name, blockingRead, count,
-          offset, pDst, numEventsInWaitList,
-          cl_adapter::cast<const cl_event *>(phEventWaitList),
-          cl_adapter::cast<cl_event *>(phEvent));
+  cl_int Res = F(hQueue->CLQueue, cl_adapter::cast<cl_program>(hProgram), name,
+                 blockingRead, count, offset, pDst, numEventsInWaitList,
+                 cl_adapter::cast<const cl_event *>(phEventWaitList),
+                 cl_adapter::cast<cl_event *>(phEvent));
 
   return mapCLErrorToUR(Res);
 }
@@ -423,28 +474,17 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueReadHostPipe(
     uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
     ur_event_handle_t *phEvent) {
 
-  cl_context CLContext;
-  cl_int CLErr = clGetCommandQueueInfo(
-      cl_adapter::cast<cl_command_queue>(hQueue), CL_QUEUE_CONTEXT,
-      sizeof(cl_context), &CLContext, nullptr);
-  if (CLErr != CL_SUCCESS) {
-    return mapCLErrorToUR(CLErr);
+  cl_ext::clEnqueueReadHostPipeINTEL_fn FuncPtr =
+      hQueue->Context->ExtFuncs.clEnqueueReadHostPipeINTEL;
+  if (!FuncPtr) {
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
   }
 
-  cl_ext::clEnqueueReadHostPipeINTEL_fn FuncPtr = nullptr;
-  UR_RETURN_ON_FAILURE(
-      cl_ext::getExtFuncFromContext<cl_ext::clEnqueueReadHostPipeINTEL_fn>(
-          CLContext, cl_ext::ExtFuncPtrCache->clEnqueueReadHostPipeINTELCache,
-          cl_ext::EnqueueReadHostPipeName, &FuncPtr));
-
-  if (FuncPtr) {
-    CL_RETURN_ON_FAILURE(
-        FuncPtr(cl_adapter::cast<cl_command_queue>(hQueue),
-                cl_adapter::cast<cl_program>(hProgram), pipe_symbol, blocking,
-                pDst, size, numEventsInWaitList,
-                cl_adapter::cast<const cl_event *>(phEventWaitList),
-                cl_adapter::cast<cl_event *>(phEvent)));
-  }
+  CL_RETURN_ON_FAILURE(
+      FuncPtr(hQueue->CLQueue, cl_adapter::cast<cl_program>(hProgram),
+              pipe_symbol, blocking, pDst, size, numEventsInWaitList,
+              cl_adapter::cast<const cl_event *>(phEventWaitList),
+              cl_adapter::cast<cl_event *>(phEvent)));
 
   return UR_RESULT_SUCCESS;
 }
@@ -455,28 +495,17 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueWriteHostPipe(
     uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
     ur_event_handle_t *phEvent) {
 
-  cl_context CLContext;
-  cl_int CLErr = clGetCommandQueueInfo(
-      cl_adapter::cast<cl_command_queue>(hQueue), CL_QUEUE_CONTEXT,
-      sizeof(cl_context), &CLContext, nullptr);
-  if (CLErr != CL_SUCCESS) {
-    return mapCLErrorToUR(CLErr);
+  cl_ext::clEnqueueWriteHostPipeINTEL_fn FuncPtr =
+      hQueue->Context->ExtFuncs.clEnqueueWriteHostPipeINTEL;
+  if (!FuncPtr) {
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
   }
 
-  cl_ext::clEnqueueWriteHostPipeINTEL_fn FuncPtr = nullptr;
-  UR_RETURN_ON_FAILURE(
-      cl_ext::getExtFuncFromContext<cl_ext::clEnqueueWriteHostPipeINTEL_fn>(
-          CLContext, cl_ext::ExtFuncPtrCache->clEnqueueWriteHostPipeINTELCache,
-          cl_ext::EnqueueWriteHostPipeName, &FuncPtr));
-
-  if (FuncPtr) {
-    CL_RETURN_ON_FAILURE(
-        FuncPtr(cl_adapter::cast<cl_command_queue>(hQueue),
-                cl_adapter::cast<cl_program>(hProgram), pipe_symbol, blocking,
-                pSrc, size, numEventsInWaitList,
-                cl_adapter::cast<const cl_event *>(phEventWaitList),
-                cl_adapter::cast<cl_event *>(phEvent)));
-  }
+  CL_RETURN_ON_FAILURE(
+      FuncPtr(hQueue->CLQueue, cl_adapter::cast<cl_program>(hProgram),
+              pipe_symbol, blocking, pSrc, size, numEventsInWaitList,
+              cl_adapter::cast<const cl_event *>(phEventWaitList),
+              cl_adapter::cast<cl_event *>(phEvent)));
 
   return UR_RESULT_SUCCESS;
 }
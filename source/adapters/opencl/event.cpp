@@ -9,6 +9,8 @@
 //===----------------------------------------------------------------------===//
 
 #include "common.hpp"
+#include "context.hpp"
+#include "queue.hpp"
 
 #include <mutex>
 #include <set>
@@ -177,6 +179,19 @@ UR_APIEXPORT ur_result_t UR_APICALL urEventGetInfo(ur_event_handle_t hEvent,
         // terminated in an unexpected way.
         *param_value_int = UR_EVENT_STATUS_ERROR;
       }
+    } else if (propName == UR_EVENT_INFO_COMMAND_QUEUE) {
+      // User events have no queue.
+      cl_command_queue CLQueue = *static_cast<cl_command_queue *>(pPropValue);
+      ur_queue_handle_t Queue = nullptr;
+      if (CLQueue) {
+        UR_RETURN_ON_FAILURE(ur_queue_handle_t_::get(CLQueue, Queue));
+      }
+      *static_cast<ur_queue_handle_t *>(pPropValue) = Queue;
+    } else if (propName == UR_EVENT_INFO_CONTEXT) {
+      cl_context CLContext = *static_cast<cl_context *>(pPropValue);
+      ur_context_handle_t Context = nullptr;
+      UR_RETURN_ON_FAILURE(ur_context_handle_t_::get(CLContext, Context));
+      *static_cast<ur_context_handle_t *>(pPropValue) = Context;
     }
   }
 
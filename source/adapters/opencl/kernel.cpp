@@ -7,29 +7,77 @@
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 //
 //===----------------------------------------------------------------------===//
+#include "kernel.hpp"
 #include "common.hpp"
+#include "context.hpp"
 #include "device.hpp"
+#include "queue.hpp"
 
 #include <algorithm>
 #include <cstddef>
 #include <memory>
 
+ur_result_t ur_kernel_handle_t_::make(cl_kernel Kernel,
+                                      ur_program_handle_t Program,
+                                      ur_kernel_handle_t &Handle) {
+  cl_context CLContext;
+  ur_context_handle_t Context;
+  if (cl_int Res = clGetKernelInfo(Kernel, CL_KERNEL_CONTEXT,
+                                   sizeof(cl_context), &CLContext, nullptr);
+      Res != CL_SUCCESS) {
+    clReleaseKernel(Kernel);
+    return mapCLErrorToUR(Res);
+  }
+  if (ur_result_t Res = ur_context_handle_t_::get(CLContext, Context);
+      Res != UR_RESULT_SUCCESS) {
+    clReleaseKernel(Kernel);
+    return Res;
+  }
+
+  urContextRetain(Context);
+  Handle = new ur_kernel_handle_t_(Kernel, Program, Context);
+  return UR_RESULT_SUCCESS;
+}
+
+ur_kernel_handle_t_::~ur_kernel_handle_t_() {
+  clReleaseKernel(CLKernel);
+  urContextRelease(Context);
+}
+
+ur_result_t
+ur_kernel_handle_t_::getCompileWorkGroupSize(ur_device_handle_t Device,
+                                             std::array<size_t, 3> &Size) {
+  std::lock_guard<std::mutex> Lock{CompileWorkGroupSizesMutex};
+  for (const auto &[CachedDevice, CachedSize] : CompileWorkGroupSizes) {
+    if (CachedDevice == Device) {
+      Size = CachedSize;
+      return UR_RESULT_SUCCESS;
+    }
+  }
+
+  CL_RETURN_ON_FAILURE(clGetKernelWorkGroupInfo(
+      CLKernel, Device->CLDevice, CL_KERNEL_COMPILE_WORK_GROUP_SIZE,
+      sizeof(Size), Size.data(), nullptr));
+  CompileWorkGroupSizes.emplace_back(Device, Size);
+  return UR_RESULT_SUCCESS;
+}
+
 UR_APIEXPORT ur_result_t UR_APICALL
 urKernelCreate(ur_program_handle_t hProgram, const char *pKernelName,
                ur_kernel_handle_t *phKernel) {
 
   cl_int CLResult;
-  *phKernel = cl_adapter::cast<ur_kernel_handle_t>(clCreateKernel(
-      cl_adapter::cast<cl_program>(hProgram), pKernelName, &CLResult));
-  CL_RETURN_ON_FAILURE(CLResult);
-  return UR_RESULT_SUCCESS;
+  cl_kernel Kernel = clCreateKernel(cl_adapter::cast<cl_program>(hProgram),
+                                    pKernelName, &CLResult);
+  CL_RETURN_ON_FAILURE_AND_SET_NULL(CLResult, phKernel);
+  return ur_kernel_handle_t_::make(Kernel, hProgram, *phKernel);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urKernelSetArgValue(
     ur_kernel_handle_t hKernel, uint32_t argIndex, size_t argSize,
     const ur_kernel_arg_value_properties_t *, const void *pArgValue) {
 
-  CL_RETURN_ON_FAILURE(clSetKernelArg(cl_adapter::cast<cl_kernel>(hKernel),
+  CL_RETURN_ON_FAILURE(clSetKernelArg(hKernel->CLKernel,
                                       cl_adapter::cast<cl_uint>(argIndex),
                                       argSize, pArgValue));
 
@@ -40,7 +88,7 @@ UR_APIEXPORT ur_result_t UR_APICALL
 urKernelSetArgLocal(ur_kernel_handle_t hKernel, uint32_t argIndex,
                     size_t argSize, const ur_kernel_arg_local_properties_t *) {
 
-  CL_RETURN_ON_FAILURE(clSetKernelArg(cl_adapter::cast<cl_kernel>(hKernel),
+  CL_RETURN_ON_FAILURE(clSetKernelArg(hKernel->CLKernel,
                                       cl_adapter::cast<cl_uint>(argIndex),
                                       argSize, nullptr));
 
@@ -82,8 +130,21 @@ UR_APIEXPORT ur_result_t UR_APICALL urKernelGetInfo(ur_kernel_handle_t hKernel,
   if (propName == UR_KERNEL_INFO_SPILL_MEM_SIZE) {
     return UR_RESULT_ERROR_UNSUPPORTED_ENUMERATION;
   }
+
+  UrReturnHelper ReturnValue(propSize, pPropValue, pPropSizeRet);
+  switch (propName) {
+  case UR_KERNEL_INFO_CONTEXT:
+    return ReturnValue(hKernel->Context);
+  case UR_KERNEL_INFO_PROGRAM:
+    return ReturnValue(hKernel->Program);
+  case UR_KERNEL_INFO_REFERENCE_COUNT:
+    return ReturnValue(hKernel->RefCount.load());
+  default:
+    break;
+  }
+
   size_t CheckPropSize = 0;
-  cl_int ClResult = clGetKernelInfo(cl_adapter::cast<cl_kernel>(hKernel),
+  cl_int ClResult = clGetKernelInfo(hKernel->CLKernel,
                                     mapURKernelInfoToCL(propName), propSize,
                                     pPropValue, &CheckPropSize);
   if (pPropValue && CheckPropSize != propSize) {
@@ -129,7 +190,7 @@ urKernelGetGroupInfo(ur_kernel_handle_t hKernel, ur_device_handle_t hDevice,
   if (propName == UR_KERNEL_GROUP_INFO_GLOBAL_WORK_SIZE) {
     cl_device_type ClDeviceType;
     CL_RETURN_ON_FAILURE(
-        clGetDeviceInfo(cl_adapter::cast<cl_device_id>(hDevice), CL_DEVICE_TYPE,
+        clGetDeviceInfo(hDevice->CLDevice, CL_DEVICE_TYPE,
                         sizeof(ClDeviceType), &ClDeviceType, nullptr));
     if (ClDeviceType != CL_DEVICE_TYPE_CUSTOM) {
       return UR_RESULT_ERROR_UNSUPPORTED_ENUMERATION;
@@ -140,8 +201,8 @@ urKernelGetGroupInfo(ur_kernel_handle_t hKernel, ur_device_handle_t hDevice,
     return UR_RESULT_ERROR_UNSUPPORTED_ENUMERATION;
   }
   CL_RETURN_ON_FAILURE(clGetKernelWorkGroupInfo(
-      cl_adapter::cast<cl_kernel>(hKernel),
-      cl_adapter::cast<cl_device_id>(hDevice),
+      hKernel->CLKernel,
+      hDevice->CLDevice,
       mapURKernelGroupInfoToCL(propName), propSize, pPropValue, pPropSizeRet));
 
   return UR_RESULT_SUCCESS;
@@ -198,32 +259,21 @@ urKernelGetSubGroupInfo(ur_kernel_handle_t hKernel, ur_device_handle_t hDevice,
   // supports the original khr subgroup extension.
   cl_ext::clGetKernelSubGroupInfoKHR_fn GetKernelSubGroupInfo = nullptr;
 
-  oclv::OpenCLVersion DevVer;
-  CL_RETURN_ON_FAILURE(cl_adapter::getDeviceVersion(
-      cl_adapter::cast<cl_device_id>(hDevice), DevVer));
-
-  if (DevVer < oclv::V2_1) {
-    bool SubgroupExtSupported = false;
-
-    UR_RETURN_ON_FAILURE(cl_adapter::checkDeviceExtensions(
-        cl_adapter::cast<cl_device_id>(hDevice), {"cl_khr_subgroups"},
-        SubgroupExtSupported));
-    if (!SubgroupExtSupported) {
+  if (hDevice->Version < oclv::V2_1) {
+    if (!hDevice->checkExtensions({"cl_khr_subgroups"})) {
+      return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+    }
+    GetKernelSubGroupInfo =
+        hKernel->Context->ExtFuncs.clGetKernelSubGroupInfoKHR;
+    if (!GetKernelSubGroupInfo) {
       return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
     }
-    cl_context Context = nullptr;
-    CL_RETURN_ON_FAILURE(clGetKernelInfo(cl_adapter::cast<cl_kernel>(hKernel),
-                                         CL_KERNEL_CONTEXT, sizeof(Context),
-                                         &Context, nullptr));
-    UR_RETURN_ON_FAILURE(cl_ext::getExtFuncFromContext(
-        Context, cl_ext::ExtFuncPtrCache->clGetKernelSubGroupInfoKHRCache,
-        cl_ext::GetKernelSubGroupInfoName, &GetKernelSubGroupInfo));
   } else {
     GetKernelSubGroupInfo = clGetKernelSubGroupInfo;
   }
 
-  cl_int Ret = GetKernelSubGroupInfo(cl_adapter::cast<cl_kernel>(hKernel),
-                                     cl_adapter::cast<cl_device_id>(hDevice),
+  cl_int Ret = GetKernelSubGroupInfo(hKernel->CLKernel,
+                                     hDevice->CLDevice,
                                      mapURKernelSubGroupInfoToCL(propName),
                                      InputValueSize, InputValue.get(),
                                      sizeof(size_t), &RetVal, pPropSizeRet);
@@ -270,13 +320,15 @@ urKernelGetSubGroupInfo(ur_kernel_handle_t hKernel, ur_device_handle_t hDevice,
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urKernelRetain(ur_kernel_handle_t hKernel) {
-  CL_RETURN_ON_FAILURE(clRetainKernel(cl_adapter::cast<cl_kernel>(hKernel)));
+  hKernel->RefCount++;
   return UR_RESULT_SUCCESS;
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL
 urKernelRelease(ur_kernel_handle_t hKernel) {
-  CL_RETURN_ON_FAILURE(clReleaseKernel(cl_adapter::cast<cl_kernel>(hKernel)));
+  if (--hKernel->RefCount == 0) {
+    delete hKernel;
+  }
   return UR_RESULT_SUCCESS;
 }
 
@@ -287,46 +339,27 @@ urKernelRelease(ur_kernel_handle_t hKernel) {
 static ur_result_t usmSetIndirectAccess(ur_kernel_handle_t hKernel) {
 
   cl_bool TrueVal = CL_TRUE;
-  clHostMemAllocINTEL_fn HFunc = nullptr;
-  clSharedMemAllocINTEL_fn SFunc = nullptr;
-  clDeviceMemAllocINTEL_fn DFunc = nullptr;
-  cl_context CLContext;
+  const cl_ext::ExtFuncPtrT &ExtFuncs = hKernel->Context->ExtFuncs;
 
   /* We test that each alloc type is supported before we actually try to set
    * KernelExecInfo. */
-  CL_RETURN_ON_FAILURE(clGetKernelInfo(cl_adapter::cast<cl_kernel>(hKernel),
-                                       CL_KERNEL_CONTEXT, sizeof(cl_context),
-                                       &CLContext, nullptr));
-
-  UR_RETURN_ON_FAILURE(cl_ext::getExtFuncFromContext<clHostMemAllocINTEL_fn>(
-      CLContext, cl_ext::ExtFuncPtrCache->clHostMemAllocINTELCache,
-      cl_ext::HostMemAllocName, &HFunc));
-
-  if (HFunc) {
+  if (ExtFuncs.clHostMemAllocINTEL) {
     CL_RETURN_ON_FAILURE(
-        clSetKernelExecInfo(cl_adapter::cast<cl_kernel>(hKernel),
+        clSetKernelExecInfo(hKernel->CLKernel,
                             CL_KERNEL_EXEC_INFO_INDIRECT_HOST_ACCESS_INTEL,
                             sizeof(cl_bool), &TrueVal));
   }
 
-  UR_RETURN_ON_FAILURE(cl_ext::getExtFuncFromContext<clDeviceMemAllocINTEL_fn>(
-      CLContext, cl_ext::ExtFuncPtrCache->clDeviceMemAllocINTELCache,
-      cl_ext::DeviceMemAllocName, &DFunc));
-
-  if (DFunc) {
+  if (ExtFuncs.clDeviceMemAllocINTEL) {
     CL_RETURN_ON_FAILURE(
-        clSetKernelExecInfo(cl_adapter::cast<cl_kernel>(hKernel),
+        clSetKernelExecInfo(hKernel->CLKernel,
                             CL_KERNEL_EXEC_INFO_INDIRECT_DEVICE_ACCESS_INTEL,
                             sizeof(cl_bool), &TrueVal));
   }
 
-  UR_RETURN_ON_FAILURE(cl_ext::getExtFuncFromContext<clSharedMemAllocINTEL_fn>(
-      CLContext, cl_ext::ExtFuncPtrCache->clSharedMemAllocINTELCache,
-      cl_ext::SharedMemAllocName, &SFunc));
-
-  if (SFunc) {
+  if (ExtFuncs.clSharedMemAllocINTEL) {
     CL_RETURN_ON_FAILURE(
-        clSetKernelExecInfo(cl_adapter::cast<cl_kernel>(hKernel),
+        clSetKernelExecInfo(hKernel->CLKernel,
                             CL_KERNEL_EXEC_INFO_INDIRECT_SHARED_ACCESS_INTEL,
                             sizeof(cl_bool), &TrueVal));
   }
@@ -351,7 +384,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urKernelSetExecInfo(
   }
   case UR_KERNEL_EXEC_INFO_USM_PTRS: {
     CL_RETURN_ON_FAILURE(clSetKernelExecInfo(
-        cl_adapter::cast<cl_kernel>(hKernel),
+        hKernel->CLKernel,
         CL_KERNEL_EXEC_INFO_USM_PTRS_INTEL, propSize, pPropValue));
     return UR_RESULT_SUCCESS;
   }
@@ -365,30 +398,21 @@ UR_APIEXPORT ur_result_t UR_APICALL urKernelSetArgPointer(
     ur_kernel_handle_t hKernel, uint32_t argIndex,
     const ur_kernel_arg_pointer_properties_t *, const void *pArgValue) {
 
-  cl_context CLContext;
-  CL_RETURN_ON_FAILURE(clGetKernelInfo(cl_adapter::cast<cl_kernel>(hKernel),
-                                       CL_KERNEL_CONTEXT, sizeof(cl_context),
-                                       &CLContext, nullptr));
-
-  clSetKernelArgMemPointerINTEL_fn FuncPtr = nullptr;
-  UR_RETURN_ON_FAILURE(
-      cl_ext::getExtFuncFromContext<clSetKernelArgMemPointerINTEL_fn>(
-          CLContext,
-          cl_ext::ExtFuncPtrCache->clSetKernelArgMemPointerINTELCache,
-          cl_ext::SetKernelArgMemPointerName, &FuncPtr));
-
-  if (FuncPtr) {
-    CL_RETURN_ON_FAILURE(FuncPtr(cl_adapter::cast<cl_kernel>(hKernel),
-                                 cl_adapter::cast<cl_uint>(argIndex),
-                                 pArgValue));
+  clSetKernelArgMemPointerINTEL_fn FuncPtr =
+      hKernel->Context->ExtFuncs.clSetKernelArgMemPointerINTEL;
+  if (!FuncPtr) {
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
   }
 
+  CL_RETURN_ON_FAILURE(FuncPtr(hKernel->CLKernel,
+                               cl_adapter::cast<cl_uint>(argIndex), pArgValue));
+
   return UR_RESULT_SUCCESS;
 }
 UR_APIEXPORT ur_result_t UR_APICALL urKernelGetNativeHandle(
     ur_kernel_handle_t hKernel, ur_native_handle_t *phNativeKernel) {
 
-  *phNativeKernel = reinterpret_cast<ur_native_handle_t>(hKernel);
+  *phNativeKernel = reinterpret_cast<ur_native_handle_t>(hKernel->CLKernel);
   return UR_RESULT_SUCCESS;
 }
 
@@ -403,14 +427,22 @@ UR_APIEXPORT ur_result_t UR_APICALL urKernelSuggestMaxCooperativeGroupCountExp(
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urKernelCreateWithNativeHandle(
-    ur_native_handle_t hNativeKernel, ur_context_handle_t, ur_program_handle_t,
+    ur_native_handle_t hNativeKernel, ur_context_handle_t,
+    ur_program_handle_t hProgram,
     const ur_kernel_native_properties_t *pProperties,
     ur_kernel_handle_t *phKernel) {
-  *phKernel = reinterpret_cast<ur_kernel_handle_t>(hNativeKernel);
+  cl_kernel NativeHandle = reinterpret_cast<cl_kernel>(hNativeKernel);
+  if (!hProgram) {
+    cl_program CLProgram;
+    CL_RETURN_ON_FAILURE(clGetKernelInfo(NativeHandle, CL_KERNEL_PROGRAM,
+                                         sizeof(CLProgram), &CLProgram,
+                                         nullptr));
+    hProgram = cl_adapter::cast<ur_program_handle_t>(CLProgram);
+  }
   if (!pProperties || !pProperties->isNativeHandleOwned) {
-    return urKernelRetain(*phKernel);
+    CL_RETURN_ON_FAILURE(clRetainKernel(NativeHandle));
   }
-  return UR_RESULT_SUCCESS;
+  return ur_kernel_handle_t_::make(NativeHandle, hProgram, *phKernel);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urKernelSetArgMemObj(
@@ -418,7 +450,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urKernelSetArgMemObj(
     const ur_kernel_arg_mem_obj_properties_t *, ur_mem_handle_t hArgValue) {
 
   cl_int RetErr = clSetKernelArg(
-      cl_adapter::cast<cl_kernel>(hKernel), cl_adapter::cast<cl_uint>(argIndex),
+      hKernel->CLKernel, cl_adapter::cast<cl_uint>(argIndex),
       sizeof(hArgValue), cl_adapter::cast<const cl_mem *>(&hArgValue));
   CL_RETURN_ON_FAILURE(RetErr);
   return UR_RESULT_SUCCESS;
@@ -429,7 +461,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urKernelSetArgSampler(
     const ur_kernel_arg_sampler_properties_t *, ur_sampler_handle_t hArgValue) {
 
   cl_int RetErr = clSetKernelArg(
-      cl_adapter::cast<cl_kernel>(hKernel), cl_adapter::cast<cl_uint>(argIndex),
+      hKernel->CLKernel, cl_adapter::cast<cl_uint>(argIndex),
       sizeof(hArgValue), cl_adapter::cast<const cl_sampler *>(&hArgValue));
   CL_RETURN_ON_FAILURE(RetErr);
   return UR_RESULT_SUCCESS;
@@ -439,26 +471,13 @@ UR_APIEXPORT ur_result_t UR_APICALL urKernelGetSuggestedLocalWorkSize(
     ur_kernel_handle_t hKernel, ur_queue_handle_t hQueue, uint32_t workDim,
     const size_t *pGlobalWorkOffset, const size_t *pGlobalWorkSize,
     size_t *pSuggestedLocalWorkSize) {
-  cl_device_id Device;
-  cl_platform_id Platform;
-
-  CL_RETURN_ON_FAILURE(clGetCommandQueueInfo(
-      cl_adapter::cast<cl_command_queue>(hQueue), CL_QUEUE_DEVICE,
-      sizeof(cl_device_id), &Device, nullptr));
-
-  CL_RETURN_ON_FAILURE(clGetDeviceInfo(
-      Device, CL_DEVICE_PLATFORM, sizeof(cl_platform_id), &Platform, nullptr));
-
-  auto GetKernelSuggestedLocalWorkSizeFuncPtr =
-      (clGetKernelSuggestedLocalWorkSizeKHR_fn)
-          clGetExtensionFunctionAddressForPlatform(
-              Platform, "clGetKernelSuggestedLocalWorkSizeKHR");
-  if (!GetKernelSuggestedLocalWorkSizeFuncPtr)
+  clGetKernelSuggestedLocalWorkSizeKHR_fn GetKernelSuggestedLocalWorkSize =
+      hQueue->Context->ExtFuncs.clGetKernelSuggestedLocalWorkSizeKHR;
+  if (!GetKernelSuggestedLocalWorkSize)
     return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
 
-  CL_RETURN_ON_FAILURE(GetKernelSuggestedLocalWorkSizeFuncPtr(
-      cl_adapter::cast<cl_command_queue>(hQueue),
-      cl_adapter::cast<cl_kernel>(hKernel), workDim, pGlobalWorkOffset,
+  CL_RETURN_ON_FAILURE(GetKernelSuggestedLocalWorkSize(
+      hQueue->CLQueue, hKernel->CLKernel, workDim, pGlobalWorkOffset,
       pGlobalWorkSize, pSuggestedLocalWorkSize));
   return UR_RESULT_SUCCESS;
 }
@@ -0,0 +1,50 @@
+//===--------- kernel.hpp - OpenCL Adapter ---------------------------===//
+//
+// Copyright (C) 2025 Intel Corporation
+//
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include "common.hpp"
+#include "context.hpp"
+#include "device.hpp"
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/// Wraps a cl_kernel together with its program and context, and the
+/// per-device properties needed when it is launched.
+struct ur_kernel_handle_t_ {
+  /// Creates the handle of a kernel of Program, taking over one OpenCL
+  /// reference, which is dropped on failure.
+  static ur_result_t make(cl_kernel Kernel, ur_program_handle_t Program,
+                          ur_kernel_handle_t &Handle);
+
+  ~ur_kernel_handle_t_();
+
+  /// Gets CL_KERNEL_COMPILE_WORK_GROUP_SIZE for Device, which is only queried
+  /// the first time.
+  ur_result_t getCompileWorkGroupSize(ur_device_handle_t Device,
+                                      std::array<size_t, 3> &Size);
+
+  cl_kernel CLKernel;
+  ur_program_handle_t Program;
+  ur_context_handle_t Context;
+  std::atomic<uint32_t> RefCount = 1;
+
+private:
+  ur_kernel_handle_t_(cl_kernel Kernel, ur_program_handle_t Program,
+                      ur_context_handle_t Context)
+      : CLKernel(Kernel), Program(Program), Context(Context) {}
+
+  std::mutex CompileWorkGroupSizesMutex;
+  std::vector<std::pair<ur_device_handle_t, std::array<size_t, 3>>>
+      CompileWorkGroupSizes;
+};
@@ -9,6 +9,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "common.hpp"
+#include "context.hpp"
 
 #include <unordered_map>
 
@@ -317,14 +318,8 @@ UR_APIEXPORT ur_result_t UR_APICALL urMemBufferCreate(
   if (pProperties) {
     // TODO: need to check if all properties are supported by OpenCL RT and
     // ignore unsupported
-    clCreateBufferWithPropertiesINTEL_fn FuncPtr = nullptr;
-    cl_context CLContext = cl_adapter::cast<cl_context>(hContext);
-    // First we need to look up the function pointer
-    RetErr =
-        cl_ext::getExtFuncFromContext<clCreateBufferWithPropertiesINTEL_fn>(
-            CLContext,
-            cl_ext::ExtFuncPtrCache->clCreateBufferWithPropertiesINTELCache,
-            cl_ext::CreateBufferWithPropertiesName, &FuncPtr);
+    clCreateBufferWithPropertiesINTEL_fn FuncPtr =
+        hContext->ExtFuncs.clCreateBufferWithPropertiesINTEL;
     if (FuncPtr) {
       std::vector<cl_mem_properties_intel> PropertiesIntel;
       auto Prop = static_cast<ur_base_properties_t *>(pProperties->pNext);
@@ -349,17 +344,18 @@ UR_APIEXPORT ur_result_t UR_APICALL urMemBufferCreate(
       }
       PropertiesIntel.push_back(0);
 
-      *phBuffer = reinterpret_cast<ur_mem_handle_t>(FuncPtr(
-          CLContext, PropertiesIntel.data(), static_cast<cl_mem_flags>(flags),
-          size, pProperties->pHost, cl_adapter::cast<cl_int *>(&RetErr)));
+      *phBuffer = reinterpret_cast<ur_mem_handle_t>(
+          FuncPtr(hContext->CLContext, PropertiesIntel.data(),
+                  static_cast<cl_mem_flags>(flags), size, pProperties->pHost,
+                  cl_adapter::cast<cl_int *>(&RetErr)));
       return mapCLErrorToUR(RetErr);
     }
   }
 
   void *HostPtr = pProperties ? pProperties->pHost : nullptr;
-  *phBuffer = reinterpret_cast<ur_mem_handle_t>(clCreateBuffer(
-      cl_adapter::cast<cl_context>(hContext), static_cast<cl_mem_flags>(flags),
-      size, HostPtr, cl_adapter::cast<cl_int *>(&RetErr)));
+  *phBuffer = reinterpret_cast<ur_mem_handle_t>(
+      clCreateBuffer(hContext->CLContext, static_cast<cl_mem_flags>(flags),
+                     size, HostPtr, cl_adapter::cast<cl_int *>(&RetErr)));
   CL_RETURN_ON_FAILURE(RetErr);
 
   return UR_RESULT_SUCCESS;
@@ -376,9 +372,9 @@ UR_APIEXPORT ur_result_t UR_APICALL urMemImageCreate(
   cl_image_desc ImageDesc = mapURImageDescToCL(pImageDesc);
   cl_map_flags MapFlags = convertURMemFlagsToCL(flags);
 
-  *phMem = reinterpret_cast<ur_mem_handle_t>(clCreateImage(
-      cl_adapter::cast<cl_context>(hContext), MapFlags, &ImageFormat,
-      &ImageDesc, pHost, cl_adapter::cast<cl_int *>(&RetErr)));
+  *phMem = reinterpret_cast<ur_mem_handle_t>(
+      clCreateImage(hContext->CLContext, MapFlags, &ImageFormat, &ImageDesc,
+                    pHost, cl_adapter::cast<cl_int *>(&RetErr)));
   CL_RETURN_ON_FAILURE(RetErr);
 
   return UR_RESULT_SUCCESS;
@@ -457,6 +453,16 @@ UR_APIEXPORT ur_result_t UR_APICALL urMemGetInfo(ur_mem_handle_t hMemory,
   UrReturnHelper ReturnValue(propSize, pPropValue, pPropSizeRet);
   const cl_int CLPropName = mapURMemInfoToCL(propName);
 
+  if (propName == UR_MEM_INFO_CONTEXT) {
+    cl_context CLContext = nullptr;
+    CL_RETURN_ON_FAILURE(clGetMemObjectInfo(cl_adapter::cast<cl_mem>(hMemory),
+                                            CLPropName, sizeof(CLContext),
+                                            &CLContext, nullptr));
+    ur_context_handle_t Context = nullptr;
+    UR_RETURN_ON_FAILURE(ur_context_handle_t_::get(CLContext, Context));
+    return ReturnValue(Context);
+  }
+
   size_t CheckPropSize = 0;
   auto ClResult =
       clGetMemObjectInfo(cl_adapter::cast<cl_mem>(hMemory), CLPropName,
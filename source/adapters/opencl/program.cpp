@@ -13,6 +13,7 @@
 #include "context.hpp"
 #include "device.hpp"
 #include "platform.hpp"
+#include "ur_file_mapping.hpp"
 
 static ur_result_t getDevicesFromProgram(
     ur_program_handle_t hProgram,
@@ -36,78 +37,69 @@ static ur_result_t getDevicesFromProgram(
   return UR_RESULT_SUCCESS;
 }
 
+static ur_result_t getProgramContext(ur_program_handle_t hProgram,
+                                     ur_context_handle_t &Context) {
+  cl_context CLContext = nullptr;
+  CL_RETURN_ON_FAILURE(clGetProgramInfo(cl_adapter::cast<cl_program>(hProgram),
+                                        CL_PROGRAM_CONTEXT, sizeof(CLContext),
+                                        &CLContext, nullptr));
+  return ur_context_handle_t_::get(CLContext, Context);
+}
+
 UR_APIEXPORT ur_result_t UR_APICALL urProgramCreateWithIL(
     ur_context_handle_t hContext, const void *pIL, size_t length,
-    const ur_program_properties_t *, ur_program_handle_t *phProgram) {
-
-  std::unique_ptr<std::vector<cl_device_id>> DevicesInCtx;
-  CL_RETURN_ON_FAILURE_AND_SET_NULL(
-      cl_adapter::getDevicesFromContext(hContext, DevicesInCtx), phProgram);
+    const ur_program_properties_t *pProperties,
+    ur_program_handle_t *phProgram) {
 
-  cl_platform_id CurPlatform;
-  CL_RETURN_ON_FAILURE_AND_SET_NULL(
-      clGetDeviceInfo((*DevicesInCtx)[0], CL_DEVICE_PLATFORM,
-                      sizeof(cl_platform_id), &CurPlatform, nullptr),
-      phProgram);
+  // The CL runtime takes its own copy of the IL, so the file only needs to be
+  // mapped for the duration of the call.
+  std::vector<ur::file_mapping_t> Mappings;
+  UR_RETURN_ON_FAILURE(
+      ur::mapProgramFileSource(pProperties, 1, &length, Mappings));
+  if (!Mappings.empty()) {
+    pIL = Mappings[0].data();
+  }
 
   oclv::OpenCLVersion PlatVer;
   CL_RETURN_ON_FAILURE_AND_SET_NULL(
-      cl_adapter::getPlatformVersion(CurPlatform, PlatVer), phProgram);
+      cl_adapter::getPlatformVersion(hContext->Devices[0]->Platform, PlatVer),
+      phProgram);
 
   cl_int Err = CL_SUCCESS;
   if (PlatVer >= oclv::V2_1) {
 
     /* Make sure all devices support CL 2.1 or newer as well. */
-    for (cl_device_id Dev : *DevicesInCtx) {
-      oclv::OpenCLVersion DevVer;
-
-      CL_RETURN_ON_FAILURE_AND_SET_NULL(
-          cl_adapter::getDeviceVersion(Dev, DevVer), phProgram);
-
+    for (ur_device_handle_t Dev : hContext->Devices) {
       /* If the device does not support CL 2.1 or greater, we need to make sure
        * it supports the cl_khr_il_program extension.
        */
-      if (DevVer < oclv::V2_1) {
-        bool Supported = false;
-        CL_RETURN_ON_FAILURE_AND_SET_NULL(
-            cl_adapter::checkDeviceExtensions(Dev, {"cl_khr_il_program"},
-                                              Supported),
-            phProgram);
-
-        if (!Supported) {
-          return UR_RESULT_ERROR_COMPILER_NOT_AVAILABLE;
-        }
+      if (Dev->Version < oclv::V2_1 &&
+          !Dev->checkExtensions({"cl_khr_il_program"})) {
+        return UR_RESULT_ERROR_COMPILER_NOT_AVAILABLE;
       }
     }
 
-    *phProgram = cl_adapter::cast<ur_program_handle_t>(clCreateProgramWithIL(
-        cl_adapter::cast<cl_context>(hContext), pIL, length, &Err));
+    *phProgram = cl_adapter::cast<ur_program_handle_t>(
+        clCreateProgramWithIL(hContext->CLContext, pIL, length, &Err));
   } else {
 
     /* If none of the devices conform with CL 2.1 or newer make sure they all
      * support the cl_khr_il_program extension.
      */
-    for (cl_device_id Dev : *DevicesInCtx) {
-      bool Supported = false;
-      CL_RETURN_ON_FAILURE_AND_SET_NULL(
-          cl_adapter::checkDeviceExtensions(Dev, {"cl_khr_il_program"},
-                                            Supported),
-          phProgram);
-
-      if (!Supported) {
+    for (ur_device_handle_t Dev : hContext->Devices) {
+      if (!Dev->checkExtensions({"cl_khr_il_program"})) {
         return UR_RESULT_ERROR_COMPILER_NOT_AVAILABLE;
       }
     }
 
-    cl_ext::clCreateProgramWithILKHR_fn CreateProgramWithIL = nullptr;
-
-    UR_RETURN_ON_FAILURE(cl_ext::getExtFuncFromContext(
-        cl_adapter::cast<cl_context>(hContext),
-        cl_ext::ExtFuncPtrCache->clCreateProgramWithILKHRCache,
-        cl_ext::CreateProgramWithILName, &CreateProgramWithIL));
+    cl_ext::clCreateProgramWithILKHR_fn CreateProgramWithIL =
+        hContext->ExtFuncs.clCreateProgramWithILKHR;
+    if (!CreateProgramWithIL) {
+      return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+    }
 
-    *phProgram = cl_adapter::cast<ur_program_handle_t>(CreateProgramWithIL(
-        cl_adapter::cast<cl_context>(hContext), pIL, length, &Err));
+    *phProgram = cl_adapter::cast<ur_program_handle_t>(
+        CreateProgramWithIL(hContext->CLContext, pIL, length, &Err));
   }
 
   // INVALID_VALUE is only returned in three circumstances according to the cl
@@ -135,16 +127,27 @@ UR_APIEXPORT ur_result_t UR_APICALL urProgramCreateWithIL(
 UR_APIEXPORT ur_result_t UR_APICALL urProgramCreateWithBinary(
     ur_context_handle_t hContext, uint32_t numDevices,
     ur_device_handle_t *phDevices, size_t *pLengths, const uint8_t **ppBinaries,
-    const ur_program_properties_t *, ur_program_handle_t *phProgram) {
+    const ur_program_properties_t *pProperties,
+    ur_program_handle_t *phProgram) {
+  std::vector<ur::file_mapping_t> Mappings;
+  UR_RETURN_ON_FAILURE(
+      ur::mapProgramFileSource(pProperties, numDevices, pLengths, Mappings));
+  std::vector<const uint8_t *> MappedBinaries;
+  if (!Mappings.empty()) {
+    for (const auto &Mapping : Mappings) {
+      MappedBinaries.push_back(static_cast<const uint8_t *>(Mapping.data()));
+    }
+    ppBinaries = MappedBinaries.data();
+  }
+
   std::vector<cl_device_id> Devices(numDevices);
   for (uint32_t i = 0; i < numDevices; ++i)
-    Devices[i] = cl_adapter::cast<cl_device_id>(phDevices[i]);
+    Devices[i] = phDevices[i]->CLDevice;
   std::vector<cl_int> BinaryStatus(numDevices);
   cl_int CLResult;
   *phProgram = cl_adapter::cast<ur_program_handle_t>(clCreateProgramWithBinary(
-      cl_adapter::cast<cl_context>(hContext),
-      cl_adapter::cast<cl_uint>(numDevices), Devices.data(), pLengths,
-      ppBinaries, BinaryStatus.data(), &CLResult));
+      hContext->CLContext, cl_adapter::cast<cl_uint>(numDevices),
+      Devices.data(), pLengths, ppBinaries, BinaryStatus.data(), &CLResult));
   for (uint32_t i = 0; i < numDevices; ++i) {
     CL_RETURN_ON_FAILURE(BinaryStatus[i]);
   }
@@ -208,6 +211,21 @@ urProgramGetInfo(ur_program_handle_t hProgram, ur_program_info_t propName,
   if (pPropSizeRet) {
     *pPropSizeRet = CheckPropSize;
   }
+
+  // The OpenCL handles are replaced in place by the handles that wrap them.
+  if (pPropValue && propName == UR_PROGRAM_INFO_CONTEXT) {
+    cl_context CLContext = *static_cast<cl_context *>(pPropValue);
+    ur_context_handle_t Context = nullptr;
+    UR_RETURN_ON_FAILURE(ur_context_handle_t_::get(CLContext, Context));
+    *static_cast<ur_context_handle_t *>(pPropValue) = Context;
+  } else if (pPropValue && propName == UR_PROGRAM_INFO_DEVICES) {
+    for (size_t i = 0; i < CheckPropSize / sizeof(cl_device_id); i++) {
+      cl_device_id CLDevice = static_cast<cl_device_id *>(pPropValue)[i];
+      ur_device_handle_t Device = nullptr;
+      UR_RETURN_ON_FAILURE(ur_device_handle_t_::get(CLDevice, Device));
+      static_cast<ur_device_handle_t *>(pPropValue)[i] = Device;
+    }
+  }
   return UR_RESULT_SUCCESS;
 }
 
@@ -231,8 +249,8 @@ urProgramLink(ur_context_handle_t hContext, uint32_t count,
 
   cl_int CLResult;
   *phProgram = cl_adapter::cast<ur_program_handle_t>(
-      clLinkProgram(cl_adapter::cast<cl_context>(hContext), 0, nullptr,
-                    pOptions, cl_adapter::cast<cl_uint>(count),
+      clLinkProgram(hContext->CLContext, 0, nullptr, pOptions,
+                    cl_adapter::cast<cl_uint>(count),
                     cl_adapter::cast<const cl_program *>(phPrograms), nullptr,
                     nullptr, &CLResult));
 
@@ -317,15 +335,14 @@ urProgramGetBuildInfo(ur_program_handle_t hProgram, ur_device_handle_t hDevice,
     UrReturnHelper ReturnValue(propSize, pPropValue, pPropSizeRet);
     cl_program_binary_type BinaryType;
     CL_RETURN_ON_FAILURE(clGetProgramBuildInfo(
-        cl_adapter::cast<cl_program>(hProgram),
-        cl_adapter::cast<cl_device_id>(hDevice),
+        cl_adapter::cast<cl_program>(hProgram), hDevice->CLDevice,
         mapURProgramBuildInfoToCL(propName), sizeof(cl_program_binary_type),
         &BinaryType, nullptr));
     return ReturnValue(mapCLBinaryTypeToUR(BinaryType));
   }
   size_t CheckPropSize = 0;
   cl_int ClErr = clGetProgramBuildInfo(cl_adapter::cast<cl_program>(hProgram),
-                                       cl_adapter::cast<cl_device_id>(hDevice),
+                                       hDevice->CLDevice,
                                        mapURProgramBuildInfoToCL(propName),
                                        propSize, pPropValue, &CheckPropSize);
   if (pPropValue && CheckPropSize != propSize) {
@@ -377,20 +394,6 @@ UR_APIEXPORT ur_result_t UR_APICALL urProgramSetSpecializationConstants(
     const ur_specialization_constant_info_t *pSpecConstants) {
 
   cl_program CLProg = cl_adapter::cast<cl_program>(hProgram);
-  cl_context Ctx = nullptr;
-  size_t RetSize = 0;
-
-  CL_RETURN_ON_FAILURE(clGetProgramInfo(CLProg, CL_PROGRAM_CONTEXT, sizeof(Ctx),
-                                        &Ctx, &RetSize));
-
-  std::unique_ptr<std::vector<cl_device_id>> DevicesInCtx;
-  UR_RETURN_ON_FAILURE(cl_adapter::getDevicesFromContext(
-      cl_adapter::cast<ur_context_handle_t>(Ctx), DevicesInCtx));
-
-  cl_platform_id CurPlatform;
-  CL_RETURN_ON_FAILURE(clGetDeviceInfo((*DevicesInCtx)[0], CL_DEVICE_PLATFORM,
-                                       sizeof(cl_platform_id), &CurPlatform,
-                                       nullptr));
 
   if (ur::cl::getAdapter()->clSetProgramSpecializationConstant) {
     for (uint32_t i = 0; i < count; ++i) {
@@ -436,17 +439,14 @@ UR_APIEXPORT ur_result_t UR_APICALL urProgramGetFunctionPointer(
     ur_device_handle_t hDevice, ur_program_handle_t hProgram,
     const char *pFunctionName, void **ppFunctionPointer) {
 
-  cl_context CLContext = nullptr;
-  CL_RETURN_ON_FAILURE(clGetProgramInfo(cl_adapter::cast<cl_program>(hProgram),
-                                        CL_PROGRAM_CONTEXT, sizeof(CLContext),
-                                        &CLContext, nullptr));
-
-  cl_ext::clGetDeviceFunctionPointer_fn FuncT = nullptr;
+  ur_context_handle_t Context = nullptr;
+  UR_RETURN_ON_FAILURE(getProgramContext(hProgram, Context));
 
-  UR_RETURN_ON_FAILURE(
-      cl_ext::getExtFuncFromContext<cl_ext::clGetDeviceFunctionPointer_fn>(
-          CLContext, cl_ext::ExtFuncPtrCache->clGetDeviceFunctionPointerCache,
-          cl_ext::GetDeviceFunctionPointerName, &FuncT));
+  cl_ext::clGetDeviceFunctionPointer_fn FuncT =
+      Context->ExtFuncs.clGetDeviceFunctionPointer;
+  if (!FuncT) {
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  }
 
   // Check if the kernel name exists to prevent the OpenCL runtime from throwing
   // an exception with the cpu runtime.
@@ -473,9 +473,8 @@ UR_APIEXPORT ur_result_t UR_APICALL urProgramGetFunctionPointer(
   }
 
   const cl_int CLResult =
-      FuncT(cl_adapter::cast<cl_device_id>(hDevice),
-            cl_adapter::cast<cl_program>(hProgram), pFunctionName,
-            reinterpret_cast<cl_ulong *>(ppFunctionPointer));
+      FuncT(hDevice->CLDevice, cl_adapter::cast<cl_program>(hProgram),
+            pFunctionName, reinterpret_cast<cl_ulong *>(ppFunctionPointer));
   // GPU runtime sometimes returns CL_INVALID_ARG_VALUE if the function address
   // cannot be found but the kernel exists. As the kernel does exist, return
   // that the function name is invalid.
@@ -494,22 +493,18 @@ UR_APIEXPORT ur_result_t UR_APICALL urProgramGetGlobalVariablePointer(
     const char *pGlobalVariableName, size_t *pGlobalVariableSizeRet,
     void **ppGlobalVariablePointerRet) {
 
-  cl_context CLContext = nullptr;
-  CL_RETURN_ON_FAILURE(clGetProgramInfo(cl_adapter::cast<cl_program>(hProgram),
-                                        CL_PROGRAM_CONTEXT, sizeof(CLContext),
-                                        &CLContext, nullptr));
-
-  cl_ext::clGetDeviceGlobalVariablePointer_fn FuncT = nullptr;
+  ur_context_handle_t Context = nullptr;
+  UR_RETURN_ON_FAILURE(getProgramContext(hProgram, Context));
 
-  UR_RETURN_ON_FAILURE(cl_ext::getExtFuncFromContext<
-                       cl_ext::clGetDeviceGlobalVariablePointer_fn>(
-      CLContext, cl_ext::ExtFuncPtrCache->clGetDeviceGlobalVariablePointerCache,
-      cl_ext::GetDeviceGlobalVariablePointerName, &FuncT));
+  cl_ext::clGetDeviceGlobalVariablePointer_fn FuncT =
+      Context->ExtFuncs.clGetDeviceGlobalVariablePointer;
+  if (!FuncT) {
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  }
 
-  const cl_int CLResult =
-      FuncT(cl_adapter::cast<cl_device_id>(hDevice),
-            cl_adapter::cast<cl_program>(hProgram), pGlobalVariableName,
-            pGlobalVariableSizeRet, ppGlobalVariablePointerRet);
+  const cl_int CLResult = FuncT(
+      hDevice->CLDevice, cl_adapter::cast<cl_program>(hProgram),
+      pGlobalVariableName, pGlobalVariableSizeRet, ppGlobalVariablePointerRet);
 
   if (CLResult != CL_SUCCESS) {
     *ppGlobalVariablePointerRet = nullptr;
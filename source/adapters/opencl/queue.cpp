@@ -6,9 +6,99 @@
 //
 //===-----------------------------------------------------------------===//
 
+#include "queue.hpp"
 #include "common.hpp"
+#include "context.hpp"
+#include "device.hpp"
 #include "platform.hpp"
 
+using queue_registry_t =
+    cl_adapter::handle_registry<cl_command_queue, ur_queue_handle_t>;
+
+static queue_registry_t &getQueueRegistry() {
+  // Never destroyed, so that handles can be released from static destructors.
+  static queue_registry_t *Registry = new queue_registry_t;
+  return *Registry;
+}
+
+ur_result_t ur_queue_handle_t_::initialize() {
+  cl_context CLContext;
+  CL_RETURN_ON_FAILURE(clGetCommandQueueInfo(CLQueue, CL_QUEUE_CONTEXT,
+                                             sizeof(cl_context), &CLContext,
+                                             nullptr));
+  cl_device_id CLDevice;
+  CL_RETURN_ON_FAILURE(clGetCommandQueueInfo(CLQueue, CL_QUEUE_DEVICE,
+                                             sizeof(cl_device_id), &CLDevice,
+                                             nullptr));
+
+  UR_RETURN_ON_FAILURE(ur_context_handle_t_::get(CLContext, Context));
+  UR_RETURN_ON_FAILURE(urContextRetain(Context));
+  UR_RETURN_ON_FAILURE(ur_device_handle_t_::get(CLDevice, Device));
+  UR_RETURN_ON_FAILURE(urDeviceRetain(Device));
+
+  cl_command_queue_properties Properties = 0;
+  CL_RETURN_ON_FAILURE(clGetCommandQueueInfo(CLQueue, CL_QUEUE_PROPERTIES,
+                                             sizeof(Properties), &Properties,
+                                             nullptr));
+  const ur::usm_arena::arena_fns_t ArenaFns = {
+      urUSMDeviceAlloc, urUSMFree, urEnqueueEventsWait,
+      urEnqueueEventsWaitWithBarrier, urEventGetInfo, urEventWait,
+      urEventRetain, urEventRelease};
+  USMArena = std::make_unique<ur::usm_arena::arena_t>(
+      ArenaFns, Context, Device,
+      !(Properties & CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE));
+  return UR_RESULT_SUCCESS;
+}
+
+static ur_result_t releaseQueueOwners(ur_queue_handle_t Queue) {
+  if (Queue->Device) {
+    UR_RETURN_ON_FAILURE(urDeviceRelease(Queue->Device));
+  }
+  if (Queue->Context) {
+    UR_RETURN_ON_FAILURE(urContextRelease(Queue->Context));
+  }
+  return UR_RESULT_SUCCESS;
+}
+
+ur_result_t ur_queue_handle_t_::create(cl_command_queue Queue,
+                                       ur_queue_handle_t &Handle) {
+  std::unique_ptr<ur_queue_handle_t_> NewQueue{new ur_queue_handle_t_(Queue)};
+  if (ur_result_t Result = NewQueue->initialize();
+      Result != UR_RESULT_SUCCESS) {
+    releaseQueueOwners(NewQueue.get());
+    clReleaseCommandQueue(Queue);
+    return Result;
+  }
+
+  Handle = NewQueue.release();
+  getQueueRegistry().insert(Queue, Handle);
+  Handle->Context->addQueue(Handle);
+  return UR_RESULT_SUCCESS;
+}
+
+ur_result_t ur_queue_handle_t_::make(cl_command_queue Queue,
+                                     ur_queue_handle_t &Handle) {
+  queue_registry_t &Registry = getQueueRegistry();
+  std::lock_guard<std::mutex> Lock{Registry.Mutex};
+  if ((Handle = Registry.find(Queue))) {
+    Handle->RefCount++;
+    CL_RETURN_ON_FAILURE(clReleaseCommandQueue(Queue));
+    return UR_RESULT_SUCCESS;
+  }
+  return create(Queue, Handle);
+}
+
+ur_result_t ur_queue_handle_t_::get(cl_command_queue Queue,
+                                    ur_queue_handle_t &Handle) {
+  queue_registry_t &Registry = getQueueRegistry();
+  std::lock_guard<std::mutex> Lock{Registry.Mutex};
+  if ((Handle = Registry.find(Queue))) {
+    return UR_RESULT_SUCCESS;
+  }
+  CL_RETURN_ON_FAILURE(clRetainCommandQueue(Queue));
+  return create(Queue, Handle);
+}
+
 cl_command_queue_info mapURQueueInfoToCL(const ur_queue_info_t PropName) {
 
   switch (PropName) {
@@ -71,13 +161,6 @@ UR_APIEXPORT ur_result_t UR_APICALL urQueueCreate(
     ur_context_handle_t hContext, ur_device_handle_t hDevice,
     const ur_queue_properties_t *pProperties, ur_queue_handle_t *phQueue) {
 
-  cl_platform_id CurPlatform;
-  CL_RETURN_ON_FAILURE_AND_SET_NULL(
-      clGetDeviceInfo(cl_adapter::cast<cl_device_id>(hDevice),
-                      CL_DEVICE_PLATFORM, sizeof(cl_platform_id), &CurPlatform,
-                      nullptr),
-      phQueue);
-
   cl_command_queue_properties CLProperties =
       pProperties ? convertURQueuePropertiesToCL(pProperties) : 0;
 
@@ -88,29 +171,25 @@ UR_APIEXPORT ur_result_t UR_APICALL urQueueCreate(
 
   oclv::OpenCLVersion Version;
   CL_RETURN_ON_FAILURE_AND_SET_NULL(
-      cl_adapter::getPlatformVersion(CurPlatform, Version), phQueue);
+      cl_adapter::getPlatformVersion(hDevice->Platform, Version), phQueue);
 
   cl_int RetErr = CL_INVALID_OPERATION;
+  cl_command_queue Queue;
 
   if (Version < oclv::V2_0) {
-    *phQueue = cl_adapter::cast<ur_queue_handle_t>(
-        clCreateCommandQueue(cl_adapter::cast<cl_context>(hContext),
-                             cl_adapter::cast<cl_device_id>(hDevice),
-                             CLProperties & SupportByOpenCL, &RetErr));
-    CL_RETURN_ON_FAILURE(RetErr);
-    return UR_RESULT_SUCCESS;
+    Queue = clCreateCommandQueue(hContext->CLContext, hDevice->CLDevice,
+                                 CLProperties & SupportByOpenCL, &RetErr);
+  } else {
+    /* TODO: Add support for CL_QUEUE_PRIORITY_KHR */
+    cl_queue_properties CreationFlagProperties[] = {
+        CL_QUEUE_PROPERTIES, CLProperties & SupportByOpenCL, 0};
+    Queue = clCreateCommandQueueWithProperties(
+        hContext->CLContext, hDevice->CLDevice, CreationFlagProperties,
+        &RetErr);
   }
+  CL_RETURN_ON_FAILURE_AND_SET_NULL(RetErr, phQueue);
 
-  /* TODO: Add support for CL_QUEUE_PRIORITY_KHR */
-  cl_queue_properties CreationFlagProperties[] = {
-      CL_QUEUE_PROPERTIES, CLProperties & SupportByOpenCL, 0};
-  *phQueue =
-      cl_adapter::cast<ur_queue_handle_t>(clCreateCommandQueueWithProperties(
-          cl_adapter::cast<cl_context>(hContext),
-          cl_adapter::cast<cl_device_id>(hDevice), CreationFlagProperties,
-          &RetErr));
-  CL_RETURN_ON_FAILURE(RetErr);
-  return UR_RESULT_SUCCESS;
+  return ur_queue_handle_t_::make(Queue, *phQueue);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urQueueGetInfo(ur_queue_handle_t hQueue,
@@ -123,23 +202,45 @@ UR_APIEXPORT ur_result_t UR_APICALL urQueueGetInfo(ur_queue_handle_t hQueue,
     return UR_RESULT_ERROR_UNSUPPORTED_ENUMERATION;
   }
   cl_command_queue_info CLCommandQueueInfo = mapURQueueInfoToCL(propName);
+  UrReturnHelper ReturnValue(propSize, pPropValue, pPropSizeRet);
+
+  switch (propName) {
+  case UR_QUEUE_INFO_CONTEXT:
+    return ReturnValue(hQueue->Context);
+  case UR_QUEUE_INFO_DEVICE:
+    return ReturnValue(hQueue->Device);
+  case UR_QUEUE_INFO_REFERENCE_COUNT:
+    return ReturnValue(hQueue->RefCount.load());
+  case UR_QUEUE_INFO_DEVICE_DEFAULT: {
+    cl_command_queue CLDefaultQueue = nullptr;
+    CL_RETURN_ON_FAILURE(clGetCommandQueueInfo(
+        hQueue->CLQueue, CLCommandQueueInfo, sizeof(CLDefaultQueue),
+        &CLDefaultQueue, nullptr));
+    ur_queue_handle_t DefaultQueue = nullptr;
+    if (CLDefaultQueue) {
+      UR_RETURN_ON_FAILURE(
+          ur_queue_handle_t_::get(CLDefaultQueue, DefaultQueue));
+    }
+    return ReturnValue(DefaultQueue);
+  }
+  default:
+    break;
+  }
 
   // Unfortunately the size of cl_bitfield (unsigned long) doesn't line up with
   // our enums (forced to be sizeof(uint32_t)) so this needs special handling.
   if (propName == UR_QUEUE_INFO_FLAGS) {
-    UrReturnHelper ReturnValue(propSize, pPropValue, pPropSizeRet);
-
     cl_command_queue_properties QueueProperties = 0;
     CL_RETURN_ON_FAILURE(clGetCommandQueueInfo(
-        cl_adapter::cast<cl_command_queue>(hQueue), CLCommandQueueInfo,
-        sizeof(QueueProperties), &QueueProperties, nullptr));
+        hQueue->CLQueue, CLCommandQueueInfo, sizeof(QueueProperties),
+        &QueueProperties, nullptr));
 
     return ReturnValue(mapCLQueuePropsToUR(QueueProperties));
   } else {
     size_t CheckPropSize = 0;
-    cl_int RetErr = clGetCommandQueueInfo(
-        cl_adapter::cast<cl_command_queue>(hQueue), CLCommandQueueInfo,
-        propSize, pPropValue, &CheckPropSize);
+    cl_int RetErr =
+        clGetCommandQueueInfo(hQueue->CLQueue, CLCommandQueueInfo, propSize,
+                              pPropValue, &CheckPropSize);
     if (pPropValue && CheckPropSize != propSize) {
       return UR_RESULT_ERROR_INVALID_SIZE;
     }
@@ -155,7 +256,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urQueueGetInfo(ur_queue_handle_t hQueue,
 UR_APIEXPORT ur_result_t UR_APICALL
 urQueueGetNativeHandle(ur_queue_handle_t hQueue, ur_queue_native_desc_t *,
                        ur_native_handle_t *phNativeQueue) {
-  return getNativeHandle(hQueue, phNativeQueue);
+  return getNativeHandle(hQueue->CLQueue, phNativeQueue);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urQueueCreateWithNativeHandle(
@@ -165,35 +266,53 @@ UR_APIEXPORT ur_result_t UR_APICALL urQueueCreateWithNativeHandle(
     [[maybe_unused]] const ur_queue_native_properties_t *pProperties,
     ur_queue_handle_t *phQueue) {
 
-  *phQueue = reinterpret_cast<ur_queue_handle_t>(hNativeQueue);
-  cl_int RetErr =
-      clRetainCommandQueue(cl_adapter::cast<cl_command_queue>(*phQueue));
-  CL_RETURN_ON_FAILURE(RetErr);
-  return UR_RESULT_SUCCESS;
+  cl_command_queue NativeHandle =
+      reinterpret_cast<cl_command_queue>(hNativeQueue);
+  CL_RETURN_ON_FAILURE(clRetainCommandQueue(NativeHandle));
+  return ur_queue_handle_t_::make(NativeHandle, *phQueue);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urQueueFinish(ur_queue_handle_t hQueue) {
-  cl_int RetErr = clFinish(cl_adapter::cast<cl_command_queue>(hQueue));
+  cl_int RetErr = clFinish(hQueue->CLQueue);
   CL_RETURN_ON_FAILURE(RetErr);
   return UR_RESULT_SUCCESS;
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urQueueFlush(ur_queue_handle_t hQueue) {
-  cl_int RetErr = clFinish(cl_adapter::cast<cl_command_queue>(hQueue));
+  cl_int RetErr = clFinish(hQueue->CLQueue);
   CL_RETURN_ON_FAILURE(RetErr);
   return UR_RESULT_SUCCESS;
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urQueueRetain(ur_queue_handle_t hQueue) {
-  cl_int RetErr =
-      clRetainCommandQueue(cl_adapter::cast<cl_command_queue>(hQueue));
-  CL_RETURN_ON_FAILURE(RetErr);
+  hQueue->RefCount++;
   return UR_RESULT_SUCCESS;
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urQueueRelease(ur_queue_handle_t hQueue) {
-  cl_int RetErr =
-      clReleaseCommandQueue(cl_adapter::cast<cl_command_queue>(hQueue));
+  cl_command_queue CLQueue = hQueue->CLQueue;
+  {
+    queue_registry_t &Registry = getQueueRegistry();
+    std::lock_guard<std::mutex> Lock{Registry.Mutex};
+    if (--hQueue->RefCount != 0) {
+      return UR_RESULT_SUCCESS;
+    }
+    Registry.erase(CLQueue);
+  }
+
+  // Commands still in flight may be using memory from the arena.
+  cl_int RetErr = CL_SUCCESS;
+  if (hQueue->USMArena && hQueue->USMArena->holdsMemory()) {
+    RetErr = clFinish(CLQueue);
+  }
+  hQueue->USMArena.reset();
+  hQueue->Context->removeQueue(hQueue);
+
+  cl_int ReleaseErr = clReleaseCommandQueue(CLQueue);
+  ur_result_t Result = releaseQueueOwners(hQueue);
+  delete hQueue;
+
   CL_RETURN_ON_FAILURE(RetErr);
-  return UR_RESULT_SUCCESS;
+  CL_RETURN_ON_FAILURE(ReleaseErr);
+  return Result;
 }
@@ -0,0 +1,48 @@
+//===--------- queue.hpp - OpenCL Adapter ---------------------------===//
+//
+// Copyright (C) 2025 Intel Corporation
+//
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include "common.hpp"
+#include "context.hpp"
+#include "device.hpp"
+#include "ur_usm_arena.hpp"
+
+#include <atomic>
+#include <memory>
+
+/// Wraps a cl_command_queue together with the context and device it was
+/// created for, both of which hold a reference for the queue.
+struct ur_queue_handle_t_ {
+  /// Creates the handle of a queue, taking over one OpenCL reference, which
+  /// is dropped on failure. If Queue already has a handle, that one is
+  /// returned with an added reference.
+  static ur_result_t make(cl_command_queue Queue, ur_queue_handle_t &Handle);
+
+  /// Returns the handle of a queue returned by OpenCL, e.g. by
+  /// CL_EVENT_COMMAND_QUEUE. No UR reference is added; queues that weren't
+  /// created through the adapter get a handle, which retains Queue, owned by
+  /// the adapter.
+  static ur_result_t get(cl_command_queue Queue, ur_queue_handle_t &Handle);
+
+  cl_command_queue CLQueue;
+  ur_context_handle_t Context = nullptr;
+  ur_device_handle_t Device = nullptr;
+  std::atomic<uint32_t> RefCount = 1;
+  /// Serves urEnqueueUSMAllocExp and urEnqueueUSMFreeExp on this queue.
+  std::unique_ptr<ur::usm_arena::arena_t> USMArena;
+
+private:
+  explicit ur_queue_handle_t_(cl_command_queue Queue) : CLQueue(Queue) {}
+  ur_result_t initialize();
+  /// Creates and registers the handle of Queue, taking over one OpenCL
+  /// reference. The caller holds the registry lock, so a queue never gets two
+  /// handles.
+  static ur_result_t create(cl_command_queue Queue, ur_queue_handle_t &Handle);
+};
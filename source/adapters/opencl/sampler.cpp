@@ -9,6 +9,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "common.hpp"
+#include "context.hpp"
 
 namespace {
 
@@ -106,9 +107,9 @@ ur_sampler_filter_mode_t cl2URFilterMode(cl_filter_mode Mode) {
   }
 }
 
-void cl2URSamplerInfoValue(cl_sampler_info Info, void *InfoValue) {
+ur_result_t cl2URSamplerInfoValue(cl_sampler_info Info, void *InfoValue) {
   if (!InfoValue) {
-    return;
+    return UR_RESULT_SUCCESS;
   }
   switch (Info) {
   case CL_SAMPLER_ADDRESSING_MODE: {
@@ -124,10 +125,18 @@ void cl2URSamplerInfoValue(cl_sampler_info Info, void *InfoValue) {
         cl2URFilterMode(CLMode);
     break;
   }
+  case CL_SAMPLER_CONTEXT: {
+    cl_context CLContext = *reinterpret_cast<cl_context *>(InfoValue);
+    ur_context_handle_t Context = nullptr;
+    UR_RETURN_ON_FAILURE(ur_context_handle_t_::get(CLContext, Context));
+    *reinterpret_cast<ur_context_handle_t *>(InfoValue) = Context;
+    break;
+  }
 
   default:
     break;
   }
+  return UR_RESULT_SUCCESS;
 }
 
 } // namespace
@@ -144,9 +153,8 @@ ur_result_t urSamplerCreate(ur_context_handle_t hContext,
 
   // Always call OpenCL 1.0 API
   *phSampler = cl_adapter::cast<ur_sampler_handle_t>(clCreateSampler(
-      cl_adapter::cast<cl_context>(hContext),
-      static_cast<cl_bool>(pDesc->normalizedCoords), AddressingMode, FilterMode,
-      cl_adapter::cast<cl_int *>(&ErrorCode)));
+      hContext->CLContext, static_cast<cl_bool>(pDesc->normalizedCoords),
+      AddressingMode, FilterMode, cl_adapter::cast<cl_int *>(&ErrorCode)));
 
   return mapCLErrorToUR(ErrorCode);
 }
@@ -193,9 +201,7 @@ urSamplerGetInfo(ur_sampler_handle_t hSampler, ur_sampler_info_t propName,
   }
 
   // Convert OpenCL returns to UR
-  cl2URSamplerInfoValue(SamplerInfo, pPropValue);
-
-  return UR_RESULT_SUCCESS;
+  return cl2URSamplerInfoValue(SamplerInfo, pPropValue);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL
@@ -408,6 +408,9 @@ UR_DLLEXPORT ur_result_t UR_APICALL urGetEnqueueExpProcAddrTable(
       urEnqueueCooperativeKernelLaunchExp;
   pDdiTable->pfnTimestampRecordingExp = urEnqueueTimestampRecordingExp;
   pDdiTable->pfnNativeCommandExp = urEnqueueNativeCommandExp;
+  pDdiTable->pfnHostTaskExp = urEnqueueHostTaskExp;
+  pDdiTable->pfnUSMAllocExp = urEnqueueUSMAllocExp;
+  pDdiTable->pfnUSMFreeExp = urEnqueueUSMFreeExp;
 
   return UR_RESULT_SUCCESS;
 }
@@ -8,9 +8,17 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <numeric>
+#include <optional>
 #include <ur/ur.hpp>
 
 #include "common.hpp"
+#include "context.hpp"
+#include "device.hpp"
+#include "queue.hpp"
 #include "usm.hpp"
 
 template <class T>
@@ -21,8 +29,15 @@ void AllocDeleterCallback(cl_event event, cl_int, void *pUserData) {
 }
 
 namespace umf {
-ur_result_t getProviderNativeError(const char *, int32_t) {
-  // TODO: implement when UMF supports OpenCL
+ur_result_t getProviderNativeError(const char *ProviderName,
+                                   int32_t NativeError) {
+  if (std::strcmp(ProviderName, "OPENCL") == 0) {
+    if (NativeError == CL_INVALID_BUFFER_SIZE) {
+      return UR_RESULT_ERROR_INVALID_USM_SIZE;
+    }
+    return mapCLErrorToUR(NativeError);
+  }
+
   return UR_RESULT_ERROR_UNKNOWN;
 }
 } // namespace umf
@@ -95,111 +110,226 @@ usmDescToCLMemProperties(const ur_base_desc_t *Desc,
   return UR_RESULT_SUCCESS;
 }
 
-UR_APIEXPORT ur_result_t UR_APICALL
-urUSMHostAlloc(ur_context_handle_t hContext, const ur_usm_desc_t *pUSMDesc,
-               ur_usm_pool_handle_t, size_t size, void **ppMem) {
+// Allocates Type memory directly from OpenCL. Device is ignored for host
+// memory and Properties may be null.
+static cl_int allocateCLUSM(ur_context_handle_t Context,
+                            ur_device_handle_t Device, ur_usm_type_t Type,
+                            const cl_mem_properties_intel *Properties,
+                            size_t Size, uint32_t Alignment, void **Mem) {
+  const cl_ext::ExtFuncPtrT &ExtFuncs = Context->ExtFuncs;
+  cl_int ClResult = CL_SUCCESS;
+  switch (Type) {
+  case UR_USM_TYPE_HOST:
+    *Mem = ExtFuncs.clHostMemAllocINTEL(Context->CLContext, Properties, Size,
+                                        Alignment, &ClResult);
+    break;
+  case UR_USM_TYPE_DEVICE:
+    *Mem = ExtFuncs.clDeviceMemAllocINTEL(Context->CLContext, Device->CLDevice,
+                                          Properties, Size, Alignment,
+                                          &ClResult);
+    break;
+  case UR_USM_TYPE_SHARED:
+    *Mem = ExtFuncs.clSharedMemAllocINTEL(Context->CLContext, Device->CLDevice,
+                                          Properties, Size, Alignment,
+                                          &ClResult);
+    break;
+  default:
+    return CL_INVALID_VALUE;
+  }
 
-  void *Ptr = nullptr;
-  uint32_t Alignment = pUSMDesc ? pUSMDesc->align : 0;
+  assert((ClResult != CL_SUCCESS || Alignment == 0 ||
+          reinterpret_cast<std::uintptr_t>(*Mem) % Alignment == 0) &&
+         "Allocation not aligned correctly!");
+  return ClResult;
+}
 
-  if (pUSMDesc && pUSMDesc->align != 0 &&
-      ((pUSMDesc->align & (pUSMDesc->align - 1)) != 0)) {
-    return UR_RESULT_ERROR_INVALID_VALUE;
+namespace {
+// UMF memory provider that allocates one type of USM memory, for one device
+// unless it is host memory, straight from OpenCL.
+class USMMemoryProvider {
+  ur_context_handle_t Context = nullptr;
+  ur_device_handle_t Device = nullptr;
+  ur_usm_type_t Type = UR_USM_TYPE_UNKNOWN;
+
+  static cl_int &getLastNativeErrorRef() {
+    static thread_local cl_int LastNativeError = CL_SUCCESS;
+    return LastNativeError;
   }
 
-  std::vector<cl_mem_properties_intel> AllocProperties;
-  if (pUSMDesc && pUSMDesc->pNext) {
-    UR_RETURN_ON_FAILURE(usmDescToCLMemProperties(
-        static_cast<const ur_base_desc_t *>(pUSMDesc->pNext), AllocProperties));
+public:
+  umf_result_t initialize(ur_context_handle_t Ctx, ur_device_handle_t Dev,
+                          ur_usm_type_t MemType) {
+    Context = Ctx;
+    Device = Dev;
+    Type = MemType;
+    return UMF_RESULT_SUCCESS;
   }
 
-  // First we need to look up the function pointer
-  clHostMemAllocINTEL_fn FuncPtr = nullptr;
-  cl_context CLContext = cl_adapter::cast<cl_context>(hContext);
-  if (auto UrResult = cl_ext::getExtFuncFromContext<clHostMemAllocINTEL_fn>(
-          CLContext, cl_ext::ExtFuncPtrCache->clHostMemAllocINTELCache,
-          cl_ext::HostMemAllocName, &FuncPtr)) {
-    return UrResult;
+  umf_result_t alloc(size_t Size, size_t Align, void **Ptr) {
+    cl_int ClResult = allocateCLUSM(Context, Device, Type, nullptr, Size,
+                                    static_cast<uint32_t>(Align), Ptr);
+    if (ClResult != CL_SUCCESS) {
+      getLastNativeErrorRef() = ClResult;
+      return UMF_RESULT_ERROR_MEMORY_PROVIDER_SPECIFIC;
+    }
+    return UMF_RESULT_SUCCESS;
   }
 
-  if (FuncPtr) {
-    cl_int ClResult = CL_SUCCESS;
-    Ptr = FuncPtr(CLContext,
-                  AllocProperties.empty() ? nullptr : AllocProperties.data(),
-                  size, Alignment, &ClResult);
-    if (ClResult == CL_INVALID_BUFFER_SIZE) {
-      return UR_RESULT_ERROR_INVALID_USM_SIZE;
+  umf_result_t free(void *Ptr, size_t) {
+    cl_int ClResult =
+        Context->ExtFuncs.clMemBlockingFreeINTEL(Context->CLContext, Ptr);
+    if (ClResult != CL_SUCCESS) {
+      getLastNativeErrorRef() = ClResult;
+      return UMF_RESULT_ERROR_MEMORY_PROVIDER_SPECIFIC;
     }
-    CL_RETURN_ON_FAILURE(ClResult);
+    return UMF_RESULT_SUCCESS;
   }
 
-  *ppMem = Ptr;
+  void get_last_native_error(const char **ErrMsg, int32_t *ErrCode) {
+    *ErrMsg = nullptr;
+    *ErrCode = getLastNativeErrorRef();
+  }
 
-  assert((Alignment == 0 ||
-          reinterpret_cast<std::uintptr_t>(*ppMem) % Alignment == 0) &&
-         "Allocation not aligned correctly!");
+  umf_result_t get_recommended_page_size(size_t, size_t *) {
+    return UMF_RESULT_ERROR_NOT_SUPPORTED;
+  }
 
-  return UR_RESULT_SUCCESS;
-}
+  // OpenCL has no notion of pages, so don't constrain the pool.
+  umf_result_t get_min_page_size(void *, size_t *PageSize) {
+    *PageSize = 0;
+    return UMF_RESULT_SUCCESS;
+  }
 
-UR_APIEXPORT ur_result_t UR_APICALL
-urUSMDeviceAlloc(ur_context_handle_t hContext, ur_device_handle_t hDevice,
-                 const ur_usm_desc_t *pUSMDesc, ur_usm_pool_handle_t,
-                 size_t size, void **ppMem) {
+  umf_result_t purge_lazy(void *, size_t) {
+    return UMF_RESULT_ERROR_NOT_SUPPORTED;
+  }
+  umf_result_t purge_force(void *, size_t) {
+    return UMF_RESULT_ERROR_NOT_SUPPORTED;
+  }
+  umf_result_t allocation_merge(void *, void *, size_t) {
+    return UMF_RESULT_ERROR_UNKNOWN;
+  }
+  umf_result_t allocation_split(void *, size_t, size_t) {
+    return UMF_RESULT_ERROR_UNKNOWN;
+  }
 
-  void *Ptr = nullptr;
-  uint32_t Alignment = pUSMDesc ? pUSMDesc->align : 0;
+  const char *get_name() { return "OPENCL"; }
+};
 
-  if (pUSMDesc && pUSMDesc->align != 0 &&
-      ((pUSMDesc->align & (pUSMDesc->align - 1)) != 0)) {
-    return UR_RESULT_ERROR_INVALID_VALUE;
+std::optional<usm::DisjointPoolAllConfigs> initializeDisjointPoolConfig() {
+  const char *Disable = std::getenv("UR_OPENCL_DISABLE_USM_ALLOCATOR");
+  if (Disable != nullptr && Disable != std::string("")) {
+    return std::nullopt;
   }
 
-  std::vector<cl_mem_properties_intel> AllocProperties;
-  if (pUSMDesc && pUSMDesc->pNext) {
-    UR_RETURN_ON_FAILURE(usmDescToCLMemProperties(
-        static_cast<const ur_base_desc_t *>(pUSMDesc->pNext), AllocProperties));
+  int PoolTrace = 0;
+  if (const char *PoolTraceVal = std::getenv("UR_OPENCL_USM_ALLOCATOR_TRACE")) {
+    PoolTrace = std::atoi(PoolTraceVal);
   }
 
-  // First we need to look up the function pointer
-  clDeviceMemAllocINTEL_fn FuncPtr = nullptr;
-  cl_context CLContext = cl_adapter::cast<cl_context>(hContext);
-  if (auto UrResult = cl_ext::getExtFuncFromContext<clDeviceMemAllocINTEL_fn>(
-          CLContext, cl_ext::ExtFuncPtrCache->clDeviceMemAllocINTELCache,
-          cl_ext::DeviceMemAllocName, &FuncPtr)) {
-    return UrResult;
+  const char *PoolConfigVal = std::getenv("UR_OPENCL_USM_ALLOCATOR");
+  if (PoolConfigVal == nullptr) {
+    return usm::DisjointPoolAllConfigs(PoolTrace);
   }
 
-  if (FuncPtr) {
-    cl_int ClResult = CL_SUCCESS;
-    Ptr = FuncPtr(CLContext, cl_adapter::cast<cl_device_id>(hDevice),
-                  AllocProperties.empty() ? nullptr : AllocProperties.data(),
-                  size, Alignment, &ClResult);
-    if (ClResult == CL_INVALID_BUFFER_SIZE) {
-      return UR_RESULT_ERROR_INVALID_USM_SIZE;
+  auto Configs = usm::parseDisjointPoolConfig(PoolConfigVal, PoolTrace);
+  if (Configs.EnableBuffers) {
+    return Configs;
+  }
+
+  return std::nullopt;
+}
+
+usm::DisjointPoolMemType
+descToDisjointPoolMemType(const usm::pool_descriptor &Desc) {
+  switch (Desc.type) {
+  case UR_USM_TYPE_HOST:
+    return usm::DisjointPoolMemType::Host;
+  case UR_USM_TYPE_DEVICE:
+    return usm::DisjointPoolMemType::Device;
+  case UR_USM_TYPE_SHARED:
+    return usm::DisjointPoolMemType::Shared;
+  default:
+    throw UR_RESULT_ERROR_INVALID_ARGUMENT;
+  }
+}
+
+umf::provider_unique_handle_t makeProvider(const usm::pool_descriptor &Desc) {
+  auto [Result, Provider] = umf::memoryProviderMakeUnique<USMMemoryProvider>(
+      Desc.hContext, Desc.hDevice, Desc.type);
+  if (Result != UMF_RESULT_SUCCESS) {
+    throw umf::umf2urResult(Result);
+  }
+  return std::move(Provider);
+}
+} // namespace
+
+ur_usm_pool_handle_t_::ur_usm_pool_handle_t_(ur_context_handle_t Context,
+                                             ur_usm_pool_desc_t *PoolDesc)
+    : Context(Context) {
+  auto DisjointPoolConfigs = initializeDisjointPoolConfig();
+  if (DisjointPoolConfigs && PoolDesc) {
+    if (auto Limits = find_stype_node<ur_usm_pool_limits_desc_t>(PoolDesc)) {
+      for (auto &Config : DisjointPoolConfigs->Configs) {
+        Config.MaxPoolableSize = Limits->maxPoolableSize;
+        Config.SlabMinSize = Limits->minDriverAllocSize;
+      }
     }
-    CL_RETURN_ON_FAILURE(ClResult);
   }
 
-  *ppMem = Ptr;
+  // OpenCL has no read-only shared allocations, see usmDescToCLMemProperties.
+  std::vector<usm::pool_descriptor> Descriptors{
+      {this, Context, nullptr, UR_USM_TYPE_HOST, false}};
+  for (ur_device_handle_t Device : Context->Devices) {
+    Descriptors.push_back({this, Context, Device, UR_USM_TYPE_DEVICE, false});
+    Descriptors.push_back({this, Context, Device, UR_USM_TYPE_SHARED, false});
+  }
 
-  assert((Alignment == 0 ||
-          reinterpret_cast<std::uintptr_t>(*ppMem) % Alignment == 0) &&
-         "Allocation not aligned correctly!");
+  for (const usm::pool_descriptor &Desc : Descriptors) {
+    umf::pool_unique_handle_t Pool =
+        DisjointPoolConfigs
+            ? usm::makeDisjointPool(
+                  makeProvider(Desc),
+                  DisjointPoolConfigs->Configs[descToDisjointPoolMemType(Desc)])
+            : usm::makeProxyPool(makeProvider(Desc));
+    if (ur_result_t Result = PoolManager.addPool(Desc, std::move(Pool));
+        Result != UR_RESULT_SUCCESS) {
+      throw Result;
+    }
+  }
+}
 
+ur_result_t ur_usm_pool_handle_t_::allocate(ur_device_handle_t Device,
+                                            ur_usm_type_t Type, size_t Size,
+                                            uint32_t Alignment, void **Mem) {
+  auto Pool =
+      PoolManager.getPool(usm::pool_descriptor{this, Context, Device, Type,
+                                               /*deviceReadOnly*/ false});
+  if (!Pool) {
+    return UR_RESULT_ERROR_INVALID_DEVICE;
+  }
+
+  Context->reclaimPoolFrees(/*Wait*/ false);
+  *Mem = umfPoolAlignedMalloc(*Pool, Size, Alignment);
+  if (*Mem == nullptr) {
+    // Memory of deferred frees may be all that is missing.
+    Context->reclaimPoolFrees(/*Wait*/ true);
+    *Mem = umfPoolAlignedMalloc(*Pool, Size, Alignment);
+  }
+  if (*Mem == nullptr) {
+    return umf::umf2urResult(umfPoolGetLastAllocationError(*Pool));
+  }
   return UR_RESULT_SUCCESS;
 }
 
-UR_APIEXPORT ur_result_t UR_APICALL
-urUSMSharedAlloc(ur_context_handle_t hContext, ur_device_handle_t hDevice,
-                 const ur_usm_desc_t *pUSMDesc, ur_usm_pool_handle_t,
-                 size_t size, void **ppMem) {
-
-  void *Ptr = nullptr;
+// Implements the USM allocation entry points. Device is null for host memory.
+static ur_result_t usmAlloc(ur_context_handle_t hContext,
+                            ur_device_handle_t hDevice, ur_usm_type_t Type,
+                            const ur_usm_desc_t *pUSMDesc,
+                            ur_usm_pool_handle_t hPool, size_t size,
+                            void **ppMem) {
   uint32_t Alignment = pUSMDesc ? pUSMDesc->align : 0;
-
-  if (pUSMDesc && pUSMDesc->align != 0 &&
-      ((pUSMDesc->align & (pUSMDesc->align - 1)) != 0)) {
+  if ((Alignment & (Alignment - 1)) != 0) {
     return UR_RESULT_ERROR_INVALID_VALUE;
   }
 
@@ -209,208 +339,258 @@ urUSMSharedAlloc(ur_context_handle_t hContext, ur_device_handle_t hDevice,
         static_cast<const ur_base_desc_t *>(pUSMDesc->pNext), AllocProperties));
   }
 
-  // First we need to look up the function pointer
-  clSharedMemAllocINTEL_fn FuncPtr = nullptr;
-  cl_context CLContext = cl_adapter::cast<cl_context>(hContext);
-  if (auto UrResult = cl_ext::getExtFuncFromContext<clSharedMemAllocINTEL_fn>(
-          CLContext, cl_ext::ExtFuncPtrCache->clSharedMemAllocINTELCache,
-          cl_ext::SharedMemAllocName, &FuncPtr)) {
-    return UrResult;
+  const cl_ext::ExtFuncPtrT &ExtFuncs = hContext->ExtFuncs;
+  const bool Supported =
+      Type == UR_USM_TYPE_HOST     ? ExtFuncs.clHostMemAllocINTEL != nullptr
+      : Type == UR_USM_TYPE_DEVICE ? ExtFuncs.clDeviceMemAllocINTEL != nullptr
+                                   : ExtFuncs.clSharedMemAllocINTEL != nullptr;
+  if (!Supported) {
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
   }
 
-  if (FuncPtr) {
-    cl_int ClResult = CL_SUCCESS;
-    Ptr = FuncPtr(CLContext, cl_adapter::cast<cl_device_id>(hDevice),
-                  AllocProperties.empty() ? nullptr : AllocProperties.data(),
-                  size, Alignment, cl_adapter::cast<cl_int *>(&ClResult));
-    if (ClResult == CL_INVALID_BUFFER_SIZE) {
-      return UR_RESULT_ERROR_INVALID_USM_SIZE;
+  // Allocation properties apply to whole OpenCL allocations, so allocations
+  // that have any can't be carved out of a pool. The list always ends with a
+  // zero.
+  if (AllocProperties.size() <= 1) {
+    if (!hPool) {
+      hPool = hContext->DefaultUSMPool.get();
+    }
+    if (hPool) {
+      // OpenCL rejects empty allocations, pools would return null.
+      if (size == 0) {
+        return UR_RESULT_ERROR_INVALID_USM_SIZE;
+      }
+      return hPool->allocate(hDevice, Type, size, Alignment, ppMem);
     }
-    CL_RETURN_ON_FAILURE(ClResult);
   }
 
-  *ppMem = Ptr;
-
-  assert((Alignment == 0 ||
-          reinterpret_cast<std::uintptr_t>(*ppMem) % Alignment == 0) &&
-         "Allocation not aligned correctly!");
+  cl_int ClResult = allocateCLUSM(
+      hContext, hDevice, Type,
+      AllocProperties.empty() ? nullptr : AllocProperties.data(), size,
+      Alignment, ppMem);
+  if (ClResult == CL_INVALID_BUFFER_SIZE) {
+    return UR_RESULT_ERROR_INVALID_USM_SIZE;
+  }
+  CL_RETURN_ON_FAILURE(ClResult);
   return UR_RESULT_SUCCESS;
 }
 
+UR_APIEXPORT ur_result_t UR_APICALL
+urUSMHostAlloc(ur_context_handle_t hContext, const ur_usm_desc_t *pUSMDesc,
+               ur_usm_pool_handle_t hPool, size_t size, void **ppMem) {
+  return usmAlloc(hContext, nullptr, UR_USM_TYPE_HOST, pUSMDesc, hPool, size,
+                  ppMem);
+}
+
+UR_APIEXPORT ur_result_t UR_APICALL
+urUSMDeviceAlloc(ur_context_handle_t hContext, ur_device_handle_t hDevice,
+                 const ur_usm_desc_t *pUSMDesc, ur_usm_pool_handle_t hPool,
+                 size_t size, void **ppMem) {
+  return usmAlloc(hContext, hDevice, UR_USM_TYPE_DEVICE, pUSMDesc, hPool, size,
+                  ppMem);
+}
+
+UR_APIEXPORT ur_result_t UR_APICALL
+urUSMSharedAlloc(ur_context_handle_t hContext, ur_device_handle_t hDevice,
+                 const ur_usm_desc_t *pUSMDesc, ur_usm_pool_handle_t hPool,
+                 size_t size, void **ppMem) {
+  return usmAlloc(hContext, hDevice, UR_USM_TYPE_SHARED, pUSMDesc, hPool, size,
+                  ppMem);
+}
+
 UR_APIEXPORT ur_result_t UR_APICALL urUSMFree(ur_context_handle_t hContext,
                                               void *pMem) {
+  // Kernels that might be still running can access the memory indirectly, so
+  // pooled memory is only handed out again once they have completed.
+  if (umf_memory_pool_handle_t Pool = umfPoolByPtr(pMem)) {
+    return hContext->deferPoolFree(Pool, pMem);
+  }
 
   // Use a blocking free to avoid issues with indirect access from kernels that
   // might be still running.
-  clMemBlockingFreeINTEL_fn FuncPtr = nullptr;
-
-  cl_context CLContext = cl_adapter::cast<cl_context>(hContext);
-  ur_result_t RetVal = UR_RESULT_ERROR_INVALID_OPERATION;
-  RetVal = cl_ext::getExtFuncFromContext<clMemBlockingFreeINTEL_fn>(
-      CLContext, cl_ext::ExtFuncPtrCache->clMemBlockingFreeINTELCache,
-      cl_ext::MemBlockingFreeName, &FuncPtr);
-
-  if (FuncPtr) {
-    RetVal = mapCLErrorToUR(FuncPtr(CLContext, pMem));
+  clMemBlockingFreeINTEL_fn FuncPtr = hContext->ExtFuncs.clMemBlockingFreeINTEL;
+  if (!FuncPtr) {
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
   }
 
-  return RetVal;
+  return mapCLErrorToUR(FuncPtr(hContext->CLContext, pMem));
 }
 
-UR_APIEXPORT ur_result_t UR_APICALL urEnqueueUSMFill(
-    ur_queue_handle_t hQueue, void *ptr, size_t patternSize,
-    const void *pPattern, size_t size, uint32_t numEventsInWaitList,
-    const ur_event_handle_t *phEventWaitList, ur_event_handle_t *phEvent) {
-  // Have to look up the context from the kernel
-  cl_context CLContext;
-  cl_int CLErr = clGetCommandQueueInfo(
-      cl_adapter::cast<cl_command_queue>(hQueue), CL_QUEUE_CONTEXT,
-      sizeof(cl_context), &CLContext, nullptr);
-  if (CLErr != CL_SUCCESS) {
-    return mapCLErrorToUR(CLErr);
+namespace {
+// Number of bytes filled on the host before the rest of a fill is done by
+// doubling them with device-side copies.
+constexpr size_t FillSeedSize = 64 * 1024;
+
+// Writes Size bytes of the repeated pattern to Dst, starting at byte
+// PatternOffset of the pattern.
+void writePattern(uint8_t *Dst, const uint8_t *Pattern, size_t PatternSize,
+                  size_t PatternOffset, size_t Size) {
+  while (Size) {
+    const size_t Chunk = std::min(Size, PatternSize - PatternOffset);
+    std::memcpy(Dst, Pattern + PatternOffset, Chunk);
+    Dst += Chunk;
+    Size -= Chunk;
+    PatternOffset = 0;
   }
+}
 
-  if (patternSize <= 128 && isPowerOf2(patternSize)) {
-    clEnqueueMemFillINTEL_fn EnqueueMemFill = nullptr;
-    UR_RETURN_ON_FAILURE(
-        cl_ext::getExtFuncFromContext<clEnqueueMemFillINTEL_fn>(
-            CLContext, cl_ext::ExtFuncPtrCache->clEnqueueMemFillINTELCache,
-            cl_ext::EnqueueMemFillName, &EnqueueMemFill));
+// Fills Size bytes at Ptr with the repeated pattern, starting at byte
+// PatternOffset of the pattern.
+//
+// OpenCL only supports pattern sizes which are powers of 2 and are as large as
+// the largest CL type (double16/long16 - 128 bytes). Other fills copy a seed
+// of whole patterns, written on the host, to the start of the destination and
+// then double the filled region with device-side copies until it covers Size.
+// The host allocation is therefore bounded by FillSeedSize, or the pattern size
+// if that's larger, rather than by the size of the fill.
+ur_result_t enqueueUSMFillPattern(ur_queue_handle_t hQueue, void *Ptr,
+                                  const void *pPattern, size_t PatternSize,
+                                  size_t PatternOffset, size_t Size,
+                                  cl_uint NumEventsInWaitList,
+                                  const cl_event *EventWaitList,
+                                  cl_event *OutEvent) {
+  const cl_ext::ExtFuncPtrT &ExtFuncs = hQueue->Context->ExtFuncs;
+
+  if (PatternSize <= 128 && isPowerOf2(PatternSize) && PatternOffset == 0 &&
+      Size % PatternSize == 0) {
+    clEnqueueMemFillINTEL_fn EnqueueMemFill = ExtFuncs.clEnqueueMemFillINTEL;
+    if (!EnqueueMemFill) {
+      return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+    }
 
-    CL_RETURN_ON_FAILURE(
-        EnqueueMemFill(cl_adapter::cast<cl_command_queue>(hQueue), ptr,
-                       pPattern, patternSize, size, numEventsInWaitList,
-                       cl_adapter::cast<const cl_event *>(phEventWaitList),
-                       cl_adapter::cast<cl_event *>(phEvent)));
+    CL_RETURN_ON_FAILURE(EnqueueMemFill(hQueue->CLQueue, Ptr, pPattern,
+                                        PatternSize, Size, NumEventsInWaitList,
+                                        EventWaitList, OutEvent));
     return UR_RESULT_SUCCESS;
   }
 
-  // OpenCL only supports pattern sizes which are powers of 2 and are as large
-  // as the largest CL type (double16/long16 - 128 bytes), anything larger or
-  // not a power of 2, we need to do on the host side and copy it into the
-  // target allocation.
-  clHostMemAllocINTEL_fn HostMemAlloc = nullptr;
-  UR_RETURN_ON_FAILURE(cl_ext::getExtFuncFromContext<clHostMemAllocINTEL_fn>(
-      CLContext, cl_ext::ExtFuncPtrCache->clHostMemAllocINTELCache,
-      cl_ext::HostMemAllocName, &HostMemAlloc));
-
-  clEnqueueMemcpyINTEL_fn USMMemcpy = nullptr;
-  UR_RETURN_ON_FAILURE(cl_ext::getExtFuncFromContext<clEnqueueMemcpyINTEL_fn>(
-      CLContext, cl_ext::ExtFuncPtrCache->clEnqueueMemcpyINTELCache,
-      cl_ext::EnqueueMemcpyName, &USMMemcpy));
-
-  clMemBlockingFreeINTEL_fn USMFree = nullptr;
-  UR_RETURN_ON_FAILURE(cl_ext::getExtFuncFromContext<clMemBlockingFreeINTEL_fn>(
-      CLContext, cl_ext::ExtFuncPtrCache->clMemBlockingFreeINTELCache,
-      cl_ext::MemBlockingFreeName, &USMFree));
+  clHostMemAllocINTEL_fn HostMemAlloc = ExtFuncs.clHostMemAllocINTEL;
+  clEnqueueMemcpyINTEL_fn USMMemcpy = ExtFuncs.clEnqueueMemcpyINTEL;
+  clMemBlockingFreeINTEL_fn USMFree = ExtFuncs.clMemBlockingFreeINTEL;
+  if (!HostMemAlloc || !USMMemcpy || !USMFree) {
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  }
 
+  // The seed holds whole patterns, so every doubling copy starts on a pattern
+  // boundary.
+  const size_t SeedSize = std::min(
+      Size, std::max(PatternSize, FillSeedSize / PatternSize * PatternSize));
+  cl_context CLContext = hQueue->Context->CLContext;
   cl_int ClErr = CL_SUCCESS;
-  auto HostBuffer =
-      static_cast<uint8_t *>(HostMemAlloc(CLContext, nullptr, size, 0, &ClErr));
+  auto Seed = static_cast<uint8_t *>(HostMemAlloc(CLContext, nullptr, SeedSize,
+                                                  0, &ClErr));
   CL_RETURN_ON_FAILURE(ClErr);
+  writePattern(Seed, static_cast<const uint8_t *>(pPattern), PatternSize,
+               PatternOffset, SeedSize);
 
-  auto *End = HostBuffer + size;
-  for (auto *Iter = HostBuffer; Iter < End; Iter += patternSize) {
-    std::memcpy(Iter, pPattern, patternSize);
+  cl_event Event = nullptr;
+  ClErr = USMMemcpy(hQueue->CLQueue, false, Ptr, Seed, SeedSize,
+                    NumEventsInWaitList, EventWaitList, &Event);
+  if (ClErr != CL_SUCCESS) {
+    USMFree(CLContext, Seed);
+    CL_RETURN_ON_FAILURE(ClErr);
   }
 
-  cl_event CopyEvent = nullptr;
-  CL_RETURN_ON_FAILURE(USMMemcpy(
-      cl_adapter::cast<cl_command_queue>(hQueue), false, ptr, HostBuffer, size,
-      numEventsInWaitList, cl_adapter::cast<const cl_event *>(phEventWaitList),
-      &CopyEvent));
-
-  if (phEvent) {
-    // Since we're releasing this in the callback above we need to retain it
-    // here to keep the user copy alive.
-    CL_RETURN_ON_FAILURE(clRetainEvent(CopyEvent));
-    *phEvent = cl_adapter::cast<ur_event_handle_t>(CopyEvent);
-  }
+  // The callback releases its own reference to the event, the copies below
+  // need another one.
+  CL_RETURN_ON_FAILURE(clRetainEvent(Event));
 
   // This self destructs taking the event and allocation with it.
-  auto Info = new AllocDeleterCallbackInfo(USMFree, CLContext, HostBuffer);
+  auto Info = new AllocDeleterCallbackInfo(USMFree, CLContext, Seed);
 
-  ClErr =
-      clSetEventCallback(CopyEvent, CL_COMPLETE,
-                         AllocDeleterCallback<AllocDeleterCallbackInfo>, Info);
+  ClErr = clSetEventCallback(
+      Event, CL_COMPLETE, AllocDeleterCallback<AllocDeleterCallbackInfo>, Info);
   if (ClErr != CL_SUCCESS) {
     // We can attempt to recover gracefully by attempting to wait for the copy
     // to finish and deleting the info struct here.
-    clWaitForEvents(1, &CopyEvent);
+    clWaitForEvents(1, &Event);
     delete Info;
-    clReleaseEvent(CopyEvent);
+    clReleaseEvent(Event);
+    clReleaseEvent(Event);
+    CL_RETURN_ON_FAILURE(ClErr);
+  }
+
+  auto Dst = static_cast<uint8_t *>(Ptr);
+  for (size_t Filled = SeedSize; Filled < Size; Filled *= 2) {
+    cl_event CopyEvent = nullptr;
+    ClErr = USMMemcpy(hQueue->CLQueue, false, Dst + Filled, Dst,
+                      std::min(Filled, Size - Filled), 1, &Event, &CopyEvent);
+    clReleaseEvent(Event);
     CL_RETURN_ON_FAILURE(ClErr);
+    Event = CopyEvent;
+  }
+
+  if (OutEvent) {
+    *OutEvent = Event;
+  } else {
+    CL_RETURN_ON_FAILURE(clReleaseEvent(Event));
   }
 
   return UR_RESULT_SUCCESS;
 }
+} // namespace
+
+UR_APIEXPORT ur_result_t UR_APICALL urEnqueueUSMFill(
+    ur_queue_handle_t hQueue, void *ptr, size_t patternSize,
+    const void *pPattern, size_t size, uint32_t numEventsInWaitList,
+    const ur_event_handle_t *phEventWaitList, ur_event_handle_t *phEvent) {
+  return enqueueUSMFillPattern(
+      hQueue, ptr, pPattern, patternSize, 0, size, numEventsInWaitList,
+      cl_adapter::cast<const cl_event *>(phEventWaitList),
+      cl_adapter::cast<cl_event *>(phEvent));
+}
 
 UR_APIEXPORT ur_result_t UR_APICALL urEnqueueUSMMemcpy(
     ur_queue_handle_t hQueue, bool blocking, void *pDst, const void *pSrc,
     size_t size, uint32_t numEventsInWaitList,
     const ur_event_handle_t *phEventWaitList, ur_event_handle_t *phEvent) {
 
-  // Have to look up the context from the kernel
-  cl_context CLContext;
-  cl_int CLErr = clGetCommandQueueInfo(
-      cl_adapter::cast<cl_command_queue>(hQueue), CL_QUEUE_CONTEXT,
-      sizeof(cl_context), &CLContext, nullptr);
-  if (CLErr != CL_SUCCESS) {
-    return mapCLErrorToUR(CLErr);
+  cl_context CLContext = hQueue->Context->CLContext;
+  const cl_ext::ExtFuncPtrT &ExtFuncs = hQueue->Context->ExtFuncs;
+  clGetMemAllocInfoINTEL_fn GetMemAllocInfo = ExtFuncs.clGetMemAllocInfoINTEL;
+  clEnqueueMemcpyINTEL_fn USMMemcpy = ExtFuncs.clEnqueueMemcpyINTEL;
+  clMemBlockingFreeINTEL_fn USMFree = ExtFuncs.clMemBlockingFreeINTEL;
+  if (!GetMemAllocInfo || !USMMemcpy || !USMFree) {
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
   }
 
-  clGetMemAllocInfoINTEL_fn GetMemAllocInfo = nullptr;
-  UR_RETURN_ON_FAILURE(cl_ext::getExtFuncFromContext<clGetMemAllocInfoINTEL_fn>(
-      CLContext, cl_ext::ExtFuncPtrCache->clGetMemAllocInfoINTELCache,
-      cl_ext::GetMemAllocInfoName, &GetMemAllocInfo));
-
-  clEnqueueMemcpyINTEL_fn USMMemcpy = nullptr;
-  UR_RETURN_ON_FAILURE(cl_ext::getExtFuncFromContext<clEnqueueMemcpyINTEL_fn>(
-      CLContext, cl_ext::ExtFuncPtrCache->clEnqueueMemcpyINTELCache,
-      cl_ext::EnqueueMemcpyName, &USMMemcpy));
-
-  clMemBlockingFreeINTEL_fn USMFree = nullptr;
-  UR_RETURN_ON_FAILURE(cl_ext::getExtFuncFromContext<clMemBlockingFreeINTEL_fn>(
-      CLContext, cl_ext::ExtFuncPtrCache->clMemBlockingFreeINTELCache,
-      cl_ext::MemBlockingFreeName, &USMFree));
-
   // Check if the two allocations are DEVICE allocations from different
   // devices, if they are we need to do the copy indirectly via a host
-  // allocation.
+  // allocation. This can't happen in a single device context, so skip the
+  // queries there.
   cl_device_id SrcDevice = 0, DstDevice = 0;
-  CL_RETURN_ON_FAILURE(
-      GetMemAllocInfo(CLContext, pSrc, CL_MEM_ALLOC_DEVICE_INTEL,
-                      sizeof(cl_device_id), &SrcDevice, nullptr));
-  CL_RETURN_ON_FAILURE(
-      GetMemAllocInfo(CLContext, pDst, CL_MEM_ALLOC_DEVICE_INTEL,
-                      sizeof(cl_device_id), &DstDevice, nullptr));
+  if (hQueue->Context->Devices.size() > 1) {
+    CL_RETURN_ON_FAILURE(
+        GetMemAllocInfo(CLContext, pSrc, CL_MEM_ALLOC_DEVICE_INTEL,
+                        sizeof(cl_device_id), &SrcDevice, nullptr));
+    CL_RETURN_ON_FAILURE(
+        GetMemAllocInfo(CLContext, pDst, CL_MEM_ALLOC_DEVICE_INTEL,
+                        sizeof(cl_device_id), &DstDevice, nullptr));
+  }
 
   if ((SrcDevice && DstDevice) && SrcDevice != DstDevice) {
     // We need a queue associated with each device, so first figure out which
     // one we weren't given.
-    cl_device_id QueueDevice = nullptr;
-    CL_RETURN_ON_FAILURE(clGetCommandQueueInfo(
-        cl_adapter::cast<cl_command_queue>(hQueue), CL_QUEUE_DEVICE,
-        sizeof(QueueDevice), &QueueDevice, nullptr));
-
+    cl_int CLErr = CL_SUCCESS;
     cl_command_queue MissingQueue = nullptr, SrcQueue = nullptr,
                      DstQueue = nullptr;
-    if (QueueDevice == SrcDevice) {
+    if (hQueue->Device->CLDevice == SrcDevice) {
       MissingQueue = clCreateCommandQueue(CLContext, DstDevice, 0, &CLErr);
-      SrcQueue = cl_adapter::cast<cl_command_queue>(hQueue);
+      SrcQueue = hQueue->CLQueue;
       DstQueue = MissingQueue;
     } else {
       MissingQueue = clCreateCommandQueue(CLContext, SrcDevice, 0, &CLErr);
-      DstQueue = cl_adapter::cast<cl_command_queue>(hQueue);
+      DstQueue = hQueue->CLQueue;
       SrcQueue = MissingQueue;
     }
     CL_RETURN_ON_FAILURE(CLErr);
 
     cl_event HostCopyEvent = nullptr, FinalCopyEvent = nullptr;
-    clHostMemAllocINTEL_fn HostMemAlloc = nullptr;
-    UR_RETURN_ON_FAILURE(cl_ext::getExtFuncFromContext<clHostMemAllocINTEL_fn>(
-        CLContext, cl_ext::ExtFuncPtrCache->clHostMemAllocINTELCache,
-        cl_ext::HostMemAllocName, &HostMemAlloc));
+    clHostMemAllocINTEL_fn HostMemAlloc = ExtFuncs.clHostMemAllocINTEL;
+    if (!HostMemAlloc) {
+      clReleaseCommandQueue(MissingQueue);
+      return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+    }
 
     auto HostAlloc = HostMemAlloc(CLContext, nullptr, size, 0, &CLErr);
     CL_RETURN_ON_FAILURE(CLErr);
@@ -476,11 +656,10 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueUSMMemcpy(
       }
     }
   } else {
-    CL_RETURN_ON_FAILURE(
-        USMMemcpy(cl_adapter::cast<cl_command_queue>(hQueue), blocking, pDst,
-                  pSrc, size, numEventsInWaitList,
-                  cl_adapter::cast<const cl_event *>(phEventWaitList),
-                  cl_adapter::cast<cl_event *>(phEvent)));
+    CL_RETURN_ON_FAILURE(USMMemcpy(
+        hQueue->CLQueue, blocking, pDst, pSrc, size, numEventsInWaitList,
+        cl_adapter::cast<const cl_event *>(phEventWaitList),
+        cl_adapter::cast<cl_event *>(phEvent)));
   }
 
   return UR_RESULT_SUCCESS;
@@ -494,7 +673,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueUSMPrefetch(
     ur_event_handle_t *phEvent) {
 
   return mapCLErrorToUR(clEnqueueMarkerWithWaitList(
-      cl_adapter::cast<cl_command_queue>(hQueue), numEventsInWaitList,
+      hQueue->CLQueue, numEventsInWaitList,
       cl_adapter::cast<const cl_event *>(phEventWaitList),
       cl_adapter::cast<cl_event *>(phEvent)));
 
@@ -533,8 +712,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueUSMAdvise(
     ur_event_handle_t *phEvent) {
 
   return mapCLErrorToUR(clEnqueueMarkerWithWaitList(
-      cl_adapter::cast<cl_command_queue>(hQueue), 0, nullptr,
-      reinterpret_cast<cl_event *>(phEvent)));
+      hQueue->CLQueue, 0, nullptr, reinterpret_cast<cl_event *>(phEvent)));
 
   /*
   // Change to use this once drivers support it.
@@ -566,40 +744,201 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueUSMAdvise(
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urEnqueueUSMFill2D(
-    [[maybe_unused]] ur_queue_handle_t hQueue, [[maybe_unused]] void *pMem,
-    [[maybe_unused]] size_t pitch, [[maybe_unused]] size_t patternSize,
-    [[maybe_unused]] const void *pPattern, [[maybe_unused]] size_t width,
-    [[maybe_unused]] size_t height,
-    [[maybe_unused]] uint32_t numEventsInWaitList,
-    [[maybe_unused]] const ur_event_handle_t *phEventWaitList,
-    [[maybe_unused]] ur_event_handle_t *phEvent) {
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+    ur_queue_handle_t hQueue, void *pMem, size_t pitch, size_t patternSize,
+    const void *pPattern, size_t width, size_t height,
+    uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
+    ur_event_handle_t *phEvent) {
+  const cl_event *CLWaitList =
+      cl_adapter::cast<const cl_event *>(phEventWaitList);
+
+  // The pattern carries on from the end of one row to the start of the next,
+  // so without padding this is a plain fill.
+  if (pitch == width) {
+    return enqueueUSMFillPattern(
+        hQueue, pMem, pPattern, patternSize, 0, width * height,
+        numEventsInWaitList, CLWaitList, cl_adapter::cast<cl_event *>(phEvent));
+  }
+
+  clEnqueueMemcpyINTEL_fn USMMemcpy =
+      hQueue->Context->ExtFuncs.clEnqueueMemcpyINTEL;
+  if (!USMMemcpy) {
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  }
+
+  // Rows start at the same offset into the pattern every Period rows. The
+  // first Period rows are filled and the others are copied from them, unless
+  // every row can be filled natively.
+  const bool NativeRowFill = patternSize <= 128 && isPowerOf2(patternSize) &&
+                             width % patternSize == 0;
+  const size_t Period =
+      NativeRowFill ? height : patternSize / std::gcd(width, patternSize);
+
+  auto Dst = static_cast<uint8_t *>(pMem);
+  std::vector<cl_event> Events;
+  Events.reserve(height);
+  ur_result_t Result = UR_RESULT_SUCCESS;
+  for (size_t Row = 0; Row < height && Result == UR_RESULT_SUCCESS; Row++) {
+    cl_event Event = nullptr;
+    if (Row < Period) {
+      Result = enqueueUSMFillPattern(hQueue, Dst + Row * pitch, pPattern,
+                                     patternSize, (Row * width) % patternSize,
+                                     width, numEventsInWaitList, CLWaitList,
+                                     &Event);
+    } else {
+      Result = mapCLErrorToUR(USMMemcpy(hQueue->CLQueue, false,
+                                        Dst + Row * pitch,
+                                        Dst + (Row % Period) * pitch, width, 1,
+                                        &Events[Row % Period], &Event));
+    }
+    if (Result == UR_RESULT_SUCCESS) {
+      Events.push_back(Event);
+    }
+  }
+
+  if (phEvent && Result == UR_RESULT_SUCCESS) {
+    Result = mapCLErrorToUR(clEnqueueBarrierWithWaitList(
+        hQueue->CLQueue, Events.size(), Events.data(),
+        cl_adapter::cast<cl_event *>(phEvent)));
+  }
+  for (const auto &E : Events) {
+    clReleaseEvent(E);
+  }
+  return Result;
+}
+
+namespace {
+// Returns whether kernels running on the device of the queue can access Ptr.
+ur_result_t isUSMAccessibleFromQueue(ur_queue_handle_t hQueue, const void *Ptr,
+                                     bool &Accessible) {
+  Accessible = false;
+  clGetMemAllocInfoINTEL_fn GetMemAllocInfo =
+      hQueue->Context->ExtFuncs.clGetMemAllocInfoINTEL;
+  if (!GetMemAllocInfo) {
+    return UR_RESULT_SUCCESS;
+  }
+
+  cl_context CLContext = hQueue->Context->CLContext;
+  cl_unified_shared_memory_type_intel Type = CL_MEM_TYPE_UNKNOWN_INTEL;
+  CL_RETURN_ON_FAILURE(GetMemAllocInfo(CLContext, Ptr, CL_MEM_ALLOC_TYPE_INTEL,
+                                       sizeof(Type), &Type, nullptr));
+  if (Type == CL_MEM_TYPE_DEVICE_INTEL) {
+    cl_device_id Device = nullptr;
+    CL_RETURN_ON_FAILURE(GetMemAllocInfo(CLContext, Ptr,
+                                         CL_MEM_ALLOC_DEVICE_INTEL,
+                                         sizeof(Device), &Device, nullptr));
+    Accessible = Device == hQueue->Device->CLDevice;
+  } else {
+    Accessible = Type != CL_MEM_TYPE_UNKNOWN_INTEL;
+  }
+  return UR_RESULT_SUCCESS;
+}
+
+// Copies a 2D region with a single launch of one of the context's helper copy
+// kernels. Launched is set to false if the helper kernels aren't available.
+ur_result_t enqueueUSMCopy2DKernel(ur_queue_handle_t hQueue, void *pDst,
+                                   size_t DstPitch, const void *pSrc,
+                                   size_t SrcPitch, size_t Width, size_t Height,
+                                   cl_uint NumEventsInWaitList,
+                                   const cl_event *EventWaitList,
+                                   cl_event *OutEvent, bool &Launched) {
+  Launched = false;
+  ur_context_handle_t Context = hQueue->Context;
+  clSetKernelArgMemPointerINTEL_fn SetKernelArgMemPointer =
+      Context->ExtFuncs.clSetKernelArgMemPointerINTEL;
+  if (!SetKernelArgMemPointer) {
+    return UR_RESULT_SUCCESS;
+  }
+
+  // Copy 16 bytes per work-item if the pointers and sizes allow it.
+  const bool Vec16 =
+      ((reinterpret_cast<uintptr_t>(pDst) | reinterpret_cast<uintptr_t>(pSrc) |
+        DstPitch | SrcPitch | Width) %
+       16) == 0;
+  const size_t ElementSize = Vec16 ? 16 : 1;
+  const cl_ulong DstElementPitch = DstPitch / ElementSize;
+  const cl_ulong SrcElementPitch = SrcPitch / ElementSize;
+  const size_t GlobalSize[2] = {Width / ElementSize, Height};
+
+  std::lock_guard<std::mutex> Lock{Context->HelperKernelMutex};
+  cl_kernel Kernel = nullptr;
+  UR_RETURN_ON_FAILURE(Context->getHelperKernel(
+      Vec16 ? "urUSMCopy2DVec16" : "urUSMCopy2D", Kernel));
+  if (!Kernel) {
+    return UR_RESULT_SUCCESS;
+  }
+
+  CL_RETURN_ON_FAILURE(SetKernelArgMemPointer(Kernel, 0, pDst));
+  CL_RETURN_ON_FAILURE(clSetKernelArg(Kernel, 1, sizeof(DstElementPitch),
+                                      &DstElementPitch));
+  CL_RETURN_ON_FAILURE(SetKernelArgMemPointer(Kernel, 2, pSrc));
+  CL_RETURN_ON_FAILURE(clSetKernelArg(Kernel, 3, sizeof(SrcElementPitch),
+                                      &SrcElementPitch));
+  CL_RETURN_ON_FAILURE(clEnqueueNDRangeKernel(
+      hQueue->CLQueue, Kernel, 2, nullptr, GlobalSize, nullptr,
+      NumEventsInWaitList, EventWaitList, OutEvent));
+  Launched = true;
+  return UR_RESULT_SUCCESS;
 }
+} // namespace
 
 UR_APIEXPORT ur_result_t UR_APICALL urEnqueueUSMMemcpy2D(
     ur_queue_handle_t hQueue, bool blocking, void *pDst, size_t dstPitch,
     const void *pSrc, size_t srcPitch, size_t width, size_t height,
     uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
     ur_event_handle_t *phEvent) {
-  cl_context CLContext;
-  CL_RETURN_ON_FAILURE(clGetCommandQueueInfo(
-      cl_adapter::cast<cl_command_queue>(hQueue), CL_QUEUE_CONTEXT,
-      sizeof(cl_context), &CLContext, nullptr));
+  clEnqueueMemcpyINTEL_fn FuncPtr =
+      hQueue->Context->ExtFuncs.clEnqueueMemcpyINTEL;
+  if (!FuncPtr) {
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  }
 
-  clEnqueueMemcpyINTEL_fn FuncPtr = nullptr;
-  ur_result_t RetVal = cl_ext::getExtFuncFromContext<clEnqueueMemcpyINTEL_fn>(
-      CLContext, cl_ext::ExtFuncPtrCache->clEnqueueMemcpyINTELCache,
-      cl_ext::EnqueueMemcpyName, &FuncPtr);
+  // Regions without padding are a single copy.
+  if (height == 1 || (dstPitch == width && srcPitch == width)) {
+    CL_RETURN_ON_FAILURE(
+        FuncPtr(hQueue->CLQueue, blocking, pDst, pSrc, width * height,
+                numEventsInWaitList,
+                cl_adapter::cast<const cl_event *>(phEventWaitList),
+                cl_adapter::cast<cl_event *>(phEvent)));
+    return UR_RESULT_SUCCESS;
+  }
 
-  if (!FuncPtr) {
-    return RetVal;
+  // If the device can access both allocations, a kernel copies the whole
+  // region in one command. Other memory, such as pageable host memory, is
+  // copied row by row.
+  bool DstAccessible = false, SrcAccessible = false;
+  UR_RETURN_ON_FAILURE(isUSMAccessibleFromQueue(hQueue, pDst, DstAccessible));
+  if (DstAccessible) {
+    UR_RETURN_ON_FAILURE(
+        isUSMAccessibleFromQueue(hQueue, pSrc, SrcAccessible));
+  }
+  if (DstAccessible && SrcAccessible) {
+    cl_event Event = nullptr;
+    bool Launched = false;
+    UR_RETURN_ON_FAILURE(enqueueUSMCopy2DKernel(
+        hQueue, pDst, dstPitch, pSrc, srcPitch, width, height,
+        numEventsInWaitList,
+        cl_adapter::cast<const cl_event *>(phEventWaitList), &Event,
+        Launched));
+    if (Launched) {
+      cl_int ClResult = CL_SUCCESS;
+      if (blocking) {
+        ClResult = clWaitForEvents(1, &Event);
+      }
+      if (phEvent) {
+        *phEvent = cl_adapter::cast<ur_event_handle_t>(Event);
+      } else {
+        clReleaseEvent(Event);
+      }
+      CL_RETURN_ON_FAILURE(ClResult);
+      return UR_RESULT_SUCCESS;
+    }
   }
 
   std::vector<cl_event> Events(height);
   for (size_t HeightIndex = 0; HeightIndex < height; HeightIndex++) {
     cl_event Event = nullptr;
     auto ClResult =
-        FuncPtr(cl_adapter::cast<cl_command_queue>(hQueue), false,
+        FuncPtr(hQueue->CLQueue, false,
                 static_cast<uint8_t *>(pDst) + dstPitch * HeightIndex,
                 static_cast<const uint8_t *>(pSrc) + srcPitch * HeightIndex,
                 width, numEventsInWaitList,
@@ -618,8 +957,8 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueUSMMemcpy2D(
   }
   if (phEvent && ClResult == CL_SUCCESS) {
     ClResult = clEnqueueBarrierWithWaitList(
-        cl_adapter::cast<cl_command_queue>(hQueue), Events.size(),
-        Events.data(), cl_adapter::cast<cl_event *>(phEvent));
+        hQueue->CLQueue, Events.size(), Events.data(),
+        cl_adapter::cast<cl_event *>(phEvent));
   }
   for (const auto &E : Events) {
     CL_RETURN_ON_FAILURE(clReleaseEvent(E));
@@ -648,11 +987,11 @@ urUSMGetMemAllocInfo(ur_context_handle_t hContext, const void *pMem,
                      ur_usm_alloc_info_t propName, size_t propSize,
                      void *pPropValue, size_t *pPropSizeRet) {
 
-  clGetMemAllocInfoINTEL_fn GetMemAllocInfo = nullptr;
-  cl_context CLContext = cl_adapter::cast<cl_context>(hContext);
-  UR_RETURN_ON_FAILURE(cl_ext::getExtFuncFromContext<clGetMemAllocInfoINTEL_fn>(
-      CLContext, cl_ext::ExtFuncPtrCache->clGetMemAllocInfoINTELCache,
-      cl_ext::GetMemAllocInfoName, &GetMemAllocInfo));
+  clGetMemAllocInfoINTEL_fn GetMemAllocInfo =
+      hContext->ExtFuncs.clGetMemAllocInfoINTEL;
+  if (!GetMemAllocInfo) {
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  }
 
   cl_mem_info_intel PropNameCL;
   switch (propName) {
@@ -673,9 +1012,8 @@ urUSMGetMemAllocInfo(ur_context_handle_t hContext, const void *pMem,
   }
 
   size_t CheckPropSize = 0;
-  cl_int ClErr =
-      GetMemAllocInfo(cl_adapter::cast<cl_context>(hContext), pMem, PropNameCL,
-                      propSize, pPropValue, &CheckPropSize);
+  cl_int ClErr = GetMemAllocInfo(hContext->CLContext, pMem, PropNameCL,
+                                 propSize, pPropValue, &CheckPropSize);
   if (pPropValue && CheckPropSize != propSize) {
     return UR_RESULT_ERROR_INVALID_SIZE;
   }
@@ -705,26 +1043,59 @@ urUSMReleaseExp([[maybe_unused]] ur_context_handle_t Context,
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL
-urUSMPoolCreate([[maybe_unused]] ur_context_handle_t hContext,
-                [[maybe_unused]] ur_usm_pool_desc_t *pPoolDesc,
-                [[maybe_unused]] ur_usm_pool_handle_t *ppPool) {
+urUSMPoolCreate(ur_context_handle_t hContext, ur_usm_pool_desc_t *pPoolDesc,
+                ur_usm_pool_handle_t *ppPool) {
+  // Without pool tracking, pool allocations can't be freed.
+#ifdef UMF_ENABLE_POOL_TRACKING
+  if (pPoolDesc->flags & UR_USM_POOL_FLAG_ZERO_INITIALIZE_BLOCK) {
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  }
+  try {
+    *ppPool = new ur_usm_pool_handle_t_(hContext, pPoolDesc);
+  } catch (ur_result_t Err) {
+    return Err;
+  } catch (umf_result_t Err) {
+    return umf::umf2urResult(Err);
+  } catch (...) {
+    return UR_RESULT_ERROR_UNKNOWN;
+  }
+  return urContextRetain(hContext);
+#else
+  std::ignore = hContext;
+  std::ignore = pPoolDesc;
+  std::ignore = ppPool;
   return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+#endif
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL
-urUSMPoolRetain([[maybe_unused]] ur_usm_pool_handle_t pPool) {
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+urUSMPoolRetain(ur_usm_pool_handle_t pPool) {
+  pPool->RefCount++;
+  return UR_RESULT_SUCCESS;
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL
-urUSMPoolRelease([[maybe_unused]] ur_usm_pool_handle_t pPool) {
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+urUSMPoolRelease(ur_usm_pool_handle_t pPool) {
+  if (--pPool->RefCount != 0) {
+    return UR_RESULT_SUCCESS;
+  }
+  ur_context_handle_t Context = pPool->Context;
+  Context->reclaimPoolFrees(/*Wait*/ true);
+  delete pPool;
+  return urContextRelease(Context);
 }
 
-UR_APIEXPORT ur_result_t UR_APICALL urUSMPoolGetInfo(
-    [[maybe_unused]] ur_usm_pool_handle_t hPool,
-    [[maybe_unused]] ur_usm_pool_info_t propName,
-    [[maybe_unused]] size_t propSize, [[maybe_unused]] void *pPropValue,
-    [[maybe_unused]] size_t *pPropSizeRet) {
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+UR_APIEXPORT ur_result_t UR_APICALL
+urUSMPoolGetInfo(ur_usm_pool_handle_t hPool, ur_usm_pool_info_t propName,
+                 size_t propSize, void *pPropValue, size_t *pPropSizeRet) {
+  UrReturnHelper ReturnValue(propSize, pPropValue, pPropSizeRet);
+
+  switch (propName) {
+  case UR_USM_POOL_INFO_REFERENCE_COUNT:
+    return ReturnValue(hPool->RefCount.load());
+  case UR_USM_POOL_INFO_CONTEXT:
+    return ReturnValue(hPool->Context);
+  default:
+    return UR_RESULT_ERROR_UNSUPPORTED_ENUMERATION;
+  }
 }
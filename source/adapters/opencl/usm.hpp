@@ -8,9 +8,39 @@
 //
 //===----------------------------------------------------------------------===//
 
+#pragma once
+
 #include "CL/cl_ext.h"
 #include <CL/cl.h>
 
+#include "common.hpp"
+
+#include <atomic>
+#include <umf_pools/disjoint_pool_config_parser.hpp>
+#include <ur_pool_manager.hpp>
+
+/// A USM pool. Allocations are carved out of UMF pools, one per memory type and
+/// device of the context, which get their memory from the
+/// cl_intel_unified_shared_memory entry points. The pools are disjoint pools
+/// configured by UR_OPENCL_USM_ALLOCATOR, or pass every allocation through if
+/// UR_OPENCL_DISABLE_USM_ALLOCATOR is set. Each context has a default pool
+/// that serves allocations which don't name one.
+struct ur_usm_pool_handle_t_ {
+  ur_usm_pool_handle_t_(ur_context_handle_t Context,
+                        ur_usm_pool_desc_t *PoolDesc);
+
+  /// Allocates Size bytes of Type memory, Device is null for host memory.
+  /// Returns UR_RESULT_ERROR_INVALID_DEVICE if no pool serves Device.
+  ur_result_t allocate(ur_device_handle_t Device, ur_usm_type_t Type,
+                       size_t Size, uint32_t Alignment, void **Mem);
+
+  ur_context_handle_t Context;
+  std::atomic<uint32_t> RefCount = 1;
+
+private:
+  usm::pool_manager<usm::pool_descriptor> PoolManager;
+};
+
 // This struct is intended to be used in conjunction with the below callback via
 // clSetEventCallback to release temporary allocations created by the adapter to
 // implement certain USM operations.
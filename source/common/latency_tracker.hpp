@@ -21,6 +21,19 @@
 
 #include <hdr/hdr_histogram.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_set>
+
+#ifndef _WIN32
+#include <csignal>
+#endif
+
 static inline bool trackLatency = []() {
   try {
     auto map = getenv_to_map("UR_LOG_LATENCY");
@@ -53,6 +66,23 @@ struct latencyValues {
 using histogram_ptr =
     std::unique_ptr<struct hdr_histogram, decltype(&hdr_close)>;
 
+struct histogram_config {
+  int64_t lowestDiscernibleValue = 1;
+  int64_t highestTrackableValue = 100'000'000'000;
+  int significantFigures = 3;
+};
+
+static inline histogram_ptr makeHistogram(const histogram_config &config) {
+  struct hdr_histogram *cHistogram = nullptr;
+  auto ret = hdr_init(config.lowestDiscernibleValue,
+                      config.highestTrackableValue, config.significantFigures,
+                      &cHistogram);
+  if (ret != 0) {
+    logger::error("Failed to initialize latency histogram");
+  }
+  return histogram_ptr(cHistogram, &hdr_close);
+}
+
 static inline latencyValues getValues(const struct hdr_histogram *histogram) {
   latencyValues values;
   values.count = histogram->total_count;
@@ -70,28 +100,76 @@ static inline latencyValues getValues(const struct hdr_histogram *histogram) {
   return values;
 }
 
-class latency_printer {
+class latency_printer;
+inline latency_printer &globalLatencyPrinter();
+
+// Histogram of a single thread for a single scope. Values are recorded by the
+// owning thread only, the lock is taken by readers merging histograms while
+// the thread is alive, so it is almost never contended.
+class latency_histogram {
 public:
-  latency_printer() : logger(logger::create_logger("latency", true, false)) {}
+  inline latency_histogram(const char *name,
+                           latency_printer &printer = globalLatencyPrinter(),
+                           histogram_config config = {});
+
+  latency_histogram(const latency_histogram &) = delete;
+  latency_histogram(latency_histogram &&) = delete;
+
+  inline ~latency_histogram();
+
+  inline void trackValue(int64_t value) {
+    std::scoped_lock<std::mutex> lock(mutex);
+    hdr_record_value(histogram.get(), value);
+  }
+
+private:
+  const char *name;
+  const histogram_config config;
+  histogram_ptr histogram;
+  std::mutex mutex;
+  latency_printer &printer;
 
-  inline void publishLatency(const std::string &name, histogram_ptr histogram) {
-    auto [it, inserted] = values.try_emplace(name, std::move(histogram));
-    if (!inserted) {
-      // combine histograms
-      hdr_add(it->second.get(), histogram.get());
+  friend class latency_printer;
+};
+
+// Aggregates the histograms of all threads. Histograms of live threads are
+// merged when read, those of exited threads are merged when they exit.
+//
+// Besides printing at exit, the histograms can be printed every
+// UR_LATENCY_DUMP_INTERVAL seconds, or when the process receives the signal
+// number UR_LATENCY_DUMP_SIGNAL, and be read with toString().
+class latency_printer {
+public:
+  latency_printer() : logger(logger::create_logger("latency", true, false)) {
+    if (trackLatency) {
+      startExporter();
     }
   }
 
   inline ~latency_printer() {
+    stopExporter();
     if (trackLatency) {
       print();
     }
   }
 
+  inline void registerHistogram(latency_histogram *histogram) {
+    std::scoped_lock<std::mutex> lock(mutex);
+    live.insert(histogram);
+  }
+
+  // Moves the values of a histogram whose thread exits to the totals.
+  inline void retireHistogram(latency_histogram *histogram) {
+    std::scoped_lock<std::mutex> lock(mutex);
+    live.erase(histogram);
+    addTo(retired, histogram->name, histogram->config,
+          histogram->histogram.get());
+  }
+
   inline void print() {
     printHeader();
 
-    for (auto &[name, histogram] : values) {
+    for (auto &[name, histogram] : snapshot()) {
       auto value = getValues(histogram.get());
       auto f = groupDigits<int64_t>;
       logger.log(logger::Level::INFO,
@@ -105,7 +183,59 @@ public:
     }
   }
 
+  // Same columns as print(), without digit grouping.
+  inline std::string toString() {
+    std::ostringstream out;
+    out << "name,mean";
+    for (auto percentile : percentiles) {
+      out << ",p" << percentile;
+    }
+    out << ",count,sum,min,max,stdev,unit\n";
+
+    for (auto &[name, histogram] : snapshot()) {
+      auto value = getValues(histogram.get());
+      out << name << ',' << value.mean;
+      for (auto percentileValue : value.percentileValues) {
+        out << ',' << percentileValue;
+      }
+      out << ',' << value.count << ',' << value.count * value.mean << ','
+          << value.min << ',' << value.max << ',' << value.stddev << ",ns\n";
+    }
+    return out.str();
+  }
+
 private:
+  inline static void addTo(std::map<std::string, histogram_ptr> &histograms,
+                           const std::string &name,
+                           const histogram_config &config,
+                           const struct hdr_histogram *histogram) {
+    if (!histogram || histogram->total_count == 0) {
+      return;
+    }
+    auto [it, inserted] =
+        histograms.try_emplace(name, histogram_ptr(nullptr, &hdr_close));
+    if (inserted) {
+      it->second = makeHistogram(config);
+    }
+    if (it->second) {
+      hdr_add(it->second.get(), histogram);
+    }
+  }
+
+  inline std::map<std::string, histogram_ptr> snapshot() {
+    std::map<std::string, histogram_ptr> values;
+    std::scoped_lock<std::mutex> lock(mutex);
+    for (auto &[name, histogram] : retired) {
+      addTo(values, name, {}, histogram.get());
+    }
+    for (auto *histogram : live) {
+      std::scoped_lock<std::mutex> histogramLock(histogram->mutex);
+      addTo(values, histogram->name, histogram->config,
+            histogram->histogram.get());
+    }
+    return values;
+  }
+
   inline void printHeader() {
     logger.log(logger::Level::INFO, "Latency histogram:");
     logger.log(logger::Level::INFO,
@@ -115,60 +245,154 @@ private:
                percentiles[4], percentiles[5], percentiles[6]);
   }
 
-  std::map<std::string, histogram_ptr> values;
-  logger::Logger logger;
-};
+#ifndef _WIN32
+  // The handler is installed once per library, chaining to the handler
+  // installed before it, which may be the one of another library.
+  static inline std::atomic<bool> dumpRequested{false};
+  static inline std::mutex signalMutex;
+  static inline int dumpSignal = 0;
+  static inline struct sigaction previousAction;
+
+  static void onDumpSignal(int signal, siginfo_t *info, void *context) {
+    dumpRequested.store(true);
+    if (previousAction.sa_flags & SA_SIGINFO) {
+      if (previousAction.sa_sigaction) {
+        previousAction.sa_sigaction(signal, info, context);
+      }
+    } else if (previousAction.sa_handler != SIG_DFL &&
+               previousAction.sa_handler != SIG_IGN) {
+      previousAction.sa_handler(signal);
+    }
+  }
 
-inline latency_printer &globalLatencyPrinter() {
-  static latency_printer printer;
-  return printer;
-}
+  inline bool installSignalHandler(int signal) {
+    std::scoped_lock<std::mutex> lock(signalMutex);
+    if (dumpSignal) {
+      return dumpSignal == signal;
+    }
+    struct sigaction action {};
+    action.sa_sigaction = onDumpSignal;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(signal, &action, &previousAction) != 0) {
+      return false;
+    }
+    dumpSignal = signal;
+    ownsSignalHandler = true;
+    return true;
+  }
 
-class latency_histogram {
-public:
-  inline latency_histogram(const char *name,
-                           latency_printer &printer = globalLatencyPrinter(),
-                           int64_t lowestDiscernibleValue = 1,
-                           int64_t highestTrackableValue = 100'000'000'000,
-                           int significantFigures = 3)
-      : name(name), histogram(nullptr, nullptr), printer(printer) {
-    if (trackLatency) {
-      struct hdr_histogram *cHistogram;
-      auto ret = hdr_init(lowestDiscernibleValue, highestTrackableValue,
-                          significantFigures, &cHistogram);
-      if (ret != 0) {
-        logger::error("Failed to initialize latency histogram");
-      }
-      histogram = std::unique_ptr<struct hdr_histogram, decltype(&hdr_close)>(
-          cHistogram, &hdr_close);
+  // Restores the previous handler unless another one was installed since,
+  // as the handler is unloaded with the library.
+  inline void uninstallSignalHandler() {
+    std::scoped_lock<std::mutex> lock(signalMutex);
+    struct sigaction current {};
+    if (ownsSignalHandler && sigaction(dumpSignal, nullptr, &current) == 0 &&
+        (current.sa_flags & SA_SIGINFO) &&
+        current.sa_sigaction == onDumpSignal) {
+      sigaction(dumpSignal, &previousAction, nullptr);
+      dumpSignal = 0;
     }
   }
 
-  latency_histogram(const latency_histogram &) = delete;
-  latency_histogram(latency_histogram &&) = delete;
+  inline static uint64_t getEnvNumber(const char *name) {
+    try {
+      auto value = ur_getenv(name);
+      return value ? std::stoull(*value) : 0;
+    } catch (...) {
+      logger::error("Invalid value of {}", name);
+      return 0;
+    }
+  }
 
-  inline ~latency_histogram() {
-    if (!trackLatency || !histogram) {
+  inline void startExporter() {
+    auto interval =
+        std::chrono::seconds(getEnvNumber("UR_LATENCY_DUMP_INTERVAL"));
+    auto signal = static_cast<int>(getEnvNumber("UR_LATENCY_DUMP_SIGNAL"));
+    if (signal && !installSignalHandler(signal)) {
+      logger::error("Failed to install the latency dump signal handler");
+      signal = 0;
+    }
+    if (!signal && interval.count() == 0) {
       return;
     }
 
-    if (hdr_min(histogram.get()) == std::numeric_limits<int64_t>::max()) {
-      logger::info("[{}] latency: no data", name);
+    // The signal handler only sets a flag, which is polled.
+    auto period = signal ? std::chrono::milliseconds(100)
+                         : std::chrono::milliseconds(interval);
+    exporter = std::thread([this, interval, period] {
+      auto nextDump = std::chrono::steady_clock::now() + interval;
+      std::unique_lock<std::mutex> lock(exporterMutex);
+      while (!exporterCv.wait_for(lock, period,
+                                  [this] { return exporterStopped; })) {
+        auto now = std::chrono::steady_clock::now();
+        bool due = interval.count() && now >= nextDump;
+        if (dumpRequested.exchange(false) || due) {
+          nextDump = now + interval;
+          lock.unlock();
+          print();
+          lock.lock();
+        }
+      }
+    });
+  }
+
+  inline void stopExporter() {
+    if (!exporter.joinable()) {
       return;
     }
+    uninstallSignalHandler();
+    {
+      std::scoped_lock<std::mutex> lock(exporterMutex);
+      exporterStopped = true;
+    }
+    exporterCv.notify_all();
+    exporter.join();
+  }
+
+  bool ownsSignalHandler = false;
+  std::thread exporter;
+  std::mutex exporterMutex;
+  std::condition_variable exporterCv;
+  bool exporterStopped = false;
+#else
+  // Not supported, as the exporter thread could not be joined while the
+  // library is unloaded.
+  inline void startExporter() {}
+  inline void stopExporter() {}
+#endif
+
+  std::mutex mutex;
+  std::unordered_set<latency_histogram *> live;
+  std::map<std::string, histogram_ptr> retired;
+  logger::Logger logger;
+};
+
+inline latency_printer &globalLatencyPrinter() {
+  static latency_printer printer;
+  return printer;
+}
 
-    printer.publishLatency(name, std::move(histogram));
+inline latency_histogram::latency_histogram(const char *name,
+                                            latency_printer &printer,
+                                            histogram_config config)
+    : name(name), config(config), histogram(nullptr, &hdr_close),
+      printer(printer) {
+  if (trackLatency) {
+    histogram = makeHistogram(config);
+    if (histogram) {
+      printer.registerHistogram(this);
+    }
   }
+}
 
-  inline void trackValue(int64_t value) {
-    hdr_record_value(histogram.get(), value);
+inline latency_histogram::~latency_histogram() {
+  if (!trackLatency || !histogram) {
+    return;
   }
 
-private:
-  const char *name;
-  histogram_ptr histogram;
-  latency_printer &printer;
-};
+  printer.retireHistogram(this);
+}
 
 class latency_tracker {
 public:
@@ -213,9 +437,9 @@ private:
 // To resolve __COUNTER__
 #define CONCAT(a, b) a##b
 
-// Each tracker has it's own thread-local histogram.
-// At program exit, all histograms for the same scope are
-// aggregated.
+// Each tracker has it's own thread-local histogram, registered with the
+// printer, which merges the histograms of all threads for the same scope
+// whenever they are read.
 #define TRACK_SCOPE_LATENCY_CNT(name, cnt)                                     \
   static thread_local latency_histogram CONCAT(histogram, cnt)(name);          \
   latency_tracker CONCAT(tracker, cnt)(CONCAT(histogram, cnt));
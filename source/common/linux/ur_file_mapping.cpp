@@ -0,0 +1,71 @@
+/*
+ *
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+ * Exceptions. See LICENSE.TXT
+ *
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ */
+#include <cerrno>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "logger/ur_logger.hpp"
+#include "ur_file_mapping.hpp"
+
+namespace ur {
+
+ur_result_t file_mapping_t::map(const ur_exp_file_region_t &region,
+                                size_t length) {
+  unmap();
+  if (length == 0) {
+    return UR_RESULT_ERROR_INVALID_SIZE;
+  }
+
+  struct stat st;
+  if (fstat(region.fd, &st) != 0) {
+    return UR_RESULT_ERROR_INVALID_VALUE;
+  }
+  // Pages past the end of the file can be mapped, but accessing them raises
+  // SIGBUS rather than returning an error.
+  auto fileSize = static_cast<uint64_t>(st.st_size);
+  if (region.offset > fileSize || length > fileSize - region.offset) {
+    return UR_RESULT_ERROR_INVALID_SIZE;
+  }
+
+  auto pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+  uint64_t mapOffset = region.offset / pageSize * pageSize;
+  size_t delta = static_cast<size_t>(region.offset - mapOffset);
+  void *mapped = mmap(nullptr, length + delta, PROT_READ, MAP_PRIVATE,
+                      region.fd, static_cast<off_t>(mapOffset));
+  if (mapped == MAP_FAILED) {
+    int err = errno;
+    logger::error("failed to map {} bytes at offset {} of fd {}: {}", length,
+                  region.offset, region.fd, err);
+    return err == ENOMEM ? UR_RESULT_ERROR_OUT_OF_HOST_MEMORY
+                         : UR_RESULT_ERROR_INVALID_VALUE;
+  }
+  // Sources are consumed front to back by the compiler or runtime.
+  posix_madvise(mapped, length + delta, POSIX_MADV_SEQUENTIAL);
+
+  base = mapped;
+  mappedLength = length + delta;
+  ptr = static_cast<const char *>(mapped) + delta;
+  this->length = length;
+  return UR_RESULT_SUCCESS;
+}
+
+void file_mapping_t::unmap() {
+  if (base) {
+    munmap(base, mappedLength);
+  }
+  base = nullptr;
+  mappedLength = 0;
+  ptr = nullptr;
+  length = 0;
+}
+
+} // namespace ur
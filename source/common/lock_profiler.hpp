@@ -0,0 +1,217 @@
+//===--------- lock_profiler.hpp - common ---------------------------------===//
+//
+// Copyright (C) 2025 Intel Corporation
+//
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#if defined(UR_ENABLE_LOCK_PROFILING)
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "logger/ur_logger.hpp"
+
+static inline bool profileLocks = []() {
+  try {
+    auto map = getenv_to_map("UR_LOG_LOCK_PROFILE");
+
+    if (!map.has_value()) {
+      return false;
+    }
+
+    auto it = map->find("level");
+    return it != map->end() &&
+           logger::str_to_level(it->second.front()) != logger::Level::QUIET;
+  } catch (...) {
+    return false;
+  }
+}();
+
+// Statistics of all mutexes constructed at the same site. Hold times are
+// only recorded for exclusive acquisitions.
+struct lock_site_stats {
+  std::atomic<uint64_t> acquisitions{0};
+  std::atomic<uint64_t> contended{0};
+  std::atomic<uint64_t> sharedAcquisitions{0};
+  std::atomic<uint64_t> sharedContended{0};
+  std::atomic<uint64_t> waitNs{0};
+  std::atomic<uint64_t> maxWaitNs{0};
+  std::atomic<uint64_t> holdNs{0};
+  std::atomic<uint64_t> maxHoldNs{0};
+};
+
+class lock_profiler {
+public:
+  lock_profiler()
+      : logger(logger::create_logger("lock_profile", true, false)) {}
+
+  lock_site_stats *getSite(const std::string &name) {
+    std::scoped_lock<std::mutex> lock(mutex);
+    auto &site = sites[name];
+    if (!site) {
+      site = std::make_unique<lock_site_stats>();
+    }
+    return site.get();
+  }
+
+  // Prints the sites with the longest total wait first.
+  void print() {
+    std::vector<std::pair<std::string, const lock_site_stats *>> sorted;
+    {
+      std::scoped_lock<std::mutex> lock(mutex);
+      for (auto &[name, site] : sites) {
+        sorted.emplace_back(name, site.get());
+      }
+    }
+    std::stable_sort(sorted.begin(), sorted.end(), [](auto &a, auto &b) {
+      return a.second->waitNs.load() > b.second->waitNs.load();
+    });
+
+    auto f = groupDigits<uint64_t>;
+    logger.log(logger::Level::INFO, "Lock profile:");
+    logger.log(logger::Level::INFO,
+               "site,acquisitions,contended,shared,shared contended,"
+               "wait,max wait,hold,max hold,unit");
+    for (auto &[name, site] : sorted) {
+      logger.log(logger::Level::INFO, "{},{},{},{},{},{},{},{},{},ns", name,
+                 f(site->acquisitions.load()), f(site->contended.load()),
+                 f(site->sharedAcquisitions.load()),
+                 f(site->sharedContended.load()), f(site->waitNs.load()),
+                 f(site->maxWaitNs.load()), f(site->holdNs.load()),
+                 f(site->maxHoldNs.load()));
+    }
+  }
+
+private:
+  std::mutex mutex;
+  std::map<std::string, std::unique_ptr<lock_site_stats>> sites;
+  logger::Logger logger;
+};
+
+// Prints the profile at teardown. The profiler itself is never destroyed, as
+// mutexes of objects released later during teardown still record into it.
+inline lock_profiler &globalLockProfiler() {
+  static auto *profiler = new lock_profiler();
+  static struct printer_t {
+    ~printer_t() { profiler->print(); }
+  } printer;
+  return *profiler;
+}
+
+// Profile of a single mutex, recording into the statistics of its site, which
+// is its name if it has one, or the location it is constructed at otherwise.
+class lock_site_profile {
+public:
+  lock_site_profile(const char *name, const char *file, int line) {
+    if (!profileLocks) {
+      return;
+    }
+    if (name) {
+      stats = globalLockProfiler().getSite(name);
+      return;
+    }
+    std::string site = file;
+    auto pos = site.rfind("source/");
+    if (pos != std::string::npos) {
+      site = site.substr(pos + sizeof("source/") - 1);
+    }
+    stats = globalLockProfiler().getSite(site + ":" + std::to_string(line));
+  }
+
+  template <typename TryLock, typename Lock>
+  void lock(TryLock &&tryLock, Lock &&lock) {
+    if (!stats) {
+      lock();
+      return;
+    }
+    acquire(std::forward<TryLock>(tryLock), std::forward<Lock>(lock),
+            stats->acquisitions, stats->contended);
+    holdBegin = clock::now();
+  }
+
+  template <typename TryLock, typename Lock>
+  void lockShared(TryLock &&tryLock, Lock &&lock) {
+    if (!stats) {
+      lock();
+      return;
+    }
+    acquire(std::forward<TryLock>(tryLock), std::forward<Lock>(lock),
+            stats->sharedAcquisitions, stats->sharedContended);
+  }
+
+  // Records an exclusive acquisition by try_lock.
+  void locked() {
+    if (stats) {
+      stats->acquisitions.fetch_add(1, std::memory_order_relaxed);
+      holdBegin = clock::now();
+    }
+  }
+
+  void lockedShared() {
+    if (stats) {
+      stats->sharedAcquisitions.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  // Must be called before the mutex is released.
+  void unlocking() {
+    if (stats) {
+      auto hold = elapsedNs(holdBegin);
+      stats->holdNs.fetch_add(hold, std::memory_order_relaxed);
+      updateMax(stats->maxHoldNs, hold);
+    }
+  }
+
+private:
+  using clock = std::chrono::steady_clock;
+
+  static uint64_t elapsedNs(clock::time_point begin) {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() -
+                                                             begin)
+            .count());
+  }
+
+  static void updateMax(std::atomic<uint64_t> &max, uint64_t value) {
+    auto current = max.load(std::memory_order_relaxed);
+    while (current < value &&
+           !max.compare_exchange_weak(current, value,
+                                      std::memory_order_relaxed)) {
+    }
+  }
+
+  template <typename TryLock, typename Lock>
+  void acquire(TryLock &&tryLock, Lock &&lock,
+               std::atomic<uint64_t> &acquisitions,
+               std::atomic<uint64_t> &contended) {
+    acquisitions.fetch_add(1, std::memory_order_relaxed);
+    if (tryLock()) {
+      return;
+    }
+    auto begin = clock::now();
+    lock();
+    auto wait = elapsedNs(begin);
+    contended.fetch_add(1, std::memory_order_relaxed);
+    stats->waitNs.fetch_add(wait, std::memory_order_relaxed);
+    updateMax(stats->maxWaitNs, wait);
+  }
+
+  lock_site_stats *stats = nullptr;
+  // Only accessed by the thread holding the mutex exclusively.
+  clock::time_point holdBegin;
+};
+
+#endif // UR_ENABLE_LOCK_PROFILING
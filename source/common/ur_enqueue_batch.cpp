@@ -0,0 +1,143 @@
+/*
+ *
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+ * Exceptions. See LICENSE.TXT
+ *
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ */
+
+#include "ur_enqueue_batch.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace ur::batch {
+
+enqueue_fns_t getEnqueueFns(const ur_dditable_t &dditable) {
+  return {dditable.Enqueue.pfnKernelLaunch,
+          dditable.Enqueue.pfnUSMMemcpy,
+          dditable.Enqueue.pfnUSMFill,
+          dditable.Enqueue.pfnEventsWait,
+          dditable.Enqueue.pfnEventsWaitWithBarrier,
+          dditable.Event.pfnRelease};
+}
+
+ur_result_t validate(uint32_t numCommands,
+                     const ur_exp_batch_command_t *pCommands) {
+  for (uint32_t i = 0; i < numCommands; i++) {
+    auto &command = pCommands[i];
+    if (command.type > UR_EXP_BATCH_COMMAND_TYPE_BARRIER) {
+      return UR_RESULT_ERROR_INVALID_ENUMERATION;
+    }
+    if (command.numDepsInBatch > 0 && !command.pDepsInBatch) {
+      return UR_RESULT_ERROR_INVALID_NULL_POINTER;
+    }
+    for (uint32_t d = 0; d < command.numDepsInBatch; d++) {
+      if (command.pDepsInBatch[d] >= i) {
+        return UR_RESULT_ERROR_INVALID_VALUE;
+      }
+    }
+  }
+  return UR_RESULT_SUCCESS;
+}
+
+ur_result_t enqueueByCommand(const enqueue_fns_t &fns, ur_queue_handle_t hQueue,
+                             uint32_t numCommands,
+                             const ur_exp_batch_command_t *pCommands,
+                             uint32_t numEventsInWaitList,
+                             const ur_event_handle_t *phEventWaitList,
+                             ur_event_handle_t *phEvent) {
+  auto result = validate(numCommands, pCommands);
+  if (result != UR_RESULT_SUCCESS) {
+    return result;
+  }
+
+  // Each barrier waits for the commands since the previous barrier,
+  // including it, and phEvent for the commands since the last barrier.
+  std::vector<bool> needsEvent(numCommands, false);
+  uint32_t segmentBegin = 0;
+  for (uint32_t i = 0; i < numCommands; i++) {
+    auto &command = pCommands[i];
+    for (uint32_t d = 0; d < command.numDepsInBatch; d++) {
+      needsEvent[command.pDepsInBatch[d]] = true;
+    }
+    if (command.type == UR_EXP_BATCH_COMMAND_TYPE_BARRIER) {
+      std::fill(needsEvent.begin() + segmentBegin, needsEvent.begin() + i,
+                true);
+      segmentBegin = i;
+    }
+  }
+  if (phEvent) {
+    std::fill(needsEvent.begin() + segmentBegin, needsEvent.end(), true);
+  }
+
+  std::vector<ur_event_handle_t> events(numCommands, nullptr);
+  std::vector<ur_event_handle_t> waitList;
+  segmentBegin = 0;
+  for (uint32_t i = 0; i < numCommands && result == UR_RESULT_SUCCESS; i++) {
+    auto &command = pCommands[i];
+
+    waitList.assign(phEventWaitList, phEventWaitList + numEventsInWaitList);
+    if (command.type == UR_EXP_BATCH_COMMAND_TYPE_BARRIER) {
+      waitList.insert(waitList.end(), events.begin() + segmentBegin,
+                      events.begin() + i);
+      segmentBegin = i;
+    }
+    for (uint32_t d = 0; d < command.numDepsInBatch; d++) {
+      waitList.push_back(events[command.pDepsInBatch[d]]);
+    }
+    auto numWaitEvents = static_cast<uint32_t>(waitList.size());
+    auto *phWaitEvents = waitList.empty() ? nullptr : waitList.data();
+    auto *phCommandEvent = needsEvent[i] ? &events[i] : nullptr;
+
+    switch (command.type) {
+    case UR_EXP_BATCH_COMMAND_TYPE_KERNEL_LAUNCH: {
+      auto &args = command.args.kernelLaunch;
+      result = fns.pfnKernelLaunch(hQueue, args.hKernel, args.workDim,
+                                   args.pGlobalWorkOffset, args.pGlobalWorkSize,
+                                   args.pLocalWorkSize, numWaitEvents,
+                                   phWaitEvents, phCommandEvent);
+      break;
+    }
+    case UR_EXP_BATCH_COMMAND_TYPE_USM_MEMCPY: {
+      auto &args = command.args.usmMemcpy;
+      result = fns.pfnUSMMemcpy(hQueue, false, args.pDst, args.pSrc, args.size,
+                                numWaitEvents, phWaitEvents, phCommandEvent);
+      break;
+    }
+    case UR_EXP_BATCH_COMMAND_TYPE_USM_FILL: {
+      auto &args = command.args.usmFill;
+      result = fns.pfnUSMFill(hQueue, args.pMem, args.patternSize,
+                              args.pPattern, args.size, numWaitEvents,
+                              phWaitEvents, phCommandEvent);
+      break;
+    }
+    default:
+      result = fns.pfnEventsWaitWithBarrier(hQueue, numWaitEvents,
+                                            phWaitEvents, phCommandEvent);
+      break;
+    }
+  }
+
+  if (result == UR_RESULT_SUCCESS && phEvent) {
+    if (numCommands - segmentBegin == 1) {
+      *phEvent = events[segmentBegin];
+      events[segmentBegin] = nullptr;
+    } else {
+      result = fns.pfnEventsWait(hQueue, numCommands - segmentBegin,
+                                 events.data() + segmentBegin, phEvent);
+    }
+  }
+
+  for (auto hEvent : events) {
+    if (hEvent) {
+      fns.pfnEventRelease(hEvent);
+    }
+  }
+  return result;
+}
+
+} // namespace ur::batch
@@ -0,0 +1,54 @@
+/*
+ *
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+ * Exceptions. See LICENSE.TXT
+ *
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ */
+
+#ifndef UR_ENQUEUE_BATCH_HPP
+#define UR_ENQUEUE_BATCH_HPP 1
+
+#include <ur_api.h>
+#include <ur_ddi.h>
+
+// Implementation of urEnqueueBatchExp on top of the regular enqueue entry
+// points, used by the loader for adapters that don't record batches natively
+// and by adapters that have no better way to record them.
+namespace ur::batch {
+
+// Entry points the commands of a batch are enqueued with.
+struct enqueue_fns_t {
+  ur_pfnEnqueueKernelLaunch_t pfnKernelLaunch;
+  ur_pfnEnqueueUSMMemcpy_t pfnUSMMemcpy;
+  ur_pfnEnqueueUSMFill_t pfnUSMFill;
+  ur_pfnEnqueueEventsWait_t pfnEventsWait;
+  ur_pfnEnqueueEventsWaitWithBarrier_t pfnEventsWaitWithBarrier;
+  ur_pfnEventRelease_t pfnEventRelease;
+};
+
+enqueue_fns_t getEnqueueFns(const ur_dditable_t &dditable);
+
+// Checks the command types, and that commands only depend on commands before
+// them in the batch.
+ur_result_t validate(uint32_t numCommands,
+                     const ur_exp_batch_command_t *pCommands);
+
+// Enqueues each command of the batch with its own call. Commands wait for the
+// events of the commands they depend on, barriers for the events of the
+// commands since the previous barrier, and only these commands are asked for
+// an event. phEvent is the event of the last command if the batch ends with
+// a barrier or a single command, or the event of an events wait otherwise.
+ur_result_t enqueueByCommand(const enqueue_fns_t &fns, ur_queue_handle_t hQueue,
+                             uint32_t numCommands,
+                             const ur_exp_batch_command_t *pCommands,
+                             uint32_t numEventsInWaitList,
+                             const ur_event_handle_t *phEventWaitList,
+                             ur_event_handle_t *phEvent);
+
+} // namespace ur::batch
+
+#endif // UR_ENQUEUE_BATCH_HPP
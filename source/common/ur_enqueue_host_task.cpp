@@ -0,0 +1,48 @@
+/*
+ *
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+ * Exceptions. See LICENSE.TXT
+ *
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ */
+
+#include "ur_enqueue_host_task.hpp"
+
+namespace ur::host_task {
+
+enqueue_fns_t getEnqueueFns(const ur_dditable_t &dditable) {
+  return {dditable.Enqueue.pfnEventsWaitWithBarrier, dditable.Event.pfnWait,
+          dditable.Event.pfnRelease};
+}
+
+ur_result_t enqueueAndWait(const enqueue_fns_t &fns, ur_queue_handle_t hQueue,
+                           ur_exp_host_task_function_t pfnHostTask,
+                           void *pUserData, uint32_t numEventsInWaitList,
+                           const ur_event_handle_t *phEventWaitList,
+                           ur_event_handle_t *phEvent) {
+  // Without a way to signal an event from the host, later commands can only
+  // be ordered after the host task by not enqueuing them before it is done.
+  ur_event_handle_t hEvent = nullptr;
+  auto result = fns.pfnEventsWaitWithBarrier(hQueue, numEventsInWaitList,
+                                             phEventWaitList, &hEvent);
+  if (result != UR_RESULT_SUCCESS) {
+    return result;
+  }
+
+  result = fns.pfnEventWait(1, &hEvent);
+  if (result == UR_RESULT_SUCCESS) {
+    pfnHostTask(pUserData);
+  }
+
+  if (result == UR_RESULT_SUCCESS && phEvent) {
+    *phEvent = hEvent;
+  } else {
+    fns.pfnEventRelease(hEvent);
+  }
+  return result;
+}
+
+} // namespace ur::host_task
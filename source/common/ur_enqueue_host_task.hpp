@@ -0,0 +1,42 @@
+/*
+ *
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+ * Exceptions. See LICENSE.TXT
+ *
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ */
+
+#ifndef UR_ENQUEUE_HOST_TASK_HPP
+#define UR_ENQUEUE_HOST_TASK_HPP 1
+
+#include <ur_api.h>
+#include <ur_ddi.h>
+
+// Implementation of urEnqueueHostTaskExp on top of the regular entry points,
+// used by the loader for adapters that can't run host tasks asynchronously.
+namespace ur::host_task {
+
+// Entry points the host task is ordered with.
+struct enqueue_fns_t {
+  ur_pfnEnqueueEventsWaitWithBarrier_t pfnEventsWaitWithBarrier;
+  ur_pfnEventWait_t pfnEventWait;
+  ur_pfnEventRelease_t pfnEventRelease;
+};
+
+enqueue_fns_t getEnqueueFns(const ur_dditable_t &dditable);
+
+// Enqueues a barrier for the wait list and the commands enqueued before it,
+// waits for it and calls pfnHostTask on the calling thread. phEvent is the
+// event of the barrier, which is complete by the time this returns.
+ur_result_t enqueueAndWait(const enqueue_fns_t &fns, ur_queue_handle_t hQueue,
+                           ur_exp_host_task_function_t pfnHostTask,
+                           void *pUserData, uint32_t numEventsInWaitList,
+                           const ur_event_handle_t *phEventWaitList,
+                           ur_event_handle_t *phEvent);
+
+} // namespace ur::host_task
+
+#endif // UR_ENQUEUE_HOST_TASK_HPP
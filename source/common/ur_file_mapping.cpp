@@ -0,0 +1,47 @@
+/*
+ *
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+ * Exceptions. See LICENSE.TXT
+ *
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ */
+
+#include "ur_file_mapping.hpp"
+#include "ur_util.hpp"
+
+namespace ur {
+
+ur_result_t mapProgramFileSource(const ur_program_properties_t *pProperties,
+                                 uint32_t count, const size_t *pLengths,
+                                 std::vector<file_mapping_t> &mappings) {
+  mappings.clear();
+  if (!pProperties) {
+    return UR_RESULT_SUCCESS;
+  }
+  const auto *pFileSource =
+      find_stype_node<ur_exp_program_file_source_t>(pProperties->pNext);
+  if (!pFileSource) {
+    return UR_RESULT_SUCCESS;
+  }
+  if (pFileSource->count != count) {
+    return UR_RESULT_ERROR_INVALID_SIZE;
+  }
+  if (!pFileSource->pRegions) {
+    return UR_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+
+  std::vector<file_mapping_t> newMappings(count);
+  for (uint32_t i = 0; i < count; i++) {
+    auto result = newMappings[i].map(pFileSource->pRegions[i], pLengths[i]);
+    if (result != UR_RESULT_SUCCESS) {
+      return result;
+    }
+  }
+  mappings = std::move(newMappings);
+  return UR_RESULT_SUCCESS;
+}
+
+} // namespace ur
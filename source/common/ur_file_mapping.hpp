@@ -0,0 +1,73 @@
+/*
+ *
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+ * Exceptions. See LICENSE.TXT
+ *
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ */
+
+#ifndef UR_FILE_MAPPING_HPP
+#define UR_FILE_MAPPING_HPP 1
+
+#include <ur_api.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace ur {
+
+// Read-only mapping of a region of a file, unmapped when destroyed. Pages are
+// only read in as the region is accessed, and are shared with the page cache
+// rather than copied into the process' heap.
+class file_mapping_t {
+public:
+  file_mapping_t() = default;
+  ~file_mapping_t() { unmap(); }
+
+  file_mapping_t(file_mapping_t &&other) noexcept { *this = std::move(other); }
+  file_mapping_t &operator=(file_mapping_t &&other) noexcept {
+    if (this != &other) {
+      unmap();
+      std::swap(base, other.base);
+      std::swap(mappedLength, other.mappedLength);
+      std::swap(ptr, other.ptr);
+      std::swap(length, other.length);
+    }
+    return *this;
+  }
+
+  file_mapping_t(const file_mapping_t &) = delete;
+  file_mapping_t &operator=(const file_mapping_t &) = delete;
+
+  // Maps `length` bytes of `region`, which must lie within the file.
+  ur_result_t map(const ur_exp_file_region_t &region, size_t length);
+
+  const void *data() const { return ptr; }
+  size_t size() const { return length; }
+
+private:
+  void unmap();
+
+  // The mapping starts at the allocation granularity boundary below the
+  // region's offset.
+  void *base = nullptr;
+  size_t mappedLength = 0;
+  const void *ptr = nullptr;
+  size_t length = 0;
+};
+
+// Maps the sources given by a ur_exp_program_file_source_t chained to
+// `pProperties`, of which there must be `count`, with the lengths in
+// `pLengths`. Leaves `mappings` empty if there is no such structure.
+ur_result_t mapProgramFileSource(const ur_program_properties_t *pProperties,
+                                 uint32_t count, const size_t *pLengths,
+                                 std::vector<file_mapping_t> &mappings);
+
+} // namespace ur
+
+#endif // UR_FILE_MAPPING_HPP
@@ -0,0 +1,403 @@
+/*
+ *
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+ * Exceptions. See LICENSE.TXT
+ *
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ */
+
+#include "ur_host_dma.hpp"
+#include "ur_util.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define UR_DMA_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define UR_DMA_TARGET(Isa)
+#else
+#define UR_DMA_TARGET(Isa) __attribute__((target(Isa)))
+#endif
+#endif
+
+namespace ur::dma {
+
+namespace {
+
+// Operations are only split when every task gets at least this many bytes.
+constexpr size_t MinBytesPerTask = 1 << 20;
+constexpr size_t MaxTasks = 256;
+// Fills this large would evict the whole cache, so they bypass it.
+constexpr size_t StreamingThreshold = 16 << 20;
+// Vector fills work on blocks this large, so patterns have to divide it.
+constexpr size_t BlockSize = 64;
+
+isa_t detectIsa() {
+#ifdef UR_DMA_X86
+#ifdef _MSC_VER
+  int Info[4];
+  __cpuid(Info, 0);
+  const int MaxLeaf = Info[0];
+  __cpuid(Info, 1);
+  const bool OsAvx = (Info[2] & (1 << 27)) && (Info[2] & (1 << 28));
+  if (MaxLeaf >= 7 && OsAvx) {
+    const unsigned long long Xcr0 = _xgetbv(0);
+    __cpuidex(Info, 7, 0);
+    if ((Info[1] & (1 << 16)) && (Xcr0 & 0xe6) == 0xe6) {
+      return isa_t::avx512;
+    }
+    if ((Info[1] & (1 << 5)) && (Xcr0 & 0x6) == 0x6) {
+      return isa_t::avx2;
+    }
+  }
+#else
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return isa_t::avx512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return isa_t::avx2;
+  }
+#endif
+  return isa_t::sse2;
+#else
+  return isa_t::generic;
+#endif
+}
+
+isa_t selectIsa() {
+  isa_t Isa = detectIsa();
+  if (auto Env = ur_getenv("UR_HOST_DMA_ISA")) {
+    for (isa_t Limit :
+         {isa_t::generic, isa_t::sse2, isa_t::avx2, isa_t::avx512}) {
+      if (*Env == getIsaName(Limit)) {
+        Isa = std::min(Isa, Limit);
+      }
+    }
+  }
+  return Isa;
+}
+
+// The vector fills store a 64-byte window of Block, which holds the pattern
+// repeated twice over, so that the stores can start at any phase of the
+// pattern. This writes the bytes up to the first 64-byte boundary, advances
+// Dst and Size past them and returns the window to store from there.
+inline const char *fillHead(char *&Dst, const char *Block, size_t &Size) {
+  const size_t Head = std::min(
+      Size, (BlockSize - reinterpret_cast<uintptr_t>(Dst) % BlockSize) %
+                BlockSize);
+  std::memcpy(Dst, Block, Head);
+  Dst += Head;
+  Size -= Head;
+  return Block + Head % BlockSize;
+}
+
+void fillGeneric(char *Dst, const char *Block, size_t Size, bool) {
+  const char *Window = fillHead(Dst, Block, Size);
+  const size_t Body = Size - Size % BlockSize;
+  for (size_t I = 0; I < Body; I += BlockSize) {
+    std::memcpy(Dst + I, Window, BlockSize);
+  }
+  std::memcpy(Dst + Body, Window, Size - Body);
+}
+
+#ifdef UR_DMA_X86
+UR_DMA_TARGET("sse2")
+void fillSse2(char *Dst, const char *Block, size_t Size, bool Stream) {
+  const char *Window = fillHead(Dst, Block, Size);
+  const size_t Body = Size - Size % BlockSize;
+  __m128i V[4];
+  for (int J = 0; J < 4; J++) {
+    V[J] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Window) + J);
+  }
+  if (Stream) {
+    for (size_t I = 0; I < Body; I += BlockSize) {
+      auto *Out = reinterpret_cast<__m128i *>(Dst + I);
+      for (int J = 0; J < 4; J++) {
+        _mm_stream_si128(Out + J, V[J]);
+      }
+    }
+    _mm_sfence();
+  } else {
+    for (size_t I = 0; I < Body; I += BlockSize) {
+      auto *Out = reinterpret_cast<__m128i *>(Dst + I);
+      for (int J = 0; J < 4; J++) {
+        _mm_store_si128(Out + J, V[J]);
+      }
+    }
+  }
+  std::memcpy(Dst + Body, Window, Size - Body);
+}
+
+UR_DMA_TARGET("avx2")
+void fillAvx2(char *Dst, const char *Block, size_t Size, bool Stream) {
+  const char *Window = fillHead(Dst, Block, Size);
+  const size_t Body = Size - Size % BlockSize;
+  const __m256i V0 =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i *>(Window));
+  const __m256i V1 =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i *>(Window) + 1);
+  for (size_t I = 0; I < Body; I += BlockSize) {
+    auto *Out = reinterpret_cast<__m256i *>(Dst + I);
+    if (Stream) {
+      _mm256_stream_si256(Out, V0);
+      _mm256_stream_si256(Out + 1, V1);
+    } else {
+      _mm256_store_si256(Out, V0);
+      _mm256_store_si256(Out + 1, V1);
+    }
+  }
+  if (Stream) {
+    _mm_sfence();
+  }
+  std::memcpy(Dst + Body, Window, Size - Body);
+}
+
+UR_DMA_TARGET("avx512f")
+void fillAvx512(char *Dst, const char *Block, size_t Size, bool Stream) {
+  const char *Window = fillHead(Dst, Block, Size);
+  const size_t Body = Size - Size % BlockSize;
+  const __m512i V = _mm512_loadu_si512(Window);
+  for (size_t I = 0; I < Body; I += BlockSize) {
+    if (Stream) {
+      _mm512_stream_si512(reinterpret_cast<__m512i *>(Dst + I), V);
+    } else {
+      _mm512_store_si512(Dst + I, V);
+    }
+  }
+  if (Stream) {
+    _mm_sfence();
+  }
+  std::memcpy(Dst + Body, Window, Size - Body);
+}
+#endif
+
+// Fills memory with one pattern, using the vector fills when the pattern
+// divides a block and repeated copies of the pattern otherwise.
+class filler {
+public:
+  filler(isa_t Isa, const void *Pattern, size_t PatternSize)
+      : Pattern(static_cast<const char *>(Pattern)), PatternSize(PatternSize) {
+    assert(PatternSize != 0);
+    if (BlockSize % PatternSize != 0) {
+      return;
+    }
+    for (size_t I = 0; I < sizeof(Block); I += PatternSize) {
+      std::memcpy(Block + I, Pattern, PatternSize);
+    }
+    switch (Isa) {
+#ifdef UR_DMA_X86
+    case isa_t::avx512:
+      Fill = fillAvx512;
+      break;
+    case isa_t::avx2:
+      Fill = fillAvx2;
+      break;
+    case isa_t::sse2:
+      Fill = fillSse2;
+      break;
+#endif
+    default:
+      Fill = fillGeneric;
+      break;
+    }
+  }
+
+  // Dst must be at the start of a pattern.
+  void operator()(char *Dst, size_t Size, bool Stream) const {
+    if (Fill) {
+      Fill(Dst, Block, Size, Stream);
+      return;
+    }
+    // Copy the pattern once, then keep doubling the filled prefix.
+    const size_t First = std::min(Size, PatternSize);
+    std::memcpy(Dst, Pattern, First);
+    for (size_t Filled = First; Filled < Size;) {
+      const size_t Step = std::min(Filled, Size - Filled);
+      std::memcpy(Dst + Filled, Dst, Step);
+      Filled += Step;
+    }
+  }
+
+  // Multiple of the pattern size at which a fill can be split.
+  size_t granularity() const { return PatternSize * BlockSize; }
+
+private:
+  const char *Pattern;
+  size_t PatternSize;
+  alignas(BlockSize) char Block[2 * BlockSize];
+  void (*Fill)(char *, const char *, size_t, bool) = nullptr;
+};
+
+// Calls Func(Begin, End) for ranges covering [0, Count), each starting at a
+// multiple of Granularity, in parallel when there is enough work.
+template <class Fn>
+void parallelFor(size_t Count, size_t Granularity, size_t BytesPerItem,
+                 const executor_t &Executor, Fn &&Func) {
+  const size_t MinItems = std::max(
+      Granularity, MinBytesPerTask / std::max<size_t>(BytesPerItem, 1));
+  size_t NumTasks = std::min(Count / MinItems, MaxTasks);
+  if (!Executor || NumTasks < 2) {
+    Func(size_t{0}, Count);
+    return;
+  }
+  size_t Chunk = (Count + NumTasks - 1) / NumTasks;
+  Chunk = (Chunk + Granularity - 1) / Granularity * Granularity;
+  NumTasks = (Count + Chunk - 1) / Chunk;
+  Executor(NumTasks, [&](size_t Task) {
+    const size_t Begin = Task * Chunk;
+    Func(Begin, std::min(Count, Begin + Chunk));
+  });
+}
+
+} // namespace
+
+isa_t getIsa() {
+  static const isa_t Isa = selectIsa();
+  return Isa;
+}
+
+const char *getIsaName(isa_t Isa) {
+  switch (Isa) {
+  case isa_t::sse2:
+    return "sse2";
+  case isa_t::avx2:
+    return "avx2";
+  case isa_t::avx512:
+    return "avx512";
+  default:
+    return "generic";
+  }
+}
+
+executor_t makeThreadExecutor(size_t MaxThreads) {
+  if (MaxThreads == 0) {
+    MaxThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  return [MaxThreads](size_t NumTasks, const task_t &Task) {
+    std::atomic<size_t> Next{0};
+    auto Worker = [&]() {
+      for (size_t I = Next++; I < NumTasks; I = Next++) {
+        Task(I);
+      }
+    };
+    std::vector<std::thread> Threads;
+    try {
+      for (size_t T = 1; T < std::min(MaxThreads, NumTasks); T++) {
+        Threads.emplace_back(Worker);
+      }
+    } catch (const std::system_error &) {
+      // Run the remaining tasks on the threads that could be created.
+    }
+    Worker();
+    for (auto &Thread : Threads) {
+      Thread.join();
+    }
+  };
+}
+
+void set(void *Dst, unsigned char Value, size_t Size,
+         const executor_t &Executor) {
+  char *Out = static_cast<char *>(Dst);
+  parallelFor(Size, BlockSize, 1, Executor, [=](size_t Begin, size_t End) {
+    std::memset(Out + Begin, Value, End - Begin);
+  });
+}
+
+void fill(void *Dst, const void *Pattern, size_t PatternSize, size_t Size,
+          const executor_t &Executor) {
+  assert(Size % PatternSize == 0);
+  if (PatternSize == 1) {
+    set(Dst, *static_cast<const unsigned char *>(Pattern), Size, Executor);
+    return;
+  }
+  const filler Fill(getIsa(), Pattern, PatternSize);
+  const bool Stream = Size >= StreamingThreshold;
+  char *Out = static_cast<char *>(Dst);
+  parallelFor(Size, Fill.granularity(), 1, Executor,
+              [&](size_t Begin, size_t End) {
+                Fill(Out + Begin, End - Begin, Stream);
+              });
+}
+
+void fill2D(void *Dst, size_t Pitch, const void *Pattern, size_t PatternSize,
+            size_t Width, size_t Height, const executor_t &Executor) {
+  assert(Width % PatternSize == 0);
+  if (Width == Pitch) {
+    fill(Dst, Pattern, PatternSize, Width * Height, Executor);
+    return;
+  }
+  const filler Fill(getIsa(), Pattern, PatternSize);
+  const bool Stream = Width * Height >= StreamingThreshold;
+  char *Out = static_cast<char *>(Dst);
+  parallelFor(Height, 1, Width, Executor, [&](size_t Begin, size_t End) {
+    for (size_t Row = Begin; Row < End; Row++) {
+      Fill(Out + Row * Pitch, Width, Stream);
+    }
+  });
+}
+
+void copy(void *Dst, const void *Src, size_t Size,
+          const executor_t &Executor) {
+  char *Out = static_cast<char *>(Dst);
+  const char *In = static_cast<const char *>(Src);
+  parallelFor(Size, BlockSize, 1, Executor, [=](size_t Begin, size_t End) {
+    std::memcpy(Out + Begin, In + Begin, End - Begin);
+  });
+}
+
+void copy2D(void *Dst, size_t DstPitch, const void *Src, size_t SrcPitch,
+            size_t Width, size_t Height, const executor_t &Executor) {
+  copy3D(Dst, DstPitch, DstPitch * Height, Src, SrcPitch, SrcPitch * Height,
+         Width, Height, 1, Executor);
+}
+
+void copy3D(void *Dst, size_t DstRowPitch, size_t DstSlicePitch,
+            const void *Src, size_t SrcRowPitch, size_t SrcSlicePitch,
+            size_t Width, size_t Height, size_t Depth,
+            const executor_t &Executor) {
+  if (Width == DstRowPitch && Width == SrcRowPitch) {
+    if (Width * Height == DstSlicePitch && Width * Height == SrcSlicePitch) {
+      copy(Dst, Src, Width * Height * Depth, Executor);
+      return;
+    }
+    // Each slice is contiguous, copy them as single rows.
+    Width *= Height;
+    DstRowPitch = DstSlicePitch;
+    SrcRowPitch = SrcSlicePitch;
+    Height = 1;
+  }
+  char *Out = static_cast<char *>(Dst);
+  const char *In = static_cast<const char *>(Src);
+  parallelFor(Height * Depth, 1, Width, Executor,
+              [&](size_t Begin, size_t End) {
+                for (size_t Row = Begin; Row < End; Row++) {
+                  const size_t Z = Row / Height;
+                  const size_t Y = Row % Height;
+                  std::memcpy(Out + Z * DstSlicePitch + Y * DstRowPitch,
+                              In + Z * SrcSlicePitch + Y * SrcRowPitch, Width);
+                }
+              });
+}
+
+namespace detail {
+void fill(isa_t Isa, void *Dst, const void *Pattern, size_t PatternSize,
+          size_t Size) {
+  const filler Fill(Isa, Pattern, PatternSize);
+  Fill(static_cast<char *>(Dst), Size, Size >= StreamingThreshold);
+}
+} // namespace detail
+
+} // namespace ur::dma
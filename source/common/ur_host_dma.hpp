@@ -0,0 +1,80 @@
+/*
+ *
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+ * Exceptions. See LICENSE.TXT
+ *
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ */
+
+#ifndef UR_HOST_DMA_HPP
+#define UR_HOST_DMA_HPP 1
+
+#include <cstddef>
+#include <functional>
+
+// Host memory fill and copy primitives shared by the adapters and layers that
+// operate on host memory directly. Pattern fills use the widest vector
+// instructions supported by the CPU, selected at runtime, and operations
+// larger than a few megabytes are split across the supplied executor.
+namespace ur::dma {
+
+enum class isa_t { generic, sse2, avx2, avx512 };
+
+// Returns the instruction set used for pattern fills. It is the best one
+// supported by the CPU, unless lowered with UR_HOST_DMA_ISA=generic|sse2|avx2.
+isa_t getIsa();
+const char *getIsaName(isa_t Isa);
+
+// An executor runs Task(0) ... Task(NumTasks - 1), possibly concurrently, and
+// returns once all of them have finished. An empty executor runs everything on
+// the calling thread.
+using task_t = std::function<void(size_t)>;
+using executor_t = std::function<void(size_t NumTasks, const task_t &Task)>;
+
+// Executor that runs the tasks on up to MaxThreads threads created for the
+// duration of each call, including the calling thread. Zero means the number
+// of hardware threads.
+executor_t makeThreadExecutor(size_t MaxThreads = 0);
+
+// Sets Size bytes at Dst to Value.
+void set(void *Dst, unsigned char Value, size_t Size,
+         const executor_t &Executor = {});
+
+// Fills Size bytes at Dst with copies of the PatternSize bytes at Pattern.
+// Size must be a multiple of PatternSize.
+void fill(void *Dst, const void *Pattern, size_t PatternSize, size_t Size,
+          const executor_t &Executor = {});
+
+// Fills Height rows of Width bytes, Pitch bytes apart. Width must be a
+// multiple of PatternSize; each row starts with a full pattern.
+void fill2D(void *Dst, size_t Pitch, const void *Pattern, size_t PatternSize,
+            size_t Width, size_t Height, const executor_t &Executor = {});
+
+// Copies Size bytes. The ranges must not overlap.
+void copy(void *Dst, const void *Src, size_t Size,
+          const executor_t &Executor = {});
+
+// Copies Height rows of Width bytes. Rows are DstPitch and SrcPitch bytes
+// apart in the destination and source respectively.
+void copy2D(void *Dst, size_t DstPitch, const void *Src, size_t SrcPitch,
+            size_t Width, size_t Height, const executor_t &Executor = {});
+
+// Copies Depth slices of Height rows of Width bytes.
+void copy3D(void *Dst, size_t DstRowPitch, size_t DstSlicePitch,
+            const void *Src, size_t SrcRowPitch, size_t SrcSlicePitch,
+            size_t Width, size_t Height, size_t Depth,
+            const executor_t &Executor = {});
+
+namespace detail {
+// Single-threaded fill with a specific instruction set, for testing and
+// benchmarking. Isa must be supported by the CPU.
+void fill(isa_t Isa, void *Dst, const void *Pattern, size_t PatternSize,
+          size_t Size);
+} // namespace detail
+
+} // namespace ur::dma
+
+#endif // UR_HOST_DMA_HPP
@@ -24,8 +24,10 @@
 #include <umf/pools/pool_disjoint.h>
 #include <umf/pools/pool_proxy.h>
 
+#include <array>
 #include <functional>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace usm {
@@ -58,6 +60,12 @@ struct pool_descriptor {
   ur_usm_type_t type;
   bool deviceReadOnly;
 
+  // Native handle of hDevice, resolved once by create(). It is resolved on
+  // demand for descriptors built elsewhere.
+  ur_native_handle_t hNativeDevice = 0;
+
+  ur_native_handle_t getNativeDevice() const;
+
   bool operator==(const pool_descriptor &other) const;
   friend std::ostream &operator<<(std::ostream &os,
                                   const pool_descriptor &desc);
@@ -164,12 +172,24 @@ isSharedAllocationReadOnlyOnDevice(const pool_descriptor &desc) {
   return desc.type == UR_USM_TYPE_SHARED && desc.deviceReadOnly;
 }
 
-inline bool pool_descriptor::operator==(const pool_descriptor &other) const {
+inline ur_native_handle_t pool_descriptor::getNativeDevice() const {
   static usm::detail::ddiTables ddi;
 
+  if (!hDevice || hNativeDevice) {
+    return hNativeDevice;
+  }
+
+  ur_native_handle_t native = 0;
+  auto ret = ddi.deviceDdiTable.pfnGetNativeHandle(hDevice, &native);
+  if (ret != UR_RESULT_SUCCESS) {
+    throw ret;
+  }
+  return native;
+}
+
+inline bool pool_descriptor::operator==(const pool_descriptor &other) const {
   const pool_descriptor &lhs = *this;
   const pool_descriptor &rhs = other;
-  ur_native_handle_t lhsNative = 0, rhsNative = 0;
 
   // We want to share a memory pool for sub-devices and sub-sub devices.
   // Sub-devices and sub-sub-devices might be represented by different
@@ -177,21 +197,8 @@ inline bool pool_descriptor::operator==(const pool_descriptor &other) const {
   // by UMF provider). Ref:
   // https://github.com/intel/llvm/commit/86511c5dc84b5781dcfd828caadcb5cac157eae1
   // TODO: is this L0 specific?
-  if (lhs.hDevice) {
-    auto ret = ddi.deviceDdiTable.pfnGetNativeHandle(lhs.hDevice, &lhsNative);
-    if (ret != UR_RESULT_SUCCESS) {
-      throw ret;
-    }
-  }
-
-  if (rhs.hDevice) {
-    auto ret = ddi.deviceDdiTable.pfnGetNativeHandle(rhs.hDevice, &rhsNative);
-    if (ret != UR_RESULT_SUCCESS) {
-      throw ret;
-    }
-  }
-
-  return lhsNative == rhsNative && lhs.type == rhs.type &&
+  return lhs.getNativeDevice() == rhs.getNativeDevice() &&
+         lhs.type == rhs.type &&
          (isSharedAllocationReadOnlyOnDevice(lhs) ==
           isSharedAllocationReadOnlyOnDevice(rhs)) &&
          lhs.poolHandle == rhs.poolHandle;
@@ -213,6 +220,8 @@ pool_descriptor::create(ur_usm_pool_handle_t poolHandle,
     return {ret, {}};
   }
 
+  static usm::detail::ddiTables ddi;
+
   std::vector<pool_descriptor> descriptors;
   pool_descriptor &desc = descriptors.emplace_back();
   desc.poolHandle = poolHandle;
@@ -220,12 +229,19 @@ pool_descriptor::create(ur_usm_pool_handle_t poolHandle,
   desc.type = UR_USM_TYPE_HOST;
 
   for (auto &device : devices) {
+    ur_native_handle_t native = 0;
+    ret = ddi.deviceDdiTable.pfnGetNativeHandle(device, &native);
+    if (ret != UR_RESULT_SUCCESS) {
+      return {ret, {}};
+    }
+
     {
       pool_descriptor &desc = descriptors.emplace_back();
       desc.poolHandle = poolHandle;
       desc.hContext = hContext;
       desc.hDevice = device;
       desc.type = UR_USM_TYPE_DEVICE;
+      desc.hNativeDevice = native;
     }
     {
       pool_descriptor &desc = descriptors.emplace_back();
@@ -234,6 +250,7 @@ pool_descriptor::create(ur_usm_pool_handle_t poolHandle,
       desc.type = UR_USM_TYPE_SHARED;
       desc.hDevice = device;
       desc.deviceReadOnly = false;
+      desc.hNativeDevice = native;
     }
     {
       pool_descriptor &desc = descriptors.emplace_back();
@@ -242,6 +259,7 @@ pool_descriptor::create(ur_usm_pool_handle_t poolHandle,
       desc.type = UR_USM_TYPE_SHARED;
       desc.hDevice = device;
       desc.deviceReadOnly = true;
+      desc.hNativeDevice = native;
     }
   }
 
@@ -254,6 +272,42 @@ private:
 
   desc_to_pool_map_t descToPoolMap;
 
+  // Pools of a device (or of no device, for host pools) indexed by USM type
+  // and by whether shared allocations are read-only on the device.
+  using pool_row_t = std::array<umf_memory_pool_handle_t, 4 * 2>;
+
+  struct device_key_hash {
+    size_t operator()(
+        const std::pair<ur_usm_pool_handle_t, ur_device_handle_t> &key) const {
+      return combine_hashes(0, key.first, key.second);
+    }
+  };
+
+  // Flat lookup filled by addPool, so that getPool resolves the pool of a
+  // descriptor without resolving native device handles. Sub-devices sharing
+  // a native handle with a device already added refer to the same pools.
+  std::unordered_map<std::pair<ur_usm_pool_handle_t, ur_device_handle_t>,
+                     size_t, device_key_hash>
+      deviceIndex;
+  std::vector<pool_row_t> pools;
+
+  static size_t poolIndex(const D &desc) {
+    return static_cast<size_t>(desc.type) * 2 +
+           isSharedAllocationReadOnlyOnDevice(desc);
+  }
+
+  void addToLookup(const D &desc, umf_memory_pool_handle_t hPool) {
+    if (static_cast<size_t>(desc.type) >= pool_row_t().size() / 2) {
+      return;
+    }
+    auto [it, inserted] =
+        deviceIndex.try_emplace({desc.poolHandle, desc.hDevice}, pools.size());
+    if (inserted) {
+      pools.emplace_back().fill(nullptr);
+    }
+    pools[it->second][poolIndex(desc)] = hPool;
+  }
+
 public:
   static std::pair<ur_result_t, pool_manager>
   create(desc_to_pool_map_t &&descToHandleMap = {}) {
@@ -270,24 +324,43 @@ public:
   }
 
   ur_result_t addPool(const D &desc,
-                      umf::pool_unique_handle_t &&hPool) noexcept {
-    if (!descToPoolMap.try_emplace(desc, std::move(hPool)).second) {
+                      umf::pool_unique_handle_t &&hPool) noexcept try {
+    auto [it, inserted] = descToPoolMap.try_emplace(desc, std::move(hPool));
+    // A descriptor equal to an existing one still gets its device handle
+    // added to the lookup.
+    addToLookup(desc, it->second.get());
+    if (!inserted) {
       logger::error("Pool for pool descriptor: {}, already exists", desc);
       return UR_RESULT_ERROR_INVALID_ARGUMENT;
     }
 
     return UR_RESULT_SUCCESS;
+  } catch (...) {
+    return exceptionToResult(std::current_exception());
   }
 
   std::optional<umf_memory_pool_handle_t> getPool(const D &desc) noexcept {
-    auto it = descToPoolMap.find(desc);
-    if (it == descToPoolMap.end()) {
-      logger::error("Pool descriptor doesn't match any existing pool: {}",
-                    desc);
-      return std::nullopt;
+    if (static_cast<size_t>(desc.type) < pool_row_t().size() / 2) {
+      auto it = deviceIndex.find({desc.poolHandle, desc.hDevice});
+      if (it != deviceIndex.end()) {
+        if (auto hPool = pools[it->second][poolIndex(desc)]) {
+          return hPool;
+        }
+      }
+    }
+
+    // Devices the pools were not added for, e.g. sub-devices created later,
+    // are matched by their native handle.
+    try {
+      auto it = descToPoolMap.find(desc);
+      if (it != descToPoolMap.end()) {
+        return it->second.get();
+      }
+    } catch (...) {
     }
 
-    return it->second.get();
+    logger::error("Pool descriptor doesn't match any existing pool: {}", desc);
+    return std::nullopt;
   }
 };
 
@@ -319,17 +392,7 @@ namespace std {
 /// @brief hash specialization for usm::pool_descriptor
 template <> struct hash<usm::pool_descriptor> {
   inline size_t operator()(const usm::pool_descriptor &desc) const {
-    static usm::detail::ddiTables ddi;
-
-    ur_native_handle_t native = 0;
-    if (desc.hDevice) {
-      auto ret = ddi.deviceDdiTable.pfnGetNativeHandle(desc.hDevice, &native);
-      if (ret != UR_RESULT_SUCCESS) {
-        throw ret;
-      }
-    }
-
-    return combine_hashes(0, desc.type, native,
+    return combine_hashes(0, desc.type, desc.getNativeDevice(),
                           isSharedAllocationReadOnlyOnDevice(desc),
                           desc.poolHandle);
   }
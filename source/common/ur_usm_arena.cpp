@@ -0,0 +1,178 @@
+/*
+ *
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+ * Exceptions. See LICENSE.TXT
+ *
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ */
+
+#include "ur_usm_arena.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+namespace ur::usm_arena {
+
+arena_t::arena_t(const arena_fns_t &fns, ur_context_handle_t hContext,
+                 ur_device_handle_t hDevice, bool inOrder, size_t chunkSize)
+    : fns(fns), hContext(hContext), hDevice(hDevice), inOrder(inOrder),
+      chunkSize(chunkSize) {}
+
+arena_t::~arena_t() {
+  for (auto &chunk : chunks) {
+    if (!chunk.pendingFrees.empty()) {
+      fns.pfnEventWait(static_cast<uint32_t>(chunk.pendingFrees.size()),
+                       chunk.pendingFrees.data());
+    }
+    releasePendingFrees(chunk);
+    fns.pfnFree(hContext, chunk.base);
+  }
+}
+
+void arena_t::releasePendingFrees(chunk_t &chunk) {
+  for (auto hEvent : chunk.pendingFrees) {
+    fns.pfnEventRelease(hEvent);
+  }
+  chunk.pendingFrees.clear();
+}
+
+bool arena_t::tryReclaim(chunk_t &chunk) {
+  if (!chunk.live.empty()) {
+    return false;
+  }
+  for (auto hEvent : chunk.pendingFrees) {
+    ur_event_status_t status = UR_EVENT_STATUS_QUEUED;
+    auto result =
+        fns.pfnEventGetInfo(hEvent, UR_EVENT_INFO_COMMAND_EXECUTION_STATUS,
+                            sizeof(status), &status, nullptr);
+    if (result != UR_RESULT_SUCCESS || status != UR_EVENT_STATUS_COMPLETE) {
+      return false;
+    }
+  }
+  releasePendingFrees(chunk);
+  chunk.offset = 0;
+  return true;
+}
+
+ur_result_t arena_t::enqueueAlloc(ur_queue_handle_t hQueue,
+                                  const ur_usm_desc_t *pUSMDesc, size_t size,
+                                  uint32_t numEventsInWaitList,
+                                  const ur_event_handle_t *phEventWaitList,
+                                  void **ppMem, ur_event_handle_t *phEvent) {
+  size_t align = pUSMDesc && pUSMDesc->align ? pUSMDesc->align : defaultAlign;
+  if (size == 0 || size > std::numeric_limits<size_t>::max() - align) {
+    return UR_RESULT_ERROR_INVALID_USM_SIZE;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+
+  // Chunks larger than chunkSize were allocated for a single allocation, so
+  // they are given back once idle rather than kept around.
+  for (auto it = chunks.begin(); it != chunks.end();) {
+    if (tryReclaim(*it) && it->size > chunkSize) {
+      fns.pfnFree(hContext, it->base);
+      it = chunks.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  // Offsets are aligned as absolute addresses, as chunks are only guaranteed
+  // the device's minimum alignment.
+  auto alignedOffset = [align](const chunk_t &chunk) {
+    auto base = reinterpret_cast<uintptr_t>(chunk.base);
+    return (base + chunk.offset + align - 1) / align * align - base;
+  };
+  auto chunk = std::find_if(chunks.begin(), chunks.end(), [&](auto &chunk) {
+    auto offset = alignedOffset(chunk);
+    return offset <= chunk.size && size <= chunk.size - offset;
+  });
+  if (chunk == chunks.end()) {
+    size_t newChunkSize = std::max(chunkSize, size + align);
+    void *base = nullptr;
+    auto result = fns.pfnDeviceAlloc(hContext, hDevice, nullptr, nullptr,
+                                     newChunkSize, &base);
+    if (result != UR_RESULT_SUCCESS) {
+      return result;
+    }
+    chunks.push_back({base, newChunkSize, 0, {}, {}});
+    chunk = std::prev(chunks.end());
+  }
+
+  // The memory itself is usable right away, only the commands using it need
+  // to be ordered after the wait list.
+  if (phEvent || numEventsInWaitList > 0) {
+    auto result = fns.pfnEventsWait(hQueue, numEventsInWaitList,
+                                    phEventWaitList, phEvent);
+    if (result != UR_RESULT_SUCCESS) {
+      return result;
+    }
+  }
+
+  auto offset = alignedOffset(*chunk);
+  chunk->offset = offset + size;
+  chunk->live.push_back(offset);
+  *ppMem = static_cast<char *>(chunk->base) + offset;
+  return UR_RESULT_SUCCESS;
+}
+
+ur_result_t arena_t::enqueueFree(ur_queue_handle_t hQueue, void *pMem,
+                                 uint32_t numEventsInWaitList,
+                                 const ur_event_handle_t *phEventWaitList,
+                                 ur_event_handle_t *phEvent) {
+  std::lock_guard<std::mutex> lock(mutex);
+
+  auto ptr = reinterpret_cast<uintptr_t>(pMem);
+  auto chunk = std::find_if(chunks.begin(), chunks.end(), [&](auto &chunk) {
+    auto base = reinterpret_cast<uintptr_t>(chunk.base);
+    return base <= ptr && ptr < base + chunk.offset;
+  });
+  if (chunk == chunks.end()) {
+    return UR_RESULT_ERROR_INVALID_VALUE;
+  }
+  // Only the start of a live allocation may be freed, so that the chunk isn't
+  // rewound while some of it is still in use.
+  auto offset = ptr - reinterpret_cast<uintptr_t>(chunk->base);
+  auto live = std::lower_bound(chunk->live.begin(), chunk->live.end(), offset);
+  if (live == chunk->live.end() || *live != offset) {
+    return UR_RESULT_ERROR_INVALID_VALUE;
+  }
+
+  if (inOrder) {
+    // Commands enqueued after the free run after the commands using the
+    // memory, so it can be handed out again right away.
+    if (phEvent || numEventsInWaitList > 0) {
+      auto result = fns.pfnEventsWait(hQueue, numEventsInWaitList,
+                                      phEventWaitList, phEvent);
+      if (result != UR_RESULT_SUCCESS) {
+        return result;
+      }
+    }
+  } else {
+    ur_event_handle_t hEvent = nullptr;
+    auto result = fns.pfnEventsWaitWithBarrier(hQueue, numEventsInWaitList,
+                                               phEventWaitList, &hEvent);
+    if (result != UR_RESULT_SUCCESS) {
+      return result;
+    }
+    chunk->pendingFrees.push_back(hEvent);
+    if (phEvent) {
+      fns.pfnEventRetain(hEvent);
+      *phEvent = hEvent;
+    }
+  }
+
+  chunk->live.erase(live);
+  return UR_RESULT_SUCCESS;
+}
+
+bool arena_t::holdsMemory() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return !chunks.empty();
+}
+
+} // namespace ur::usm_arena
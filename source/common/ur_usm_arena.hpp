@@ -0,0 +1,106 @@
+/*
+ *
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+ * Exceptions. See LICENSE.TXT
+ *
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ */
+
+#ifndef UR_USM_ARENA_HPP
+#define UR_USM_ARENA_HPP 1
+
+#include <ur_api.h>
+#include <ur_ddi.h>
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+// Implementation of urEnqueueUSMAllocExp and urEnqueueUSMFreeExp for adapters
+// that own a queue object, on top of the regular USM and event entry points.
+namespace ur::usm_arena {
+
+// Entry points the arena allocates its chunks and orders its frees with.
+struct arena_fns_t {
+  ur_pfnUSMDeviceAlloc_t pfnDeviceAlloc;
+  ur_pfnUSMFree_t pfnFree;
+  ur_pfnEnqueueEventsWait_t pfnEventsWait;
+  ur_pfnEnqueueEventsWaitWithBarrier_t pfnEventsWaitWithBarrier;
+  ur_pfnEventGetInfo_t pfnEventGetInfo;
+  ur_pfnEventWait_t pfnEventWait;
+  ur_pfnEventRetain_t pfnEventRetain;
+  ur_pfnEventRelease_t pfnEventRelease;
+};
+
+// Per-queue bump allocator. Allocations are carved out of device memory
+// chunks, and a chunk is only rewound once everything allocated from it has
+// been freed and these frees have completed on the device: right away on
+// in-order queues, and once the events of the frees are complete otherwise.
+// Frees on out-of-order queues are barriers, as the commands using the memory
+// aren't necessarily in their wait lists.
+//
+// The owner must make sure the queue is finished before destroying the arena.
+class arena_t {
+public:
+  static constexpr size_t defaultChunkSize = 2 * 1024 * 1024;
+  static constexpr size_t defaultAlign = 64;
+
+  arena_t(const arena_fns_t &fns, ur_context_handle_t hContext,
+          ur_device_handle_t hDevice, bool inOrder,
+          size_t chunkSize = defaultChunkSize);
+  ~arena_t();
+
+  arena_t(const arena_t &) = delete;
+  arena_t &operator=(const arena_t &) = delete;
+
+  ur_result_t enqueueAlloc(ur_queue_handle_t hQueue,
+                           const ur_usm_desc_t *pUSMDesc, size_t size,
+                           uint32_t numEventsInWaitList,
+                           const ur_event_handle_t *phEventWaitList,
+                           void **ppMem, ur_event_handle_t *phEvent);
+
+  ur_result_t enqueueFree(ur_queue_handle_t hQueue, void *pMem,
+                          uint32_t numEventsInWaitList,
+                          const ur_event_handle_t *phEventWaitList,
+                          ur_event_handle_t *phEvent);
+
+  // Whether the arena holds any device memory, which commands on the queue
+  // may still be using.
+  bool holdsMemory();
+
+private:
+  struct chunk_t {
+    void *base;
+    size_t size;
+    // Bump pointer, relative to base.
+    size_t offset;
+    // Offsets of the allocations from this chunk that haven't been freed yet,
+    // in increasing order, as they are bumped.
+    std::vector<size_t> live;
+    // Events of the frees that must complete before the chunk is rewound.
+    std::vector<ur_event_handle_t> pendingFrees;
+  };
+
+  // Rewinds an idle chunk whose frees have completed. Returns false if the
+  // chunk can't be rewound yet.
+  bool tryReclaim(chunk_t &chunk);
+
+  // Releases the chunk's pending free events.
+  void releasePendingFrees(chunk_t &chunk);
+
+  const arena_fns_t fns;
+  const ur_context_handle_t hContext;
+  const ur_device_handle_t hDevice;
+  const bool inOrder;
+  const size_t chunkSize;
+
+  std::mutex mutex;
+  std::vector<chunk_t> chunks;
+};
+
+} // namespace ur::usm_arena
+
+#endif // UR_USM_ARENA_HPP
@@ -0,0 +1,80 @@
+/*
+ *
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+ * Exceptions. See LICENSE.TXT
+ *
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ */
+#include <io.h>
+#include <windows.h>
+
+#include "logger/ur_logger.hpp"
+#include "ur_file_mapping.hpp"
+
+namespace ur {
+
+ur_result_t file_mapping_t::map(const ur_exp_file_region_t &region,
+                                size_t length) {
+  unmap();
+  if (length == 0) {
+    return UR_RESULT_ERROR_INVALID_SIZE;
+  }
+
+  HANDLE hFile = reinterpret_cast<HANDLE>(_get_osfhandle(region.fd));
+  LARGE_INTEGER fileSize;
+  if (hFile == INVALID_HANDLE_VALUE || !GetFileSizeEx(hFile, &fileSize)) {
+    return UR_RESULT_ERROR_INVALID_VALUE;
+  }
+  auto size = static_cast<uint64_t>(fileSize.QuadPart);
+  if (region.offset > size || length > size - region.offset) {
+    return UR_RESULT_ERROR_INVALID_SIZE;
+  }
+
+  HANDLE hMapping =
+      CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!hMapping) {
+    logger::error("failed to create a mapping of fd {}: {}", region.fd,
+                  GetLastError());
+    return UR_RESULT_ERROR_INVALID_VALUE;
+  }
+
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  uint64_t granularity = info.dwAllocationGranularity;
+  uint64_t mapOffset = region.offset / granularity * granularity;
+  size_t delta = static_cast<size_t>(region.offset - mapOffset);
+  // The view keeps the mapping object alive, so its handle can be closed
+  // right away.
+  void *mapped = MapViewOfFile(hMapping, FILE_MAP_READ,
+                               static_cast<DWORD>(mapOffset >> 32),
+                               static_cast<DWORD>(mapOffset), length + delta);
+  DWORD err = GetLastError();
+  CloseHandle(hMapping);
+  if (!mapped) {
+    logger::error("failed to map {} bytes at offset {} of fd {}: {}", length,
+                  region.offset, region.fd, err);
+    return err == ERROR_NOT_ENOUGH_MEMORY ? UR_RESULT_ERROR_OUT_OF_HOST_MEMORY
+                                          : UR_RESULT_ERROR_INVALID_VALUE;
+  }
+
+  base = mapped;
+  mappedLength = length + delta;
+  ptr = static_cast<const char *>(mapped) + delta;
+  this->length = length;
+  return UR_RESULT_SUCCESS;
+}
+
+void file_mapping_t::unmap() {
+  if (base) {
+    UnmapViewOfFile(base);
+  }
+  base = nullptr;
+  mappedLength = 0;
+  ptr = nullptr;
+  length = 0;
+}
+
+} // namespace ur
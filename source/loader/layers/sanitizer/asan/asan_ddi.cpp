@@ -16,6 +16,7 @@
 #include "asan_options.hpp"
 #include "sanitizer_common/sanitizer_stacktrace.hpp"
 #include "sanitizer_common/sanitizer_utils.hpp"
+#include "ur_enqueue_batch.hpp"
 #include "ur_sanitizer_layer.hpp"
 
 #include <memory>
@@ -195,7 +196,8 @@ __urdlllocal ur_result_t UR_APICALL urUSMFree(
 __urdlllocal ur_result_t UR_APICALL urProgramCreateWithIL(
     /// [in] handle of the context instance
     ur_context_handle_t hContext,
-    /// [in] pointer to IL binary.
+    /// [in][optional] pointer to IL binary. May only be NULL if the IL is
+    /// given by a ::ur_exp_program_file_source_t chained to `pProperties`.
     const void *pIL,
     /// [in] length of `pIL` in bytes.
     size_t length,
@@ -232,8 +234,10 @@ __urdlllocal ur_result_t UR_APICALL urProgramCreateWithBinary(
     /// [in][range(0, numDevices)] array of sizes of program binaries specified
     /// by `pBinaries` (in bytes).
     size_t *pLengths,
-    /// [in][range(0, numDevices)] pointer to program binaries to be loaded
-    /// for devices specified by `phDevices`.
+    /// [in][optional][range(0, numDevices)] pointer to program binaries to be
+    /// loaded for devices specified by `phDevices`. May only be NULL if the
+    /// binaries are given by a ::ur_exp_program_file_source_t chained to
+    /// `pProperties`.
     const uint8_t **ppBinaries,
     /// [in][optional] pointer to program creation properties.
     const ur_program_properties_t *pProperties,
@@ -513,6 +517,40 @@ __urdlllocal ur_result_t UR_APICALL urEnqueueKernelLaunch(
   return result;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Intercept function for urEnqueueBatchExp
+__urdlllocal ur_result_t UR_APICALL urEnqueueBatchExp(
+    /// [in] handle of the queue object
+    ur_queue_handle_t hQueue,
+    /// [in] number of commands in the batch
+    uint32_t numCommands,
+    /// [in][range(0, numCommands)] pointer to the commands of the batch
+    const ur_exp_batch_command_t *pCommands,
+    /// [in] size of the event wait list
+    uint32_t numEventsInWaitList,
+    /// [in][optional][range(0, numEventsInWaitList)] pointer to a list of
+    /// events that must be complete before the commands of the batch are
+    /// executed.
+    /// If nullptr, the numEventsInWaitList must be 0, indicating no wait
+    /// events.
+    const ur_event_handle_t *phEventWaitList,
+    /// [out][optional] return an event object that identifies the execution
+    /// of the whole batch.
+    /// If phEventWaitList and phEvent are not NULL, phEvent must not refer to
+    /// an element of the phEventWaitList array.
+    ur_event_handle_t *phEvent) {
+  getContext()->logger.debug("==== urEnqueueBatchExp");
+
+  // Adapters would record the commands without the checks of this layer, so
+  // each command goes through its intercept.
+  auto Fns = ur::batch::getEnqueueFns(getContext()->urDdiTable);
+  Fns.pfnKernelLaunch = ur_sanitizer_layer::asan::urEnqueueKernelLaunch;
+
+  return ur::batch::enqueueByCommand(Fns, hQueue, numCommands, pCommands,
+                                     numEventsInWaitList, phEventWaitList,
+                                     phEvent);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// @brief Intercept function for urContextCreate
 __urdlllocal ur_result_t UR_APICALL urContextCreate(
@@ -1870,6 +1908,36 @@ __urdlllocal ur_result_t UR_APICALL urGetEnqueueProcAddrTable(
   return result;
 }
 ///////////////////////////////////////////////////////////////////////////////
+/// @brief Exported function for filling application's EnqueueExp table
+///        with current process' addresses
+///
+/// @returns
+///     - ::UR_RESULT_SUCCESS
+///     - ::UR_RESULT_ERROR_INVALID_NULL_POINTER
+///     - ::UR_RESULT_ERROR_UNSUPPORTED_VERSION
+__urdlllocal ur_result_t UR_APICALL urGetEnqueueExpProcAddrTable(
+    /// [in] API version requested
+    ur_api_version_t version,
+    /// [in,out] pointer to table of DDI function pointers
+    ur_enqueue_exp_dditable_t *pDdiTable) {
+  if (nullptr == pDdiTable) {
+    return UR_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+
+  if (UR_MAJOR_VERSION(ur_sanitizer_layer::getContext()->version) !=
+          UR_MAJOR_VERSION(version) ||
+      UR_MINOR_VERSION(ur_sanitizer_layer::getContext()->version) >
+          UR_MINOR_VERSION(version)) {
+    return UR_RESULT_ERROR_UNSUPPORTED_VERSION;
+  }
+
+  ur_result_t result = UR_RESULT_SUCCESS;
+
+  pDdiTable->pfnBatchExp = ur_sanitizer_layer::asan::urEnqueueBatchExp;
+
+  return result;
+}
+///////////////////////////////////////////////////////////////////////////////
 /// @brief Exported function for filling application's USM table
 ///        with current process' addresses
 ///
@@ -2108,6 +2176,11 @@ ur_result_t initAsanDDITable(ur_dditable_t *dditable) {
         UR_API_VERSION_CURRENT, &dditable->Enqueue);
   }
 
+  if (UR_RESULT_SUCCESS == result) {
+    result = ur_sanitizer_layer::asan::urGetEnqueueExpProcAddrTable(
+        UR_API_VERSION_CURRENT, &dditable->EnqueueExp);
+  }
+
   if (UR_RESULT_SUCCESS == result) {
     result = ur_sanitizer_layer::asan::urGetUSMProcAddrTable(
         UR_API_VERSION_CURRENT, &dditable->USM);
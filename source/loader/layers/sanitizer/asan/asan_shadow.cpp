@@ -15,6 +15,7 @@
 #include "asan_interceptor.hpp"
 #include "asan_libdevice.hpp"
 #include "sanitizer_common/sanitizer_utils.hpp"
+#include "ur_host_dma.hpp"
 #include "ur_sanitizer_layer.hpp"
 
 namespace ur_sanitizer_layer {
@@ -95,7 +96,11 @@ ur_result_t ShadowMemoryCPU::EnqueuePoisonShadow(ur_queue_handle_t, uptr Ptr,
   getContext()->logger.debug("EnqueuePoisonShadow(addr={}, count={}, value={})",
                              (void *)ShadowBegin, ShadowEnd - ShadowBegin + 1,
                              (void *)(size_t)Value);
-  memset((void *)ShadowBegin, Value, ShadowEnd - ShadowBegin + 1);
+  // Poisoning large allocations touches megabytes of shadow, so spread it
+  // across threads.
+  static const ur::dma::executor_t Executor = ur::dma::makeThreadExecutor();
+  ur::dma::set((void *)ShadowBegin, Value, ShadowEnd - ShadowBegin + 1,
+               Executor);
 
   return UR_RESULT_SUCCESS;
 }
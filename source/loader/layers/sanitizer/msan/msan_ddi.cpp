@@ -14,6 +14,7 @@
 #include "msan_ddi.hpp"
 #include "msan_interceptor.hpp"
 #include "sanitizer_common/sanitizer_utils.hpp"
+#include "ur_enqueue_batch.hpp"
 #include "ur_sanitizer_layer.hpp"
 
 #include <memory>
@@ -158,7 +159,8 @@ ur_result_t UR_APICALL urUSMFree(
 ur_result_t urProgramCreateWithIL(
     /// [in] handle of the context instance
     ur_context_handle_t hContext,
-    /// [in] pointer to IL binary.
+    /// [in][optional] pointer to IL binary. May only be NULL if the IL is
+    /// given by a ::ur_exp_program_file_source_t chained to `pProperties`.
     const void *pIL,
     /// [in] length of `pIL` in bytes.
     size_t length,
@@ -191,8 +193,10 @@ ur_result_t urProgramCreateWithBinary(
     /// [in][range(0, numDevices)] array of sizes of program binaries specified
     /// by `pBinaries` (in bytes).
     size_t *pLengths,
-    /// [in][range(0, numDevices)] pointer to program binaries to be loaded
-    /// for devices specified by `phDevices`.
+    /// [in][optional][range(0, numDevices)] pointer to program binaries to be
+    /// loaded for devices specified by `phDevices`. May only be NULL if the
+    /// binaries are given by a ::ur_exp_program_file_source_t chained to
+    /// `pProperties`.
     const uint8_t **ppBinaries,
     /// [in][optional] pointer to program creation properties.
     const ur_program_properties_t *pProperties,
@@ -1662,6 +1666,42 @@ ur_result_t UR_APICALL urEnqueueUSMMemcpy2D(
   return UR_RESULT_SUCCESS;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Intercept function for urEnqueueBatchExp
+ur_result_t urEnqueueBatchExp(
+    /// [in] handle of the queue object
+    ur_queue_handle_t hQueue,
+    /// [in] number of commands in the batch
+    uint32_t numCommands,
+    /// [in][range(0, numCommands)] pointer to the commands of the batch
+    const ur_exp_batch_command_t *pCommands,
+    /// [in] size of the event wait list
+    uint32_t numEventsInWaitList,
+    /// [in][optional][range(0, numEventsInWaitList)] pointer to a list of
+    /// events that must be complete before the commands of the batch are
+    /// executed.
+    /// If nullptr, the numEventsInWaitList must be 0, indicating no wait
+    /// events.
+    const ur_event_handle_t *phEventWaitList,
+    /// [out][optional] return an event object that identifies the execution
+    /// of the whole batch.
+    /// If phEventWaitList and phEvent are not NULL, phEvent must not refer to
+    /// an element of the phEventWaitList array.
+    ur_event_handle_t *phEvent) {
+  getContext()->logger.debug("==== urEnqueueBatchExp");
+
+  // Adapters would record the commands without the checks of this layer, so
+  // each command goes through its intercept.
+  auto Fns = ur::batch::getEnqueueFns(getContext()->urDdiTable);
+  Fns.pfnKernelLaunch = ur_sanitizer_layer::msan::urEnqueueKernelLaunch;
+  Fns.pfnUSMMemcpy = ur_sanitizer_layer::msan::urEnqueueUSMMemcpy;
+  Fns.pfnUSMFill = ur_sanitizer_layer::msan::urEnqueueUSMFill;
+
+  return ur::batch::enqueueByCommand(Fns, hQueue, numCommands, pCommands,
+                                     numEventsInWaitList, phEventWaitList,
+                                     phEvent);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// @brief Exported function for filling application's Global table
 ///        with current process' addresses
@@ -1817,6 +1857,22 @@ ur_result_t urGetEnqueueProcAddrTable(
   return result;
 }
 ///////////////////////////////////////////////////////////////////////////////
+/// @brief Exported function for filling application's EnqueueExp table
+///        with current process' addresses
+///
+/// @returns
+///     - ::UR_RESULT_SUCCESS
+///     - ::UR_RESULT_ERROR_INVALID_NULL_POINTER
+ur_result_t urGetEnqueueExpProcAddrTable(
+    /// [in,out] pointer to table of DDI function pointers
+    ur_enqueue_exp_dditable_t *pDdiTable) {
+  ur_result_t result = UR_RESULT_SUCCESS;
+
+  pDdiTable->pfnBatchExp = ur_sanitizer_layer::msan::urEnqueueBatchExp;
+
+  return result;
+}
+///////////////////////////////////////////////////////////////////////////////
 /// @brief Exported function for filling application's USM table
 ///        with current process' addresses
 ///
@@ -1896,6 +1952,11 @@ ur_result_t initMsanDDITable(ur_dditable_t *dditable) {
         ur_sanitizer_layer::msan::urGetEnqueueProcAddrTable(&dditable->Enqueue);
   }
 
+  if (UR_RESULT_SUCCESS == result) {
+    result = ur_sanitizer_layer::msan::urGetEnqueueExpProcAddrTable(
+        &dditable->EnqueueExp);
+  }
+
   if (UR_RESULT_SUCCESS == result) {
     result = ur_sanitizer_layer::msan::urGetUSMProcAddrTable(&dditable->USM);
   }
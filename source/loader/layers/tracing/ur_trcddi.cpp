@@ -2592,7 +2592,8 @@ __urdlllocal ur_result_t UR_APICALL urPhysicalMemGetInfo(
 __urdlllocal ur_result_t UR_APICALL urProgramCreateWithIL(
     /// [in] handle of the context instance
     ur_context_handle_t hContext,
-    /// [in] pointer to IL binary.
+    /// [in][optional] pointer to IL binary. May only be NULL if the IL is
+    /// given by a ::ur_exp_program_file_source_t chained to `pProperties`.
     const void *pIL,
     /// [in] length of `pIL` in bytes.
     size_t length,
@@ -2643,8 +2644,10 @@ __urdlllocal ur_result_t UR_APICALL urProgramCreateWithBinary(
     /// [in][range(0, numDevices)] array of sizes of program binaries
     /// specified by `pBinaries` (in bytes).
     size_t *pLengths,
-    /// [in][range(0, numDevices)] pointer to program binaries to be loaded
-    /// for devices specified by `phDevices`.
+    /// [in][optional][range(0, numDevices)] pointer to program binaries to be
+    /// loaded for devices specified by `phDevices`. May only be NULL if the
+    /// binaries are given by a ::ur_exp_program_file_source_t chained to
+    /// `pProperties`.
     const uint8_t **ppBinaries,
     /// [in][optional] pointer to program creation properties.
     const ur_program_properties_t *pProperties,
@@ -8959,6 +8962,221 @@ __urdlllocal ur_result_t UR_APICALL urUsmP2PPeerAccessGetInfoExp(
   return result;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Intercept function for urEnqueueBatchExp
+__urdlllocal ur_result_t UR_APICALL urEnqueueBatchExp(
+    /// [in] handle of the queue object
+    ur_queue_handle_t hQueue,
+    /// [in] number of commands in the batch
+    uint32_t numCommands,
+    /// [in][range(0, numCommands)] pointer to the commands of the batch
+    const ur_exp_batch_command_t *pCommands,
+    /// [in] size of the event wait list
+    uint32_t numEventsInWaitList,
+    /// [in][optional][range(0, numEventsInWaitList)] pointer to a list of
+    /// events that must be complete before the commands of the batch are
+    /// executed.
+    /// If nullptr, the numEventsInWaitList must be 0, indicating no wait
+    /// events.
+    const ur_event_handle_t *phEventWaitList,
+    /// [out][optional] return an event object that identifies the execution
+    /// of the whole batch.
+    /// If phEventWaitList and phEvent are not NULL, phEvent must not refer to
+    /// an element of the phEventWaitList array.
+    ur_event_handle_t *phEvent) {
+  auto pfnBatchExp = getContext()->urDdiTable.EnqueueExp.pfnBatchExp;
+
+  if (nullptr == pfnBatchExp)
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+
+  ur_enqueue_batch_exp_params_t params = {
+      &hQueue,          &numCommands, &pCommands, &numEventsInWaitList,
+      &phEventWaitList, &phEvent};
+  uint64_t instance = getContext()->notify_begin(UR_FUNCTION_ENQUEUE_BATCH_EXP,
+                                                 "urEnqueueBatchExp", &params);
+
+  auto &logger = getContext()->logger;
+  logger.info("   ---> urEnqueueBatchExp\n");
+
+  ur_result_t result = pfnBatchExp(hQueue, numCommands, pCommands,
+                                   numEventsInWaitList, phEventWaitList,
+                                   phEvent);
+
+  getContext()->notify_end(UR_FUNCTION_ENQUEUE_BATCH_EXP, "urEnqueueBatchExp",
+                           &params, &result, instance);
+
+  if (logger.getLevel() <= logger::Level::INFO) {
+    std::ostringstream args_str;
+    ur::extras::printFunctionParams(args_str, UR_FUNCTION_ENQUEUE_BATCH_EXP,
+                                    &params);
+    logger.info("   <--- urEnqueueBatchExp({}) -> {};\n", args_str.str(),
+                result);
+  }
+
+  return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Intercept function for urEnqueueHostTaskExp
+__urdlllocal ur_result_t UR_APICALL urEnqueueHostTaskExp(
+    /// [in] handle of the queue object
+    ur_queue_handle_t hQueue,
+    /// [in] function to be executed on the host
+    ur_exp_host_task_function_t pfnHostTask,
+    /// [in][optional] data passed to pfnHostTask
+    void *pUserData,
+    /// [in] size of the event wait list
+    uint32_t numEventsInWaitList,
+    /// [in][optional][range(0, numEventsInWaitList)] pointer to a list of
+    /// events that must be complete before pfnHostTask is called.
+    /// If nullptr, the numEventsInWaitList must be 0, indicating no wait
+    /// events.
+    const ur_event_handle_t *phEventWaitList,
+    /// [out][optional] return an event object that identifies the execution
+    /// of the host task.
+    /// If phEventWaitList and phEvent are not NULL, phEvent must not refer to
+    /// an element of the phEventWaitList array.
+    ur_event_handle_t *phEvent) {
+  auto pfnHostTaskExp = getContext()->urDdiTable.EnqueueExp.pfnHostTaskExp;
+
+  if (nullptr == pfnHostTaskExp)
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+
+  ur_enqueue_host_task_exp_params_t params = {
+      &hQueue,          &pfnHostTask, &pUserData, &numEventsInWaitList,
+      &phEventWaitList, &phEvent};
+  uint64_t instance =
+      getContext()->notify_begin(UR_FUNCTION_ENQUEUE_HOST_TASK_EXP,
+                                 "urEnqueueHostTaskExp", &params);
+
+  auto &logger = getContext()->logger;
+  logger.info("   ---> urEnqueueHostTaskExp\n");
+
+  ur_result_t result = pfnHostTaskExp(hQueue, pfnHostTask, pUserData,
+                                      numEventsInWaitList, phEventWaitList,
+                                      phEvent);
+
+  getContext()->notify_end(UR_FUNCTION_ENQUEUE_HOST_TASK_EXP,
+                           "urEnqueueHostTaskExp", &params, &result, instance);
+
+  if (logger.getLevel() <= logger::Level::INFO) {
+    std::ostringstream args_str;
+    ur::extras::printFunctionParams(args_str, UR_FUNCTION_ENQUEUE_HOST_TASK_EXP,
+                                    &params);
+    logger.info("   <--- urEnqueueHostTaskExp({}) -> {};\n", args_str.str(),
+                result);
+  }
+
+  return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Intercept function for urEnqueueUSMAllocExp
+__urdlllocal ur_result_t UR_APICALL urEnqueueUSMAllocExp(
+    /// [in] handle of the queue object
+    ur_queue_handle_t hQueue,
+    /// [in][optional] USM memory allocation descriptor, of which only the
+    /// alignment is used
+    const ur_usm_desc_t *pUSMDesc,
+    /// [in] minimum size in bytes of the USM memory object to be allocated
+    size_t size,
+    /// [in] size of the event wait list
+    uint32_t numEventsInWaitList,
+    /// [in][optional][range(0, numEventsInWaitList)] pointer to a list of
+    /// events that must be complete before the allocation can be used.
+    /// If nullptr, the numEventsInWaitList must be 0, indicating no wait
+    /// events.
+    const ur_event_handle_t *phEventWaitList,
+    /// [out] pointer to USM device memory object
+    void **ppMem,
+    /// [out][optional] return an event object that identifies this particular
+    /// command instance.
+    /// If phEventWaitList and phEvent are not NULL, phEvent must not refer to
+    /// an element of the phEventWaitList array.
+    ur_event_handle_t *phEvent) {
+  auto pfnUSMAllocExp = getContext()->urDdiTable.EnqueueExp.pfnUSMAllocExp;
+
+  if (nullptr == pfnUSMAllocExp)
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+
+  ur_enqueue_usm_alloc_exp_params_t params = {
+      &hQueue,          &pUSMDesc, &size,   &numEventsInWaitList,
+      &phEventWaitList, &ppMem,    &phEvent};
+  uint64_t instance =
+      getContext()->notify_begin(UR_FUNCTION_ENQUEUE_USM_ALLOC_EXP,
+                                 "urEnqueueUSMAllocExp", &params);
+
+  auto &logger = getContext()->logger;
+  logger.info("   ---> urEnqueueUSMAllocExp\n");
+
+  ur_result_t result = pfnUSMAllocExp(hQueue, pUSMDesc, size,
+                                      numEventsInWaitList, phEventWaitList,
+                                      ppMem, phEvent);
+
+  getContext()->notify_end(UR_FUNCTION_ENQUEUE_USM_ALLOC_EXP,
+                           "urEnqueueUSMAllocExp", &params, &result, instance);
+
+  if (logger.getLevel() <= logger::Level::INFO) {
+    std::ostringstream args_str;
+    ur::extras::printFunctionParams(args_str, UR_FUNCTION_ENQUEUE_USM_ALLOC_EXP,
+                                    &params);
+    logger.info("   <--- urEnqueueUSMAllocExp({}) -> {};\n", args_str.str(),
+                result);
+  }
+
+  return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Intercept function for urEnqueueUSMFreeExp
+__urdlllocal ur_result_t UR_APICALL urEnqueueUSMFreeExp(
+    /// [in] handle of the queue object
+    ur_queue_handle_t hQueue,
+    /// [in] pointer to USM memory object allocated by ::urEnqueueUSMAllocExp
+    void *pMem,
+    /// [in] size of the event wait list
+    uint32_t numEventsInWaitList,
+    /// [in][optional][range(0, numEventsInWaitList)] pointer to a list of
+    /// events that must be complete before the memory is released.
+    /// If nullptr, the numEventsInWaitList must be 0, indicating no wait
+    /// events.
+    const ur_event_handle_t *phEventWaitList,
+    /// [out][optional] return an event object that identifies this particular
+    /// command instance.
+    /// If phEventWaitList and phEvent are not NULL, phEvent must not refer to
+    /// an element of the phEventWaitList array.
+    ur_event_handle_t *phEvent) {
+  auto pfnUSMFreeExp = getContext()->urDdiTable.EnqueueExp.pfnUSMFreeExp;
+
+  if (nullptr == pfnUSMFreeExp)
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+
+  ur_enqueue_usm_free_exp_params_t params = {
+      &hQueue, &pMem, &numEventsInWaitList, &phEventWaitList, &phEvent};
+  uint64_t instance =
+      getContext()->notify_begin(UR_FUNCTION_ENQUEUE_USM_FREE_EXP,
+                                 "urEnqueueUSMFreeExp", &params);
+
+  auto &logger = getContext()->logger;
+  logger.info("   ---> urEnqueueUSMFreeExp\n");
+
+  ur_result_t result = pfnUSMFreeExp(hQueue, pMem, numEventsInWaitList,
+                                     phEventWaitList, phEvent);
+
+  getContext()->notify_end(UR_FUNCTION_ENQUEUE_USM_FREE_EXP,
+                           "urEnqueueUSMFreeExp", &params, &result, instance);
+
+  if (logger.getLevel() <= logger::Level::INFO) {
+    std::ostringstream args_str;
+    ur::extras::printFunctionParams(args_str, UR_FUNCTION_ENQUEUE_USM_FREE_EXP,
+                                    &params);
+    logger.info("   <--- urEnqueueUSMFreeExp({}) -> {};\n", args_str.str(),
+                result);
+  }
+
+  return result;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// @brief Intercept function for urEnqueueEventsWaitWithBarrierExt
 __urdlllocal ur_result_t UR_APICALL urEnqueueEventsWaitWithBarrierExt(
@@ -9533,6 +9751,18 @@ __urdlllocal ur_result_t UR_APICALL urGetEnqueueExpProcAddrTable(
   pDdiTable->pfnKernelLaunchCustomExp =
       ur_tracing_layer::urEnqueueKernelLaunchCustomExp;
 
+  dditable.pfnBatchExp = pDdiTable->pfnBatchExp;
+  pDdiTable->pfnBatchExp = ur_tracing_layer::urEnqueueBatchExp;
+
+  dditable.pfnHostTaskExp = pDdiTable->pfnHostTaskExp;
+  pDdiTable->pfnHostTaskExp = ur_tracing_layer::urEnqueueHostTaskExp;
+
+  dditable.pfnUSMAllocExp = pDdiTable->pfnUSMAllocExp;
+  pDdiTable->pfnUSMAllocExp = ur_tracing_layer::urEnqueueUSMAllocExp;
+
+  dditable.pfnUSMFreeExp = pDdiTable->pfnUSMFreeExp;
+  pDdiTable->pfnUSMFreeExp = ur_tracing_layer::urEnqueueUSMFreeExp;
+
   dditable.pfnCooperativeKernelLaunchExp =
       pDdiTable->pfnCooperativeKernelLaunchExp;
   pDdiTable->pfnCooperativeKernelLaunchExp =
@@ -177,7 +177,7 @@ __urdlllocal ur_result_t UR_APICALL urAdapterGetInfo(
     if (pPropValue == NULL && pPropSizeRet == NULL)
       return UR_RESULT_ERROR_INVALID_NULL_POINTER;
 
-    if (UR_ADAPTER_INFO_VERSION < propName)
+    if (UR_ADAPTER_INFO_LATENCY_HISTOGRAM_EXP < propName)
       return UR_RESULT_ERROR_INVALID_ENUMERATION;
 
     if (propSize == 0 && pPropValue != NULL)
@@ -2553,7 +2553,8 @@ __urdlllocal ur_result_t UR_APICALL urPhysicalMemGetInfo(
 __urdlllocal ur_result_t UR_APICALL urProgramCreateWithIL(
     /// [in] handle of the context instance
     ur_context_handle_t hContext,
-    /// [in] pointer to IL binary.
+    /// [in][optional] pointer to IL binary. May only be NULL if the IL is
+    /// given by a ::ur_exp_program_file_source_t chained to `pProperties`.
     const void *pIL,
     /// [in] length of `pIL` in bytes.
     size_t length,
@@ -2571,10 +2572,11 @@ __urdlllocal ur_result_t UR_APICALL urProgramCreateWithIL(
     if (NULL == hContext)
       return UR_RESULT_ERROR_INVALID_NULL_HANDLE;
 
-    if (NULL == pIL)
+    if (NULL == phProgram)
       return UR_RESULT_ERROR_INVALID_NULL_POINTER;
 
-    if (NULL == phProgram)
+    if (NULL == pIL &&
+        NULL == find_stype_node<ur_exp_program_file_source_t>(pProperties))
       return UR_RESULT_ERROR_INVALID_NULL_POINTER;
 
     if (NULL != pProperties && pProperties->count > 0 &&
@@ -2617,8 +2619,10 @@ __urdlllocal ur_result_t UR_APICALL urProgramCreateWithBinary(
     /// [in][range(0, numDevices)] array of sizes of program binaries
     /// specified by `pBinaries` (in bytes).
     size_t *pLengths,
-    /// [in][range(0, numDevices)] pointer to program binaries to be loaded
-    /// for devices specified by `phDevices`.
+    /// [in][optional][range(0, numDevices)] pointer to program binaries to be
+    /// loaded for devices specified by `phDevices`. May only be NULL if the
+    /// binaries are given by a ::ur_exp_program_file_source_t chained to
+    /// `pProperties`.
     const uint8_t **ppBinaries,
     /// [in][optional] pointer to program creation properties.
     const ur_program_properties_t *pProperties,
@@ -2641,10 +2645,11 @@ __urdlllocal ur_result_t UR_APICALL urProgramCreateWithBinary(
     if (NULL == pLengths)
       return UR_RESULT_ERROR_INVALID_NULL_POINTER;
 
-    if (NULL == ppBinaries)
+    if (NULL == phProgram)
       return UR_RESULT_ERROR_INVALID_NULL_POINTER;
 
-    if (NULL == phProgram)
+    if (NULL == ppBinaries &&
+        NULL == find_stype_node<ur_exp_program_file_source_t>(pProperties))
       return UR_RESULT_ERROR_INVALID_NULL_POINTER;
 
     if (NULL != pProperties && pProperties->count > 0 &&
@@ -9598,6 +9603,264 @@ __urdlllocal ur_result_t UR_APICALL urUsmP2PPeerAccessGetInfoExp(
   return result;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Intercept function for urEnqueueBatchExp
+__urdlllocal ur_result_t UR_APICALL urEnqueueBatchExp(
+    /// [in] handle of the queue object
+    ur_queue_handle_t hQueue,
+    /// [in] number of commands in the batch
+    uint32_t numCommands,
+    /// [in][range(0, numCommands)] pointer to the commands of the batch
+    const ur_exp_batch_command_t *pCommands,
+    /// [in] size of the event wait list
+    uint32_t numEventsInWaitList,
+    /// [in][optional][range(0, numEventsInWaitList)] pointer to a list of
+    /// events that must be complete before the commands of the batch are
+    /// executed.
+    /// If nullptr, the numEventsInWaitList must be 0, indicating no wait
+    /// events.
+    const ur_event_handle_t *phEventWaitList,
+    /// [out][optional] return an event object that identifies the execution
+    /// of the whole batch.
+    /// If phEventWaitList and phEvent are not NULL, phEvent must not refer to
+    /// an element of the phEventWaitList array.
+    ur_event_handle_t *phEvent) {
+  auto pfnBatchExp = getContext()->urDdiTable.EnqueueExp.pfnBatchExp;
+
+  if (nullptr == pfnBatchExp) {
+    return UR_RESULT_ERROR_UNINITIALIZED;
+  }
+
+  if (getContext()->enableParameterValidation) {
+    if (NULL == hQueue)
+      return UR_RESULT_ERROR_INVALID_NULL_HANDLE;
+
+    if (NULL == pCommands)
+      return UR_RESULT_ERROR_INVALID_NULL_POINTER;
+
+    if (numCommands == 0)
+      return UR_RESULT_ERROR_INVALID_SIZE;
+
+    if (phEventWaitList == NULL && numEventsInWaitList > 0)
+      return UR_RESULT_ERROR_INVALID_EVENT_WAIT_LIST;
+
+    if (phEventWaitList != NULL && numEventsInWaitList == 0)
+      return UR_RESULT_ERROR_INVALID_EVENT_WAIT_LIST;
+
+    if (phEventWaitList != NULL && numEventsInWaitList > 0) {
+      for (uint32_t i = 0; i < numEventsInWaitList; ++i) {
+        if (phEventWaitList[i] == NULL) {
+          return UR_RESULT_ERROR_INVALID_EVENT_WAIT_LIST;
+        }
+      }
+    }
+  }
+
+  if (getContext()->enableLifetimeValidation &&
+      !getContext()->refCountContext->isReferenceValid(hQueue)) {
+    getContext()->refCountContext->logInvalidReference(hQueue);
+  }
+
+  ur_result_t result = pfnBatchExp(hQueue, numCommands, pCommands,
+                                   numEventsInWaitList, phEventWaitList,
+                                   phEvent);
+
+  return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Intercept function for urEnqueueHostTaskExp
+__urdlllocal ur_result_t UR_APICALL urEnqueueHostTaskExp(
+    /// [in] handle of the queue object
+    ur_queue_handle_t hQueue,
+    /// [in] function to be executed on the host
+    ur_exp_host_task_function_t pfnHostTask,
+    /// [in][optional] data passed to pfnHostTask
+    void *pUserData,
+    /// [in] size of the event wait list
+    uint32_t numEventsInWaitList,
+    /// [in][optional][range(0, numEventsInWaitList)] pointer to a list of
+    /// events that must be complete before pfnHostTask is called.
+    /// If nullptr, the numEventsInWaitList must be 0, indicating no wait
+    /// events.
+    const ur_event_handle_t *phEventWaitList,
+    /// [out][optional] return an event object that identifies the execution
+    /// of the host task.
+    /// If phEventWaitList and phEvent are not NULL, phEvent must not refer to
+    /// an element of the phEventWaitList array.
+    ur_event_handle_t *phEvent) {
+  auto pfnHostTaskExp = getContext()->urDdiTable.EnqueueExp.pfnHostTaskExp;
+
+  if (nullptr == pfnHostTaskExp) {
+    return UR_RESULT_ERROR_UNINITIALIZED;
+  }
+
+  if (getContext()->enableParameterValidation) {
+    if (NULL == hQueue)
+      return UR_RESULT_ERROR_INVALID_NULL_HANDLE;
+
+    if (NULL == pfnHostTask)
+      return UR_RESULT_ERROR_INVALID_NULL_POINTER;
+
+    if (phEventWaitList == NULL && numEventsInWaitList > 0)
+      return UR_RESULT_ERROR_INVALID_EVENT_WAIT_LIST;
+
+    if (phEventWaitList != NULL && numEventsInWaitList == 0)
+      return UR_RESULT_ERROR_INVALID_EVENT_WAIT_LIST;
+
+    if (phEventWaitList != NULL && numEventsInWaitList > 0) {
+      for (uint32_t i = 0; i < numEventsInWaitList; ++i) {
+        if (phEventWaitList[i] == NULL) {
+          return UR_RESULT_ERROR_INVALID_EVENT_WAIT_LIST;
+        }
+      }
+    }
+  }
+
+  if (getContext()->enableLifetimeValidation &&
+      !getContext()->refCountContext->isReferenceValid(hQueue)) {
+    getContext()->refCountContext->logInvalidReference(hQueue);
+  }
+
+  ur_result_t result = pfnHostTaskExp(hQueue, pfnHostTask, pUserData,
+                                      numEventsInWaitList, phEventWaitList,
+                                      phEvent);
+
+  return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Intercept function for urEnqueueUSMAllocExp
+__urdlllocal ur_result_t UR_APICALL urEnqueueUSMAllocExp(
+    /// [in] handle of the queue object
+    ur_queue_handle_t hQueue,
+    /// [in][optional] USM memory allocation descriptor, of which only the
+    /// alignment is used
+    const ur_usm_desc_t *pUSMDesc,
+    /// [in] minimum size in bytes of the USM memory object to be allocated
+    size_t size,
+    /// [in] size of the event wait list
+    uint32_t numEventsInWaitList,
+    /// [in][optional][range(0, numEventsInWaitList)] pointer to a list of
+    /// events that must be complete before the allocation can be used.
+    /// If nullptr, the numEventsInWaitList must be 0, indicating no wait
+    /// events.
+    const ur_event_handle_t *phEventWaitList,
+    /// [out] pointer to USM device memory object
+    void **ppMem,
+    /// [out][optional] return an event object that identifies this particular
+    /// command instance.
+    /// If phEventWaitList and phEvent are not NULL, phEvent must not refer to
+    /// an element of the phEventWaitList array.
+    ur_event_handle_t *phEvent) {
+  auto pfnUSMAllocExp = getContext()->urDdiTable.EnqueueExp.pfnUSMAllocExp;
+
+  if (nullptr == pfnUSMAllocExp) {
+    return UR_RESULT_ERROR_UNINITIALIZED;
+  }
+
+  if (getContext()->enableParameterValidation) {
+    if (NULL == hQueue)
+      return UR_RESULT_ERROR_INVALID_NULL_HANDLE;
+
+    if (NULL == ppMem)
+      return UR_RESULT_ERROR_INVALID_NULL_POINTER;
+
+    if (NULL != pUSMDesc && UR_USM_ADVICE_FLAGS_MASK & pUSMDesc->hints)
+      return UR_RESULT_ERROR_INVALID_ENUMERATION;
+
+    if (pUSMDesc && pUSMDesc->align != 0 &&
+        ((pUSMDesc->align & (pUSMDesc->align - 1)) != 0))
+      return UR_RESULT_ERROR_INVALID_VALUE;
+
+    if (size == 0)
+      return UR_RESULT_ERROR_INVALID_USM_SIZE;
+
+    if (phEventWaitList == NULL && numEventsInWaitList > 0)
+      return UR_RESULT_ERROR_INVALID_EVENT_WAIT_LIST;
+
+    if (phEventWaitList != NULL && numEventsInWaitList == 0)
+      return UR_RESULT_ERROR_INVALID_EVENT_WAIT_LIST;
+
+    if (phEventWaitList != NULL && numEventsInWaitList > 0) {
+      for (uint32_t i = 0; i < numEventsInWaitList; ++i) {
+        if (phEventWaitList[i] == NULL) {
+          return UR_RESULT_ERROR_INVALID_EVENT_WAIT_LIST;
+        }
+      }
+    }
+  }
+
+  if (getContext()->enableLifetimeValidation &&
+      !getContext()->refCountContext->isReferenceValid(hQueue)) {
+    getContext()->refCountContext->logInvalidReference(hQueue);
+  }
+
+  ur_result_t result = pfnUSMAllocExp(hQueue, pUSMDesc, size,
+                                      numEventsInWaitList, phEventWaitList,
+                                      ppMem, phEvent);
+
+  return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Intercept function for urEnqueueUSMFreeExp
+__urdlllocal ur_result_t UR_APICALL urEnqueueUSMFreeExp(
+    /// [in] handle of the queue object
+    ur_queue_handle_t hQueue,
+    /// [in] pointer to USM memory object allocated by ::urEnqueueUSMAllocExp
+    void *pMem,
+    /// [in] size of the event wait list
+    uint32_t numEventsInWaitList,
+    /// [in][optional][range(0, numEventsInWaitList)] pointer to a list of
+    /// events that must be complete before the memory is released.
+    /// If nullptr, the numEventsInWaitList must be 0, indicating no wait
+    /// events.
+    const ur_event_handle_t *phEventWaitList,
+    /// [out][optional] return an event object that identifies this particular
+    /// command instance.
+    /// If phEventWaitList and phEvent are not NULL, phEvent must not refer to
+    /// an element of the phEventWaitList array.
+    ur_event_handle_t *phEvent) {
+  auto pfnUSMFreeExp = getContext()->urDdiTable.EnqueueExp.pfnUSMFreeExp;
+
+  if (nullptr == pfnUSMFreeExp) {
+    return UR_RESULT_ERROR_UNINITIALIZED;
+  }
+
+  if (getContext()->enableParameterValidation) {
+    if (NULL == hQueue)
+      return UR_RESULT_ERROR_INVALID_NULL_HANDLE;
+
+    if (NULL == pMem)
+      return UR_RESULT_ERROR_INVALID_NULL_POINTER;
+
+    if (phEventWaitList == NULL && numEventsInWaitList > 0)
+      return UR_RESULT_ERROR_INVALID_EVENT_WAIT_LIST;
+
+    if (phEventWaitList != NULL && numEventsInWaitList == 0)
+      return UR_RESULT_ERROR_INVALID_EVENT_WAIT_LIST;
+
+    if (phEventWaitList != NULL && numEventsInWaitList > 0) {
+      for (uint32_t i = 0; i < numEventsInWaitList; ++i) {
+        if (phEventWaitList[i] == NULL) {
+          return UR_RESULT_ERROR_INVALID_EVENT_WAIT_LIST;
+        }
+      }
+    }
+  }
+
+  if (getContext()->enableLifetimeValidation &&
+      !getContext()->refCountContext->isReferenceValid(hQueue)) {
+    getContext()->refCountContext->logInvalidReference(hQueue);
+  }
+
+  ur_result_t result = pfnUSMFreeExp(hQueue, pMem, numEventsInWaitList,
+                                     phEventWaitList, phEvent);
+
+  return result;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// @brief Intercept function for urEnqueueEventsWaitWithBarrierExt
 __urdlllocal ur_result_t UR_APICALL urEnqueueEventsWaitWithBarrierExt(
@@ -10189,6 +10452,18 @@ UR_DLLEXPORT ur_result_t UR_APICALL urGetEnqueueExpProcAddrTable(
   pDdiTable->pfnKernelLaunchCustomExp =
       ur_validation_layer::urEnqueueKernelLaunchCustomExp;
 
+  dditable.pfnBatchExp = pDdiTable->pfnBatchExp;
+  pDdiTable->pfnBatchExp = ur_validation_layer::urEnqueueBatchExp;
+
+  dditable.pfnHostTaskExp = pDdiTable->pfnHostTaskExp;
+  pDdiTable->pfnHostTaskExp = ur_validation_layer::urEnqueueHostTaskExp;
+
+  dditable.pfnUSMAllocExp = pDdiTable->pfnUSMAllocExp;
+  pDdiTable->pfnUSMAllocExp = ur_validation_layer::urEnqueueUSMAllocExp;
+
+  dditable.pfnUSMFreeExp = pDdiTable->pfnUSMFreeExp;
+  pDdiTable->pfnUSMFreeExp = ur_validation_layer::urEnqueueUSMFreeExp;
+
   dditable.pfnCooperativeKernelLaunchExp =
       pDdiTable->pfnCooperativeKernelLaunchExp;
   pDdiTable->pfnCooperativeKernelLaunchExp =
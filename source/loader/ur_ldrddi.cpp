@@ -11,6 +11,8 @@
  * @file ur_ldrddi.cpp
  *
  */
+#include "ur_enqueue_batch.hpp"
+#include "ur_enqueue_host_task.hpp"
 #include "ur_lib_loader.hpp"
 #include "ur_loader.hpp"
 
@@ -2598,7 +2600,8 @@ __urdlllocal ur_result_t UR_APICALL urPhysicalMemGetInfo(
 __urdlllocal ur_result_t UR_APICALL urProgramCreateWithIL(
     /// [in] handle of the context instance
     ur_context_handle_t hContext,
-    /// [in] pointer to IL binary.
+    /// [in][optional] pointer to IL binary. May only be NULL if the IL is
+    /// given by a ::ur_exp_program_file_source_t chained to `pProperties`.
     const void *pIL,
     /// [in] length of `pIL` in bytes.
     size_t length,
@@ -2650,8 +2653,10 @@ __urdlllocal ur_result_t UR_APICALL urProgramCreateWithBinary(
     /// [in][range(0, numDevices)] array of sizes of program binaries
     /// specified by `pBinaries` (in bytes).
     size_t *pLengths,
-    /// [in][range(0, numDevices)] pointer to program binaries to be loaded
-    /// for devices specified by `phDevices`.
+    /// [in][optional][range(0, numDevices)] pointer to program binaries to be
+    /// loaded for devices specified by `phDevices`. May only be NULL if the
+    /// binaries are given by a ::ur_exp_program_file_source_t chained to
+    /// `pProperties`.
     const uint8_t **ppBinaries,
     /// [in][optional] pointer to program creation properties.
     const ur_program_properties_t *pProperties,
@@ -9123,6 +9128,329 @@ __urdlllocal ur_result_t UR_APICALL urUsmP2PPeerAccessGetInfoExp(
   return result;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Intercept function for urEnqueueBatchExp
+__urdlllocal ur_result_t UR_APICALL urEnqueueBatchExp(
+    /// [in] handle of the queue object
+    ur_queue_handle_t hQueue,
+    /// [in] number of commands in the batch
+    uint32_t numCommands,
+    /// [in][range(0, numCommands)] pointer to the commands of the batch
+    const ur_exp_batch_command_t *pCommands,
+    /// [in] size of the event wait list
+    uint32_t numEventsInWaitList,
+    /// [in][optional][range(0, numEventsInWaitList)] pointer to a list of
+    /// events that must be complete before the commands of the batch are
+    /// executed.
+    /// If nullptr, the numEventsInWaitList must be 0, indicating no wait
+    /// events.
+    const ur_event_handle_t *phEventWaitList,
+    /// [out][optional] return an event object that identifies the execution
+    /// of the whole batch.
+    /// If phEventWaitList and phEvent are not NULL, phEvent must not refer to
+    /// an element of the phEventWaitList array.
+    ur_event_handle_t *phEvent) {
+  ur_result_t result = UR_RESULT_SUCCESS;
+
+  [[maybe_unused]] auto context = getContext();
+
+  // extract platform's function pointer table
+  auto dditable = reinterpret_cast<ur_queue_object_t *>(hQueue)->dditable;
+  auto pfnBatchExp = dditable->ur.EnqueueExp.pfnBatchExp;
+
+  // convert loader handle to platform handle
+  hQueue = reinterpret_cast<ur_queue_object_t *>(hQueue)->handle;
+
+  // convert loader handles to platform handles
+  auto phEventWaitListLocal =
+      std::vector<ur_event_handle_t>(numEventsInWaitList);
+  for (size_t i = 0; i < numEventsInWaitList; ++i)
+    phEventWaitListLocal[i] =
+        reinterpret_cast<ur_event_object_t *>(phEventWaitList[i])->handle;
+
+  // convert loader handles in the commands to platform handles
+  auto pCommandsLocal =
+      std::vector<ur_exp_batch_command_t>(pCommands, pCommands + numCommands);
+  for (auto &command : pCommandsLocal)
+    if (UR_EXP_BATCH_COMMAND_TYPE_KERNEL_LAUNCH == command.type)
+      command.args.kernelLaunch.hKernel =
+          reinterpret_cast<ur_kernel_object_t *>(
+              command.args.kernelLaunch.hKernel)
+              ->handle;
+  pCommands = pCommandsLocal.data();
+
+  // forward to device-platform, or to the loader's implementation if it
+  // doesn't provide one
+  if (nullptr == pfnBatchExp)
+    result = ur::batch::enqueueByCommand(
+        ur::batch::getEnqueueFns(dditable->ur), hQueue, numCommands, pCommands,
+        numEventsInWaitList, phEventWaitListLocal.data(), phEvent);
+  else
+    result = pfnBatchExp(hQueue, numCommands, pCommands, numEventsInWaitList,
+                         phEventWaitListLocal.data(), phEvent);
+
+  // In the event of ERROR_ADAPTER_SPECIFIC we should still attempt to wrap any
+  // output handles below.
+  if (UR_RESULT_SUCCESS != result && UR_RESULT_ERROR_ADAPTER_SPECIFIC != result)
+    return result;
+  try {
+    // convert platform handle to loader handle
+    if (nullptr != phEvent)
+      *phEvent = reinterpret_cast<ur_event_handle_t>(
+          context->factories.ur_event_factory.getInstance(*phEvent, dditable));
+  } catch (std::bad_alloc &) {
+    result = UR_RESULT_ERROR_OUT_OF_HOST_MEMORY;
+  }
+
+  return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief urEnqueueBatchExp for adapters that don't provide it, when the
+///        platform's DDI tables are returned directly
+__urdlllocal ur_result_t UR_APICALL urEnqueueBatchExpFallback(
+    /// [in] handle of the queue object
+    ur_queue_handle_t hQueue,
+    /// [in] number of commands in the batch
+    uint32_t numCommands,
+    /// [in][range(0, numCommands)] pointer to the commands of the batch
+    const ur_exp_batch_command_t *pCommands,
+    /// [in] size of the event wait list
+    uint32_t numEventsInWaitList,
+    /// [in][optional][range(0, numEventsInWaitList)] pointer to a list of
+    /// events that must be complete before the commands of the batch are
+    /// executed.
+    /// If nullptr, the numEventsInWaitList must be 0, indicating no wait
+    /// events.
+    const ur_event_handle_t *phEventWaitList,
+    /// [out][optional] return an event object that identifies the execution
+    /// of the whole batch.
+    /// If phEventWaitList and phEvent are not NULL, phEvent must not refer to
+    /// an element of the phEventWaitList array.
+    ur_event_handle_t *phEvent) {
+  auto &dditable = getContext()->platforms.front().dditable;
+  return ur::batch::enqueueByCommand(
+      ur::batch::getEnqueueFns(dditable.ur), hQueue, numCommands, pCommands,
+      numEventsInWaitList, phEventWaitList, phEvent);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Intercept function for urEnqueueHostTaskExp
+__urdlllocal ur_result_t UR_APICALL urEnqueueHostTaskExp(
+    /// [in] handle of the queue object
+    ur_queue_handle_t hQueue,
+    /// [in] function to be executed on the host
+    ur_exp_host_task_function_t pfnHostTask,
+    /// [in][optional] data passed to pfnHostTask
+    void *pUserData,
+    /// [in] size of the event wait list
+    uint32_t numEventsInWaitList,
+    /// [in][optional][range(0, numEventsInWaitList)] pointer to a list of
+    /// events that must be complete before pfnHostTask is called.
+    /// If nullptr, the numEventsInWaitList must be 0, indicating no wait
+    /// events.
+    const ur_event_handle_t *phEventWaitList,
+    /// [out][optional] return an event object that identifies the execution
+    /// of the host task.
+    /// If phEventWaitList and phEvent are not NULL, phEvent must not refer to
+    /// an element of the phEventWaitList array.
+    ur_event_handle_t *phEvent) {
+  ur_result_t result = UR_RESULT_SUCCESS;
+
+  [[maybe_unused]] auto context = getContext();
+
+  // extract platform's function pointer table
+  auto dditable = reinterpret_cast<ur_queue_object_t *>(hQueue)->dditable;
+  auto pfnHostTaskExp = dditable->ur.EnqueueExp.pfnHostTaskExp;
+
+  // convert loader handle to platform handle
+  hQueue = reinterpret_cast<ur_queue_object_t *>(hQueue)->handle;
+
+  // convert loader handles to platform handles
+  auto phEventWaitListLocal =
+      std::vector<ur_event_handle_t>(numEventsInWaitList);
+  for (size_t i = 0; i < numEventsInWaitList; ++i)
+    phEventWaitListLocal[i] =
+        reinterpret_cast<ur_event_object_t *>(phEventWaitList[i])->handle;
+
+  // forward to device-platform, or to the loader's implementation if it
+  // doesn't provide one
+  if (nullptr == pfnHostTaskExp)
+    result = ur::host_task::enqueueAndWait(
+        ur::host_task::getEnqueueFns(dditable->ur), hQueue, pfnHostTask,
+        pUserData, numEventsInWaitList, phEventWaitListLocal.data(), phEvent);
+  else
+    result = pfnHostTaskExp(hQueue, pfnHostTask, pUserData,
+                            numEventsInWaitList, phEventWaitListLocal.data(),
+                            phEvent);
+
+  // In the event of ERROR_ADAPTER_SPECIFIC we should still attempt to wrap any
+  // output handles below.
+  if (UR_RESULT_SUCCESS != result && UR_RESULT_ERROR_ADAPTER_SPECIFIC != result)
+    return result;
+  try {
+    // convert platform handle to loader handle
+    if (nullptr != phEvent)
+      *phEvent = reinterpret_cast<ur_event_handle_t>(
+          context->factories.ur_event_factory.getInstance(*phEvent, dditable));
+  } catch (std::bad_alloc &) {
+    result = UR_RESULT_ERROR_OUT_OF_HOST_MEMORY;
+  }
+
+  return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief urEnqueueHostTaskExp for adapters that don't provide it, when the
+///        platform's DDI tables are returned directly
+__urdlllocal ur_result_t UR_APICALL urEnqueueHostTaskExpFallback(
+    /// [in] handle of the queue object
+    ur_queue_handle_t hQueue,
+    /// [in] function to be executed on the host
+    ur_exp_host_task_function_t pfnHostTask,
+    /// [in][optional] data passed to pfnHostTask
+    void *pUserData,
+    /// [in] size of the event wait list
+    uint32_t numEventsInWaitList,
+    /// [in][optional][range(0, numEventsInWaitList)] pointer to a list of
+    /// events that must be complete before pfnHostTask is called.
+    /// If nullptr, the numEventsInWaitList must be 0, indicating no wait
+    /// events.
+    const ur_event_handle_t *phEventWaitList,
+    /// [out][optional] return an event object that identifies the execution
+    /// of the host task.
+    /// If phEventWaitList and phEvent are not NULL, phEvent must not refer to
+    /// an element of the phEventWaitList array.
+    ur_event_handle_t *phEvent) {
+  auto &dditable = getContext()->platforms.front().dditable;
+  return ur::host_task::enqueueAndWait(
+      ur::host_task::getEnqueueFns(dditable.ur), hQueue, pfnHostTask,
+      pUserData, numEventsInWaitList, phEventWaitList, phEvent);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Intercept function for urEnqueueUSMAllocExp
+__urdlllocal ur_result_t UR_APICALL urEnqueueUSMAllocExp(
+    /// [in] handle of the queue object
+    ur_queue_handle_t hQueue,
+    /// [in][optional] USM memory allocation descriptor, of which only the
+    /// alignment is used
+    const ur_usm_desc_t *pUSMDesc,
+    /// [in] minimum size in bytes of the USM memory object to be allocated
+    size_t size,
+    /// [in] size of the event wait list
+    uint32_t numEventsInWaitList,
+    /// [in][optional][range(0, numEventsInWaitList)] pointer to a list of
+    /// events that must be complete before the allocation can be used.
+    /// If nullptr, the numEventsInWaitList must be 0, indicating no wait
+    /// events.
+    const ur_event_handle_t *phEventWaitList,
+    /// [out] pointer to USM device memory object
+    void **ppMem,
+    /// [out][optional] return an event object that identifies this particular
+    /// command instance.
+    /// If phEventWaitList and phEvent are not NULL, phEvent must not refer to
+    /// an element of the phEventWaitList array.
+    ur_event_handle_t *phEvent) {
+  ur_result_t result = UR_RESULT_SUCCESS;
+
+  [[maybe_unused]] auto context = getContext();
+
+  // extract platform's function pointer table
+  auto dditable = reinterpret_cast<ur_queue_object_t *>(hQueue)->dditable;
+  auto pfnUSMAllocExp = dditable->ur.EnqueueExp.pfnUSMAllocExp;
+  if (nullptr == pfnUSMAllocExp)
+    return UR_RESULT_ERROR_UNINITIALIZED;
+
+  // convert loader handle to platform handle
+  hQueue = reinterpret_cast<ur_queue_object_t *>(hQueue)->handle;
+
+  // convert loader handles to platform handles
+  auto phEventWaitListLocal =
+      std::vector<ur_event_handle_t>(numEventsInWaitList);
+  for (size_t i = 0; i < numEventsInWaitList; ++i)
+    phEventWaitListLocal[i] =
+        reinterpret_cast<ur_event_object_t *>(phEventWaitList[i])->handle;
+
+  // forward to device-platform
+  result = pfnUSMAllocExp(hQueue, pUSMDesc, size, numEventsInWaitList,
+                          phEventWaitListLocal.data(), ppMem, phEvent);
+
+  // In the event of ERROR_ADAPTER_SPECIFIC we should still attempt to wrap any
+  // output handles below.
+  if (UR_RESULT_SUCCESS != result && UR_RESULT_ERROR_ADAPTER_SPECIFIC != result)
+    return result;
+  try {
+    // convert platform handle to loader handle
+    if (nullptr != phEvent)
+      *phEvent = reinterpret_cast<ur_event_handle_t>(
+          context->factories.ur_event_factory.getInstance(*phEvent, dditable));
+  } catch (std::bad_alloc &) {
+    result = UR_RESULT_ERROR_OUT_OF_HOST_MEMORY;
+  }
+
+  return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Intercept function for urEnqueueUSMFreeExp
+__urdlllocal ur_result_t UR_APICALL urEnqueueUSMFreeExp(
+    /// [in] handle of the queue object
+    ur_queue_handle_t hQueue,
+    /// [in] pointer to USM memory object allocated by ::urEnqueueUSMAllocExp
+    void *pMem,
+    /// [in] size of the event wait list
+    uint32_t numEventsInWaitList,
+    /// [in][optional][range(0, numEventsInWaitList)] pointer to a list of
+    /// events that must be complete before the memory is released.
+    /// If nullptr, the numEventsInWaitList must be 0, indicating no wait
+    /// events.
+    const ur_event_handle_t *phEventWaitList,
+    /// [out][optional] return an event object that identifies this particular
+    /// command instance.
+    /// If phEventWaitList and phEvent are not NULL, phEvent must not refer to
+    /// an element of the phEventWaitList array.
+    ur_event_handle_t *phEvent) {
+  ur_result_t result = UR_RESULT_SUCCESS;
+
+  [[maybe_unused]] auto context = getContext();
+
+  // extract platform's function pointer table
+  auto dditable = reinterpret_cast<ur_queue_object_t *>(hQueue)->dditable;
+  auto pfnUSMFreeExp = dditable->ur.EnqueueExp.pfnUSMFreeExp;
+  if (nullptr == pfnUSMFreeExp)
+    return UR_RESULT_ERROR_UNINITIALIZED;
+
+  // convert loader handle to platform handle
+  hQueue = reinterpret_cast<ur_queue_object_t *>(hQueue)->handle;
+
+  // convert loader handles to platform handles
+  auto phEventWaitListLocal =
+      std::vector<ur_event_handle_t>(numEventsInWaitList);
+  for (size_t i = 0; i < numEventsInWaitList; ++i)
+    phEventWaitListLocal[i] =
+        reinterpret_cast<ur_event_object_t *>(phEventWaitList[i])->handle;
+
+  // forward to device-platform
+  result = pfnUSMFreeExp(hQueue, pMem, numEventsInWaitList,
+                         phEventWaitListLocal.data(), phEvent);
+
+  // In the event of ERROR_ADAPTER_SPECIFIC we should still attempt to wrap any
+  // output handles below.
+  if (UR_RESULT_SUCCESS != result && UR_RESULT_ERROR_ADAPTER_SPECIFIC != result)
+    return result;
+  try {
+    // convert platform handle to loader handle
+    if (nullptr != phEvent)
+      *phEvent = reinterpret_cast<ur_event_handle_t>(
+          context->factories.ur_event_factory.getInstance(*phEvent, dditable));
+  } catch (std::bad_alloc &) {
+    result = UR_RESULT_ERROR_OUT_OF_HOST_MEMORY;
+  }
+
+  return result;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// @brief Intercept function for urEnqueueEventsWaitWithBarrierExt
 __urdlllocal ur_result_t UR_APICALL urEnqueueEventsWaitWithBarrierExt(
@@ -9687,6 +10015,10 @@ UR_DLLEXPORT ur_result_t UR_APICALL urGetEnqueueExpProcAddrTable(
       // return pointers to loader's DDIs
       pDdiTable->pfnKernelLaunchCustomExp =
           ur_loader::urEnqueueKernelLaunchCustomExp;
+      pDdiTable->pfnBatchExp = ur_loader::urEnqueueBatchExp;
+      pDdiTable->pfnHostTaskExp = ur_loader::urEnqueueHostTaskExp;
+      pDdiTable->pfnUSMAllocExp = ur_loader::urEnqueueUSMAllocExp;
+      pDdiTable->pfnUSMFreeExp = ur_loader::urEnqueueUSMFreeExp;
       pDdiTable->pfnCooperativeKernelLaunchExp =
           ur_loader::urEnqueueCooperativeKernelLaunchExp;
       pDdiTable->pfnTimestampRecordingExp =
@@ -9696,6 +10028,10 @@ UR_DLLEXPORT ur_result_t UR_APICALL urGetEnqueueExpProcAddrTable(
       // return pointers directly to platform's DDIs
       *pDdiTable =
           ur_loader::getContext()->platforms.front().dditable.ur.EnqueueExp;
+      if (nullptr == pDdiTable->pfnBatchExp)
+        pDdiTable->pfnBatchExp = ur_loader::urEnqueueBatchExpFallback;
+      if (nullptr == pDdiTable->pfnHostTaskExp)
+        pDdiTable->pfnHostTaskExp = ur_loader::urEnqueueHostTaskExpFallback;
     }
   }
 
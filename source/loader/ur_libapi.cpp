@@ -12,6 +12,7 @@
  * @brief C++ library for ur
  *
  */
+#include "latency_tracker.hpp"
 #include "ur_lib.hpp"
 
 extern "C" {
@@ -444,7 +445,7 @@ ur_result_t UR_APICALL urAdapterGetLastError(
 ///     - ::UR_RESULT_ERROR_INVALID_NULL_HANDLE
 ///         + `NULL == hAdapter`
 ///     - ::UR_RESULT_ERROR_INVALID_ENUMERATION
-///         + `::UR_ADAPTER_INFO_VERSION < propName`
+///         + `::UR_ADAPTER_INFO_LATENCY_HISTOGRAM_EXP < propName`
 ///     - ::UR_RESULT_ERROR_UNSUPPORTED_ENUMERATION
 ///         + If `propName` is not supported by the adapter.
 ///     - ::UR_RESULT_ERROR_INVALID_SIZE
@@ -3025,8 +3026,9 @@ ur_result_t UR_APICALL urPhysicalMemGetInfo(
 ///     - ::UR_RESULT_ERROR_INVALID_NULL_HANDLE
 ///         + `NULL == hContext`
 ///     - ::UR_RESULT_ERROR_INVALID_NULL_POINTER
-///         + `NULL == pIL`
 ///         + `NULL == phProgram`
+///         + `NULL == pIL && NULL ==
+///         find_stype_node<ur_exp_program_file_source_t>(pProperties)`
 ///         + `NULL != pProperties && pProperties->count > 0 && NULL ==
 ///         pProperties->pMetadatas`
 ///     - ::UR_RESULT_ERROR_INVALID_SIZE
@@ -3041,7 +3043,8 @@ ur_result_t UR_APICALL urPhysicalMemGetInfo(
 ur_result_t UR_APICALL urProgramCreateWithIL(
     /// [in] handle of the context instance
     ur_context_handle_t hContext,
-    /// [in] pointer to IL binary.
+    /// [in][optional] pointer to IL binary. May only be NULL if the IL is
+    /// given by a ::ur_exp_program_file_source_t chained to `pProperties`.
     const void *pIL,
     /// [in] length of `pIL` in bytes.
     size_t length,
@@ -3088,8 +3091,9 @@ ur_result_t UR_APICALL urProgramCreateWithIL(
 ///     - ::UR_RESULT_ERROR_INVALID_NULL_POINTER
 ///         + `NULL == phDevices`
 ///         + `NULL == pLengths`
-///         + `NULL == ppBinaries`
 ///         + `NULL == phProgram`
+///         + `NULL == ppBinaries && NULL ==
+///         find_stype_node<ur_exp_program_file_source_t>(pProperties)`
 ///         + `NULL != pProperties && pProperties->count > 0 && NULL ==
 ///         pProperties->pMetadatas`
 ///     - ::UR_RESULT_ERROR_INVALID_SIZE
@@ -3110,8 +3114,10 @@ ur_result_t UR_APICALL urProgramCreateWithBinary(
     /// [in][range(0, numDevices)] array of sizes of program binaries
     /// specified by `pBinaries` (in bytes).
     size_t *pLengths,
-    /// [in][range(0, numDevices)] pointer to program binaries to be loaded
-    /// for devices specified by `phDevices`.
+    /// [in][optional][range(0, numDevices)] pointer to program binaries to be
+    /// loaded for devices specified by `phDevices`. May only be NULL if the
+    /// binaries are given by a ::ur_exp_program_file_source_t chained to
+    /// `pProperties`.
     const uint8_t **ppBinaries,
     /// [in][optional] pointer to program creation properties.
     const ur_program_properties_t *pProperties,
@@ -5041,6 +5047,7 @@ ur_result_t UR_APICALL urEnqueueKernelLaunch(
     /// kernel execution instance. If phEventWaitList and phEvent are not
     /// NULL, phEvent must not refer to an element of the phEventWaitList array.
     ur_event_handle_t *phEvent) try {
+  TRACK_SCOPE_LATENCY("urEnqueueKernelLaunch");
   auto pfnKernelLaunch =
       ur_lib::getContext()->urDdiTable.Enqueue.pfnKernelLaunch;
   if (nullptr == pfnKernelLaunch)
@@ -5099,6 +5106,7 @@ ur_result_t UR_APICALL urEnqueueEventsWait(
     /// command instance. If phEventWaitList and phEvent are not NULL, phEvent
     /// must not refer to an element of the phEventWaitList array.
     ur_event_handle_t *phEvent) try {
+  TRACK_SCOPE_LATENCY("urEnqueueEventsWait");
   auto pfnEventsWait = ur_lib::getContext()->urDdiTable.Enqueue.pfnEventsWait;
   if (nullptr == pfnEventsWait)
     return UR_RESULT_ERROR_UNINITIALIZED;
@@ -5156,6 +5164,7 @@ ur_result_t UR_APICALL urEnqueueEventsWaitWithBarrier(
     /// command instance. If phEventWaitList and phEvent are not NULL, phEvent
     /// must not refer to an element of the phEventWaitList array.
     ur_event_handle_t *phEvent) try {
+  TRACK_SCOPE_LATENCY("urEnqueueEventsWaitWithBarrier");
   auto pfnEventsWaitWithBarrier =
       ur_lib::getContext()->urDdiTable.Enqueue.pfnEventsWaitWithBarrier;
   if (nullptr == pfnEventsWaitWithBarrier)
@@ -5225,6 +5234,7 @@ ur_result_t UR_APICALL urEnqueueMemBufferRead(
     /// command instance. If phEventWaitList and phEvent are not NULL, phEvent
     /// must not refer to an element of the phEventWaitList array.
     ur_event_handle_t *phEvent) try {
+  TRACK_SCOPE_LATENCY("urEnqueueMemBufferRead");
   auto pfnMemBufferRead =
       ur_lib::getContext()->urDdiTable.Enqueue.pfnMemBufferRead;
   if (nullptr == pfnMemBufferRead)
@@ -5294,6 +5304,7 @@ ur_result_t UR_APICALL urEnqueueMemBufferWrite(
     /// command instance. If phEventWaitList and phEvent are not NULL, phEvent
     /// must not refer to an element of the phEventWaitList array.
     ur_event_handle_t *phEvent) try {
+  TRACK_SCOPE_LATENCY("urEnqueueMemBufferWrite");
   auto pfnMemBufferWrite =
       ur_lib::getContext()->urDdiTable.Enqueue.pfnMemBufferWrite;
   if (nullptr == pfnMemBufferWrite)
@@ -5390,6 +5401,7 @@ ur_result_t UR_APICALL urEnqueueMemBufferReadRect(
     /// command instance. If phEventWaitList and phEvent are not NULL, phEvent
     /// must not refer to an element of the phEventWaitList array.
     ur_event_handle_t *phEvent) try {
+  TRACK_SCOPE_LATENCY("urEnqueueMemBufferReadRect");
   auto pfnMemBufferReadRect =
       ur_lib::getContext()->urDdiTable.Enqueue.pfnMemBufferReadRect;
   if (nullptr == pfnMemBufferReadRect)
@@ -5489,6 +5501,7 @@ ur_result_t UR_APICALL urEnqueueMemBufferWriteRect(
     /// command instance. If phEventWaitList and phEvent are not NULL, phEvent
     /// must not refer to an element of the phEventWaitList array.
     ur_event_handle_t *phEvent) try {
+  TRACK_SCOPE_LATENCY("urEnqueueMemBufferWriteRect");
   auto pfnMemBufferWriteRect =
       ur_lib::getContext()->urDdiTable.Enqueue.pfnMemBufferWriteRect;
   if (nullptr == pfnMemBufferWriteRect)
@@ -5556,6 +5569,7 @@ ur_result_t UR_APICALL urEnqueueMemBufferCopy(
     /// command instance. If phEventWaitList and phEvent are not NULL, phEvent
     /// must not refer to an element of the phEventWaitList array.
     ur_event_handle_t *phEvent) try {
+  TRACK_SCOPE_LATENCY("urEnqueueMemBufferCopy");
   auto pfnMemBufferCopy =
       ur_lib::getContext()->urDdiTable.Enqueue.pfnMemBufferCopy;
   if (nullptr == pfnMemBufferCopy)
@@ -5643,6 +5657,7 @@ ur_result_t UR_APICALL urEnqueueMemBufferCopyRect(
     /// command instance. If phEventWaitList and phEvent are not NULL, phEvent
     /// must not refer to an element of the phEventWaitList array.
     ur_event_handle_t *phEvent) try {
+  TRACK_SCOPE_LATENCY("urEnqueueMemBufferCopyRect");
   auto pfnMemBufferCopyRect =
       ur_lib::getContext()->urDdiTable.Enqueue.pfnMemBufferCopyRect;
   if (nullptr == pfnMemBufferCopyRect)
@@ -5716,6 +5731,7 @@ ur_result_t UR_APICALL urEnqueueMemBufferFill(
     /// command instance. If phEventWaitList and phEvent are not NULL, phEvent
     /// must not refer to an element of the phEventWaitList array.
     ur_event_handle_t *phEvent) try {
+  TRACK_SCOPE_LATENCY("urEnqueueMemBufferFill");
   auto pfnMemBufferFill =
       ur_lib::getContext()->urDdiTable.Enqueue.pfnMemBufferFill;
   if (nullptr == pfnMemBufferFill)
@@ -5791,6 +5807,7 @@ ur_result_t UR_APICALL urEnqueueMemImageRead(
     /// command instance. If phEventWaitList and phEvent are not NULL, phEvent
     /// must not refer to an element of the phEventWaitList array.
     ur_event_handle_t *phEvent) try {
+  TRACK_SCOPE_LATENCY("urEnqueueMemImageRead");
   auto pfnMemImageRead =
       ur_lib::getContext()->urDdiTable.Enqueue.pfnMemImageRead;
   if (nullptr == pfnMemImageRead)
@@ -5867,6 +5884,7 @@ ur_result_t UR_APICALL urEnqueueMemImageWrite(
     /// command instance. If phEventWaitList and phEvent are not NULL, phEvent
     /// must not refer to an element of the phEventWaitList array.
     ur_event_handle_t *phEvent) try {
+  TRACK_SCOPE_LATENCY("urEnqueueMemImageWrite");
   auto pfnMemImageWrite =
       ur_lib::getContext()->urDdiTable.Enqueue.pfnMemImageWrite;
   if (nullptr == pfnMemImageWrite)
@@ -5935,6 +5953,7 @@ ur_result_t UR_APICALL urEnqueueMemImageCopy(
     /// command instance. If phEventWaitList and phEvent are not NULL, phEvent
     /// must not refer to an element of the phEventWaitList array.
     ur_event_handle_t *phEvent) try {
+  TRACK_SCOPE_LATENCY("urEnqueueMemImageCopy");
   auto pfnMemImageCopy =
       ur_lib::getContext()->urDdiTable.Enqueue.pfnMemImageCopy;
   if (nullptr == pfnMemImageCopy)
@@ -6011,6 +6030,7 @@ ur_result_t UR_APICALL urEnqueueMemBufferMap(
     /// [out] return mapped pointer.  TODO: move it before
     /// numEventsInWaitList?
     void **ppRetMap) try {
+  TRACK_SCOPE_LATENCY("urEnqueueMemBufferMap");
   auto pfnMemBufferMap =
       ur_lib::getContext()->urDdiTable.Enqueue.pfnMemBufferMap;
   if (nullptr == pfnMemBufferMap)
@@ -6070,6 +6090,7 @@ ur_result_t UR_APICALL urEnqueueMemUnmap(
     /// command instance. If phEventWaitList and phEvent are not NULL, phEvent
     /// must not refer to an element of the phEventWaitList array.
     ur_event_handle_t *phEvent) try {
+  TRACK_SCOPE_LATENCY("urEnqueueMemUnmap");
   auto pfnMemUnmap = ur_lib::getContext()->urDdiTable.Enqueue.pfnMemUnmap;
   if (nullptr == pfnMemUnmap)
     return UR_RESULT_ERROR_UNINITIALIZED;
@@ -6132,6 +6153,7 @@ ur_result_t UR_APICALL urEnqueueUSMFill(
     /// command instance. If phEventWaitList and phEvent are not NULL, phEvent
     /// must not refer to an element of the phEventWaitList array.
     ur_event_handle_t *phEvent) try {
+  TRACK_SCOPE_LATENCY("urEnqueueUSMFill");
   auto pfnUSMFill = ur_lib::getContext()->urDdiTable.Enqueue.pfnUSMFill;
   if (nullptr == pfnUSMFill)
     return UR_RESULT_ERROR_UNINITIALIZED;
@@ -6191,6 +6213,7 @@ ur_result_t UR_APICALL urEnqueueUSMMemcpy(
     /// command instance. If phEventWaitList and phEvent are not NULL, phEvent
     /// must not refer to an element of the phEventWaitList array.
     ur_event_handle_t *phEvent) try {
+  TRACK_SCOPE_LATENCY("urEnqueueUSMMemcpy");
   auto pfnUSMMemcpy = ur_lib::getContext()->urDdiTable.Enqueue.pfnUSMMemcpy;
   if (nullptr == pfnUSMMemcpy)
     return UR_RESULT_ERROR_UNINITIALIZED;
@@ -6254,6 +6277,7 @@ ur_result_t UR_APICALL urEnqueueUSMPrefetch(
     /// command instance. If phEventWaitList and phEvent are not NULL, phEvent
     /// must not refer to an element of the phEventWaitList array.
     ur_event_handle_t *phEvent) try {
+  TRACK_SCOPE_LATENCY("urEnqueueUSMPrefetch");
   auto pfnUSMPrefetch = ur_lib::getContext()->urDdiTable.Enqueue.pfnUSMPrefetch;
   if (nullptr == pfnUSMPrefetch)
     return UR_RESULT_ERROR_UNINITIALIZED;
@@ -6304,6 +6328,7 @@ ur_result_t UR_APICALL urEnqueueUSMAdvise(
     /// [out][optional] return an event object that identifies this particular
     /// command instance.
     ur_event_handle_t *phEvent) try {
+  TRACK_SCOPE_LATENCY("urEnqueueUSMAdvise");
   auto pfnUSMAdvise = ur_lib::getContext()->urDdiTable.Enqueue.pfnUSMAdvise;
   if (nullptr == pfnUSMAdvise)
     return UR_RESULT_ERROR_UNINITIALIZED;
@@ -6374,6 +6399,7 @@ ur_result_t UR_APICALL urEnqueueUSMFill2D(
     /// kernel execution instance. If phEventWaitList and phEvent are not
     /// NULL, phEvent must not refer to an element of the phEventWaitList array.
     ur_event_handle_t *phEvent) try {
+  TRACK_SCOPE_LATENCY("urEnqueueUSMFill2D");
   auto pfnUSMFill2D = ur_lib::getContext()->urDdiTable.Enqueue.pfnUSMFill2D;
   if (nullptr == pfnUSMFill2D)
     return UR_RESULT_ERROR_UNINITIALIZED;
@@ -6446,6 +6472,7 @@ ur_result_t UR_APICALL urEnqueueUSMMemcpy2D(
     /// kernel execution instance. If phEventWaitList and phEvent are not
     /// NULL, phEvent must not refer to an element of the phEventWaitList array.
     ur_event_handle_t *phEvent) try {
+  TRACK_SCOPE_LATENCY("urEnqueueUSMMemcpy2D");
   auto pfnUSMMemcpy2D = ur_lib::getContext()->urDdiTable.Enqueue.pfnUSMMemcpy2D;
   if (nullptr == pfnUSMMemcpy2D)
     return UR_RESULT_ERROR_UNINITIALIZED;
@@ -6503,6 +6530,7 @@ ur_result_t UR_APICALL urEnqueueDeviceGlobalVariableWrite(
     /// kernel execution instance. If phEventWaitList and phEvent are not
     /// NULL, phEvent must not refer to an element of the phEventWaitList array.
     ur_event_handle_t *phEvent) try {
+  TRACK_SCOPE_LATENCY("urEnqueueDeviceGlobalVariableWrite");
   auto pfnDeviceGlobalVariableWrite =
       ur_lib::getContext()->urDdiTable.Enqueue.pfnDeviceGlobalVariableWrite;
   if (nullptr == pfnDeviceGlobalVariableWrite)
@@ -6562,6 +6590,7 @@ ur_result_t UR_APICALL urEnqueueDeviceGlobalVariableRead(
     /// kernel execution instance. If phEventWaitList and phEvent are not
     /// NULL, phEvent must not refer to an element of the phEventWaitList array.
     ur_event_handle_t *phEvent) try {
+  TRACK_SCOPE_LATENCY("urEnqueueDeviceGlobalVariableRead");
   auto pfnDeviceGlobalVariableRead =
       ur_lib::getContext()->urDdiTable.Enqueue.pfnDeviceGlobalVariableRead;
   if (nullptr == pfnDeviceGlobalVariableRead)
@@ -6622,6 +6651,7 @@ ur_result_t UR_APICALL urEnqueueReadHostPipe(
     /// complete. If phEventWaitList and phEvent are not NULL, phEvent must not
     /// refer to an element of the phEventWaitList array.
     ur_event_handle_t *phEvent) try {
+  TRACK_SCOPE_LATENCY("urEnqueueReadHostPipe");
   auto pfnReadHostPipe =
       ur_lib::getContext()->urDdiTable.Enqueue.pfnReadHostPipe;
   if (nullptr == pfnReadHostPipe)
@@ -6682,6 +6712,7 @@ ur_result_t UR_APICALL urEnqueueWriteHostPipe(
     /// complete. If phEventWaitList and phEvent are not NULL, phEvent must not
     /// refer to an element of the phEventWaitList array.
     ur_event_handle_t *phEvent) try {
+  TRACK_SCOPE_LATENCY("urEnqueueWriteHostPipe");
   auto pfnWriteHostPipe =
       ur_lib::getContext()->urDdiTable.Enqueue.pfnWriteHostPipe;
   if (nullptr == pfnWriteHostPipe)
@@ -9022,6 +9053,7 @@ ur_result_t UR_APICALL urEnqueueCooperativeKernelLaunchExp(
     /// kernel execution instance. If phEventWaitList and phEvent are not
     /// NULL, phEvent must not refer to an element of the phEventWaitList array.
     ur_event_handle_t *phEvent) try {
+  TRACK_SCOPE_LATENCY("urEnqueueCooperativeKernelLaunchExp");
   auto pfnCooperativeKernelLaunchExp =
       ur_lib::getContext()->urDdiTable.EnqueueExp.pfnCooperativeKernelLaunchExp;
   if (nullptr == pfnCooperativeKernelLaunchExp)
@@ -9119,6 +9151,7 @@ ur_result_t UR_APICALL urEnqueueTimestampRecordingExp(
     /// not NULL, phEvent must not refer to an element of the phEventWaitList
     /// array.
     ur_event_handle_t *phEvent) try {
+  TRACK_SCOPE_LATENCY("urEnqueueTimestampRecordingExp");
   auto pfnTimestampRecordingExp =
       ur_lib::getContext()->urDdiTable.EnqueueExp.pfnTimestampRecordingExp;
   if (nullptr == pfnTimestampRecordingExp)
@@ -9214,6 +9247,7 @@ ur_result_t UR_APICALL urEnqueueKernelLaunchCustomExp(
     /// NULL, phEvent must not refer to an element of the phEventWaitList
     /// array.
     ur_event_handle_t *phEvent) try {
+  TRACK_SCOPE_LATENCY("urEnqueueKernelLaunchCustomExp");
   auto pfnKernelLaunchCustomExp =
       ur_lib::getContext()->urDdiTable.EnqueueExp.pfnKernelLaunchCustomExp;
   if (nullptr == pfnKernelLaunchCustomExp)
@@ -9608,6 +9642,275 @@ ur_result_t UR_APICALL urUsmP2PPeerAccessGetInfoExp(
   return exceptionToResult(std::current_exception());
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Enqueue a batch of commands
+///
+/// @details
+///     - Enqueues the commands of pCommands in a single call, so that adapters
+///       can record them in one go, e.g. into a single native command list or
+///       task graph.
+///     - Each command waits for the events in phEventWaitList, for the commands
+///       of the batch listed in its pDepsInBatch and for the earlier barrier
+///       commands of the batch. A barrier command waits for all the earlier
+///       commands of the batch.
+///     - On in-order queues, the commands are executed in the order of
+///       pCommands.
+///     - phEvent completes once all the commands of the batch complete.
+///     - Adapters that don't implement this entry point are served by the
+///       loader, which enqueues the commands one by one.
+///
+/// @returns
+///     - ::UR_RESULT_SUCCESS
+///     - ::UR_RESULT_ERROR_UNINITIALIZED
+///     - ::UR_RESULT_ERROR_DEVICE_LOST
+///     - ::UR_RESULT_ERROR_ADAPTER_SPECIFIC
+///     - ::UR_RESULT_ERROR_INVALID_NULL_HANDLE
+///         + `NULL == hQueue`
+///     - ::UR_RESULT_ERROR_INVALID_NULL_POINTER
+///         + `NULL == pCommands`
+///     - ::UR_RESULT_ERROR_INVALID_SIZE
+///         + `numCommands == 0`
+///     - ::UR_RESULT_ERROR_INVALID_VALUE
+///         + An index in pDepsInBatch is not lower than the index of its
+///         command.
+///     - ::UR_RESULT_ERROR_INVALID_KERNEL
+///     - ::UR_RESULT_ERROR_INVALID_WORK_DIMENSION
+///     - ::UR_RESULT_ERROR_INVALID_EVENT_WAIT_LIST
+///         + `phEventWaitList == NULL && numEventsInWaitList > 0`
+///         + `phEventWaitList != NULL && numEventsInWaitList == 0`
+///         + If event objects in phEventWaitList are not valid events.
+///     - ::UR_RESULT_ERROR_IN_EVENT_LIST_EXEC_STATUS
+///         + An event in phEventWaitList has ::UR_EVENT_STATUS_ERROR
+///     - ::UR_RESULT_ERROR_OUT_OF_HOST_MEMORY
+///     - ::UR_RESULT_ERROR_OUT_OF_RESOURCES
+ur_result_t UR_APICALL urEnqueueBatchExp(
+    /// [in] handle of the queue object
+    ur_queue_handle_t hQueue,
+    /// [in] number of commands in the batch
+    uint32_t numCommands,
+    /// [in][range(0, numCommands)] pointer to the commands of the batch
+    const ur_exp_batch_command_t *pCommands,
+    /// [in] size of the event wait list
+    uint32_t numEventsInWaitList,
+    /// [in][optional][range(0, numEventsInWaitList)] pointer to a list of
+    /// events that must be complete before the commands of the batch are
+    /// executed.
+    /// If nullptr, the numEventsInWaitList must be 0, indicating no wait
+    /// events.
+    const ur_event_handle_t *phEventWaitList,
+    /// [out][optional] return an event object that identifies the execution
+    /// of the whole batch.
+    /// If phEventWaitList and phEvent are not NULL, phEvent must not refer to
+    /// an element of the phEventWaitList array.
+    ur_event_handle_t *phEvent) try {
+  TRACK_SCOPE_LATENCY("urEnqueueBatchExp");
+  auto pfnBatchExp = ur_lib::getContext()->urDdiTable.EnqueueExp.pfnBatchExp;
+  if (nullptr == pfnBatchExp)
+    return UR_RESULT_ERROR_UNINITIALIZED;
+
+  return pfnBatchExp(hQueue, numCommands, pCommands, numEventsInWaitList,
+                     phEventWaitList, phEvent);
+} catch (...) {
+  return exceptionToResult(std::current_exception());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Enqueue a function to be executed on the host
+///
+/// @details
+///     - pfnHostTask is called on a host thread once the events in
+///       phEventWaitList complete, and, on in-order queues, once the commands
+///       enqueued before it complete.
+///     - phEvent completes once pfnHostTask returns, and commands enqueued
+///       after it on in-order queues are executed after it returns.
+///     - pfnHostTask may be called before this function returns, and from a
+///       thread other than the calling one.
+///     - pfnHostTask must not enqueue commands to hQueue or wait for events of
+///       commands enqueued after it.
+///     - Adapters that don't implement this entry point are served by the
+///       loader, which waits for the dependencies of the host task and calls it
+///       before returning.
+///
+/// @returns
+///     - ::UR_RESULT_SUCCESS
+///     - ::UR_RESULT_ERROR_UNINITIALIZED
+///     - ::UR_RESULT_ERROR_DEVICE_LOST
+///     - ::UR_RESULT_ERROR_ADAPTER_SPECIFIC
+///     - ::UR_RESULT_ERROR_INVALID_NULL_HANDLE
+///         + `NULL == hQueue`
+///     - ::UR_RESULT_ERROR_INVALID_NULL_POINTER
+///         + `NULL == pfnHostTask`
+///     - ::UR_RESULT_ERROR_INVALID_EVENT_WAIT_LIST
+///         + `phEventWaitList == NULL && numEventsInWaitList > 0`
+///         + `phEventWaitList != NULL && numEventsInWaitList == 0`
+///         + If event objects in phEventWaitList are not valid events.
+///     - ::UR_RESULT_ERROR_IN_EVENT_LIST_EXEC_STATUS
+///         + An event in phEventWaitList has ::UR_EVENT_STATUS_ERROR
+///     - ::UR_RESULT_ERROR_OUT_OF_HOST_MEMORY
+///     - ::UR_RESULT_ERROR_OUT_OF_RESOURCES
+ur_result_t UR_APICALL urEnqueueHostTaskExp(
+    /// [in] handle of the queue object
+    ur_queue_handle_t hQueue,
+    /// [in] function to be executed on the host
+    ur_exp_host_task_function_t pfnHostTask,
+    /// [in][optional] data passed to pfnHostTask
+    void *pUserData,
+    /// [in] size of the event wait list
+    uint32_t numEventsInWaitList,
+    /// [in][optional][range(0, numEventsInWaitList)] pointer to a list of
+    /// events that must be complete before pfnHostTask is called.
+    /// If nullptr, the numEventsInWaitList must be 0, indicating no wait
+    /// events.
+    const ur_event_handle_t *phEventWaitList,
+    /// [out][optional] return an event object that identifies the execution
+    /// of the host task.
+    /// If phEventWaitList and phEvent are not NULL, phEvent must not refer to
+    /// an element of the phEventWaitList array.
+    ur_event_handle_t *phEvent) try {
+  TRACK_SCOPE_LATENCY("urEnqueueHostTaskExp");
+  auto pfnHostTaskExp =
+      ur_lib::getContext()->urDdiTable.EnqueueExp.pfnHostTaskExp;
+  if (nullptr == pfnHostTaskExp)
+    return UR_RESULT_ERROR_UNINITIALIZED;
+
+  return pfnHostTaskExp(hQueue, pfnHostTask, pUserData, numEventsInWaitList,
+                        phEventWaitList, phEvent);
+} catch (...) {
+  return exceptionToResult(std::current_exception());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Enqueue an allocation of USM device memory
+///
+/// @details
+///     - Allocates device memory on the device of hQueue, which can be used by
+///       the commands enqueued after this one on hQueue, or by commands that
+///       wait for phEvent.
+///     - The allocation is served from a memory arena owned by hQueue, and must
+///       be freed with ::urEnqueueUSMFreeExp on the same queue. It must not be
+///       freed with ::urUSMFree.
+///     - Memory freed with ::urEnqueueUSMFreeExp is reused by later allocations
+///       on hQueue once the free completes, or right away on in-order queues.
+///     - Any memory still allocated from the arena is released together with
+///       hQueue.
+///
+/// @returns
+///     - ::UR_RESULT_SUCCESS
+///     - ::UR_RESULT_ERROR_UNINITIALIZED
+///     - ::UR_RESULT_ERROR_DEVICE_LOST
+///     - ::UR_RESULT_ERROR_ADAPTER_SPECIFIC
+///     - ::UR_RESULT_ERROR_INVALID_NULL_HANDLE
+///         + `NULL == hQueue`
+///     - ::UR_RESULT_ERROR_INVALID_ENUMERATION
+///         + `NULL != pUSMDesc && ::UR_USM_ADVICE_FLAGS_MASK & pUSMDesc->hints`
+///     - ::UR_RESULT_ERROR_INVALID_NULL_POINTER
+///         + `NULL == ppMem`
+///     - ::UR_RESULT_ERROR_INVALID_VALUE
+///         + `pUSMDesc && pUSMDesc->align != 0 && ((pUSMDesc->align &
+///         (pUSMDesc->align-1)) != 0)`
+///     - ::UR_RESULT_ERROR_INVALID_USM_SIZE
+///         + `size == 0`
+///         + `size` is greater than ::UR_DEVICE_INFO_MAX_MEM_ALLOC_SIZE.
+///     - ::UR_RESULT_ERROR_INVALID_EVENT_WAIT_LIST
+///         + `phEventWaitList == NULL && numEventsInWaitList > 0`
+///         + `phEventWaitList != NULL && numEventsInWaitList == 0`
+///         + If event objects in phEventWaitList are not valid events.
+///     - ::UR_RESULT_ERROR_IN_EVENT_LIST_EXEC_STATUS
+///         + An event in phEventWaitList has ::UR_EVENT_STATUS_ERROR
+///     - ::UR_RESULT_ERROR_OUT_OF_HOST_MEMORY
+///     - ::UR_RESULT_ERROR_OUT_OF_RESOURCES
+ur_result_t UR_APICALL urEnqueueUSMAllocExp(
+    /// [in] handle of the queue object
+    ur_queue_handle_t hQueue,
+    /// [in][optional] USM memory allocation descriptor, of which only the
+    /// alignment is used
+    const ur_usm_desc_t *pUSMDesc,
+    /// [in] minimum size in bytes of the USM memory object to be allocated
+    size_t size,
+    /// [in] size of the event wait list
+    uint32_t numEventsInWaitList,
+    /// [in][optional][range(0, numEventsInWaitList)] pointer to a list of
+    /// events that must be complete before the allocation can be used.
+    /// If nullptr, the numEventsInWaitList must be 0, indicating no wait
+    /// events.
+    const ur_event_handle_t *phEventWaitList,
+    /// [out] pointer to USM device memory object
+    void **ppMem,
+    /// [out][optional] return an event object that identifies this particular
+    /// command instance.
+    /// If phEventWaitList and phEvent are not NULL, phEvent must not refer to
+    /// an element of the phEventWaitList array.
+    ur_event_handle_t *phEvent) try {
+  TRACK_SCOPE_LATENCY("urEnqueueUSMAllocExp");
+  auto pfnUSMAllocExp =
+      ur_lib::getContext()->urDdiTable.EnqueueExp.pfnUSMAllocExp;
+  if (nullptr == pfnUSMAllocExp)
+    return UR_RESULT_ERROR_UNINITIALIZED;
+
+  return pfnUSMAllocExp(hQueue, pUSMDesc, size, numEventsInWaitList,
+                        phEventWaitList, ppMem, phEvent);
+} catch (...) {
+  return exceptionToResult(std::current_exception());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Enqueue the release of USM memory allocated by ::urEnqueueUSMAllocExp
+///
+/// @details
+///     - The memory is released once the events in phEventWaitList complete,
+///       and, on in-order queues, once the commands enqueued before this one
+///       complete.
+///     - pMem must have been returned by ::urEnqueueUSMAllocExp on hQueue, and
+///       must not be used by commands enqueued after this one.
+///
+/// @returns
+///     - ::UR_RESULT_SUCCESS
+///     - ::UR_RESULT_ERROR_UNINITIALIZED
+///     - ::UR_RESULT_ERROR_DEVICE_LOST
+///     - ::UR_RESULT_ERROR_ADAPTER_SPECIFIC
+///     - ::UR_RESULT_ERROR_INVALID_NULL_HANDLE
+///         + `NULL == hQueue`
+///     - ::UR_RESULT_ERROR_INVALID_NULL_POINTER
+///         + `NULL == pMem`
+///     - ::UR_RESULT_ERROR_INVALID_VALUE
+///         + pMem was not allocated by ::urEnqueueUSMAllocExp on hQueue.
+///     - ::UR_RESULT_ERROR_INVALID_EVENT_WAIT_LIST
+///         + `phEventWaitList == NULL && numEventsInWaitList > 0`
+///         + `phEventWaitList != NULL && numEventsInWaitList == 0`
+///         + If event objects in phEventWaitList are not valid events.
+///     - ::UR_RESULT_ERROR_IN_EVENT_LIST_EXEC_STATUS
+///         + An event in phEventWaitList has ::UR_EVENT_STATUS_ERROR
+///     - ::UR_RESULT_ERROR_OUT_OF_HOST_MEMORY
+///     - ::UR_RESULT_ERROR_OUT_OF_RESOURCES
+ur_result_t UR_APICALL urEnqueueUSMFreeExp(
+    /// [in] handle of the queue object
+    ur_queue_handle_t hQueue,
+    /// [in] pointer to USM memory object allocated by ::urEnqueueUSMAllocExp
+    void *pMem,
+    /// [in] size of the event wait list
+    uint32_t numEventsInWaitList,
+    /// [in][optional][range(0, numEventsInWaitList)] pointer to a list of
+    /// events that must be complete before the memory is released.
+    /// If nullptr, the numEventsInWaitList must be 0, indicating no wait
+    /// events.
+    const ur_event_handle_t *phEventWaitList,
+    /// [out][optional] return an event object that identifies this particular
+    /// command instance.
+    /// If phEventWaitList and phEvent are not NULL, phEvent must not refer to
+    /// an element of the phEventWaitList array.
+    ur_event_handle_t *phEvent) try {
+  TRACK_SCOPE_LATENCY("urEnqueueUSMFreeExp");
+  auto pfnUSMFreeExp =
+      ur_lib::getContext()->urDdiTable.EnqueueExp.pfnUSMFreeExp;
+  if (nullptr == pfnUSMFreeExp)
+    return UR_RESULT_ERROR_UNINITIALIZED;
+
+  return pfnUSMFreeExp(hQueue, pMem, numEventsInWaitList, phEventWaitList,
+                       phEvent);
+} catch (...) {
+  return exceptionToResult(std::current_exception());
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// @brief Enqueue a barrier command which waits a list of events to complete
 ///        before it completes, with optional extended properties
@@ -9661,6 +9964,7 @@ ur_result_t UR_APICALL urEnqueueEventsWaitWithBarrierExt(
     /// command instance. If phEventWaitList and phEvent are not NULL, phEvent
     /// must not refer to an element of the phEventWaitList array.
     ur_event_handle_t *phEvent) try {
+  TRACK_SCOPE_LATENCY("urEnqueueEventsWaitWithBarrierExt");
   auto pfnEventsWaitWithBarrierExt =
       ur_lib::getContext()->urDdiTable.Enqueue.pfnEventsWaitWithBarrierExt;
   if (nullptr == pfnEventsWaitWithBarrierExt)
@@ -9717,6 +10021,7 @@ ur_result_t UR_APICALL urEnqueueNativeCommandExp(
     /// not NULL, phEvent must not refer to an element of the phEventWaitList
     /// array.
     ur_event_handle_t *phEvent) try {
+  TRACK_SCOPE_LATENCY("urEnqueueNativeCommandExp");
   auto pfnNativeCommandExp =
       ur_lib::getContext()->urDdiTable.EnqueueExp.pfnNativeCommandExp;
   if (nullptr == pfnNativeCommandExp)
@@ -25,6 +25,7 @@
 
 #include <ur_api.h>
 
+#include "lock_profiler.hpp"
 #include "ur_util.hpp"
 
 template <class To, class From> To ur_cast(From Value) {
@@ -79,29 +80,81 @@ static const bool SingleThreadMode = [] {
 // Class which acts like shared_mutex if SingleThreadMode variable is not set.
 // If SingleThreadMode variable is set then mutex operations are turned into
 // nop.
+//
+// With UR_ENABLE_LOCK_PROFILING, contention of the mutex is profiled under its
+// name, or under the location it is constructed at if it has none.
 class ur_shared_mutex {
   std::shared_mutex Mutex;
+#if defined(UR_ENABLE_LOCK_PROFILING)
+  lock_site_profile Profile;
+#endif
 
 public:
+#if defined(UR_ENABLE_LOCK_PROFILING)
+  // The line comes first, so that a name is never taken for the file.
+  ur_shared_mutex(int Line = __builtin_LINE(),
+                  const char *File = __builtin_FILE())
+      : Profile(nullptr, File, Line) {}
+  explicit ur_shared_mutex(const char *Name, int Line = __builtin_LINE(),
+                           const char *File = __builtin_FILE())
+      : Profile(Name, File, Line) {}
+#else
+  ur_shared_mutex() {}
+  explicit ur_shared_mutex(const char * /*Name*/) {}
+#endif
+
   void lock() {
     if (!SingleThreadMode) {
+#if defined(UR_ENABLE_LOCK_PROFILING)
+      Profile.lock([this] { return Mutex.try_lock(); },
+                   [this] { Mutex.lock(); });
+#else
       Mutex.lock();
+#endif
+    }
+  }
+  bool try_lock() {
+    if (SingleThreadMode) {
+      return true;
     }
+    if (!Mutex.try_lock()) {
+      return false;
+    }
+#if defined(UR_ENABLE_LOCK_PROFILING)
+    Profile.locked();
+#endif
+    return true;
   }
-  bool try_lock() { return SingleThreadMode ? true : Mutex.try_lock(); }
   void unlock() {
     if (!SingleThreadMode) {
+#if defined(UR_ENABLE_LOCK_PROFILING)
+      Profile.unlocking();
+#endif
       Mutex.unlock();
     }
   }
 
   void lock_shared() {
     if (!SingleThreadMode) {
+#if defined(UR_ENABLE_LOCK_PROFILING)
+      Profile.lockShared([this] { return Mutex.try_lock_shared(); },
+                         [this] { Mutex.lock_shared(); });
+#else
       Mutex.lock_shared();
+#endif
     }
   }
   bool try_lock_shared() {
-    return SingleThreadMode ? true : Mutex.try_lock_shared();
+    if (SingleThreadMode) {
+      return true;
+    }
+    if (!Mutex.try_lock_shared()) {
+      return false;
+    }
+#if defined(UR_ENABLE_LOCK_PROFILING)
+    Profile.lockedShared();
+#endif
+    return true;
   }
   void unlock_shared() {
     if (!SingleThreadMode) {
@@ -113,33 +166,63 @@ public:
 // Class which acts like std::mutex if SingleThreadMode variable is not set.
 // If SingleThreadMode variable is set then mutex operations are turned into
 // nop.
+//
+// Profiled like ur_shared_mutex.
 class ur_mutex {
   std::mutex Mutex;
-  friend class ur_lock;
+#if defined(UR_ENABLE_LOCK_PROFILING)
+  lock_site_profile Profile;
+#endif
 
 public:
+#if defined(UR_ENABLE_LOCK_PROFILING)
+  ur_mutex(int Line = __builtin_LINE(), const char *File = __builtin_FILE())
+      : Profile(nullptr, File, Line) {}
+  explicit ur_mutex(const char *Name, int Line = __builtin_LINE(),
+                    const char *File = __builtin_FILE())
+      : Profile(Name, File, Line) {}
+#else
+  constexpr ur_mutex() {}
+  explicit constexpr ur_mutex(const char * /*Name*/) {}
+#endif
+
   void lock() {
     if (!SingleThreadMode) {
+#if defined(UR_ENABLE_LOCK_PROFILING)
+      Profile.lock([this] { return Mutex.try_lock(); },
+                   [this] { Mutex.lock(); });
+#else
       Mutex.lock();
+#endif
+    }
+  }
+  bool try_lock() {
+    if (SingleThreadMode) {
+      return true;
+    }
+    if (!Mutex.try_lock()) {
+      return false;
     }
+#if defined(UR_ENABLE_LOCK_PROFILING)
+    Profile.locked();
+#endif
+    return true;
   }
-  bool try_lock() { return SingleThreadMode ? true : Mutex.try_lock(); }
   void unlock() {
     if (!SingleThreadMode) {
+#if defined(UR_ENABLE_LOCK_PROFILING)
+      Profile.unlocking();
+#endif
       Mutex.unlock();
     }
   }
 };
 
 class ur_lock {
-  std::unique_lock<std::mutex> Lock;
+  std::unique_lock<ur_mutex> Lock;
 
 public:
-  explicit ur_lock(ur_mutex &Mutex) {
-    if (!SingleThreadMode) {
-      Lock = std::unique_lock<std::mutex>(Mutex.Mutex);
-    }
-  }
+  explicit ur_lock(ur_mutex &Mutex) : Lock(Mutex) {}
 };
 
 /// SpinLock is a synchronization primitive, that uses atomic variable and
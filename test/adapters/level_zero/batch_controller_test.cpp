@@ -0,0 +1,213 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "helpers/batch_controller.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+zeCommandListBatchConfig makeConfig(ur_batch_policy_t Policy) {
+  zeCommandListBatchConfig Config{};
+  Config.Policy = Policy;
+  return Config;
+}
+
+// Replays a synthetic trace in which the application synchronizes after each
+// of Intervals commands, the way a queue drives its controller. Each batch
+// completes Latency after its submission. Returns the batch size after every
+// synchronization.
+std::vector<uint32_t> replay(ur_batch_controller &Controller,
+                             const std::vector<uint32_t> &Intervals,
+                             std::chrono::nanoseconds Latency = 0ns) {
+  std::vector<uint32_t> Sizes;
+  for (uint32_t Interval : Intervals) {
+    uint32_t Open = 0;
+    for (uint32_t I = 0; I < Interval; I++) {
+      if (++Open >= Controller.size()) {
+        Controller.onFullBatch();
+        Controller.onBatchCompleted(Open, Latency);
+        Open = 0;
+      }
+    }
+    if (Open > 0) {
+      Controller.onPartialBatch(Open);
+      Controller.onBatchCompleted(Open, Latency);
+    }
+    Sizes.push_back(Controller.size());
+  }
+  return Sizes;
+}
+
+size_t countChanges(const std::vector<uint32_t> &Sizes) {
+  size_t Changes = 0;
+  for (size_t I = 1; I < Sizes.size(); I++) {
+    Changes += Sizes[I] != Sizes[I - 1];
+  }
+  return Changes;
+}
+
+} // namespace
+
+TEST(BatchControllerTest, ParsePolicy) {
+  ASSERT_EQ(parseBatchPolicy("threshold"), ur_batch_policy_t::Threshold);
+  ASSERT_EQ(parseBatchPolicy("aimd"), ur_batch_policy_t::Aimd);
+  ASSERT_EQ(parseBatchPolicy("AIMD"), std::nullopt);
+  ASSERT_EQ(parseBatchPolicy(""), std::nullopt);
+}
+
+TEST(BatchControllerTest, FixedSize) {
+  zeCommandListBatchConfig Config{};
+  Config.Size = 16;
+  auto Controller = makeBatchController(Config);
+  auto Sizes = replay(*Controller, std::vector<uint32_t>(100, 3));
+  ASSERT_EQ(Controller->size(), 16u);
+  ASSERT_EQ(countChanges(Sizes), 0u);
+  ASSERT_EQ(Controller->numTimesClosedEarly(), 100u);
+}
+
+TEST(BatchControllerTest, ThresholdRaisesAfterFullBatches) {
+  auto Controller =
+      makeBatchController(makeConfig(ur_batch_policy_t::Threshold));
+  ASSERT_EQ(Controller->size(), 4u);
+
+  // The size grows by one step after more than 8 full batches.
+  for (int I = 0; I < 8; I++) {
+    Controller->onFullBatch();
+  }
+  ASSERT_EQ(Controller->size(), 4u);
+  Controller->onFullBatch();
+  ASSERT_EQ(Controller->size(), 5u);
+}
+
+TEST(BatchControllerTest, ThresholdLowersAfterEarlyCloses) {
+  auto Controller =
+      makeBatchController(makeConfig(ur_batch_policy_t::Threshold));
+
+  // After more than 3 early closes without full ones, the size drops below
+  // the size of the last partial batch.
+  for (int I = 0; I < 3; I++) {
+    Controller->onPartialBatch(3);
+  }
+  ASSERT_EQ(Controller->size(), 4u);
+  Controller->onPartialBatch(3);
+  ASSERT_EQ(Controller->size(), 2u);
+
+  for (int I = 0; I < 4; I++) {
+    Controller->onPartialBatch(1);
+  }
+  ASSERT_EQ(Controller->size(), 1u);
+}
+
+TEST(BatchControllerTest, AimdIncreasesAdditively) {
+  auto Config = makeConfig(ur_batch_policy_t::Aimd);
+  auto Controller = makeBatchController(Config);
+  for (uint32_t I = 1; I <= 10; I++) {
+    Controller->onFullBatch();
+    ASSERT_EQ(Controller->size(), Config.DynamicSizeStart + I);
+  }
+
+  for (int I = 0; I < 100; I++) {
+    Controller->onFullBatch();
+  }
+  ASSERT_EQ(Controller->size(), Config.DynamicSizeMax);
+}
+
+TEST(BatchControllerTest, AimdDecreasesMultiplicatively) {
+  auto Config = makeConfig(ur_batch_policy_t::Aimd);
+  Config.DynamicSizeStart = 32;
+  auto Controller = makeBatchController(Config);
+
+  // Early closes with at least half of the size are tolerated.
+  Controller->onPartialBatch(16);
+  ASSERT_EQ(Controller->size(), 32u);
+
+  Controller->onPartialBatch(15);
+  ASSERT_EQ(Controller->size(), 16u);
+  Controller->onPartialBatch(1);
+  ASSERT_EQ(Controller->size(), 8u);
+}
+
+TEST(BatchControllerTest, AimdReactsToLatency) {
+  auto Config = makeConfig(ur_batch_policy_t::Aimd);
+  Config.DynamicSizeStart = 32;
+  Config.LatencyTarget = 100us;
+  auto Controller = makeBatchController(Config);
+
+  Controller->onBatchCompleted(32, 50us);
+  ASSERT_EQ(Controller->size(), 32u);
+
+  Controller->onBatchCompleted(32, 200us);
+  ASSERT_EQ(Controller->size(), 16u);
+
+  // Slow batches submitted before the decrease do not decrease the size
+  // again.
+  Controller->onBatchCompleted(32, 400us);
+  Controller->onBatchCompleted(32, 400us);
+  ASSERT_EQ(Controller->size(), 16u);
+
+  // The size does not grow while batches are slow on average.
+  Controller->onFullBatch();
+  ASSERT_EQ(Controller->size(), 16u);
+}
+
+TEST(BatchControllerTest, AimdGrowsWhileWithinLatencyTarget) {
+  auto Config = makeConfig(ur_batch_policy_t::Aimd);
+  Config.LatencyTarget = 100us;
+  auto Controller = makeBatchController(Config);
+
+  auto Sizes = replay(*Controller, std::vector<uint32_t>(20, 1000), 10us);
+  ASSERT_EQ(Sizes.back(), Config.DynamicSizeMax);
+}
+
+// A stream alternating between synchronizing after 20 and after 12 commands.
+TEST(BatchControllerTest, AimdSettlesOnAlternatingIntervals) {
+  std::vector<uint32_t> Trace;
+  for (int I = 0; I < 200; I++) {
+    Trace.push_back(I % 2 ? 12 : 20);
+  }
+
+  auto Controller = makeBatchController(makeConfig(ur_batch_policy_t::Aimd));
+  auto Sizes = replay(*Controller, Trace);
+
+  // The size stops growing just above the longest interval.
+  std::vector<uint32_t> SettledSizes(Sizes.begin() + 30, Sizes.end());
+  ASSERT_EQ(countChanges(SettledSizes), 0u);
+  ASSERT_EQ(SettledSizes.back(), 21u);
+}
+
+// Phases of short synchronization intervals, as with large kernels whose
+// results are read back immediately, alternating with streams of small
+// kernels.
+TEST(BatchControllerTest, AimdRecoversAfterShortIntervals) {
+  auto Config = makeConfig(ur_batch_policy_t::Aimd);
+  auto Aimd = makeBatchController(Config);
+  auto Threshold =
+      makeBatchController(makeConfig(ur_batch_policy_t::Threshold));
+
+  for (int Phase = 0; Phase < 5; Phase++) {
+    replay(*Threshold, std::vector<uint32_t>(20, 3));
+    auto Sizes = replay(*Aimd, std::vector<uint32_t>(20, 3));
+    ASSERT_LE(Sizes.back(), 2 * 3u);
+
+    replay(*Threshold, std::vector<uint32_t>(20, 500));
+    Sizes = replay(*Aimd, std::vector<uint32_t>(20, 500));
+    ASSERT_EQ(Sizes.back(), Config.DynamicSizeMax);
+  }
+
+  // The threshold heuristic stops raising the size after the first short
+  // phase, since early closes are only forgotten when lowering it, and
+  // submits many more batches.
+  auto submissions = [](const ur_batch_controller &Controller) {
+    return Controller.numTimesClosedFull() + Controller.numTimesClosedEarly();
+  };
+  ASSERT_LT(submissions(*Aimd) * 10, submissions(*Threshold));
+}
@@ -0,0 +1,213 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "helpers/event_slot_allocator.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <set>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Hands out fake event pool handles, counting them.
+struct FakePools {
+  ur_event_slot_allocator::create_pool_t creator() {
+    return [this](uint32_t NumSlots, ze_event_pool_handle_t &Pool) {
+      if (Fail)
+        return UR_RESULT_ERROR_OUT_OF_DEVICE_MEMORY;
+      Pool = reinterpret_cast<ze_event_pool_handle_t>(++NumCreated);
+      std::ignore = NumSlots;
+      return UR_RESULT_SUCCESS;
+    };
+  }
+
+  std::atomic<uintptr_t> NumCreated{0};
+  std::atomic<bool> Fail{false};
+};
+
+using slot_key_t = std::pair<ze_event_pool_handle_t, uint32_t>;
+
+slot_key_t key(const ur_event_slot_t &Slot) {
+  return {Slot.ZeEventPool, Slot.Index};
+}
+
+} // namespace
+
+TEST(EventSlotAllocatorTest, FillsPoolBeforeCreatingAnother) {
+  FakePools Pools;
+  ur_event_slot_allocator Allocator(100, 0, Pools.creator());
+
+  std::set<slot_key_t> Slots;
+  for (int I = 0; I < 100; I++) {
+    ur_event_slot_t Slot;
+    ASSERT_EQ(Allocator.allocate(Slot), UR_RESULT_SUCCESS);
+    ASSERT_LT(Slot.Index, 100u);
+    ASSERT_TRUE(Slots.insert(key(Slot)).second);
+  }
+  ASSERT_EQ(Pools.NumCreated, 1u);
+  ASSERT_EQ(Allocator.getNumFreeSlots(), 0u);
+
+  ur_event_slot_t Slot;
+  ASSERT_EQ(Allocator.allocate(Slot), UR_RESULT_SUCCESS);
+  ASSERT_EQ(Pools.NumCreated, 2u);
+  ASSERT_EQ(Allocator.getNumPools(), 2u);
+  ASSERT_TRUE(Slots.insert(key(Slot)).second);
+}
+
+TEST(EventSlotAllocatorTest, ReleasedSlotsAreReused) {
+  FakePools Pools;
+  ur_event_slot_allocator Allocator(64, 0, Pools.creator());
+
+  std::vector<ur_event_slot_t> Slots(64);
+  for (auto &Slot : Slots) {
+    ASSERT_EQ(Allocator.allocate(Slot), UR_RESULT_SUCCESS);
+  }
+  ur_event_slot_allocator::release(Slots[10]);
+  ur_event_slot_allocator::release(Slots[42]);
+  ASSERT_EQ(Allocator.getNumFreeSlots(), 2u);
+
+  std::set<uint32_t> Reused;
+  for (int I = 0; I < 2; I++) {
+    ur_event_slot_t Slot;
+    ASSERT_EQ(Allocator.allocate(Slot), UR_RESULT_SUCCESS);
+    Reused.insert(Slot.Index);
+  }
+  ASSERT_EQ(Reused, (std::set<uint32_t>{10, 42}));
+  ASSERT_EQ(Pools.NumCreated, 1u);
+}
+
+TEST(EventSlotAllocatorTest, DoubleReleaseIsIgnored) {
+  FakePools Pools;
+  ur_event_slot_allocator Allocator(4, 0, Pools.creator());
+
+  ur_event_slot_t Slot;
+  ASSERT_EQ(Allocator.allocate(Slot), UR_RESULT_SUCCESS);
+  ur_event_slot_allocator::release(Slot);
+  ur_event_slot_allocator::release(Slot);
+  ASSERT_EQ(Allocator.getNumFreeSlots(), 4u);
+
+  // Slots that are not owned are ignored.
+  ur_event_slot_allocator::release(ur_event_slot_t{});
+}
+
+TEST(EventSlotAllocatorTest, PoolCreationFailure) {
+  FakePools Pools;
+  Pools.Fail = true;
+  ur_event_slot_allocator Allocator(4, 0, Pools.creator());
+
+  ur_event_slot_t Slot;
+  ASSERT_EQ(Allocator.allocate(Slot), UR_RESULT_ERROR_OUT_OF_DEVICE_MEMORY);
+  ASSERT_EQ(Allocator.getNumPools(), 0u);
+
+  Pools.Fail = false;
+  ASSERT_EQ(Allocator.allocate(Slot), UR_RESULT_SUCCESS);
+}
+
+TEST(EventSlotAllocatorTest, RefillsBelowWatermark) {
+  FakePools Pools;
+  ur_event_slot_allocator Allocator(64, 16, Pools.creator());
+
+  ur_event_slot_t Slot;
+  for (int I = 0; I < 48; I++) {
+    ASSERT_EQ(Allocator.allocate(Slot), UR_RESULT_SUCCESS);
+  }
+  Allocator.waitForRefill();
+  ASSERT_EQ(Allocator.getNumPools(), 1u);
+
+  // Dropping below 16 free slots creates the next pool in the background.
+  ASSERT_EQ(Allocator.allocate(Slot), UR_RESULT_SUCCESS);
+  Allocator.waitForRefill();
+  ASSERT_EQ(Allocator.getNumPools(), 2u);
+  ASSERT_EQ(Allocator.getNumFreeSlots(), 64u + 15u);
+
+  // The remaining slots of the first pool and the whole second pool are then
+  // allocated without creating another pool in the foreground.
+  for (int I = 0; I < 15 + 64 - 16; I++) {
+    ASSERT_EQ(Allocator.allocate(Slot), UR_RESULT_SUCCESS);
+  }
+  Allocator.waitForRefill();
+  ASSERT_EQ(Allocator.getNumPools(), 2u);
+  ASSERT_EQ(Allocator.allocate(Slot), UR_RESULT_SUCCESS);
+  Allocator.waitForRefill();
+  ASSERT_EQ(Allocator.getNumPools(), 3u);
+}
+
+TEST(EventSlotAllocatorTest, DestroyPools) {
+  FakePools Pools;
+  ur_event_slot_allocator Allocator(8, 2, Pools.creator());
+
+  ur_event_slot_t Slot;
+  for (int I = 0; I < 20; I++) {
+    ASSERT_EQ(Allocator.allocate(Slot), UR_RESULT_SUCCESS);
+  }
+
+  std::set<ze_event_pool_handle_t> Destroyed;
+  ASSERT_EQ(Allocator.destroyPools([&](ze_event_pool_handle_t Pool) {
+    Destroyed.insert(Pool);
+    return UR_RESULT_SUCCESS;
+  }),
+            UR_RESULT_SUCCESS);
+  ASSERT_EQ(Destroyed.size(), Pools.NumCreated.load());
+  ASSERT_EQ(Allocator.getNumPools(), 0u);
+  ASSERT_EQ(Allocator.getNumFreeSlots(), 0u);
+}
+
+TEST(EventSlotAllocatorTest, Threaded) {
+  static constexpr int NumThreads = 32;
+  static constexpr int NumIterations = 2000;
+  static constexpr int NumLive = 40;
+
+  FakePools Pools;
+  ur_event_slot_allocator Allocator(256, 64, Pools.creator());
+
+  // Every thread keeps NumLive slots and records which slots it holds, so
+  // that a slot handed to two threads at once is detected.
+  std::vector<std::atomic<int>> Owners(1 << 16);
+  std::atomic<bool> Failed{false};
+  auto slotId = [&](const ur_event_slot_t &Slot) {
+    return reinterpret_cast<uintptr_t>(Slot.ZeEventPool) * 256 + Slot.Index;
+  };
+
+  std::vector<std::thread> Threads;
+  for (int T = 0; T < NumThreads; T++) {
+    Threads.emplace_back([&, T] {
+      std::vector<ur_event_slot_t> Live;
+      for (int I = 0; I < NumIterations; I++) {
+        ur_event_slot_t Slot;
+        if (Allocator.allocate(Slot) != UR_RESULT_SUCCESS ||
+            Owners.at(slotId(Slot)).exchange(T + 1) != 0) {
+          Failed = true;
+          return;
+        }
+        Live.push_back(Slot);
+        if (Live.size() == NumLive) {
+          for (auto &LiveSlot : Live) {
+            Owners.at(slotId(LiveSlot)) = 0;
+            ur_event_slot_allocator::release(LiveSlot);
+          }
+          Live.clear();
+        }
+      }
+      for (auto &LiveSlot : Live) {
+        Owners.at(slotId(LiveSlot)) = 0;
+        ur_event_slot_allocator::release(LiveSlot);
+      }
+    });
+  }
+  for (auto &Thread : Threads) {
+    Thread.join();
+  }
+  Allocator.waitForRefill();
+
+  ASSERT_FALSE(Failed);
+  // At most NumThreads * NumLive slots were ever in use at once.
+  ASSERT_LE(Allocator.getNumPools(), (NumThreads * NumLive) / 256 + 2);
+  ASSERT_EQ(Allocator.getNumFreeSlots(), Allocator.getNumPools() * 256);
+}
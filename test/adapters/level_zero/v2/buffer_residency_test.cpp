@@ -0,0 +1,121 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "buffer_residency.hpp"
+
+#include <gtest/gtest.h>
+
+using location_t = v2::buffer_residency_t::location_t;
+
+namespace {
+
+bool anySource(location_t) { return true; }
+
+// Accesses the buffer at location the way ur_discrete_buffer_handle_t does,
+// returns the location migrated from, if any.
+std::optional<location_t> access(v2::buffer_residency_t &residency,
+                                 location_t location, bool write) {
+  auto source = residency.getMigrationSource(location, anySource);
+  residency.markAccessed(location, write);
+  return source;
+}
+
+} // namespace
+
+TEST(BufferResidency, UninitializedBufferIsNotMigrated) {
+  v2::buffer_residency_t residency(2);
+  ASSERT_FALSE(residency.hasValidCopy());
+
+  ASSERT_EQ(access(residency, 1, false), std::nullopt);
+  ASSERT_TRUE(residency.isValid(1));
+  ASSERT_EQ(residency.anyValidDevice(), location_t{1});
+
+  ASSERT_EQ(access(residency, 0, false), location_t{1});
+}
+
+TEST(BufferResidency, HostContentsAreMigratedOnFirstUse) {
+  v2::buffer_residency_t residency(2);
+  residency.markAccessed(residency.host(), true);
+  ASSERT_EQ(residency.anyValidDevice(), std::nullopt);
+
+  // Nothing is placed on the first device unless it is used.
+  ASSERT_EQ(access(residency, 1, false), residency.host());
+  ASSERT_FALSE(residency.isValid(0));
+  ASSERT_TRUE(residency.isValid(1));
+  ASSERT_TRUE(residency.isValid(residency.host()));
+}
+
+TEST(BufferResidency, ReadsKeepCopiesValid) {
+  v2::buffer_residency_t residency(4);
+  residency.markAccessed(residency.host(), true);
+
+  // Each device is migrated to once, from a device copy.
+  ASSERT_EQ(access(residency, 0, false), residency.host());
+  for (location_t device = 1; device < 4; device++) {
+    ASSERT_EQ(access(residency, device, false), location_t{0});
+  }
+
+  for (int iteration = 0; iteration < 3; iteration++) {
+    for (location_t device = 0; device < 4; device++) {
+      ASSERT_EQ(access(residency, device, false), std::nullopt);
+    }
+  }
+}
+
+TEST(BufferResidency, WritesInvalidateOtherCopies) {
+  v2::buffer_residency_t residency(3);
+  residency.markAccessed(residency.host(), true);
+  access(residency, 0, false);
+  access(residency, 1, false);
+
+  ASSERT_EQ(access(residency, 2, true), location_t{0});
+  ASSERT_FALSE(residency.isValid(0));
+  ASSERT_FALSE(residency.isValid(1));
+  ASSERT_FALSE(residency.isValid(residency.host()));
+  ASSERT_TRUE(residency.isValid(2));
+
+  // Writing to a valid copy needs no migration.
+  ASSERT_EQ(access(residency, 2, true), std::nullopt);
+  ASSERT_EQ(access(residency, 0, false), location_t{2});
+  ASSERT_TRUE(residency.isValid(2));
+}
+
+TEST(BufferResidency, PrefersAccessibleDeviceCopies) {
+  v2::buffer_residency_t residency(3);
+  residency.markAccessed(residency.host(), true);
+  access(residency, 0, false);
+  access(residency, 1, false);
+
+  // Device 2 can only copy from device 1 and the host.
+  auto source = residency.getMigrationSource(
+      2, [](location_t location) { return location != 0; });
+  ASSERT_EQ(source, location_t{1});
+
+  // Falls back to the host copy when no device copy is accessible.
+  source = residency.getMigrationSource(
+      2, [&](location_t location) { return location == residency.host(); });
+  ASSERT_EQ(source, residency.host());
+}
+
+TEST(BufferResidency, NoAccessibleCopyIsMigratedThroughHost) {
+  v2::buffer_residency_t residency(3);
+  residency.markAccessed(1, true);
+
+  // Device 2 can only copy from the host, so a device copy is returned for
+  // the contents to be staged in the host copy.
+  auto hostOnly = [&](location_t location) {
+    return location == residency.host();
+  };
+  ASSERT_EQ(residency.getMigrationSource(2, hostOnly), location_t{1});
+
+  // Staging reads the device copy into the host copy, which then is valid
+  // and copied from directly.
+  residency.markAccessed(residency.host(), false);
+  ASSERT_EQ(residency.getMigrationSource(2, hostOnly), residency.host());
+  residency.markAccessed(2, false);
+  ASSERT_TRUE(residency.isValid(1));
+  ASSERT_TRUE(residency.isValid(2));
+}
@@ -243,3 +243,92 @@ TEST_P(CommandListCacheTest, CommandListsCacheIsThreadSafe) {
   ASSERT_LE(context->getCommandListCache().getNumImmediateCommandLists(),
             NumThreads);
 }
+
+TEST_P(CommandListCacheTest, LeastRecentlyUsedCommandListsAreEvicted) {
+  static constexpr size_t Capacity = 2;
+  v2::command_list_cache_t cache(context->getZeHandle(), Capacity);
+
+  ze_command_queue_mode_t Mode = ZE_COMMAND_QUEUE_MODE_DEFAULT;
+  auto getList = [&](ze_command_queue_priority_t Priority) {
+    return cache.getImmediateCommandList(device->ZeDevice, false, 0, true, Mode,
+                                         Priority);
+  };
+
+  std::vector<ze_command_queue_priority_t> Priorities = {
+      ZE_COMMAND_QUEUE_PRIORITY_NORMAL, ZE_COMMAND_QUEUE_PRIORITY_PRIORITY_LOW,
+      ZE_COMMAND_QUEUE_PRIORITY_PRIORITY_HIGH};
+  {
+    std::vector<v2::raii::command_list_unique_handle> Lists;
+    for (auto Priority : Priorities) {
+      Lists.push_back(getList(Priority));
+    }
+    // return them in order, the first one becomes the least recently used
+    for (auto &List : Lists) {
+      List.reset();
+    }
+  }
+
+  ASSERT_EQ(cache.getNumImmediateCommandLists(), Capacity);
+  auto Stats = cache.getStats();
+  ASSERT_EQ(Stats.Misses, Priorities.size());
+  ASSERT_EQ(Stats.Hits, 0);
+  ASSERT_EQ(Stats.Evictions, Priorities.size() - Capacity);
+
+  // the last two lists are reused, the first one has to be created again
+  auto High = getList(ZE_COMMAND_QUEUE_PRIORITY_PRIORITY_HIGH);
+  auto Low = getList(ZE_COMMAND_QUEUE_PRIORITY_PRIORITY_LOW);
+  ASSERT_EQ(cache.getStats().Hits, 2);
+  auto Normal = getList(ZE_COMMAND_QUEUE_PRIORITY_NORMAL);
+  ASSERT_EQ(cache.getStats().Misses, Priorities.size() + 1);
+  ASSERT_EQ(cache.getNumImmediateCommandLists(), 0);
+}
+
+TEST_P(CommandListCacheTest, CommandListsAreShardedByOrdinal) {
+  v2::command_list_cache_t cache(context->getZeHandle());
+
+  uint32_t numQueueGroups = 0;
+  ASSERT_EQ(zeDeviceGetCommandQueueGroupProperties(device->ZeDevice,
+                                                   &numQueueGroups, nullptr),
+            ZE_RESULT_SUCCESS);
+
+  // lists differing only by ordinal are never mixed up
+  for (uint32_t Ordinal = 0; Ordinal < numQueueGroups; Ordinal++) {
+    cache.getRegularCommandList(device->ZeDevice, true, Ordinal, true);
+  }
+  ASSERT_EQ(cache.getNumRegularCommandLists(), numQueueGroups);
+
+  for (uint32_t Ordinal = 0; Ordinal < numQueueGroups; Ordinal++) {
+    auto CommandList =
+        cache.getRegularCommandList(device->ZeDevice, true, Ordinal, true);
+    uint32_t ActualOrdinal;
+    auto Ret = zeCommandListGetOrdinal(CommandList.get(), &ActualOrdinal);
+    if (Ret == ZE_RESULT_SUCCESS) {
+      ASSERT_EQ(ActualOrdinal, Ordinal);
+    } else {
+      ASSERT_EQ(Ret, ZE_RESULT_ERROR_UNSUPPORTED_FEATURE);
+    }
+  }
+  ASSERT_EQ(cache.getStats().Hits, numQueueGroups);
+}
+
+TEST_P(CommandListCacheTest, PrewarmedCommandListsAreReused) {
+  v2::command_list_cache_t cache(context->getZeHandle());
+
+  static constexpr size_t Count = 3;
+  cache.prewarmImmediateCommandLists(
+      device->ZeDevice, true, 0, true, ZE_COMMAND_QUEUE_MODE_ASYNCHRONOUS,
+      ZE_COMMAND_QUEUE_PRIORITY_NORMAL, Count);
+  ASSERT_EQ(cache.getNumImmediateCommandLists(), Count);
+
+  std::vector<v2::raii::command_list_unique_handle> Lists;
+  for (size_t I = 0; I < Count; I++) {
+    Lists.push_back(cache.getImmediateCommandList(
+        device->ZeDevice, true, 0, true, ZE_COMMAND_QUEUE_MODE_ASYNCHRONOUS,
+        ZE_COMMAND_QUEUE_PRIORITY_NORMAL));
+  }
+
+  auto Stats = cache.getStats();
+  ASSERT_EQ(Stats.Hits, Count);
+  ASSERT_EQ(Stats.Misses, 0);
+  ASSERT_EQ(cache.getNumImmediateCommandLists(), 0);
+}
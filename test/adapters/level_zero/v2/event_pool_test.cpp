@@ -20,9 +20,11 @@
 #include "uur/fixtures.h"
 #include "ze_api.h"
 
+#include <future>
 #include <gtest/gtest.h>
 #include <map>
 #include <string>
+#include <thread>
 #include <unordered_set>
 
 using namespace v2;
@@ -304,3 +306,163 @@ TEST_P(EventPoolTestWithQueue, WithTimestamp) {
   ASSERT_EQ(first, third);
   ASSERT_EQ(zeFirst, zeThird);
 }
+
+// Provider handing out fake ze handles, so that the pool can be tested
+// without driver calls. Counter-based events are never reset on the host.
+struct FakeProvider : event_provider {
+  raii::cache_borrowed_event allocate() override {
+    ++allocations;
+    return raii::cache_borrowed_event(
+        reinterpret_cast<ze_event_handle_t>(++lastHandle),
+        [](ze_event_handle_t) {});
+  }
+  event_flags_t eventFlags() const override { return EVENT_FLAGS_COUNTER; }
+
+  uintptr_t lastHandle = 0;
+  size_t allocations = 0;
+};
+
+struct EventPoolFakeProviderTest : public ::testing::Test {
+  void SetUp() override {
+    auto fakeProvider = std::make_unique<FakeProvider>();
+    provider = fakeProvider.get();
+    pool = std::make_unique<event_pool>(nullptr, std::move(fakeProvider));
+  }
+
+  FakeProvider *provider;
+  std::unique_ptr<event_pool> pool;
+};
+
+static constexpr size_t BATCH = event_pool::THREAD_CACHE_BATCH;
+
+TEST_F(EventPoolFakeProviderTest, ThreadCacheHits) {
+  auto first = pool->allocate();
+  auto stats = pool->getStats();
+  ASSERT_EQ(stats.hits, 0u);
+  ASSERT_EQ(stats.refills, 1u);
+  ASSERT_EQ(stats.providerAllocations, provider->allocations);
+
+  // A freed event is reused by the same thread without locking.
+  ASSERT_EQ(first->release(), UR_RESULT_SUCCESS);
+  auto second = pool->allocate();
+  ASSERT_EQ(first, second);
+  stats = pool->getStats();
+  ASSERT_EQ(stats.hits, 1u);
+  ASSERT_EQ(stats.refills, 1u);
+
+  std::vector<ur_event_handle_t> events{second};
+  for (size_t i = 1; i < BATCH; ++i) {
+    events.push_back(pool->allocate());
+  }
+  ASSERT_EQ(pool->getStats().refills, 1u);
+  events.push_back(pool->allocate());
+  stats = pool->getStats();
+  ASSERT_EQ(stats.hits, BATCH);
+  ASSERT_EQ(stats.refills, 2u);
+  ASSERT_EQ(stats.providerAllocations, provider->allocations);
+
+  for (auto event : events) {
+    ASSERT_EQ(event->release(), UR_RESULT_SUCCESS);
+  }
+}
+
+TEST_F(EventPoolFakeProviderTest, BatchReturn) {
+  std::vector<ur_event_handle_t> events;
+  for (int iter = 0; iter < 10; ++iter) {
+    for (size_t i = 0; i < 8 * BATCH; ++i) {
+      events.push_back(pool->allocate());
+    }
+    for (auto event : events) {
+      ASSERT_EQ(event->release(), UR_RESULT_SUCCESS);
+    }
+    events.clear();
+  }
+
+  // Freed events went back to the shared freelist rather than piling up in
+  // the thread cache, so the provider wasn't asked for more.
+  auto allocations = provider->allocations;
+  ASSERT_LE(allocations, 8 * BATCH + 2 * BATCH);
+  ASSERT_EQ(pool->getStats().providerAllocations, allocations);
+}
+
+TEST_F(EventPoolFakeProviderTest, Threaded) {
+  std::mutex mutex;
+  std::unordered_set<ur_event_handle_t> live;
+
+  std::vector<std::thread> threads;
+  for (int th = 0; th < 8; ++th) {
+    threads.emplace_back([&] {
+      std::vector<ur_event_handle_t> events;
+      for (int iter = 0; iter < 100; ++iter) {
+        for (int i = 0; i < 10; ++i) {
+          auto event = pool->allocate();
+          std::unique_lock<std::mutex> lock(mutex);
+          ASSERT_TRUE(live.insert(event).second);
+          events.push_back(event);
+        }
+        for (auto event : events) {
+          {
+            std::unique_lock<std::mutex> lock(mutex);
+            live.erase(event);
+          }
+          ASSERT_EQ(event->release(), UR_RESULT_SUCCESS);
+        }
+        events.clear();
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  auto stats = pool->getStats();
+  ASSERT_EQ(stats.providerAllocations, provider->allocations);
+  ASSERT_GT(stats.hits, stats.refills);
+}
+
+TEST_F(EventPoolFakeProviderTest, PoolDestroyedBeforeThreadExit) {
+  std::promise<void> cached, destroyed;
+  std::thread thread([&] {
+    auto event = pool->allocate();
+    EXPECT_EQ(event->release(), UR_RESULT_SUCCESS);
+    cached.set_value();
+    // The thread cache still holds events of the destroyed pool and drops
+    // them when the thread exits.
+    destroyed.get_future().wait();
+  });
+  cached.get_future().wait();
+  pool.reset();
+  destroyed.set_value();
+  thread.join();
+}
+
+TEST_F(EventPoolFakeProviderTest, ThreadCacheSlots) {
+  // Run on a new thread, so that no caches of other tests' pools are left.
+  std::thread thread([&] {
+    std::vector<std::unique_ptr<event_pool>> pools;
+    for (size_t i = 0; i < event_pool::THREAD_CACHE_SLOTS; ++i) {
+      pools.push_back(std::make_unique<event_pool>(
+          nullptr, std::make_unique<FakeProvider>()));
+    }
+
+    // Alternating between as many pools as there are slots keeps all their
+    // caches.
+    for (int iter = 0; iter < 4; ++iter) {
+      for (auto &other : pools) {
+        EXPECT_EQ(other->allocate()->release(), UR_RESULT_SUCCESS);
+      }
+    }
+
+    // Reading the stats of a pool this thread has no cache of doesn't evict
+    // any.
+    EXPECT_EQ(pool->getStats().refills, 0u);
+
+    for (auto &other : pools) {
+      EXPECT_EQ(other->allocate()->release(), UR_RESULT_SUCCESS);
+      auto stats = other->getStats();
+      EXPECT_EQ(stats.refills, 1u);
+      EXPECT_EQ(stats.hits, 4u);
+    }
+  });
+  thread.join();
+}
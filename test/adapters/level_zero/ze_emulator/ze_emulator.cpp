@@ -0,0 +1,1836 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "ze_emulator.hpp"
+
+#include <loader/ze_loader.h>
+#include <ze_api.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+using namespace ze_emulator;
+
+namespace {
+
+std::chrono::nanoseconds latencyFromEnv(const char *Name) {
+  const char *Value = std::getenv(Name);
+  return std::chrono::nanoseconds(Value ? std::strtoll(Value, nullptr, 10)
+                                        : 0);
+}
+
+config_t configFromEnv() {
+  config_t Config;
+  if (const char *Devices = std::getenv("ZE_EMULATOR_DEVICES")) {
+    Config.NumDevices =
+        static_cast<uint32_t>(std::strtoul(Devices, nullptr, 10));
+  }
+  Config.Latency.Create = latencyFromEnv("ZE_EMULATOR_CREATE_LATENCY_NS");
+  Config.Latency.Append = latencyFromEnv("ZE_EMULATOR_APPEND_LATENCY_NS");
+  Config.Latency.Submit = latencyFromEnv("ZE_EMULATOR_SUBMIT_LATENCY_NS");
+  Config.Latency.Execute = latencyFromEnv("ZE_EMULATOR_EXECUTE_LATENCY_NS");
+  return Config;
+}
+
+struct state_t {
+  std::mutex ConfigMutex;
+  config_t Config = configFromEnv();
+
+  std::mutex CountersMutex;
+  std::map<std::string, std::unique_ptr<std::atomic<uint64_t>>, std::less<>>
+      Counters;
+
+  std::mutex KernelsMutex;
+  std::map<std::string, std::pair<uint32_t, kernel_t>, std::less<>> Kernels;
+
+  // Guards the state of all events; EventCV is notified whenever one is
+  // signaled.
+  std::mutex EventMutex;
+  std::condition_variable EventCV;
+
+  // USM allocations by base address.
+  std::mutex AllocsMutex;
+  std::map<uintptr_t, std::tuple<size_t, ze_memory_type_t, ze_device_handle_t>>
+      Allocs;
+};
+
+state_t &state() {
+  static state_t *State = new state_t;
+  return *State;
+}
+
+std::atomic<uint64_t> &counter(const char *Name) {
+  state_t &State = state();
+  std::lock_guard<std::mutex> Lock(State.CountersMutex);
+  auto &Counter = State.Counters[Name];
+  if (!Counter) {
+    Counter = std::make_unique<std::atomic<uint64_t>>(0);
+  }
+  return *Counter;
+}
+
+latencies_t latencies() {
+  state_t &State = state();
+  std::lock_guard<std::mutex> Lock(State.ConfigMutex);
+  return State.Config.Latency;
+}
+
+void spin(std::chrono::nanoseconds Duration) {
+  if (Duration.count() <= 0) {
+    return;
+  }
+  const auto End = std::chrono::steady_clock::now() + Duration;
+  while (std::chrono::steady_clock::now() < End) {
+  }
+}
+
+uint64_t now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Finds the first structure of type Type in the pNext chain of Desc.
+template <typename T> const T *findExtension(const void *Desc,
+                                             ze_structure_type_t Type) {
+  auto *Base = static_cast<const ze_base_desc_t *>(Desc);
+  for (Base = Base ? static_cast<const ze_base_desc_t *>(Base->pNext)
+                   : nullptr;
+       Base; Base = static_cast<const ze_base_desc_t *>(Base->pNext)) {
+    if (Base->stype == Type) {
+      return reinterpret_cast<const T *>(Base);
+    }
+  }
+  return nullptr;
+}
+
+template <typename T>
+ze_result_t returnArray(uint32_t *pCount, T *pValues,
+                        const std::vector<T> &Values) {
+  if (!pCount) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  if (*pCount == 0 || !pValues) {
+    *pCount = static_cast<uint32_t>(Values.size());
+    return ZE_RESULT_SUCCESS;
+  }
+  *pCount = std::min(*pCount, static_cast<uint32_t>(Values.size()));
+  std::copy_n(Values.begin(), *pCount, pValues);
+  return ZE_RESULT_SUCCESS;
+}
+
+// Runs work items in submission order on a host thread.
+class engine_t {
+public:
+  engine_t() : Thread([this] { run(); }) {}
+
+  ~engine_t() {
+    {
+      std::lock_guard<std::mutex> Lock(Mutex);
+      Stop = true;
+    }
+    CV.notify_all();
+    Thread.join();
+  }
+
+  void submit(std::function<void()> Work) {
+    {
+      std::lock_guard<std::mutex> Lock(Mutex);
+      Queue.push_back(std::move(Work));
+    }
+    CV.notify_all();
+  }
+
+  // Waits until all submitted work has finished, or until Timeout expires.
+  bool wait(uint64_t Timeout) {
+    std::unique_lock<std::mutex> Lock(Mutex);
+    auto Idle = [this] { return Queue.empty() && !Busy; };
+    if (Timeout == UINT64_MAX) {
+      CV.wait(Lock, Idle);
+      return true;
+    }
+    return CV.wait_for(Lock, std::chrono::nanoseconds(Timeout), Idle);
+  }
+
+private:
+  void run() {
+    std::unique_lock<std::mutex> Lock(Mutex);
+    while (true) {
+      CV.wait(Lock, [this] { return Stop || !Queue.empty(); });
+      if (Queue.empty()) {
+        return;
+      }
+      std::function<void()> Work = std::move(Queue.front());
+      Queue.pop_front();
+      Busy = true;
+      Lock.unlock();
+      Work();
+      Lock.lock();
+      Busy = false;
+      CV.notify_all();
+    }
+  }
+
+  std::mutex Mutex;
+  std::condition_variable CV;
+  std::deque<std::function<void()>> Queue;
+  bool Busy = false;
+  bool Stop = false;
+  std::thread Thread;
+};
+
+} // namespace
+
+struct _ze_device_handle_t {
+  ze_driver_handle_t Driver;
+  uint32_t Index;
+};
+
+struct _ze_driver_handle_t {
+  std::vector<std::unique_ptr<_ze_device_handle_t>> Devices;
+};
+
+struct _ze_context_handle_t {
+  ze_driver_handle_t Driver;
+};
+
+struct _ze_event_pool_handle_t {
+  ze_context_handle_t Context;
+  ze_event_pool_flags_t Flags;
+  uint32_t Count;
+  bool CounterBased;
+};
+
+struct _ze_event_handle_t {
+  ze_event_pool_handle_t Pool;
+  bool CounterBased;
+  bool Timestamps;
+  // Guarded by state_t::EventMutex.
+  bool Signaled;
+  // Number of submitted commands yet to signal a counter-based event; it
+  // completes when the last of them has run.
+  uint32_t Pending = 0;
+  uint64_t Start = 0;
+  uint64_t End = 0;
+};
+
+struct _ze_fence_handle_t {
+  ze_command_queue_handle_t Queue;
+  // Guarded by state_t::EventMutex.
+  bool Signaled = false;
+};
+
+namespace {
+
+// A command waits for its events, runs, then signals its event.
+struct command_t {
+  std::vector<ze_event_handle_t> WaitEvents;
+  std::function<void()> Run;
+  ze_event_handle_t SignalEvent = nullptr;
+};
+
+void waitEvents(const std::vector<ze_event_handle_t> &Events) {
+  state_t &State = state();
+  std::unique_lock<std::mutex> Lock(State.EventMutex);
+  State.EventCV.wait(Lock, [&] {
+    return std::all_of(Events.begin(), Events.end(),
+                       [](ze_event_handle_t Event) { return Event->Signaled; });
+  });
+}
+
+void signalEvent(ze_event_handle_t Event, uint64_t Start, uint64_t End) {
+  state_t &State = state();
+  {
+    std::lock_guard<std::mutex> Lock(State.EventMutex);
+    if (Event->CounterBased && Event->Pending && --Event->Pending) {
+      return;
+    }
+    Event->Signaled = true;
+    Event->Start = Start;
+    Event->End = End;
+  }
+  State.EventCV.notify_all();
+}
+
+void execute(const command_t &Command) {
+  waitEvents(Command.WaitEvents);
+  const uint64_t Start = now();
+  spin(latencies().Execute);
+  if (Command.Run) {
+    Command.Run();
+  }
+  if (Command.SignalEvent) {
+    signalEvent(Command.SignalEvent, Start, now());
+  }
+}
+
+// Hands Command to Engine. Counter-based events are reset when a command
+// that signals them is submitted.
+void submit(engine_t &Engine, command_t Command) {
+  if (Command.SignalEvent && Command.SignalEvent->CounterBased) {
+    std::lock_guard<std::mutex> Lock(state().EventMutex);
+    Command.SignalEvent->Signaled = false;
+    Command.SignalEvent->Pending++;
+  }
+  Engine.submit([Command = std::move(Command)] { execute(Command); });
+}
+
+} // namespace
+
+struct _ze_command_queue_handle_t {
+  ze_context_handle_t Context;
+  ze_device_handle_t Device;
+  engine_t Engine;
+};
+
+struct _ze_command_list_handle_t {
+  ze_context_handle_t Context;
+  ze_device_handle_t Device;
+  // Only immediate command lists have an engine.
+  std::unique_ptr<engine_t> Engine;
+  std::vector<command_t> Commands;
+  // Queue group and queue index the list was created for.
+  uint32_t Ordinal = 0;
+  uint32_t Index = 0;
+  bool Closed = false;
+};
+
+struct _ze_module_handle_t {
+  ze_context_handle_t Context;
+  ze_device_handle_t Device;
+};
+
+struct _ze_module_build_log_handle_t {};
+
+struct _ze_kernel_handle_t {
+  std::string Name;
+  uint32_t NumArgs;
+  kernel_t Function;
+  std::vector<std::vector<uint8_t>> Args;
+  std::array<uint32_t, 3> GroupSize = {1, 1, 1};
+  std::array<uint32_t, 3> GlobalOffset = {0, 0, 0};
+};
+
+// Counts the call to the enclosing ze* function.
+#define ZE_EMULATOR_CALL()                                                     \
+  static std::atomic<uint64_t> &CallCount = counter(__func__);                 \
+  CallCount.fetch_add(1, std::memory_order_relaxed)
+
+namespace {
+
+_ze_driver_handle_t *Driver = nullptr;
+std::once_flag DriverOnce;
+
+ze_result_t initDriver() {
+  std::call_once(DriverOnce, [] {
+    const uint32_t NumDevices = getConfig().NumDevices;
+    Driver = new _ze_driver_handle_t;
+    for (uint32_t I = 0; I < NumDevices; I++) {
+      Driver->Devices.push_back(std::make_unique<_ze_device_handle_t>(
+          _ze_device_handle_t{Driver, I}));
+    }
+  });
+  return ZE_RESULT_SUCCESS;
+}
+
+ze_result_t append(ze_command_list_handle_t hCommandList, command_t Command,
+                   uint32_t numWaitEvents, ze_event_handle_t *phWaitEvents) {
+  if (!hCommandList) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  if (hCommandList->Closed) {
+    return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+  }
+  spin(latencies().Append);
+  Command.WaitEvents.insert(Command.WaitEvents.end(), phWaitEvents,
+                            phWaitEvents + numWaitEvents);
+  if (hCommandList->Engine) {
+    submit(*hCommandList->Engine, std::move(Command));
+  } else {
+    hCommandList->Commands.push_back(std::move(Command));
+  }
+  return ZE_RESULT_SUCCESS;
+}
+
+ze_result_t allocate(size_t size, size_t alignment, ze_memory_type_t Type,
+                     ze_device_handle_t hDevice, void **pptr) {
+  if (!pptr) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  if (size == 0) {
+    return ZE_RESULT_ERROR_UNSUPPORTED_SIZE;
+  }
+  if (alignment & (alignment - 1)) {
+    return ZE_RESULT_ERROR_UNSUPPORTED_ALIGNMENT;
+  }
+  alignment = std::max<size_t>(alignment, 64);
+  // aligned_alloc requires the size to be a multiple of the alignment.
+  const size_t AllocSize = (size + alignment - 1) / alignment * alignment;
+  void *Ptr = std::aligned_alloc(alignment, AllocSize);
+  if (!Ptr) {
+    return ZE_RESULT_ERROR_OUT_OF_HOST_MEMORY;
+  }
+  state_t &State = state();
+  std::lock_guard<std::mutex> Lock(State.AllocsMutex);
+  State.Allocs[reinterpret_cast<uintptr_t>(Ptr)] = {size, Type, hDevice};
+  *pptr = Ptr;
+  return ZE_RESULT_SUCCESS;
+}
+
+// Returns the allocation containing Ptr, or State.Allocs.end(). Must be
+// called with AllocsMutex held.
+auto findAlloc(const void *Ptr) {
+  auto &Allocs = state().Allocs;
+  auto It = Allocs.upper_bound(reinterpret_cast<uintptr_t>(Ptr));
+  if (It == Allocs.begin()) {
+    return Allocs.end();
+  }
+  --It;
+  if (reinterpret_cast<uintptr_t>(Ptr) >= It->first + std::get<0>(It->second)) {
+    return Allocs.end();
+  }
+  return It;
+}
+
+ze_result_t appendLaunch(ze_command_list_handle_t hCommandList,
+                         ze_kernel_handle_t hKernel,
+                         const ze_group_count_t *pLaunchFuncArgs,
+                         ze_event_handle_t hSignalEvent,
+                         uint32_t numWaitEvents,
+                         ze_event_handle_t *phWaitEvents) {
+  if (!hKernel || !pLaunchFuncArgs) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  // Arguments are captured when the launch is appended.
+  launch_t Launch{hKernel->Args,
+                  {pLaunchFuncArgs->groupCountX, pLaunchFuncArgs->groupCountY,
+                   pLaunchFuncArgs->groupCountZ},
+                  hKernel->GroupSize,
+                  hKernel->GlobalOffset};
+  return append(hCommandList,
+                {{},
+                 [Function = hKernel->Function, Launch = std::move(Launch)] {
+                   Function(Launch);
+                 },
+                 hSignalEvent},
+                numWaitEvents, phWaitEvents);
+}
+
+ze_result_t createEvent(ze_event_pool_handle_t Pool, bool CounterBased,
+                        bool Timestamps, ze_event_handle_t *phEvent) {
+  if (!phEvent) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  // Counter-based events that were never signaled count as completed.
+  *phEvent = new _ze_event_handle_t{Pool, CounterBased, Timestamps,
+                                    CounterBased};
+  return ZE_RESULT_SUCCESS;
+}
+
+} // namespace
+
+namespace ze_emulator {
+
+config_t getConfig() {
+  state_t &State = state();
+  std::lock_guard<std::mutex> Lock(State.ConfigMutex);
+  return State.Config;
+}
+
+void setConfig(const config_t &Config) {
+  state_t &State = state();
+  std::lock_guard<std::mutex> Lock(State.ConfigMutex);
+  State.Config = Config;
+}
+
+uint64_t getCallCount(std::string_view Name) {
+  state_t &State = state();
+  std::lock_guard<std::mutex> Lock(State.CountersMutex);
+  auto It = State.Counters.find(Name);
+  return It == State.Counters.end() ? 0 : It->second->load();
+}
+
+std::map<std::string, uint64_t> getCallCounts() {
+  state_t &State = state();
+  std::lock_guard<std::mutex> Lock(State.CountersMutex);
+  std::map<std::string, uint64_t> Counts;
+  for (auto &[Name, Count] : State.Counters) {
+    if (Count->load()) {
+      Counts[Name] = Count->load();
+    }
+  }
+  return Counts;
+}
+
+void resetCallCounts() {
+  state_t &State = state();
+  std::lock_guard<std::mutex> Lock(State.CountersMutex);
+  for (auto &Counter : State.Counters) {
+    Counter.second->store(0);
+  }
+}
+
+void registerKernel(const std::string &Name, uint32_t NumArgs,
+                    kernel_t Kernel) {
+  state_t &State = state();
+  std::lock_guard<std::mutex> Lock(State.KernelsMutex);
+  State.Kernels[Name] = {NumArgs, std::move(Kernel)};
+}
+
+} // namespace ze_emulator
+
+extern "C" {
+
+///////////////////////////////////////////////////////////////////////////////
+// Drivers
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeInit(ze_init_flags_t flags) {
+  ZE_EMULATOR_CALL();
+  if (flags && !(flags & ZE_INIT_FLAG_GPU_ONLY)) {
+    return ZE_RESULT_ERROR_UNINITIALIZED;
+  }
+  return initDriver();
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL
+zeInitDrivers(uint32_t *pCount, ze_driver_handle_t *phDrivers,
+              ze_init_driver_type_desc_t *desc) {
+  ZE_EMULATOR_CALL();
+  if (!pCount || !desc) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  if (!(desc->flags & ZE_INIT_DRIVER_TYPE_FLAG_GPU)) {
+    *pCount = 0;
+    return ZE_RESULT_SUCCESS;
+  }
+  initDriver();
+  return returnArray<ze_driver_handle_t>(pCount, phDrivers, {Driver});
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeDriverGet(uint32_t *pCount,
+                                                ze_driver_handle_t *phDrivers) {
+  ZE_EMULATOR_CALL();
+  if (!Driver) {
+    return ZE_RESULT_ERROR_UNINITIALIZED;
+  }
+  return returnArray<ze_driver_handle_t>(pCount, phDrivers, {Driver});
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL
+zeDriverGetApiVersion(ze_driver_handle_t hDriver, ze_api_version_t *version) {
+  ZE_EMULATOR_CALL();
+  if (!hDriver || !version) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  *version = ZE_API_VERSION_CURRENT;
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeDriverGetProperties(
+    ze_driver_handle_t hDriver, ze_driver_properties_t *pDriverProperties) {
+  ZE_EMULATOR_CALL();
+  if (!hDriver || !pDriverProperties) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  std::memset(&pDriverProperties->uuid, 0, sizeof(pDriverProperties->uuid));
+  pDriverProperties->uuid.id[0] = 0xe0;
+  pDriverProperties->driverVersion = 1;
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeDriverGetExtensionProperties(
+    ze_driver_handle_t hDriver, uint32_t *pCount,
+    ze_driver_extension_properties_t *pExtensionProperties) {
+  ZE_EMULATOR_CALL();
+  if (!hDriver) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  std::vector<ze_driver_extension_properties_t> Extensions;
+  auto add = [&](const char *Name, uint32_t Version) {
+    ze_driver_extension_properties_t Extension{};
+    std::strncpy(Extension.name, Name, ZE_MAX_EXTENSION_NAME - 1);
+    Extension.version = Version;
+    Extensions.push_back(Extension);
+  };
+  add(ZE_GLOBAL_OFFSET_EXP_NAME, ZE_GLOBAL_OFFSET_EXP_VERSION_1_0);
+  add(ZE_EVENT_POOL_COUNTER_BASED_EXP_NAME,
+      ZE_EVENT_POOL_COUNTER_BASED_EXP_VERSION_CURRENT);
+  add(ZE_IMMEDIATE_COMMAND_LIST_APPEND_EXP_NAME,
+      ZE_IMMEDIATE_COMMAND_LIST_APPEND_EXP_VERSION_CURRENT);
+  return returnArray(pCount, pExtensionProperties, Extensions);
+}
+
+// Creates a counter-based event outside of any pool, as done by the Intel
+// driver extension of the same name.
+static ze_result_t ZE_APICALL zexCounterBasedEventCreate(
+    ze_context_handle_t hContext, ze_device_handle_t hDevice,
+    uint64_t * /*deviceAddress*/, uint64_t * /*hostAddress*/,
+    uint64_t /*completionValue*/, const ze_event_desc_t *desc,
+    ze_event_handle_t *phEvent) {
+  ZE_EMULATOR_CALL();
+  if (!hContext || !hDevice || !desc) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  return createEvent(nullptr, true, false, phEvent);
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeDriverGetExtensionFunctionAddress(
+    ze_driver_handle_t hDriver, const char *name, void **ppFunctionAddress) {
+  ZE_EMULATOR_CALL();
+  if (!hDriver || !name || !ppFunctionAddress) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  if (std::strcmp(name, "zexCounterBasedEventCreate") == 0) {
+    *ppFunctionAddress = reinterpret_cast<void *>(&zexCounterBasedEventCreate);
+    return ZE_RESULT_SUCCESS;
+  }
+  *ppFunctionAddress = nullptr;
+  return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+}
+
+ZE_DLLEXPORT ze_result_t ZE_APICALL
+zelLoaderGetVersions(size_t *num_elems, zel_component_version_t *versions) {
+  ZE_EMULATOR_CALL();
+  if (!num_elems) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  if (!versions) {
+    *num_elems = 1;
+    return ZE_RESULT_SUCCESS;
+  }
+  if (*num_elems >= 1) {
+    std::strncpy(versions[0].component_name, "loader",
+                 ZEL_COMPONENT_STRING_SIZE - 1);
+    versions[0].spec_version = ZE_API_VERSION_CURRENT;
+    versions[0].component_lib_version = {1, 19, 2};
+    *num_elems = 1;
+  }
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_DLLEXPORT ze_result_t ZE_APICALL zelLoaderTranslateHandle(
+    zel_handle_type_t /*handleType*/, void *handleIn, void **handleOut) {
+  ZE_EMULATOR_CALL();
+  if (!handleOut) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  *handleOut = handleIn;
+  return ZE_RESULT_SUCCESS;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Devices
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeDeviceGet(ze_driver_handle_t hDriver,
+                                                uint32_t *pCount,
+                                                ze_device_handle_t *phDevices) {
+  ZE_EMULATOR_CALL();
+  if (!hDriver) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  std::vector<ze_device_handle_t> Devices;
+  for (auto &Device : hDriver->Devices) {
+    Devices.push_back(Device.get());
+  }
+  return returnArray(pCount, phDevices, Devices);
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL
+zeDeviceGetSubDevices(ze_device_handle_t hDevice, uint32_t *pCount,
+                      ze_device_handle_t *phSubdevices) {
+  ZE_EMULATOR_CALL();
+  if (!hDevice) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  return returnArray<ze_device_handle_t>(pCount, phSubdevices, {});
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeDeviceGetRootDevice(
+    ze_device_handle_t hDevice, ze_device_handle_t *phRootDevice) {
+  ZE_EMULATOR_CALL();
+  if (!hDevice || !phRootDevice) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  *phRootDevice = nullptr;
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeDeviceGetProperties(
+    ze_device_handle_t hDevice, ze_device_properties_t *pDeviceProperties) {
+  ZE_EMULATOR_CALL();
+  if (!hDevice || !pDeviceProperties) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  ze_device_properties_t &Props = *pDeviceProperties;
+  Props.type = ZE_DEVICE_TYPE_GPU;
+  Props.vendorId = 0x8086;
+  Props.deviceId = 0;
+  Props.flags = 0;
+  Props.subdeviceId = 0;
+  Props.coreClockRate = 1000;
+  Props.maxMemAllocSize = uint64_t{4} << 30;
+  Props.maxHardwareContexts = 1;
+  Props.maxCommandQueuePriority = 0;
+  Props.numThreadsPerEU = 8;
+  Props.physicalEUSimdWidth = 8;
+  Props.numEUsPerSubslice = 8;
+  Props.numSubslicesPerSlice = 4;
+  Props.numSlices = 1;
+  // Timestamps are in nanoseconds; version 1.2 of the structure reports the
+  // resolution in cycles per second.
+  Props.timerResolution =
+      Props.stype == ZE_STRUCTURE_TYPE_DEVICE_PROPERTIES_1_2 ? 1000000000 : 1;
+  Props.timestampValidBits = 64;
+  Props.kernelTimestampValidBits = 64;
+  std::memset(&Props.uuid, 0, sizeof(Props.uuid));
+  Props.uuid.id[0] = 0xe0;
+  Props.uuid.id[1] = static_cast<uint8_t>(hDevice->Index + 1);
+  std::snprintf(Props.name, ZE_MAX_DEVICE_NAME, "Level Zero Emulator %u",
+                hDevice->Index);
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeDeviceGetComputeProperties(
+    ze_device_handle_t hDevice,
+    ze_device_compute_properties_t *pComputeProperties) {
+  ZE_EMULATOR_CALL();
+  if (!hDevice || !pComputeProperties) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  ze_device_compute_properties_t &Props = *pComputeProperties;
+  Props.maxTotalGroupSize = 1024;
+  Props.maxGroupSizeX = 1024;
+  Props.maxGroupSizeY = 1024;
+  Props.maxGroupSizeZ = 1024;
+  Props.maxGroupCountX = UINT32_MAX;
+  Props.maxGroupCountY = UINT32_MAX;
+  Props.maxGroupCountZ = UINT32_MAX;
+  Props.maxSharedLocalMemory = 64 << 10;
+  Props.numSubGroupSizes = 2;
+  Props.subGroupSizes[0] = 16;
+  Props.subGroupSizes[1] = 32;
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeDeviceGetModuleProperties(
+    ze_device_handle_t hDevice,
+    ze_device_module_properties_t *pModuleProperties) {
+  ZE_EMULATOR_CALL();
+  if (!hDevice || !pModuleProperties) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  ze_device_module_properties_t &Props = *pModuleProperties;
+  Props.spirvVersionSupported = ZE_MAKE_VERSION(1, 2);
+  Props.flags = 0;
+  Props.fp16flags = 0;
+  Props.fp32flags = 0;
+  Props.fp64flags = 0;
+  Props.maxArgumentsSize = 2048;
+  Props.printfBufferSize = 4 << 20;
+  std::memset(&Props.nativeKernelSupported, 0,
+              sizeof(Props.nativeKernelSupported));
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeDeviceGetCommandQueueGroupProperties(
+    ze_device_handle_t hDevice, uint32_t *pCount,
+    ze_command_queue_group_properties_t *pCommandQueueGroupProperties) {
+  ZE_EMULATOR_CALL();
+  if (!hDevice || !pCount) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  // A compute group and a copy group, each with a single queue.
+  const ze_command_queue_group_property_flags_t Flags[] = {
+      ZE_COMMAND_QUEUE_GROUP_PROPERTY_FLAG_COMPUTE |
+          ZE_COMMAND_QUEUE_GROUP_PROPERTY_FLAG_COPY |
+          ZE_COMMAND_QUEUE_GROUP_PROPERTY_FLAG_COOPERATIVE_KERNELS,
+      ZE_COMMAND_QUEUE_GROUP_PROPERTY_FLAG_COPY};
+  if (*pCount == 0 || !pCommandQueueGroupProperties) {
+    *pCount = 2;
+    return ZE_RESULT_SUCCESS;
+  }
+  *pCount = std::min<uint32_t>(*pCount, 2);
+  for (uint32_t I = 0; I < *pCount; I++) {
+    pCommandQueueGroupProperties[I].flags = Flags[I];
+    pCommandQueueGroupProperties[I].maxMemoryFillPatternSize = 128;
+    pCommandQueueGroupProperties[I].numQueues = 1;
+  }
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeDeviceGetMemoryProperties(
+    ze_device_handle_t hDevice, uint32_t *pCount,
+    ze_device_memory_properties_t *pMemProperties) {
+  ZE_EMULATOR_CALL();
+  if (!hDevice || !pCount) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  if (*pCount == 0 || !pMemProperties) {
+    *pCount = 1;
+    return ZE_RESULT_SUCCESS;
+  }
+  *pCount = 1;
+  pMemProperties->flags = 0;
+  pMemProperties->maxClockRate = 1000;
+  pMemProperties->maxBusWidth = 64;
+  pMemProperties->totalSize = uint64_t{16} << 30;
+  std::strncpy(pMemProperties->name, "HBM", ZE_MAX_DEVICE_NAME - 1);
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeDeviceGetMemoryAccessProperties(
+    ze_device_handle_t hDevice,
+    ze_device_memory_access_properties_t *pMemAccessProperties) {
+  ZE_EMULATOR_CALL();
+  if (!hDevice || !pMemAccessProperties) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  const ze_memory_access_cap_flags_t All =
+      ZE_MEMORY_ACCESS_CAP_FLAG_RW | ZE_MEMORY_ACCESS_CAP_FLAG_ATOMIC |
+      ZE_MEMORY_ACCESS_CAP_FLAG_CONCURRENT |
+      ZE_MEMORY_ACCESS_CAP_FLAG_CONCURRENT_ATOMIC;
+  pMemAccessProperties->hostAllocCapabilities = All;
+  pMemAccessProperties->deviceAllocCapabilities = All;
+  pMemAccessProperties->sharedSingleDeviceAllocCapabilities = All;
+  pMemAccessProperties->sharedCrossDeviceAllocCapabilities = All;
+  pMemAccessProperties->sharedSystemAllocCapabilities = 0;
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeDeviceGetCacheProperties(
+    ze_device_handle_t hDevice, uint32_t *pCount,
+    ze_device_cache_properties_t *pCacheProperties) {
+  ZE_EMULATOR_CALL();
+  if (!hDevice || !pCount) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  if (*pCount == 0 || !pCacheProperties) {
+    *pCount = 1;
+    return ZE_RESULT_SUCCESS;
+  }
+  *pCount = 1;
+  pCacheProperties->flags = 0;
+  pCacheProperties->cacheSize = 4 << 20;
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL
+zeDeviceGetImageProperties(ze_device_handle_t hDevice,
+                           ze_device_image_properties_t *pImageProperties) {
+  ZE_EMULATOR_CALL();
+  if (!hDevice || !pImageProperties) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  // Images aren't emulated.
+  pImageProperties->maxImageDims1D = 0;
+  pImageProperties->maxImageDims2D = 0;
+  pImageProperties->maxImageDims3D = 0;
+  pImageProperties->maxImageBufferSize = 0;
+  pImageProperties->maxImageArraySlices = 0;
+  pImageProperties->maxSamplers = 0;
+  pImageProperties->maxReadImageArgs = 0;
+  pImageProperties->maxWriteImageArgs = 0;
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL
+zeDeviceGetP2PProperties(ze_device_handle_t hDevice,
+                         ze_device_handle_t hPeerDevice,
+                         ze_device_p2p_properties_t *pP2PProperties) {
+  ZE_EMULATOR_CALL();
+  if (!hDevice || !hPeerDevice || !pP2PProperties) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  pP2PProperties->flags =
+      ZE_DEVICE_P2P_PROPERTY_FLAG_ACCESS | ZE_DEVICE_P2P_PROPERTY_FLAG_ATOMICS;
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeDeviceCanAccessPeer(
+    ze_device_handle_t hDevice, ze_device_handle_t hPeerDevice,
+    ze_bool_t *value) {
+  ZE_EMULATOR_CALL();
+  if (!hDevice || !hPeerDevice || !value) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  *value = true;
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeDeviceGetGlobalTimestamps(
+    ze_device_handle_t hDevice, uint64_t *hostTimestamp,
+    uint64_t *deviceTimestamp) {
+  ZE_EMULATOR_CALL();
+  if (!hDevice || !hostTimestamp || !deviceTimestamp) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  *hostTimestamp = *deviceTimestamp = now();
+  return ZE_RESULT_SUCCESS;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Contexts and memory
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeContextCreate(
+    ze_driver_handle_t hDriver, const ze_context_desc_t *desc,
+    ze_context_handle_t *phContext) {
+  ZE_EMULATOR_CALL();
+  if (!hDriver || !desc || !phContext) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  spin(latencies().Create);
+  *phContext = new _ze_context_handle_t{hDriver};
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL
+zeContextDestroy(ze_context_handle_t hContext) {
+  ZE_EMULATOR_CALL();
+  if (!hContext) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  delete hContext;
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL
+zeContextMakeMemoryResident(ze_context_handle_t hContext,
+                            ze_device_handle_t hDevice, void *ptr,
+                            size_t /*size*/) {
+  ZE_EMULATOR_CALL();
+  if (!hContext || !hDevice || !ptr) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL
+zeMemAllocDevice(ze_context_handle_t hContext,
+                 const ze_device_mem_alloc_desc_t *device_desc, size_t size,
+                 size_t alignment, ze_device_handle_t hDevice, void **pptr) {
+  ZE_EMULATOR_CALL();
+  if (!hContext || !hDevice || !device_desc) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  return allocate(size, alignment, ZE_MEMORY_TYPE_DEVICE, hDevice, pptr);
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL
+zeMemAllocHost(ze_context_handle_t hContext,
+               const ze_host_mem_alloc_desc_t *host_desc, size_t size,
+               size_t alignment, void **pptr) {
+  ZE_EMULATOR_CALL();
+  if (!hContext || !host_desc) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  return allocate(size, alignment, ZE_MEMORY_TYPE_HOST, nullptr, pptr);
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeMemAllocShared(
+    ze_context_handle_t hContext, const ze_device_mem_alloc_desc_t *device_desc,
+    const ze_host_mem_alloc_desc_t *host_desc, size_t size, size_t alignment,
+    ze_device_handle_t hDevice, void **pptr) {
+  ZE_EMULATOR_CALL();
+  if (!hContext || !device_desc || !host_desc) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  return allocate(size, alignment, ZE_MEMORY_TYPE_SHARED, hDevice, pptr);
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeMemFree(ze_context_handle_t hContext,
+                                              void *ptr) {
+  ZE_EMULATOR_CALL();
+  if (!hContext || !ptr) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  state_t &State = state();
+  std::lock_guard<std::mutex> Lock(State.AllocsMutex);
+  if (!State.Allocs.erase(reinterpret_cast<uintptr_t>(ptr))) {
+    return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+  }
+  std::free(ptr);
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeMemGetAllocProperties(
+    ze_context_handle_t hContext, const void *ptr,
+    ze_memory_allocation_properties_t *pMemAllocProperties,
+    ze_device_handle_t *phDevice) {
+  ZE_EMULATOR_CALL();
+  if (!hContext || !pMemAllocProperties) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  std::lock_guard<std::mutex> Lock(state().AllocsMutex);
+  auto It = findAlloc(ptr);
+  const bool Found = It != state().Allocs.end();
+  pMemAllocProperties->type =
+      Found ? std::get<1>(It->second) : ZE_MEMORY_TYPE_UNKNOWN;
+  pMemAllocProperties->id = Found ? It->first : 0;
+  pMemAllocProperties->pageSize = Found ? 4096 : 0;
+  if (phDevice) {
+    *phDevice = Found ? std::get<2>(It->second) : nullptr;
+  }
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeMemGetAddressRange(
+    ze_context_handle_t hContext, const void *ptr, void **pBase,
+    size_t *pSize) {
+  ZE_EMULATOR_CALL();
+  if (!hContext) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  std::lock_guard<std::mutex> Lock(state().AllocsMutex);
+  auto It = findAlloc(ptr);
+  if (It == state().Allocs.end()) {
+    return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+  }
+  if (pBase) {
+    *pBase = reinterpret_cast<void *>(It->first);
+  }
+  if (pSize) {
+    *pSize = std::get<0>(It->second);
+  }
+  return ZE_RESULT_SUCCESS;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Command queues and command lists
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeCommandQueueCreate(
+    ze_context_handle_t hContext, ze_device_handle_t hDevice,
+    const ze_command_queue_desc_t *desc,
+    ze_command_queue_handle_t *phCommandQueue) {
+  ZE_EMULATOR_CALL();
+  if (!hContext || !hDevice || !desc || !phCommandQueue) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  spin(latencies().Create);
+  *phCommandQueue = new _ze_command_queue_handle_t{hContext, hDevice, {}};
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL
+zeCommandQueueDestroy(ze_command_queue_handle_t hCommandQueue) {
+  ZE_EMULATOR_CALL();
+  if (!hCommandQueue) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  delete hCommandQueue;
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeCommandQueueExecuteCommandLists(
+    ze_command_queue_handle_t hCommandQueue, uint32_t numCommandLists,
+    ze_command_list_handle_t *phCommandLists, ze_fence_handle_t hFence) {
+  ZE_EMULATOR_CALL();
+  if (!hCommandQueue || !phCommandLists) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  for (uint32_t I = 0; I < numCommandLists; I++) {
+    if (!phCommandLists[I]->Closed) {
+      return ZE_RESULT_ERROR_INVALID_COMMAND_LIST_TYPE;
+    }
+  }
+  spin(latencies().Submit);
+  for (uint32_t I = 0; I < numCommandLists; I++) {
+    for (const command_t &Command : phCommandLists[I]->Commands) {
+      submit(hCommandQueue->Engine, Command);
+    }
+  }
+  if (hFence) {
+    hCommandQueue->Engine.submit([hFence] {
+      {
+        std::lock_guard<std::mutex> Lock(state().EventMutex);
+        hFence->Signaled = true;
+      }
+      state().EventCV.notify_all();
+    });
+  }
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeCommandQueueSynchronize(
+    ze_command_queue_handle_t hCommandQueue, uint64_t timeout) {
+  ZE_EMULATOR_CALL();
+  if (!hCommandQueue) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  return hCommandQueue->Engine.wait(timeout) ? ZE_RESULT_SUCCESS
+                                             : ZE_RESULT_NOT_READY;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeCommandListCreate(
+    ze_context_handle_t hContext, ze_device_handle_t hDevice,
+    const ze_command_list_desc_t *desc,
+    ze_command_list_handle_t *phCommandList) {
+  ZE_EMULATOR_CALL();
+  if (!hContext || !hDevice || !desc || !phCommandList) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  spin(latencies().Create);
+  *phCommandList = new _ze_command_list_handle_t{
+      hContext, hDevice, nullptr, {}, desc->commandQueueGroupOrdinal};
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeCommandListCreateImmediate(
+    ze_context_handle_t hContext, ze_device_handle_t hDevice,
+    const ze_command_queue_desc_t *altdesc,
+    ze_command_list_handle_t *phCommandList) {
+  ZE_EMULATOR_CALL();
+  if (!hContext || !hDevice || !altdesc || !phCommandList) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  spin(latencies().Create);
+  *phCommandList = new _ze_command_list_handle_t{
+      hContext, hDevice, std::make_unique<engine_t>(), {}, altdesc->ordinal,
+      altdesc->index};
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeCommandListGetDeviceHandle(
+    ze_command_list_handle_t hCommandList, ze_device_handle_t *phDevice) {
+  ZE_EMULATOR_CALL();
+  if (!hCommandList) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  if (!phDevice) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  *phDevice = hCommandList->Device;
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeCommandListGetOrdinal(
+    ze_command_list_handle_t hCommandList, uint32_t *pOrdinal) {
+  ZE_EMULATOR_CALL();
+  if (!hCommandList) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  if (!pOrdinal) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  *pOrdinal = hCommandList->Ordinal;
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeCommandListImmediateGetIndex(
+    ze_command_list_handle_t hCommandListImmediate, uint32_t *pIndex) {
+  ZE_EMULATOR_CALL();
+  if (!hCommandListImmediate) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  if (!pIndex) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  if (!hCommandListImmediate->Engine) {
+    return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+  }
+  *pIndex = hCommandListImmediate->Index;
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL
+zeCommandListDestroy(ze_command_list_handle_t hCommandList) {
+  ZE_EMULATOR_CALL();
+  if (!hCommandList) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  delete hCommandList;
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL
+zeCommandListClose(ze_command_list_handle_t hCommandList) {
+  ZE_EMULATOR_CALL();
+  if (!hCommandList) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  hCommandList->Closed = !hCommandList->Engine;
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL
+zeCommandListReset(ze_command_list_handle_t hCommandList) {
+  ZE_EMULATOR_CALL();
+  if (!hCommandList) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  if (hCommandList->Engine) {
+    hCommandList->Engine->wait(UINT64_MAX);
+  }
+  hCommandList->Commands.clear();
+  hCommandList->Closed = false;
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeCommandListHostSynchronize(
+    ze_command_list_handle_t hCommandList, uint64_t timeout) {
+  ZE_EMULATOR_CALL();
+  if (!hCommandList) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  if (!hCommandList->Engine) {
+    return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+  }
+  return hCommandList->Engine->wait(timeout) ? ZE_RESULT_SUCCESS
+                                             : ZE_RESULT_NOT_READY;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeCommandListImmediateAppendCommandListsExp(
+    ze_command_list_handle_t hCommandListImmediate, uint32_t numCommandLists,
+    ze_command_list_handle_t *phCommandLists, ze_event_handle_t hSignalEvent,
+    uint32_t numWaitEvents, ze_event_handle_t *phWaitEvents) {
+  ZE_EMULATOR_CALL();
+  if (!hCommandListImmediate || !phCommandLists) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  if (!hCommandListImmediate->Engine) {
+    return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+  }
+  spin(latencies().Submit);
+  engine_t &Engine = *hCommandListImmediate->Engine;
+  submit(Engine, {{phWaitEvents, phWaitEvents + numWaitEvents}, {}, nullptr});
+  for (uint32_t I = 0; I < numCommandLists; I++) {
+    for (const command_t &Command : phCommandLists[I]->Commands) {
+      submit(Engine, Command);
+    }
+  }
+  submit(Engine, {{}, {}, hSignalEvent});
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeCommandListAppendBarrier(
+    ze_command_list_handle_t hCommandList, ze_event_handle_t hSignalEvent,
+    uint32_t numWaitEvents, ze_event_handle_t *phWaitEvents) {
+  ZE_EMULATOR_CALL();
+  // Commands already run in order, so barriers only wait and signal.
+  return append(hCommandList, {{}, {}, hSignalEvent}, numWaitEvents,
+                phWaitEvents);
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeCommandListAppendMemoryCopy(
+    ze_command_list_handle_t hCommandList, void *dstptr, const void *srcptr,
+    size_t size, ze_event_handle_t hSignalEvent, uint32_t numWaitEvents,
+    ze_event_handle_t *phWaitEvents) {
+  ZE_EMULATOR_CALL();
+  if (!dstptr || !srcptr) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  return append(hCommandList,
+                {{}, [=] { std::memmove(dstptr, srcptr, size); }, hSignalEvent},
+                numWaitEvents, phWaitEvents);
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeCommandListAppendMemoryFill(
+    ze_command_list_handle_t hCommandList, void *ptr, const void *pattern,
+    size_t pattern_size, size_t size, ze_event_handle_t hSignalEvent,
+    uint32_t numWaitEvents, ze_event_handle_t *phWaitEvents) {
+  ZE_EMULATOR_CALL();
+  if (!ptr || !pattern) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  if (pattern_size == 0 || size % pattern_size) {
+    return ZE_RESULT_ERROR_INVALID_SIZE;
+  }
+  const auto *PatternBytes = static_cast<const uint8_t *>(pattern);
+  std::vector<uint8_t> Pattern(PatternBytes, PatternBytes + pattern_size);
+  return append(hCommandList,
+                {{},
+                 [=] {
+                   auto *Dst = static_cast<uint8_t *>(ptr);
+                   for (size_t I = 0; I < size; I += Pattern.size()) {
+                     std::memcpy(Dst + I, Pattern.data(), Pattern.size());
+                   }
+                 },
+                 hSignalEvent},
+                numWaitEvents, phWaitEvents);
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeCommandListAppendMemoryCopyRegion(
+    ze_command_list_handle_t hCommandList, void *dstptr,
+    const ze_copy_region_t *dstRegion, uint32_t dstPitch,
+    uint32_t dstSlicePitch, const void *srcptr,
+    const ze_copy_region_t *srcRegion, uint32_t srcPitch,
+    uint32_t srcSlicePitch, ze_event_handle_t hSignalEvent,
+    uint32_t numWaitEvents, ze_event_handle_t *phWaitEvents) {
+  ZE_EMULATOR_CALL();
+  if (!dstptr || !srcptr || !dstRegion || !srcRegion) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  const ze_copy_region_t Dst = *dstRegion, Src = *srcRegion;
+  return append(
+      hCommandList,
+      {{},
+       [=] {
+         for (uint32_t Z = 0; Z < Src.depth; Z++) {
+           for (uint32_t Y = 0; Y < Src.height; Y++) {
+             const size_t DstOffset = size_t{Dst.originZ + Z} * dstSlicePitch +
+                                      size_t{Dst.originY + Y} * dstPitch +
+                                      Dst.originX;
+             const size_t SrcOffset = size_t{Src.originZ + Z} * srcSlicePitch +
+                                      size_t{Src.originY + Y} * srcPitch +
+                                      Src.originX;
+             std::memmove(static_cast<uint8_t *>(dstptr) + DstOffset,
+                          static_cast<const uint8_t *>(srcptr) + SrcOffset,
+                          Src.width);
+           }
+         }
+       },
+       hSignalEvent},
+      numWaitEvents, phWaitEvents);
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeCommandListAppendMemoryPrefetch(
+    ze_command_list_handle_t hCommandList, const void *ptr, size_t /*size*/) {
+  ZE_EMULATOR_CALL();
+  if (!hCommandList || !ptr) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeCommandListAppendMemAdvise(
+    ze_command_list_handle_t hCommandList, ze_device_handle_t hDevice,
+    const void *ptr, size_t /*size*/, ze_memory_advice_t /*advice*/) {
+  ZE_EMULATOR_CALL();
+  if (!hCommandList || !hDevice || !ptr) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeCommandListAppendSignalEvent(
+    ze_command_list_handle_t hCommandList, ze_event_handle_t hEvent) {
+  ZE_EMULATOR_CALL();
+  if (!hEvent) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  return append(hCommandList, {{}, {}, hEvent}, 0, nullptr);
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeCommandListAppendWaitOnEvents(
+    ze_command_list_handle_t hCommandList, uint32_t numEvents,
+    ze_event_handle_t *phEvents) {
+  ZE_EMULATOR_CALL();
+  return append(hCommandList, {}, numEvents, phEvents);
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeCommandListAppendEventReset(
+    ze_command_list_handle_t hCommandList, ze_event_handle_t hEvent) {
+  ZE_EMULATOR_CALL();
+  if (!hEvent) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  return append(hCommandList,
+                {{},
+                 [hEvent] {
+                   std::lock_guard<std::mutex> Lock(state().EventMutex);
+                   hEvent->Signaled = false;
+                 },
+                 nullptr},
+                0, nullptr);
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeCommandListAppendLaunchKernel(
+    ze_command_list_handle_t hCommandList, ze_kernel_handle_t hKernel,
+    const ze_group_count_t *pLaunchFuncArgs, ze_event_handle_t hSignalEvent,
+    uint32_t numWaitEvents, ze_event_handle_t *phWaitEvents) {
+  ZE_EMULATOR_CALL();
+  return appendLaunch(hCommandList, hKernel, pLaunchFuncArgs, hSignalEvent,
+                      numWaitEvents, phWaitEvents);
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeCommandListAppendLaunchCooperativeKernel(
+    ze_command_list_handle_t hCommandList, ze_kernel_handle_t hKernel,
+    const ze_group_count_t *pLaunchFuncArgs, ze_event_handle_t hSignalEvent,
+    uint32_t numWaitEvents, ze_event_handle_t *phWaitEvents) {
+  ZE_EMULATOR_CALL();
+  return appendLaunch(hCommandList, hKernel, pLaunchFuncArgs, hSignalEvent,
+                      numWaitEvents, phWaitEvents);
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeCommandListAppendWriteGlobalTimestamp(
+    ze_command_list_handle_t hCommandList, uint64_t *dstptr,
+    ze_event_handle_t hSignalEvent, uint32_t numWaitEvents,
+    ze_event_handle_t *phWaitEvents) {
+  ZE_EMULATOR_CALL();
+  if (!dstptr) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  return append(hCommandList, {{}, [dstptr] { *dstptr = now(); }, hSignalEvent},
+                numWaitEvents, phWaitEvents);
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeCommandListAppendQueryKernelTimestamps(
+    ze_command_list_handle_t hCommandList, uint32_t numEvents,
+    ze_event_handle_t *phEvents, void *dstptr, const size_t *pOffsets,
+    ze_event_handle_t hSignalEvent, uint32_t numWaitEvents,
+    ze_event_handle_t *phWaitEvents) {
+  ZE_EMULATOR_CALL();
+  if (!phEvents || !dstptr) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  std::vector<ze_event_handle_t> Events(phEvents, phEvents + numEvents);
+  std::vector<size_t> Offsets;
+  if (pOffsets) {
+    Offsets.assign(pOffsets, pOffsets + numEvents);
+  }
+  return append(
+      hCommandList,
+      {{},
+       [=] {
+         std::lock_guard<std::mutex> Lock(state().EventMutex);
+         for (size_t I = 0; I < Events.size(); I++) {
+           ze_kernel_timestamp_result_t Result{};
+           Result.global = {Events[I]->Start, Events[I]->End};
+           Result.context = Result.global;
+           const size_t Offset =
+               Offsets.empty() ? I * sizeof(Result) : Offsets[I];
+           std::memcpy(static_cast<uint8_t *>(dstptr) + Offset, &Result,
+                       sizeof(Result));
+         }
+       },
+       hSignalEvent},
+      numWaitEvents, phWaitEvents);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Events and fences
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeEventPoolCreate(
+    ze_context_handle_t hContext, const ze_event_pool_desc_t *desc,
+    uint32_t /*numDevices*/, ze_device_handle_t * /*phDevices*/,
+    ze_event_pool_handle_t *phEventPool) {
+  ZE_EMULATOR_CALL();
+  if (!hContext || !desc || !phEventPool) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  if (desc->count == 0) {
+    return ZE_RESULT_ERROR_INVALID_SIZE;
+  }
+  spin(latencies().Create);
+  const bool CounterBased =
+      findExtension<ze_event_pool_counter_based_exp_desc_t>(
+          desc, ZE_STRUCTURE_TYPE_COUNTER_BASED_EVENT_POOL_EXP_DESC) !=
+      nullptr;
+  *phEventPool = new _ze_event_pool_handle_t{hContext, desc->flags,
+                                             desc->count, CounterBased};
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL
+zeEventPoolDestroy(ze_event_pool_handle_t hEventPool) {
+  ZE_EMULATOR_CALL();
+  if (!hEventPool) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  delete hEventPool;
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL
+zeEventCreate(ze_event_pool_handle_t hEventPool, const ze_event_desc_t *desc,
+              ze_event_handle_t *phEvent) {
+  ZE_EMULATOR_CALL();
+  if (!hEventPool || !desc) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  if (desc->index >= hEventPool->Count) {
+    return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+  }
+  return createEvent(hEventPool, hEventPool->CounterBased,
+                     hEventPool->Flags & ZE_EVENT_POOL_FLAG_KERNEL_TIMESTAMP,
+                     phEvent);
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeEventDestroy(ze_event_handle_t hEvent) {
+  ZE_EMULATOR_CALL();
+  if (!hEvent) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  delete hEvent;
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL
+zeEventHostSignal(ze_event_handle_t hEvent) {
+  ZE_EMULATOR_CALL();
+  if (!hEvent) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  const uint64_t Now = now();
+  signalEvent(hEvent, Now, Now);
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL
+zeEventHostSynchronize(ze_event_handle_t hEvent, uint64_t timeout) {
+  ZE_EMULATOR_CALL();
+  if (!hEvent) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  state_t &State = state();
+  std::unique_lock<std::mutex> Lock(State.EventMutex);
+  auto Signaled = [hEvent] { return hEvent->Signaled; };
+  if (timeout == UINT64_MAX) {
+    State.EventCV.wait(Lock, Signaled);
+    return ZE_RESULT_SUCCESS;
+  }
+  return State.EventCV.wait_for(Lock, std::chrono::nanoseconds(timeout),
+                                Signaled)
+             ? ZE_RESULT_SUCCESS
+             : ZE_RESULT_NOT_READY;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL
+zeEventQueryStatus(ze_event_handle_t hEvent) {
+  ZE_EMULATOR_CALL();
+  if (!hEvent) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  std::lock_guard<std::mutex> Lock(state().EventMutex);
+  return hEvent->Signaled ? ZE_RESULT_SUCCESS : ZE_RESULT_NOT_READY;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeEventHostReset(ze_event_handle_t hEvent) {
+  ZE_EMULATOR_CALL();
+  if (!hEvent) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  if (hEvent->CounterBased) {
+    return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+  }
+  std::lock_guard<std::mutex> Lock(state().EventMutex);
+  hEvent->Signaled = false;
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeEventQueryKernelTimestamp(
+    ze_event_handle_t hEvent, ze_kernel_timestamp_result_t *dstptr) {
+  ZE_EMULATOR_CALL();
+  if (!hEvent || !dstptr) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  std::lock_guard<std::mutex> Lock(state().EventMutex);
+  if (!hEvent->Signaled) {
+    return ZE_RESULT_NOT_READY;
+  }
+  dstptr->global = {hEvent->Start, hEvent->End};
+  dstptr->context = dstptr->global;
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL
+zeFenceCreate(ze_command_queue_handle_t hCommandQueue,
+              const ze_fence_desc_t *desc, ze_fence_handle_t *phFence) {
+  ZE_EMULATOR_CALL();
+  if (!hCommandQueue || !desc || !phFence) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  const bool Signaled = (desc->flags & ZE_FENCE_FLAG_SIGNALED) != 0;
+  *phFence = new _ze_fence_handle_t{hCommandQueue, Signaled};
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeFenceDestroy(ze_fence_handle_t hFence) {
+  ZE_EMULATOR_CALL();
+  if (!hFence) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  delete hFence;
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL
+zeFenceHostSynchronize(ze_fence_handle_t hFence, uint64_t timeout) {
+  ZE_EMULATOR_CALL();
+  if (!hFence) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  state_t &State = state();
+  std::unique_lock<std::mutex> Lock(State.EventMutex);
+  auto Signaled = [hFence] { return hFence->Signaled; };
+  if (timeout == UINT64_MAX) {
+    State.EventCV.wait(Lock, Signaled);
+    return ZE_RESULT_SUCCESS;
+  }
+  return State.EventCV.wait_for(Lock, std::chrono::nanoseconds(timeout),
+                                Signaled)
+             ? ZE_RESULT_SUCCESS
+             : ZE_RESULT_NOT_READY;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL
+zeFenceQueryStatus(ze_fence_handle_t hFence) {
+  ZE_EMULATOR_CALL();
+  if (!hFence) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  std::lock_guard<std::mutex> Lock(state().EventMutex);
+  return hFence->Signaled ? ZE_RESULT_SUCCESS : ZE_RESULT_NOT_READY;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeFenceReset(ze_fence_handle_t hFence) {
+  ZE_EMULATOR_CALL();
+  if (!hFence) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  std::lock_guard<std::mutex> Lock(state().EventMutex);
+  hFence->Signaled = false;
+  return ZE_RESULT_SUCCESS;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Modules and kernels
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeModuleCreate(
+    ze_context_handle_t hContext, ze_device_handle_t hDevice,
+    const ze_module_desc_t *desc, ze_module_handle_t *phModule,
+    ze_module_build_log_handle_t *phBuildLog) {
+  ZE_EMULATOR_CALL();
+  if (!hContext || !hDevice || !desc || !phModule) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  spin(latencies().Create);
+  // The binary is ignored; all registered kernels are available.
+  *phModule = new _ze_module_handle_t{hContext, hDevice};
+  if (phBuildLog) {
+    *phBuildLog = new _ze_module_build_log_handle_t;
+  }
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL
+zeModuleDestroy(ze_module_handle_t hModule) {
+  ZE_EMULATOR_CALL();
+  if (!hModule) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  delete hModule;
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL
+zeModuleBuildLogDestroy(ze_module_build_log_handle_t hModuleBuildLog) {
+  ZE_EMULATOR_CALL();
+  if (!hModuleBuildLog) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  delete hModuleBuildLog;
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeModuleBuildLogGetString(
+    ze_module_build_log_handle_t hModuleBuildLog, size_t *pSize,
+    char *pBuildLog) {
+  ZE_EMULATOR_CALL();
+  if (!hModuleBuildLog || !pSize) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  if (pBuildLog && *pSize) {
+    pBuildLog[0] = '\0';
+  }
+  *pSize = 1;
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeModuleGetKernelNames(
+    ze_module_handle_t hModule, uint32_t *pCount, const char **pNames) {
+  ZE_EMULATOR_CALL();
+  if (!hModule) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  state_t &State = state();
+  std::lock_guard<std::mutex> Lock(State.KernelsMutex);
+  std::vector<const char *> Names;
+  for (auto &Kernel : State.Kernels) {
+    Names.push_back(Kernel.first.c_str());
+  }
+  return returnArray(pCount, pNames, Names);
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeModuleGetProperties(
+    ze_module_handle_t hModule, ze_module_properties_t *pModuleProperties) {
+  ZE_EMULATOR_CALL();
+  if (!hModule || !pModuleProperties) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  pModuleProperties->flags = 0;
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeModuleGetGlobalPointer(
+    ze_module_handle_t hModule, const char *pGlobalName, size_t * /*pSize*/,
+    void ** /*pptr*/) {
+  ZE_EMULATOR_CALL();
+  if (!hModule || !pGlobalName) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  return ZE_RESULT_ERROR_INVALID_GLOBAL_NAME;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeKernelCreate(
+    ze_module_handle_t hModule, const ze_kernel_desc_t *desc,
+    ze_kernel_handle_t *phKernel) {
+  ZE_EMULATOR_CALL();
+  if (!hModule || !desc || !desc->pKernelName || !phKernel) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  state_t &State = state();
+  std::lock_guard<std::mutex> Lock(State.KernelsMutex);
+  auto It = State.Kernels.find(desc->pKernelName);
+  if (It == State.Kernels.end()) {
+    return ZE_RESULT_ERROR_INVALID_KERNEL_NAME;
+  }
+  auto &[NumArgs, Function] = It->second;
+  *phKernel = new _ze_kernel_handle_t{
+      It->first, NumArgs, Function,
+      std::vector<std::vector<uint8_t>>(NumArgs)};
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL
+zeKernelDestroy(ze_kernel_handle_t hKernel) {
+  ZE_EMULATOR_CALL();
+  if (!hKernel) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  delete hKernel;
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL
+zeKernelSetArgumentValue(ze_kernel_handle_t hKernel, uint32_t argIndex,
+                         size_t argSize, const void *pArgValue) {
+  ZE_EMULATOR_CALL();
+  if (!hKernel) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  if (argIndex >= hKernel->NumArgs) {
+    return ZE_RESULT_ERROR_INVALID_KERNEL_ARGUMENT_INDEX;
+  }
+  // Local memory arguments have no value; they are passed as zeroes.
+  auto &Arg = hKernel->Args[argIndex];
+  Arg.assign(argSize, 0);
+  if (pArgValue) {
+    std::memcpy(Arg.data(), pArgValue, argSize);
+  }
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeKernelSetGroupSize(
+    ze_kernel_handle_t hKernel, uint32_t groupSizeX, uint32_t groupSizeY,
+    uint32_t groupSizeZ) {
+  ZE_EMULATOR_CALL();
+  if (!hKernel) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  hKernel->GroupSize = {groupSizeX, groupSizeY, groupSizeZ};
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeKernelSetGlobalOffsetExp(
+    ze_kernel_handle_t hKernel, uint32_t offsetX, uint32_t offsetY,
+    uint32_t offsetZ) {
+  ZE_EMULATOR_CALL();
+  if (!hKernel) {
+    return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  hKernel->GlobalOffset = {offsetX, offsetY, offsetZ};
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeKernelSuggestGroupSize(
+    ze_kernel_handle_t hKernel, uint32_t globalSizeX, uint32_t globalSizeY,
+    uint32_t globalSizeZ, uint32_t *groupSizeX, uint32_t *groupSizeY,
+    uint32_t *groupSizeZ) {
+  ZE_EMULATOR_CALL();
+  if (!hKernel || !groupSizeX || !groupSizeY || !groupSizeZ) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  // The largest power of two up to 64 dividing each dimension.
+  auto suggest = [](uint32_t GlobalSize) {
+    uint32_t Size = 64;
+    while (Size > 1 && GlobalSize % Size) {
+      Size /= 2;
+    }
+    return Size;
+  };
+  *groupSizeX = suggest(globalSizeX);
+  *groupSizeY = suggest(globalSizeY);
+  *groupSizeZ = suggest(globalSizeZ);
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeKernelSuggestMaxCooperativeGroupCount(
+    ze_kernel_handle_t hKernel, uint32_t *totalGroupCount) {
+  ZE_EMULATOR_CALL();
+  if (!hKernel || !totalGroupCount) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  *totalGroupCount = 32;
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeKernelGetProperties(
+    ze_kernel_handle_t hKernel, ze_kernel_properties_t *pKernelProperties) {
+  ZE_EMULATOR_CALL();
+  if (!hKernel || !pKernelProperties) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  ze_kernel_properties_t &Props = *pKernelProperties;
+  Props.numKernelArgs = hKernel->NumArgs;
+  Props.requiredGroupSizeX = 0;
+  Props.requiredGroupSizeY = 0;
+  Props.requiredGroupSizeZ = 0;
+  Props.requiredNumSubGroups = 0;
+  Props.requiredSubgroupSize = 0;
+  Props.maxSubgroupSize = 32;
+  Props.maxNumSubgroups = 64;
+  Props.localMemSize = 0;
+  Props.privateMemSize = 0;
+  Props.spillMemSize = 0;
+  std::memset(&Props.uuid, 0, sizeof(Props.uuid));
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeKernelGetName(ze_kernel_handle_t hKernel,
+                                                    size_t *pSize,
+                                                    char *pName) {
+  ZE_EMULATOR_CALL();
+  if (!hKernel || !pSize) {
+    return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  if (pName) {
+    std::memcpy(pName, hKernel->Name.c_str(),
+                std::min(*pSize, hKernel->Name.size() + 1));
+  }
+  *pSize = hKernel->Name.size() + 1;
+  return ZE_RESULT_SUCCESS;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeKernelSetIndirectAccess(
+    ze_kernel_handle_t hKernel, ze_kernel_indirect_access_flags_t /*flags*/) {
+  ZE_EMULATOR_CALL();
+  return hKernel ? ZE_RESULT_SUCCESS : ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeKernelSetCacheConfig(
+    ze_kernel_handle_t hKernel, ze_cache_config_flags_t /*flags*/) {
+  ZE_EMULATOR_CALL();
+  return hKernel ? ZE_RESULT_SUCCESS : ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+}
+
+} // extern "C"
@@ -0,0 +1,83 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// The Level Zero emulator implements the subset of the ze* API used by the
+// Level Zero adapters on the host, so that their logic can be tested and
+// profiled without Intel GPUs. Link it instead of the Level Zero loader, or
+// preload it (LD_PRELOAD) in front of it.
+//
+// Devices share host memory, so every USM allocation is plain malloc'ed memory.
+// Each immediate command list and command queue executes its commands in
+// order on its own host thread, and kernels are host functions registered by
+// name; every module exposes all registered kernels.
+namespace ze_emulator {
+
+// Artificial costs added to driver calls, emulated by busy-waiting so that
+// they are accurate at microsecond scale.
+struct latencies_t {
+  // Creation of contexts, command lists, queues, event pools and modules.
+  std::chrono::nanoseconds Create{0};
+  // Every append to a command list.
+  std::chrono::nanoseconds Append{0};
+  // Submission of command lists to a queue, paid by the calling thread.
+  std::chrono::nanoseconds Submit{0};
+  // Execution of every command on the host thread of its queue.
+  std::chrono::nanoseconds Execute{0};
+};
+
+struct config_t {
+  // Number of root devices, read by the first zeInit or zeInitDrivers.
+  uint32_t NumDevices = 1;
+  latencies_t Latency;
+};
+
+// Returns the current configuration. The defaults can be overridden with
+// ZE_EMULATOR_DEVICES and ZE_EMULATOR_{CREATE,APPEND,SUBMIT,EXECUTE}_LATENCY_NS.
+config_t getConfig();
+void setConfig(const config_t &Config);
+
+// Number of calls made to the ze* function Name since the last reset.
+uint64_t getCallCount(std::string_view Name);
+// Counts of all functions called at least once since the last reset.
+std::map<std::string, uint64_t> getCallCounts();
+void resetCallCounts();
+
+// Launch of a host kernel. Args holds the bytes of every argument, pointers
+// included, as set by zeKernelSetArgumentValue.
+struct launch_t {
+  std::vector<std::vector<uint8_t>> Args;
+  std::array<uint32_t, 3> GroupCount;
+  std::array<uint32_t, 3> GroupSize;
+  std::array<uint32_t, 3> GlobalOffset;
+
+  template <typename T> T arg(size_t Index) const {
+    T Value;
+    std::memcpy(&Value, Args.at(Index).data(), sizeof(T));
+    return Value;
+  }
+};
+
+// A host kernel runs once per launch, covering all work-groups itself.
+using kernel_t = std::function<void(const launch_t &)>;
+
+// Registers Kernel under Name, replacing any kernel of that name. NumArgs is
+// reported by zeKernelGetProperties.
+void registerKernel(const std::string &Name, uint32_t NumArgs,
+                    kernel_t Kernel);
+
+} // namespace ze_emulator
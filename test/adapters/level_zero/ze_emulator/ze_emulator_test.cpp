@@ -0,0 +1,368 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "ze_emulator.hpp"
+
+#include <gtest/gtest.h>
+#include <ze_api.h>
+
+#include <atomic>
+#include <numeric>
+
+namespace {
+
+struct zeEmulatorTest : ::testing::Test {
+  void SetUp() override {
+    ze_emulator::setConfig({});
+    ASSERT_EQ(zeInit(ZE_INIT_FLAG_GPU_ONLY), ZE_RESULT_SUCCESS);
+
+    uint32_t Count = 1;
+    ASSERT_EQ(zeDriverGet(&Count, &Driver), ZE_RESULT_SUCCESS);
+    Count = 1;
+    ASSERT_EQ(zeDeviceGet(Driver, &Count, &Device), ZE_RESULT_SUCCESS);
+
+    ze_context_desc_t ContextDesc{ZE_STRUCTURE_TYPE_CONTEXT_DESC, nullptr, 0};
+    ASSERT_EQ(zeContextCreate(Driver, &ContextDesc, &Context),
+              ZE_RESULT_SUCCESS);
+
+    ze_command_queue_desc_t QueueDesc{};
+    QueueDesc.stype = ZE_STRUCTURE_TYPE_COMMAND_QUEUE_DESC;
+    QueueDesc.mode = ZE_COMMAND_QUEUE_MODE_ASYNCHRONOUS;
+    ASSERT_EQ(
+        zeCommandListCreateImmediate(Context, Device, &QueueDesc, &Immediate),
+        ZE_RESULT_SUCCESS);
+
+    ze_emulator::resetCallCounts();
+  }
+
+  void TearDown() override {
+    zeCommandListDestroy(Immediate);
+    zeContextDestroy(Context);
+  }
+
+  void *allocShared(size_t Size) {
+    ze_device_mem_alloc_desc_t DeviceDesc{};
+    DeviceDesc.stype = ZE_STRUCTURE_TYPE_DEVICE_MEM_ALLOC_DESC;
+    ze_host_mem_alloc_desc_t HostDesc{};
+    HostDesc.stype = ZE_STRUCTURE_TYPE_HOST_MEM_ALLOC_DESC;
+    void *Ptr = nullptr;
+    EXPECT_EQ(zeMemAllocShared(Context, &DeviceDesc, &HostDesc, Size, 0,
+                               Device, &Ptr),
+              ZE_RESULT_SUCCESS);
+    return Ptr;
+  }
+
+  ze_event_pool_handle_t createEventPool(uint32_t Count, bool CounterBased) {
+    ze_event_pool_counter_based_exp_desc_t CounterBasedDesc{};
+    CounterBasedDesc.stype = ZE_STRUCTURE_TYPE_COUNTER_BASED_EVENT_POOL_EXP_DESC;
+    CounterBasedDesc.flags = ZE_EVENT_POOL_COUNTER_BASED_EXP_FLAG_IMMEDIATE;
+    ze_event_pool_desc_t Desc{};
+    Desc.stype = ZE_STRUCTURE_TYPE_EVENT_POOL_DESC;
+    Desc.pNext = CounterBased ? &CounterBasedDesc : nullptr;
+    Desc.flags = ZE_EVENT_POOL_FLAG_HOST_VISIBLE;
+    Desc.count = Count;
+    ze_event_pool_handle_t Pool = nullptr;
+    EXPECT_EQ(zeEventPoolCreate(Context, &Desc, 1, &Device, &Pool),
+              ZE_RESULT_SUCCESS);
+    return Pool;
+  }
+
+  ze_event_handle_t createEvent(ze_event_pool_handle_t Pool, uint32_t Index) {
+    ze_event_desc_t Desc{};
+    Desc.stype = ZE_STRUCTURE_TYPE_EVENT_DESC;
+    Desc.index = Index;
+    ze_event_handle_t Event = nullptr;
+    EXPECT_EQ(zeEventCreate(Pool, &Desc, &Event), ZE_RESULT_SUCCESS);
+    return Event;
+  }
+
+  ze_driver_handle_t Driver = nullptr;
+  ze_device_handle_t Device = nullptr;
+  ze_context_handle_t Context = nullptr;
+  ze_command_list_handle_t Immediate = nullptr;
+};
+
+} // namespace
+
+TEST_F(zeEmulatorTest, deviceProperties) {
+  ze_device_properties_t Props{};
+  Props.stype = ZE_STRUCTURE_TYPE_DEVICE_PROPERTIES;
+  ASSERT_EQ(zeDeviceGetProperties(Device, &Props), ZE_RESULT_SUCCESS);
+  EXPECT_EQ(Props.type, ZE_DEVICE_TYPE_GPU);
+  EXPECT_EQ(Props.stype, ZE_STRUCTURE_TYPE_DEVICE_PROPERTIES);
+
+  uint32_t Count = 0;
+  ASSERT_EQ(zeDeviceGetCommandQueueGroupProperties(Device, &Count, nullptr),
+            ZE_RESULT_SUCCESS);
+  EXPECT_EQ(Count, 2u);
+}
+
+TEST_F(zeEmulatorTest, allocProperties) {
+  auto *Ptr = static_cast<uint8_t *>(allocShared(100));
+  ASSERT_NE(Ptr, nullptr);
+
+  ze_memory_allocation_properties_t Props{};
+  ze_device_handle_t AllocDevice = nullptr;
+  ASSERT_EQ(zeMemGetAllocProperties(Context, Ptr + 10, &Props, &AllocDevice),
+            ZE_RESULT_SUCCESS);
+  EXPECT_EQ(Props.type, ZE_MEMORY_TYPE_SHARED);
+  EXPECT_EQ(AllocDevice, Device);
+
+  void *Base = nullptr;
+  size_t Size = 0;
+  ASSERT_EQ(zeMemGetAddressRange(Context, Ptr + 99, &Base, &Size),
+            ZE_RESULT_SUCCESS);
+  EXPECT_EQ(Base, Ptr);
+  EXPECT_EQ(Size, 100u);
+
+  int Stack = 0;
+  ASSERT_EQ(zeMemGetAllocProperties(Context, &Stack, &Props, nullptr),
+            ZE_RESULT_SUCCESS);
+  EXPECT_EQ(Props.type, ZE_MEMORY_TYPE_UNKNOWN);
+
+  ASSERT_EQ(zeMemFree(Context, Ptr), ZE_RESULT_SUCCESS);
+}
+
+TEST_F(zeEmulatorTest, fillAndCopy) {
+  constexpr size_t Size = 1024;
+  auto *Src = static_cast<uint32_t *>(allocShared(Size));
+  auto *Dst = static_cast<uint32_t *>(allocShared(Size));
+
+  const uint32_t Pattern = 0xdeadbeef;
+  ASSERT_EQ(zeCommandListAppendMemoryFill(Immediate, Src, &Pattern,
+                                          sizeof(Pattern), Size, nullptr, 0,
+                                          nullptr),
+            ZE_RESULT_SUCCESS);
+  ASSERT_EQ(zeCommandListAppendMemoryCopy(Immediate, Dst, Src, Size, nullptr,
+                                          0, nullptr),
+            ZE_RESULT_SUCCESS);
+  ASSERT_EQ(zeCommandListHostSynchronize(Immediate, UINT64_MAX),
+            ZE_RESULT_SUCCESS);
+
+  for (size_t I = 0; I < Size / sizeof(uint32_t); I++) {
+    ASSERT_EQ(Dst[I], Pattern) << "at " << I;
+  }
+
+  zeMemFree(Context, Src);
+  zeMemFree(Context, Dst);
+}
+
+TEST_F(zeEmulatorTest, eventDependencies) {
+  ze_event_pool_handle_t Pool = createEventPool(2, false);
+  ze_event_handle_t Gate = createEvent(Pool, 0);
+  ze_event_handle_t Done = createEvent(Pool, 1);
+  EXPECT_EQ(zeEventQueryStatus(Gate), ZE_RESULT_NOT_READY);
+
+  auto *Value = static_cast<uint32_t *>(allocShared(sizeof(uint32_t)));
+  *Value = 0;
+  const uint32_t One = 1;
+  ASSERT_EQ(zeCommandListAppendMemoryFill(Immediate, Value, &One, sizeof(One),
+                                          sizeof(One), Done, 1, &Gate),
+            ZE_RESULT_SUCCESS);
+
+  // Nothing runs until the host signals the gate.
+  EXPECT_EQ(zeEventHostSynchronize(Done, 1000000), ZE_RESULT_NOT_READY);
+  EXPECT_EQ(*Value, 0u);
+
+  ASSERT_EQ(zeEventHostSignal(Gate), ZE_RESULT_SUCCESS);
+  ASSERT_EQ(zeEventHostSynchronize(Done, UINT64_MAX), ZE_RESULT_SUCCESS);
+  EXPECT_EQ(*Value, 1u);
+
+  ze_kernel_timestamp_result_t Timestamp{};
+  ASSERT_EQ(zeEventQueryKernelTimestamp(Done, &Timestamp), ZE_RESULT_SUCCESS);
+  EXPECT_LE(Timestamp.global.kernelStart, Timestamp.global.kernelEnd);
+
+  ASSERT_EQ(zeEventHostReset(Done), ZE_RESULT_SUCCESS);
+  EXPECT_EQ(zeEventQueryStatus(Done), ZE_RESULT_NOT_READY);
+
+  zeEventDestroy(Gate);
+  zeEventDestroy(Done);
+  zeEventPoolDestroy(Pool);
+  zeMemFree(Context, Value);
+}
+
+TEST_F(zeEmulatorTest, counterBasedEvents) {
+  ze_event_pool_handle_t Pool = createEventPool(1, true);
+  ze_event_handle_t Event = createEvent(Pool, 0);
+
+  // Counter-based events are complete until they are appended.
+  EXPECT_EQ(zeEventQueryStatus(Event), ZE_RESULT_SUCCESS);
+  EXPECT_NE(zeEventHostReset(Event), ZE_RESULT_SUCCESS);
+
+  for (int I = 0; I < 3; I++) {
+    ASSERT_EQ(zeCommandListAppendBarrier(Immediate, Event, 0, nullptr),
+              ZE_RESULT_SUCCESS);
+    ASSERT_EQ(zeEventHostSynchronize(Event, UINT64_MAX), ZE_RESULT_SUCCESS);
+  }
+
+  zeEventDestroy(Event);
+  zeEventPoolDestroy(Pool);
+}
+
+TEST_F(zeEmulatorTest, hostKernel) {
+  ze_emulator::registerKernel(
+      "iota", 2, [](const ze_emulator::launch_t &Launch) {
+        auto *Out = Launch.arg<uint32_t *>(0);
+        const auto Base = Launch.arg<uint32_t>(1);
+        const uint32_t Count = Launch.GroupCount[0] * Launch.GroupSize[0];
+        for (uint32_t I = 0; I < Count; I++) {
+          Out[I] = Base + Launch.GlobalOffset[0] + I;
+        }
+      });
+
+  ze_module_desc_t ModuleDesc{};
+  ModuleDesc.stype = ZE_STRUCTURE_TYPE_MODULE_DESC;
+  ze_module_handle_t Module = nullptr;
+  ASSERT_EQ(zeModuleCreate(Context, Device, &ModuleDesc, &Module, nullptr),
+            ZE_RESULT_SUCCESS);
+
+  ze_kernel_desc_t KernelDesc{};
+  KernelDesc.stype = ZE_STRUCTURE_TYPE_KERNEL_DESC;
+  KernelDesc.pKernelName = "missing";
+  ze_kernel_handle_t Kernel = nullptr;
+  EXPECT_EQ(zeKernelCreate(Module, &KernelDesc, &Kernel),
+            ZE_RESULT_ERROR_INVALID_KERNEL_NAME);
+  KernelDesc.pKernelName = "iota";
+  ASSERT_EQ(zeKernelCreate(Module, &KernelDesc, &Kernel), ZE_RESULT_SUCCESS);
+
+  ze_kernel_properties_t Props{};
+  ASSERT_EQ(zeKernelGetProperties(Kernel, &Props), ZE_RESULT_SUCCESS);
+  EXPECT_EQ(Props.numKernelArgs, 2u);
+
+  constexpr uint32_t Count = 64;
+  auto *Out = static_cast<uint32_t *>(allocShared(Count * sizeof(uint32_t)));
+  uint32_t Base = 100;
+  ASSERT_EQ(zeKernelSetArgumentValue(Kernel, 0, sizeof(Out), &Out),
+            ZE_RESULT_SUCCESS);
+  ASSERT_EQ(zeKernelSetArgumentValue(Kernel, 1, sizeof(Base), &Base),
+            ZE_RESULT_SUCCESS);
+  ASSERT_EQ(zeKernelSetGroupSize(Kernel, 16, 1, 1), ZE_RESULT_SUCCESS);
+  ASSERT_EQ(zeKernelSetGlobalOffsetExp(Kernel, 5, 0, 0), ZE_RESULT_SUCCESS);
+  ze_group_count_t GroupCount{Count / 16, 1, 1};
+  ASSERT_EQ(zeCommandListAppendLaunchKernel(Immediate, Kernel, &GroupCount,
+                                            nullptr, 0, nullptr),
+            ZE_RESULT_SUCCESS);
+
+  // Arguments set after the append don't affect the launch.
+  Base = 0;
+  ASSERT_EQ(zeKernelSetArgumentValue(Kernel, 1, sizeof(Base), &Base),
+            ZE_RESULT_SUCCESS);
+  ASSERT_EQ(zeCommandListHostSynchronize(Immediate, UINT64_MAX),
+            ZE_RESULT_SUCCESS);
+
+  for (uint32_t I = 0; I < Count; I++) {
+    ASSERT_EQ(Out[I], 105 + I) << "at " << I;
+  }
+
+  zeMemFree(Context, Out);
+  zeKernelDestroy(Kernel);
+  zeModuleDestroy(Module);
+}
+
+TEST_F(zeEmulatorTest, commandListProperties) {
+  ze_command_queue_desc_t QueueDesc{};
+  QueueDesc.stype = ZE_STRUCTURE_TYPE_COMMAND_QUEUE_DESC;
+  QueueDesc.ordinal = 1;
+  ze_command_list_handle_t List = nullptr;
+  ASSERT_EQ(zeCommandListCreateImmediate(Context, Device, &QueueDesc, &List),
+            ZE_RESULT_SUCCESS);
+
+  ze_device_handle_t ListDevice = nullptr;
+  ASSERT_EQ(zeCommandListGetDeviceHandle(List, &ListDevice),
+            ZE_RESULT_SUCCESS);
+  EXPECT_EQ(ListDevice, Device);
+  uint32_t Ordinal = 0;
+  ASSERT_EQ(zeCommandListGetOrdinal(List, &Ordinal), ZE_RESULT_SUCCESS);
+  EXPECT_EQ(Ordinal, 1u);
+  uint32_t Index = 1;
+  ASSERT_EQ(zeCommandListImmediateGetIndex(List, &Index), ZE_RESULT_SUCCESS);
+  EXPECT_EQ(Index, 0u);
+
+  ASSERT_EQ(zeCommandListDestroy(List), ZE_RESULT_SUCCESS);
+}
+
+TEST_F(zeEmulatorTest, regularCommandList) {
+  ze_command_list_desc_t ListDesc{};
+  ListDesc.stype = ZE_STRUCTURE_TYPE_COMMAND_LIST_DESC;
+  ze_command_list_handle_t List = nullptr;
+  ASSERT_EQ(zeCommandListCreate(Context, Device, &ListDesc, &List),
+            ZE_RESULT_SUCCESS);
+
+  auto *Value = static_cast<uint32_t *>(allocShared(sizeof(uint32_t)));
+  *Value = 0;
+  const uint32_t Seven = 7;
+  ASSERT_EQ(zeCommandListAppendMemoryFill(List, Value, &Seven, sizeof(Seven),
+                                          sizeof(Seven), nullptr, 0, nullptr),
+            ZE_RESULT_SUCCESS);
+  ASSERT_EQ(zeCommandListClose(List), ZE_RESULT_SUCCESS);
+  EXPECT_EQ(*Value, 0u);
+
+  ze_command_queue_desc_t QueueDesc{};
+  QueueDesc.stype = ZE_STRUCTURE_TYPE_COMMAND_QUEUE_DESC;
+  ze_command_queue_handle_t Queue = nullptr;
+  ASSERT_EQ(zeCommandQueueCreate(Context, Device, &QueueDesc, &Queue),
+            ZE_RESULT_SUCCESS);
+  ze_fence_desc_t FenceDesc{};
+  FenceDesc.stype = ZE_STRUCTURE_TYPE_FENCE_DESC;
+  ze_fence_handle_t Fence = nullptr;
+  ASSERT_EQ(zeFenceCreate(Queue, &FenceDesc, &Fence), ZE_RESULT_SUCCESS);
+
+  ASSERT_EQ(zeCommandQueueExecuteCommandLists(Queue, 1, &List, Fence),
+            ZE_RESULT_SUCCESS);
+  ASSERT_EQ(zeFenceHostSynchronize(Fence, UINT64_MAX), ZE_RESULT_SUCCESS);
+  EXPECT_EQ(*Value, 7u);
+
+  // The same list can be appended to an immediate command list.
+  *Value = 0;
+  ASSERT_EQ(zeCommandListImmediateAppendCommandListsExp(Immediate, 1, &List,
+                                                        nullptr, 0, nullptr),
+            ZE_RESULT_SUCCESS);
+  ASSERT_EQ(zeCommandListHostSynchronize(Immediate, UINT64_MAX),
+            ZE_RESULT_SUCCESS);
+  EXPECT_EQ(*Value, 7u);
+
+  zeFenceDestroy(Fence);
+  zeCommandQueueDestroy(Queue);
+  zeCommandListDestroy(List);
+  zeMemFree(Context, Value);
+}
+
+TEST_F(zeEmulatorTest, callCounts) {
+  ze_event_pool_handle_t Pool = createEventPool(1, true);
+  ze_event_handle_t Event = createEvent(Pool, 0);
+  for (int I = 0; I < 5; I++) {
+    zeCommandListAppendBarrier(Immediate, Event, 0, nullptr);
+  }
+  zeEventHostSynchronize(Event, UINT64_MAX);
+
+  EXPECT_EQ(ze_emulator::getCallCount("zeEventPoolCreate"), 1u);
+  EXPECT_EQ(ze_emulator::getCallCount("zeEventCreate"), 1u);
+  EXPECT_EQ(ze_emulator::getCallCount("zeCommandListAppendBarrier"), 5u);
+  EXPECT_EQ(ze_emulator::getCallCount("zeCommandListAppendMemoryCopy"), 0u);
+  EXPECT_EQ(ze_emulator::getCallCounts().size(), 4u);
+
+  ze_emulator::resetCallCounts();
+  EXPECT_EQ(ze_emulator::getCallCount("zeCommandListAppendBarrier"), 0u);
+  EXPECT_TRUE(ze_emulator::getCallCounts().empty());
+
+  zeEventDestroy(Event);
+  zeEventPoolDestroy(Pool);
+}
+
+TEST_F(zeEmulatorTest, latency) {
+  ze_emulator::config_t Config;
+  Config.Latency.Append = std::chrono::microseconds(200);
+  ze_emulator::setConfig(Config);
+
+  const auto Start = std::chrono::steady_clock::now();
+  for (int I = 0; I < 10; I++) {
+    zeCommandListAppendBarrier(Immediate, nullptr, 0, nullptr);
+  }
+  const auto Elapsed = std::chrono::steady_clock::now() - Start;
+  EXPECT_GE(Elapsed, std::chrono::milliseconds(2));
+
+  ze_emulator::setConfig({});
+}
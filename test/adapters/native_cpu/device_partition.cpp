@@ -0,0 +1,236 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "uur/fixtures.h"
+#include "uur/utils.h"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <vector>
+
+struct urNativeCpuDevicePartitionTest : uur::urDeviceTest {
+  void SetUp() override {
+    UUR_RETURN_ON_FATAL_FAILURE(urDeviceTest::SetUp());
+    // The compute units the root device can be partitioned into, which may
+    // be fewer than its threads.
+    ASSERT_SUCCESS(urDeviceGetInfo(device,
+                                   UR_DEVICE_INFO_PARTITION_MAX_SUB_DEVICES,
+                                   sizeof(ComputeUnits), &ComputeUnits,
+                                   nullptr));
+    if (ComputeUnits < 2) {
+      GTEST_SKIP() << "Partitioning needs at least two compute units.";
+    }
+  }
+
+  std::vector<ur_device_handle_t>
+  partition(const std::vector<ur_device_partition_property_t> &Properties) {
+    ur_device_partition_properties_t Desc{
+        UR_STRUCTURE_TYPE_DEVICE_PARTITION_PROPERTIES, nullptr,
+        Properties.data(), Properties.size()};
+    uint32_t Count = 0;
+    EXPECT_SUCCESS(urDevicePartition(device, &Desc, 0, nullptr, &Count));
+    std::vector<ur_device_handle_t> SubDevices(Count);
+    EXPECT_SUCCESS(
+        urDevicePartition(device, &Desc, Count, SubDevices.data(), nullptr));
+    return SubDevices;
+  }
+
+  static uint32_t computeUnits(ur_device_handle_t Device) {
+    uint32_t Count = 0;
+    EXPECT_SUCCESS(uur::GetDeviceMaxComputeUnits(Device, Count));
+    return Count;
+  }
+
+  static uint32_t referenceCount(ur_device_handle_t Device) {
+    uint32_t Count = 0;
+    EXPECT_SUCCESS(urDeviceGetInfo(Device, UR_DEVICE_INFO_REFERENCE_COUNT,
+                                   sizeof(Count), &Count, nullptr));
+    return Count;
+  }
+
+  static std::vector<ur_device_partition_property_t>
+  partitionType(ur_device_handle_t Device) {
+    size_t Size = 0;
+    EXPECT_SUCCESS(urDeviceGetInfo(Device, UR_DEVICE_INFO_PARTITION_TYPE, 0,
+                                   nullptr, &Size));
+    std::vector<ur_device_partition_property_t> Properties(
+        Size / sizeof(ur_device_partition_property_t));
+    if (Size) {
+      EXPECT_SUCCESS(urDeviceGetInfo(Device, UR_DEVICE_INFO_PARTITION_TYPE,
+                                     Size, Properties.data(), nullptr));
+    }
+    return Properties;
+  }
+
+  uint32_t ComputeUnits = 0;
+};
+
+UUR_INSTANTIATE_DEVICE_TEST_SUITE(urNativeCpuDevicePartitionTest);
+
+TEST_P(urNativeCpuDevicePartitionTest, Equally) {
+  auto SubDevices = partition({uur::makePartitionEquallyDesc(1)});
+  ASSERT_EQ(SubDevices.size(), ComputeUnits);
+  for (auto SubDevice : SubDevices) {
+    ur_device_handle_t Parent = nullptr;
+    ASSERT_SUCCESS(urDeviceGetInfo(SubDevice, UR_DEVICE_INFO_PARENT_DEVICE,
+                                   sizeof(Parent), &Parent, nullptr));
+    EXPECT_EQ(Parent, device);
+    EXPECT_EQ(computeUnits(SubDevice), 1u);
+
+    auto Type = partitionType(SubDevice);
+    ASSERT_EQ(Type.size(), 1u);
+    EXPECT_EQ(Type[0].type, UR_DEVICE_PARTITION_EQUALLY);
+    EXPECT_EQ(Type[0].value.equally, 1u);
+    ASSERT_SUCCESS(urDeviceRelease(SubDevice));
+  }
+  EXPECT_TRUE(partitionType(device).empty());
+}
+
+TEST_P(urNativeCpuDevicePartitionTest, ByCounts) {
+  auto SubDevices =
+      partition({uur::makePartitionByCountsDesc(1),
+                 uur::makePartitionByCountsDesc(ComputeUnits - 1)});
+  ASSERT_EQ(SubDevices.size(), 2u);
+  EXPECT_EQ(computeUnits(SubDevices[0]), 1u);
+  EXPECT_EQ(computeUnits(SubDevices[1]), ComputeUnits - 1);
+  for (auto SubDevice : SubDevices) {
+    // Each sub-device reports all the counts it was created with.
+    auto Type = partitionType(SubDevice);
+    ASSERT_EQ(Type.size(), 2u);
+    EXPECT_EQ(Type[0].type, UR_DEVICE_PARTITION_BY_COUNTS);
+    EXPECT_EQ(Type[0].value.count, 1u);
+    EXPECT_EQ(Type[1].value.count, ComputeUnits - 1);
+    ASSERT_SUCCESS(urDeviceRelease(SubDevice));
+  }
+}
+
+TEST_P(urNativeCpuDevicePartitionTest, ByCountsTooMany) {
+  auto Property = uur::makePartitionByCountsDesc(ComputeUnits + 1);
+  ur_device_partition_properties_t Desc{
+      UR_STRUCTURE_TYPE_DEVICE_PARTITION_PROPERTIES, nullptr, &Property, 1};
+  uint32_t Count = 0;
+  ASSERT_EQ(urDevicePartition(device, &Desc, 0, nullptr, &Count),
+            UR_RESULT_ERROR_INVALID_DEVICE_PARTITION_COUNT);
+}
+
+TEST_P(urNativeCpuDevicePartitionTest, ByAffinityDomain) {
+  ur_device_affinity_domain_flags_t Supported = 0;
+  ASSERT_SUCCESS(urDeviceGetInfo(device,
+                                 UR_DEVICE_INFO_PARTITION_AFFINITY_DOMAIN,
+                                 sizeof(Supported), &Supported, nullptr));
+  if (!Supported) {
+    GTEST_SKIP() << "The host reports no affinity domains.";
+  }
+
+  for (auto Domain : {UR_DEVICE_AFFINITY_DOMAIN_FLAG_NUMA,
+                      UR_DEVICE_AFFINITY_DOMAIN_FLAG_L4_CACHE,
+                      UR_DEVICE_AFFINITY_DOMAIN_FLAG_L3_CACHE,
+                      UR_DEVICE_AFFINITY_DOMAIN_FLAG_L2_CACHE,
+                      UR_DEVICE_AFFINITY_DOMAIN_FLAG_L1_CACHE}) {
+    if (!(Supported & Domain)) {
+      continue;
+    }
+    // The domains cover every compute unit exactly once.
+    auto SubDevices = partition({uur::makePartitionByAffinityDomain(Domain)});
+    ASSERT_FALSE(SubDevices.empty());
+    uint32_t Total = 0;
+    for (auto SubDevice : SubDevices) {
+      Total += computeUnits(SubDevice);
+      auto Type = partitionType(SubDevice);
+      ASSERT_EQ(Type.size(), 1u);
+      EXPECT_EQ(Type[0].type, UR_DEVICE_PARTITION_BY_AFFINITY_DOMAIN);
+      EXPECT_EQ(Type[0].value.affinity_domain, Domain);
+      ASSERT_SUCCESS(urDeviceRelease(SubDevice));
+    }
+    EXPECT_EQ(Total, ComputeUnits);
+  }
+}
+
+TEST_P(urNativeCpuDevicePartitionTest, NextPartitionable) {
+  auto Property = uur::makePartitionByAffinityDomain(
+      UR_DEVICE_AFFINITY_DOMAIN_FLAG_NEXT_PARTITIONABLE);
+  ur_device_partition_properties_t Desc{
+      UR_STRUCTURE_TYPE_DEVICE_PARTITION_PROPERTIES, nullptr, &Property, 1};
+  uint32_t Count = 0;
+  auto Result = urDevicePartition(device, &Desc, 0, nullptr, &Count);
+  if (Result == UR_RESULT_ERROR_INVALID_VALUE ||
+      Result == UR_RESULT_ERROR_DEVICE_PARTITION_FAILED) {
+    GTEST_SKIP() << "No affinity domain splits the host.";
+  }
+  ASSERT_SUCCESS(Result);
+  ASSERT_GT(Count, 1u);
+
+  // Sub-devices report the domain that was picked.
+  std::vector<ur_device_handle_t> SubDevices(Count);
+  ASSERT_SUCCESS(
+      urDevicePartition(device, &Desc, Count, SubDevices.data(), nullptr));
+  for (auto SubDevice : SubDevices) {
+    auto Type = partitionType(SubDevice);
+    ASSERT_EQ(Type.size(), 1u);
+    EXPECT_NE(Type[0].value.affinity_domain,
+              UR_DEVICE_AFFINITY_DOMAIN_FLAG_NEXT_PARTITIONABLE);
+    ASSERT_SUCCESS(urDeviceRelease(SubDevice));
+  }
+}
+
+TEST_P(urNativeCpuDevicePartitionTest, FewerHandlesThanSubDevices) {
+  auto Property = uur::makePartitionEquallyDesc(1);
+  ur_device_partition_properties_t Desc{
+      UR_STRUCTURE_TYPE_DEVICE_PARTITION_PROPERTIES, nullptr, &Property, 1};
+  ur_device_handle_t SubDevice = nullptr;
+  uint32_t Count = 0;
+  ASSERT_SUCCESS(urDevicePartition(device, &Desc, 1, &SubDevice, &Count));
+  EXPECT_EQ(Count, ComputeUnits);
+  ASSERT_NE(SubDevice, nullptr);
+  ASSERT_SUCCESS(urDeviceRelease(SubDevice));
+}
+
+TEST_P(urNativeCpuDevicePartitionTest, QueueOutlivesSubDeviceHandle) {
+  auto SubDevices = partition({uur::makePartitionEquallyDesc(1)});
+  ASSERT_FALSE(SubDevices.empty());
+  ur_device_handle_t SubDevice = SubDevices[0];
+  for (size_t I = 1; I < SubDevices.size(); I++) {
+    ASSERT_SUCCESS(urDeviceRelease(SubDevices[I]));
+  }
+
+  ur_context_handle_t Context = nullptr;
+  ASSERT_SUCCESS(urContextCreate(1, &SubDevice, nullptr, &Context));
+  ur_queue_handle_t Queue = nullptr;
+  ASSERT_SUCCESS(urQueueCreate(Context, SubDevice, nullptr, &Queue));
+  // The context and the queue hold references of the sub-device.
+  EXPECT_EQ(referenceCount(SubDevice), 3u);
+  ASSERT_SUCCESS(urDeviceRelease(SubDevice));
+
+  // The queue still runs commands on the threads of the sub-device.
+  constexpr size_t Size = 1024 * 1024;
+  void *Mem = nullptr;
+  ASSERT_SUCCESS(urUSMHostAlloc(Context, nullptr, nullptr, Size, &Mem));
+  const uint32_t Pattern = 0xdeadbeef;
+  ASSERT_SUCCESS(urEnqueueUSMFill(Queue, Mem, sizeof(Pattern), &Pattern, Size,
+                                  0, nullptr, nullptr));
+  ASSERT_SUCCESS(urQueueFinish(Queue));
+  EXPECT_EQ(static_cast<uint32_t *>(Mem)[Size / sizeof(Pattern) - 1],
+            Pattern);
+  ASSERT_SUCCESS(urUSMFree(Context, Mem));
+
+  ASSERT_SUCCESS(urQueueRelease(Queue));
+  ASSERT_SUCCESS(urContextRelease(Context));
+}
+
+TEST_P(urNativeCpuDevicePartitionTest, RootReleaseDoesNotUnderflow) {
+  const uint32_t Initial = referenceCount(device);
+  ASSERT_GE(Initial, 1u);
+  for (int I = 0; I < 3; I++) {
+    ASSERT_SUCCESS(urDeviceRelease(device));
+  }
+  EXPECT_GE(referenceCount(device), 1u);
+  EXPECT_LE(referenceCount(device), Initial);
+
+  ASSERT_SUCCESS(urDeviceRetain(device));
+  const uint32_t Retained = referenceCount(device);
+  ASSERT_SUCCESS(urDeviceRelease(device));
+  EXPECT_EQ(referenceCount(device), Retained - 1);
+}
@@ -0,0 +1,174 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "uur/fixtures.h"
+
+#include <chrono>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+namespace native_cpu {
+struct state;
+}
+
+namespace {
+
+// Matches the layout of the entries emitted by the offload wrapper, see
+// nativecpu_entry in source/adapters/native_cpu/program.hpp.
+struct kernel_entry {
+  const char *kernelname;
+  const unsigned char *kernel_ptr;
+};
+
+// Args[0]: uint32_t *Mem. Writes Mem[0] after a delay.
+void slowWriteKernel(void *const *Args, native_cpu::state *) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  static_cast<uint32_t *>(Args[0])[0] = 42;
+}
+
+const kernel_entry Entries[] = {
+    {"slow_write", reinterpret_cast<const unsigned char *>(&slowWriteKernel)},
+    {nullptr, nullptr}};
+
+ur_exp_batch_command_t makeCopy(void *Dst, const void *Src, size_t Size) {
+  ur_exp_batch_command_t Command{};
+  Command.type = UR_EXP_BATCH_COMMAND_TYPE_USM_MEMCPY;
+  Command.args.usmMemcpy = {Dst, Src, Size};
+  return Command;
+}
+
+} // namespace
+
+struct urNativeCpuEnqueueBatchTest : uur::urContextTest {
+  void SetUp() override {
+    UUR_RETURN_ON_FATAL_FAILURE(urContextTest::SetUp());
+    ur_queue_properties_t Properties = {
+        UR_STRUCTURE_TYPE_QUEUE_PROPERTIES, nullptr,
+        UR_QUEUE_FLAG_OUT_OF_ORDER_EXEC_MODE_ENABLE};
+    ASSERT_SUCCESS(urQueueCreate(context, device, &Properties, &Queue));
+
+    const uint8_t *Binary = reinterpret_cast<const uint8_t *>(Entries);
+    size_t Length = sizeof(Entries);
+    ASSERT_SUCCESS(urProgramCreateWithBinary(context, 1, &device, &Length,
+                                             &Binary, nullptr, &Program));
+    ASSERT_SUCCESS(urKernelCreate(Program, "slow_write", &Kernel));
+    ASSERT_SUCCESS(urUSMHostAlloc(context, nullptr, nullptr,
+                                  Count * sizeof(uint32_t),
+                                  reinterpret_cast<void **>(&Mem)));
+    for (size_t I = 0; I < Count; I++) {
+      Mem[I] = 0;
+    }
+    ASSERT_SUCCESS(urKernelSetArgPointer(Kernel, 0, nullptr, Mem));
+  }
+
+  void TearDown() override {
+    if (Queue) {
+      EXPECT_SUCCESS(urQueueFinish(Queue));
+      EXPECT_SUCCESS(urQueueRelease(Queue));
+    }
+    if (Mem) {
+      EXPECT_SUCCESS(urUSMFree(context, Mem));
+    }
+    if (Kernel) {
+      EXPECT_SUCCESS(urKernelRelease(Kernel));
+    }
+    if (Program) {
+      EXPECT_SUCCESS(urProgramRelease(Program));
+    }
+    UUR_RETURN_ON_FATAL_FAILURE(urContextTest::TearDown());
+  }
+
+  ur_exp_batch_command_t makeLaunch() {
+    ur_exp_batch_command_t Command{};
+    Command.type = UR_EXP_BATCH_COMMAND_TYPE_KERNEL_LAUNCH;
+    Command.args.kernelLaunch = {Kernel, 1, &Offset, &Size, &Size};
+    return Command;
+  }
+
+  static constexpr size_t Count = 64;
+  size_t Offset = 0;
+  size_t Size = 1;
+  ur_queue_handle_t Queue = nullptr;
+  ur_program_handle_t Program = nullptr;
+  ur_kernel_handle_t Kernel = nullptr;
+  uint32_t *Mem = nullptr;
+};
+
+UUR_INSTANTIATE_DEVICE_TEST_SUITE(urNativeCpuEnqueueBatchTest);
+
+TEST_P(urNativeCpuEnqueueBatchTest, CompletesWithoutWaiting) {
+  const uint32_t Pattern = 7;
+  const uint32_t Deps[] = {0};
+  ur_exp_batch_command_t Commands[4] = {makeLaunch(),
+                                        makeCopy(&Mem[1], &Mem[0], 4)};
+  Commands[1].numDepsInBatch = 1;
+  Commands[1].pDepsInBatch = Deps;
+  Commands[2].type = UR_EXP_BATCH_COMMAND_TYPE_BARRIER;
+  Commands[3].type = UR_EXP_BATCH_COMMAND_TYPE_USM_FILL;
+  Commands[3].args.usmFill = {&Mem[8], sizeof(Pattern), &Pattern,
+                              8 * sizeof(uint32_t)};
+
+  ur_event_handle_t Event = nullptr;
+  ASSERT_SUCCESS(urEnqueueBatchExp(Queue, 4, Commands, 0, nullptr, &Event));
+
+  // The status of the batch must become complete without anyone waiting for
+  // it, e.g. for the USM arena to reuse memory freed behind it.
+  auto Deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  ur_event_status_t Status = UR_EVENT_STATUS_SUBMITTED;
+  while (Status != UR_EVENT_STATUS_COMPLETE &&
+         std::chrono::steady_clock::now() < Deadline) {
+    ASSERT_SUCCESS(urEventGetInfo(Event,
+                                  UR_EVENT_INFO_COMMAND_EXECUTION_STATUS,
+                                  sizeof(Status), &Status, nullptr));
+    std::this_thread::yield();
+  }
+  ASSERT_EQ(Status, UR_EVENT_STATUS_COMPLETE);
+
+  EXPECT_EQ(Mem[0], 42u);
+  EXPECT_EQ(Mem[1], 42u);
+  for (size_t I = 8; I < 16; I++) {
+    EXPECT_EQ(Mem[I], Pattern);
+  }
+  ASSERT_SUCCESS(urEventRelease(Event));
+}
+
+TEST_P(urNativeCpuEnqueueBatchTest, CopiesWaitForTheirDependencies) {
+  // Each copy depends on the previous one, so the kernel's value ends up at
+  // the end of the chain.
+  constexpr uint32_t Copies = 16;
+  std::vector<ur_exp_batch_command_t> Commands{makeLaunch()};
+  std::vector<uint32_t> Deps(Copies);
+  for (uint32_t I = 0; I < Copies; I++) {
+    Deps[I] = I;
+    Commands.push_back(makeCopy(&Mem[I + 1], &Mem[I], sizeof(uint32_t)));
+    Commands.back().numDepsInBatch = 1;
+    Commands.back().pDepsInBatch = &Deps[I];
+  }
+
+  ur_event_handle_t Event = nullptr;
+  ASSERT_SUCCESS(urEnqueueBatchExp(Queue, Commands.size(), Commands.data(), 0,
+                                   nullptr, &Event));
+  ASSERT_SUCCESS(urEventWait(1, &Event));
+  ASSERT_SUCCESS(urEventRelease(Event));
+  for (uint32_t I = 0; I <= Copies; I++) {
+    EXPECT_EQ(Mem[I], 42u);
+  }
+}
+
+TEST_P(urNativeCpuEnqueueBatchTest, FailedBatchWaitsForScheduledCommands) {
+  ur_exp_batch_command_t Commands[2] = {makeLaunch()};
+  Commands[1].type = UR_EXP_BATCH_COMMAND_TYPE_USM_FILL;
+  Commands[1].args.usmFill = {&Mem[8], sizeof(uint32_t), nullptr,
+                              8 * sizeof(uint32_t)};
+
+  ur_event_handle_t Event = nullptr;
+  ASSERT_EQ(urEnqueueBatchExp(Queue, 2, Commands, 0, nullptr, &Event),
+            UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  // The kernel launched before the failing command has finished.
+  EXPECT_EQ(Mem[0], 42u);
+}
@@ -0,0 +1,49 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "uur/fixtures.h"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <vector>
+
+using urNativeCpuHostTaskTest = uur::urQueueTest;
+
+UUR_INSTANTIATE_DEVICE_TEST_SUITE(urNativeCpuHostTaskTest);
+
+namespace {
+struct FillData {
+  ur_queue_handle_t Queue;
+  uint32_t *Ptr;
+  size_t Count;
+  ur_result_t Result;
+};
+} // namespace
+
+// The test runs with a single device thread, so a fill split across the
+// device's threads can only complete if the host task doesn't occupy it.
+TEST_P(urNativeCpuHostTaskTest, HostTaskWaitsOnDeviceThreads) {
+  constexpr size_t Count = 16 * 1024 * 1024;
+  std::vector<uint32_t> Host(Count);
+  FillData Data{queue, Host.data(), Count, UR_RESULT_ERROR_UNKNOWN};
+
+  ur_event_handle_t Event = nullptr;
+  ASSERT_SUCCESS(urEnqueueHostTaskExp(
+      queue,
+      [](void *pUserData) {
+        auto *Data = static_cast<FillData *>(pUserData);
+        const uint32_t Pattern = 7;
+        Data->Result = urEnqueueUSMFill(Data->Queue, Data->Ptr, sizeof(Pattern),
+                                        &Pattern, Data->Count * sizeof(Pattern),
+                                        0, nullptr, nullptr);
+      },
+      &Data, 0, nullptr, &Event));
+  ASSERT_SUCCESS(urEventWait(1, &Event));
+  ASSERT_SUCCESS(urEventRelease(Event));
+
+  ASSERT_SUCCESS(Data.Result);
+  ASSERT_EQ(Host, std::vector<uint32_t>(Count, 7));
+}
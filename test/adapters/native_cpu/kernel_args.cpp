@@ -0,0 +1,168 @@
+// Copyright (C) 2024 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "uur/fixtures.h"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace native_cpu {
+struct state;
+}
+
+namespace {
+
+// Matches the layout of the entries emitted by the offload wrapper, see
+// nativecpu_entry in source/adapters/native_cpu/program.hpp.
+struct kernel_entry {
+  const char *kernelname;
+  const unsigned char *kernel_ptr;
+};
+
+// Args[0]: uint64_t *Out, Args[1]: uint32_t NumValues, Args[2...]: uint64_t.
+// Writes the sum of the values to Out[0] and the number of misaligned
+// arguments to Out[1].
+void sumKernel(void *const *Args, native_cpu::state *) {
+  auto *Out = static_cast<uint64_t *>(Args[0]);
+  const uint32_t NumValues = *static_cast<const uint32_t *>(Args[1]);
+  uint64_t Sum = 0;
+  uint64_t Misaligned = 0;
+  for (uint32_t I = 0; I < NumValues; I++) {
+    const void *Value = Args[2 + I];
+    Misaligned += reinterpret_cast<uintptr_t>(Value) % alignof(uint64_t) != 0;
+    Sum += *static_cast<const uint64_t *>(Value);
+  }
+  Out[0] = Sum;
+  Out[1] = Misaligned;
+}
+
+const kernel_entry Entries[] = {
+    {"sum", reinterpret_cast<const unsigned char *>(&sumKernel)},
+    {nullptr, nullptr}};
+
+} // namespace
+
+struct urNativeCpuKernelArgsTest : uur::urQueueTest {
+  void SetUp() override {
+    UUR_RETURN_ON_FATAL_FAILURE(uur::urQueueTest::SetUp());
+
+    const uint8_t *Binary = reinterpret_cast<const uint8_t *>(Entries);
+    size_t Length = sizeof(Entries);
+    ASSERT_SUCCESS(urProgramCreateWithBinary(context, 1, &device, &Length,
+                                             &Binary, nullptr, &program));
+    ASSERT_SUCCESS(urKernelCreate(program, "sum", &kernel));
+    ASSERT_SUCCESS(urUSMHostAlloc(context, nullptr, nullptr,
+                                  2 * sizeof(uint64_t),
+                                  reinterpret_cast<void **>(&out)));
+    ASSERT_SUCCESS(urKernelSetArgPointer(kernel, 0, nullptr, out));
+  }
+
+  void TearDown() override {
+    if (out) {
+      EXPECT_SUCCESS(urUSMFree(context, out));
+    }
+    if (kernel) {
+      EXPECT_SUCCESS(urKernelRelease(kernel));
+    }
+    if (program) {
+      EXPECT_SUCCESS(urProgramRelease(program));
+    }
+    UUR_RETURN_ON_FATAL_FAILURE(uur::urQueueTest::TearDown());
+  }
+
+  void setValues(const std::vector<uint64_t> &Values) {
+    const uint32_t NumValues = static_cast<uint32_t>(Values.size());
+    ASSERT_SUCCESS(urKernelSetArgValue(kernel, 1, sizeof(NumValues), nullptr,
+                                       &NumValues));
+    for (uint32_t I = 0; I < NumValues; I++) {
+      ASSERT_SUCCESS(urKernelSetArgValue(kernel, 2 + I, sizeof(uint64_t),
+                                         nullptr, &Values[I]));
+    }
+  }
+
+  void launch() {
+    size_t Offset = 0;
+    size_t Size = 1;
+    ASSERT_SUCCESS(urEnqueueKernelLaunch(queue, kernel, 1, &Offset, &Size,
+                                         &Size, 0, nullptr, nullptr));
+  }
+
+  ur_program_handle_t program = nullptr;
+  ur_kernel_handle_t kernel = nullptr;
+  uint64_t *out = nullptr;
+};
+
+UUR_INSTANTIATE_DEVICE_TEST_SUITE(urNativeCpuKernelArgsTest);
+
+TEST_P(urNativeCpuKernelArgsTest, ValuesAreAlignedAndUpdated) {
+  for (uint32_t NumValues = 1; NumValues <= 64; NumValues *= 2) {
+    std::vector<uint64_t> Values(NumValues);
+    uint64_t Expected = 0;
+    for (uint32_t I = 0; I < NumValues; I++) {
+      Values[I] = (uint64_t{1} << 40) + I;
+      Expected += Values[I];
+    }
+    setValues(Values);
+    launch();
+    ASSERT_SUCCESS(urQueueFinish(queue));
+    ASSERT_EQ(out[0], Expected);
+    ASSERT_EQ(out[1], 0u);
+  }
+}
+
+TEST_P(urNativeCpuKernelArgsTest, ArgumentSizeChange) {
+  // Argument 2 first holds a byte, then a full 64-bit value.
+  const uint8_t Small = 0xff;
+  ASSERT_SUCCESS(
+      urKernelSetArgValue(kernel, 2, sizeof(Small), nullptr, &Small));
+  setValues({uint64_t{1} << 33, 7});
+  launch();
+  ASSERT_SUCCESS(urQueueFinish(queue));
+  ASSERT_EQ(out[0], (uint64_t{1} << 33) + 7);
+  ASSERT_EQ(out[1], 0u);
+}
+
+TEST_P(urNativeCpuKernelArgsTest, ValuesAreCapturedAtEnqueue) {
+  setValues({1, 2});
+  launch();
+  setValues({10, 20});
+  ASSERT_SUCCESS(urQueueFinish(queue));
+  ASSERT_EQ(out[0], 3u);
+
+  launch();
+  ASSERT_SUCCESS(urQueueFinish(queue));
+  ASSERT_EQ(out[0], 30u);
+}
+
+TEST_P(urNativeCpuKernelArgsTest, ValuesSetInReverseOrder) {
+  // Setting the last argument first grows the argument storage once, the
+  // others then fill the slots below it.
+  const uint32_t NumValues = 32;
+  uint64_t Expected = 0;
+  for (uint32_t I = NumValues; I-- > 0;) {
+    const uint64_t Value = (uint64_t{1} << 36) * (I + 1);
+    ASSERT_SUCCESS(urKernelSetArgValue(kernel, 2 + I, sizeof(Value), nullptr,
+                                       &Value));
+    Expected += Value;
+  }
+  ASSERT_SUCCESS(urKernelSetArgValue(kernel, 1, sizeof(NumValues), nullptr,
+                                     &NumValues));
+  launch();
+  ASSERT_SUCCESS(urQueueFinish(queue));
+  ASSERT_EQ(out[0], Expected);
+  ASSERT_EQ(out[1], 0u);
+}
+
+TEST_P(urNativeCpuKernelArgsTest, EveryLaunchSeesItsValues) {
+  for (uint64_t I = 0; I < 100; I++) {
+    setValues({I, I << 32, 3});
+    launch();
+    ASSERT_SUCCESS(urQueueFinish(queue));
+    ASSERT_EQ(out[0], I + (I << 32) + 3);
+    ASSERT_EQ(out[1], 0u);
+  }
+}
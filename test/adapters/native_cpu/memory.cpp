@@ -0,0 +1,49 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "uur/fixtures.h"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+
+struct urNativeCpuMemoryTest : uur::urQueueTest {
+  void TearDown() override {
+    if (Buffer) {
+      EXPECT_SUCCESS(urMemRelease(Buffer));
+    }
+    UUR_RETURN_ON_FATAL_FAILURE(urQueueTest::TearDown());
+  }
+
+  // Larger than any address space, so that the storage can never be
+  // allocated.
+  static constexpr size_t HugeSize = SIZE_MAX / 2;
+  ur_mem_handle_t Buffer = nullptr;
+};
+
+UUR_INSTANTIATE_DEVICE_TEST_SUITE(urNativeCpuMemoryTest);
+
+TEST_P(urNativeCpuMemoryTest, CopyHostPtrOutOfMemory) {
+  uint8_t Host[16] = {};
+  ur_buffer_properties_t Properties{UR_STRUCTURE_TYPE_BUFFER_PROPERTIES,
+                                    nullptr, Host};
+  ASSERT_EQ(urMemBufferCreate(context, UR_MEM_FLAG_ALLOC_COPY_HOST_POINTER,
+                              HugeSize, &Properties, &Buffer),
+            UR_RESULT_ERROR_OUT_OF_HOST_MEMORY);
+}
+
+TEST_P(urNativeCpuMemoryTest, LazyAllocationOutOfMemory) {
+  // The storage is only allocated on the first access.
+  ASSERT_SUCCESS(urMemBufferCreate(context, UR_MEM_FLAG_READ_WRITE, HugeSize,
+                                   nullptr, &Buffer));
+  const uint8_t Pattern = 1;
+  ASSERT_EQ(urEnqueueMemBufferFill(queue, Buffer, &Pattern, sizeof(Pattern), 0,
+                                   16, 0, nullptr, nullptr),
+            UR_RESULT_ERROR_OUT_OF_HOST_MEMORY);
+  uint8_t Data[16] = {};
+  ASSERT_EQ(urEnqueueMemBufferRead(queue, Buffer, true, 0, sizeof(Data), Data,
+                                   0, nullptr, nullptr),
+            UR_RESULT_ERROR_OUT_OF_HOST_MEMORY);
+}
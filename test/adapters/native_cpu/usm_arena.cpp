@@ -0,0 +1,131 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "uur/fixtures.h"
+
+#include <chrono>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+namespace native_cpu {
+struct state;
+}
+
+namespace {
+
+// Matches the layout of the entries emitted by the offload wrapper, see
+// nativecpu_entry in source/adapters/native_cpu/program.hpp.
+struct kernel_entry {
+  const char *kernelname;
+  const unsigned char *kernel_ptr;
+};
+
+// Args[0]: uint32_t *Mem, Args[1]: uint32_t *Done. Writes Mem[0] after a
+// delay, then sets Done[0].
+void slowWriteKernel(void *const *Args, native_cpu::state *) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  static_cast<uint32_t *>(Args[0])[0] = 42;
+  static_cast<uint32_t *>(Args[1])[0] = 1;
+}
+
+const kernel_entry Entries[] = {
+    {"slow_write", reinterpret_cast<const unsigned char *>(&slowWriteKernel)},
+    {nullptr, nullptr}};
+
+} // namespace
+
+struct urNativeCpuUSMArenaTest : uur::urQueueTest {
+  void *alloc(ur_queue_handle_t Queue, size_t Size,
+              ur_event_handle_t *Event = nullptr) {
+    void *Mem = nullptr;
+    EXPECT_SUCCESS(
+        urEnqueueUSMAllocExp(Queue, nullptr, Size, 0, nullptr, &Mem, Event));
+    EXPECT_NE(Mem, nullptr);
+    return Mem;
+  }
+};
+
+UUR_INSTANTIATE_DEVICE_TEST_SUITE(urNativeCpuUSMArenaTest);
+
+TEST_P(urNativeCpuUSMArenaTest, FillAndRead) {
+  constexpr size_t Count = 1024;
+  auto *A = static_cast<uint32_t *>(alloc(queue, Count * sizeof(uint32_t)));
+  auto *B = static_cast<uint32_t *>(alloc(queue, Count * sizeof(uint32_t)));
+  ASSERT_NE(A, B);
+
+  const uint32_t Pattern = 42;
+  ASSERT_SUCCESS(urEnqueueUSMFill(queue, A, sizeof(Pattern), &Pattern,
+                                  Count * sizeof(uint32_t), 0, nullptr,
+                                  nullptr));
+  ASSERT_SUCCESS(urEnqueueUSMMemcpy(queue, false, B, A,
+                                    Count * sizeof(uint32_t), 0, nullptr,
+                                    nullptr));
+  std::vector<uint32_t> Host(Count);
+  ASSERT_SUCCESS(urEnqueueUSMMemcpy(queue, true, Host.data(), B,
+                                    Count * sizeof(uint32_t), 0, nullptr,
+                                    nullptr));
+  ASSERT_EQ(Host, std::vector<uint32_t>(Count, Pattern));
+
+  ASSERT_SUCCESS(urEnqueueUSMFreeExp(queue, A, 0, nullptr, nullptr));
+  ASSERT_SUCCESS(urEnqueueUSMFreeExp(queue, B, 0, nullptr, nullptr));
+}
+
+TEST_P(urNativeCpuUSMArenaTest, InOrderReusesFreedMemory) {
+  void *A = alloc(queue, 256);
+  ASSERT_SUCCESS(urEnqueueUSMFreeExp(queue, A, 0, nullptr, nullptr));
+  ASSERT_EQ(alloc(queue, 256), A);
+}
+
+TEST_P(urNativeCpuUSMArenaTest, OutOfOrderReusesCompletedFrees) {
+  ur_queue_properties_t Properties = {
+      UR_STRUCTURE_TYPE_QUEUE_PROPERTIES, nullptr,
+      UR_QUEUE_FLAG_OUT_OF_ORDER_EXEC_MODE_ENABLE};
+  ur_queue_handle_t OutOfOrderQueue = nullptr;
+  ASSERT_SUCCESS(urQueueCreate(context, device, &Properties, &OutOfOrderQueue));
+
+  const uint8_t *Binary = reinterpret_cast<const uint8_t *>(Entries);
+  size_t Length = sizeof(Entries);
+  ur_program_handle_t Program = nullptr;
+  ASSERT_SUCCESS(urProgramCreateWithBinary(context, 1, &device, &Length,
+                                           &Binary, nullptr, &Program));
+  ur_kernel_handle_t Kernel = nullptr;
+  ASSERT_SUCCESS(urKernelCreate(Program, "slow_write", &Kernel));
+  uint32_t *Done = nullptr;
+  ASSERT_SUCCESS(urUSMHostAlloc(context, nullptr, nullptr, sizeof(uint32_t),
+                                reinterpret_cast<void **>(&Done)));
+  *Done = 0;
+
+  // The free doesn't wait for the kernel using A explicitly, so it mustn't
+  // complete, and A mustn't be handed out again, before the kernel is done.
+  void *A = alloc(OutOfOrderQueue, 256);
+  ASSERT_SUCCESS(urKernelSetArgPointer(Kernel, 0, nullptr, A));
+  ASSERT_SUCCESS(urKernelSetArgPointer(Kernel, 1, nullptr, Done));
+  size_t Offset = 0;
+  size_t Size = 1;
+  ASSERT_SUCCESS(urEnqueueKernelLaunch(OutOfOrderQueue, Kernel, 1, &Offset,
+                                       &Size, &Size, 0, nullptr, nullptr));
+  ur_event_handle_t FreeEvent = nullptr;
+  ASSERT_SUCCESS(
+      urEnqueueUSMFreeExp(OutOfOrderQueue, A, 0, nullptr, &FreeEvent));
+  ASSERT_SUCCESS(urEventWait(1, &FreeEvent));
+  ASSERT_SUCCESS(urEventRelease(FreeEvent));
+  EXPECT_EQ(*Done, 1u);
+  EXPECT_EQ(*static_cast<uint32_t *>(A), 42u);
+  EXPECT_EQ(alloc(OutOfOrderQueue, 256), A);
+
+  EXPECT_SUCCESS(urQueueRelease(OutOfOrderQueue));
+  EXPECT_SUCCESS(urUSMFree(context, Done));
+  EXPECT_SUCCESS(urKernelRelease(Kernel));
+  EXPECT_SUCCESS(urProgramRelease(Program));
+}
+
+TEST_P(urNativeCpuUSMArenaTest, FreeOfForeignPointer) {
+  uint32_t NotFromArena = 0;
+  ASSERT_EQ(urEnqueueUSMFreeExp(queue, &NotFromArena, 0, nullptr, nullptr),
+            UR_RESULT_ERROR_INVALID_VALUE);
+}
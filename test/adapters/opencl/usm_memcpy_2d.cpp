@@ -0,0 +1,128 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "uur/fixtures.h"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+struct urOpenCLUSMMemcpy2DTest : uur::urQueueTest {
+  void SetUp() override {
+    UUR_RETURN_ON_FATAL_FAILURE(uur::urQueueTest::SetUp());
+
+    bool Memcpy2DSupport = false;
+    ASSERT_SUCCESS(urContextGetInfo(context,
+                                    UR_CONTEXT_INFO_USM_MEMCPY2D_SUPPORT,
+                                    sizeof(Memcpy2DSupport), &Memcpy2DSupport,
+                                    nullptr));
+    if (!Memcpy2DSupport) {
+      GTEST_SKIP() << "2D USM memcpy is not supported";
+    }
+
+    ur_device_usm_access_capability_flags_t DeviceUSM = 0;
+    ASSERT_SUCCESS(uur::GetDeviceUSMDeviceSupport(device, DeviceUSM));
+    if (!DeviceUSM) {
+      GTEST_SKIP() << "Device USM is not supported";
+    }
+
+    ASSERT_SUCCESS(
+        urUSMDeviceAlloc(context, device, nullptr, nullptr, Size, &src));
+    ASSERT_SUCCESS(
+        urUSMDeviceAlloc(context, device, nullptr, nullptr, Size, &dst));
+  }
+
+  void TearDown() override {
+    if (src) {
+      EXPECT_SUCCESS(urUSMFree(context, src));
+    }
+    if (dst) {
+      EXPECT_SUCCESS(urUSMFree(context, dst));
+    }
+    UUR_RETURN_ON_FATAL_FAILURE(uur::urQueueTest::TearDown());
+  }
+
+  // Copies Height rows of Width bytes from src to dst, SrcPitch and DstPitch
+  // bytes apart, and checks the whole of dst.
+  void copyAndVerify(size_t DstPitch, size_t SrcPitch, size_t Width,
+                     size_t Height) {
+    std::vector<uint8_t> Src(Size), Dst(Size, 0);
+    for (size_t I = 0; I < Size; I++) {
+      Src[I] = static_cast<uint8_t>(I * 13 + 5);
+    }
+    ASSERT_SUCCESS(urEnqueueUSMMemcpy(queue, true, src, Src.data(), Size, 0,
+                                      nullptr, nullptr));
+    ASSERT_SUCCESS(urEnqueueUSMMemcpy(queue, true, dst, Dst.data(), Size, 0,
+                                      nullptr, nullptr));
+
+    ASSERT_SUCCESS(urEnqueueUSMMemcpy2D(queue, true, dst, DstPitch, src,
+                                        SrcPitch, Width, Height, 0, nullptr,
+                                        nullptr));
+
+    ASSERT_SUCCESS(urEnqueueUSMMemcpy(queue, true, Dst.data(), dst, Size, 0,
+                                      nullptr, nullptr));
+    for (size_t I = 0; I < Size; I++) {
+      const size_t Row = I / DstPitch;
+      const size_t Col = I % DstPitch;
+      const uint8_t Expected =
+          Row < Height && Col < Width ? Src[Row * SrcPitch + Col] : 0;
+      ASSERT_EQ(Dst[I], Expected) << "row " << Row << " col " << Col;
+    }
+  }
+
+  static constexpr size_t Size = 4 << 20;
+  void *src = nullptr;
+  void *dst = nullptr;
+};
+
+UUR_INSTANTIATE_DEVICE_TEST_SUITE(urOpenCLUSMMemcpy2DTest);
+
+TEST_P(urOpenCLUSMMemcpy2DTest, Contiguous) {
+  copyAndVerify(256, 256, 256, 64);
+}
+
+TEST_P(urOpenCLUSMMemcpy2DTest, Padded) { copyAndVerify(300, 500, 257, 100); }
+
+TEST_P(urOpenCLUSMMemcpy2DTest, PaddedAligned) {
+  copyAndVerify(1024, 512, 496, 1000);
+}
+
+TEST_P(urOpenCLUSMMemcpy2DTest, RowCounts) {
+  // A single row is one memcpy, more rows one kernel, with and without
+  // vectorized accesses.
+  for (size_t Height : {1, 2, 3, 17, 1000, 4096}) {
+    SCOPED_TRACE("height " + std::to_string(Height));
+    ASSERT_NO_FATAL_FAILURE(copyAndVerify(1024, 512, 496, Height));
+    ASSERT_NO_FATAL_FAILURE(copyAndVerify(1000, 999, 997, Height));
+  }
+}
+
+TEST_P(urOpenCLUSMMemcpy2DTest, PageableHostSource) {
+  // The kernel can't read pageable host memory, so the rows are copied one by
+  // one.
+  constexpr size_t DstPitch = 600, SrcPitch = 700, Width = 555, Height = 300;
+  std::vector<uint8_t> Src(SrcPitch * Height), Dst(Size, 0);
+  for (size_t I = 0; I < Src.size(); I++) {
+    Src[I] = static_cast<uint8_t>(I * 7 + 3);
+  }
+  ASSERT_SUCCESS(urEnqueueUSMMemcpy(queue, true, dst, Dst.data(), Size, 0,
+                                    nullptr, nullptr));
+
+  ASSERT_SUCCESS(urEnqueueUSMMemcpy2D(queue, true, dst, DstPitch, Src.data(),
+                                      SrcPitch, Width, Height, 0, nullptr,
+                                      nullptr));
+
+  ASSERT_SUCCESS(urEnqueueUSMMemcpy(queue, true, Dst.data(), dst, Size, 0,
+                                    nullptr, nullptr));
+  for (size_t I = 0; I < Size; I++) {
+    const size_t Row = I / DstPitch;
+    const size_t Col = I % DstPitch;
+    const uint8_t Expected =
+        Row < Height && Col < Width ? Src[Row * SrcPitch + Col] : 0;
+    ASSERT_EQ(Dst[I], Expected) << "row " << Row << " col " << Col;
+  }
+}
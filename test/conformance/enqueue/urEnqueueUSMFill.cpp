@@ -92,7 +92,12 @@ static std::vector<testParametersFill> test_cases{
     {256, 4},
     {256, 8},
     {256, 16},
-    {256, 32}};
+    {256, 32},
+    /* pattern sizes which can't be filled natively by every adapter */
+    {768, 24},
+    {4096, 256},
+    /* fills much larger than a non power of 2 pattern */
+    {(1 << 20) + (1 << 18), 20}};
 
 UUR_DEVICE_TEST_SUITE_WITH_PARAM(
     urEnqueueUSMFillTestWithParam, testing::ValuesIn(test_cases),
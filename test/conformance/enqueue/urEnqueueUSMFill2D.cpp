@@ -128,7 +128,11 @@ static std::vector<testParametersFill2D> test_cases{
     /* Height != power_of_2 && Pitch == width + 1 && pattern_size == 1 */
     {234, 233, 35, 1},
     /* Height != power_of_2 && width == power_of_2 && pattern_size == 128 */
-    {1024, 256, 35, 128}};
+    {1024, 256, 35, 128},
+    /* Height > 1 && Pitch > width && width % pattern_size != 0 */
+    {128, 96, 10, 64},
+    /* Height > 1 && Pitch > width && pattern_size > width */
+    {512, 128, 40, 256}};
 
 UUR_DEVICE_TEST_SUITE_WITH_PARAM(
     urEnqueueUSMFill2DTestWithParam, testing::ValuesIn(test_cases),
@@ -6,6 +6,9 @@
 
 #include <uur/fixtures.h>
 
+#include <cstdio>
+#include <memory>
+
 struct urProgramCreateWithBinaryTest : uur::urProgramTest {
   void SetUp() override {
     UUR_RETURN_ON_FATAL_FAILURE(urProgramTest::SetUp());
@@ -68,6 +71,44 @@ TEST_P(urProgramCreateWithBinaryTest, InvalidNullPointerBinary) {
                                              &binary_program));
 }
 
+TEST_P(urProgramCreateWithBinaryTest,
+       InvalidNullPointerBinaryWithoutFileSource) {
+  // A chained structure only stands in for the binaries if it's a file
+  // source.
+  ur_usm_desc_t unrelated = {};
+  unrelated.stype = UR_STRUCTURE_TYPE_USM_DESC;
+  ur_program_properties_t properties{UR_STRUCTURE_TYPE_PROGRAM_PROPERTIES,
+                                     &unrelated, 0, nullptr};
+  auto size = binary.size();
+  ASSERT_EQ_RESULT(UR_RESULT_ERROR_INVALID_NULL_POINTER,
+                   urProgramCreateWithBinary(context, 1, &device, &size,
+                                             nullptr, &properties,
+                                             &binary_program));
+}
+
+TEST_P(urProgramCreateWithBinaryTest, SuccessWithFileSource) {
+  std::unique_ptr<FILE, decltype(&std::fclose)> file(std::tmpfile(),
+                                                     &std::fclose);
+  ASSERT_NE(file, nullptr);
+  ASSERT_EQ(std::fwrite(binary.data(), 1, binary.size(), file.get()),
+            binary.size());
+  ASSERT_EQ(std::fflush(file.get()), 0);
+
+  ur_exp_file_region_t region{fileno(file.get()), 0};
+  ur_exp_program_file_source_t source{
+      UR_STRUCTURE_TYPE_EXP_PROGRAM_FILE_SOURCE, nullptr, 1, &region};
+  ur_program_properties_t properties{UR_STRUCTURE_TYPE_PROGRAM_PROPERTIES,
+                                     &source, 0, nullptr};
+  auto size = binary.size();
+  auto result = urProgramCreateWithBinary(context, 1, &device, &size, nullptr,
+                                          &properties, &binary_program);
+  if (result == UR_RESULT_ERROR_UNSUPPORTED_FEATURE) {
+    GTEST_SKIP() << "Loading binaries from files is not supported.";
+  }
+  ASSERT_SUCCESS(result);
+  ASSERT_NE(binary_program, nullptr);
+}
+
 TEST_P(urProgramCreateWithBinaryTest, InvalidNullPointerProgram) {
   auto size = binary.size();
   const uint8_t *data = binary.data();
@@ -7,6 +7,9 @@
 #include <uur/fixtures.h>
 #include <uur/known_failure.h>
 
+#include <cstdio>
+#include <memory>
+
 struct urProgramCreateWithILTest : uur::urContextTest {
   void SetUp() override {
     // We haven't got device code tests working on native cpu yet.
@@ -69,6 +72,42 @@ TEST_P(urProgramCreateWithILTest, InvalidNullPointerSource) {
                                          nullptr, &program));
 }
 
+TEST_P(urProgramCreateWithILTest, InvalidNullPointerSourceWithoutFileSource) {
+  // A chained structure only stands in for the IL if it's a file source.
+  ur_usm_desc_t unrelated = {};
+  unrelated.stype = UR_STRUCTURE_TYPE_USM_DESC;
+  ur_program_properties_t properties{UR_STRUCTURE_TYPE_PROGRAM_PROPERTIES,
+                                     &unrelated, 0, nullptr};
+  ur_program_handle_t program = nullptr;
+  ASSERT_EQ_RESULT(UR_RESULT_ERROR_INVALID_NULL_POINTER,
+                   urProgramCreateWithIL(context, nullptr, il_binary->size(),
+                                         &properties, &program));
+}
+
+TEST_P(urProgramCreateWithILTest, SuccessWithFileSource) {
+  std::unique_ptr<FILE, decltype(&std::fclose)> file(std::tmpfile(),
+                                                     &std::fclose);
+  ASSERT_NE(file, nullptr);
+  ASSERT_EQ(std::fwrite(il_binary->data(), 1, il_binary->size(), file.get()),
+            il_binary->size());
+  ASSERT_EQ(std::fflush(file.get()), 0);
+
+  ur_exp_file_region_t region{fileno(file.get()), 0};
+  ur_exp_program_file_source_t source{
+      UR_STRUCTURE_TYPE_EXP_PROGRAM_FILE_SOURCE, nullptr, 1, &region};
+  ur_program_properties_t properties{UR_STRUCTURE_TYPE_PROGRAM_PROPERTIES,
+                                     &source, 0, nullptr};
+  ur_program_handle_t program = nullptr;
+  auto result = urProgramCreateWithIL(context, nullptr, il_binary->size(),
+                                      &properties, &program);
+  if (result == UR_RESULT_ERROR_UNSUPPORTED_FEATURE) {
+    GTEST_SKIP() << "Loading IL from files is not supported.";
+  }
+  ASSERT_SUCCESS(result);
+  ASSERT_NE(nullptr, program);
+  ASSERT_SUCCESS(urProgramRelease(program));
+}
+
 TEST_P(urProgramCreateWithILTest, InvalidSizeLength) {
   ur_program_handle_t program = nullptr;
   ASSERT_EQ_RESULT(
@@ -24,6 +24,16 @@ namespace uur {
 
 template <class T> bool isQueryOptional(T) { return false; }
 
+constexpr std::array optional_ur_adapter_info_t = {
+    UR_ADAPTER_INFO_LATENCY_HISTOGRAM_EXP,
+};
+
+template <> inline bool isQueryOptional(ur_adapter_info_t query) {
+  return std::find(optional_ur_adapter_info_t.begin(),
+                   optional_ur_adapter_info_t.end(),
+                   query) != optional_ur_adapter_info_t.end();
+}
+
 constexpr std::array optional_ur_device_info_t = {
     UR_DEVICE_INFO_DEVICE_ID,
     UR_DEVICE_INFO_MEMORY_CLOCK_RATE,
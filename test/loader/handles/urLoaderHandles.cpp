@@ -39,3 +39,53 @@ TEST_F(LoaderHandleTest, SuccessArraySizeRet) {
   ASSERT_EQ(query_platform[0], platform);
   ASSERT_EQ(query_platform[1], (ur_platform_handle_t)0xBEEF);
 }
+
+ur_kernel_handle_t adapterKernel = nullptr;
+ur_kernel_handle_t batchedKernel = nullptr;
+
+ur_result_t after_urKernelCreate(void *pParams) {
+  const auto &params = *static_cast<ur_kernel_create_params_t *>(pParams);
+  adapterKernel = **params.pphKernel;
+  return UR_RESULT_SUCCESS;
+}
+
+ur_result_t before_urEnqueueBatchExp(void *pParams) {
+  const auto &params = *static_cast<ur_enqueue_batch_exp_params_t *>(pParams);
+  batchedKernel = (*params.ppCommands)[0].args.kernelLaunch.hKernel;
+  return UR_RESULT_SUCCESS;
+}
+
+TEST_F(LoaderHandleTest, SuccessBatchKernelHandle) {
+  mock::getCallbacks().set_after_callback("urKernelCreate",
+                                          &after_urKernelCreate);
+  mock::getCallbacks().set_before_callback("urEnqueueBatchExp",
+                                           &before_urEnqueueBatchExp);
+
+  ur_context_handle_t context = nullptr;
+  ASSERT_SUCCESS(urContextCreate(1, &device, nullptr, &context));
+  ur_queue_handle_t queue = nullptr;
+  ASSERT_SUCCESS(urQueueCreate(context, device, nullptr, &queue));
+  const uint8_t il[] = {0x03, 0x02, 0x23, 0x07};
+  ur_program_handle_t program = nullptr;
+  ASSERT_SUCCESS(
+      urProgramCreateWithIL(context, il, sizeof(il), nullptr, &program));
+  ur_kernel_handle_t kernel = nullptr;
+  ASSERT_SUCCESS(urKernelCreate(program, "kernel", &kernel));
+  ASSERT_NE(adapterKernel, nullptr);
+
+  const size_t globalSize = 1;
+  ur_exp_batch_command_t commands[2] = {};
+  commands[0].type = UR_EXP_BATCH_COMMAND_TYPE_KERNEL_LAUNCH;
+  commands[0].args.kernelLaunch = {kernel, 1, nullptr, &globalSize, nullptr};
+  commands[1].type = UR_EXP_BATCH_COMMAND_TYPE_BARRIER;
+  ur_event_handle_t event = nullptr;
+  ASSERT_SUCCESS(urEnqueueBatchExp(queue, 2, commands, 0, nullptr, &event));
+  ASSERT_EQ(batchedKernel, adapterKernel);
+  ASSERT_NE(event, nullptr);
+
+  urEventRelease(event);
+  urKernelRelease(kernel);
+  urProgramRelease(program);
+  urQueueRelease(queue);
+  urContextRelease(context);
+}
@@ -102,3 +102,38 @@ TEST(Mock, Callbacks) {
       reinterpret_cast<ur_adapter_handle_t>(uintptr_t(0xF00DCAFE));
   ASSERT_EQ(urAdapterGet(1, &adapter, nullptr), UR_RESULT_SUCCESS);
 }
+
+TEST(Mock, HostTask) {
+  uur::raii::LoaderConfig loader_config;
+  ASSERT_EQ(urLoaderConfigCreate(loader_config.ptr()), UR_RESULT_SUCCESS);
+  ASSERT_EQ(urLoaderConfigSetMockingEnabled(loader_config, true),
+            UR_RESULT_SUCCESS);
+  ASSERT_EQ(urLoaderInit(0, loader_config), UR_RESULT_SUCCESS);
+
+  ur_adapter_handle_t adapter = nullptr;
+  ur_platform_handle_t platform = nullptr;
+  ur_device_handle_t device = nullptr;
+  ur_context_handle_t context = nullptr;
+  ur_queue_handle_t queue = nullptr;
+  ASSERT_EQ(urAdapterGet(1, &adapter, nullptr), UR_RESULT_SUCCESS);
+  ASSERT_EQ(urPlatformGet(&adapter, 1, 1, &platform, nullptr),
+            UR_RESULT_SUCCESS);
+  ASSERT_EQ(urDeviceGet(platform, UR_DEVICE_TYPE_ALL, 1, &device, nullptr),
+            UR_RESULT_SUCCESS);
+  ASSERT_EQ(urContextCreate(1, &device, nullptr, &context), UR_RESULT_SUCCESS);
+  ASSERT_EQ(urQueueCreate(context, device, nullptr, &queue), UR_RESULT_SUCCESS);
+
+  // The mock adapter runs host tasks inline.
+  int calls = 0;
+  auto hostTask = [](void *pUserData) { ++*static_cast<int *>(pUserData); };
+  ur_event_handle_t event = nullptr;
+  ASSERT_EQ(urEnqueueHostTaskExp(queue, hostTask, &calls, 0, nullptr, &event),
+            UR_RESULT_SUCCESS);
+  ASSERT_EQ(calls, 1);
+  ASSERT_NE(event, nullptr);
+
+  ASSERT_EQ(urEventRelease(event), UR_RESULT_SUCCESS);
+  ASSERT_EQ(urQueueRelease(queue), UR_RESULT_SUCCESS);
+  ASSERT_EQ(urContextRelease(context), UR_RESULT_SUCCESS);
+  ASSERT_EQ(urDeviceRelease(device), UR_RESULT_SUCCESS);
+}
@@ -0,0 +1,236 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <gtest/gtest.h>
+
+#include "ur_enqueue_batch.hpp"
+
+#include <cstdint>
+#include <set>
+#include <vector>
+
+namespace {
+
+// Commands enqueued through the fake entry points below, which hand out
+// events numbered from 1.
+struct enqueued_t {
+  ur_command_t type;
+  std::vector<ur_event_handle_t> waitList;
+  ur_event_handle_t event;
+};
+
+std::vector<enqueued_t> enqueued;
+std::set<ur_event_handle_t> released;
+uintptr_t nextEvent = 1;
+
+ur_result_t record(ur_command_t type, uint32_t numEventsInWaitList,
+                   const ur_event_handle_t *phEventWaitList,
+                   ur_event_handle_t *phEvent) {
+  ur_event_handle_t event = nullptr;
+  if (phEvent) {
+    event = reinterpret_cast<ur_event_handle_t>(nextEvent++);
+    *phEvent = event;
+  }
+  enqueued.push_back(
+      {type,
+       {phEventWaitList, phEventWaitList + numEventsInWaitList},
+       event});
+  return UR_RESULT_SUCCESS;
+}
+
+ur_result_t UR_APICALL
+fakeKernelLaunch(ur_queue_handle_t, ur_kernel_handle_t, uint32_t,
+                 const size_t *, const size_t *, const size_t *,
+                 uint32_t numEventsInWaitList,
+                 const ur_event_handle_t *phEventWaitList,
+                 ur_event_handle_t *phEvent) {
+  return record(UR_COMMAND_KERNEL_LAUNCH, numEventsInWaitList, phEventWaitList,
+                phEvent);
+}
+
+ur_result_t UR_APICALL fakeUSMMemcpy(ur_queue_handle_t, bool blocking, void *,
+                                     const void *, size_t,
+                                     uint32_t numEventsInWaitList,
+                                     const ur_event_handle_t *phEventWaitList,
+                                     ur_event_handle_t *phEvent) {
+  EXPECT_FALSE(blocking);
+  return record(UR_COMMAND_USM_MEMCPY, numEventsInWaitList, phEventWaitList,
+                phEvent);
+}
+
+ur_result_t UR_APICALL fakeUSMFill(ur_queue_handle_t, void *, size_t,
+                                   const void *, size_t,
+                                   uint32_t numEventsInWaitList,
+                                   const ur_event_handle_t *phEventWaitList,
+                                   ur_event_handle_t *phEvent) {
+  return record(UR_COMMAND_USM_FILL, numEventsInWaitList, phEventWaitList,
+                phEvent);
+}
+
+ur_result_t UR_APICALL fakeEventsWait(ur_queue_handle_t,
+                                      uint32_t numEventsInWaitList,
+                                      const ur_event_handle_t *phEventWaitList,
+                                      ur_event_handle_t *phEvent) {
+  return record(UR_COMMAND_EVENTS_WAIT, numEventsInWaitList, phEventWaitList,
+                phEvent);
+}
+
+ur_result_t UR_APICALL
+fakeEventsWaitWithBarrier(ur_queue_handle_t, uint32_t numEventsInWaitList,
+                          const ur_event_handle_t *phEventWaitList,
+                          ur_event_handle_t *phEvent) {
+  return record(UR_COMMAND_EVENTS_WAIT_WITH_BARRIER, numEventsInWaitList,
+                phEventWaitList, phEvent);
+}
+
+ur_result_t UR_APICALL fakeEventRelease(ur_event_handle_t hEvent) {
+  EXPECT_TRUE(released.insert(hEvent).second);
+  return UR_RESULT_SUCCESS;
+}
+
+const ur::batch::enqueue_fns_t fakeFns = {
+    fakeKernelLaunch,
+    fakeUSMMemcpy,
+    fakeUSMFill,
+    fakeEventsWait,
+    fakeEventsWaitWithBarrier,
+    fakeEventRelease,
+};
+
+ur_event_handle_t event(uintptr_t id) {
+  return reinterpret_cast<ur_event_handle_t>(id);
+}
+
+ur_exp_batch_command_t command(ur_exp_batch_command_type_t type,
+                               const std::vector<uint32_t> &deps = {}) {
+  ur_exp_batch_command_t command{};
+  command.type = type;
+  command.numDepsInBatch = static_cast<uint32_t>(deps.size());
+  command.pDepsInBatch = deps.empty() ? nullptr : deps.data();
+  return command;
+}
+
+struct EnqueueBatchByCommand : ::testing::Test {
+  void SetUp() override {
+    enqueued.clear();
+    released.clear();
+    nextEvent = 1;
+  }
+
+  ur_result_t enqueue(const std::vector<ur_exp_batch_command_t> &commands,
+                      const std::vector<ur_event_handle_t> &waitList,
+                      ur_event_handle_t *phEvent) {
+    return ur::batch::enqueueByCommand(
+        fakeFns, nullptr, static_cast<uint32_t>(commands.size()),
+        commands.data(), static_cast<uint32_t>(waitList.size()),
+        waitList.empty() ? nullptr : waitList.data(), phEvent);
+  }
+};
+
+} // namespace
+
+TEST_F(EnqueueBatchByCommand, IndependentCommandsHaveNoEvents) {
+  std::vector<ur_exp_batch_command_t> commands = {
+      command(UR_EXP_BATCH_COMMAND_TYPE_KERNEL_LAUNCH),
+      command(UR_EXP_BATCH_COMMAND_TYPE_USM_MEMCPY),
+      command(UR_EXP_BATCH_COMMAND_TYPE_USM_FILL)};
+  ur_event_handle_t external = event(100);
+
+  ASSERT_EQ(enqueue(commands, {external}, nullptr), UR_RESULT_SUCCESS);
+
+  ASSERT_EQ(enqueued.size(), 3u);
+  ASSERT_EQ(enqueued[0].type, UR_COMMAND_KERNEL_LAUNCH);
+  ASSERT_EQ(enqueued[1].type, UR_COMMAND_USM_MEMCPY);
+  ASSERT_EQ(enqueued[2].type, UR_COMMAND_USM_FILL);
+  for (auto &command : enqueued) {
+    ASSERT_EQ(command.waitList, std::vector<ur_event_handle_t>{external});
+    ASSERT_EQ(command.event, nullptr);
+  }
+  ASSERT_TRUE(released.empty());
+}
+
+TEST_F(EnqueueBatchByCommand, DependenciesWaitForEvents) {
+  std::vector<uint32_t> deps = {0, 1};
+  std::vector<ur_exp_batch_command_t> commands = {
+      command(UR_EXP_BATCH_COMMAND_TYPE_USM_FILL),
+      command(UR_EXP_BATCH_COMMAND_TYPE_USM_FILL),
+      command(UR_EXP_BATCH_COMMAND_TYPE_KERNEL_LAUNCH, deps)};
+
+  ASSERT_EQ(enqueue(commands, {}, nullptr), UR_RESULT_SUCCESS);
+
+  ASSERT_EQ(enqueued.size(), 3u);
+  ASSERT_EQ(enqueued[2].waitList,
+            (std::vector<ur_event_handle_t>{event(1), event(2)}));
+  ASSERT_EQ(enqueued[2].event, nullptr);
+  ASSERT_EQ(released, (std::set<ur_event_handle_t>{event(1), event(2)}));
+}
+
+TEST_F(EnqueueBatchByCommand, BarriersWaitForTheirSegment) {
+  std::vector<ur_exp_batch_command_t> commands = {
+      command(UR_EXP_BATCH_COMMAND_TYPE_KERNEL_LAUNCH),
+      command(UR_EXP_BATCH_COMMAND_TYPE_KERNEL_LAUNCH),
+      command(UR_EXP_BATCH_COMMAND_TYPE_BARRIER),
+      command(UR_EXP_BATCH_COMMAND_TYPE_KERNEL_LAUNCH),
+      command(UR_EXP_BATCH_COMMAND_TYPE_BARRIER)};
+
+  ASSERT_EQ(enqueue(commands, {}, nullptr), UR_RESULT_SUCCESS);
+
+  ASSERT_EQ(enqueued.size(), 5u);
+  ASSERT_EQ(enqueued[2].type, UR_COMMAND_EVENTS_WAIT_WITH_BARRIER);
+  ASSERT_EQ(enqueued[2].waitList,
+            (std::vector<ur_event_handle_t>{event(1), event(2)}));
+  ASSERT_EQ(enqueued[4].waitList,
+            (std::vector<ur_event_handle_t>{event(3), event(4)}));
+  ASSERT_EQ(enqueued[4].event, nullptr);
+  ASSERT_EQ(released.size(), 4u);
+}
+
+TEST_F(EnqueueBatchByCommand, BatchEventWaitsForLastSegment) {
+  std::vector<ur_exp_batch_command_t> commands = {
+      command(UR_EXP_BATCH_COMMAND_TYPE_KERNEL_LAUNCH),
+      command(UR_EXP_BATCH_COMMAND_TYPE_BARRIER),
+      command(UR_EXP_BATCH_COMMAND_TYPE_USM_MEMCPY),
+      command(UR_EXP_BATCH_COMMAND_TYPE_USM_FILL)};
+  ur_event_handle_t batchEvent = nullptr;
+
+  ASSERT_EQ(enqueue(commands, {}, &batchEvent), UR_RESULT_SUCCESS);
+
+  ASSERT_EQ(enqueued.size(), 5u);
+  ASSERT_EQ(enqueued[4].type, UR_COMMAND_EVENTS_WAIT);
+  ASSERT_EQ(enqueued[4].waitList,
+            (std::vector<ur_event_handle_t>{event(2), event(3), event(4)}));
+  ASSERT_EQ(batchEvent, enqueued[4].event);
+  ASSERT_EQ(released.size(), 4u);
+  ASSERT_EQ(released.count(batchEvent), 0u);
+}
+
+TEST_F(EnqueueBatchByCommand, BatchEventOfSingleCommand) {
+  std::vector<ur_exp_batch_command_t> commands = {
+      command(UR_EXP_BATCH_COMMAND_TYPE_USM_FILL),
+      command(UR_EXP_BATCH_COMMAND_TYPE_BARRIER)};
+  ur_event_handle_t batchEvent = nullptr;
+
+  ASSERT_EQ(enqueue(commands, {}, &batchEvent), UR_RESULT_SUCCESS);
+
+  ASSERT_EQ(enqueued.size(), 2u);
+  ASSERT_EQ(batchEvent, enqueued[1].event);
+  ASSERT_EQ(released, std::set<ur_event_handle_t>{event(1)});
+}
+
+TEST_F(EnqueueBatchByCommand, InvalidDependency) {
+  std::vector<uint32_t> deps = {1};
+  std::vector<ur_exp_batch_command_t> commands = {
+      command(UR_EXP_BATCH_COMMAND_TYPE_USM_FILL),
+      command(UR_EXP_BATCH_COMMAND_TYPE_USM_FILL, deps)};
+
+  ASSERT_EQ(enqueue(commands, {}, nullptr), UR_RESULT_ERROR_INVALID_VALUE);
+  ASSERT_TRUE(enqueued.empty());
+
+  commands[1].type = static_cast<ur_exp_batch_command_type_t>(42);
+  commands[1].numDepsInBatch = 0;
+  ASSERT_EQ(enqueue(commands, {}, nullptr),
+            UR_RESULT_ERROR_INVALID_ENUMERATION);
+}
@@ -0,0 +1,99 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <gtest/gtest.h>
+
+#include "ur_enqueue_host_task.hpp"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+// Calls made through the fake entry points below, in order.
+std::vector<std::string> calls;
+ur_result_t barrierResult = UR_RESULT_SUCCESS;
+const ur_event_handle_t barrierEvent = reinterpret_cast<ur_event_handle_t>(1);
+
+ur_result_t UR_APICALL fakeEventsWaitWithBarrier(ur_queue_handle_t,
+                                                 uint32_t numEventsInWaitList,
+                                                 const ur_event_handle_t *,
+                                                 ur_event_handle_t *phEvent) {
+  calls.push_back("barrier " + std::to_string(numEventsInWaitList));
+  if (barrierResult == UR_RESULT_SUCCESS) {
+    *phEvent = barrierEvent;
+  }
+  return barrierResult;
+}
+
+ur_result_t UR_APICALL fakeEventWait(uint32_t numEvents,
+                                     const ur_event_handle_t *phEventWaitList) {
+  EXPECT_EQ(numEvents, 1u);
+  EXPECT_EQ(phEventWaitList[0], barrierEvent);
+  calls.push_back("wait");
+  return UR_RESULT_SUCCESS;
+}
+
+ur_result_t UR_APICALL fakeEventRelease(ur_event_handle_t hEvent) {
+  EXPECT_EQ(hEvent, barrierEvent);
+  calls.push_back("release");
+  return UR_RESULT_SUCCESS;
+}
+
+void hostTask(void *pUserData) {
+  calls.push_back(*static_cast<std::string *>(pUserData));
+}
+
+const ur::host_task::enqueue_fns_t fakeFns = {
+    fakeEventsWaitWithBarrier,
+    fakeEventWait,
+    fakeEventRelease,
+};
+
+struct EnqueueHostTaskAndWait : ::testing::Test {
+  void SetUp() override {
+    calls.clear();
+    barrierResult = UR_RESULT_SUCCESS;
+  }
+
+  std::string task = "task";
+};
+
+} // namespace
+
+TEST_F(EnqueueHostTaskAndWait, RunsAfterBarrier) {
+  ur_event_handle_t waitEvent = reinterpret_cast<ur_event_handle_t>(2);
+
+  ASSERT_EQ(ur::host_task::enqueueAndWait(fakeFns, nullptr, hostTask, &task, 1,
+                                          &waitEvent, nullptr),
+            UR_RESULT_SUCCESS);
+
+  ASSERT_EQ(calls, (std::vector<std::string>{"barrier 1", "wait", "task",
+                                             "release"}));
+}
+
+TEST_F(EnqueueHostTaskAndWait, ReturnsBarrierEvent) {
+  ur_event_handle_t event = nullptr;
+
+  ASSERT_EQ(ur::host_task::enqueueAndWait(fakeFns, nullptr, hostTask, &task, 0,
+                                          nullptr, &event),
+            UR_RESULT_SUCCESS);
+
+  ASSERT_EQ(event, barrierEvent);
+  ASSERT_EQ(calls, (std::vector<std::string>{"barrier 0", "wait", "task"}));
+}
+
+TEST_F(EnqueueHostTaskAndWait, BarrierFailure) {
+  barrierResult = UR_RESULT_ERROR_OUT_OF_RESOURCES;
+  ur_event_handle_t event = nullptr;
+
+  ASSERT_EQ(ur::host_task::enqueueAndWait(fakeFns, nullptr, hostTask, &task, 0,
+                                          nullptr, &event),
+            UR_RESULT_ERROR_OUT_OF_RESOURCES);
+
+  ASSERT_EQ(event, nullptr);
+  ASSERT_EQ(calls, std::vector<std::string>{"barrier 0"});
+}
@@ -0,0 +1,109 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <gtest/gtest.h>
+
+#include "ur_file_mapping.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+struct FileMapping : ::testing::Test {
+  void SetUp() override {
+    file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    // Large enough for regions to straddle page boundaries.
+    contents.resize(3 * 65536 + 123);
+    for (size_t i = 0; i < contents.size(); i++) {
+      contents[i] = static_cast<char>(i * 31 + 7);
+    }
+    ASSERT_EQ(std::fwrite(contents.data(), 1, contents.size(), file),
+              contents.size());
+    ASSERT_EQ(std::fflush(file), 0);
+  }
+
+  void TearDown() override { std::fclose(file); }
+
+  ur_exp_file_region_t region(uint64_t offset) {
+    return {fileno(file), offset};
+  }
+
+  FILE *file = nullptr;
+  std::vector<char> contents;
+};
+
+} // namespace
+
+TEST_F(FileMapping, MapsRegion) {
+  for (uint64_t offset : {0ull, 1ull, 4095ull, 65536ull, 65537ull}) {
+    ur::file_mapping_t mapping;
+    ASSERT_EQ(mapping.map(region(offset), 70000), UR_RESULT_SUCCESS);
+    ASSERT_EQ(mapping.size(), 70000u);
+    ASSERT_EQ(std::memcmp(mapping.data(), contents.data() + offset, 70000), 0)
+        << "offset " << offset;
+  }
+}
+
+TEST_F(FileMapping, MapsUpToEndOfFile) {
+  ur::file_mapping_t mapping;
+  ASSERT_EQ(mapping.map(region(contents.size() - 10), 10), UR_RESULT_SUCCESS);
+  ASSERT_EQ(std::memcmp(mapping.data(), contents.data() + contents.size() - 10,
+                        10),
+            0);
+}
+
+TEST_F(FileMapping, InvalidRegions) {
+  ur::file_mapping_t mapping;
+  ASSERT_EQ(mapping.map(region(0), 0), UR_RESULT_ERROR_INVALID_SIZE);
+  ASSERT_EQ(mapping.map(region(contents.size() - 10), 11),
+            UR_RESULT_ERROR_INVALID_SIZE);
+  ASSERT_EQ(mapping.map(region(contents.size() + 1), 1),
+            UR_RESULT_ERROR_INVALID_SIZE);
+  ASSERT_EQ(mapping.map({-1, 0}, 1), UR_RESULT_ERROR_INVALID_VALUE);
+  ASSERT_EQ(mapping.data(), nullptr);
+}
+
+TEST_F(FileMapping, MoveTransfersMapping) {
+  ur::file_mapping_t a;
+  ASSERT_EQ(a.map(region(100), 200), UR_RESULT_SUCCESS);
+  const void *data = a.data();
+
+  ur::file_mapping_t b = std::move(a);
+  ASSERT_EQ(a.data(), nullptr);
+  ASSERT_EQ(b.data(), data);
+  ASSERT_EQ(std::memcmp(b.data(), contents.data() + 100, 200), 0);
+}
+
+TEST_F(FileMapping, ProgramFileSource) {
+  ur_exp_file_region_t regions[] = {region(10), region(70000)};
+  ur_exp_program_file_source_t fileSource = {
+      UR_STRUCTURE_TYPE_EXP_PROGRAM_FILE_SOURCE, nullptr, 2, regions};
+  ur_program_properties_t properties = {UR_STRUCTURE_TYPE_PROGRAM_PROPERTIES,
+                                        &fileSource, 0, nullptr};
+  size_t lengths[] = {20, 30};
+
+  std::vector<ur::file_mapping_t> mappings;
+  ASSERT_EQ(ur::mapProgramFileSource(&properties, 2, lengths, mappings),
+            UR_RESULT_SUCCESS);
+  ASSERT_EQ(mappings.size(), 2u);
+  ASSERT_EQ(std::memcmp(mappings[0].data(), contents.data() + 10, 20), 0);
+  ASSERT_EQ(std::memcmp(mappings[1].data(), contents.data() + 70000, 30), 0);
+
+  ASSERT_EQ(ur::mapProgramFileSource(&properties, 1, lengths, mappings),
+            UR_RESULT_ERROR_INVALID_SIZE);
+  ASSERT_TRUE(mappings.empty());
+
+  properties.pNext = nullptr;
+  ASSERT_EQ(ur::mapProgramFileSource(&properties, 2, lengths, mappings),
+            UR_RESULT_SUCCESS);
+  ASSERT_TRUE(mappings.empty());
+  ASSERT_EQ(ur::mapProgramFileSource(nullptr, 2, lengths, mappings),
+            UR_RESULT_SUCCESS);
+  ASSERT_TRUE(mappings.empty());
+}
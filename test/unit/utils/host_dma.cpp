@@ -0,0 +1,191 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <gtest/gtest.h>
+
+#include "ur_host_dma.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using ur::dma::isa_t;
+
+namespace {
+
+std::vector<isa_t> supportedIsas() {
+  std::vector<isa_t> Isas;
+  for (isa_t Isa :
+       {isa_t::generic, isa_t::sse2, isa_t::avx2, isa_t::avx512}) {
+    if (Isa <= ur::dma::getIsa()) {
+      Isas.push_back(Isa);
+    }
+  }
+  return Isas;
+}
+
+std::vector<uint8_t> makePattern(size_t Size) {
+  std::vector<uint8_t> Pattern(Size);
+  for (size_t I = 0; I < Size; I++) {
+    Pattern[I] = static_cast<uint8_t>(I * 7 + 1);
+  }
+  return Pattern;
+}
+
+// Checks that [Offset, Offset + Size) holds the pattern and that the guard
+// bytes around it are untouched.
+void expectFilled(const std::vector<uint8_t> &Buffer, size_t Offset,
+                  size_t Size, const std::vector<uint8_t> &Pattern,
+                  uint8_t Guard) {
+  for (size_t I = 0; I < Offset; I++) {
+    ASSERT_EQ(Buffer[I], Guard) << "at " << I;
+  }
+  for (size_t I = 0; I < Size; I++) {
+    ASSERT_EQ(Buffer[Offset + I], Pattern[I % Pattern.size()])
+        << "at " << Offset + I;
+  }
+  for (size_t I = Offset + Size; I < Buffer.size(); I++) {
+    ASSERT_EQ(Buffer[I], Guard) << "at " << I;
+  }
+}
+
+} // namespace
+
+TEST(hostDma, fillAllIsas) {
+  constexpr uint8_t Guard = 0xaa;
+  for (isa_t Isa : supportedIsas()) {
+    for (size_t PatternSize : {1, 2, 3, 4, 8, 12, 16, 32, 64, 128}) {
+      const auto Pattern = makePattern(PatternSize);
+      for (size_t Offset : {0, 1, 7, 33}) {
+        for (size_t Count : {0, 1, 5, 63, 64, 65, 1000}) {
+          SCOPED_TRACE(std::string(ur::dma::getIsaName(Isa)) + " pattern " +
+                       std::to_string(PatternSize) + " offset " +
+                       std::to_string(Offset) + " count " +
+                       std::to_string(Count));
+          const size_t Size = Count * PatternSize;
+          std::vector<uint8_t> Buffer(Offset + Size + 128, Guard);
+          ur::dma::detail::fill(Isa, Buffer.data() + Offset, Pattern.data(),
+                                PatternSize, Size);
+          expectFilled(Buffer, Offset, Size, Pattern, Guard);
+        }
+      }
+    }
+  }
+}
+
+TEST(hostDma, parallelFill) {
+  const auto Executor = ur::dma::makeThreadExecutor(4);
+  for (size_t PatternSize : {1, 4, 12, 64, 128}) {
+    SCOPED_TRACE("pattern " + std::to_string(PatternSize));
+    const auto Pattern = makePattern(PatternSize);
+    const size_t Size = (24 << 20) / PatternSize * PatternSize;
+    std::vector<uint8_t> Buffer(Size + 3, 0);
+    ur::dma::fill(Buffer.data() + 3, Pattern.data(), PatternSize, Size,
+                  Executor);
+    expectFilled(Buffer, 3, Size, Pattern, 0);
+  }
+}
+
+TEST(hostDma, fill2D) {
+  const auto Executor = ur::dma::makeThreadExecutor(4);
+  constexpr size_t Pitch = 3000, Width = 2000, Height = 1000;
+  const uint32_t Pattern = 0x01020304;
+  std::vector<uint8_t> Buffer(Pitch * Height, 0);
+  ur::dma::fill2D(Buffer.data() + 1, Pitch, &Pattern, sizeof(Pattern), Width,
+                  Height, Executor);
+  const auto *PatternBytes = reinterpret_cast<const uint8_t *>(&Pattern);
+  for (size_t Row = 0; Row < Height; Row++) {
+    for (size_t Col = 0; Col < Pitch; Col++) {
+      const uint8_t Expected = (Col >= 1 && Col < Width + 1)
+                                   ? PatternBytes[(Col - 1) % sizeof(Pattern)]
+                                   : 0;
+      ASSERT_EQ(Buffer[Row * Pitch + Col], Expected)
+          << "row " << Row << " col " << Col;
+    }
+  }
+}
+
+TEST(hostDma, setAndCopy) {
+  const auto Executor = ur::dma::makeThreadExecutor(4);
+  constexpr size_t Size = 20 << 20;
+  std::vector<uint8_t> Src(Size), Dst(Size);
+  for (size_t I = 0; I < Size; I++) {
+    Src[I] = static_cast<uint8_t>(I);
+  }
+  ur::dma::copy(Dst.data(), Src.data(), Size, Executor);
+  ASSERT_EQ(Src, Dst);
+
+  ur::dma::set(Dst.data(), 7, Size, Executor);
+  ASSERT_EQ(Dst, std::vector<uint8_t>(Size, 7));
+}
+
+TEST(hostDma, copy3D) {
+  const auto Executor = ur::dma::makeThreadExecutor(4);
+  constexpr size_t Width = 700, Height = 50, Depth = 40;
+  constexpr size_t SrcRowPitch = 1000, SrcSlicePitch = SrcRowPitch * 60;
+  constexpr size_t DstRowPitch = 900, DstSlicePitch = DstRowPitch * 55;
+  std::vector<uint8_t> Src(SrcSlicePitch * Depth);
+  std::vector<uint8_t> Dst(DstSlicePitch * Depth, 0);
+  for (size_t I = 0; I < Src.size(); I++) {
+    Src[I] = static_cast<uint8_t>(I * 31);
+  }
+  ur::dma::copy3D(Dst.data(), DstRowPitch, DstSlicePitch, Src.data(),
+                  SrcRowPitch, SrcSlicePitch, Width, Height, Depth, Executor);
+  for (size_t Z = 0; Z < Depth; Z++) {
+    for (size_t Y = 0; Y < Height; Y++) {
+      for (size_t X = 0; X < DstRowPitch; X++) {
+        const uint8_t Expected =
+            X < Width ? Src[Z * SrcSlicePitch + Y * SrcRowPitch + X] : 0;
+        ASSERT_EQ(Dst[Z * DstSlicePitch + Y * DstRowPitch + X], Expected)
+            << Z << " " << Y << " " << X;
+      }
+    }
+  }
+}
+
+TEST(hostDma, streamingFillUnalignedEdges) {
+  // Fills this large bypass the cache, which only works on aligned blocks, so
+  // the unaligned head and tail are written separately.
+  constexpr uint8_t Guard = 0xaa;
+  const auto Pattern = makePattern(12);
+  const size_t Size = (16 << 20) / Pattern.size() * Pattern.size() + 120;
+  for (isa_t Isa : supportedIsas()) {
+    for (size_t Offset : {1, 61}) {
+      SCOPED_TRACE(std::string(ur::dma::getIsaName(Isa)) + " offset " +
+                   std::to_string(Offset));
+      std::vector<uint8_t> Buffer(Offset + Size + 67, Guard);
+      ur::dma::detail::fill(Isa, Buffer.data() + Offset, Pattern.data(),
+                            Pattern.size(), Size);
+      expectFilled(Buffer, Offset, Size, Pattern, Guard);
+    }
+  }
+}
+
+TEST(hostDma, parallelSetAndCopyUnalignedEdges) {
+  // Split across tasks, with neither end on a block boundary.
+  const auto Executor = ur::dma::makeThreadExecutor(4);
+  constexpr uint8_t Guard = 0xaa;
+  constexpr size_t Offset = 3, Size = (8 << 20) + 5;
+  std::vector<uint8_t> Dst(Offset + Size + 64, Guard);
+  ur::dma::set(Dst.data() + Offset, 7, Size, Executor);
+  expectFilled(Dst, Offset, Size, {7}, Guard);
+
+  std::vector<uint8_t> Src(Size + 1);
+  for (size_t I = 0; I < Src.size(); I++) {
+    Src[I] = static_cast<uint8_t>(I * 13 + 5);
+  }
+  std::fill(Dst.begin(), Dst.end(), Guard);
+  ur::dma::copy(Dst.data() + Offset, Src.data() + 1, Size, Executor);
+  for (size_t I = 0; I < Offset; I++) {
+    ASSERT_EQ(Dst[I], Guard) << "at " << I;
+  }
+  for (size_t I = 0; I < Size; I++) {
+    ASSERT_EQ(Dst[Offset + I], Src[1 + I]) << "at " << Offset + I;
+  }
+  for (size_t I = Offset + Size; I < Dst.size(); I++) {
+    ASSERT_EQ(Dst[I], Guard) << "at " << I;
+  }
+}
@@ -0,0 +1,145 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <atomic>
+#include <csignal>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "latency_tracker.hpp"
+
+// Run with UR_LOG_LATENCY=level:info, as latency tracking is only enabled
+// from the environment.
+
+namespace {
+
+// Returns the count column of the row of a scope in toString() output.
+int64_t countOf(const std::string &csv, const std::string &name) {
+  std::istringstream lines(csv);
+  std::string line;
+  while (std::getline(lines, line)) {
+    std::istringstream columns(line);
+    std::string column;
+    std::getline(columns, column, ',');
+    if (column != name) {
+      continue;
+    }
+    for (size_t i = 0; i < 1 + numPercentiles + 1; i++) {
+      std::getline(columns, column, ',');
+    }
+    return std::stoll(column);
+  }
+  return 0;
+}
+
+} // namespace
+
+TEST(LatencyTracker, Enabled) { ASSERT_TRUE(trackLatency); }
+
+TEST(LatencyTracker, MergesLiveAndExitedThreads) {
+  latency_printer printer;
+
+  std::atomic<bool> exit{false};
+  std::atomic<int> recorded{0};
+  auto record = [&](bool wait) {
+    latency_histogram histogram("scope", printer);
+    for (int i = 1; i <= 100; i++) {
+      histogram.trackValue(i);
+    }
+    recorded++;
+    while (wait && !exit) {
+      std::this_thread::yield();
+    }
+  };
+
+  std::thread exited(record, false);
+  exited.join();
+  std::thread live(record, true);
+  while (recorded < 2) {
+    std::this_thread::yield();
+  }
+
+  auto csv = printer.toString();
+  exit = true;
+  live.join();
+
+  ASSERT_EQ(csv.rfind("name,mean,p50,p90,p99,", 0), 0u);
+  ASSERT_EQ(countOf(csv, "scope"), 200);
+  ASSERT_EQ(countOf(printer.toString(), "scope"), 200);
+}
+
+TEST(LatencyTracker, ReadWhileRecording) {
+  static constexpr int numThreads = 8;
+  static constexpr int numValues = 20000;
+  latency_printer printer;
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < numThreads; t++) {
+    threads.emplace_back([&] {
+      latency_histogram histogram("concurrent", printer);
+      for (int i = 0; i < numValues; i++) {
+        histogram.trackValue(i % 1000 + 1);
+      }
+    });
+  }
+
+  // Counts read while threads record only grow.
+  int64_t last = 0;
+  for (int i = 0; i < 50; i++) {
+    auto count = countOf(printer.toString(), "concurrent");
+    ASSERT_GE(count, last);
+    last = count;
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(countOf(printer.toString(), "concurrent"),
+            int64_t{numThreads} * numValues);
+}
+
+TEST(LatencyTracker, TrackScopeLatency) {
+  auto scope = [] { TRACK_SCOPE_LATENCY("LatencyTracker.TrackScopeLatency"); };
+  std::thread([&] {
+    for (int i = 0; i < 10; i++) {
+      scope();
+    }
+  }).join();
+  scope();
+
+  ASSERT_EQ(countOf(globalLatencyPrinter().toString(),
+                    "LatencyTracker.TrackScopeLatency"),
+            11);
+}
+
+#ifndef _WIN32
+namespace {
+std::atomic<int> previousHandlerCalls{0};
+}
+
+TEST(LatencyTracker, DumpSignalChainsPreviousHandler) {
+  auto previous = std::signal(SIGUSR2, [](int) { previousHandlerCalls++; });
+  ASSERT_NE(previous, SIG_ERR);
+
+  ASSERT_EQ(setenv("UR_LATENCY_DUMP_SIGNAL", std::to_string(SIGUSR2).c_str(),
+                   1),
+            0);
+  {
+    latency_printer printer;
+    std::raise(SIGUSR2);
+    ASSERT_EQ(previousHandlerCalls, 1);
+  }
+  unsetenv("UR_LATENCY_DUMP_SIGNAL");
+
+  // The previous handler is restored with the printer.
+  std::raise(SIGUSR2);
+  ASSERT_EQ(previousHandlerCalls, 2);
+  std::signal(SIGUSR2, previous);
+}
+#endif
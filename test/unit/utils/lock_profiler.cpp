@@ -0,0 +1,128 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <chrono>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ur/ur.hpp"
+
+// Run with UR_LOG_LOCK_PROFILE=level:info, as lock profiling is only enabled
+// from the environment.
+
+TEST(LockProfiler, Enabled) { ASSERT_TRUE(profileLocks); }
+
+TEST(LockProfiler, CountsAcquisitions) {
+  static constexpr int numThreads = 4;
+  static constexpr int numLocks = 10000;
+  ur_mutex Mutex{"LockProfiler.CountsAcquisitions"};
+  auto *Site = globalLockProfiler().getSite("LockProfiler.CountsAcquisitions");
+
+  int Counter = 0;
+  std::vector<std::thread> Threads;
+  for (int T = 0; T < numThreads; T++) {
+    Threads.emplace_back([&] {
+      for (int I = 0; I < numLocks; I++) {
+        std::scoped_lock<ur_mutex> Lock(Mutex);
+        Counter++;
+      }
+    });
+  }
+  for (auto &Thread : Threads) {
+    Thread.join();
+  }
+
+  ASSERT_EQ(Counter, numThreads * numLocks);
+  ASSERT_EQ(Site->acquisitions, uint64_t{numThreads} * numLocks);
+  ASSERT_LE(Site->contended, Site->acquisitions);
+  ASSERT_EQ(Site->sharedAcquisitions, 0u);
+}
+
+TEST(LockProfiler, RecordsWaitAndHold) {
+  using namespace std::chrono_literals;
+  ur_mutex Mutex{"LockProfiler.RecordsWaitAndHold"};
+  auto *Site = globalLockProfiler().getSite("LockProfiler.RecordsWaitAndHold");
+
+  std::unique_lock<ur_mutex> Lock(Mutex);
+  std::thread Waiter([&] { std::scoped_lock<ur_mutex> WaiterLock(Mutex); });
+  std::this_thread::sleep_for(20ms);
+  Lock.unlock();
+  Waiter.join();
+
+  ASSERT_EQ(Site->acquisitions, 2u);
+  ASSERT_EQ(Site->contended, 1u);
+  ASSERT_GE(Site->maxWaitNs, uint64_t(10ms / 1ns));
+  ASSERT_GE(Site->maxHoldNs, uint64_t(20ms / 1ns));
+  ASSERT_GE(Site->holdNs, Site->maxHoldNs.load());
+}
+
+TEST(LockProfiler, SharedAcquisitions) {
+  ur_shared_mutex Mutex{"LockProfiler.SharedAcquisitions"};
+  auto *Site = globalLockProfiler().getSite("LockProfiler.SharedAcquisitions");
+
+  {
+    std::shared_lock<ur_shared_mutex> First(Mutex);
+    std::shared_lock<ur_shared_mutex> Second(Mutex);
+    ASSERT_FALSE(Mutex.try_lock());
+  }
+  { std::scoped_lock<ur_shared_mutex> Lock(Mutex); }
+
+  ASSERT_EQ(Site->sharedAcquisitions, 2u);
+  ASSERT_EQ(Site->sharedContended, 0u);
+  ASSERT_EQ(Site->acquisitions, 1u);
+}
+
+TEST(LockProfiler, UnnamedMutexesUseConstructionSite) {
+  std::vector<std::unique_ptr<ur_mutex>> Mutexes;
+  int Line = __LINE__ + 2;
+  for (int I = 0; I < 2; I++) {
+    Mutexes.emplace_back(new ur_mutex());
+  }
+  ur_mutex Other;
+  auto *Site =
+      globalLockProfiler().getSite(__FILE__ ":" + std::to_string(Line));
+
+  for (auto &Mutex : Mutexes) {
+    ur_lock Lock(*Mutex);
+  }
+  ur_lock Lock(Other);
+
+  ASSERT_EQ(Site->acquisitions, 2u);
+}
+
+TEST(LockProfiler, BaseMutexNamedByDerived) {
+  struct Base {
+    explicit Base(const char *Name) : Mutex{Name} {}
+    ur_shared_mutex Mutex;
+  };
+  struct First : Base {
+    First() : Base("LockProfiler.First") {}
+  };
+  struct Second : Base {
+    Second() : Base("LockProfiler.Second") {}
+  };
+  First A;
+  Second B;
+  { std::scoped_lock<ur_shared_mutex> Lock(A.Mutex); }
+  { std::shared_lock<ur_shared_mutex> Lock(B.Mutex); }
+
+  auto *FirstSite = globalLockProfiler().getSite("LockProfiler.First");
+  auto *SecondSite = globalLockProfiler().getSite("LockProfiler.Second");
+  ASSERT_EQ(FirstSite->acquisitions, 1u);
+  ASSERT_EQ(FirstSite->sharedAcquisitions, 0u);
+  ASSERT_EQ(SecondSite->acquisitions, 0u);
+  ASSERT_EQ(SecondSite->sharedAcquisitions, 1u);
+}
+
+// Names must be given explicitly, so that no string is taken for a mutex.
+static_assert(!std::is_convertible_v<const char *, ur_mutex>);
+static_assert(!std::is_convertible_v<const char *, ur_shared_mutex>);
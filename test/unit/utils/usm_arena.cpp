@@ -0,0 +1,277 @@
+// Copyright (C) 2025 Intel Corporation
+// Part of the Unified-Runtime Project, under the Apache License v2.0 with LLVM
+// Exceptions. See LICENSE.TXT
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <gtest/gtest.h>
+
+#include "ur_usm_arena.hpp"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <new>
+#include <set>
+
+namespace {
+
+// Device memory and events handed out by the fake entry points below. Events
+// are numbered from 1 and start out incomplete.
+std::set<void *> allocations;
+size_t freed = 0;
+std::map<ur_event_handle_t, int> eventRefs;
+std::set<ur_event_handle_t> completed;
+uintptr_t nextEvent = 1;
+size_t eventsWaits = 0;
+size_t barriers = 0;
+
+constexpr std::align_val_t deviceAlign{4096};
+
+ur_result_t UR_APICALL fakeDeviceAlloc(ur_context_handle_t, ur_device_handle_t,
+                                       const ur_usm_desc_t *,
+                                       ur_usm_pool_handle_t, size_t size,
+                                       void **ppMem) {
+  *ppMem = ::operator new(size, deviceAlign);
+  allocations.insert(*ppMem);
+  return UR_RESULT_SUCCESS;
+}
+
+ur_result_t UR_APICALL fakeFree(ur_context_handle_t, void *pMem) {
+  EXPECT_EQ(allocations.erase(pMem), 1u);
+  freed++;
+  ::operator delete(pMem, deviceAlign);
+  return UR_RESULT_SUCCESS;
+}
+
+void newEvent(ur_event_handle_t *phEvent) {
+  if (phEvent) {
+    *phEvent = reinterpret_cast<ur_event_handle_t>(nextEvent++);
+    eventRefs[*phEvent] = 1;
+  }
+}
+
+ur_result_t UR_APICALL fakeEventsWait(ur_queue_handle_t, uint32_t,
+                                      const ur_event_handle_t *,
+                                      ur_event_handle_t *phEvent) {
+  eventsWaits++;
+  newEvent(phEvent);
+  return UR_RESULT_SUCCESS;
+}
+
+ur_result_t UR_APICALL fakeEventsWaitWithBarrier(ur_queue_handle_t, uint32_t,
+                                                 const ur_event_handle_t *,
+                                                 ur_event_handle_t *phEvent) {
+  barriers++;
+  newEvent(phEvent);
+  return UR_RESULT_SUCCESS;
+}
+
+ur_result_t UR_APICALL fakeEventGetInfo(ur_event_handle_t hEvent,
+                                        ur_event_info_t propName, size_t,
+                                        void *pPropValue, size_t *) {
+  EXPECT_EQ(propName, UR_EVENT_INFO_COMMAND_EXECUTION_STATUS);
+  *static_cast<ur_event_status_t *>(pPropValue) =
+      completed.count(hEvent) ? UR_EVENT_STATUS_COMPLETE
+                              : UR_EVENT_STATUS_SUBMITTED;
+  return UR_RESULT_SUCCESS;
+}
+
+ur_result_t UR_APICALL fakeEventWait(uint32_t numEvents,
+                                     const ur_event_handle_t *phEventWaitList) {
+  completed.insert(phEventWaitList, phEventWaitList + numEvents);
+  return UR_RESULT_SUCCESS;
+}
+
+ur_result_t UR_APICALL fakeEventRetain(ur_event_handle_t hEvent) {
+  eventRefs[hEvent]++;
+  return UR_RESULT_SUCCESS;
+}
+
+ur_result_t UR_APICALL fakeEventRelease(ur_event_handle_t hEvent) {
+  EXPECT_GT(eventRefs[hEvent], 0);
+  eventRefs[hEvent]--;
+  return UR_RESULT_SUCCESS;
+}
+
+const ur::usm_arena::arena_fns_t fakeFns = {
+    fakeDeviceAlloc,  fakeFree,        fakeEventsWait,
+    fakeEventsWaitWithBarrier,         fakeEventGetInfo,
+    fakeEventWait,    fakeEventRetain, fakeEventRelease,
+};
+
+constexpr size_t chunkSize = 4096;
+
+struct USMArena : ::testing::TestWithParam<bool> {
+  void SetUp() override {
+    allocations.clear();
+    freed = 0;
+    eventRefs.clear();
+    completed.clear();
+    nextEvent = 1;
+    eventsWaits = 0;
+    barriers = 0;
+  }
+
+  void TearDown() override {
+    arena.reset();
+    ASSERT_TRUE(allocations.empty());
+    for (auto &[hEvent, refs] : eventRefs) {
+      ASSERT_EQ(refs, 0) << "event " << hEvent;
+    }
+  }
+
+  bool inOrder() const { return GetParam(); }
+
+  void *alloc(size_t size, size_t align = 0) {
+    ur_usm_desc_t desc{};
+    desc.align = static_cast<uint32_t>(align);
+    void *pMem = nullptr;
+    EXPECT_EQ(arena->enqueueAlloc(nullptr, &desc, size, 0, nullptr, &pMem,
+                                  nullptr),
+              UR_RESULT_SUCCESS);
+    return pMem;
+  }
+
+  void free(void *pMem) {
+    ASSERT_EQ(arena->enqueueFree(nullptr, pMem, 0, nullptr, nullptr),
+              UR_RESULT_SUCCESS);
+  }
+
+  std::unique_ptr<ur::usm_arena::arena_t> arena =
+      std::make_unique<ur::usm_arena::arena_t>(fakeFns, nullptr, nullptr,
+                                               inOrder(), chunkSize);
+};
+
+} // namespace
+
+TEST_P(USMArena, AllocationsShareAChunk) {
+  auto *a = static_cast<char *>(alloc(100));
+  auto *b = static_cast<char *>(alloc(100, 256));
+
+  ASSERT_EQ(allocations.size(), 1u);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(a) % 64, 0u);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(b) % 256, 0u);
+  ASSERT_GE(b, a + 100);
+  ASSERT_EQ(eventsWaits, 0u);
+}
+
+TEST_P(USMArena, FullChunkAllocatesAnother) {
+  alloc(chunkSize / 2);
+  alloc(chunkSize / 2 + 1);
+  ASSERT_EQ(allocations.size(), 2u);
+
+  // Too large for any chunk, so it gets one of its own.
+  alloc(chunkSize * 2);
+  ASSERT_EQ(allocations.size(), 3u);
+}
+
+TEST_P(USMArena, ChunkIsReusedOnceFreesComplete) {
+  void *a = alloc(chunkSize / 2);
+  void *b = alloc(chunkSize / 2);
+  free(a);
+  free(b);
+
+  if (!inOrder()) {
+    // The frees haven't completed yet, so the chunk can't be rewound.
+    ASSERT_EQ(barriers, 2u);
+    ASSERT_NE(alloc(chunkSize / 2), a);
+    ASSERT_EQ(allocations.size(), 2u);
+    completed.insert({reinterpret_cast<ur_event_handle_t>(1),
+                      reinterpret_cast<ur_event_handle_t>(2)});
+  } else {
+    ASSERT_EQ(barriers, 0u);
+  }
+  ASSERT_EQ(eventsWaits, 0u);
+
+  ASSERT_EQ(alloc(chunkSize / 2), a);
+}
+
+TEST_P(USMArena, LiveAllocationKeepsChunk) {
+  void *a = alloc(100);
+  void *b = alloc(100);
+  free(a);
+  completed.insert(reinterpret_cast<ur_event_handle_t>(1));
+
+  ASSERT_NE(alloc(100), a);
+  free(b);
+}
+
+TEST_P(USMArena, OversizedChunkIsReleased) {
+  void *a = alloc(chunkSize * 2);
+  free(a);
+  completed.insert(reinterpret_cast<ur_event_handle_t>(1));
+
+  alloc(100);
+  ASSERT_EQ(allocations.size(), 1u);
+  ASSERT_EQ(freed, 1u);
+}
+
+TEST_P(USMArena, EventsAreReturned) {
+  ur_event_handle_t waitEvent = reinterpret_cast<ur_event_handle_t>(100);
+  ur_event_handle_t allocEvent = nullptr;
+  void *pMem = nullptr;
+  ASSERT_EQ(arena->enqueueAlloc(nullptr, nullptr, 100, 1, &waitEvent, &pMem,
+                                &allocEvent),
+            UR_RESULT_SUCCESS);
+  ASSERT_NE(allocEvent, nullptr);
+
+  ur_event_handle_t freeEvent = nullptr;
+  ASSERT_EQ(arena->enqueueFree(nullptr, pMem, 0, nullptr, &freeEvent),
+            UR_RESULT_SUCCESS);
+  ASSERT_NE(freeEvent, nullptr);
+  // Frees on out-of-order queues wait for all earlier commands.
+  ASSERT_EQ(eventsWaits, inOrder() ? 2u : 1u);
+  ASSERT_EQ(barriers, inOrder() ? 0u : 1u);
+
+  fakeEventRelease(allocEvent);
+  fakeEventRelease(freeEvent);
+}
+
+TEST_P(USMArena, InvalidArguments) {
+  void *pMem = nullptr;
+  ASSERT_EQ(
+      arena->enqueueAlloc(nullptr, nullptr, 0, 0, nullptr, &pMem, nullptr),
+      UR_RESULT_ERROR_INVALID_USM_SIZE);
+
+  int notFromArena = 0;
+  ASSERT_EQ(arena->enqueueFree(nullptr, &notFromArena, 0, nullptr, nullptr),
+            UR_RESULT_ERROR_INVALID_VALUE);
+
+  void *a = alloc(100);
+  free(a);
+  if (!inOrder()) {
+    completed.insert(reinterpret_cast<ur_event_handle_t>(1));
+  }
+  alloc(200);
+  alloc(200);
+  ASSERT_EQ(arena->enqueueFree(nullptr, static_cast<char *>(a) + 1024, 0,
+                               nullptr, nullptr),
+            UR_RESULT_ERROR_INVALID_VALUE);
+}
+
+TEST_P(USMArena, FreeOfNonLiveAllocationIsRejected) {
+  auto *a = static_cast<char *>(alloc(100));
+  auto *b = static_cast<char *>(alloc(100));
+
+  // Neither a pointer into an allocation nor a second free of one counts as
+  // freeing b, which must keep the chunk from being rewound.
+  ASSERT_EQ(arena->enqueueFree(nullptr, b + 1, 0, nullptr, nullptr),
+            UR_RESULT_ERROR_INVALID_VALUE);
+  free(a);
+  ASSERT_EQ(arena->enqueueFree(nullptr, a, 0, nullptr, nullptr),
+            UR_RESULT_ERROR_INVALID_VALUE);
+  if (!inOrder()) {
+    completed.insert(reinterpret_cast<ur_event_handle_t>(1));
+  }
+  auto *c = static_cast<char *>(alloc(100));
+  ASSERT_GE(c, b + 100);
+
+  free(b);
+  free(c);
+}
+
+INSTANTIATE_TEST_SUITE_P(, USMArena, ::testing::Values(true, false),
+                         [](const ::testing::TestParamInfo<bool> &info) {
+                           return info.param ? "InOrder" : "OutOfOrder";
+                         });
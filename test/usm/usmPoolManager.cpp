@@ -9,6 +9,11 @@
 
 #include <uur/fixtures.h>
 
+#include <ur_mock_helpers.hpp>
+
+#include <atomic>
+#include <chrono>
+
 using urUsmPoolDescriptorTest = uur::urMultiDeviceContextTest;
 
 UUR_INSTANTIATE_PLATFORM_TEST_SUITE(urUsmPoolDescriptorTest);
@@ -177,4 +182,58 @@ TEST_P(urUsmPoolManagerTest, config) {
   ASSERT_EQ(compareConfigs(test, parsed3), true);
 }
 
+static std::atomic<size_t> numGetNativeHandleCalls = 0;
+
+ur_result_t countGetNativeHandle(void *) {
+  numGetNativeHandleCalls++;
+  return UR_RESULT_SUCCESS;
+}
+
+// Pool lookups happen on every USM allocation and must not go through the
+// loader to resolve native device handles.
+TEST_P(urUsmPoolManagerTest, poolManagerGetPoolBenchmark) {
+  auto [ret, manager] = usm::pool_manager<usm::pool_descriptor>::create();
+  ASSERT_EQ(ret, UR_RESULT_SUCCESS);
+
+  for (auto &desc : poolDescriptors) {
+    ret = manager.addPool(desc, createMockPoolHandle());
+    ASSERT_EQ(ret, UR_RESULT_SUCCESS);
+  }
+
+  // Descriptors as the adapters build them for each allocation.
+  std::vector<usm::pool_descriptor> lookups;
+  for (auto &desc : poolDescriptors) {
+    lookups.push_back(usm::pool_descriptor{desc.poolHandle, desc.hContext,
+                                           desc.hDevice, desc.type,
+                                           desc.deviceReadOnly});
+  }
+
+  numGetNativeHandleCalls = 0;
+  mock::getCallbacks().set_before_callback("urDeviceGetNativeHandle",
+                                           &countGetNativeHandle);
+
+  constexpr size_t numIterations = 100000;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < numIterations; i++) {
+    for (auto &desc : lookups) {
+      auto hPool = manager.getPool(desc);
+      ASSERT_TRUE(hPool.has_value());
+    }
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  mock::getCallbacks().resetCallbacks();
+
+  auto numLookups = numIterations * lookups.size();
+  RecordProperty(
+      "ns_per_lookup",
+      std::to_string(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+              .count() /
+          numLookups));
+  RecordProperty("ddi_calls_per_lookup",
+                 std::to_string(double(numGetNativeHandleCalls) / numLookups));
+  ASSERT_EQ(numGetNativeHandleCalls.load(), 0u);
+}
+
 UUR_INSTANTIATE_DEVICE_TEST_SUITE(urUsmPoolManagerTest);
@@ -32,6 +32,8 @@ inline void printAdapterInfos(ur_adapter_handle_t hAdapter,
   printAdapterInfo<ur_adapter_backend_t>(hAdapter, UR_ADAPTER_INFO_BACKEND);
   std::cout << prefix;
   printAdapterInfo<uint32_t>(hAdapter, UR_ADAPTER_INFO_VERSION);
+  std::cout << prefix;
+  printAdapterInfo<char[]>(hAdapter, UR_ADAPTER_INFO_LATENCY_HISTOGRAM_EXP);
 }
 
 inline void printPlatformInfos(ur_platform_handle_t hPlatform,
@@ -164,6 +164,19 @@ inline void printAdapterInfo(ur_adapter_handle_t adapter,
   std::cout << value << "\n";
 }
 
+template <>
+inline void printAdapterInfo<char[]>(ur_adapter_handle_t adapter,
+                                     ur_adapter_info_t info) {
+  std::cout << getAdapterInfoName(info) << ": ";
+  size_t size = 0;
+  UR_CHECK_WEAK(urAdapterGetInfo(adapter, info, 0, nullptr, &size));
+  std::string str(size, '\0');
+  UR_CHECK_WEAK(urAdapterGetInfo(adapter, info, size, str.data(), nullptr));
+  str.pop_back(); // std::string does not need a terminating NULL, remove it
+                  // here
+  std::cout << str << "\n";
+}
+
 inline std::string getPlatformInfoName(ur_platform_info_t info) {
   std::stringstream stream;
   stream << info;